@@ -73,6 +73,25 @@ class LLGL_EXPORT Blob : public NonCopyable
         */
         static std::unique_ptr<Blob> CreateFromFile(const std::string& filename);
 
+        /**
+        \brief Creates a new Blob instance that maps the specified binary file into memory.
+        \param[in] filename Specifies the file that is to be mapped.
+        \return New instance of Blob that refers to the read-only memory mapping of the specified file or null if the file could not be mapped.
+        \remarks In contrast to CreateFromFile, the file content is not copied. Instead, the pages are loaded by the operating system when they are accessed.
+        This is the preferred way to load large image files that are stored in a raw format, e.g. with the Image class:
+        \code
+        LLGL::Image myImage { myExtent, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, LLGL::Blob::CreateFromMappedFile("MyImage.raw") };
+        \endcode
+        \see Image::Image(const Extent3D&, const ImageFormat, const DataType, const std::shared_ptr<Blob>&, std::size_t)
+        */
+        static std::unique_ptr<Blob> CreateFromMappedFile(const char* filename);
+
+        /**
+        \brief Creates a new Blob instance that maps the specified binary file into memory.
+        \see CreateFromMappedFile(const char*)
+        */
+        static std::unique_ptr<Blob> CreateFromMappedFile(const std::string& filename);
+
     public:
 
         //! Returns a constant pointer to the internal buffer.
@@ -95,6 +95,15 @@ struct CommandBufferFlags
         \todo Rename to \c Restore
         */
         MultiSubmit     = (1 << 1),
+
+        /**
+        \brief Specifies that the encoded command buffer is optimized once the encoding has ended.
+        \remarks This removes redundant state changes and clear commands and merges consecutive draw commands where the renderer supports it.
+        The optimization takes additional time in CommandBuffer::End, so it is recommended only in conjunction with \c MultiSubmit.
+        \note Only supported with: OpenGL.
+        \see CommandBuffer::End
+        */
+        Optimize        = (1 << 2),
     };
 };
 
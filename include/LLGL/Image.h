@@ -12,19 +12,26 @@
 #include "Export.h"
 #include "Types.h"
 #include "ImageFlags.h"
+#include "ImageView.h"
 #include "SamplerFlags.h"
+#include "TextureFlags.h"
+#include <vector>
+#include <memory>
 
 
 namespace LLGL
 {
 
 
+class Blob;
+
 /**
 \brief Utility class to manage the storage and attributes of an image.
 
 This class is not required for any interaction with the render system.
 It can be used as utility to handle 2D and 3D image data before passing it to a hardware texture.
 \remarks This class holds the ownership of an image buffer and its attributes.
+Alternatively, it can hold a shared reference to a read-only image buffer, e.g. a memory-mapped file (see Image(const Extent3D&, const ImageFormat, const DataType, const std::shared_ptr<Blob>&, std::size_t)).
 The primary functions are implemented as global functions like <code>GenerateImageBuffer</code> for instance.
 \note All image operations of this class do NOT make use of hardware acceleration.
 \see GenerateImageBuffer
@@ -59,7 +66,28 @@ class LLGL_EXPORT Image
         */
         Image(const Extent3D& extent, const ImageFormat format, const DataType dataType, ByteBuffer&& data);
 
-        //! Copy constructor which copies the entire image buffer from the specified source image.
+        /**
+        \brief Constructor to initialize the image with all atributes, including a shared reference to the read-only image buffer specified by the 'blob' parameter.
+        \param[in] blob Specifies the blob that contains the image buffer, e.g. a memory-mapped file created with Blob::CreateFromMappedFile.
+        The image keeps a shared reference to this blob instead of copying its data.
+        \param[in] offset Specifies the offset (in bytes) of the image buffer within the blob. By default 0.
+        \remarks Only functions that modify the image buffer (e.g. WritePixels, Convert, or the non-const version of GetData) copy the image buffer into a buffer owned by this image.
+        Functions that only read the image buffer (e.g. ReadPixels, GetSrcDesc, or GetView) work directly on the blob, so a memory-mapped file can be passed to RenderSystem::CreateTexture without a heap allocation:
+        \code
+        std::shared_ptr<LLGL::Blob> atlasFile = LLGL::Blob::CreateFromMappedFile("Atlas.raw");
+        LLGL::Image atlas { LLGL::Extent3D { 16384, 16384, 1 }, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, atlasFile };
+        LLGL::SrcImageDescriptor atlasDesc = atlas.GetSrcDesc();
+        auto myTexture = myRenderer->CreateTexture(myTextureDesc, &atlasDesc);
+        \endcode
+        \throw std::invalid_argument If 'blob' is null or if it is too small for the specified offset, extent, format, and data type.
+        \see Blob::CreateFromMappedFile
+        */
+        Image(const Extent3D& extent, const ImageFormat format, const DataType dataType, const std::shared_ptr<Blob>& blob, std::size_t offset = 0);
+
+        /**
+        \brief Copy constructor which copies the entire image buffer from the specified source image.
+        \remarks If the source image refers to a shared image buffer, only the reference is copied.
+        */
         Image(const Image& rhs);
 
         //! Move constructor which takes the ownership of the specified source image.
@@ -77,7 +105,9 @@ class LLGL_EXPORT Image
 
         /**
         \brief Converts the image format and data type.
-        \see ConvertImageBuffer
+        \remarks This can also compress the image into one of the block compression formats (ImageFormat::BC1 to ImageFormat::BC7) or decompress it,
+        e.g. <code>myImage.Convert(LLGL::ImageFormat::BC3, LLGL::DataType::UInt8)</code>. Compressed images must use DataType::UInt8.
+        \see ConvertImageBuffer(const SrcImageDescriptor&, ImageFormat, DataType, const Extent3D&, std::size_t)
         */
         void Convert(const ImageFormat format, const DataType dataType, std::size_t threadCount = 0);
 
@@ -108,12 +138,27 @@ class LLGL_EXPORT Image
         /**
         \brief Resizes the image and resamples the pixels from the previous image buffer.
         \param[in] extent Specifies the new image size.
-        \param[in] filter Specifies the sampling filter.
-        \brief GenerateImageBuffer
-        \todo Not implemented yet.
+        \param[in] filter Specifies the sampling filter. SamplerFilter::Nearest maps to ImageFilter::Nearest and SamplerFilter::Linear maps to ImageFilter::Linear.
+        \see Resize(const Extent3D&, const ImageFilter, bool, std::size_t)
         */
         void Resize(const Extent3D& extent, const SamplerFilter filter);
 
+        /**
+        \brief Resizes the image and resamples the pixels from the previous image buffer with the specified filter.
+        \param[in] extent Specifies the new image size. If any of its components is zero, the image buffer is released.
+        \param[in] filter Specifies the resampling filter. The filter is applied separately for each axis (i.e. width, height, and depth).
+        \param[in] sRGB Specifies whether the color components are stored in sRGB color space.
+        If true, the color components (but not alpha) are converted into linear space before they are filtered, and converted back afterwards.
+        This avoids that downsampled images become darker. By default false.
+        \param[in] threadCount Specifies the number of threads to use for resampling (see ConvertImageBuffer for more details). By default 0.
+        \remarks Except for ImageFilter::Nearest, the pixels are filtered with 32-bit floating-point precision and rounded to the nearest value of the image data type.
+        This works for all color formats and data types, but 32-bit integer components lose precision beyond 24 bits.
+        \throw std::invalid_argument If the image has a compressed format.
+        \throw std::invalid_argument If the image has a depth-stencil format and the filter is not ImageFilter::Nearest.
+        \see ImageFilter
+        */
+        void Resize(const Extent3D& extent, const ImageFilter filter, bool sRGB = false, std::size_t threadCount = 0);
+
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
 
@@ -140,11 +185,20 @@ class LLGL_EXPORT Image
         If the source image is the same object as this image and the destination and source regions overlap, an internal temporary copy is allocated for reading the data.
         \param[in] srcRegionOffset Specifies the offset within the source image. This will be clamped if it exceeds the source image area.
         \param[in] srcRegionExtent Specifies the extent of the region to copy. This will be clamped if it exceeds the source or destination image area.
+        \param[in] threadCount Specifies the number of threads to copy large regions with (see ConvertImageBuffer for more details). By default 0.
         \remarks If one of the region offsets is clamped, the region extent will be adjusted respectively.
         If the source image has a different format or data type compared to this image, the function has no effect.
+        \throw std::invalid_argument If both images have the same compressed format, since their pixels are not addressable individually.
         \see ConvertImageBuffer
         */
-        void Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent);
+        void Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount = 0);
+
+        /**
+        \brief Copies a region of the specified source image view into this image.
+        \remarks This behaves the same as the other overload, but the source image buffer is not owned by an Image instance.
+        \see Blit(Offset3D, const Image&, Offset3D, Extent3D, std::size_t)
+        */
+        void Blit(Offset3D dstRegionOffset, const ImageView& srcImageView, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount = 0);
 
         /**
         \brief Fills a region of this image by the specified color.
@@ -173,6 +227,7 @@ class LLGL_EXPORT Image
         \endcode
         \throws std::invalid_argument If the 'data' member of the image descriptor is non-null, the sub-image region is inside the image,
         but the 'dataSize' member of the image descriptor is too small.
+        \throws std::invalid_argument If this image has a compressed format and the region is not the entire image.
         \see IsRegionInside
         \see ConvertImageBuffer
         */
@@ -185,28 +240,52 @@ class LLGL_EXPORT Image
         \param[in] imageDesc Specifies the source image descriptor to read the region from.
         If the 'data' member of this descriptor is null or if the sub-image region is not inside the image, this function has no effect.
         \param[in] threadCount Specifies the number of threads to use if the data needs to be converted (see ConvertImageBuffer for more details). By default 0.
+        \throws std::invalid_argument If this image has a compressed format and the region is not the entire image.
         \see IsRegionInside
         \see ConvertImageBuffer
         */
         void WritePixels(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, std::size_t threadCount = 0);
 
         /**
-        \brief Mirrors the image at the YZ plane.
-        \todo Not implemented yet
+        \brief Mirrors the image at the YZ plane, i.e. reverses the order of pixels within each row.
+        \param[in] threadCount Specifies the number of threads to use for large images (see ConvertImageBuffer for more details). By default 0.
+        \remarks This has no effect on compressed images.
+        */
+        void MirrorYZPlane(std::size_t threadCount = 0);
+
+        /**
+        \brief Mirrors the image at the XZ plane, i.e. reverses the order of rows within each slice.
+        \param[in] threadCount Specifies the number of threads to use for large images (see ConvertImageBuffer for more details). By default 0.
+        \remarks This has no effect on compressed images.
+        */
+        void MirrorXZPlane(std::size_t threadCount = 0);
+
+        /**
+        \brief Mirrors the image at the XY plane, i.e. reverses the order of slices.
+        \param[in] threadCount Specifies the number of threads to use for large images (see ConvertImageBuffer for more details). By default 0.
+        \remarks This has no effect on compressed images.
         */
-        void MirrorYZPlane();
+        void MirrorXYPlane(std::size_t threadCount = 0);
 
         /**
-        \brief Mirrors the image at the XZ plane.
-        \todo Not implemented yet
+        \brief Transposes each slice of the image, i.e. swaps the X and Y axes. The width and height of the image are swapped as well.
+        \param[in] threadCount Specifies the number of threads to use for large images (see ConvertImageBuffer for more details). By default 0.
+        \remarks Square images are transposed in place. All other images are transposed into a new image buffer of the same size.
+        The pixels are copied in tiles that fit into the CPU cache, so this is much faster than reading the pixels column by column.
+        This has no effect on compressed images.
         */
-        void MirrorXZPlane();
+        void Transpose(std::size_t threadCount = 0);
 
         /**
-        \brief Mirrors the image at the XY plane.
-        \todo Not implemented yet
+        \brief Rotates each slice of the image by 90 degrees. The width and height of the image are swapped as well.
+        \param[in] clockwise Specifies whether to rotate clockwise or counter-clockwise, assuming the first row is the top of the image. By default true.
+        \param[in] threadCount Specifies the number of threads to use for large images (see ConvertImageBuffer for more details). By default 0.
+        \remarks This can be used to re-orient the faces of a cube map, where each face is a slice of the image.
+        Square images are rotated in place. All other images are rotated into a new image buffer of the same size.
+        This has no effect on compressed images.
+        \see Transpose
         */
-        void MirrorXYPlane();
+        void Rotate90(bool clockwise = true, std::size_t threadCount = 0);
 
         /* ----- Attributes ----- */
 
@@ -216,6 +295,9 @@ class LLGL_EXPORT Image
         //! Returns a destination image descriptor for this image with read/write access to the image data.
         DstImageDescriptor GetDstDesc();
 
+        //! Returns a non-owning view of this image. The view is invalidated when the image buffer is modified or released.
+        ImageView GetView() const;
+
         //! Returns the extent of the image as 3D vector.
         inline const Extent3D& GetExtent() const
         {
@@ -235,19 +317,17 @@ class LLGL_EXPORT Image
         }
 
         //! Returns the image data buffer as constant raw pointer.
-        inline const void* GetData() const
-        {
-            return data_.get();
-        }
+        const void* GetData() const;
 
-        //! Returns the image data buffer as raw pointer.
-        inline void* GetData()
-        {
-            return data_.get();
-        }
+        /**
+        \brief Returns the image data buffer as raw pointer.
+        \remarks If the image refers to a shared image buffer, it is copied into a buffer owned by this image first.
+        */
+        void* GetData();
 
         /**
         \brief Returns the size (in bytes) for each pixel.
+        \remarks Compressed formats have no size per pixel, so this is 0 for them. Use GetRowStride and GetDepthStride instead.
         \see GetFormat
         \see ImageFormatSize
         \see GetDataType
@@ -255,10 +335,13 @@ class LLGL_EXPORT Image
         */
         std::uint32_t GetBytesPerPixel() const;
 
-        //! Returns the stride (in bytes) for each row.
+        /**
+        \brief Returns the stride (in bytes) for each row.
+        \remarks For compressed formats, this is the stride for each row of 4x4 pixel blocks.
+        */
         std::uint32_t GetRowStride() const;
 
-        //! Returns the stride (in bytes) for each depth slice.
+        //! Returns the stride (in bytes) for each depth slice. This includes the padding of compressed formats.
         std::uint32_t GetDepthStride() const;
 
         /**
@@ -290,16 +373,80 @@ class LLGL_EXPORT Image
 
         void ClampRegion(Offset3D& offset, Extent3D& extent) const;
 
+        void ResetData(ByteBuffer&& data);
+
+        void DetachSharedData();
+
+        void TransposeSlices(bool flipX, bool flipY, std::size_t threadCount);
+
     private:
 
-        Extent3D    extent_;
-        ImageFormat format_     = ImageFormat::RGBA;
-        DataType    dataType_   = DataType::UInt8;
-        ByteBuffer  data_;
+        Extent3D                extent_;
+        ImageFormat             format_         = ImageFormat::RGBA;
+        DataType                dataType_       = DataType::UInt8;
+        ByteBuffer              data_;
+
+        std::shared_ptr<Blob>   sharedData_;
+        std::size_t             sharedOffset_   = 0;
 
 };
 
 
+/* ----- Structures ----- */
+
+/**
+\brief MIP-map chain that was generated on the CPU.
+\remarks All MIP-map levels are stored in a single contiguous buffer, starting with the first and largest level.
+\see GenerateMipChain
+*/
+struct MipChain
+{
+    //! Image buffer of all MIP-map levels.
+    ByteBuffer                      data;
+
+    //! Source image descriptors for each MIP-map level. These point into the \c data buffer.
+    std::vector<SrcImageDescriptor> levels;
+
+    //! Extent of each MIP-map level (including array layers).
+    std::vector<Extent3D>           extents;
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Generates a MIP-map chain from the specified image on the CPU.
+\param[in] image Specifies the image of the first MIP-map level. Its format and data type are used for all MIP-map levels.
+For array and cube textures, the array layers must be stored in the height (for 1D arrays) or depth (for all other arrays and cubes) of the image extent.
+\param[in] type Specifies the type of texture the MIP-map chain is generated for. This determines which dimensions are downsampled.
+\param[in] filter Specifies the downsampling filter. Usually ImageFilter::Box or ImageFilter::Kaiser. By default ImageFilter::Box.
+\param[in] sRGB Specifies whether the color components are stored in sRGB color space, so they are filtered in linear space. By default false.
+\param[in] numMipLevels Specifies the number of MIP-map levels to generate. If this is zero, the full MIP-map chain is generated. By default 0.
+\param[in] threadCount Specifies the number of threads to use for each level (see ConvertImageBuffer for more details). By default 0.
+\remarks Each level is downsampled from the previous one. The MIP-map chain can be uploaded without generating the MIP-maps on the GPU like this:
+\code
+auto mipChain = LLGL::GenerateMipChain(myImage, LLGL::TextureType::Texture2D, LLGL::ImageFilter::Kaiser, true);
+
+myTextureDesc.mipLevels = static_cast<std::uint32_t>(mipChain.levels.size());
+auto myTexture = myRenderer->CreateTextureWithMips(myTextureDesc, myTextureDesc.mipLevels, mipChain.levels.data());
+\endcode
+\throw std::invalid_argument If the image has no image buffer or an empty extent.
+\throw std::invalid_argument If \c type is a multi-sampled texture type.
+\throw std::invalid_argument If the image has a compressed or depth-stencil format.
+\see ImageFilter
+\see NumMipLevels(const TextureType, const Extent3D&)
+\see RenderSystem::CreateTextureWithMips
+*/
+LLGL_EXPORT MipChain GenerateMipChain(
+    const Image&        image,
+    const TextureType   type,
+    const ImageFilter   filter          = ImageFilter::Box,
+    bool                sRGB            = false,
+    std::uint32_t       numMipLevels    = 0,
+    std::size_t         threadCount     = 0
+);
+
+
 } // /namespace LLGL
 
 
@@ -34,6 +34,31 @@ Therefore, the byte buffer type is an std::unique_ptr<char[]>.
 using ByteBuffer = std::unique_ptr<char[]>;
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Image resampling filter enumeration.
+\see Image::Resize(const Extent3D&, const ImageFilter, bool, std::size_t)
+*/
+enum class ImageFilter
+{
+    //! Takes the nearest source pixel. This copies the pixels bitwise and is the only filter that supports depth-stencil images.
+    Nearest,
+
+    //! Averages all source pixels the destination pixel covers, weighted by their coverage (also known as area filter).
+    Box,
+
+    //! Interpolates linearly between the source pixels (i.e. bilinear for 2D and trilinear for 3D images). Widens to a tent filter for downsampling.
+    Linear,
+
+    //! Lanczos filter with a radius of 3 pixels. Gives the sharpest results, but can overshoot at hard edges.
+    Lanczos,
+
+    //! Sinc filter with a Kaiser window (radius of 3 pixels, alpha of 4). Commonly used for MIP-map generation as it preserves detail with less ringing than Lanczos.
+    Kaiser,
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -122,8 +147,10 @@ struct DstImageDescriptor
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+The threads are taken from the library-wide thread pool, so the actual number of threads is also limited by its size.
+\remarks If both the image format and data type differ, they are converted in a single pass over the image buffer without an intermediate image buffer.
 \return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination buffer is not modified!
-\note Compressed images and depth-stencil images cannot be converted.
+\note Compressed images and depth-stencil images cannot be converted. Use the overload with an image extent to convert compressed images.
 \throw std::invalid_argument If a compressed image format is specified either as source or destination.
 \throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
 \throw std::invalid_argument If the source buffer size is not a multiple of the source data type size times the image format size.
@@ -131,6 +158,7 @@ the maximal count of threads the system supports will be used (e.g. 4 on a quad-
 \throw std::invalid_argument If the destination buffer size does not match the required output buffer size.
 \throw std::invalid_argument If the destination buffer is a null pointer.
 \see Constants::maxThreadCount
+\see SetThreadPoolSize
 \see DataTypeSize
 \see ImageFormatSize
 */
@@ -148,14 +176,16 @@ LLGL_EXPORT bool ConvertImageBuffer(
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+The threads are taken from the library-wide thread pool, so the actual number of threads is also limited by its size.
 \return Byte buffer with the converted image data or null if no conversion is necessary.
 This can be casted to the respective target data type (e.g. <code>unsigned char</code>, <code>int</code>, <code>float</code> etc.).
-\note Compressed images and depth-stencil images cannot be converted.
+\note Compressed images and depth-stencil images cannot be converted. Use the overload with an image extent to convert compressed images.
 \throw std::invalid_argument If a compressed image format is specified either as source or destination.
 \throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
 \throw std::invalid_argument If the source buffer size is not a multiple of the source data type size times the image format size.
 \throw std::invalid_argument If the source buffer is a null pointer.
 \see Constants::maxThreadCount
+\see SetThreadPoolSize
 \see ByteBuffer
 \see DataTypeSize
 \see ImageFormatSize
@@ -167,6 +197,60 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     std::size_t                 threadCount = 0
 );
 
+/**
+\brief Converts the image format and data type of the source image, including block compression formats.
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[out] dstImageDesc Specifies the destination image descriptor. Its data size must match the size returned by GetImageBufferSize.
+\param[in] extent Specifies the image extent. This is required to locate the 4x4 pixel blocks of compressed images.
+\param[in] threadCount Specifies the number of threads to use for conversion (see the other overload for more details). By default 0.
+\return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination buffer is not modified!
+\remarks This extends the other overload by the compression formats ImageFormat::BC1 to ImageFormat::BC7,
+which can be used either as source or destination format. Compressed images must use DataType::UInt8.
+Images are compressed from and decompressed into RGBA8 with an intermediate conversion if necessary.
+Each slice of a 3D image is compressed separately and the borders of images whose size is not a multiple of 4 are padded by replicating the edge pixels.
+BC1 uses its 1-bit alpha mode for blocks that contain pixels with an alpha value below 128. BC4 compresses the red channel and BC5 the red and green channels.
+BC7 blocks of all modes can be decompressed, but the encoder only emits mode 6 (one subset with RGBA endpoints).
+If neither format is compressed, this is equivalent to the other overload.
+\throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
+\throw std::invalid_argument If a compressed format is specified with another data type than DataType::UInt8.
+\throw std::invalid_argument If the source buffer is too small for the image extent.
+\throw std::invalid_argument If the destination buffer size does not match the required output buffer size.
+\see GetImageBufferSize
+\see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, std::size_t)
+*/
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Converts the image format and data type of the source image, including block compression formats, and returns the new generated image buffer.
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[in] dstFormat Specifies the destination image format.
+\param[in] dstDataType Specifies the destination image data type.
+\param[in] extent Specifies the image extent. This is required to locate the 4x4 pixel blocks of compressed images.
+\param[in] threadCount Specifies the number of threads to use for conversion (see the other overload for more details). By default 0.
+\return Byte buffer with the converted image data or null if no conversion is necessary.
+\remarks See ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, const Extent3D&, std::size_t) for details about the compression formats.
+\see GetImageBufferSize
+*/
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    const Extent3D&             extent,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Returns the size (in bytes) of an image buffer with the specified format, data type, and extent.
+\remarks For the compressed formats, the width and height are rounded up to a multiple of 4, since these formats compress images in 4x4 pixel blocks.
+\see GetMemoryFootprint(const ImageFormat, const DataType, std::uint32_t)
+*/
+LLGL_EXPORT std::size_t GetImageBufferSize(ImageFormat format, DataType dataType, const Extent3D& extent);
+
 /**
 \brief Copies an image buffer region from the source buffer to the destination buffer.
 \param[out] dstImageDesc Specifies the destination image descriptor.
@@ -178,6 +262,7 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
 \param[in] srcRowStride Specifies the number of pixels for each row in the source image.
 \param[in] srcSliceStride Specifies the number of pixels for each slice in the source image.
 \param[in] extent Specifies the region extent to be copied.
+\param[in] threadCount Specifies the number of threads to copy large regions with (see ConvertImageBuffer for more details). By default 0.
 \remarks Only performs a bitwise copy. No blending or other operation is performed.
 \throw std::invalid_argument If the destination buffer is a null pointer.
 \throw std::invalid_argument If the destination buffer size does not match the required output buffer size.
@@ -201,7 +286,9 @@ LLGL_EXPORT void CopyImageBufferRegion(
     std::uint32_t               srcSliceStride,
 
     // Region
-    const Extent3D&             extent
+    const Extent3D&             extent,
+
+    std::size_t                 threadCount = 0
 );
 
 /**
@@ -0,0 +1,169 @@
+/*
+ * ImageStreamConverter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_STREAM_CONVERTER_H
+#define LLGL_IMAGE_STREAM_CONVERTER_H
+
+
+#include "NonCopyable.h"
+#include "ImageFlags.h"
+#include "TextureFlags.h"
+#include <functional>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+class RenderSystem;
+class Texture;
+
+/**
+\brief Converts an image that arrives in chunks of scanlines, e.g. from an image decoder, and forwards it in strips of rows.
+\remarks Only a single strip of the source and destination image is kept in memory, so the peak memory usage is bounded
+by the strip size instead of the image size. This allows uploading huge textures without ever holding the entire image in RAM:
+\code
+LLGL::ImageStreamConverter converter { *myRenderer, *myTexture, myTextureRegion, LLGL::ImageFormat::RGB, LLGL::DataType::UInt8 };
+while (!converter.IsComplete()) {
+    auto scanlines = myDecoder.DecodeNextScanlines();
+    converter.Write(scanlines.data(), scanlines.size());
+}
+\endcode
+The rows of each slice are written from top to bottom, and the slices from front to back. A strip never spans multiple slices.
+\see ConvertImageBuffer
+\see RenderSystem::WriteTexture
+*/
+class LLGL_EXPORT ImageStreamConverter : public NonCopyable
+{
+
+    public:
+
+        /**
+        \brief Callback function for each converted strip of rows.
+        \param[in] offset Specifies the offset of the strip within the image. The X coordinate is always zero.
+        \param[in] extent Specifies the extent of the strip. The width is always the image width and the depth is always 1.
+        \param[in] imageDesc Specifies the image data of the strip in the destination format and data type.
+        The image data is only valid until the callback returns.
+        */
+        using WriteStripFunction = std::function<void(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc)>;
+
+    public:
+
+        /**
+        \brief Constructs the converter with a callback function for each converted strip, e.g. to forward the strips to Image::WritePixels.
+        \param[in] extent Specifies the extent of the entire image.
+        \param[in] srcFormat Specifies the image format of the incoming scanlines. This must not be a compressed format.
+        \param[in] srcDataType Specifies the data type of the incoming scanlines.
+        \param[in] dstFormat Specifies the image format the strips are converted to. This can also be a block compression format (ImageFormat::BC1 to ImageFormat::BC7).
+        \param[in] dstDataType Specifies the data type the strips are converted to.
+        \param[in] writeStripFunc Specifies the callback function for each converted strip.
+        \param[in] maxStripSize Specifies the maximal size (in bytes) of the source and destination strip together.
+        If this is 0, a default size of 4 MB is used. A strip contains at least one row, or four rows for compressed destination formats.
+        \param[in] threadCount Specifies the number of threads to convert each strip with (see ConvertImageBuffer for more details). By default 0.
+        \throw std::invalid_argument If the source format is a compressed format.
+        \throw std::invalid_argument If 'writeStripFunc' is empty.
+        */
+        ImageStreamConverter(
+            const Extent3D&             extent,
+            const ImageFormat           srcFormat,
+            const DataType              srcDataType,
+            const ImageFormat           dstFormat,
+            const DataType              dstDataType,
+            const WriteStripFunction&   writeStripFunc,
+            std::size_t                 maxStripSize    = 0,
+            std::size_t                 threadCount     = 0
+        );
+
+        /**
+        \brief Constructs the converter to upload the strips into a texture region with RenderSystem::WriteTexture.
+        \param[in] renderSystem Specifies the render system to write the texture with. This must outlive the converter.
+        \param[in] texture Specifies the destination texture. This must outlive the converter.
+        \param[in] textureRegion Specifies the texture region to write. Each array layer of the region is streamed as a separate slice.
+        \param[in] srcFormat Specifies the image format of the incoming scanlines.
+        \param[in] srcDataType Specifies the data type of the incoming scanlines.
+        \param[in] maxStripSize Specifies the maximal size (in bytes) of the source and destination strip together. By default 4 MB.
+        \param[in] threadCount Specifies the number of threads to convert each strip with. By default 0.
+        \remarks The strips are converted into the image format and data type of the texture format, so the renderer does not need to allocate an intermediate image buffer.
+        \see RenderSystem::WriteTexture
+        */
+        ImageStreamConverter(
+            RenderSystem&               renderSystem,
+            Texture&                    texture,
+            const TextureRegion&        textureRegion,
+            const ImageFormat           srcFormat,
+            const DataType              srcDataType,
+            std::size_t                 maxStripSize    = 0,
+            std::size_t                 threadCount     = 0
+        );
+
+        /**
+        \brief Writes the next chunk of the source image. The chunk does not need to end on a row boundary.
+        \param[in] data Pointer to the chunk of source image data.
+        \param[in] dataSize Specifies the size (in bytes) of the chunk.
+        \return Number of bytes that were consumed. This is less than 'dataSize' only if the chunk exceeds the end of the image.
+        \remarks Each time a strip is complete, it is converted and passed to the callback function.
+        If the chunk contains entire strips, they are converted directly from the chunk without copying them into the internal strip buffer.
+        */
+        std::size_t Write(const void* data, std::size_t dataSize);
+
+        /**
+        \brief Converts and forwards all complete rows that are pending in the internal strip buffer.
+        \remarks For compressed destination formats, only complete rows of 4x4 blocks are forwarded.
+        */
+        void Flush();
+
+        //! Returns true if the entire image has been written and forwarded.
+        bool IsComplete() const;
+
+        //! Returns the number of bytes of the source image that have not been written yet.
+        std::size_t GetRemainingSize() const;
+
+        //! Returns the maximal number of rows per strip.
+        inline std::uint32_t GetStripRows() const
+        {
+            return stripRows_;
+        }
+
+    private:
+
+        void Initialize(std::size_t maxStripSize);
+
+        void ConvertStrip(const char* src, std::uint32_t numRows);
+
+    private:
+
+        Extent3D            extent_;
+        ImageFormat         srcFormat_      = ImageFormat::RGBA;
+        DataType            srcDataType_    = DataType::UInt8;
+        ImageFormat         dstFormat_      = ImageFormat::RGBA;
+        DataType            dstDataType_    = DataType::UInt8;
+        WriteStripFunction  writeStripFunc_;
+        std::size_t         threadCount_    = 0;
+
+        std::size_t         srcRowSize_     = 0;
+        std::uint32_t       stripRows_      = 0;
+        std::uint32_t       rowAlignment_   = 1;
+
+        ByteBuffer          srcStrip_;
+        std::size_t         srcStripSize_   = 0;
+        ByteBuffer          dstStrip_;
+
+        std::uint32_t       currentRow_     = 0;
+        std::uint32_t       currentSlice_   = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
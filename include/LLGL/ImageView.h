@@ -0,0 +1,115 @@
+/*
+ * ImageView.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_VIEW_H
+#define LLGL_IMAGE_VIEW_H
+
+
+#include "Export.h"
+#include "Types.h"
+#include "ImageFlags.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Non-owning, read-only view of an image buffer and its attributes.
+
+This is the counterpart to the Image class for image buffers that are managed elsewhere, e.g. by a memory-mapped file or a third-party image loader.
+Since no image buffer is copied, it can be used to pass large images to Image::Blit, ConvertImageBuffer, or RenderSystem::CreateTexture without a heap allocation.
+\remarks The image buffer must remain valid for the lifetime of this view.
+In contrast to the Image class, all sizes are returned as \c std::size_t, so views can also refer to image buffers larger than 4 GB.
+\see Image::GetView
+\see Blob::CreateFromMappedFile
+*/
+class LLGL_EXPORT ImageView
+{
+
+    public:
+
+        ImageView() = default;
+
+        /**
+        \brief Constructor to initialize the view with all attributes and the image buffer specified by the 'data' parameter.
+        \note If the specified data does not point to an image buffer of the specified extent and format, the behavior is undefined.
+        */
+        ImageView(const Extent3D& extent, const ImageFormat format, const DataType dataType, const void* data);
+
+        /**
+        \brief Reads a region of pixels from this image view into the destination image buffer specified by 'imageDesc'.
+        \remarks This behaves the same as Image::ReadPixels. If the region consists of entire rows of this image,
+        a conversion reads directly from the image buffer without a temporary copy.
+        \see Image::ReadPixels
+        */
+        void ReadPixels(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, std::size_t threadCount = 0) const;
+
+        //! Returns a source image descriptor for this image view, e.g. to pass it to RenderSystem::CreateTexture.
+        SrcImageDescriptor GetSrcDesc() const;
+
+        //! Returns the extent of the image as 3D vector.
+        inline const Extent3D& GetExtent() const
+        {
+            return extent_;
+        }
+
+        //! Returns the format for each pixel. By default ImageFormat::RGBA.
+        inline ImageFormat GetFormat() const
+        {
+            return format_;
+        }
+
+        //! Returns the data type for each pixel component. By default DataType::UInt8.
+        inline DataType GetDataType() const
+        {
+            return dataType_;
+        }
+
+        //! Returns the image data buffer as constant raw pointer.
+        inline const void* GetData() const
+        {
+            return data_;
+        }
+
+        //! Returns the size (in bytes) for each pixel, or 0 for compressed formats.
+        std::size_t GetBytesPerPixel() const;
+
+        //! Returns the stride (in bytes) for each row, or for each row of 4x4 pixel blocks for compressed formats.
+        std::size_t GetRowStride() const;
+
+        //! Returns the stride (in bytes) for each depth slice. This includes the padding of compressed formats.
+        std::size_t GetDepthStride() const;
+
+        //! Returns the number of pixels this image view has.
+        std::size_t GetNumPixels() const;
+
+        //! Returns the size (in bytes) of the image buffer.
+        std::size_t GetDataSize() const;
+
+        //! Returns true if the specified sub-image region is inside the image.
+        bool IsRegionInside(const Offset3D& offset, const Extent3D& extent) const;
+
+    private:
+
+        Extent3D    extent_;
+        ImageFormat format_     = ImageFormat::RGBA;
+        DataType    dataType_   = DataType::UInt8;
+        const void* data_       = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
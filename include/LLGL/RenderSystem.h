@@ -179,6 +179,16 @@ class LLGL_EXPORT RenderSystem : public Interface
             return config_;
         }
 
+        /**
+        \brief Queries the current device memory statistics of this render system.
+        \param[out] stats Specifies the output statistics.
+        \return True if the statistics could be queried. Otherwise, the render system does not manage device memory by itself and the output is left unchanged.
+        \remarks This is currently only supported by the Vulkan render system.
+        This function can be called frequently, e.g. once per second, to monitor the device memory fragmentation in production.
+        \see MemoryStatistics
+        */
+        virtual bool QueryMemoryStatistics(MemoryStatistics& stats);
+
         /* ----- Render Context ----- */
 
         /**
@@ -288,6 +298,25 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual Texture* CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc = nullptr) = 0;
 
+        /**
+        \brief Creates a new texture and initializes its MIP-map levels with the specified images, e.g. with a MIP-map chain that was generated on the CPU.
+        \param[in] textureDesc Specifies the texture descriptor. The flag MiscFlags::GenerateMips is ignored, since the MIP-map levels are provided by \c mipImages.
+        \param[in] numMipImages Specifies the number of MIP-map images. This must be greater than zero and must not exceed the number of MIP-map levels of the texture.
+        \param[in] mipImages Pointer to an array of \c numMipImages image descriptors, one for each MIP-map level beginning with the first and largest level.
+        Each image must contain all array layers of its MIP-map level.
+        \remarks The storage of all MIP-map levels is allocated once and initialized with the first image, then the remaining images are uploaded into their levels,
+        so no MIP-maps are generated on the GPU. The Vulkan render system records all uploads into the same staging batch.
+        MIP-map levels beyond \c numMipImages are left uninitialized.
+        \code
+        auto myMipChain = LLGL::GenerateMipChain(myImage, LLGL::TextureType::Texture2D, LLGL::ImageFilter::Kaiser, true);
+        auto myTexture = myRenderer->CreateTextureWithMips(myTextureDesc, static_cast<std::uint32_t>(myMipChain.levels.size()), myMipChain.levels.data());
+        \endcode
+        \throw std::invalid_argument If \c numMipImages is zero or exceeds the number of MIP-map levels, if \c mipImages is null, or if the texture is multi-sampled.
+        \see GenerateMipChain
+        \see CreateTexture
+        */
+        virtual Texture* CreateTextureWithMips(const TextureDescriptor& textureDesc, std::uint32_t numMipImages, const SrcImageDescriptor* mipImages);
+
         //! Releases the specified texture object. After this call, the specified object must no longer be used.
         virtual void Release(Texture& texture) = 0;
 
@@ -466,6 +495,9 @@ class LLGL_EXPORT RenderSystem : public Interface
             );
         }
         \endcode
+        \note For Vulkan, the serialized cache contains the device-wide pipeline cache instead of a single pipeline state.
+        It is merged into the pipeline cache of the render system (if it was created on the same device and driver version) and the return value is always null.
+        All subsequently created pipeline states benefit from this cache. See also RendererConfigurationVulkan::pipelineCacheFilename.
         \see CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
         \see CreatePipelineState(const ComputePipelineDescriptor&, std::unique_ptr<Blob>*)
         */
@@ -186,6 +186,25 @@ enum class CPUAccess
     ReadWrite,
 };
 
+/**
+\brief Dispatch mode enumeration for the execution of deferred command buffers.
+\see RenderSystemConfiguration::commandDispatch
+*/
+enum class CommandDispatchMode
+{
+    /**
+    \brief Commands are dispatched by their opcode with a single \c switch statement. This is the default value.
+    */
+    Switch,
+
+    /**
+    \brief Commands are decoded into an array of function pointers on their first execution, and called directly.
+    \remarks This avoids the indirect branch of the \c switch statement for every command,
+    at the cost of additional memory for the decoded commands, which are kept until the command buffer is recorded again.
+    */
+    Threaded,
+};
+
 
 /* ----- Structures ----- */
 
@@ -202,6 +221,14 @@ struct RenderSystemConfiguration
     \see Constants::maxThreadCount
     */
     std::size_t threadCount = Constants::maxThreadCount;
+
+    /**
+    \brief Specifies how deferred command buffers are dispatched on submission. By default CommandDispatchMode::Switch.
+    \remarks The dispatch mode can be changed between submissions of the same command buffer.
+    If a command buffer has been compiled into native code, the native code is executed regardless of this mode.
+    \note Only supported with: OpenGL.
+    */
+    CommandDispatchMode commandDispatch = CommandDispatchMode::Switch;
 };
 
 /**
@@ -251,6 +278,48 @@ struct RendererInfo
     std::vector<std::string>    extensionNames;
 };
 
+/**
+\brief Device memory statistics structure.
+\remarks The fragmentation of the device memory can be estimated by the ratio between the largest free block and the entire free memory,
+i.e. <code>1 - largestFreeBlockSize / (chunkMemorySize - blockMemorySize)</code>.
+\see RenderSystem::QueryMemoryStatistics
+*/
+struct MemoryStatistics
+{
+    //! Number of device memory allocations (so called chunks) that were requested from the driver.
+    std::uint64_t   numChunks               = 0;
+
+    //! Number of chunks that are currently empty but not yet released to the driver.
+    std::uint64_t   numEmptyChunks          = 0;
+
+    //! Number of resource blocks that are sub-allocated within the chunks.
+    std::uint64_t   numBlocks               = 0;
+
+    //! Number of free blocks within the chunks, i.e. the number of memory fragments.
+    std::uint64_t   numFreeBlocks           = 0;
+
+    //! Size (in bytes) of all chunks.
+    std::uint64_t   chunkMemorySize         = 0;
+
+    //! Size (in bytes) of all resource blocks.
+    std::uint64_t   blockMemorySize         = 0;
+
+    //! Size (in bytes) of the largest free block within any chunk.
+    std::uint64_t   largestFreeBlockSize    = 0;
+
+    /**
+    \brief Device memory budget (in bytes) of this process over all memory heaps as reported by the driver.
+    \remarks This is zero if the driver does not report memory budgets, e.g. if the Vulkan extension \c VK_EXT_memory_budget is not available.
+    */
+    std::uint64_t   budget                  = 0;
+
+    /**
+    \brief Device memory usage (in bytes) of this process over all memory heaps as reported by the driver.
+    \remarks This is zero if the driver does not report memory budgets, e.g. if the Vulkan extension \c VK_EXT_memory_budget is not available.
+    */
+    std::uint64_t   usage                   = 0;
+};
+
 /**
 \brief Render system descriptor structure.
 \remarks This can be used for some refinements of a specific renderer, e.g. to configure the Vulkan device memory manager.
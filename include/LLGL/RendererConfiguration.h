@@ -18,6 +18,9 @@ namespace LLGL
 {
 
 
+class RenderingProfiler;
+
+
 /* ----- Enumerations ----- */
 
 /**
@@ -98,6 +101,44 @@ struct RendererConfigurationVulkan
     \todo Remove this as soon as Vulkan memory manage has been improved.
     */
     bool                        reduceDeviceMemoryFragmentation = false;
+
+    /**
+    \brief Specifies whether device memory blocks are sub-allocated with a two-level segregated fit (TLSF) allocator. By default false.
+    \remarks If this is true, each VkDeviceMemory chunk manages its free blocks in size-class bins,
+    so that allocating and releasing a block takes constant time regardless of the number of blocks within a chunk.
+    This is recommended for applications that create and release a large number of buffers and images, e.g. when loading a level.
+    If this is true, \c reduceDeviceMemoryFragmentation is ignored, since free blocks are always merged immediately.
+    */
+    bool                        tlsfDeviceMemoryAllocator       = false;
+
+    /**
+    \brief Specifies the maximal number of bytes that are moved per frame to defragment the device memory chunks. By default 0, i.e. the defragmentation is disabled.
+    \remarks If this is greater than zero, buffers are incrementally moved out of sparsely occupied VkDeviceMemory chunks
+    into the free blocks of other chunks whenever a render context presents its content, so the emptied chunks can be released.
+    A moved buffer gets a new native buffer object, so command buffers that refer to a moved buffer must be recorded again; they are typically recorded once per frame.
+    Buffers that are referenced by a resource heap or a buffer array, as well as all textures, are never moved.
+    At least one buffer is moved per frame, even if it is larger than this budget.
+    */
+    std::uint64_t               maxDeviceMemoryDefragSizePerFrame = 0;
+
+    /**
+    \brief Size (in bytes) of the persistently mapped staging ring for buffer and texture uploads. By default 16*1024*1024, i.e. 16 MB of host visible memory.
+    \remarks Uploads via RenderSystem::CreateBuffer, RenderSystem::WriteBuffer, RenderSystem::CreateTexture, and RenderSystem::WriteTexture are written into this ring
+    and their transfer commands are batched. A batch is submitted without waiting for its completion whenever a command buffer or fence is submitted or a render context presents its content,
+    so the CPU only waits for the GPU if the ring is full. Uploads that are larger than the ring, as well as buffers with CPU access or dynamic usage, use a temporary or dedicated staging buffer and wait for their completion.
+    If this is zero, the staging ring is disabled and each upload waits for its completion.
+    */
+    std::uint64_t               stagingRingSize                 = 16*1024*1024;
+
+    /**
+    \brief Optional filename of the device-wide pipeline cache. By default empty.
+    \remarks If this is not empty, the pipeline cache is loaded from this file when the render system is created,
+    and it is stored back to this file when the render system is destroyed.
+    A pipeline cache that was created on a different device or with a different driver version is ignored.
+    All pipeline states that are created with the same render system share this cache, which reduces the pipeline creation time on subsequent application runs.
+    \see RenderSystem::CreatePipelineState(const Blob&)
+    */
+    std::string                 pipelineCacheFilename;
 };
 
 /**
@@ -122,6 +163,24 @@ struct RendererConfigurationOpenGL
     \remarks This member is ignored if \c contextProfile is OpenGLContextProfile::CompatibilityProfile.
     */
     int                     minorVersion    = 0;
+
+    /**
+    \brief Specifies an optional profiler that receives the number of issued and elided GL state changes on each command queue submission. By default null.
+    \remarks The counters are accumulated into the FrameProfile members \c issuedCapabilityChanges to \c elidedShaderProgramBindings.
+    The statistics of the command buffer optimizer are accumulated into the FrameProfile members \c optimizedStateCommands to \c optimizedDrawCommands.
+    This can be the same profiler that is passed to RenderSystem::Load. The profiler must outlive the render system.
+    \see FrameProfile::issuedCapabilityChanges
+    \see FrameProfile::optimizedStateCommands
+    */
+    RenderingProfiler*      profiler        = nullptr;
+
+    /**
+    \brief Specifies an optional filename to record a compact binary trace of all GL state changes. By default empty.
+    \remarks Each record specifies the state category, whether the GL call was issued or elided, and the affected object.
+    The state changes of all render contexts are recorded into the same trace, and each command queue submission is marked with a separate record.
+    This is meant for offline analysis of redundant state changes and has a noticeable overhead.
+    */
+    std::string             stateTraceFilename;
 };
 
 /**
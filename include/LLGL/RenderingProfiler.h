@@ -270,10 +270,146 @@ struct FrameProfile
             \see CommandQueue::Submit(Fence&)
             */
             std::uint32_t fenceSubmissions;
+
+            /**
+            \brief Counter for all GL capability changes (i.e. \c glEnable and \c glDisable) that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedCapabilityChanges;
+
+            /**
+            \brief Counter for all GL capability changes (i.e. \c glEnable and \c glDisable) that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedCapabilityChanges;
+
+            /**
+            \brief Counter for all fixed-function GL state changes (e.g. \c glDepthFunc, \c glViewport) that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedRenderStateChanges;
+
+            /**
+            \brief Counter for all fixed-function GL state changes (e.g. \c glDepthFunc, \c glViewport) that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedRenderStateChanges;
+
+            /**
+            \brief Counter for all GL buffer bindings (e.g. \c glBindBuffer, \c glBindBufferBase) that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedBufferBindings;
+
+            /**
+            \brief Counter for all GL buffer bindings (e.g. \c glBindBuffer, \c glBindBufferBase) that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedBufferBindings;
+
+            /**
+            \brief Counter for all GL vertex array object bindings (i.e. \c glBindVertexArray) that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedVertexArrayBindings;
+
+            /**
+            \brief Counter for all GL vertex array object bindings (i.e. \c glBindVertexArray) that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedVertexArrayBindings;
+
+            /**
+            \brief Counter for all GL framebuffer and renderbuffer bindings that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedFramebufferBindings;
+
+            /**
+            \brief Counter for all GL framebuffer and renderbuffer bindings that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedFramebufferBindings;
+
+            /**
+            \brief Counter for all GL texture bindings and active texture changes (e.g. \c glBindTexture, \c glActiveTexture) that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedTextureBindings;
+
+            /**
+            \brief Counter for all GL texture bindings and active texture changes (e.g. \c glBindTexture, \c glActiveTexture) that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedTextureBindings;
+
+            /**
+            \brief Counter for all GL sampler bindings (i.e. \c glBindSampler) that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedSamplerBindings;
+
+            /**
+            \brief Counter for all GL sampler bindings (i.e. \c glBindSampler) that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedSamplerBindings;
+
+            /**
+            \brief Counter for all GL shader program bindings (i.e. \c glUseProgram) that have been issued to the driver.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t issuedShaderProgramBindings;
+
+            /**
+            \brief Counter for all GL shader program bindings (i.e. \c glUseProgram) that have been elided by the state manager because they were redundant.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t elidedShaderProgramBindings;
+
+            /**
+            \brief Counter for all redundant state commands that have been removed from the submitted command buffers by the command buffer optimizer.
+            \remarks This is counted on each submission of a command buffer that has been created with the CommandBufferFlags::Optimize flag.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t optimizedStateCommands;
+
+            /**
+            \brief Counter for all redundant clear commands that have been removed from the submitted command buffers by the command buffer optimizer.
+            \remarks This is counted on each submission of a command buffer that has been created with the CommandBufferFlags::Optimize flag.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t optimizedClearCommands;
+
+            /**
+            \brief Counter for all draw commands of the submitted command buffers that have been merged into multi-draw commands by the command buffer optimizer.
+            \remarks This is counted on each submission of a command buffer that has been created with the CommandBufferFlags::Optimize flag.
+            \note Only supported with: OpenGL.
+            \see RendererConfigurationOpenGL::profiler
+            */
+            std::uint32_t optimizedDrawCommands;
         };
 
         //! All proflile values as linear array.
-        std::uint32_t values[34];
+        std::uint32_t values[53];
     };
 
     /**
@@ -0,0 +1,205 @@
+/*
+ * SortedCommandEncoder.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SORTED_COMMAND_ENCODER_H
+#define LLGL_SORTED_COMMAND_ENCODER_H
+
+#ifdef LLGL_ENABLE_UTILITY
+
+/*
+THIS HEADER MUST BE EXPLICITLY INCLUDED
+*/
+
+#include "Export.h"
+#include "Constants.h"
+#include "ForwardDecls.h"
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Structures ----- */
+
+/**
+\brief Draw packet structure for the SortedCommandEncoder.
+\remarks A draw packet contains all states that are needed for a single draw command.
+The draw command is indexed if \c indexBuffer is non-null, and it is instanced if \c numInstances is not 1 or \c firstInstance is not 0.
+\see SortedCommandEncoder::Submit
+*/
+struct DrawPacket
+{
+    /**
+    \brief Specifies the key by which the draw packets are sorted in ascending order. By default 0.
+    \remarks Draw packets with equal keys are encoded in the same order as they were submitted.
+    \see SortedCommandEncoder
+    */
+    std::uint64_t   sortKey         = 0;
+
+    //! Specifies the graphics pipeline state. This must not be null.
+    PipelineState*  pipelineState   = nullptr;
+
+    //! Specifies the optional resource heap. By default null.
+    ResourceHeap*   resourceHeap    = nullptr;
+
+    //! Specifies the first descriptor set of the resource heap. By default 0.
+    std::uint32_t   firstSet        = 0;
+
+    //! Specifies the optional vertex buffer. By default null.
+    Buffer*         vertexBuffer    = nullptr;
+
+    //! Specifies the optional index buffer. If this is non-null, the draw command is indexed. By default null.
+    Buffer*         indexBuffer     = nullptr;
+
+    //! Specifies the number of vertices or indices to draw. By default 0.
+    std::uint32_t   numVertices     = 0;
+
+    //! Specifies the first vertex or the first index (if \c indexBuffer is non-null) to draw. By default 0.
+    std::uint32_t   firstVertex     = 0;
+
+    //! Specifies the offset that is added to each index. Only used if \c indexBuffer is non-null. By default 0.
+    std::int32_t    vertexOffset    = 0;
+
+    //! Specifies the number of instances to draw. By default 1.
+    std::uint32_t   numInstances    = 1;
+
+    //! Specifies the first instance to draw. By default 0.
+    std::uint32_t   firstInstance   = 0;
+};
+
+/**
+\brief Statistics of the last call to SortedCommandEncoder::Encode.
+\see SortedCommandEncoder::GetStats
+*/
+struct SortedCommandEncoderStats
+{
+    //! Number of draw commands that have been encoded.
+    std::uint32_t drawCommands              = 0;
+
+    //! Number of calls to CommandBuffer::SetPipelineState that have been encoded.
+    std::uint32_t pipelineBindings          = 0;
+
+    //! Number of calls to CommandBuffer::SetResourceHeap that have been encoded.
+    std::uint32_t resourceHeapBindings      = 0;
+
+    //! Number of calls to CommandBuffer::SetVertexBuffer that have been encoded.
+    std::uint32_t vertexBufferBindings      = 0;
+
+    //! Number of calls to CommandBuffer::SetIndexBuffer that have been encoded.
+    std::uint32_t indexBufferBindings       = 0;
+};
+
+
+/* ----- Classes ----- */
+
+/**
+\brief Utility class that sorts draw packets by a 64-bit key and encodes them into a command buffer with as few state changes as possible.
+\remarks This class only uses the CommandBuffer interface, so it works with all render systems and the debug layer.
+The sort key is entirely specified by the client. The most significant bits should contain the most expensive state changes, for example:
+\code
+// Bits 48-63: pipeline state ID, bits 32-47: resource heap ID, bits 16-31: vertex buffer ID, bits 0-15: front-to-back depth
+packet.sortKey = (pipelineID << 48) | (resourceHeapID << 32) | (vertexBufferID << 16) | depth;
+\endcode
+The draw packets are sorted with a radix sort that is distributed among the worker threads of the library-wide thread pool.
+While encoding, redundant calls to \c SetPipelineState, \c SetResourceHeap, \c SetVertexBuffer, and \c SetIndexBuffer are merged.
+Since some render systems invalidate the bound resources when the pipeline layout changes, the resource heap is always set again after a pipeline state change.
+\note This class is not thread-safe, i.e. the draw packets must be submitted from a single thread at a time.
+\see SetThreadPoolSize
+*/
+class LLGL_EXPORT SortedCommandEncoder
+{
+
+    public:
+
+        /**
+        \brief Initializes the encoder with the maximum number of threads that are used to sort the draw packets.
+        \param[in] threadCount Specifies the maximum number of threads, including the calling thread. By default Constants::maxThreadCount.
+        \see SetThreadPoolSize
+        */
+        SortedCommandEncoder(std::uint32_t threadCount = Constants::maxThreadCount);
+
+        SortedCommandEncoder(const SortedCommandEncoder&) = delete;
+        SortedCommandEncoder& operator = (const SortedCommandEncoder&) = delete;
+
+        //! Removes all draw packets but keeps the allocated memory.
+        void Reset();
+
+        //! Appends the specified draw packet.
+        void Submit(const DrawPacket& packet);
+
+        //! Appends the specified array of draw packets.
+        void Submit(std::size_t numPackets, const DrawPacket* packets);
+
+        /**
+        \brief Sorts all draw packets by their sort keys. This is called automatically by \c Encode if the packets are not sorted yet.
+        \remarks The sort is stable, i.e. draw packets with equal keys keep their submission order.
+        */
+        void Sort();
+
+        /**
+        \brief Encodes all draw packets in sorted order into the specified command buffer.
+        \param[in] commandBuffer Specifies the command buffer to encode the draw commands into.
+        This command buffer must be in encoding mode and a render pass must be active, i.e. between \c BeginRenderPass and \c EndRenderPass.
+        \remarks The draw packets are kept after this call, so they can be encoded multiple times until \c Reset is called.
+        The state of the command buffer is assumed to be unknown before this call, so the first draw packet always sets all of its states.
+        \throws std::invalid_argument If a draw packet has no pipeline state.
+        */
+        void Encode(CommandBuffer& commandBuffer);
+
+        //! Returns the number of draw packets that have been submitted since the last call to \c Reset.
+        inline std::size_t GetNumPackets() const
+        {
+            return packets_.size();
+        }
+
+        //! Returns the statistics of the last call to \c Encode.
+        inline const SortedCommandEncoderStats& GetStats() const
+        {
+            return stats_;
+        }
+
+    private:
+
+        // Sort key and index of a draw packet.
+        struct SortEntry
+        {
+            std::uint64_t key;
+            std::uint32_t index;
+        };
+
+    private:
+
+        std::uint32_t               threadCount_    = 0;
+        bool                        sorted_         = true;
+
+        std::vector<DrawPacket>     packets_;
+        std::vector<SortEntry>      entries_;
+        std::vector<SortEntry>      entriesTemp_;
+        std::vector<std::uint32_t>  histograms_;
+
+        SortedCommandEncoderStats   stats_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#else
+
+#error LLGL was not compiled with LLGL_ENABLE_UTILITY option
+
+#endif
+
+#endif
+
+
+
+// ================================================================================
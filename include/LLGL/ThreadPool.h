@@ -0,0 +1,69 @@
+/*
+ * ThreadPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include "Export.h"
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Functions ----- */
+
+/**
+\defgroup group_thread_pool Functions to configure the library-wide thread pool.
+\addtogroup group_thread_pool
+@{
+*/
+
+/**
+\brief Sets the number of persistent worker threads that are used by the multi-threaded functions of this library.
+\param[in] numWorkers Specifies the number of worker threads. The calling thread of a multi-threaded function always participates as well,
+so a value of 0 disables multi-threading entirely. If this is 'Constants::maxThreadCount', one worker thread for each hardware thread
+except the calling thread is used (e.g. 3 on a quad-core processor). This is also the default value.
+\remarks The worker threads are created on first use and are shared between all functions that take a \c threadCount parameter,
+such as ConvertImageBuffer, Image::Convert, Image::ReadPixels, and Image::WritePixels.
+Their \c threadCount parameter only limits how many of these threads are used for a single call.
+This function must not be called while any of these functions is running on another thread.
+\see ConvertImageBuffer
+\see Constants::maxThreadCount
+*/
+LLGL_EXPORT void SetThreadPoolSize(std::size_t numWorkers);
+
+/**
+\brief Returns the number of persistent worker threads.
+\see SetThreadPoolSize
+*/
+LLGL_EXPORT std::size_t GetThreadPoolSize();
+
+/**
+\brief Stops and joins all worker threads of the thread pool.
+\remarks This is called automatically when the last render system is unloaded (see RenderSystem::Unload).
+Applications that use the multi-threaded image functions without a render system should call this function before they exit,
+or before the LLGL library is unloaded, because the worker threads must not outlive the library.
+The pool starts the number of worker threads that was last set by SetThreadPoolSize again on next use.
+This function must not be called while any multi-threaded function is running on another thread.
+\see SetThreadPoolSize
+*/
+LLGL_EXPORT void ShutdownThreadPool();
+
+/** @} */
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
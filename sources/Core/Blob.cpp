@@ -10,6 +10,16 @@
 #include <fstream>
 #include "Helper.h"
 
+#ifdef _WIN32
+#   include "../Platform/Win32/Win32LeanAndMean.h"
+#   include <Windows.h>
+#else
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
 
 namespace LLGL
 {
@@ -151,6 +161,111 @@ using BlobStdVectorInt8 = BlobContainer<std::vector<std::int8_t>>;
 using BlobStdString     = BlobContainer<std::string>;
 
 
+/*
+ * BlobMappedFile class
+ */
+
+// Memory-mapped file implementation of <Blob> interface.
+class BlobMappedFile final : public Blob
+{
+
+    public:
+
+        BlobMappedFile(const void* data, std::size_t size);
+        ~BlobMappedFile();
+
+    public:
+
+        const void* GetData() const override;
+        std::size_t GetSize() const override;
+
+    private:
+
+        const void* data_ = nullptr;
+        std::size_t size_ = 0;
+
+};
+
+BlobMappedFile::BlobMappedFile(const void* data, std::size_t size) :
+    data_ { data },
+    size_ { size }
+{
+}
+
+BlobMappedFile::~BlobMappedFile()
+{
+    #ifdef _WIN32
+    ::UnmapViewOfFile(data_);
+    #else
+    ::munmap(const_cast<void*>(data_), size_);
+    #endif
+}
+
+const void* BlobMappedFile::GetData() const
+{
+    return data_;
+}
+
+std::size_t BlobMappedFile::GetSize() const
+{
+    return size_;
+}
+
+// Maps the entire file read-only into memory and returns the view and file size, or null if the file could not be mapped.
+static const void* MapFileIntoMemory(const char* filename, std::size_t& size)
+{
+    #ifdef _WIN32
+
+    HANDLE file = ::CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    const void* data = nullptr;
+
+    LARGE_INTEGER fileSize;
+    if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        /* The view keeps a reference to the mapping object, so both handles can be closed after mapping */
+        if (HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr))
+        {
+            data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            size = static_cast<std::size_t>(fileSize.QuadPart);
+            ::CloseHandle(mapping);
+        }
+    }
+
+    ::CloseHandle(file);
+
+    return data;
+
+    #else
+
+    int file = ::open(filename, O_RDONLY);
+    if (file == -1)
+        return nullptr;
+
+    const void* data = nullptr;
+
+    struct stat fileStat;
+    if (::fstat(file, &fileStat) == 0 && fileStat.st_size > 0)
+    {
+        /* The mapping keeps a reference to the file, so the descriptor can be closed after mapping */
+        void* view = ::mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (view != MAP_FAILED)
+        {
+            data = view;
+            size = static_cast<std::size_t>(fileStat.st_size);
+        }
+    }
+
+    ::close(file);
+
+    return data;
+
+    #endif
+}
+
+
 /*
  * Blob class
  */
@@ -203,6 +318,24 @@ std::unique_ptr<Blob> Blob::CreateFromFile(const std::string& filename)
     return CreateFromFile(filename.c_str());
 }
 
+std::unique_ptr<Blob> Blob::CreateFromMappedFile(const char* filename)
+{
+    if (filename == nullptr || *filename == '\0')
+        return nullptr;
+
+    /* Map file into memory (empty files cannot be mapped) */
+    std::size_t size = 0;
+    if (auto data = MapFileIntoMemory(filename, size))
+        return MakeUnique<BlobMappedFile>(data, size);
+
+    return nullptr;
+}
+
+std::unique_ptr<Blob> Blob::CreateFromMappedFile(const std::string& filename)
+{
+    return CreateFromMappedFile(filename.c_str());
+}
+
 
 } // /namespace LLGL
 
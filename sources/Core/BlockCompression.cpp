@@ -0,0 +1,1490 @@
+/*
+ * BlockCompression.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BlockCompression.h"
+#include "WorkerPool.h"
+#include <LLGL/Platform/Platform.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#if defined LLGL_ARCH_AMD64
+#   define LLGL_SIMD_SSE2
+#   include <emmintrin.h>
+#elif defined LLGL_ARCH_ARM64
+#   define LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal constants ----- */
+
+// Minimal number of blocks each worker shall process.
+static const std::size_t g_blockMinWorkSize = 256;
+
+// Pixels with an alpha value below this threshold are encoded as transparent in BC1.
+static const int g_bc1AlphaThreshold = 128;
+
+// Number of least-squares iterations to refine the color endpoints.
+static const int g_numRefineIterations = 2;
+
+
+/* ----- Color helpers ----- */
+
+static int ClampByte(int x)
+{
+    return std::max(0, std::min(x, 255));
+}
+
+static int Expand5(int x)
+{
+    return ((x << 3) | (x >> 2));
+}
+
+static int Expand6(int x)
+{
+    return ((x << 2) | (x >> 4));
+}
+
+static std::uint16_t PackRGB565(const int (&rgb)[3])
+{
+    const auto r = (ClampByte(rgb[0]) * 31 + 127) / 255;
+    const auto g = (ClampByte(rgb[1]) * 63 + 127) / 255;
+    const auto b = (ClampByte(rgb[2]) * 31 + 127) / 255;
+    return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRGB565(std::uint16_t color, int (&rgb)[3])
+{
+    rgb[0] = Expand5((color >> 11) & 0x1F);
+    rgb[1] = Expand6((color >>  5) & 0x3F);
+    rgb[2] = Expand5((color      ) & 0x1F);
+}
+
+static std::uint16_t ReadUInt16(const std::uint8_t* src)
+{
+    return static_cast<std::uint16_t>(src[0] | (src[1] << 8));
+}
+
+static std::uint32_t ReadUInt32(const std::uint8_t* src)
+{
+    return (std::uint32_t(src[0]) | (std::uint32_t(src[1]) << 8) | (std::uint32_t(src[2]) << 16) | (std::uint32_t(src[3]) << 24));
+}
+
+static void WriteUInt16(std::uint8_t* dst, std::uint16_t value)
+{
+    dst[0] = static_cast<std::uint8_t>(value);
+    dst[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+static void WriteUInt32(std::uint8_t* dst, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+        dst[i] = static_cast<std::uint8_t>(value >> (i * 8));
+}
+
+/*
+Builds the palette of a BC1 color block. In the 3-color mode, the fourth entry is transparent black.
+Interpolation follows the common integer decoders, so encoder and decoder agree on every bit.
+*/
+static void BuildColorPalette(int (&palette)[4][3], std::uint16_t c0, std::uint16_t c1, bool threeColorMode)
+{
+    UnpackRGB565(c0, palette[0]);
+    UnpackRGB565(c1, palette[1]);
+    for (int i = 0; i < 3; ++i)
+    {
+        if (threeColorMode)
+        {
+            palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+            palette[3][i] = 0;
+        }
+        else
+        {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+        }
+    }
+}
+
+// Builds the palette of a BC3 alpha block or BC4 channel block.
+static void BuildAlphaPalette(int (&palette)[8], int a0, int a1)
+{
+    palette[0] = a0;
+    palette[1] = a1;
+    if (a0 > a1)
+    {
+        for (int i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+    }
+    else
+    {
+        for (int i = 2; i < 6; ++i)
+            palette[i] = ((6 - i) * a0 + (i - 1) * a1) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+
+/* ----- Single color tables ----- */
+
+// Optimal endpoints for single color blocks, so that the first interpolated color (2/3 * c0 + 1/3 * c1) matches the 8-bit value most closely.
+struct SingleColorTable
+{
+    std::uint8_t match5[256][2];
+    std::uint8_t match6[256][2];
+};
+
+static void BuildSingleColorMatches(std::uint8_t (&match)[256][2], int size, int (*expand)(int))
+{
+    for (int i = 0; i < 256; ++i)
+    {
+        int bestError = 256, bestSpread = 256;
+        for (int hi = 0; hi < size; ++hi)
+        {
+            for (int lo = 0; lo < size; ++lo)
+            {
+                const auto hiExpanded   = expand(hi);
+                const auto loExpanded   = expand(lo);
+                const auto error        = std::abs((2 * hiExpanded + loExpanded) / 3 - i);
+                const auto spread       = std::abs(hiExpanded - loExpanded);
+                if (error < bestError || (error == bestError && spread < bestSpread))
+                {
+                    bestError       = error;
+                    bestSpread      = spread;
+                    match[i][0]     = static_cast<std::uint8_t>(hi);
+                    match[i][1]     = static_cast<std::uint8_t>(lo);
+                }
+            }
+        }
+    }
+}
+
+static SingleColorTable BuildSingleColorTable()
+{
+    SingleColorTable table;
+    BuildSingleColorMatches(table.match5, 32, Expand5);
+    BuildSingleColorMatches(table.match6, 64, Expand6);
+    return table;
+}
+
+static const SingleColorTable& GetSingleColorTable()
+{
+    static const SingleColorTable table = BuildSingleColorTable();
+    return table;
+}
+
+
+/* ----- Color block encoding ----- */
+
+// Computes the dot product of the RGB components of all 16 pixels with the specified axis.
+static void ComputeDotProducts(const std::uint8_t* block, const int (&axis)[3], int (&dots)[16])
+{
+    #if defined LLGL_SIMD_SSE2
+
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i dir   = _mm_setr_epi16(
+        static_cast<short>(axis[0]), static_cast<short>(axis[1]), static_cast<short>(axis[2]), 0,
+        static_cast<short>(axis[0]), static_cast<short>(axis[1]), static_cast<short>(axis[2]), 0
+    );
+
+    for (int i = 0; i < 16; i += 4)
+    {
+        /* Multiply 4 pixels with the axis: [R*X + G*Y, B*Z] for each pixel */
+        const __m128i pixels    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 4));
+        const __m128i prod01    = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), dir);
+        const __m128i prod23    = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), dir);
+
+        /* Sum up partial products of each pixel */
+        const __m128i part01    = _mm_shuffle_epi32(prod01, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i part23    = _mm_shuffle_epi32(prod23, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i sums      = _mm_add_epi32(_mm_unpacklo_epi64(part01, part23), _mm_unpackhi_epi64(part01, part23));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dots + i), sums);
+    }
+
+    #elif defined LLGL_SIMD_NEON
+
+    const std::int16_t  axisValues[4]   = { static_cast<std::int16_t>(axis[0]), static_cast<std::int16_t>(axis[1]), static_cast<std::int16_t>(axis[2]), 0 };
+    const int16x4_t     dir             = vld1_s16(axisValues);
+
+    for (int i = 0; i < 16; i += 4)
+    {
+        /* Multiply 4 pixels with the axis */
+        const uint8x16_t    pixels  = vld1q_u8(block + i * 4);
+        const int16x8_t     pix01   = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(pixels)));
+        const int16x8_t     pix23   = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(pixels)));
+        const int32x4_t     prod0   = vmull_s16(vget_low_s16(pix01), dir);
+        const int32x4_t     prod1   = vmull_s16(vget_high_s16(pix01), dir);
+        const int32x4_t     prod2   = vmull_s16(vget_low_s16(pix23), dir);
+        const int32x4_t     prod3   = vmull_s16(vget_high_s16(pix23), dir);
+
+        /* Sum up partial products of each pixel */
+        vst1q_s32(dots + i, vpaddq_s32(vpaddq_s32(prod0, prod1), vpaddq_s32(prod2, prod3)));
+    }
+
+    #else
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto pixel = block + i * 4;
+        dots[i] = pixel[0] * axis[0] + pixel[1] * axis[1] + pixel[2] * axis[2];
+    }
+
+    #endif
+}
+
+static int GetPaletteDot(const int (&color)[3], const int (&axis)[3])
+{
+    return (color[0] * axis[0] + color[1] * axis[1] + color[2] * axis[2]);
+}
+
+/*
+Selects the palette index for each pixel by projecting it onto the line between the endpoints.
+Transparent pixels (not in 'opaqueMask') get index 3 in the 3-color mode.
+*/
+static std::uint32_t SelectColorIndices(const std::uint8_t* block, const int (&palette)[4][3], std::uint32_t opaqueMask, bool threeColorMode)
+{
+    const int axis[3] =
+    {
+        palette[0][0] - palette[1][0],
+        palette[0][1] - palette[1][1],
+        palette[0][2] - palette[1][2],
+    };
+
+    int dots[16];
+    ComputeDotProducts(block, axis, dots);
+
+    const auto stop0 = GetPaletteDot(palette[0], axis);
+    const auto stop1 = GetPaletteDot(palette[1], axis);
+    const auto stop2 = GetPaletteDot(palette[2], axis);
+    const auto stop3 = GetPaletteDot(palette[3], axis);
+
+    std::uint32_t indices = 0;
+
+    if (threeColorMode)
+    {
+        /* Palette order along the axis is: c1, (c0 + c1)/2, c0 */
+        static const std::uint32_t indexMap[3] = { 1, 2, 0 };
+        const auto threshold0 = stop1 + stop2;
+        const auto threshold1 = stop2 + stop0;
+
+        for (int i = 15; i >= 0; --i)
+        {
+            std::uint32_t index = 3;
+            if ((opaqueMask & (1u << i)) != 0)
+            {
+                const auto dot2 = dots[i] * 2;
+                index = indexMap[(dot2 >= threshold0 ? 1 : 0) + (dot2 >= threshold1 ? 1 : 0)];
+            }
+            indices = (indices << 2) | index;
+        }
+    }
+    else
+    {
+        /* Palette order along the axis is: c1, (c0 + 2*c1)/3, (2*c0 + c1)/3, c0 */
+        static const std::uint32_t indexMap[4] = { 1, 3, 2, 0 };
+        const auto threshold0 = stop1 + stop3;
+        const auto threshold1 = stop3 + stop2;
+        const auto threshold2 = stop2 + stop0;
+
+        for (int i = 15; i >= 0; --i)
+        {
+            const auto dot2 = dots[i] * 2;
+            const auto step = (dot2 >= threshold0 ? 1 : 0) + (dot2 >= threshold1 ? 1 : 0) + (dot2 >= threshold2 ? 1 : 0);
+            indices = (indices << 2) | indexMap[step];
+        }
+    }
+
+    return indices;
+}
+
+// Returns the squared error of the encoded block for all opaque pixels.
+static int GetColorBlockError(const std::uint8_t* block, const int (&palette)[4][3], std::uint32_t indices, std::uint32_t opaqueMask)
+{
+    int error = 0;
+    for (int i = 0; i < 16; ++i, indices >>= 2)
+    {
+        if ((opaqueMask & (1u << i)) != 0)
+        {
+            const auto& color = palette[indices & 0x3];
+            for (int j = 0; j < 3; ++j)
+            {
+                const auto d = static_cast<int>(block[i * 4 + j]) - color[j];
+                error += d * d;
+            }
+        }
+    }
+    return error;
+}
+
+/*
+Orders the endpoints for the respective mode (c0 > c1 for 4 colors, c0 <= c1 for 3 colors),
+then selects the indices and returns the squared error of the block.
+*/
+static int MatchColorBlock(
+    const std::uint8_t* block,
+    std::uint16_t&      c0,
+    std::uint16_t&      c1,
+    std::uint32_t&      indices,
+    std::uint32_t       opaqueMask,
+    bool                threeColorMode)
+{
+    if (threeColorMode ? (c0 > c1) : (c0 < c1))
+        std::swap(c0, c1);
+
+    int palette[4][3];
+    BuildColorPalette(palette, c0, c1, threeColorMode);
+
+    indices = SelectColorIndices(block, palette, opaqueMask, threeColorMode);
+
+    return GetColorBlockError(block, palette, indices, opaqueMask);
+}
+
+// Determines the endpoints along the principal axis of all opaque pixels. Returns the extreme pixels as endpoints.
+static void ComputePrincipalEndpoints(const std::uint8_t* block, std::uint32_t opaqueMask, int (&minColor)[3], int (&maxColor)[3])
+{
+    /* Compute mean and value range */
+    float mean[3] = { 0.0f, 0.0f, 0.0f };
+    int minValue[3] = { 255, 255, 255 }, maxValue[3] = { 0, 0, 0 };
+    int numPixels = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) != 0)
+        {
+            for (int j = 0; j < 3; ++j)
+            {
+                const int value = block[i * 4 + j];
+                mean[j] += static_cast<float>(value);
+                minValue[j] = std::min(minValue[j], value);
+                maxValue[j] = std::max(maxValue[j], value);
+            }
+            ++numPixels;
+        }
+    }
+
+    for (int j = 0; j < 3; ++j)
+        mean[j] /= static_cast<float>(numPixels);
+
+    /* Compute covariance matrix */
+    float cov[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) != 0)
+        {
+            const auto r = static_cast<float>(block[i * 4 + 0]) - mean[0];
+            const auto g = static_cast<float>(block[i * 4 + 1]) - mean[1];
+            const auto b = static_cast<float>(block[i * 4 + 2]) - mean[2];
+            cov[0] += r*r;
+            cov[1] += r*g;
+            cov[2] += r*b;
+            cov[3] += g*g;
+            cov[4] += g*b;
+            cov[5] += b*b;
+        }
+    }
+
+    /* Find principal axis with power iteration, starting with the value range */
+    float axis[3] =
+    {
+        static_cast<float>(maxValue[0] - minValue[0]),
+        static_cast<float>(maxValue[1] - minValue[1]),
+        static_cast<float>(maxValue[2] - minValue[2]),
+    };
+
+    for (int iteration = 0; iteration < 4; ++iteration)
+    {
+        const float x = axis[0]*cov[0] + axis[1]*cov[1] + axis[2]*cov[2];
+        const float y = axis[0]*cov[1] + axis[1]*cov[3] + axis[2]*cov[4];
+        const float z = axis[0]*cov[2] + axis[1]*cov[4] + axis[2]*cov[5];
+        const float m = std::max(std::abs(x), std::max(std::abs(y), std::abs(z)));
+        if (m < 1.0e-6f)
+            break;
+        axis[0] = x / m;
+        axis[1] = y / m;
+        axis[2] = z / m;
+    }
+
+    /* Convert axis to integers with enough precision for the projection */
+    const float m = std::max(std::abs(axis[0]), std::max(std::abs(axis[1]), std::abs(axis[2])));
+
+    int intAxis[3] = { 299, 587, 114 };
+    if (m > 1.0e-6f)
+    {
+        for (int j = 0; j < 3; ++j)
+            intAxis[j] = static_cast<int>(std::lround(axis[j] / m * 1023.0f));
+    }
+
+    /* Use the opaque pixels with the minimal and maximal projection as endpoints */
+    int dots[16];
+    ComputeDotProducts(block, intAxis, dots);
+
+    int minDot = 0, maxDot = 0, minIndex = -1, maxIndex = -1;
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) != 0)
+        {
+            if (minIndex < 0 || dots[i] < minDot)
+            {
+                minDot      = dots[i];
+                minIndex    = i;
+            }
+            if (maxIndex < 0 || dots[i] > maxDot)
+            {
+                maxDot      = dots[i];
+                maxIndex    = i;
+            }
+        }
+    }
+
+    for (int j = 0; j < 3; ++j)
+    {
+        minColor[j] = block[minIndex * 4 + j];
+        maxColor[j] = block[maxIndex * 4 + j];
+    }
+}
+
+/*
+Refines the endpoints for the selected indices with a least-squares fit.
+Returns false if the indices do not determine the endpoints (e.g. all pixels use the same index).
+*/
+static bool RefineEndpoints(
+    const std::uint8_t* block,
+    std::uint32_t       indices,
+    std::uint32_t       opaqueMask,
+    bool                threeColorMode,
+    std::uint16_t&      c0,
+    std::uint16_t&      c1)
+{
+    /* Weights of the first endpoint for each index */
+    static const float weights4[4] = { 1.0f, 0.0f, 2.0f/3.0f, 1.0f/3.0f };
+    static const float weights3[4] = { 1.0f, 0.0f, 0.5f, 0.0f };
+
+    const auto& weights = (threeColorMode ? weights3 : weights4);
+
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[3] = { 0.0f, 0.0f, 0.0f }, bx[3] = { 0.0f, 0.0f, 0.0f };
+
+    for (int i = 0; i < 16; ++i, indices >>= 2)
+    {
+        if ((opaqueMask & (1u << i)) == 0)
+            continue;
+
+        const auto a = weights[indices & 0x3];
+        const auto b = 1.0f - a;
+
+        aa += a*a;
+        ab += a*b;
+        bb += b*b;
+
+        for (int j = 0; j < 3; ++j)
+        {
+            const auto x = static_cast<float>(block[i * 4 + j]);
+            ax[j] += a*x;
+            bx[j] += b*x;
+        }
+    }
+
+    const auto det = aa*bb - ab*ab;
+    if (std::abs(det) < 1.0e-6f)
+        return false;
+
+    int color0[3], color1[3];
+    for (int j = 0; j < 3; ++j)
+    {
+        color0[j] = static_cast<int>(std::lround((ax[j]*bb - bx[j]*ab) / det));
+        color1[j] = static_cast<int>(std::lround((bx[j]*aa - ax[j]*ab) / det));
+    }
+
+    c0 = PackRGB565(color0);
+    c1 = PackRGB565(color1);
+
+    return true;
+}
+
+static bool IsSingleColorBlock(const std::uint8_t* block)
+{
+    for (int i = 1; i < 16; ++i)
+    {
+        if (block[i*4] != block[0] || block[i*4 + 1] != block[1] || block[i*4 + 2] != block[2])
+            return false;
+    }
+    return true;
+}
+
+// Encodes the 64-bit color block of BC1, BC2, and BC3. Only BC1 supports transparent pixels.
+static void EncodeColorBlock(std::uint8_t* dst, const std::uint8_t* block, bool allowTransparent)
+{
+    /* Determine opaque pixels */
+    std::uint32_t opaqueMask = 0xFFFF;
+    if (allowTransparent)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            if (block[i * 4 + 3] < g_bc1AlphaThreshold)
+                opaqueMask &= ~(1u << i);
+        }
+    }
+
+    const bool threeColorMode = (opaqueMask != 0xFFFF);
+
+    std::uint16_t   c0      = 0;
+    std::uint16_t   c1      = 0;
+    std::uint32_t   indices = 0;
+
+    if (opaqueMask == 0)
+    {
+        /* Encode fully transparent block */
+        indices = 0xFFFFFFFF;
+    }
+    else if (!threeColorMode && IsSingleColorBlock(block))
+    {
+        /* Encode single color with optimal endpoints for the first interpolated color */
+        const auto& table = GetSingleColorTable();
+        c0 = static_cast<std::uint16_t>((table.match5[block[0]][0] << 11) | (table.match6[block[1]][0] << 5) | table.match5[block[2]][0]);
+        c1 = static_cast<std::uint16_t>((table.match5[block[0]][1] << 11) | (table.match6[block[1]][1] << 5) | table.match5[block[2]][1]);
+
+        if (c0 > c1)
+            indices = 0xAAAAAAAA;
+        else if (c0 < c1)
+        {
+            /* Swap endpoints and use second interpolated color */
+            std::swap(c0, c1);
+            indices = 0xFFFFFFFF;
+        }
+    }
+    else
+    {
+        /* Start with endpoints along the principal axis */
+        int minColor[3], maxColor[3];
+        ComputePrincipalEndpoints(block, opaqueMask, minColor, maxColor);
+
+        c0 = PackRGB565(maxColor);
+        c1 = PackRGB565(minColor);
+
+        auto error = MatchColorBlock(block, c0, c1, indices, opaqueMask, threeColorMode);
+
+        /* Refine endpoints as long as the error decreases */
+        for (int iteration = 0; iteration < g_numRefineIterations && error > 0; ++iteration)
+        {
+            std::uint16_t   refinedC0       = c0;
+            std::uint16_t   refinedC1       = c1;
+            std::uint32_t   refinedIndices  = 0;
+
+            if (!RefineEndpoints(block, indices, opaqueMask, threeColorMode, refinedC0, refinedC1))
+                break;
+
+            const auto refinedError = MatchColorBlock(block, refinedC0, refinedC1, refinedIndices, opaqueMask, threeColorMode);
+            if (refinedError >= error)
+                break;
+
+            c0      = refinedC0;
+            c1      = refinedC1;
+            indices = refinedIndices;
+            error   = refinedError;
+        }
+    }
+
+    WriteUInt16(dst,     c0);
+    WriteUInt16(dst + 2, c1);
+    WriteUInt32(dst + 4, indices);
+}
+
+
+/* ----- Alpha block encoding ----- */
+
+// Selects the palette index for each value. Returns the squared error.
+static int SelectAlphaIndices(const int (&values)[16], const int (&palette)[8], std::uint64_t& indices)
+{
+    int error = 0;
+    indices = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        int bestIndex = 0, bestError = 256*256;
+        for (int j = 0; j < 8; ++j)
+        {
+            const auto d = values[i] - palette[j];
+            if (d*d < bestError)
+            {
+                bestError   = d*d;
+                bestIndex   = j;
+            }
+        }
+        indices |= (static_cast<std::uint64_t>(bestIndex) << (i * 3));
+        error += bestError;
+    }
+
+    return error;
+}
+
+// Encodes the 64-bit alpha block of BC3 or a single channel block of BC4 and BC5.
+static void EncodeAlphaBlock(std::uint8_t* dst, const std::uint8_t* block, int component)
+{
+    int values[16];
+    int minValue = 255, maxValue = 0, minInner = 255, maxInner = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        values[i] = block[i * 4 + component];
+        minValue = std::min(minValue, values[i]);
+        maxValue = std::max(maxValue, values[i]);
+        if (values[i] > 0 && values[i] < 255)
+        {
+            minInner = std::min(minInner, values[i]);
+            maxInner = std::max(maxInner, values[i]);
+        }
+    }
+
+    /* Encode with 8 interpolated values between the extremes */
+    int a0 = maxValue, a1 = minValue, palette[8];
+    BuildAlphaPalette(palette, a0, a1);
+
+    std::uint64_t indices = 0;
+    auto error = SelectAlphaIndices(values, palette, indices);
+
+    if (error > 0 && (minValue == 0 || maxValue == 255))
+    {
+        /* Try 6 interpolated values between the inner extremes, plus explicit 0 and 255 */
+        if (minInner > maxInner)
+            minInner = maxInner = 0;
+
+        BuildAlphaPalette(palette, minInner, maxInner);
+
+        std::uint64_t innerIndices = 0;
+        const auto innerError = SelectAlphaIndices(values, palette, innerIndices);
+
+        if (innerError < error)
+        {
+            a0      = minInner;
+            a1      = maxInner;
+            indices = innerIndices;
+        }
+    }
+
+    dst[0] = static_cast<std::uint8_t>(a0);
+    dst[1] = static_cast<std::uint8_t>(a1);
+    for (int i = 0; i < 6; ++i)
+        dst[2 + i] = static_cast<std::uint8_t>(indices >> (i * 8));
+}
+
+// Encodes the 64-bit explicit alpha block of BC2 with 4 bits per pixel.
+static void EncodeExplicitAlphaBlock(std::uint8_t* dst, const std::uint8_t* block)
+{
+    std::fill(dst, dst + 8, std::uint8_t(0));
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto alpha = (block[i * 4 + 3] * 15 + 127) / 255;
+        dst[i / 2] |= static_cast<std::uint8_t>(alpha << ((i & 1) * 4));
+    }
+}
+
+
+/* ----- Block decoding ----- */
+
+static void DecodeColorBlock(std::uint8_t* block, const std::uint8_t* src, bool allowTransparent)
+{
+    const auto c0       = ReadUInt16(src);
+    const auto c1       = ReadUInt16(src + 2);
+    auto       indices  = ReadUInt32(src + 4);
+
+    const bool threeColorMode = (allowTransparent && c0 <= c1);
+
+    int palette[4][3];
+    BuildColorPalette(palette, c0, c1, threeColorMode);
+
+    for (int i = 0; i < 16; ++i, indices >>= 2)
+    {
+        const auto index = indices & 0x3;
+        for (int j = 0; j < 3; ++j)
+            block[i * 4 + j] = static_cast<std::uint8_t>(palette[index][j]);
+        block[i * 4 + 3] = (threeColorMode && index == 3 ? 0 : 255);
+    }
+}
+
+static void DecodeAlphaBlock(std::uint8_t* block, const std::uint8_t* src, int component)
+{
+    int palette[8];
+    BuildAlphaPalette(palette, src[0], src[1]);
+
+    std::uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i)
+        indices |= (static_cast<std::uint64_t>(src[2 + i]) << (i * 8));
+
+    for (int i = 0; i < 16; ++i, indices >>= 3)
+        block[i * 4 + component] = static_cast<std::uint8_t>(palette[indices & 0x7]);
+}
+
+static void DecodeExplicitAlphaBlock(std::uint8_t* block, const std::uint8_t* src)
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto alpha = (src[i / 2] >> ((i & 1) * 4)) & 0xF;
+        block[i * 4 + 3] = static_cast<std::uint8_t>(alpha * 17);
+    }
+}
+
+
+/* ----- BC7 block encoding and decoding ----- */
+
+// Layout of a BC7 block mode. Bit counts are per component and endpoint, or per pixel for indices.
+struct BC7ModeInfo
+{
+    int numSubsets;
+    int partitionBits;
+    int rotationBits;
+    int indexSelectionBits;
+    int colorBits;
+    int alphaBits;
+    int endpointPBits;
+    int sharedPBits;
+    int indexBits;
+    int indexBits2;
+};
+
+static const BC7ModeInfo g_bc7Modes[8] =
+{
+    { 3, 4, 0, 0, 4, 0, 1, 0, 3, 0 },
+    { 2, 6, 0, 0, 6, 0, 0, 1, 3, 0 },
+    { 3, 6, 0, 0, 5, 0, 0, 0, 2, 0 },
+    { 2, 6, 0, 0, 7, 0, 1, 0, 2, 0 },
+    { 1, 0, 2, 1, 5, 6, 0, 0, 2, 3 },
+    { 1, 0, 2, 0, 7, 8, 0, 0, 2, 2 },
+    { 1, 0, 0, 0, 7, 7, 1, 0, 4, 0 },
+    { 2, 6, 0, 0, 5, 5, 1, 0, 2, 0 },
+};
+
+// Interpolation weights (out of 64) for 2-, 3-, and 4-bit indices.
+static const int g_bc7Weights2[4]   = { 0, 21, 43, 64 };
+static const int g_bc7Weights3[8]   = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static const int g_bc7Weights4[16]  = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// Partitions for two subsets: bit N specifies whether pixel N belongs to the second subset.
+static const std::uint16_t g_bc7Partitions2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// Partitions for three subsets: bits 2N and 2N+1 specify the subset of pixel N.
+static const std::uint32_t g_bc7Partitions3[64] =
+{
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8,
+    0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090,
+    0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0,
+    0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400,
+    0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424,
+    0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0,
+    0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600,
+    0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000,
+    0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// Anchor pixels of the second subset for two subsets.
+static const std::uint8_t g_bc7Anchors2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// Anchor pixels of the second and third subset for three subsets.
+static const std::uint8_t g_bc7Anchors3[2][64] =
+{
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+    },
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+    },
+};
+
+// Reads and writes the bit fields of a 128-bit BC7 block, starting with the least significant bit.
+class BC7BitStream
+{
+
+    public:
+
+        BC7BitStream(const std::uint8_t* src) :
+            src_ { src }
+        {
+        }
+
+        BC7BitStream(std::uint8_t* dst) :
+            src_ { dst },
+            dst_ { dst }
+        {
+            std::fill(dst, dst + 16, std::uint8_t(0));
+        }
+
+        int Read(int numBits)
+        {
+            int value = 0;
+            for (int i = 0; i < numBits; ++i, ++pos_)
+                value |= ((src_[pos_ / 8] >> (pos_ % 8)) & 0x1) << i;
+            return value;
+        }
+
+        void Write(int value, int numBits)
+        {
+            for (int i = 0; i < numBits; ++i, ++pos_)
+                dst_[pos_ / 8] |= static_cast<std::uint8_t>(((value >> i) & 0x1) << (pos_ % 8));
+        }
+
+    private:
+
+        const std::uint8_t* src_    = nullptr;
+        std::uint8_t*       dst_    = nullptr;
+        int                 pos_    = 0;
+
+};
+
+static const int* GetBC7Weights(int indexBits)
+{
+    switch (indexBits)
+    {
+        case 2:     return g_bc7Weights2;
+        case 3:     return g_bc7Weights3;
+        default:    return g_bc7Weights4;
+    }
+}
+
+static int InterpolateBC7(int e0, int e1, int weight)
+{
+    return (((64 - weight) * e0 + weight * e1 + 32) >> 6);
+}
+
+// Expands the specified value with 'precision' bits (between 5 and 8) to 8 bits.
+static int ExpandBC7(int value, int precision)
+{
+    value <<= (8 - precision);
+    return (value | (value >> precision));
+}
+
+static int GetBC7Subset(int numSubsets, int partition, int pixel)
+{
+    switch (numSubsets)
+    {
+        case 2:     return ((g_bc7Partitions2[partition] >> pixel) & 0x1);
+        case 3:     return ((g_bc7Partitions3[partition] >> (pixel * 2)) & 0x3);
+        default:    return 0;
+    }
+}
+
+static bool IsBC7AnchorPixel(int numSubsets, int partition, int pixel)
+{
+    if (pixel == 0)
+        return true;
+    switch (numSubsets)
+    {
+        case 2:     return (pixel == g_bc7Anchors2[partition]);
+        case 3:     return (pixel == g_bc7Anchors3[0][partition] || pixel == g_bc7Anchors3[1][partition]);
+        default:    return false;
+    }
+}
+
+// Decodes a BC7 block of any mode. Reserved blocks decode to transparent black.
+static void DecodeBC7Block(std::uint8_t* block, const std::uint8_t* src)
+{
+    BC7BitStream stream{ src };
+
+    /* Mode is specified by the number of leading zero bits */
+    int mode = 0;
+    while (mode < 8 && stream.Read(1) == 0)
+        ++mode;
+
+    if (mode == 8)
+    {
+        std::fill(block, block + 64, std::uint8_t(0));
+        return;
+    }
+
+    const auto& info            = g_bc7Modes[mode];
+    const auto  numEndpoints    = info.numSubsets * 2;
+    const auto  partition       = stream.Read(info.partitionBits);
+    const auto  rotation        = stream.Read(info.rotationBits);
+    const auto  indexSelection  = stream.Read(info.indexSelectionBits);
+
+    /* Read endpoints component by component */
+    int endpoints[6][4];
+    for (int c = 0; c < 3; ++c)
+    {
+        for (int e = 0; e < numEndpoints; ++e)
+            endpoints[e][c] = stream.Read(info.colorBits);
+    }
+    for (int e = 0; e < numEndpoints; ++e)
+        endpoints[e][3] = stream.Read(info.alphaBits);
+
+    /* Read P-bits, which extend the precision of all components of an endpoint */
+    int pBits[6] = { 0, 0, 0, 0, 0, 0 };
+    if (info.endpointPBits != 0)
+    {
+        for (int e = 0; e < numEndpoints; ++e)
+            pBits[e] = stream.Read(1);
+    }
+    else if (info.sharedPBits != 0)
+    {
+        for (int s = 0; s < info.numSubsets; ++s)
+            pBits[s * 2] = pBits[s * 2 + 1] = stream.Read(1);
+    }
+
+    /* Expand endpoints to 8 bits */
+    const auto hasPBits         = (info.endpointPBits + info.sharedPBits);
+    const auto colorPrecision   = info.colorBits + hasPBits;
+    const auto alphaPrecision   = info.alphaBits + hasPBits;
+
+    for (int e = 0; e < numEndpoints; ++e)
+    {
+        for (int c = 0; c < 3; ++c)
+            endpoints[e][c] = ExpandBC7((endpoints[e][c] << hasPBits) | pBits[e], colorPrecision);
+        endpoints[e][3] = (info.alphaBits > 0 ? ExpandBC7((endpoints[e][3] << hasPBits) | pBits[e], alphaPrecision) : 255);
+    }
+
+    /* Read primary and secondary indices; anchor pixels have an implicit most significant bit of zero */
+    int indices[16], indices2[16];
+    for (int i = 0; i < 16; ++i)
+        indices[i] = stream.Read(IsBC7AnchorPixel(info.numSubsets, partition, i) ? info.indexBits - 1 : info.indexBits);
+    for (int i = 0; i < 16; ++i)
+        indices2[i] = (info.indexBits2 > 0 ? stream.Read(i == 0 ? info.indexBits2 - 1 : info.indexBits2) : indices[i]);
+
+    /* Index selection swaps the index sets of color and alpha */
+    const auto colorWeights = GetBC7Weights(indexSelection != 0 ? info.indexBits2 : info.indexBits);
+    const auto alphaWeights = GetBC7Weights(info.indexBits2 > 0 && indexSelection == 0 ? info.indexBits2 : info.indexBits);
+    const auto colorIndices = (indexSelection != 0 ? indices2 : indices);
+    const auto alphaIndices = (indexSelection != 0 ? indices : indices2);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto  subset  = GetBC7Subset(info.numSubsets, partition, i);
+        const auto& e0      = endpoints[subset * 2];
+        const auto& e1      = endpoints[subset * 2 + 1];
+        auto        pixel   = block + i * 4;
+
+        for (int c = 0; c < 3; ++c)
+            pixel[c] = static_cast<std::uint8_t>(InterpolateBC7(e0[c], e1[c], colorWeights[colorIndices[i]]));
+        pixel[3] = static_cast<std::uint8_t>(InterpolateBC7(e0[3], e1[3], alphaWeights[alphaIndices[i]]));
+
+        /* Rotation swaps alpha with one of the color components */
+        if (rotation > 0)
+            std::swap(pixel[3], pixel[rotation - 1]);
+    }
+}
+
+// Quantizes an RGBA endpoint to 7 bits per component plus one P-bit, choosing the P-bit with the smaller error.
+static void QuantizeBC7Mode6Endpoint(const float (&endpoint)[4], int (&quantized)[4], int& pBit)
+{
+    float bestError = 0.0f;
+    for (int p = 0; p < 2; ++p)
+    {
+        int     values[4];
+        float   error   = 0.0f;
+        for (int c = 0; c < 4; ++c)
+        {
+            values[c] = std::max(0, std::min(static_cast<int>(std::lround((endpoint[c] - static_cast<float>(p)) * 0.5f)), 127));
+            const auto d = static_cast<float>((values[c] << 1) | p) - endpoint[c];
+            error += d*d;
+        }
+        if (p == 0 || error < bestError)
+        {
+            bestError = error;
+            std::copy(values, values + 4, quantized);
+            pBit = p;
+        }
+    }
+}
+
+// Builds the 16-entry palette from the quantized endpoints. Mode 6 has 8-bit precision, so no expansion is required.
+static void BuildBC7Mode6Palette(int (&palette)[16][4], const int (&q0)[4], int p0, const int (&q1)[4], int p1)
+{
+    for (int c = 0; c < 4; ++c)
+    {
+        const auto e0 = (q0[c] << 1) | p0;
+        const auto e1 = (q1[c] << 1) | p1;
+        for (int i = 0; i < 16; ++i)
+            palette[i][c] = InterpolateBC7(e0, e1, g_bc7Weights4[i]);
+    }
+}
+
+static int GetBC7PixelError(const std::uint8_t* pixel, const int (&color)[4])
+{
+    int error = 0;
+    for (int c = 0; c < 4; ++c)
+    {
+        const auto d = static_cast<int>(pixel[c]) - color[c];
+        error += d*d;
+    }
+    return error;
+}
+
+// Selects the palette index for each pixel by projecting it onto the line between the endpoints. Returns the squared error.
+static int SelectBC7Mode6Indices(const std::uint8_t* block, const int (&palette)[16][4], int (&indices)[16])
+{
+    float axis[4], axisLengthSq = 0.0f;
+    for (int c = 0; c < 4; ++c)
+    {
+        axis[c] = static_cast<float>(palette[15][c] - palette[0][c]);
+        axisLengthSq += axis[c]*axis[c];
+    }
+
+    int error = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto pixel = block + i * 4;
+
+        /* Project pixel onto axis, then check the adjacent indices as well */
+        int index = 0;
+        if (axisLengthSq > 0.0f)
+        {
+            float dot = 0.0f;
+            for (int c = 0; c < 4; ++c)
+                dot += (static_cast<float>(pixel[c]) - static_cast<float>(palette[0][c])) * axis[c];
+            index = std::max(0, std::min(static_cast<int>(std::lround(dot / axisLengthSq * 15.0f)), 15));
+        }
+
+        int bestIndex = index, bestError = GetBC7PixelError(pixel, palette[index]);
+        for (int j = std::max(0, index - 1); j <= std::min(index + 1, 15); ++j)
+        {
+            const auto pixelError = GetBC7PixelError(pixel, palette[j]);
+            if (pixelError < bestError)
+            {
+                bestError   = pixelError;
+                bestIndex   = j;
+            }
+        }
+
+        indices[i] = bestIndex;
+        error += bestError;
+    }
+
+    return error;
+}
+
+// Determines the RGBA endpoints along the principal axis of all 16 pixels.
+static void ComputeBC7PrincipalEndpoints(const std::uint8_t* block, float (&e0)[4], float (&e1)[4])
+{
+    /* Compute mean and covariance matrix */
+    float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int i = 0; i < 16; ++i)
+    {
+        for (int c = 0; c < 4; ++c)
+            mean[c] += static_cast<float>(block[i * 4 + c]);
+    }
+    for (int c = 0; c < 4; ++c)
+        mean[c] /= 16.0f;
+
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; ++i)
+    {
+        float d[4];
+        for (int c = 0; c < 4; ++c)
+            d[c] = static_cast<float>(block[i * 4 + c]) - mean[c];
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+                cov[r][c] += d[r]*d[c];
+        }
+    }
+
+    /* Find principal axis with power iteration, starting with the diagonal of the covariance matrix */
+    float axis[4] = { cov[0][0], cov[1][1], cov[2][2], cov[3][3] };
+    for (int iteration = 0; iteration < 8; ++iteration)
+    {
+        float v[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, m = 0.0f;
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+                v[r] += cov[r][c]*axis[c];
+            m = std::max(m, std::abs(v[r]));
+        }
+        if (m < 1.0e-6f)
+            break;
+        for (int c = 0; c < 4; ++c)
+            axis[c] = v[c] / m;
+    }
+
+    /* Use the extreme projections onto the axis as endpoints */
+    float minT = 0.0f, maxT = 0.0f, axisLengthSq = 0.0f;
+    for (int c = 0; c < 4; ++c)
+        axisLengthSq += axis[c]*axis[c];
+
+    if (axisLengthSq > 1.0e-6f)
+    {
+        for (int i = 0; i < 16; ++i)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < 4; ++c)
+                t += (static_cast<float>(block[i * 4 + c]) - mean[c]) * axis[c];
+            t /= axisLengthSq;
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+    }
+
+    for (int c = 0; c < 4; ++c)
+    {
+        e0[c] = std::max(0.0f, std::min(mean[c] + minT*axis[c], 255.0f));
+        e1[c] = std::max(0.0f, std::min(mean[c] + maxT*axis[c], 255.0f));
+    }
+}
+
+/*
+Refines the endpoints for the selected indices with a least-squares fit.
+Returns false if the indices do not determine the endpoints (e.g. all pixels use the same index).
+*/
+static bool RefineBC7Endpoints(const std::uint8_t* block, const int (&indices)[16], float (&e0)[4], float (&e1)[4])
+{
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[4] = { 0.0f, 0.0f, 0.0f, 0.0f }, bx[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const auto b = static_cast<float>(g_bc7Weights4[indices[i]]) / 64.0f;
+        const auto a = 1.0f - b;
+
+        aa += a*a;
+        ab += a*b;
+        bb += b*b;
+
+        for (int c = 0; c < 4; ++c)
+        {
+            const auto x = static_cast<float>(block[i * 4 + c]);
+            ax[c] += a*x;
+            bx[c] += b*x;
+        }
+    }
+
+    const auto det = aa*bb - ab*ab;
+    if (std::abs(det) < 1.0e-6f)
+        return false;
+
+    for (int c = 0; c < 4; ++c)
+    {
+        e0[c] = std::max(0.0f, std::min((ax[c]*bb - bx[c]*ab) / det, 255.0f));
+        e1[c] = std::max(0.0f, std::min((bx[c]*aa - ax[c]*ab) / det, 255.0f));
+    }
+
+    return true;
+}
+
+struct BC7Mode6Block
+{
+    int q0[4];
+    int q1[4];
+    int p0;
+    int p1;
+    int indices[16];
+};
+
+static int MatchBC7Mode6Block(const std::uint8_t* block, const float (&e0)[4], const float (&e1)[4], BC7Mode6Block& result)
+{
+    QuantizeBC7Mode6Endpoint(e0, result.q0, result.p0);
+    QuantizeBC7Mode6Endpoint(e1, result.q1, result.p1);
+
+    int palette[16][4];
+    BuildBC7Mode6Palette(palette, result.q0, result.p0, result.q1, result.p1);
+
+    return SelectBC7Mode6Indices(block, palette, result.indices);
+}
+
+/*
+Encodes a BC7 block in mode 6, i.e. a single subset with 7-bit RGBA endpoints, one P-bit per endpoint, and 4-bit indices.
+This mode is a good fit for all kinds of blocks, so the other modes are not considered by the encoder.
+*/
+static void EncodeBC7Block(std::uint8_t* dst, const std::uint8_t* block)
+{
+    /* Start with endpoints along the principal axis */
+    float e0[4], e1[4];
+    ComputeBC7PrincipalEndpoints(block, e0, e1);
+
+    BC7Mode6Block encoded;
+    auto error = MatchBC7Mode6Block(block, e0, e1, encoded);
+
+    /* Refine endpoints as long as the error decreases */
+    for (int iteration = 0; iteration < g_numRefineIterations && error > 0; ++iteration)
+    {
+        if (!RefineBC7Endpoints(block, encoded.indices, e0, e1))
+            break;
+
+        BC7Mode6Block refined;
+        const auto refinedError = MatchBC7Mode6Block(block, e0, e1, refined);
+        if (refinedError >= error)
+            break;
+
+        encoded = refined;
+        error   = refinedError;
+    }
+
+    /* Anchor index has an implicit most significant bit of zero, so swap endpoints if necessary */
+    if (encoded.indices[0] >= 8)
+    {
+        std::swap(encoded.q0, encoded.q1);
+        std::swap(encoded.p0, encoded.p1);
+        for (auto& index : encoded.indices)
+            index = 15 - index;
+    }
+
+    /* Write mode 6 block */
+    BC7BitStream stream{ dst };
+    stream.Write(1 << 6, 7);
+    for (int c = 0; c < 4; ++c)
+    {
+        stream.Write(encoded.q0[c], 7);
+        stream.Write(encoded.q1[c], 7);
+    }
+    stream.Write(encoded.p0, 1);
+    stream.Write(encoded.p1, 1);
+    for (int i = 0; i < 16; ++i)
+        stream.Write(encoded.indices[i], (i == 0 ? 3 : 4));
+}
+
+
+/* ----- Image blocks ----- */
+
+static void EncodeBlock(const ImageFormat format, std::uint8_t* dst, const std::uint8_t* block)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            EncodeColorBlock(dst, block, true);
+            break;
+        case ImageFormat::BC2:
+            EncodeExplicitAlphaBlock(dst, block);
+            EncodeColorBlock(dst + 8, block, false);
+            break;
+        case ImageFormat::BC3:
+            EncodeAlphaBlock(dst, block, 3);
+            EncodeColorBlock(dst + 8, block, false);
+            break;
+        case ImageFormat::BC4:
+            EncodeAlphaBlock(dst, block, 0);
+            break;
+        case ImageFormat::BC5:
+            EncodeAlphaBlock(dst, block, 0);
+            EncodeAlphaBlock(dst + 8, block, 1);
+            break;
+        case ImageFormat::BC7:
+            EncodeBC7Block(dst, block);
+            break;
+        default:
+            break;
+    }
+}
+
+static void DecodeBlock(const ImageFormat format, std::uint8_t* block, const std::uint8_t* src)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            DecodeColorBlock(block, src, true);
+            break;
+        case ImageFormat::BC2:
+            DecodeColorBlock(block, src + 8, false);
+            DecodeExplicitAlphaBlock(block, src);
+            break;
+        case ImageFormat::BC3:
+            DecodeColorBlock(block, src + 8, false);
+            DecodeAlphaBlock(block, src, 3);
+            break;
+        case ImageFormat::BC4:
+            for (int i = 0; i < 16; ++i)
+            {
+                block[i * 4 + 1] = 0;
+                block[i * 4 + 2] = 0;
+                block[i * 4 + 3] = 255;
+            }
+            DecodeAlphaBlock(block, src, 0);
+            break;
+        case ImageFormat::BC5:
+            for (int i = 0; i < 16; ++i)
+            {
+                block[i * 4 + 2] = 0;
+                block[i * 4 + 3] = 255;
+            }
+            DecodeAlphaBlock(block, src, 0);
+            DecodeAlphaBlock(block, src + 8, 1);
+            break;
+        case ImageFormat::BC7:
+            DecodeBC7Block(block, src);
+            break;
+        default:
+            break;
+    }
+}
+
+// Loads the 4x4 block of RGBA8 pixels at the specified block coordinate. Pixels outside the image are replicated from the edge.
+static void LoadBlock(std::uint8_t* block, const std::uint8_t* slice, const Extent3D& extent, std::uint32_t x, std::uint32_t y)
+{
+    const auto rowStride = static_cast<std::size_t>(extent.width) * 4;
+
+    if (x + 4 <= extent.width && y + 4 <= extent.height)
+    {
+        for (std::uint32_t row = 0; row < 4; ++row)
+            ::memcpy(block + row * 16, slice + (y + row) * rowStride + x * 4, 16);
+    }
+    else
+    {
+        for (std::uint32_t row = 0; row < 4; ++row)
+        {
+            const auto srcY = std::min(y + row, extent.height - 1);
+            for (std::uint32_t col = 0; col < 4; ++col)
+            {
+                const auto srcX = std::min(x + col, extent.width - 1);
+                ::memcpy(block + (row * 4 + col) * 4, slice + srcY * rowStride + srcX * 4, 4);
+            }
+        }
+    }
+}
+
+// Stores the part of the 4x4 block of RGBA8 pixels that is inside the image.
+static void StoreBlock(const std::uint8_t* block, std::uint8_t* slice, const Extent3D& extent, std::uint32_t x, std::uint32_t y)
+{
+    const auto rowStride    = static_cast<std::size_t>(extent.width) * 4;
+    const auto numCols      = std::min(4u, extent.width - x);
+    const auto numRows      = std::min(4u, extent.height - y);
+
+    for (std::uint32_t row = 0; row < numRows; ++row)
+        ::memcpy(slice + (y + row) * rowStride + x * 4, block + row * 16, numCols * 4);
+}
+
+
+/* ----- Functions ----- */
+
+std::size_t GetCompressedBlockSize(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:  return 8;
+        case ImageFormat::BC2:  return 16;
+        case ImageFormat::BC3:  return 16;
+        case ImageFormat::BC4:  return 8;
+        case ImageFormat::BC5:  return 16;
+        case ImageFormat::BC7:  return 16;
+        default:                return 0;
+    }
+}
+
+std::size_t GetCompressedImageDataSize(const ImageFormat format, const Extent3D& extent)
+{
+    const auto numBlocksX = (static_cast<std::size_t>(extent.width ) + 3) / 4;
+    const auto numBlocksY = (static_cast<std::size_t>(extent.height) + 3) / 4;
+    return (GetCompressedBlockSize(format) * numBlocksX * numBlocksY * extent.depth);
+}
+
+void CompressImageBlocks(
+    const ImageFormat   dstFormat,
+    void*               dst,
+    const std::uint8_t* srcRGBA8,
+    const Extent3D&     extent,
+    std::size_t         threadCount)
+{
+    const auto blockSize = GetCompressedBlockSize(dstFormat);
+    if (blockSize == 0)
+        throw std::invalid_argument("cannot compress image into non-compressed image format");
+
+    const auto numBlocksX   = (extent.width  + 3) / 4;
+    const auto numBlocksY   = (extent.height + 3) / 4;
+    const auto sliceStride  = static_cast<std::size_t>(extent.width) * extent.height * 4;
+    auto       dstBlocks    = reinterpret_cast<std::uint8_t*>(dst);
+
+    WorkerPool::Get().ParallelFor(
+        static_cast<std::size_t>(numBlocksY) * extent.depth,
+        std::max(std::size_t(1), g_blockMinWorkSize / numBlocksX),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            std::uint8_t block[64];
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto  z       = static_cast<std::uint32_t>(row / numBlocksY);
+                const auto  y       = static_cast<std::uint32_t>(row % numBlocksY) * 4;
+                const auto  slice   = srcRGBA8 + z * sliceStride;
+                auto        out     = dstBlocks + row * numBlocksX * blockSize;
+
+                for (std::uint32_t x = 0; x < extent.width; x += 4, out += blockSize)
+                {
+                    LoadBlock(block, slice, extent, x, y);
+                    EncodeBlock(dstFormat, out, block);
+                }
+            }
+        }
+    );
+}
+
+void DecompressImageBlocks(
+    const ImageFormat   srcFormat,
+    const void*         src,
+    std::uint8_t*       dstRGBA8,
+    const Extent3D&     extent,
+    std::size_t         threadCount)
+{
+    const auto blockSize = GetCompressedBlockSize(srcFormat);
+    if (blockSize == 0)
+        throw std::invalid_argument("cannot decompress image from non-compressed image format");
+
+    const auto numBlocksX   = (extent.width  + 3) / 4;
+    const auto numBlocksY   = (extent.height + 3) / 4;
+    const auto sliceStride  = static_cast<std::size_t>(extent.width) * extent.height * 4;
+    auto       srcBlocks    = reinterpret_cast<const std::uint8_t*>(src);
+
+    WorkerPool::Get().ParallelFor(
+        static_cast<std::size_t>(numBlocksY) * extent.depth,
+        std::max(std::size_t(1), g_blockMinWorkSize * 4 / numBlocksX),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            std::uint8_t block[64];
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto  z       = static_cast<std::uint32_t>(row / numBlocksY);
+                const auto  y       = static_cast<std::uint32_t>(row % numBlocksY) * 4;
+                auto        slice   = dstRGBA8 + z * sliceStride;
+                auto        in      = srcBlocks + row * numBlocksX * blockSize;
+
+                for (std::uint32_t x = 0; x < extent.width; x += 4, in += blockSize)
+                {
+                    DecodeBlock(srcFormat, block, in);
+                    StoreBlock(block, slice, extent, x, y);
+                }
+            }
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
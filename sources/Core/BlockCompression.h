@@ -0,0 +1,62 @@
+/*
+ * BlockCompression.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BLOCK_COMPRESSION_H
+#define LLGL_BLOCK_COMPRESSION_H
+
+
+#include <LLGL/Format.h>
+#include <LLGL/Types.h>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Returns the size (in bytes) of a 4x4 block for the specified compressed image format, or 0 if the format is not compressed.
+std::size_t GetCompressedBlockSize(const ImageFormat format);
+
+// Returns the size (in bytes) of an image with the specified compressed format and extent. Partial blocks at the borders are rounded up.
+std::size_t GetCompressedImageDataSize(const ImageFormat format, const Extent3D& extent);
+
+/*
+Compresses the RGBA8 source image into the destination buffer with the specified block compression format (BC1 - BC5, or BC7).
+Each slice of a 3D image is compressed separately. Pixels of partial blocks at the borders are replicated from the edge.
+BC1 switches to its 3-color mode with transparent black for blocks that contain pixels with an alpha value below 128.
+BC4 uses the red channel only, and BC5 the red and green channels. BC7 is always encoded in mode 6.
+*/
+void CompressImageBlocks(
+    const ImageFormat   dstFormat,
+    void*               dst,
+    const std::uint8_t* srcRGBA8,
+    const Extent3D&     extent,
+    std::size_t         threadCount
+);
+
+/*
+Decompresses the source buffer with the specified block compression format (BC1 - BC5, or BC7) into the RGBA8 destination image.
+Missing components are set to zero for color and 255 for alpha, e.g. BC4 decompresses to (R, 0, 0, 255).
+*/
+void DecompressImageBlocks(
+    const ImageFormat   srcFormat,
+    const void*         src,
+    std::uint8_t*       dstRGBA8,
+    const Extent3D&     extent,
+    std::size_t         threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
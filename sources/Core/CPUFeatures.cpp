@@ -0,0 +1,112 @@
+/*
+ * CPUFeatures.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CPUFeatures.h"
+#include <LLGL/Platform/Platform.h>
+#include <cstdint>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+
+namespace LLGL
+{
+
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+
+// Stores the registers EAX, EBX, ECX, and EDX of the CPUID instruction for the specified leaf and sub-leaf.
+static void QueryCPUID(std::uint32_t leaf, std::uint32_t subleaf, std::uint32_t (&regs)[4])
+{
+    #ifdef _MSC_VER
+    int info[4] = {};
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; ++i)
+        regs[i] = static_cast<std::uint32_t>(info[i]);
+    #else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+    #endif
+}
+
+// Returns the extended control register XCR0, which specifies the register states the OS saves on context switches.
+static std::uint64_t QueryXCR0()
+{
+    #ifdef _MSC_VER
+    return _xgetbv(0);
+    #else
+    std::uint32_t eax = 0, edx = 0;
+    __asm__ __volatile__ ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((static_cast<std::uint64_t>(edx) << 32) | eax);
+    #endif
+}
+
+static CPUFeatures QueryCPUFeatures()
+{
+    CPUFeatures features;
+
+    std::uint32_t regs[4];
+    QueryCPUID(0, 0, regs);
+    const auto maxLeaf = regs[0];
+
+    if (maxLeaf >= 1)
+    {
+        QueryCPUID(1, 0, regs);
+        features.sse2   = ((regs[3] & (1u << 26)) != 0);
+        features.sse41  = ((regs[2] & (1u << 19)) != 0);
+
+        /* AVX requires the OS to save the YMM registers (XCR0 bits 1 and 2) */
+        const bool osxsave = ((regs[2] & (1u << 27)) != 0);
+        if (osxsave && (QueryXCR0() & 0x6) == 0x6)
+        {
+            features.avx    = ((regs[2] & (1u << 28)) != 0);
+            features.f16c   = (features.avx && (regs[2] & (1u << 29)) != 0);
+
+            if (features.avx && maxLeaf >= 7)
+            {
+                QueryCPUID(7, 0, regs);
+                features.avx2 = ((regs[1] & (1u << 5)) != 0);
+            }
+        }
+    }
+
+    return features;
+}
+
+#else
+
+static CPUFeatures QueryCPUFeatures()
+{
+    CPUFeatures features;
+
+    /* NEON (Advanced SIMD) is a mandatory part of ARMv8-A */
+    #if defined LLGL_ARCH_ARM64 || defined __ARM_NEON
+    features.neon = true;
+    #endif
+
+    return features;
+}
+
+#endif // /LLGL_ARCH_AMD64 || LLGL_ARCH_IA32
+
+const CPUFeatures& GetCPUFeatures()
+{
+    static const CPUFeatures features = QueryCPUFeatures();
+    return features;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,38 @@
+/*
+ * CPUFeatures.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CPU_FEATURES_H
+#define LLGL_CPU_FEATURES_H
+
+
+namespace LLGL
+{
+
+
+// Instruction set extensions of the host CPU that are used by the SIMD code paths.
+struct CPUFeatures
+{
+    bool sse2   = false;
+    bool sse41  = false;
+    bool avx    = false;
+    bool avx2   = false;
+    bool f16c   = false;
+    bool neon   = false;
+};
+
+// Returns the instruction set extensions of the host CPU. The CPU is only queried once.
+const CPUFeatures& GetCPUFeatures();
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
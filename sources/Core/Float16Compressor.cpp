@@ -6,6 +6,24 @@
  */
 
 #include "Float16Compressor.h"
+#include "CPUFeatures.h"
+#include <LLGL/Platform/Platform.h>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_SIMD_X86
+#   include <immintrin.h>
+#elif defined LLGL_ARCH_ARM64
+#   define LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+#if defined LLGL_SIMD_X86 && !defined _MSC_VER
+#   define LLGL_TARGET_SSE2 __attribute__((target("sse2")))
+#   define LLGL_TARGET_F16C __attribute__((target("avx,f16c")))
+#else
+#   define LLGL_TARGET_SSE2
+#   define LLGL_TARGET_F16C
+#endif
 
 
 namespace LLGL
@@ -58,8 +76,234 @@ class Float16Compressor
             return v.f;
         }
 
+        #ifdef LLGL_SIMD_X86
+
+        /*
+        The SSE2 kernels implement the same bit operations as the scalar functions on four elements at once.
+        Each kernel returns the number of elements it has converted, so the caller converts the remainder.
+        */
+
+        LLGL_TARGET_SSE2
+        static std::size_t CompressSSE2(const float* src, std::uint16_t* dst, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i packed = CompressSSE2x8(_mm_loadu_ps(src + i), _mm_loadu_ps(src + i + 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+            }
+            return i;
+        }
+
+        LLGL_TARGET_SSE2
+        static std::size_t DecompressSSE2(const std::uint16_t* src, float* dst, std::size_t count)
+        {
+            const __m128i zero = _mm_setzero_si128();
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                _mm_storeu_ps(dst + i,     _mm_castsi128_ps(DecompressSSE2x4(_mm_unpacklo_epi16(values, zero))));
+                _mm_storeu_ps(dst + i + 4, _mm_castsi128_ps(DecompressSSE2x4(_mm_unpackhi_epi16(values, zero))));
+            }
+            return i;
+        }
+
+        /*
+        The F16C kernels truncate the mantissa like the scalar functions, but the conversion instructions
+        behave differently for finite values beyond the 16-bit range and for NaNs, which are handled separately here.
+        */
+
+        LLGL_TARGET_F16C
+        static std::size_t CompressF16C(const float* src, std::uint16_t* dst, std::size_t count)
+        {
+            const __m256 signMask   = _mm256_castsi256_ps(_mm256_set1_epi32(signN));
+            const __m256 maxNormal  = _mm256_castsi256_ps(_mm256_set1_epi32(maxN));
+            const __m256 infinity   = _mm256_castsi256_ps(_mm256_set1_epi32(infN));
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                __m256 values = _mm256_loadu_ps(src + i);
+                __m128i result;
+
+                if (_mm256_movemask_ps(_mm256_cmp_ps(values, values, _CMP_UNORD_Q)) != 0)
+                {
+                    /* The conversion quiets NaNs, whereas the scalar function keeps their payload, so fall back to the integer path */
+                    result = CompressSSE2x8(_mm256_castps256_ps128(values), _mm256_extractf128_ps(values, 1));
+                }
+                else
+                {
+                    /* Map values beyond the 16-bit range to infinity, because rounding towards zero would clamp them to the maximum */
+                    const __m256 sign       = _mm256_and_ps(values, signMask);
+                    const __m256 overflow   = _mm256_cmp_ps(_mm256_andnot_ps(signMask, values), maxNormal, _CMP_GT_OQ);
+                    values = _mm256_blendv_ps(values, _mm256_or_ps(sign, infinity), overflow);
+                    result = _mm256_cvtps_ph(values, _MM_FROUND_TO_ZERO);
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), result);
+            }
+            return i;
+        }
+
+        LLGL_TARGET_F16C
+        static std::size_t DecompressF16C(const std::uint16_t* src, float* dst, std::size_t count)
+        {
+            const __m128i absMask       = _mm_set1_epi16(0x7FFF);
+            const __m128i infinity      = _mm_set1_epi16(0x7C00);
+            const __m128i quietBit      = _mm_set1_epi16(0x0200);
+            const __m256  quietBit32    = _mm256_castsi256_ps(_mm256_set1_epi32(0x00400000));
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                __m256 result = _mm256_cvtph_ps(values);
+
+                /* The conversion quiets signaling NaNs, whereas the scalar function keeps them signaling */
+                const __m128i isNaN         = _mm_cmpgt_epi16(_mm_and_si128(values, absMask), infinity);
+                const __m128i isSignaling   = _mm_andnot_si128(_mm_cmpeq_epi16(_mm_and_si128(values, quietBit), quietBit), isNaN);
+
+                if (_mm_movemask_epi8(isSignaling) != 0)
+                {
+                    const __m256i mask = _mm256_insertf128_si256(
+                        _mm256_castsi128_si256(_mm_unpacklo_epi16(isSignaling, isSignaling)),
+                        _mm_unpackhi_epi16(isSignaling, isSignaling),
+                        1
+                    );
+                    result = _mm256_andnot_ps(_mm256_and_ps(_mm256_castsi256_ps(mask), quietBit32), result);
+                }
+
+                _mm256_storeu_ps(dst + i, result);
+            }
+            return i;
+        }
+
+        #endif // /LLGL_SIMD_X86
+
+        #ifdef LLGL_SIMD_NEON
+
+        /*
+        FCVTN rounds to nearest, whereas the scalar function truncates the mantissa,
+        so the compression implements the same bit operations as the scalar function on four elements at once.
+        */
+        static std::size_t CompressNEON(const float* src, std::uint16_t* dst, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                int32x4_t v = vreinterpretq_s32_f32(vld1q_f32(src + i));
+
+                int32x4_t sign = vandq_s32(v, vdupq_n_s32(signN));
+                v = veorq_s32(v, sign);
+                sign = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(sign), shiftSign));
+
+                const int32x4_t s = vcvtq_s32_f32(vmulq_f32(vreinterpretq_f32_s32(vdupq_n_s32(mulN)), vreinterpretq_f32_s32(v)));
+                v = SelectNEON(vcgtq_s32(vdupq_n_s32(minN), v), s, v);
+                v = SelectNEON(vandq_u32(vcgtq_s32(vdupq_n_s32(infN), v), vcgtq_s32(v, vdupq_n_s32(maxN))), vdupq_n_s32(infN), v);
+                v = SelectNEON(vandq_u32(vcgtq_s32(vdupq_n_s32(nanN), v), vcgtq_s32(v, vdupq_n_s32(infN))), vdupq_n_s32(nanN), v);
+                v = vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(v), shift));
+                v = SelectNEON(vcgtq_s32(v, vdupq_n_s32(maxC)), vsubq_s32(v, vdupq_n_s32(maxD)), v);
+                v = SelectNEON(vcgtq_s32(v, vdupq_n_s32(subC)), vsubq_s32(v, vdupq_n_s32(minD)), v);
+
+                vst1_u16(dst + i, vmovn_u32(vreinterpretq_u32_s32(vorrq_s32(v, sign))));
+            }
+            return i;
+        }
+
+        static std::size_t DecompressNEON(const std::uint16_t* src, float* dst, std::size_t count)
+        {
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const uint16x4_t values = vld1_u16(src + i);
+                uint32x4_t result = vreinterpretq_u32_f32(vcvt_f32_f16(vreinterpret_f16_u16(values)));
+
+                /* FCVTL quiets signaling NaNs, whereas the scalar function keeps them signaling */
+                const uint16x4_t isNaN          = vcgt_u16(vand_u16(values, vdup_n_u16(0x7FFF)), vdup_n_u16(0x7C00));
+                const uint16x4_t isSignaling    = vbic_u16(isNaN, vtst_u16(values, vdup_n_u16(0x0200)));
+                const uint32x4_t mask           = vreinterpretq_u32_s32(vmovl_s16(vreinterpret_s16_u16(isSignaling)));
+                result = vbicq_u32(result, vandq_u32(mask, vdupq_n_u32(0x00400000)));
+
+                vst1q_f32(dst + i, vreinterpretq_f32_u32(result));
+            }
+            return i;
+        }
+
+        #endif // /LLGL_SIMD_NEON
+
     private:
 
+        #ifdef LLGL_SIMD_X86
+
+        // Returns (mask ? a : b) for each element.
+        LLGL_TARGET_SSE2
+        static __m128i SelectSSE2(__m128i mask, __m128i a, __m128i b)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+
+        LLGL_TARGET_SSE2
+        static __m128i CompressSSE2x4(__m128 value)
+        {
+            __m128i v = _mm_castps_si128(value);
+
+            __m128i sign = _mm_and_si128(v, _mm_set1_epi32(signN));
+            v = _mm_xor_si128(v, sign);
+            sign = _mm_srli_epi32(sign, shiftSign);
+
+            const __m128i s = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(mulN)), _mm_castsi128_ps(v)));
+            v = SelectSSE2(_mm_cmpgt_epi32(_mm_set1_epi32(minN), v), s, v);
+            v = SelectSSE2(_mm_and_si128(_mm_cmpgt_epi32(_mm_set1_epi32(infN), v), _mm_cmpgt_epi32(v, _mm_set1_epi32(maxN))), _mm_set1_epi32(infN), v);
+            v = SelectSSE2(_mm_and_si128(_mm_cmpgt_epi32(_mm_set1_epi32(nanN), v), _mm_cmpgt_epi32(v, _mm_set1_epi32(infN))), _mm_set1_epi32(nanN), v);
+            v = _mm_srli_epi32(v, shift);
+            v = SelectSSE2(_mm_cmpgt_epi32(v, _mm_set1_epi32(maxC)), _mm_sub_epi32(v, _mm_set1_epi32(maxD)), v);
+            v = SelectSSE2(_mm_cmpgt_epi32(v, _mm_set1_epi32(subC)), _mm_sub_epi32(v, _mm_set1_epi32(minD)), v);
+
+            return _mm_or_si128(v, sign);
+        }
+
+        LLGL_TARGET_SSE2
+        static __m128i CompressSSE2x8(__m128 lo, __m128 hi)
+        {
+            /* Sign-extend the 16-bit results, so packing with signed saturation keeps all bits */
+            return _mm_packs_epi32(
+                _mm_srai_epi32(_mm_slli_epi32(CompressSSE2x4(lo), 16), 16),
+                _mm_srai_epi32(_mm_slli_epi32(CompressSSE2x4(hi), 16), 16)
+            );
+        }
+
+        LLGL_TARGET_SSE2
+        static __m128i DecompressSSE2x4(__m128i v)
+        {
+            __m128i sign = _mm_and_si128(v, _mm_set1_epi32(signC));
+            v = _mm_xor_si128(v, sign);
+            sign = _mm_slli_epi32(sign, shiftSign);
+
+            v = SelectSSE2(_mm_cmpgt_epi32(v, _mm_set1_epi32(subC)), _mm_add_epi32(v, _mm_set1_epi32(minD)), v);
+            v = SelectSSE2(_mm_cmpgt_epi32(v, _mm_set1_epi32(maxC)), _mm_add_epi32(v, _mm_set1_epi32(maxD)), v);
+
+            const __m128i s     = _mm_castps_si128(_mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(mulC)), _mm_cvtepi32_ps(v)));
+            const __m128i mask  = _mm_cmpgt_epi32(_mm_set1_epi32(norC), v);
+            v = _mm_slli_epi32(v, shift);
+            v = SelectSSE2(mask, s, v);
+
+            return _mm_or_si128(v, sign);
+        }
+
+        #endif // /LLGL_SIMD_X86
+
+        #ifdef LLGL_SIMD_NEON
+
+        // Returns (mask ? a : b) for each element.
+        static int32x4_t SelectNEON(uint32x4_t mask, int32x4_t a, int32x4_t b)
+        {
+            return vbslq_s32(mask, a, b);
+        }
+
+        #endif // /LLGL_SIMD_NEON
+
         union Bits
         {
             float           f;
@@ -103,6 +347,46 @@ LLGL_EXPORT float DecompressFloat16(std::uint16_t value)
     return Float16Compressor::Decompress(value);
 }
 
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_X86
+    const auto& cpu = GetCPUFeatures();
+    if (cpu.f16c)
+        i = Float16Compressor::CompressF16C(src, dst, count);
+    else if (cpu.sse2)
+        i = Float16Compressor::CompressSSE2(src, dst, count);
+    #elif defined LLGL_SIMD_NEON
+    if (GetCPUFeatures().neon)
+        i = Float16Compressor::CompressNEON(src, dst, count);
+    #endif
+
+    /* Convert remaining elements */
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Compress(src[i]);
+}
+
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_X86
+    const auto& cpu = GetCPUFeatures();
+    if (cpu.f16c)
+        i = Float16Compressor::DecompressF16C(src, dst, count);
+    else if (cpu.sse2)
+        i = Float16Compressor::DecompressSSE2(src, dst, count);
+    #elif defined LLGL_SIMD_NEON
+    if (GetCPUFeatures().neon)
+        i = Float16Compressor::DecompressNEON(src, dst, count);
+    #endif
+
+    /* Convert remaining elements */
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Decompress(src[i]);
+}
+
 
 } // /namespace LLGL
 
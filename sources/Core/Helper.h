@@ -281,6 +281,13 @@ inline T* AdvancePtr(T* ptr, std::size_t offset)
     return reinterpret_cast<T*>(reinterpret_cast<TByteAligned*>(ptr) + offset);
 }
 
+// Combines the hash of the specified value with the seed (same as 'boost::hash_combine').
+template <typename T>
+inline void HashCombine(std::size_t& seed, const T& value)
+{
+    seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
 
 /* ----- Functions ----- */
 
@@ -6,7 +6,9 @@
  */
 
 #include <LLGL/Image.h>
+#include <LLGL/Blob.h>
 #include "ImageUtils.h"
+#include "ImageResampler.h"
 #include <algorithm>
 #include <string.h>
 
@@ -41,17 +43,47 @@ Image::Image(const Extent3D& extent, const ImageFormat format, const DataType da
 {
 }
 
+Image::Image(const Extent3D& extent, const ImageFormat format, const DataType dataType, const std::shared_ptr<Blob>& blob, std::size_t offset) :
+    extent_       { extent   },
+    format_       { format   },
+    dataType_     { dataType },
+    sharedData_   { blob     },
+    sharedOffset_ { offset   }
+{
+    if (!blob)
+        throw std::invalid_argument("cannot initialize image with null pointer to shared image buffer");
+
+    const auto requiredDataSize = GetImageBufferSize(format, dataType, extent);
+    if (offset > blob->GetSize() || blob->GetSize() - offset < requiredDataSize)
+    {
+        throw std::invalid_argument(
+            "data size of shared image buffer is too small (" + std::to_string(requiredDataSize) + " is required at offset " +
+            std::to_string(offset) + ", but only " + std::to_string(blob->GetSize()) + " was specified)"
+        );
+    }
+}
+
 Image::Image(const Image& rhs) :
-    Image { rhs.GetExtent(), rhs.GetFormat(), rhs.GetDataType() }
+    extent_       { rhs.extent_       },
+    format_       { rhs.format_       },
+    dataType_     { rhs.dataType_     },
+    sharedData_   { rhs.sharedData_   },
+    sharedOffset_ { rhs.sharedOffset_ }
 {
-    std::copy(rhs.data_.get(), rhs.data_.get() + rhs.GetDataSize(), data_.get());
+    if (rhs.data_)
+    {
+        data_ = GenerateEmptyByteBuffer(GetDataSize(), false);
+        std::copy(rhs.data_.get(), rhs.data_.get() + rhs.GetDataSize(), data_.get());
+    }
 }
 
 Image::Image(Image&& rhs) :
-    extent_   { rhs.extent_          },
-    format_   { rhs.format_          },
-    dataType_ { rhs.dataType_        },
-    data_     { std::move(rhs.data_) }
+    extent_       { rhs.extent_                },
+    format_       { rhs.format_                },
+    dataType_     { rhs.dataType_              },
+    data_         { std::move(rhs.data_)       },
+    sharedData_   { std::move(rhs.sharedData_) },
+    sharedOffset_ { rhs.sharedOffset_          }
 {
     rhs.ResetAttributes();
 }
@@ -60,30 +92,47 @@ Image::Image(Image&& rhs) :
 
 Image& Image::operator = (const Image& rhs)
 {
-    extent_     = rhs.GetExtent();
-    format_     = rhs.GetFormat();
-    dataType_   = rhs.GetDataType();
-    data_       = GenerateEmptyByteBuffer(GetDataSize(), false);
-    std::copy(rhs.data_.get(), rhs.data_.get() + rhs.GetDataSize(), data_.get());
+    if (this != &rhs)
+    {
+        extent_         = rhs.GetExtent();
+        format_         = rhs.GetFormat();
+        dataType_       = rhs.GetDataType();
+        sharedData_     = rhs.sharedData_;
+        sharedOffset_   = rhs.sharedOffset_;
+        if (rhs.data_)
+        {
+            data_ = GenerateEmptyByteBuffer(GetDataSize(), false);
+            std::copy(rhs.data_.get(), rhs.data_.get() + rhs.GetDataSize(), data_.get());
+        }
+        else
+            data_.reset();
+    }
     return *this;
 }
 
 Image& Image::operator = (Image&& rhs)
 {
     Reset(rhs.GetExtent(), rhs.GetFormat(), rhs.GetDataType(), std::move(rhs.data_));
+    sharedData_     = std::move(rhs.sharedData_);
+    sharedOffset_   = rhs.sharedOffset_;
     rhs.ResetAttributes();
     return *this;
 }
 
 /* ----- Storage ----- */
 
+static std::size_t GetRequiredImageDataSize(const Extent3D& extent, const ImageFormat format, const DataType dataType)
+{
+    return GetImageBufferSize(format, dataType, extent);
+}
+
 void Image::Convert(const ImageFormat format, const DataType dataType, std::size_t threadCount)
 {
     /* Convert image buffer (if necessary) */
-    if (data_)
+    if (GetSrcDesc().data)
     {
-        if (auto convertedData = ConvertImageBuffer(GetSrcDesc(), format, dataType, threadCount))
-            data_ = std::move(convertedData);
+        if (auto convertedData = ConvertImageBuffer(GetSrcDesc(), format, dataType, GetExtent(), threadCount))
+            ResetData(std::move(convertedData));
     }
 
     /* Store new attributes */
@@ -96,9 +145,9 @@ void Image::Resize(const Extent3D& extent)
     /* Allocate new image buffer or release it if the extent is zero */
     extent_ = extent;
     if (extent.width > 0 && extent.height > 0 && extent.depth > 0)
-        data_ = GenerateEmptyByteBuffer(GetDataSize(), false);
+        ResetData(GenerateEmptyByteBuffer(GetDataSize(), false));
     else
-        data_.reset();
+        ResetData(nullptr);
 }
 
 void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor)
@@ -107,7 +156,7 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor)
     {
         /* Generate new image buffer with fill color */
         extent_ = extent;
-        data_   = GenerateImageBuffer(GetFormat(), GetDataType(), GetNumPixels(), fillColor);
+        ResetData(GenerateImageBuffer(GetFormat(), GetDataType(), GetNumPixels(), fillColor));
     }
     else
     {
@@ -123,10 +172,12 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
         /* Store ownership of current image buffer in temporary image */
         Image prevImage;
 
-        prevImage.extent_   = GetExtent();
-        prevImage.format_   = GetFormat();
-        prevImage.dataType_ = GetDataType();
-        prevImage.data_     = std::move(data_);
+        prevImage.extent_       = GetExtent();
+        prevImage.format_       = GetFormat();
+        prevImage.dataType_     = GetDataType();
+        prevImage.data_         = std::move(data_);
+        prevImage.sharedData_   = std::move(sharedData_);
+        prevImage.sharedOffset_ = sharedOffset_;
 
         if ( extent.width  > GetExtent().width  ||
              extent.height > GetExtent().height ||
@@ -134,13 +185,13 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
         {
             /* Resize image buffer with fill color */
             extent_ = extent;
-            data_   = GenerateImageBuffer(GetFormat(), GetDataType(), GetNumPixels(), fillColor);
+            ResetData(GenerateImageBuffer(GetFormat(), GetDataType(), GetNumPixels(), fillColor));
         }
         else
         {
             /* Resize image buffer with uninitialized image buffer */
             extent_ = extent;
-            data_   = GenerateEmptyByteBuffer(GetDataSize(), false);
+            ResetData(GenerateEmptyByteBuffer(GetDataSize(), false));
         }
 
         /* Copy previous image into new image */
@@ -150,7 +201,39 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
 
 void Image::Resize(const Extent3D& extent, const SamplerFilter filter)
 {
-    //todo
+    Resize(extent, (filter == SamplerFilter::Nearest ? ImageFilter::Nearest : ImageFilter::Linear));
+}
+
+void Image::Resize(const Extent3D& extent, const ImageFilter filter, bool sRGB, std::size_t threadCount)
+{
+    if (extent != GetExtent())
+    {
+        if (GetSrcDesc().data && extent.width > 0 && extent.height > 0 && extent.depth > 0)
+        {
+            /* Resample current image buffer into new image buffer */
+            const auto dataSize = GetRequiredImageDataSize(extent, GetFormat(), GetDataType());
+            auto data = GenerateEmptyByteBuffer(dataSize, false);
+
+            ResampleImageBuffer(
+                GetSrcDesc(),
+                GetExtent(),
+                DstImageDescriptor{ GetFormat(), GetDataType(), data.get(), dataSize },
+                extent,
+                filter,
+                sRGB,
+                threadCount
+            );
+
+            /* Store new attributes */
+            extent_ = extent;
+            ResetData(std::move(data));
+        }
+        else
+        {
+            /* Nothing to resample */
+            Resize(extent);
+        }
+    }
 }
 
 void Image::Swap(Image& rhs)
@@ -159,12 +242,14 @@ void Image::Swap(Image& rhs)
     std::swap(format_,   rhs.format_  );
     std::swap(dataType_, rhs.dataType_);
     std::swap(data_,     rhs.data_    );
+    std::swap(sharedData_,   rhs.sharedData_  );
+    std::swap(sharedOffset_, rhs.sharedOffset_);
 }
 
 void Image::Reset()
 {
     ResetAttributes();
-    data_.reset();
+    ResetData(nullptr);
 }
 
 void Image::Reset(const Extent3D& extent, const ImageFormat format, const DataType dataType, ByteBuffer&& data)
@@ -172,11 +257,12 @@ void Image::Reset(const Extent3D& extent, const ImageFormat format, const DataTy
     extent_     = extent;
     format_     = format;
     dataType_   = dataType;
-    data_       = std::move(data);
+    ResetData(std::move(data));
 }
 
 ByteBuffer Image::Release()
 {
+    DetachSharedData();
     ResetAttributes();
     return std::move(data_);
 }
@@ -220,6 +306,18 @@ static bool ShiftNegative1DRegion(std::int32_t& dstOffset, std::uint32_t dstExte
     return true;
 }
 
+// Clamps the specified region to the boundaries [0, limit).
+static void ClampRegionToExtent(Offset3D& offset, Extent3D& extent, const Extent3D& limit)
+{
+    offset.x        = std::max(offset.x, 0);
+    offset.y        = std::max(offset.y, 0);
+    offset.z        = std::max(offset.z, 0);
+
+    extent.width    = std::min(extent.width, limit.width);
+    extent.height   = std::min(extent.height, limit.height);
+    extent.depth    = std::min(extent.depth, limit.depth);
+}
+
 static bool Overlap1DRegion(std::int32_t dstOffset, std::int32_t srcOffset, std::uint32_t extent)
 {
     auto dstOffsetMin = static_cast<std::uint32_t>(dstOffset);
@@ -241,12 +339,21 @@ static bool Overlap3DRegion(const Offset3D& dstOffset, const Offset3D& srcOffset
     );
 }
 
-void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent)
+void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount)
+{
+    Blit(dstRegionOffset, srcImage.GetView(), srcRegionOffset, srcRegionExtent, threadCount);
+}
+
+void Image::Blit(Offset3D dstRegionOffset, const ImageView& srcImageView, Offset3D srcRegionOffset, Extent3D srcRegionExtent, std::size_t threadCount)
 {
-    if (GetFormat() == srcImage.GetFormat() && GetDataType() == srcImage.GetDataType())
+    if (GetFormat() == srcImageView.GetFormat() && GetDataType() == srcImageView.GetDataType())
     {
+        /* Pixels of compressed images are not addressable individually */
+        if (IsCompressedFormat(GetFormat()))
+            throw std::invalid_argument("cannot blit image region with compressed image format");
+
         /* First clamp source region to source image dimension */
-        srcImage.ClampRegion(srcRegionOffset, srcRegionExtent);
+        ClampRegionToExtent(srcRegionOffset, srcRegionExtent, srcImageView.GetExtent());
 
         /* Then shift negative destination region */
         if ( ShiftNegative1DRegion(dstRegionOffset.x, GetExtent().width,  srcRegionOffset.x, srcRegionExtent.width ) &&
@@ -255,17 +362,34 @@ void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRe
         {
             /* Check if a temporary copy of the source image must be allocated */
             Image srcImageTemp;
-            const Image* srcImageRef = &srcImage;
+            ImageView srcImageRef = srcImageView;
 
-            if (srcImageRef == this && Overlap3DRegion(dstRegionOffset, srcRegionOffset, srcRegionExtent))
+            if (srcImageView.GetData() == GetSrcDesc().data)
             {
-                /* Copy source image */
-                srcImageTemp = *this;
-                srcImageRef = &srcImageTemp;
+                /*
+                Copy source image if the regions overlap, or if this image refers to a shared image buffer,
+                since that buffer is released when the image buffer is detached for writing
+                */
+                if (sharedData_ || Overlap3DRegion(dstRegionOffset, srcRegionOffset, srcRegionExtent))
+                {
+                    if (srcImageView.IsRegionInside(srcRegionOffset, srcRegionExtent))
+                    {
+                        /* Copy only the source region, which is much smaller than the entire image when packing atlases */
+                        srcImageTemp = Image{ srcRegionExtent, GetFormat(), GetDataType() };
+                        srcImageView.ReadPixels(srcRegionOffset, srcRegionExtent, srcImageTemp.GetDstDesc(), threadCount);
+                        srcRegionOffset = { 0, 0, 0 };
+                    }
+                    else
+                    {
+                        srcImageTemp = Image{ GetExtent(), GetFormat(), GetDataType(), GenerateEmptyByteBuffer(GetDataSize(), false) };
+                        ::memcpy(srcImageTemp.data_.get(), srcImageView.GetData(), GetDataSize());
+                    }
+                    srcImageRef = srcImageTemp.GetView();
+                }
             }
 
             /* Copy image buffer region */
-            const auto srcExtent = srcImageRef->GetExtent();
+            const auto srcExtent = srcImageRef.GetExtent();
             const auto dstExtent = GetExtent();
 
             CopyImageBufferRegion(
@@ -273,11 +397,12 @@ void Image::Blit(Offset3D dstRegionOffset, const Image& srcImage, Offset3D srcRe
                 dstRegionOffset,
                 dstExtent.width,
                 dstExtent.width * dstExtent.height,
-                srcImageRef->GetSrcDesc(),
+                srcImageRef.GetSrcDesc(),
                 srcRegionOffset,
                 srcExtent.width,
                 srcExtent.width * srcExtent.height,
-                srcRegionExtent
+                srcRegionExtent,
+                threadCount
             );
         }
     }
@@ -290,23 +415,6 @@ void Image::Fill(Offset3D offset, Extent3D extent, const ColorRGBAd& fillColor)
     //TODO
 }
 
-static std::size_t GetRequiredImageDataSize(const Extent3D& extent, const ImageFormat format, const DataType dataType)
-{
-    return static_cast<std::size_t>(ImageFormatSize(format) * DataTypeSize(dataType) * extent.width * extent.height * extent.depth);
-}
-
-static void ValidateImageDataSize(const Extent3D& extent, const DstImageDescriptor& imageDesc)
-{
-    const auto requiredDataSize = GetRequiredImageDataSize(extent, imageDesc.format, imageDesc.dataType);
-    if (imageDesc.dataSize < requiredDataSize)
-    {
-        throw std::invalid_argument(
-            "data size of destinaton image descriptor is too small (" + std::to_string(requiredDataSize) +
-            " is required, but only " + std::to_string(imageDesc.dataSize) + " was specified)"
-        );
-    }
-}
-
 static void ValidateImageDataSize(const Extent3D& extent, const SrcImageDescriptor& imageDesc)
 {
     const auto requiredDataSize = GetRequiredImageDataSize(extent, imageDesc.format, imageDesc.dataType);
@@ -321,49 +429,7 @@ static void ValidateImageDataSize(const Extent3D& extent, const SrcImageDescript
 
 void Image::ReadPixels(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, std::size_t threadCount) const
 {
-    if (imageDesc.data && IsRegionInside(offset, extent))
-    {
-        /* Validate required size */
-        ValidateImageDataSize(extent, imageDesc);
-
-        /* Get source image parameters */
-        const auto  bpp             = GetBytesPerPixel();
-        const auto  srcRowStride    = bpp * GetExtent().width;
-        const auto  srcDepthStride  = srcRowStride * GetExtent().height;
-        auto        src             = data_.get() + GetDataPtrOffset(offset);
-
-        if (GetFormat() == imageDesc.format && GetDataType() == imageDesc.dataType)
-        {
-            /* Get destination image parameters */
-            const auto  dstRowStride    = bpp * extent.width;
-            const auto  dstDepthStride  = dstRowStride * extent.height;
-            auto        dst             = reinterpret_cast<char*>(imageDesc.data);
-
-            /* Blit region into destination image */
-            BitBlit(
-                extent, bpp,
-                dst, dstRowStride, dstDepthStride,
-                src, srcRowStride, srcDepthStride
-            );
-        }
-        else
-        {
-            /* Copy region into temporary sub-image */
-            Image subImage { extent, GetFormat(), GetDataType() };
-
-            BitBlit(
-                extent, bpp,
-                reinterpret_cast<char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride(),
-                src, srcRowStride, srcDepthStride
-            );
-
-            /* Convert sub-image */
-            subImage.Convert(imageDesc.format, imageDesc.dataType, threadCount);
-
-            /* Copy sub-image into output data */
-            ::memcpy(imageDesc.data, subImage.GetData(), imageDesc.dataSize);
-        }
-    }
+    GetView().ReadPixels(offset, extent, imageDesc, threadCount);
 }
 
 void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, std::size_t threadCount)
@@ -373,11 +439,21 @@ void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const Sr
         /* Validate required size */
         ValidateImageDataSize(extent, imageDesc);
 
+        if (IsCompressedFormat(GetFormat()))
+        {
+            /* Compressed images can only be written entirely, since their pixels are not addressable individually */
+            if (offset != Offset3D{ 0, 0, 0 } || extent != GetExtent())
+                throw std::invalid_argument("cannot write sub-region of image with compressed image format");
+            if (!ConvertImageBuffer(imageDesc, GetDstDesc(), extent, threadCount))
+                ::memcpy(GetData(), imageDesc.data, GetDataSize());
+            return;
+        }
+
         /* Get destination image parameters */
         const auto  bpp             = GetBytesPerPixel();
         const auto  dstRowStride    = bpp * GetExtent().width;
         const auto  dstDepthStride  = dstRowStride * GetExtent().height;
-        auto        dst             = data_.get() + GetDataPtrOffset(offset);
+        auto        dst             = reinterpret_cast<char*>(GetData()) + GetDataPtrOffset(offset);
 
         if (GetFormat() == imageDesc.format && GetDataType() == imageDesc.dataType)
         {
@@ -412,19 +488,33 @@ void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const Sr
     }
 }
 
-void Image::MirrorYZPlane()
+void Image::MirrorYZPlane(std::size_t threadCount)
 {
-    //TODO
+    if (!IsCompressedFormat(GetFormat()) && GetData() != nullptr)
+        MirrorImageBufferX(reinterpret_cast<char*>(GetData()), GetExtent(), GetBytesPerPixel(), threadCount);
 }
 
-void Image::MirrorXZPlane()
+void Image::MirrorXZPlane(std::size_t threadCount)
 {
-    //TODO
+    if (!IsCompressedFormat(GetFormat()) && GetData() != nullptr)
+        MirrorImageBufferY(reinterpret_cast<char*>(GetData()), GetExtent(), GetBytesPerPixel(), threadCount);
 }
 
-void Image::MirrorXYPlane()
+void Image::MirrorXYPlane(std::size_t threadCount)
 {
-    //TODO
+    if (!IsCompressedFormat(GetFormat()) && GetData() != nullptr)
+        MirrorImageBufferZ(reinterpret_cast<char*>(GetData()), GetExtent(), GetBytesPerPixel(), threadCount);
+}
+
+void Image::Transpose(std::size_t threadCount)
+{
+    TransposeSlices(false, false, threadCount);
+}
+
+void Image::Rotate90(bool clockwise, std::size_t threadCount)
+{
+    /* A clockwise rotation mirrors the rows of the transposed image, a counter-clockwise rotation mirrors the order of its rows */
+    TransposeSlices(clockwise, !clockwise, threadCount);
 }
 
 /* ----- Attributes ----- */
@@ -453,6 +543,24 @@ DstImageDescriptor Image::GetDstDesc()
     return imageDesc;
 }
 
+ImageView Image::GetView() const
+{
+    return ImageView{ GetExtent(), GetFormat(), GetDataType(), GetData() };
+}
+
+const void* Image::GetData() const
+{
+    if (sharedData_)
+        return reinterpret_cast<const char*>(sharedData_->GetData()) + sharedOffset_;
+    return data_.get();
+}
+
+void* Image::GetData()
+{
+    DetachSharedData();
+    return data_.get();
+}
+
 std::uint32_t Image::GetBytesPerPixel() const
 {
     return (ImageFormatSize(format_) * DataTypeSize(dataType_));
@@ -460,17 +568,17 @@ std::uint32_t Image::GetBytesPerPixel() const
 
 std::uint32_t Image::GetRowStride() const
 {
-    return (GetBytesPerPixel() * GetExtent().width);
+    return static_cast<std::uint32_t>(GetImageBufferSize(GetFormat(), GetDataType(), Extent3D{ GetExtent().width, 1, 1 }));
 }
 
 std::uint32_t Image::GetDepthStride() const
 {
-    return (GetRowStride() * GetExtent().height);
+    return static_cast<std::uint32_t>(GetImageBufferSize(GetFormat(), GetDataType(), Extent3D{ GetExtent().width, GetExtent().height, 1 }));
 }
 
 std::uint32_t Image::GetDataSize() const
 {
-    return (GetNumPixels() * GetBytesPerPixel());
+    return static_cast<std::uint32_t>(GetImageBufferSize(GetFormat(), GetDataType(), GetExtent()));
 }
 
 std::uint32_t Image::GetNumPixels() const
@@ -516,15 +624,133 @@ std::size_t Image::GetDataPtrOffset(const Offset3D& offset) const
     return (bpp * (x + (y + z * h) * w));
 }
 
+void Image::ResetData(ByteBuffer&& data)
+{
+    data_ = std::move(data);
+    sharedData_.reset();
+    sharedOffset_ = 0;
+}
+
+void Image::DetachSharedData()
+{
+    if (sharedData_)
+    {
+        /* Copy shared image buffer into a buffer owned by this image */
+        const auto dataSize = GetImageBufferSize(GetFormat(), GetDataType(), GetExtent());
+        auto data = GenerateEmptyByteBuffer(dataSize, false);
+        ::memcpy(data.get(), reinterpret_cast<const char*>(sharedData_->GetData()) + sharedOffset_, dataSize);
+        ResetData(std::move(data));
+    }
+}
+
+void Image::TransposeSlices(bool flipX, bool flipY, std::size_t threadCount)
+{
+    if (IsCompressedFormat(GetFormat()) || GetSrcDesc().data == nullptr)
+        return;
+
+    const auto bpp = GetBytesPerPixel();
+
+    if (extent_.width == extent_.height && !sharedData_)
+    {
+        /* Transpose square image in place, then mirror the transposed image for rotations */
+        auto data = reinterpret_cast<char*>(data_.get());
+        TransposeSquareImageBuffer(data, extent_, bpp, threadCount);
+        if (flipX)
+            MirrorImageBufferX(data, extent_, bpp, threadCount);
+        if (flipY)
+            MirrorImageBufferY(data, extent_, bpp, threadCount);
+    }
+    else
+    {
+        /* Transpose image into new image buffer; this also avoids copying a shared image buffer before it is released */
+        auto data = GenerateEmptyByteBuffer(GetDataSize(), false);
+        TransposeImageBuffer(data.get(), reinterpret_cast<const char*>(GetSrcDesc().data), extent_, bpp, flipX, flipY, threadCount);
+        std::swap(extent_.width, extent_.height);
+        ResetData(std::move(data));
+    }
+}
+
 void Image::ClampRegion(Offset3D& offset, Extent3D& extent) const
 {
-    offset.x        = std::max(offset.x, 0);
-    offset.y        = std::max(offset.y, 0);
-    offset.z        = std::max(offset.z, 0);
+    ClampRegionToExtent(offset, extent, GetExtent());
+}
+
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT MipChain GenerateMipChain(
+    const Image&        image,
+    const TextureType   type,
+    const ImageFilter   filter,
+    bool                sRGB,
+    std::uint32_t       numMipLevels,
+    std::size_t         threadCount)
+{
+    /* Validate input parameters */
+    if (!image.GetData() || image.GetNumPixels() == 0)
+        throw std::invalid_argument("cannot generate MIP-map chain from empty image");
+    if (IsMultiSampleTexture(type))
+        throw std::invalid_argument("cannot generate MIP-map chain for multi-sampled texture type");
+    if (IsCompressedFormat(image.GetFormat()))
+        throw std::invalid_argument("cannot generate MIP-map chain for compressed image format");
+    if (IsDepthStencilFormat(image.GetFormat()))
+        throw std::invalid_argument("cannot generate MIP-map chain for depth-stencil image format");
+
+    const auto format   = image.GetFormat();
+    const auto dataType = image.GetDataType();
+    const auto extent   = image.GetExtent();
+
+    /* Determine number of MIP-map levels and their location within the contiguous buffer */
+    const auto maxNumMipLevels = NumMipLevels(type, extent);
+    if (numMipLevels == 0 || numMipLevels > maxNumMipLevels)
+        numMipLevels = maxNumMipLevels;
+
+    MipChain mipChain;
+    mipChain.extents.resize(numMipLevels);
+
+    std::vector<std::size_t> offsets(numMipLevels);
+    std::size_t dataSize = 0;
+
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        /* Cube faces are stored in the depth of the image just like the layers of a cube array */
+        mipChain.extents[mipLevel] = GetMipExtent((type == TextureType::TextureCube ? TextureType::TextureCubeArray : type), extent, mipLevel);
+        offsets[mipLevel] = dataSize;
+        dataSize += GetRequiredImageDataSize(mipChain.extents[mipLevel], format, dataType);
+    }
+
+    mipChain.data = GenerateEmptyByteBuffer(dataSize, false);
+
+    mipChain.levels.resize(numMipLevels);
+    for (std::uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel)
+    {
+        auto& level = mipChain.levels[mipLevel];
+        level.format    = format;
+        level.dataType  = dataType;
+        level.data      = mipChain.data.get() + offsets[mipLevel];
+        level.dataSize  = GetRequiredImageDataSize(mipChain.extents[mipLevel], format, dataType);
+    }
+
+    /* Copy first MIP-map level and downsample each following level from its predecessor (each level is processed in parallel) */
+    ::memcpy(mipChain.data.get(), image.GetData(), mipChain.levels[0].dataSize);
+
+    for (std::uint32_t mipLevel = 1; mipLevel < numMipLevels; ++mipLevel)
+    {
+        const auto& srcLevel = mipChain.levels[mipLevel - 1];
+        const auto& dstLevel = mipChain.levels[mipLevel];
+        ResampleImageBuffer(
+            srcLevel,
+            mipChain.extents[mipLevel - 1],
+            DstImageDescriptor{ format, dataType, mipChain.data.get() + offsets[mipLevel], dstLevel.dataSize },
+            mipChain.extents[mipLevel],
+            filter,
+            sRGB,
+            threadCount
+        );
+    }
 
-    extent.width    = std::min(extent.width, GetExtent().width);
-    extent.height   = std::min(extent.height, GetExtent().height);
-    extent.depth    = std::min(extent.depth, GetExtent().depth);
+    return mipChain;
 }
 
 
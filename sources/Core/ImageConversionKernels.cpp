@@ -0,0 +1,891 @@
+/*
+ * ImageConversionKernels.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageConversionKernels.h"
+#include "CPUFeatures.h"
+#include "Float16Compressor.h"
+#include <LLGL/Platform/Platform.h>
+#include <limits>
+#include <cstdint>
+
+#if defined LLGL_ARCH_AMD64 || defined LLGL_ARCH_IA32
+#   define LLGL_SIMD_X86
+#   include <immintrin.h>
+#elif defined LLGL_ARCH_ARM64
+#   define LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+/*
+GCC and Clang only compile intrinsics for instruction sets that are enabled for the respective function,
+so the kernels are annotated with their target instead of compiling the entire project for that target.
+*/
+#if defined LLGL_SIMD_X86 && !defined _MSC_VER
+#   define LLGL_TARGET_SSE2 __attribute__((target("sse2")))
+#   define LLGL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#   define LLGL_TARGET_SSE2
+#   define LLGL_TARGET_AVX2
+#endif
+
+
+namespace LLGL
+{
+
+
+/* ----- Scalar conversions ----- */
+
+/*
+These are used for the remaining elements that don't fill an entire SIMD register.
+They must produce the same results as the generic conversion in "ConvertDataTypeGeneric".
+*/
+
+template <typename T>
+float ReadNormalized(T src)
+{
+    const auto min = static_cast<double>(std::numeric_limits<T>::min());
+    const auto max = static_cast<double>(std::numeric_limits<T>::max());
+    return static_cast<float>((static_cast<double>(src) - min) / (max - min));
+}
+
+template <typename T>
+T WriteNormalized(float value)
+{
+    const auto min = static_cast<double>(std::numeric_limits<T>::min());
+    const auto max = static_cast<double>(std::numeric_limits<T>::max());
+
+    /* Clamp value to [0, 1] (NaN is mapped to 0 like the SIMD min/max instructions do) */
+    value = (value > 0.0f ? value : 0.0f);
+    value = (value < 1.0f ? value : 1.0f);
+
+    return static_cast<T>(static_cast<double>(value) * (max - min) + min);
+}
+
+template <typename T>
+void ConvertNormalizedToFloat32(const T* src, float* dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = ReadNormalized(src[i]);
+}
+
+template <typename T>
+void ConvertFloat32ToNormalized(const float* src, T* dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = WriteNormalized<T>(src[i]);
+}
+
+// Scale and offset to map the range [0, 1] to the range of the integral type T.
+template <typename T>
+struct NormalizedRange
+{
+    static constexpr double scale   = static_cast<double>(std::numeric_limits<T>::max()) - static_cast<double>(std::numeric_limits<T>::min());
+    static constexpr double offset  = static_cast<double>(std::numeric_limits<T>::min());
+};
+
+
+/* ----- Generic conversion ----- */
+
+// Reads the specified source element and returns it in the normalized range [0, 1].
+template <typename T>
+double ReadNormalizedElement(const void* src, std::size_t idx)
+{
+    const auto min = static_cast<double>(std::numeric_limits<T>::min());
+    const auto max = static_cast<double>(std::numeric_limits<T>::max());
+    return (static_cast<double>(static_cast<const T*>(src)[idx]) - min) / (max - min);
+}
+
+// Writes the specified value from the range [0, 1] to the destination element.
+template <typename T>
+void WriteNormalizedElement(void* dst, std::size_t idx, double value)
+{
+    const auto min = static_cast<double>(std::numeric_limits<T>::min());
+    const auto max = static_cast<double>(std::numeric_limits<T>::max());
+    static_cast<T*>(dst)[idx] = static_cast<T>(value * (max - min) + min);
+}
+
+static double ReadNormalizedDataType(DataType srcDataType, const void* src, std::size_t idx)
+{
+    switch (srcDataType)
+    {
+        case DataType::Undefined:
+            break;
+        case DataType::Int8:
+            return ReadNormalizedElement<std::int8_t>(src, idx);
+        case DataType::UInt8:
+            return ReadNormalizedElement<std::uint8_t>(src, idx);
+        case DataType::Int16:
+            return ReadNormalizedElement<std::int16_t>(src, idx);
+        case DataType::UInt16:
+            return ReadNormalizedElement<std::uint16_t>(src, idx);
+        case DataType::Int32:
+            return ReadNormalizedElement<std::int32_t>(src, idx);
+        case DataType::UInt32:
+            return ReadNormalizedElement<std::uint32_t>(src, idx);
+        case DataType::Float16:
+            return static_cast<double>(DecompressFloat16(static_cast<const std::uint16_t*>(src)[idx]));
+        case DataType::Float32:
+            return static_cast<double>(static_cast<const float*>(src)[idx]);
+        case DataType::Float64:
+            return static_cast<const double*>(src)[idx];
+    }
+    return 0.0;
+}
+
+
+#ifdef LLGL_SIMD_X86
+
+/* ----- SSE2 kernels ----- */
+
+// Converts 16 unsigned bytes into normalized floats.
+LLGL_TARGET_SSE2
+static void StoreUInt8x16AsFloat32SSE2(__m128i v, float* dst)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128  scale = _mm_set1_ps(255.0f);
+
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+    _mm_storeu_ps(dst     , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+    _mm_storeu_ps(dst +  4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+    _mm_storeu_ps(dst +  8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+    _mm_storeu_ps(dst + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+}
+
+// Converts four floats into 32-bit integers by truncating 'clamp(x, 0, 1) * scale + offset' with double precision.
+LLGL_TARGET_SSE2
+static __m128i NormalizedToInt32SSE2(__m128 x, __m128d scale, __m128d offset)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    const __m128d lo = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(x), scale), offset);
+    const __m128d hi = _mm_add_pd(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), scale), offset);
+    return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+}
+
+LLGL_TARGET_SSE2
+static void ConvertUInt8ToFloat32SSE2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::uint8_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+        StoreUInt8x16AsFloat32SSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), d + i);
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_SSE2
+static void ConvertInt8ToFloat32SSE2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::int8_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    /* Flipping the sign bit maps [-128, 127] to [0, 255], i.e. the same as adding 128 */
+    const __m128i signBit = _mm_set1_epi8(static_cast<char>(0x80));
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+        StoreUInt8x16AsFloat32SSE2(_mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)), signBit), d + i);
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_SSE2
+static void ConvertUInt16ToFloat32SSE2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::uint16_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128  scale = _mm_set1_ps(65535.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        _mm_storeu_ps(d + i    , _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), scale));
+        _mm_storeu_ps(d + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), scale));
+    }
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_SSE2
+static void ConvertFloat32ToUInt8SSE2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::uint8_t*>(dst);
+
+    const __m128d scale     = _mm_set1_pd(NormalizedRange<std::uint8_t>::scale);
+    const __m128d offset    = _mm_set1_pd(NormalizedRange<std::uint8_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i     ), scale, offset);
+        const __m128i v1 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i +  4), scale, offset);
+        const __m128i v2 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i +  8), scale, offset);
+        const __m128i v3 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i + 12), scale, offset);
+        const __m128i v  = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), v);
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_SSE2
+static void ConvertFloat32ToInt8SSE2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::int8_t*>(dst);
+
+    const __m128d scale     = _mm_set1_pd(NormalizedRange<std::int8_t>::scale);
+    const __m128d offset    = _mm_set1_pd(NormalizedRange<std::int8_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i     ), scale, offset);
+        const __m128i v1 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i +  4), scale, offset);
+        const __m128i v2 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i +  8), scale, offset);
+        const __m128i v3 = NormalizedToInt32SSE2(_mm_loadu_ps(s + i + 12), scale, offset);
+        const __m128i v  = _mm_packs_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), v);
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_SSE2
+static void ConvertFloat32ToUInt16SSE2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::uint16_t*>(dst);
+
+    const __m128d scale     = _mm_set1_pd(NormalizedRange<std::uint16_t>::scale);
+    const __m128d offset    = _mm_set1_pd(NormalizedRange<std::uint16_t>::offset);
+
+    /* SSE2 has no unsigned 32-to-16 bit pack, so the values are biased into the signed range and back */
+    const __m128i bias32    = _mm_set1_epi32(0x8000);
+    const __m128i bias16    = _mm_set1_epi16(static_cast<short>(0x8000));
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v0 = _mm_sub_epi32(NormalizedToInt32SSE2(_mm_loadu_ps(s + i    ), scale, offset), bias32);
+        const __m128i v1 = _mm_sub_epi32(NormalizedToInt32SSE2(_mm_loadu_ps(s + i + 4), scale, offset), bias32);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_xor_si128(_mm_packs_epi32(v0, v1), bias16));
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+
+/* ----- AVX2 kernels ----- */
+
+// Converts four floats into 32-bit integers by truncating 'clamp(x, 0, 1) * scale + offset' with double precision.
+LLGL_TARGET_AVX2
+static __m128i NormalizedToInt32AVX2(__m128 x, __m256d scale, __m256d offset)
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm256_cvttpd_epi32(_mm256_add_pd(_mm256_mul_pd(_mm256_cvtps_pd(x), scale), offset));
+}
+
+LLGL_TARGET_AVX2
+static void ConvertUInt8ToFloat32AVX2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::uint8_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    const __m256 scale = _mm256_set1_ps(255.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + i)));
+        _mm256_storeu_ps(d + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_AVX2
+static void ConvertInt8ToFloat32AVX2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::int8_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    const __m256    scale   = _mm256_set1_ps(255.0f);
+    const __m128i   signBit = _mm_set1_epi8(static_cast<char>(0x80));
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v = _mm_xor_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + i)), signBit);
+        _mm256_storeu_ps(d + i, _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)), scale));
+    }
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_AVX2
+static void ConvertUInt16ToFloat32AVX2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::uint16_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    const __m256 scale = _mm256_set1_ps(65535.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i)));
+        _mm256_storeu_ps(d + i, _mm256_div_ps(_mm256_cvtepi32_ps(v), scale));
+    }
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_AVX2
+static void ConvertFloat32ToUInt8AVX2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::uint8_t*>(dst);
+
+    const __m256d scale     = _mm256_set1_pd(NormalizedRange<std::uint8_t>::scale);
+    const __m256d offset    = _mm256_set1_pd(NormalizedRange<std::uint8_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i     ), scale, offset);
+        const __m128i v1 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i +  4), scale, offset);
+        const __m128i v2 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i +  8), scale, offset);
+        const __m128i v3 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i + 12), scale, offset);
+        const __m128i v  = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), v);
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_AVX2
+static void ConvertFloat32ToInt8AVX2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::int8_t*>(dst);
+
+    const __m256d scale     = _mm256_set1_pd(NormalizedRange<std::int8_t>::scale);
+    const __m256d offset    = _mm256_set1_pd(NormalizedRange<std::int8_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+    {
+        const __m128i v0 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i     ), scale, offset);
+        const __m128i v1 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i +  4), scale, offset);
+        const __m128i v2 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i +  8), scale, offset);
+        const __m128i v3 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i + 12), scale, offset);
+        const __m128i v  = _mm_packs_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), v);
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+LLGL_TARGET_AVX2
+static void ConvertFloat32ToUInt16AVX2(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::uint16_t*>(dst);
+
+    const __m256d scale     = _mm256_set1_pd(NormalizedRange<std::uint16_t>::scale);
+    const __m256d offset    = _mm256_set1_pd(NormalizedRange<std::uint16_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i v0 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i    ), scale, offset);
+        const __m128i v1 = NormalizedToInt32AVX2(_mm_loadu_ps(s + i + 4), scale, offset);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_packus_epi32(v0, v1));
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+
+#endif // /LLGL_SIMD_X86
+
+
+#ifdef LLGL_SIMD_NEON
+
+/* ----- NEON kernels ----- */
+
+// Converts 16 unsigned bytes into normalized floats.
+static void StoreUInt8x16AsFloat32NEON(uint8x16_t v, float* dst)
+{
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+
+    vst1q_f32(dst     , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), scale));
+    vst1q_f32(dst +  4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), scale));
+    vst1q_f32(dst +  8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), scale));
+    vst1q_f32(dst + 12, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), scale));
+}
+
+// Converts four floats into 32-bit integers by truncating 'clamp(x, 0, 1) * scale + offset' with double precision.
+static int32x4_t NormalizedToInt32NEON(float32x4_t x, float64x2_t scale, float64x2_t offset)
+{
+    /* FMAXNM/FMINNM return the numeric operand if the other one is NaN, so NaN is mapped to 0 */
+    x = vminnmq_f32(vmaxnmq_f32(x, vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+    const float64x2_t lo = vaddq_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(x)), scale), offset);
+    const float64x2_t hi = vaddq_f64(vmulq_f64(vcvt_high_f64_f32(x), scale), offset);
+    return vcombine_s32(vmovn_s64(vcvtq_s64_f64(lo)), vmovn_s64(vcvtq_s64_f64(hi)));
+}
+
+static void ConvertUInt8ToFloat32NEON(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::uint8_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+        StoreUInt8x16AsFloat32NEON(vld1q_u8(s + i), d + i);
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+static void ConvertInt8ToFloat32NEON(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::int8_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    /* Flipping the sign bit maps [-128, 127] to [0, 255], i.e. the same as adding 128 */
+    const uint8x16_t signBit = vdupq_n_u8(0x80);
+
+    std::size_t i = 0;
+    for (; i + 16 <= count; i += 16)
+        StoreUInt8x16AsFloat32NEON(veorq_u8(vld1q_u8(reinterpret_cast<const std::uint8_t*>(s + i)), signBit), d + i);
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+static void ConvertUInt16ToFloat32NEON(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const std::uint16_t*>(src);
+    auto d = static_cast<float*>(dst);
+
+    const float32x4_t scale = vdupq_n_f32(65535.0f);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const uint16x8_t v = vld1q_u16(s + i);
+        vst1q_f32(d + i    , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(v))), scale));
+        vst1q_f32(d + i + 4, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(v))), scale));
+    }
+
+    ConvertNormalizedToFloat32(s + i, d + i, count - i);
+}
+
+static void ConvertFloat32ToUInt8NEON(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::uint8_t*>(dst);
+
+    const float64x2_t scale     = vdupq_n_f64(NormalizedRange<std::uint8_t>::scale);
+    const float64x2_t offset    = vdupq_n_f64(NormalizedRange<std::uint8_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const int32x4_t v0 = NormalizedToInt32NEON(vld1q_f32(s + i    ), scale, offset);
+        const int32x4_t v1 = NormalizedToInt32NEON(vld1q_f32(s + i + 4), scale, offset);
+        vst1_u8(d + i, vqmovn_u16(vcombine_u16(vqmovun_s32(v0), vqmovun_s32(v1))));
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+static void ConvertFloat32ToInt8NEON(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::int8_t*>(dst);
+
+    const float64x2_t scale     = vdupq_n_f64(NormalizedRange<std::int8_t>::scale);
+    const float64x2_t offset    = vdupq_n_f64(NormalizedRange<std::int8_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const int32x4_t v0 = NormalizedToInt32NEON(vld1q_f32(s + i    ), scale, offset);
+        const int32x4_t v1 = NormalizedToInt32NEON(vld1q_f32(s + i + 4), scale, offset);
+        vst1_s8(d + i, vqmovn_s16(vcombine_s16(vqmovn_s32(v0), vqmovn_s32(v1))));
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+static void ConvertFloat32ToUInt16NEON(const void* src, void* dst, std::size_t count)
+{
+    auto s = static_cast<const float*>(src);
+    auto d = static_cast<std::uint16_t*>(dst);
+
+    const float64x2_t scale     = vdupq_n_f64(NormalizedRange<std::uint16_t>::scale);
+    const float64x2_t offset    = vdupq_n_f64(NormalizedRange<std::uint16_t>::offset);
+
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const int32x4_t v0 = NormalizedToInt32NEON(vld1q_f32(s + i    ), scale, offset);
+        const int32x4_t v1 = NormalizedToInt32NEON(vld1q_f32(s + i + 4), scale, offset);
+        vst1q_u16(d + i, vcombine_u16(vqmovun_s32(v0), vqmovun_s32(v1)));
+    }
+
+    ConvertFloat32ToNormalized(s + i, d + i, count - i);
+}
+
+#endif // /LLGL_SIMD_NEON
+
+
+/* ----- Float16 kernels ----- */
+
+/*
+The bulk Float16 functions select F16C, SSE2, or NEON internally
+and produce the same results as the scalar functions on every architecture.
+*/
+
+static void ConvertFloat16ToFloat32Bulk(const void* src, void* dst, std::size_t count)
+{
+    DecompressFloat16Array(static_cast<const std::uint16_t*>(src), static_cast<float*>(dst), count);
+}
+
+static void ConvertFloat32ToFloat16Bulk(const void* src, void* dst, std::size_t count)
+{
+    CompressFloat16Array(static_cast<const float*>(src), static_cast<std::uint16_t*>(dst), count);
+}
+
+
+/* ----- Format conversion kernels ----- */
+
+/*
+The channel layout of a color format stores the RGBA channel (0 = red, 1 = green, 2 = blue, 3 = alpha)
+of each component in a nibble, starting with the first component in the lowest nibble.
+*/
+
+constexpr unsigned GetChannelLayout(ImageFormat format)
+{
+    return
+    (
+        format == ImageFormat::Alpha    ? 0x3u    :
+        format == ImageFormat::R        ? 0x0u    :
+        format == ImageFormat::RG       ? 0x10u   :
+        format == ImageFormat::RGB      ? 0x210u  :
+        format == ImageFormat::BGR      ? 0x012u  :
+        format == ImageFormat::RGBA     ? 0x3210u :
+        format == ImageFormat::BGRA     ? 0x3012u :
+        format == ImageFormat::ARGB     ? 0x2103u :
+        format == ImageFormat::ABGR     ? 0x0123u :
+        0u
+    );
+}
+
+constexpr int GetComponentCount(ImageFormat format)
+{
+    return
+    (
+        format == ImageFormat::Alpha || format == ImageFormat::R                                                            ? 1 :
+        format == ImageFormat::RG                                                                                           ? 2 :
+        format == ImageFormat::RGB   || format == ImageFormat::BGR                                                          ? 3 :
+        format == ImageFormat::RGBA  || format == ImageFormat::BGRA || format == ImageFormat::ARGB || format == ImageFormat::ABGR ? 4 :
+        0
+    );
+}
+
+constexpr int GetComponentChannel(ImageFormat format, int component)
+{
+    return static_cast<int>((GetChannelLayout(format) >> (component * 4)) & 0xF);
+}
+
+// Returns the component index of the specified channel in the image format, or -1 if the format has no such channel.
+constexpr int FindChannelComponent(ImageFormat format, int channel, int component = 0)
+{
+    return
+    (
+        component >= GetComponentCount(format)              ? -1        :
+        GetComponentChannel(format, component) == channel   ? component :
+        FindChannelComponent(format, channel, component + 1)
+    );
+}
+
+// Returns the source component index for the destination component, or -1 if the destination component must be filled with a default value.
+constexpr int GetSourceComponent(ImageFormat srcFormat, ImageFormat dstFormat, int dstComponent)
+{
+    return (dstComponent < GetComponentCount(dstFormat) ? FindChannelComponent(srcFormat, GetComponentChannel(dstFormat, dstComponent)) : -1);
+}
+
+// Reads the source component, or returns the default value if the index is negative. The index is a template parameter to resolve it at compile time.
+template <typename T, int SrcComponent>
+struct ReadComponent
+{
+    static T Get(const T* src, T /*defaultValue*/)
+    {
+        return src[SrcComponent];
+    }
+};
+
+template <typename T>
+struct ReadComponent<T, -1>
+{
+    static T Get(const T* /*src*/, T defaultValue)
+    {
+        return defaultValue;
+    }
+};
+
+/*
+Each pair of image formats is converted by its own instance of this template,
+so the component mapping is resolved at compile time and each pixel is converted without branches.
+*/
+template <typename T, ImageFormat SrcFormat, ImageFormat DstFormat>
+void ConvertImageFormatTyped(const void* src, void* dst, std::size_t count, const void* colorDefault, const void* alphaDefault)
+{
+    constexpr int srcComponents = GetComponentCount(SrcFormat);
+    constexpr int dstComponents = GetComponentCount(DstFormat);
+
+    const T colorValue = *static_cast<const T*>(colorDefault);
+    const T alphaValue = *static_cast<const T*>(alphaDefault);
+
+    const T defaults[4] =
+    {
+        (GetComponentChannel(DstFormat, 0) == 3 ? alphaValue : colorValue),
+        (GetComponentChannel(DstFormat, 1) == 3 ? alphaValue : colorValue),
+        (GetComponentChannel(DstFormat, 2) == 3 ? alphaValue : colorValue),
+        (GetComponentChannel(DstFormat, 3) == 3 ? alphaValue : colorValue),
+    };
+
+    auto s = static_cast<const T*>(src);
+    auto d = static_cast<T*>(dst);
+
+    for (std::size_t i = 0; i < count; ++i, s += srcComponents, d += dstComponents)
+    {
+        /* Read all components before writing them, so the compiler can keep them in registers */
+        const T c0 = ReadComponent<T, GetSourceComponent(SrcFormat, DstFormat, 0)>::Get(s, defaults[0]);
+        const T c1 = ReadComponent<T, GetSourceComponent(SrcFormat, DstFormat, 1)>::Get(s, defaults[1]);
+        const T c2 = ReadComponent<T, GetSourceComponent(SrcFormat, DstFormat, 2)>::Get(s, defaults[2]);
+        const T c3 = ReadComponent<T, GetSourceComponent(SrcFormat, DstFormat, 3)>::Get(s, defaults[3]);
+
+        if (dstComponents > 0) { d[0] = c0; }
+        if (dstComponents > 1) { d[1] = c1; }
+        if (dstComponents > 2) { d[2] = c2; }
+        if (dstComponents > 3) { d[3] = c3; }
+    }
+}
+
+template <typename T, ImageFormat SrcFormat>
+FormatConversionKernel SelectFormatConversionKernel(ImageFormat dstFormat)
+{
+    switch (dstFormat)
+    {
+        case ImageFormat::Alpha:    return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::Alpha>;
+        case ImageFormat::R:        return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::R    >;
+        case ImageFormat::RG:       return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::RG   >;
+        case ImageFormat::RGB:      return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::RGB  >;
+        case ImageFormat::BGR:      return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::BGR  >;
+        case ImageFormat::RGBA:     return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::RGBA >;
+        case ImageFormat::BGRA:     return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::BGRA >;
+        case ImageFormat::ARGB:     return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::ARGB >;
+        case ImageFormat::ABGR:     return ConvertImageFormatTyped<T, SrcFormat, ImageFormat::ABGR >;
+        default:                    return nullptr;
+    }
+}
+
+template <typename T>
+FormatConversionKernel SelectFormatConversionKernel(ImageFormat srcFormat, ImageFormat dstFormat)
+{
+    switch (srcFormat)
+    {
+        case ImageFormat::Alpha:    return SelectFormatConversionKernel<T, ImageFormat::Alpha>(dstFormat);
+        case ImageFormat::R:        return SelectFormatConversionKernel<T, ImageFormat::R    >(dstFormat);
+        case ImageFormat::RG:       return SelectFormatConversionKernel<T, ImageFormat::RG   >(dstFormat);
+        case ImageFormat::RGB:      return SelectFormatConversionKernel<T, ImageFormat::RGB  >(dstFormat);
+        case ImageFormat::BGR:      return SelectFormatConversionKernel<T, ImageFormat::BGR  >(dstFormat);
+        case ImageFormat::RGBA:     return SelectFormatConversionKernel<T, ImageFormat::RGBA >(dstFormat);
+        case ImageFormat::BGRA:     return SelectFormatConversionKernel<T, ImageFormat::BGRA >(dstFormat);
+        case ImageFormat::ARGB:     return SelectFormatConversionKernel<T, ImageFormat::ARGB >(dstFormat);
+        case ImageFormat::ABGR:     return SelectFormatConversionKernel<T, ImageFormat::ABGR >(dstFormat);
+        default:                    return nullptr;
+    }
+}
+
+
+/* ----- Kernel tables ----- */
+
+struct DataTypeConversionKernelEntry
+{
+    DataType                    srcDataType;
+    DataType                    dstDataType;
+    DataTypeConversionKernel    kernel;
+};
+
+#ifdef LLGL_SIMD_X86
+
+static const DataTypeConversionKernelEntry g_kernelsSSE2[] =
+{
+    { DataType::UInt8,      DataType::Float32,  ConvertUInt8ToFloat32SSE2  },
+    { DataType::Int8,       DataType::Float32,  ConvertInt8ToFloat32SSE2   },
+    { DataType::UInt16,     DataType::Float32,  ConvertUInt16ToFloat32SSE2 },
+    { DataType::Float32,    DataType::UInt8,    ConvertFloat32ToUInt8SSE2  },
+    { DataType::Float32,    DataType::Int8,     ConvertFloat32ToInt8SSE2   },
+    { DataType::Float32,    DataType::UInt16,   ConvertFloat32ToUInt16SSE2 },
+};
+
+static const DataTypeConversionKernelEntry g_kernelsAVX2[] =
+{
+    { DataType::UInt8,      DataType::Float32,  ConvertUInt8ToFloat32AVX2  },
+    { DataType::Int8,       DataType::Float32,  ConvertInt8ToFloat32AVX2   },
+    { DataType::UInt16,     DataType::Float32,  ConvertUInt16ToFloat32AVX2 },
+    { DataType::Float32,    DataType::UInt8,    ConvertFloat32ToUInt8AVX2  },
+    { DataType::Float32,    DataType::Int8,     ConvertFloat32ToInt8AVX2   },
+    { DataType::Float32,    DataType::UInt16,   ConvertFloat32ToUInt16AVX2 },
+};
+
+#endif // /LLGL_SIMD_X86
+
+#ifdef LLGL_SIMD_NEON
+
+static const DataTypeConversionKernelEntry g_kernelsNEON[] =
+{
+    { DataType::UInt8,      DataType::Float32,  ConvertUInt8ToFloat32NEON   },
+    { DataType::Int8,       DataType::Float32,  ConvertInt8ToFloat32NEON    },
+    { DataType::UInt16,     DataType::Float32,  ConvertUInt16ToFloat32NEON  },
+    { DataType::Float32,    DataType::UInt8,    ConvertFloat32ToUInt8NEON   },
+    { DataType::Float32,    DataType::Int8,     ConvertFloat32ToInt8NEON    },
+    { DataType::Float32,    DataType::UInt16,   ConvertFloat32ToUInt16NEON  },
+};
+
+#endif // /LLGL_SIMD_NEON
+
+static const DataTypeConversionKernelEntry g_kernelsFloat16[] =
+{
+    { DataType::Float16,    DataType::Float32,  ConvertFloat16ToFloat32Bulk },
+    { DataType::Float32,    DataType::Float16,  ConvertFloat32ToFloat16Bulk },
+};
+
+template <std::size_t N>
+DataTypeConversionKernel FindKernelInTable(const DataTypeConversionKernelEntry (&table)[N], DataType srcDataType, DataType dstDataType)
+{
+    for (const auto& entry : table)
+    {
+        if (entry.srcDataType == srcDataType && entry.dstDataType == dstDataType)
+            return entry.kernel;
+    }
+    return nullptr;
+}
+
+
+/* ----- Functions ----- */
+
+DataTypeConversionKernel FindDataTypeConversionKernel(DataType srcDataType, DataType dstDataType)
+{
+    DataTypeConversionKernel kernel = FindKernelInTable(g_kernelsFloat16, srcDataType, dstDataType);
+    if (kernel)
+        return kernel;
+
+    const auto& cpu = GetCPUFeatures();
+
+    #if defined LLGL_SIMD_X86
+
+    if (cpu.avx2)
+        kernel = FindKernelInTable(g_kernelsAVX2, srcDataType, dstDataType);
+    if (!kernel && cpu.sse2)
+        kernel = FindKernelInTable(g_kernelsSSE2, srcDataType, dstDataType);
+
+    #elif defined LLGL_SIMD_NEON
+
+    if (cpu.neon)
+        kernel = FindKernelInTable(g_kernelsNEON, srcDataType, dstDataType);
+
+    #else
+
+    (void)cpu;
+
+    #endif
+
+    return kernel;
+}
+
+FormatConversionKernel FindFormatConversionKernel(DataType dataType, ImageFormat srcFormat, ImageFormat dstFormat)
+{
+    /* Only the size of the data type matters to copy the components */
+    switch (DataTypeSize(dataType))
+    {
+        case 1: return SelectFormatConversionKernel<std::uint8_t >(srcFormat, dstFormat);
+        case 2: return SelectFormatConversionKernel<std::uint16_t>(srcFormat, dstFormat);
+        case 4: return SelectFormatConversionKernel<std::uint32_t>(srcFormat, dstFormat);
+        case 8: return SelectFormatConversionKernel<std::uint64_t>(srcFormat, dstFormat);
+        default: return nullptr;
+    }
+}
+
+void ConvertDataTypeGeneric(DataType srcDataType, const void* src, DataType dstDataType, void* dst, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        /* Read normalized value from source buffer */
+        double value = ReadNormalizedDataType(srcDataType, src, i);
+
+        /* Write normalized value to destination buffer */
+        WriteNormalizedDataType(dstDataType, dst, i, value);
+    }
+}
+
+void WriteNormalizedDataType(DataType dstDataType, void* dst, std::size_t idx, double value)
+{
+    switch (dstDataType)
+    {
+        case DataType::Undefined:
+            break;
+        case DataType::Int8:
+            WriteNormalizedElement<std::int8_t>(dst, idx, value);
+            break;
+        case DataType::UInt8:
+            WriteNormalizedElement<std::uint8_t>(dst, idx, value);
+            break;
+        case DataType::Int16:
+            WriteNormalizedElement<std::int16_t>(dst, idx, value);
+            break;
+        case DataType::UInt16:
+            WriteNormalizedElement<std::uint16_t>(dst, idx, value);
+            break;
+        case DataType::Int32:
+            WriteNormalizedElement<std::int32_t>(dst, idx, value);
+            break;
+        case DataType::UInt32:
+            WriteNormalizedElement<std::uint32_t>(dst, idx, value);
+            break;
+        case DataType::Float16:
+            static_cast<std::uint16_t*>(dst)[idx] = CompressFloat16(static_cast<float>(value));
+            break;
+        case DataType::Float32:
+            static_cast<float*>(dst)[idx] = static_cast<float>(value);
+            break;
+        case DataType::Float64:
+            static_cast<double*>(dst)[idx] = value;
+            break;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
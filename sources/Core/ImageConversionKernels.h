@@ -0,0 +1,61 @@
+/*
+ * ImageConversionKernels.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_CONVERSION_KERNELS_H
+#define LLGL_IMAGE_CONVERSION_KERNELS_H
+
+
+#include <LLGL/Format.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Function signature for the conversion of 'count' elements from the source to the destination buffer.
+using DataTypeConversionKernel = void (*)(const void* src, void* dst, std::size_t count);
+
+/*
+Returns the SIMD kernel for the specified data type conversion that is best supported by the host CPU,
+or null if there is no specialized kernel for this pair of data types.
+The kernels produce the same results as the generic conversion in "ConvertImageBuffer",
+except that floating-point values outside the range [0, 1] are clamped before they are converted into integers.
+*/
+DataTypeConversionKernel FindDataTypeConversionKernel(DataType srcDataType, DataType dstDataType);
+
+/*
+Function signature for the conversion of 'count' pixels from the source to the destination image format, both with the same data type.
+Destination components that are missing in the source format are filled with the value of 'colorDefault' for color components
+and 'alphaDefault' for the alpha component. Both point to a single value of that data type.
+*/
+using FormatConversionKernel = void (*)(const void* src, void* dst, std::size_t count, const void* colorDefault, const void* alphaDefault);
+
+/*
+Returns the kernel for the specified image format conversion. Each pair of color formats has its own kernel that is instantiated from a template,
+or null if either format is not a color format (e.g. depth-stencil or compressed formats).
+*/
+FormatConversionKernel FindFormatConversionKernel(DataType dataType, ImageFormat srcFormat, ImageFormat dstFormat);
+
+/*
+Converts 'count' elements from the source to the destination buffer through the normalized range [0, 1] in double precision.
+This is the generic fallback for all pairs of data types that have no kernel (see "FindDataTypeConversionKernel").
+*/
+void ConvertDataTypeGeneric(DataType srcDataType, const void* src, DataType dstDataType, void* dst, std::size_t count);
+
+// Writes the specified value from the normalized range [0, 1] into the element at index 'idx' of the destination buffer.
+void WriteNormalizedDataType(DataType dstDataType, void* dst, std::size_t idx, double value);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
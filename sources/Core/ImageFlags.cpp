@@ -16,6 +16,9 @@
 #include "../Core/Helper.h"
 #include "../Core/Assertion.h"
 #include "Float16Compressor.h"
+#include "ImageConversionKernels.h"
+#include "BlockCompression.h"
+#include "WorkerPool.h"
 
 
 namespace LLGL
@@ -86,104 +89,28 @@ using VariantColor = ColorRGBAT<Variant>;
 
 /* ----- Internal functions ----- */
 
-// Reads the specified source variant and returns it to the normalized range [0, 1].
-template <typename T>
-double ReadNormalizedVariant(const T& src)
-{
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    return (static_cast<double>(src) - min) / (max - min);
-}
-
-// Writes the specified value from the range [0, 1] to the destination variant.
-template <typename T>
-void WriteNormalizedVariant(T& dst, double value)
-{
-    auto min = static_cast<double>(std::numeric_limits<T>::min());
-    auto max = static_cast<double>(std::numeric_limits<T>::max());
-    dst = static_cast<T>(value * (max - min) + min);
-}
-
-static double ReadNormalizedTypedVariant(DataType srcDataType, const VariantConstBuffer& srcBuffer, std::size_t idx)
-{
-    switch (srcDataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            return ReadNormalizedVariant(srcBuffer.int8[idx]);
-        case DataType::UInt8:
-            return ReadNormalizedVariant(srcBuffer.uint8[idx]);
-        case DataType::Int16:
-            return ReadNormalizedVariant(srcBuffer.int16[idx]);
-        case DataType::UInt16:
-            return ReadNormalizedVariant(srcBuffer.uint16[idx]);
-        case DataType::Int32:
-            return ReadNormalizedVariant(srcBuffer.int32[idx]);
-        case DataType::UInt32:
-            return ReadNormalizedVariant(srcBuffer.uint32[idx]);
-        case DataType::Float16:
-            return static_cast<double>(DecompressFloat16(srcBuffer.uint16[idx]));
-        case DataType::Float32:
-            return static_cast<double>(srcBuffer.real32[idx]);
-        case DataType::Float64:
-            return srcBuffer.real64[idx];
-    }
-    return 0.0;
-}
-
-static void WriteNormalizedTypedVariant(DataType dstDataType, VariantBuffer& dstBuffer, std::size_t idx, double value)
-{
-    switch (dstDataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            WriteNormalizedVariant(dstBuffer.int8[idx], value);
-            break;
-        case DataType::UInt8:
-            WriteNormalizedVariant(dstBuffer.uint8[idx], value);
-            break;
-        case DataType::Int16:
-            WriteNormalizedVariant(dstBuffer.int16[idx], value);
-            break;
-        case DataType::UInt16:
-            WriteNormalizedVariant(dstBuffer.uint16[idx], value);
-            break;
-        case DataType::Int32:
-            WriteNormalizedVariant(dstBuffer.int32[idx], value);
-            break;
-        case DataType::UInt32:
-            WriteNormalizedVariant(dstBuffer.uint32[idx], value);
-            break;
-        case DataType::Float16:
-            dstBuffer.uint16[idx] = CompressFloat16(static_cast<float>(value));
-            break;
-        case DataType::Float32:
-            dstBuffer.real32[idx] = static_cast<float>(value);
-            break;
-        case DataType::Float64:
-            dstBuffer.real64[idx] = value;
-            break;
-    }
-}
-
-// Worker thread procedure for the "ConvertImageBufferDataType" function
+// Worker procedure for the "ConvertImageBufferDataType" function
 static void ConvertImageBufferDataTypeWorker(
     DataType                    srcDataType,
     const VariantConstBuffer&   srcBuffer,
     DataType                    dstDataType,
     VariantBuffer&              dstBuffer,
+    DataTypeConversionKernel    kernel,
     std::size_t                 idxBegin,
     std::size_t                 idxEnd)
 {
-    for (auto i = idxBegin; i < idxEnd; ++i)
-    {
-        /* Read normalized variant from source buffer */
-        double value = ReadNormalizedTypedVariant(srcDataType, srcBuffer, i);
+    auto src = reinterpret_cast<const char*>(srcBuffer.raw) + idxBegin * DataTypeSize(srcDataType);
+    auto dst = reinterpret_cast<char*>(dstBuffer.raw) + idxBegin * DataTypeSize(dstDataType);
 
-        /* Write normalized variant to destination buffer */
-        WriteNormalizedTypedVariant(dstDataType, dstBuffer, i, value);
+    if (kernel != nullptr)
+    {
+        /* Convert range with SIMD kernel */
+        kernel(src, dst, idxEnd - idxBegin);
+    }
+    else
+    {
+        /* Convert range with generic fallback */
+        ConvertDataTypeGeneric(srcDataType, src, dstDataType, dst, idxEnd - idxBegin);
     }
 }
 
@@ -210,45 +137,19 @@ static void ConvertImageBufferDataType(
     VariantConstBuffer src { srcBuffer };
     VariantBuffer dst { dstBuffer };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
+    /* Find SIMD kernel for this data type conversion (null if there is none) */
+    auto kernel = FindDataTypeConversionKernel(srcDataType, dstDataType);
 
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
+    /* Convert image data type in chunks on the worker pool */
+    WorkerPool::Get().ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
         {
-            workers[i] = std::thread(
-                ConvertImageBufferDataTypeWorker,
-                srcDataType,
-                std::ref(src),
-                dstDataType,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
+            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, kernel, idxBegin, idxEnd);
         }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, 0, imageSize);
-    }
+    );
 }
 
 static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
@@ -287,258 +188,120 @@ static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
     }
 }
 
-static void CopyTypedVariant(DataType dataType, const VariantConstBuffer& srcBuffer, std::size_t idx, Variant& dst)
-{
-    switch (dataType)
-    {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            dst.int8 = srcBuffer.int8[idx];
-            break;
-        case DataType::UInt8:
-            dst.uint8 = srcBuffer.uint8[idx];
-            break;
-        case DataType::Int16:
-            dst.int16 = srcBuffer.int16[idx];
-            break;
-        case DataType::UInt16:
-            dst.uint16 = srcBuffer.uint16[idx];
-            break;
-        case DataType::Int32:
-            dst.int32 = srcBuffer.int32[idx];
-            break;
-        case DataType::UInt32:
-            dst.uint32 = srcBuffer.uint32[idx];
-            break;
-        case DataType::Float16:
-            dst.uint16 = srcBuffer.uint16[idx];
-            break;
-        case DataType::Float32:
-            dst.real32 = srcBuffer.real32[idx];
-            break;
-        case DataType::Float64:
-            dst.real64 = srcBuffer.real64[idx];
-            break;
-    }
-}
+// Maximal size (in bytes) of the temporary buffer each worker thread uses to convert the data type and format in a single pass
+static const std::size_t g_fusedChunkSize = 16384;
 
-static void CopyTypedVariant(DataType dataType, VariantBuffer& dstBuffer, std::size_t idx, const Variant& src)
+// Worker procedure for the "ConvertImageBufferFormat" function
+static void ConvertImageBufferFormatWorker(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    FormatConversionKernel      formatKernel,
+    DataTypeConversionKernel    dataTypeKernel,
+    const Variant               (&defaults)[2],
+    std::size_t                 idxBegin,
+    std::size_t                 idxEnd)
 {
-    switch (dataType)
+    /* Get size for source and destination pixels */
+    const auto srcComponents    = ImageFormatSize(srcImageDesc.format);
+    const auto dstComponents    = ImageFormatSize(dstImageDesc.format);
+    const auto srcTypeSize      = DataTypeSize(srcImageDesc.dataType);
+    const auto dstTypeSize      = DataTypeSize(dstImageDesc.dataType);
+
+    auto src = reinterpret_cast<const char*>(srcImageDesc.data) + idxBegin * srcComponents * srcTypeSize;
+    auto dst = reinterpret_cast<char*>(dstImageDesc.data) + idxBegin * dstComponents * dstTypeSize;
+
+    if (srcImageDesc.dataType == dstImageDesc.dataType)
     {
-        case DataType::Undefined:
-            break;
-        case DataType::Int8:
-            dstBuffer.int8[idx] = src.int8;
-            break;
-        case DataType::UInt8:
-            dstBuffer.uint8[idx] = src.uint8;
-            break;
-        case DataType::Int16:
-            dstBuffer.int16[idx] = src.int16;
-            break;
-        case DataType::UInt16:
-            dstBuffer.uint16[idx] = src.uint16;
-            break;
-        case DataType::Int32:
-            dstBuffer.int32[idx] = src.int32;
-            break;
-        case DataType::UInt32:
-            dstBuffer.uint32[idx] = src.uint32;
-            break;
-        case DataType::Float16:
-            dstBuffer.uint16[idx] = src.uint16;
-            break;
-        case DataType::Float32:
-            dstBuffer.real32[idx] = src.real32;
-            break;
-        case DataType::Float64:
-            dstBuffer.real64[idx] = src.real64;
-            break;
+        /* Convert image format only */
+        formatKernel(src, dst, idxEnd - idxBegin, &defaults[0], &defaults[1]);
+        return;
     }
-}
 
-template <typename TBuf, typename TVar>
-void TransferRGBAFormattedVariantColor(ImageFormat format, DataType dataType, TBuf& buffer, std::size_t idx, TVar& value)
-{
-    switch (format)
+    /*
+    Convert data type and format in chunks that fit into the L1 cache. The data type is converted on the side with fewer components,
+    so the format conversion operates either on the source or the destination data type. Both orders produce the same result,
+    because the default values are the minimum and maximum of the normalized range.
+    */
+    const bool  formatFirst     = (dstComponents < srcComponents);
+    const auto  tempComponents  = (formatFirst ? dstComponents : srcComponents);
+    const auto  tempTypeSize    = (formatFirst ? srcTypeSize : dstTypeSize);
+    const auto  chunkSize       = g_fusedChunkSize / (tempComponents * tempTypeSize);
+
+    union
     {
-        case ImageFormat::Alpha:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            break;
-        case ImageFormat::R:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            break;
-        case ImageFormat::RG:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            break;
-        case ImageFormat::RGB:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.b);
-            break;
-        case ImageFormat::BGR:
-            CopyTypedVariant(dataType, buffer, idx    , value.b);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.r);
-            break;
-        case ImageFormat::RGBA:
-            CopyTypedVariant(dataType, buffer, idx    , value.r);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.b);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.a);
-            break;
-        case ImageFormat::BGRA:
-            CopyTypedVariant(dataType, buffer, idx    , value.b);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.r);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.a);
-            break;
-        case ImageFormat::ARGB:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.r);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.b);
-            break;
-        case ImageFormat::ABGR:
-            CopyTypedVariant(dataType, buffer, idx    , value.a);
-            CopyTypedVariant(dataType, buffer, idx + 1, value.b);
-            CopyTypedVariant(dataType, buffer, idx + 2, value.g);
-            CopyTypedVariant(dataType, buffer, idx + 3, value.r);
-            break;
-        default:
-            break;
+        double  alignment;
+        char    data[g_fusedChunkSize];
     }
-}
-
-static void ReadRGBAFormattedVariant(
-    ImageFormat srcFormat, DataType dataType, const VariantConstBuffer& srcBuffer, std::size_t idx, VariantColor& value)
-{
-    TransferRGBAFormattedVariantColor(srcFormat, dataType, srcBuffer, idx, value);
-}
+    temp;
 
-static void WriteRGBAFormattedVariant(
-    ImageFormat dstFormat, DataType dataType, VariantBuffer& dstBuffer, std::size_t idx, const VariantColor& value)
-{
-    TransferRGBAFormattedVariantColor(dstFormat, dataType, dstBuffer, idx, value);
-}
-
-// Worker thread procedure for the "ConvertImageBufferFormat" function
-static void ConvertImageBufferFormatWorker(
-    ImageFormat                 srcFormat,
-    DataType                    srcDataType,
-    const VariantConstBuffer&   srcBuffer,
-    ImageFormat                 dstFormat,
-    VariantBuffer&              dstBuffer,
-    std::size_t                 idxBegin,
-    std::size_t                 idxEnd)
-{
-    /* Get size for source and destination formats */
-    auto srcFormatSize  = ImageFormatSize(srcFormat);
-    auto dstFormatSize  = ImageFormatSize(dstFormat);
-
-    /* Initialize default variant color (0, 0, 0, 1) */
-    VariantColor value { UninitializeTag{} };
+    for (auto i = idxBegin; i < idxEnd; i += chunkSize)
+    {
+        const auto count = std::min(chunkSize, idxEnd - i);
 
-    SetVariantMinMax(srcDataType, value.r, true);
-    SetVariantMinMax(srcDataType, value.g, true);
-    SetVariantMinMax(srcDataType, value.b, true);
-    SetVariantMinMax(srcDataType, value.a, false);
+        VariantBuffer tempBuffer { temp.data };
+        VariantConstBuffer tempConstBuffer { temp.data };
 
-    for (auto i = idxBegin; i < idxEnd; ++i)
-    {
-        /* Read RGBA variant from source buffer */
-        ReadRGBAFormattedVariant(srcFormat, srcDataType, srcBuffer, i*srcFormatSize, value);
+        if (formatFirst)
+        {
+            /* Convert format into temporary buffer, then convert data type into destination buffer */
+            VariantBuffer dstBuffer { dst };
+            formatKernel(src, temp.data, count, &defaults[0], &defaults[1]);
+            ConvertImageBufferDataTypeWorker(srcImageDesc.dataType, tempConstBuffer, dstImageDesc.dataType, dstBuffer, dataTypeKernel, 0, count * tempComponents);
+        }
+        else
+        {
+            /* Convert data type into temporary buffer, then convert format into destination buffer */
+            VariantConstBuffer srcBuffer { src };
+            ConvertImageBufferDataTypeWorker(srcImageDesc.dataType, srcBuffer, dstImageDesc.dataType, tempBuffer, dataTypeKernel, 0, count * tempComponents);
+            formatKernel(temp.data, dst, count, &defaults[0], &defaults[1]);
+        }
 
-        /* Write RGBA variant to destination buffer */
-        WriteRGBAFormattedVariant(dstFormat, srcDataType, dstBuffer, i*dstFormatSize, value);
+        src += count * srcComponents * srcTypeSize;
+        dst += count * dstComponents * dstTypeSize;
     }
 }
 
+/*
+Converts the image format, and the data type (if necessary) in the same pass.
+The format conversion kernel is selected for the pair of image formats and is instantiated from a template for each pair.
+*/
 static void ConvertImageBufferFormat(
     const SrcImageDescriptor&   srcImageDesc,
     const DstImageDescriptor&   dstImageDesc,
     std::size_t                 threadCount)
 {
-    /* Get image parameters */
-    auto dataTypeSize   = DataTypeSize(srcImageDesc.dataType);
-    auto srcFormatSize  = ImageFormatSize(srcImageDesc.format);
-    auto dstFormatSize  = ImageFormatSize(dstImageDesc.format);
-
     /* Validate destination buffer size */
-    auto imageSize              = srcImageDesc.dataSize / srcFormatSize;
-    auto requiredDstBufferSize  = imageSize * dstFormatSize;
+    const auto imageSize                = srcImageDesc.dataSize / GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, 1);
+    const auto requiredDstBufferSize    = imageSize * GetMemoryFootprint(dstImageDesc.format, dstImageDesc.dataType, 1);
 
     if (dstImageDesc.dataSize != requiredDstBufferSize)
         throw std::invalid_argument("cannot convert image format with destination buffer size mismatch");
 
-    /* Allocate destination buffer */
-    imageSize /= dataTypeSize;
+    /* Format conversion operates on the data type with fewer components */
+    const auto formatDataType = (ImageFormatSize(dstImageDesc.format) < ImageFormatSize(srcImageDesc.format) ? srcImageDesc.dataType : dstImageDesc.dataType);
 
-    /* Get variant buffer for source and destination images */
-    VariantConstBuffer src { srcImageDesc.data };
-    VariantBuffer dst { dstImageDesc.data };
+    auto formatKernel = FindFormatConversionKernel(formatDataType, srcImageDesc.format, dstImageDesc.format);
+    if (!formatKernel)
+        throw std::invalid_argument("cannot convert image format with non-color format");
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
+    /* Find SIMD kernel for the data type conversion (null if there is none) */
+    auto dataTypeKernel = FindDataTypeConversionKernel(srcImageDesc.dataType, dstImageDesc.dataType);
 
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
+    /* Initialize default values (0, 0, 0, 1) for missing components */
+    Variant defaults[2];
+    SetVariantMinMax(formatDataType, defaults[0], true);
+    SetVariantMinMax(formatDataType, defaults[1], false);
 
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
+    /* Convert image in chunks on the worker pool */
+    WorkerPool::Get().ParallelFor(
+        imageSize,
+        g_threadMinWorkSize,
+        threadCount,
+        [&](std::size_t idxBegin, std::size_t idxEnd)
         {
-            workers[i] = std::thread(
-                ConvertImageBufferFormatWorker,
-                srcImageDesc.format,
-                srcImageDesc.dataType,
-                std::ref(src),
-                dstImageDesc.format,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
-        }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-        {
-            ConvertImageBufferFormatWorker(
-                srcImageDesc.format,
-                srcImageDesc.dataType,
-                src,
-                dstImageDesc.format,
-                dst,
-                offset,
-                offset + workSizeRemain
-            );
+            ConvertImageBufferFormatWorker(srcImageDesc, dstImageDesc, formatKernel, dataTypeKernel, defaults, idxBegin, idxEnd);
         }
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferFormatWorker(
-            srcImageDesc.format,
-            srcImageDesc.dataType,
-            src,
-            dstImageDesc.format,
-            dst,
-            0,
-            imageSize
-        );
-    }
+    );
 }
 
 static void ValidateSourceImageDesc(const SrcImageDescriptor& imageDesc)
@@ -561,11 +324,32 @@ static void ValidateImageConversionParams(
     DataType                    dstDataType)
 {
     if (IsCompressedFormat(srcImageDesc.format) || IsCompressedFormat(dstFormat))
-        throw std::invalid_argument("cannot convert compressed image formats");
+        throw std::invalid_argument("cannot convert compressed image formats without image extent");
     if (IsDepthStencilFormat(srcImageDesc.format) || IsDepthStencilFormat(dstFormat))
         throw std::invalid_argument("cannot convert depth-stencil image formats");
 }
 
+static void ValidateCompressedImageConversionParams(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    const Extent3D&             extent)
+{
+    if (IsDepthStencilFormat(srcImageDesc.format) || IsDepthStencilFormat(dstFormat))
+        throw std::invalid_argument("cannot convert depth-stencil image formats");
+    if ((IsCompressedFormat(srcImageDesc.format) && srcImageDesc.dataType != DataType::UInt8) ||
+        (IsCompressedFormat(dstFormat) && dstDataType != DataType::UInt8))
+    {
+        throw std::invalid_argument("compressed image formats must have data type UInt8");
+    }
+
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+
+    const auto srcDataSize = GetImageBufferSize(srcImageDesc.format, srcImageDesc.dataType, extent);
+    if (srcImageDesc.dataSize < srcDataSize)
+        throw std::invalid_argument("source image data size is too small for the image extent");
+}
+
 
 /* ----- Public functions ----- */
 
@@ -575,41 +359,17 @@ LLGL_EXPORT bool ConvertImageBuffer(
     std::size_t                 threadCount)
 {
     /* Validate input parameters */
+    ValidateImageConversionParams(srcImageDesc, dstImageDesc.format, dstImageDesc.dataType);
     ValidateSourceImageDesc(srcImageDesc);
     ValidateDestinationImageDesc(dstImageDesc);
-    ValidateImageConversionParams(srcImageDesc, dstImageDesc.format, dstImageDesc.dataType);
 
     if (threadCount >= Constants::maxThreadCount)
         threadCount = std::thread::hardware_concurrency();
 
-    if (srcImageDesc.dataType != dstImageDesc.dataType && srcImageDesc.format != dstImageDesc.format)
+    if (srcImageDesc.format != dstImageDesc.format)
     {
-        /* Convert image data type with intermediate buffer */
-        auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstImageDesc.dataType);
-        auto intermediateBuffer     = MakeUniqueArray<char>(intermediateBufferSize);
-
-        ConvertImageBufferDataType(
-            srcImageDesc.dataType,
-            srcImageDesc.data,
-            srcImageDesc.dataSize,
-            dstImageDesc.dataType,
-            intermediateBuffer.get(),
-            intermediateBufferSize,
-            threadCount
-        );
-
-        /* Set new source buffer and source data type */
-        const SrcImageDescriptor intermediateImageDesc
-        {
-            srcImageDesc.format,
-            dstImageDesc.dataType,
-            intermediateBuffer.get(),
-            intermediateBufferSize
-        };
-
-        /* Convert image format */
-        ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
-
+        /* Convert image format and data type in a single pass */
+        ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
         return true;
     }
     else if (srcImageDesc.dataType != dstImageDesc.dataType)
@@ -626,12 +386,6 @@ LLGL_EXPORT bool ConvertImageBuffer(
         );
         return true;
     }
-    else if (srcImageDesc.format != dstImageDesc.format)
-    {
-        /* Convert image format */
-        ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
-        return true;
-    }
 
     return false;
 }
@@ -643,8 +397,8 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     std::size_t                 threadCount)
 {
     /* Validate input parameters */
-    ValidateSourceImageDesc(srcImageDesc);
     ValidateImageConversionParams(srcImageDesc, dstFormat, dstDataType);
+    ValidateSourceImageDesc(srcImageDesc);
 
     if (threadCount >= Constants::maxThreadCount)
         threadCount = std::thread::hardware_concurrency();
@@ -660,36 +414,13 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
         srcNumPixels * DataTypeSize(dstDataType) * ImageFormatSize(dstFormat)
     };
 
-    if (srcImageDesc.dataType != dstDataType && srcImageDesc.format != dstFormat)
+    if (srcImageDesc.format != dstFormat)
     {
+        /* Convert image format and data type in a single pass */
         auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
         {
-            /* Convert image data type with intermediate buffer */
-            auto intermediateBufferSize = srcImageDesc.dataSize / DataTypeSize(srcImageDesc.dataType) * DataTypeSize(dstDataType);
-            auto intermediateBuffer     = MakeUniqueArray<char>(intermediateBufferSize);
-
-            ConvertImageBufferDataType(
-                srcImageDesc.dataType,
-                srcImageDesc.data,
-                srcImageDesc.dataSize,
-                dstDataType,
-                intermediateBuffer.get(),
-                intermediateBufferSize,
-                threadCount
-            );
-
-            /* Set new source buffer and source data type */
-            const SrcImageDescriptor intermediateImageDesc
-            {
-                srcImageDesc.format,
-                dstDataType,
-                intermediateBuffer.get(),
-                intermediateBufferSize
-            };
-
-            /* Convert image format */
             dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
+            ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
         }
         return dstImage;
     }
@@ -711,18 +442,88 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
         }
         return dstImage;
     }
-    else if (srcImageDesc.format != dstFormat)
+
+    return nullptr;
+}
+
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    std::size_t                 threadCount)
+{
+    if (!IsCompressedFormat(srcImageDesc.format) && !IsCompressedFormat(dstImageDesc.format))
+        return ConvertImageBuffer(srcImageDesc, dstImageDesc, threadCount);
+
+    /* Validate input parameters */
+    ValidateCompressedImageConversionParams(srcImageDesc, dstImageDesc.format, dstImageDesc.dataType, extent);
+
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+    if (dstImageDesc.dataSize != GetImageBufferSize(dstImageDesc.format, dstImageDesc.dataType, extent))
+        throw std::invalid_argument("destination image data size does not match the required size for the image extent");
+
+    if (srcImageDesc.format == dstImageDesc.format)
+        return false;
+
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+
+    /* Decompress or convert source image into intermediate RGBA8 image (if necessary) */
+    const auto      rgbaDataSize    = GetImageBufferSize(ImageFormat::RGBA, DataType::UInt8, extent);
+    ByteBuffer      rgbaBuffer;
+    const void*     rgbaData        = srcImageDesc.data;
+
+    if (IsCompressedFormat(srcImageDesc.format))
     {
-        /* Convert image format */
-        auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
+        if (dstImageDesc.format == ImageFormat::RGBA && dstImageDesc.dataType == DataType::UInt8)
         {
-            dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
+            /* Decompress directly into destination image */
+            DecompressImageBlocks(srcImageDesc.format, srcImageDesc.data, reinterpret_cast<std::uint8_t*>(dstImageDesc.data), extent, threadCount);
+            return true;
         }
-        return dstImage;
+        rgbaBuffer = GenerateEmptyByteBuffer(rgbaDataSize, false);
+        DecompressImageBlocks(srcImageDesc.format, srcImageDesc.data, reinterpret_cast<std::uint8_t*>(rgbaBuffer.get()), extent, threadCount);
+        rgbaData = rgbaBuffer.get();
+    }
+    else if (srcImageDesc.format != ImageFormat::RGBA || srcImageDesc.dataType != DataType::UInt8)
+    {
+        const SrcImageDescriptor srcRegionDesc { srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, GetImageBufferSize(srcImageDesc.format, srcImageDesc.dataType, extent) };
+        rgbaBuffer  = ConvertImageBuffer(srcRegionDesc, ImageFormat::RGBA, DataType::UInt8, threadCount);
+        rgbaData    = rgbaBuffer.get();
     }
 
-    return nullptr;
+    /* Compress or convert intermediate RGBA8 image into destination image */
+    if (IsCompressedFormat(dstImageDesc.format))
+        CompressImageBlocks(dstImageDesc.format, dstImageDesc.data, reinterpret_cast<const std::uint8_t*>(rgbaData), extent, threadCount);
+    else
+        ConvertImageBuffer(SrcImageDescriptor{ ImageFormat::RGBA, DataType::UInt8, rgbaData, rgbaDataSize }, dstImageDesc, threadCount);
+
+    return true;
+}
+
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    const Extent3D&             extent,
+    std::size_t                 threadCount)
+{
+    if (!IsCompressedFormat(srcImageDesc.format) && !IsCompressedFormat(dstFormat))
+        return ConvertImageBuffer(srcImageDesc, dstFormat, dstDataType, threadCount);
+
+    /* Validate input parameters */
+    ValidateCompressedImageConversionParams(srcImageDesc, dstFormat, dstDataType, extent);
+
+    if (srcImageDesc.format == dstFormat)
+        return nullptr;
+
+    /* Convert into new allocated destination image */
+    const auto dstDataSize = GetImageBufferSize(dstFormat, dstDataType, extent);
+    auto dstImage = GenerateEmptyByteBuffer(dstDataSize, false);
+
+    ConvertImageBuffer(srcImageDesc, DstImageDescriptor{ dstFormat, dstDataType, dstImage.get(), dstDataSize }, extent, threadCount);
+
+    return dstImage;
 }
 
 // Returns the 1D flattened buffer position for a 3D image coordinate ('bpp' denotes the bytes per pixel)
@@ -764,7 +565,8 @@ LLGL_EXPORT void CopyImageBufferRegion(
     const Offset3D&             srcOffset,
     std::uint32_t               srcRowStride,
     std::uint32_t               srcSliceStride,
-    const Extent3D&             extent)
+    const Extent3D&             extent,
+    std::size_t                 threadCount)
 {
     /* Validate input parameters */
     ValidateSourceImageDesc(srcImageDesc);
@@ -798,7 +600,8 @@ LLGL_EXPORT void CopyImageBufferRegion(
         dstSliceStride * bpp,
         (reinterpret_cast<const char*>(srcImageDesc.data) + srcPos),
         srcRowStride * bpp,
-        srcSliceStride * bpp
+        srcSliceStride * bpp,
+        threadCount
     );
 }
 
@@ -812,18 +615,17 @@ LLGL_EXPORT ByteBuffer GenerateImageBuffer(
     VariantColor fillColor0 { UninitializeTag{} };
     VariantBuffer fillBuffer0 { &fillColor0 };
 
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 0, fillColor.r);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 1, fillColor.g);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 2, fillColor.b);
-    WriteNormalizedTypedVariant(dataType, fillBuffer0, 3, fillColor.a);
+    WriteNormalizedDataType(dataType, fillBuffer0.raw, 0, fillColor.r);
+    WriteNormalizedDataType(dataType, fillBuffer0.raw, 1, fillColor.g);
+    WriteNormalizedDataType(dataType, fillBuffer0.raw, 2, fillColor.b);
+    WriteNormalizedDataType(dataType, fillBuffer0.raw, 3, fillColor.a);
 
     /* Convert fill color format */
     VariantColor fillColor1 { UninitializeTag{} };
     VariantBuffer fillBuffer1 { &fillColor1 };
-    VariantConstBuffer fillBuffer2 { fillBuffer0.raw };
 
-    ReadRGBAFormattedVariant(ImageFormat::RGBA, dataType, fillBuffer2, 0, fillColor1);
-    WriteRGBAFormattedVariant(format, dataType, fillBuffer1, 0, fillColor1);
+    if (auto formatKernel = FindFormatConversionKernel(dataType, ImageFormat::RGBA, format))
+        formatKernel(fillBuffer0.raw, fillBuffer1.raw, 1, &fillColor0.r, &fillColor0.a);
 
     /* Allocate image buffer */
     const auto bytesPerPixel = DataTypeSize(dataType) * ImageFormatSize(format);
@@ -836,6 +638,14 @@ LLGL_EXPORT ByteBuffer GenerateImageBuffer(
     return imageBuffer;
 }
 
+LLGL_EXPORT std::size_t GetImageBufferSize(ImageFormat format, DataType dataType, const Extent3D& extent)
+{
+    if (IsCompressedFormat(format))
+        return GetCompressedImageDataSize(format, extent);
+    else
+        return (static_cast<std::size_t>(GetMemoryFootprint(format, dataType, 1)) * extent.width * extent.height * extent.depth);
+}
+
 LLGL_EXPORT ByteBuffer GenerateEmptyByteBuffer(std::size_t bufferSize, bool initialize)
 {
     auto buffer = MakeUniqueArray<char>(bufferSize);
@@ -0,0 +1,1019 @@
+/*
+ * ImageResampler.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageResampler.h"
+#include "ImageConversionKernels.h"
+#include "Float16Compressor.h"
+#include "WorkerPool.h"
+#include "../Core/Helper.h"
+#include "../Core/Assertion.h"
+#include <LLGL/Platform/Platform.h>
+#include <algorithm>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#if defined LLGL_ARCH_AMD64
+#   define LLGL_SIMD_SSE2
+#   include <emmintrin.h>
+#elif defined LLGL_ARCH_ARM64
+#   define LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+// Minimal number of floats (or bytes for nearest sampling) each worker shall process.
+static const std::size_t g_resampleMinWorkSize = 4096;
+
+// Radius (in pixels) of the Lanczos filter.
+static const double g_lanczosRadius = 3.0;
+
+// Radius (in pixels) and shape parameter of the Kaiser window.
+static const double g_kaiserRadius  = 3.0;
+static const double g_kaiserAlpha   = 4.0;
+
+static const double g_pi = 3.14159265358979323846;
+
+
+/* ----- Filter taps ----- */
+
+// Filter taps for all destination pixels along a single axis.
+struct ResampleTaps
+{
+    std::vector<std::uint32_t>  offsets;    // Index of the first tap for each destination pixel, plus the end of the last one.
+    std::vector<std::uint32_t>  indices;    // Source pixel index of each tap (already clamped to the edge).
+    std::vector<float>          weights;    // Normalized weight of each tap.
+};
+
+static double Sinc(double x)
+{
+    if (x == 0.0)
+        return 1.0;
+    x *= g_pi;
+    return std::sin(x) / x;
+}
+
+// Returns the modified Bessel function of the first kind of order zero.
+static double BesselI0(double x)
+{
+    double sum = 1.0, term = 1.0;
+    const auto halfSq = x * x * 0.25;
+    for (int k = 1; k < 32 && term > sum * 1e-12; ++k)
+    {
+        term *= halfSq / static_cast<double>(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+static double KaiserWindow(double x)
+{
+    const auto r = x / g_kaiserRadius;
+    return BesselI0(g_kaiserAlpha * std::sqrt(1.0 - r * r)) / BesselI0(g_kaiserAlpha);
+}
+
+static double GetFilterRadius(ImageFilter filter)
+{
+    switch (filter)
+    {
+        case ImageFilter::Nearest:  return 0.0;
+        case ImageFilter::Box:      return 0.5;
+        case ImageFilter::Linear:   return 1.0;
+        case ImageFilter::Lanczos:  return g_lanczosRadius;
+        case ImageFilter::Kaiser:   return g_kaiserRadius;
+    }
+    return 0.0;
+}
+
+// Returns the weight of the source pixel [x, x+1) for the destination pixel at 'center' with the specified footprint radius.
+static double GetFilterWeight(ImageFilter filter, double x, double center, double radius, double filterScale)
+{
+    switch (filter)
+    {
+        case ImageFilter::Box:
+        {
+            /* Coverage of the source pixel by the footprint of the destination pixel */
+            return std::max(0.0, std::min(x + 1.0, center + radius) - std::max(x, center - radius));
+        }
+        case ImageFilter::Linear:
+        {
+            const auto t = std::abs(x + 0.5 - center) / filterScale;
+            return (t < 1.0 ? 1.0 - t : 0.0);
+        }
+        case ImageFilter::Lanczos:
+        {
+            const auto t = std::abs(x + 0.5 - center) / filterScale;
+            return (t < g_lanczosRadius ? Sinc(t) * Sinc(t / g_lanczosRadius) : 0.0);
+        }
+        case ImageFilter::Kaiser:
+        {
+            const auto t = std::abs(x + 0.5 - center) / filterScale;
+            return (t < g_kaiserRadius ? Sinc(t) * KaiserWindow(t) : 0.0);
+        }
+        default:
+        {
+            return 0.0;
+        }
+    }
+}
+
+static void BuildResampleTaps(ResampleTaps& taps, std::uint32_t srcSize, std::uint32_t dstSize, ImageFilter filter)
+{
+    /* Widen the filter footprint when downsampling, so every source pixel contributes */
+    const auto scale        = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+    const auto filterScale  = std::max(scale, 1.0);
+    const auto radius       = GetFilterRadius(filter) * filterScale;
+    const auto maxIndex     = static_cast<std::int64_t>(srcSize) - 1;
+
+    taps.offsets.reserve(dstSize + 1);
+
+    std::vector<double> weights;
+
+    for (std::uint32_t i = 0; i < dstSize; ++i)
+    {
+        const auto tapsBegin = taps.indices.size();
+        taps.offsets.push_back(static_cast<std::uint32_t>(tapsBegin));
+
+        /* Center of the destination pixel in source pixel coordinates */
+        const auto center       = (static_cast<double>(i) + 0.5) * scale;
+        const auto nearestIndex = std::min(static_cast<std::int64_t>(center), maxIndex);
+
+        if (filter != ImageFilter::Nearest)
+        {
+            const auto first    = static_cast<std::int64_t>(std::floor(center - radius));
+            const auto last     = static_cast<std::int64_t>(std::ceil(center + radius));
+
+            weights.clear();
+            double weightSum = 0.0;
+
+            for (auto x = first; x < last; ++x)
+            {
+                const auto weight = GetFilterWeight(filter, static_cast<double>(x), center, radius, filterScale);
+                if (weight == 0.0)
+                    continue;
+
+                /* Clamp to edge and merge taps that have been clamped to the same source pixel */
+                const auto index = static_cast<std::uint32_t>(std::max(std::int64_t(0), std::min(x, maxIndex)));
+                if (taps.indices.size() > tapsBegin && taps.indices.back() == index)
+                    weights.back() += weight;
+                else
+                {
+                    taps.indices.push_back(index);
+                    weights.push_back(weight);
+                }
+
+                weightSum += weight;
+            }
+
+            if (weightSum != 0.0)
+            {
+                /* Normalize weights */
+                for (auto w : weights)
+                    taps.weights.push_back(static_cast<float>(w / weightSum));
+                continue;
+            }
+
+            /* Fall back to nearest sampling if no tap has a weight */
+            taps.indices.resize(tapsBegin);
+        }
+
+        taps.indices.push_back(static_cast<std::uint32_t>(nearestIndex));
+        taps.weights.push_back(1.0f);
+    }
+
+    taps.offsets.push_back(static_cast<std::uint32_t>(taps.indices.size()));
+}
+
+
+/* ----- Row kernels ----- */
+
+// Sets the row 'dst' to the row 'src' scaled by 'weight'.
+static void ScaleRow(float* dst, const float* src, float weight, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_SSE2
+    const auto w = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), w));
+    #elif defined LLGL_SIMD_NEON
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vmulq_n_f32(vld1q_f32(src + i), weight));
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] = src[i] * weight;
+}
+
+// Adds the row 'src' scaled by 'weight' to the row 'dst'.
+static void AccumulateRow(float* dst, const float* src, float weight, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_SSE2
+    const auto w = _mm_set1_ps(weight);
+    for (; i + 8 <= count; i += 8)
+    {
+        _mm_storeu_ps(dst + i,     _mm_add_ps(_mm_loadu_ps(dst + i    ), _mm_mul_ps(_mm_loadu_ps(src + i    ), w)));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_loadu_ps(dst + i + 4), _mm_mul_ps(_mm_loadu_ps(src + i + 4), w)));
+    }
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), w)));
+    #elif defined LLGL_SIMD_NEON
+    const auto w = vdupq_n_f32(weight);
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), w));
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] += src[i] * weight;
+}
+
+// Sets the pixel 'dst' of up to four components to the weighted sum of the source pixels.
+static void FilterPixel(float* dst, const float* src, const std::uint32_t* indices, const float* weights, std::size_t numTaps, std::size_t numComponents)
+{
+    #if defined LLGL_SIMD_SSE2
+    if (numComponents == 4)
+    {
+        auto sum = _mm_mul_ps(_mm_loadu_ps(src + indices[0] * 4), _mm_set1_ps(weights[0]));
+        for (std::size_t i = 1; i < numTaps; ++i)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(src + indices[i] * 4), _mm_set1_ps(weights[i])));
+        _mm_storeu_ps(dst, sum);
+        return;
+    }
+    #elif defined LLGL_SIMD_NEON
+    if (numComponents == 4)
+    {
+        auto sum = vmulq_n_f32(vld1q_f32(src + indices[0] * 4), weights[0]);
+        for (std::size_t i = 1; i < numTaps; ++i)
+            sum = vmlaq_n_f32(sum, vld1q_f32(src + indices[i] * 4), weights[i]);
+        vst1q_f32(dst, sum);
+        return;
+    }
+    #endif
+
+    float sum[4];
+    for (std::size_t c = 0; c < numComponents; ++c)
+        sum[c] = src[indices[0] * numComponents + c] * weights[0];
+
+    for (std::size_t i = 1; i < numTaps; ++i)
+    {
+        for (std::size_t c = 0; c < numComponents; ++c)
+            sum[c] += src[indices[i] * numComponents + c] * weights[i];
+    }
+
+    for (std::size_t c = 0; c < numComponents; ++c)
+        dst[c] = sum[c];
+}
+
+
+/* ----- Load and store ----- */
+
+static float SRGBToLinear(float value)
+{
+    return (value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f));
+}
+
+static float LinearToSRGB(float value)
+{
+    value = std::max(0.0f, std::min(value, 1.0f));
+    return (value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f);
+}
+
+// Returns the lookup table to convert 8-bit sRGB values into linear space.
+static const float* GetSRGBToLinearTable8()
+{
+    static const std::vector<float> table = []()
+    {
+        std::vector<float> values(256);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = SRGBToLinear(static_cast<float>(i) / 255.0f);
+        return values;
+    }();
+    return table.data();
+}
+
+// Returns the lookup table to convert 8-bit values into the normalized range [0, 1].
+static const float* GetNormalizedTable8()
+{
+    static const std::vector<float> table = []()
+    {
+        std::vector<float> values(256);
+        for (std::size_t i = 0; i < values.size(); ++i)
+            values[i] = static_cast<float>(i) / 255.0f;
+        return values;
+    }();
+    return table.data();
+}
+
+// Number of buckets to look up the first candidate when a linear value is converted into 8-bit sRGB.
+static const std::size_t g_sRGBBuckets8 = 4096;
+
+// Tables to convert linear values into 8-bit sRGB values.
+struct LinearToSRGBTables8
+{
+    float           thresholds[256];            // Linear value of the sRGB value (i + 0.5) / 255, where the encoding rounds up to i + 1.
+    std::uint8_t    buckets[g_sRGBBuckets8 + 1];  // Smallest sRGB value of each bucket of linear values.
+};
+
+static const LinearToSRGBTables8* GetLinearToSRGBTables8()
+{
+    static const std::unique_ptr<LinearToSRGBTables8> tables = []()
+    {
+        std::unique_ptr<LinearToSRGBTables8> t { new LinearToSRGBTables8() };
+
+        for (std::size_t i = 0; i < 255; ++i)
+            t->thresholds[i] = SRGBToLinear((static_cast<float>(i) + 0.5f) / 255.0f);
+        t->thresholds[255] = std::numeric_limits<float>::infinity();
+
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i <= g_sRGBBuckets8; ++i)
+        {
+            const auto bucketMin = static_cast<float>(i) / static_cast<float>(g_sRGBBuckets8);
+            while (t->thresholds[value] <= bucketMin)
+                ++value;
+            t->buckets[i] = static_cast<std::uint8_t>(value);
+        }
+
+        return t;
+    }();
+    return tables.get();
+}
+
+/*
+Converts the specified linear value into 8-bit sRGB (NaN is mapped to 0).
+The bucket gives the first candidate and the thresholds refine it, which takes at most a few steps,
+since even the steepest part of the sRGB curve spans less than one value per bucket.
+*/
+static std::uint8_t LinearToSRGB8(float value, const LinearToSRGBTables8& tables)
+{
+    value = (value > 0.0f ? value : 0.0f);
+    value = (value < 1.0f ? value : 1.0f);
+
+    std::uint32_t index = tables.buckets[static_cast<std::size_t>(value * static_cast<float>(g_sRGBBuckets8))];
+    while (tables.thresholds[index] <= value)
+        ++index;
+
+    return static_cast<std::uint8_t>(index);
+}
+
+// Returns a bit mask of the components that are stored in sRGB color space (i.e. all color components, but not alpha).
+static std::uint32_t GetSRGBComponentMask(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::R:
+        case ImageFormat::RG:
+        case ImageFormat::RGB:
+        case ImageFormat::BGR:
+        case ImageFormat::RGBA:
+        case ImageFormat::BGRA:
+            return 0x7;
+        case ImageFormat::ARGB:
+        case ImageFormat::ABGR:
+            return 0xE;
+        default:
+            return 0x0;
+    }
+}
+
+// Reads the specified values and returns them in the normalized range [0, 1] (same as "ReadNormalizedVariant" in ImageFlags.cpp).
+template <typename T>
+void LoadNormalized(const T* src, float* dst, std::size_t count)
+{
+    const auto min = static_cast<double>(std::numeric_limits<T>::min());
+    const auto max = static_cast<double>(std::numeric_limits<T>::max());
+    for (std::size_t i = 0; i < count; ++i)
+        dst[i] = static_cast<float>((static_cast<double>(src[i]) - min) / (max - min));
+}
+
+/*
+Writes the specified values from the range [0, 1] to the destination and rounds them to the nearest integer.
+Types with up to 16 bits are computed with single precision, just like the SIMD variant for 8-bit values.
+*/
+template <typename T>
+void StoreNormalized(const float* src, T* dst, std::size_t count)
+{
+    using Real = typename std::conditional<(sizeof(T) <= 2), float, double>::type;
+
+    const auto min      = static_cast<std::int64_t>(std::numeric_limits<T>::min());
+    const auto range    = static_cast<Real>(static_cast<double>(std::numeric_limits<T>::max()) - static_cast<double>(min));
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        /* Clamp value to [0, 1] (NaN is mapped to 0) */
+        auto value = static_cast<Real>(src[i]);
+        value = (value > Real(0) ? value : Real(0));
+        value = (value < Real(1) ? value : Real(1));
+        dst[i] = static_cast<T>(static_cast<std::int64_t>(value * range + Real(0.5)) + min);
+    }
+}
+
+static void StoreUInt8(const float* src, std::uint8_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_SSE2
+
+    const auto zero     = _mm_setzero_ps();
+    const auto one      = _mm_set1_ps(1.0f);
+    const auto scale    = _mm_set1_ps(255.0f);
+    const auto half     = _mm_set1_ps(0.5f);
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i values[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            /* Clamp to [0, 1] (MAXPS returns the second operand for NaN), scale, and round */
+            auto x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + j * 4), zero), one);
+            values[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(x, scale), half));
+        }
+        const auto lo = _mm_packs_epi32(values[0], values[1]);
+        const auto hi = _mm_packs_epi32(values[2], values[3]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+
+    #elif defined LLGL_SIMD_NEON
+
+    const auto zero     = vdupq_n_f32(0.0f);
+    const auto one      = vdupq_n_f32(1.0f);
+    const auto half     = vdupq_n_f32(0.5f);
+
+    for (; i + 8 <= count; i += 8)
+    {
+        /* Clamp to [0, 1] (FMAXNM returns the number for NaN), scale, and round */
+        auto x0 = vminq_f32(vmaxnmq_f32(vld1q_f32(src + i    ), zero), one);
+        auto x1 = vminq_f32(vmaxnmq_f32(vld1q_f32(src + i + 4), zero), one);
+        auto v0 = vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(x0, 255.0f), half));
+        auto v1 = vcvtq_u32_f32(vaddq_f32(vmulq_n_f32(x1, 255.0f), half));
+        vst1_u8(dst + i, vmovn_u16(vcombine_u16(vmovn_u32(v0), vmovn_u32(v1))));
+    }
+
+    #endif
+
+    StoreNormalized(src + i, dst + i, count - i);
+}
+
+static void LoadComponents(DataType dataType, const void* src, float* dst, std::size_t count, DataTypeConversionKernel kernel)
+{
+    if (kernel != nullptr)
+    {
+        kernel(src, dst, count);
+        return;
+    }
+
+    switch (dataType)
+    {
+        case DataType::Undefined:
+            break;
+        case DataType::Int8:
+            LoadNormalized(reinterpret_cast<const std::int8_t*>(src), dst, count);
+            break;
+        case DataType::UInt8:
+            LoadNormalized(reinterpret_cast<const std::uint8_t*>(src), dst, count);
+            break;
+        case DataType::Int16:
+            LoadNormalized(reinterpret_cast<const std::int16_t*>(src), dst, count);
+            break;
+        case DataType::UInt16:
+            LoadNormalized(reinterpret_cast<const std::uint16_t*>(src), dst, count);
+            break;
+        case DataType::Int32:
+            LoadNormalized(reinterpret_cast<const std::int32_t*>(src), dst, count);
+            break;
+        case DataType::UInt32:
+            LoadNormalized(reinterpret_cast<const std::uint32_t*>(src), dst, count);
+            break;
+        case DataType::Float16:
+            DecompressFloat16Array(reinterpret_cast<const std::uint16_t*>(src), dst, count);
+            break;
+        case DataType::Float32:
+            ::memcpy(dst, src, count * sizeof(float));
+            break;
+        case DataType::Float64:
+            for (std::size_t i = 0; i < count; ++i)
+                dst[i] = static_cast<float>(reinterpret_cast<const double*>(src)[i]);
+            break;
+    }
+}
+
+static void StoreComponents(DataType dataType, const float* src, void* dst, std::size_t count)
+{
+    switch (dataType)
+    {
+        case DataType::Undefined:
+            break;
+        case DataType::Int8:
+            StoreNormalized(src, reinterpret_cast<std::int8_t*>(dst), count);
+            break;
+        case DataType::UInt8:
+            StoreUInt8(src, reinterpret_cast<std::uint8_t*>(dst), count);
+            break;
+        case DataType::Int16:
+            StoreNormalized(src, reinterpret_cast<std::int16_t*>(dst), count);
+            break;
+        case DataType::UInt16:
+            StoreNormalized(src, reinterpret_cast<std::uint16_t*>(dst), count);
+            break;
+        case DataType::Int32:
+            StoreNormalized(src, reinterpret_cast<std::int32_t*>(dst), count);
+            break;
+        case DataType::UInt32:
+            StoreNormalized(src, reinterpret_cast<std::uint32_t*>(dst), count);
+            break;
+        case DataType::Float16:
+            CompressFloat16Array(src, reinterpret_cast<std::uint16_t*>(dst), count);
+            break;
+        case DataType::Float32:
+            ::memcpy(dst, src, count * sizeof(float));
+            break;
+        case DataType::Float64:
+            for (std::size_t i = 0; i < count; ++i)
+                reinterpret_cast<double*>(dst)[i] = static_cast<double>(src[i]);
+            break;
+    }
+}
+
+// Pixel format to load and store image pixels as floating-point components.
+struct PixelCodec
+{
+    PixelCodec(ImageFormat format, DataType dataType, bool sRGB) :
+        dataType        { dataType                                                             },
+        typeSize        { DataTypeSize(dataType)                                               },
+        numComponents   { ImageFormatSize(format)                                              },
+        sRGBMask        { (sRGB ? GetSRGBComponentMask(format) : 0u)                           },
+        loadKernel      { FindDataTypeConversionKernel(dataType, DataType::Float32)            },
+        sRGBTables8     { (sRGBMask != 0 && dataType == DataType::UInt8 ? GetLinearToSRGBTables8() : nullptr)     }
+    {
+        /* Select a lookup table for each component of 8-bit sRGB images */
+        if (sRGBTables8 != nullptr)
+        {
+            for (std::size_t c = 0; c < numComponents; ++c)
+                loadTables8[c] = (((1u << c) & sRGBMask) != 0 ? GetSRGBToLinearTable8() : GetNormalizedTable8());
+        }
+    }
+
+    DataType                    dataType;
+    std::size_t                 typeSize;
+    std::size_t                 numComponents;
+    std::uint32_t               sRGBMask;
+    DataTypeConversionKernel    loadKernel;
+    const LinearToSRGBTables8*  sRGBTables8;
+    const float*                loadTables8[4]  = {};
+};
+
+// Loads the pixels from the image buffer 'src' as floats and converts the sRGB components into linear space.
+static void LoadPixels(const PixelCodec& codec, const void* src, float* dst, std::size_t numPixels)
+{
+    const auto count = numPixels * codec.numComponents;
+
+    if (codec.sRGBTables8 != nullptr)
+    {
+        /* Convert 8-bit components with lookup tables */
+        auto src8 = reinterpret_cast<const std::uint8_t*>(src);
+        for (std::size_t i = 0; i < count; i += codec.numComponents)
+        {
+            for (std::size_t c = 0; c < codec.numComponents; ++c)
+                dst[i + c] = codec.loadTables8[c][src8[i + c]];
+        }
+    }
+    else
+    {
+        LoadComponents(codec.dataType, src, dst, count, codec.loadKernel);
+
+        if (codec.sRGBMask != 0)
+        {
+            for (std::size_t i = 0; i < count; i += codec.numComponents)
+            {
+                for (std::size_t c = 0; c < codec.numComponents; ++c)
+                {
+                    if (((1u << c) & codec.sRGBMask) != 0)
+                        dst[i + c] = SRGBToLinear(dst[i + c]);
+                }
+            }
+        }
+    }
+}
+
+// Converts the sRGB components of 'src' back from linear space (in place) and stores the pixels in the image buffer 'dst'.
+static void StorePixels(const PixelCodec& codec, float* src, void* dst, std::size_t numPixels)
+{
+    const auto count = numPixels * codec.numComponents;
+
+    if (codec.sRGBTables8 != nullptr)
+    {
+        /* Store all components, then encode the sRGB components directly into 8-bit values */
+        auto dst8 = reinterpret_cast<std::uint8_t*>(dst);
+        StoreUInt8(src, dst8, count);
+
+        for (std::size_t i = 0; i < count; i += codec.numComponents)
+        {
+            for (std::size_t c = 0; c < codec.numComponents; ++c)
+            {
+                if (((1u << c) & codec.sRGBMask) != 0)
+                    dst8[i + c] = LinearToSRGB8(src[i + c], *codec.sRGBTables8);
+            }
+        }
+    }
+    else
+    {
+        if (codec.sRGBMask != 0)
+        {
+            for (std::size_t i = 0; i < count; i += codec.numComponents)
+            {
+                for (std::size_t c = 0; c < codec.numComponents; ++c)
+                {
+                    if (((1u << c) & codec.sRGBMask) != 0)
+                        src[i + c] = LinearToSRGB(src[i + c]);
+                }
+            }
+        }
+        StoreComponents(codec.dataType, src, dst, count);
+    }
+}
+
+
+/* ----- Resampling passes ----- */
+
+/*
+Resamples the rows of the image along the X axis. Each destination pixel is accumulated in registers.
+If 'srcFloats' is null, the source rows are loaded from 'srcImage' on the fly, and
+if 'dstFloats' is null, the destination rows are stored in 'dstImage' right away,
+so the first and last pass don't need an intermediate buffer of the entire image.
+*/
+static void ResampleRows(
+    const ResampleTaps& taps,
+    const PixelCodec&   codec,
+    std::size_t         numRows,
+    std::size_t         srcWidth,
+    std::size_t         dstWidth,
+    const float*        srcFloats,
+    const void*         srcImage,
+    float*              dstFloats,
+    void*               dstImage,
+    std::size_t         threadCount)
+{
+    const auto numComponents    = codec.numComponents;
+    const auto bpp              = numComponents * codec.typeSize;
+
+    WorkerPool::Get().ParallelFor(
+        numRows,
+        std::max(std::size_t(1), g_resampleMinWorkSize / (dstWidth * numComponents)),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            std::vector<float> srcScratch(srcFloats != nullptr ? 0 : srcWidth * numComponents);
+            std::vector<float> dstScratch(dstFloats != nullptr ? 0 : dstWidth * numComponents);
+
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                /* Get source row */
+                const float* srcRow = nullptr;
+                if (srcFloats != nullptr)
+                    srcRow = srcFloats + row * srcWidth * numComponents;
+                else
+                {
+                    LoadPixels(codec, reinterpret_cast<const char*>(srcImage) + row * srcWidth * bpp, srcScratch.data(), srcWidth);
+                    srcRow = srcScratch.data();
+                }
+
+                /* Filter destination row */
+                auto dstRow = (dstFloats != nullptr ? dstFloats + row * dstWidth * numComponents : dstScratch.data());
+
+                for (std::size_t x = 0; x < dstWidth; ++x)
+                {
+                    const auto tapsBegin    = taps.offsets[x];
+                    const auto tapsEnd      = taps.offsets[x + 1];
+                    FilterPixel(
+                        dstRow + x * numComponents,
+                        srcRow,
+                        &(taps.indices[tapsBegin]),
+                        &(taps.weights[tapsBegin]),
+                        tapsEnd - tapsBegin,
+                        numComponents
+                    );
+                }
+
+                if (dstFloats == nullptr)
+                    StorePixels(codec, dstRow, reinterpret_cast<char*>(dstImage) + row * dstWidth * bpp, dstWidth);
+            }
+        }
+    );
+}
+
+/*
+Resamples the image along the Y or Z axis. The image is interpreted as [outer][axis][inner] array of floats,
+so the Y axis has entire rows and the Z axis has entire slices as inner dimension.
+Each destination line is accumulated row by row in segments, so the innermost loop always runs over contiguous memory
+and even a few large slices are distributed among all threads.
+If 'dstFloats' is null, the destination segments are stored in 'dstImage' right away.
+*/
+static void ResampleLines(
+    const ResampleTaps& taps,
+    const PixelCodec&   codec,
+    std::size_t         outerSize,
+    std::size_t         srcAxisSize,
+    std::size_t         dstAxisSize,
+    std::size_t         innerSize,
+    const float*        srcFloats,
+    float*              dstFloats,
+    void*               dstImage,
+    std::size_t         threadCount)
+{
+    const auto numComponents    = codec.numComponents;
+    const auto bpp              = numComponents * codec.typeSize;
+    const auto segmentSize      = std::min(innerSize, g_resampleMinWorkSize / 4 * numComponents);
+    const auto numSegments      = (innerSize + segmentSize - 1) / segmentSize;
+
+    WorkerPool::Get().ParallelFor(
+        outerSize * dstAxisSize * numSegments,
+        std::max(std::size_t(1), g_resampleMinWorkSize / segmentSize),
+        threadCount,
+        [&](std::size_t itemBegin, std::size_t itemEnd)
+        {
+            std::vector<float> dstScratch(dstFloats != nullptr ? 0 : segmentSize);
+
+            for (auto item = itemBegin; item < itemEnd; ++item)
+            {
+                const auto  line        = item / numSegments;
+                const auto  offset      = (item % numSegments) * segmentSize;
+                const auto  length      = std::min(segmentSize, innerSize - offset);
+                const auto  outer       = line / dstAxisSize;
+                const auto  i           = line % dstAxisSize;
+                const auto  srcBase     = srcFloats + outer * srcAxisSize * innerSize + offset;
+                auto        dstSegment  = (dstFloats != nullptr ? dstFloats + line * innerSize + offset : dstScratch.data());
+
+                const auto tapsBegin    = taps.offsets[i];
+                const auto tapsEnd      = taps.offsets[i + 1];
+
+                if (innerSize <= 4)
+                {
+                    /* Accumulate single pixel in registers */
+                    FilterPixel(dstSegment, srcBase, &(taps.indices[tapsBegin]), &(taps.weights[tapsBegin]), tapsEnd - tapsBegin, innerSize);
+                }
+                else
+                {
+                    ScaleRow(dstSegment, srcBase + taps.indices[tapsBegin] * innerSize, taps.weights[tapsBegin], length);
+                    for (auto tap = tapsBegin + 1; tap < tapsEnd; ++tap)
+                        AccumulateRow(dstSegment, srcBase + taps.indices[tap] * innerSize, taps.weights[tap], length);
+                }
+
+                if (dstFloats == nullptr)
+                    StorePixels(codec, dstSegment, reinterpret_cast<char*>(dstImage) + (line * innerSize + offset) / numComponents * bpp, length / numComponents);
+            }
+        }
+    );
+}
+
+// Loads the entire image as floats, which is required if the first pass is not along the X axis.
+static void LoadImagePixels(const PixelCodec& codec, const void* src, float* dst, std::size_t numPixels, std::size_t threadCount)
+{
+    const auto bpp = codec.numComponents * codec.typeSize;
+
+    WorkerPool::Get().ParallelFor(
+        numPixels,
+        std::max(std::size_t(1), g_resampleMinWorkSize / codec.numComponents),
+        threadCount,
+        [&](std::size_t pixelBegin, std::size_t pixelEnd)
+        {
+            LoadPixels(codec, reinterpret_cast<const char*>(src) + pixelBegin * bpp, dst + pixelBegin * codec.numComponents, pixelEnd - pixelBegin);
+        }
+    );
+}
+
+
+/* ----- Resampling ----- */
+
+static void ResampleImageNearest(
+    const char*     src,
+    const Extent3D& srcExtent,
+    char*           dst,
+    const Extent3D& dstExtent,
+    std::size_t     bpp,
+    std::size_t     threadCount)
+{
+    ResampleTaps tapsX, tapsY, tapsZ;
+    BuildResampleTaps(tapsX, srcExtent.width,  dstExtent.width,  ImageFilter::Nearest);
+    BuildResampleTaps(tapsY, srcExtent.height, dstExtent.height, ImageFilter::Nearest);
+    BuildResampleTaps(tapsZ, srcExtent.depth,  dstExtent.depth,  ImageFilter::Nearest);
+
+    const auto srcRowStride = bpp * srcExtent.width;
+    const auto dstRowStride = bpp * dstExtent.width;
+
+    /* Copy pixels bitwise for each destination row */
+    WorkerPool::Get().ParallelFor(
+        static_cast<std::size_t>(dstExtent.height) * dstExtent.depth,
+        std::max(std::size_t(1), g_resampleMinWorkSize / dstRowStride),
+        threadCount,
+        [&](std::size_t rowBegin, std::size_t rowEnd)
+        {
+            for (auto row = rowBegin; row < rowEnd; ++row)
+            {
+                const auto  y       = tapsY.indices[row % dstExtent.height];
+                const auto  z       = tapsZ.indices[row / dstExtent.height];
+                const auto  srcRow  = src + (static_cast<std::size_t>(z) * srcExtent.height + y) * srcRowStride;
+                auto        dstRow  = dst + row * dstRowStride;
+
+                for (std::uint32_t x = 0; x < dstExtent.width; ++x)
+                    ::memcpy(dstRow + x * bpp, srcRow + tapsX.indices[x] * bpp, bpp);
+            }
+        }
+    );
+}
+
+static std::uint32_t GetExtentAxis(const Extent3D& extent, int axis)
+{
+    return (axis == 0 ? extent.width : axis == 1 ? extent.height : extent.depth);
+}
+
+static void SetExtentAxis(Extent3D& extent, int axis, std::uint32_t size)
+{
+    if (axis == 0)
+        extent.width = size;
+    else if (axis == 1)
+        extent.height = size;
+    else
+        extent.depth = size;
+}
+
+static std::size_t GetExtentVolume(const Extent3D& extent)
+{
+    return (static_cast<std::size_t>(extent.width) * extent.height * extent.depth);
+}
+
+static void ValidateResampleParams(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ImageFilter                 filter)
+{
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+
+    if (srcImageDesc.format != dstImageDesc.format || srcImageDesc.dataType != dstImageDesc.dataType)
+        throw std::invalid_argument("cannot resample image with different source and destination formats");
+    if (IsCompressedFormat(srcImageDesc.format))
+        throw std::invalid_argument("cannot resample compressed image formats");
+    if (filter != ImageFilter::Nearest && srcImageDesc.format == ImageFormat::DepthStencil)
+        throw std::invalid_argument("cannot filter depth-stencil image format (only ImageFilter::Nearest is supported)");
+
+    if (GetExtentVolume(srcExtent) == 0 || GetExtentVolume(dstExtent) == 0)
+        throw std::invalid_argument("cannot resample image with zero extent");
+
+    const auto bpp = static_cast<std::size_t>(GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, 1));
+    if (srcImageDesc.dataSize < bpp * GetExtentVolume(srcExtent))
+        throw std::invalid_argument("source image data size is too small for the source extent");
+    if (dstImageDesc.dataSize < bpp * GetExtentVolume(dstExtent))
+        throw std::invalid_argument("destination image data size is too small for the destination extent");
+}
+
+void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ImageFilter                 filter,
+    bool                        sRGB,
+    std::size_t                 threadCount)
+{
+    ValidateResampleParams(srcImageDesc, srcExtent, dstImageDesc, dstExtent, filter);
+
+    const auto format   = srcImageDesc.format;
+    const auto dataType = srcImageDesc.dataType;
+    const auto bpp      = static_cast<std::size_t>(GetMemoryFootprint(format, dataType, 1));
+
+    if (srcExtent == dstExtent)
+    {
+        /* Nothing to filter, so just copy the image */
+        ::memcpy(dstImageDesc.data, srcImageDesc.data, bpp * GetExtentVolume(srcExtent));
+        return;
+    }
+
+    if (filter == ImageFilter::Nearest)
+    {
+        ResampleImageNearest(
+            reinterpret_cast<const char*>(srcImageDesc.data),
+            srcExtent,
+            reinterpret_cast<char*>(dstImageDesc.data),
+            dstExtent,
+            bpp,
+            threadCount
+        );
+        return;
+    }
+
+    const PixelCodec codec { format, dataType, sRGB };
+
+    /* Filter Float32 images in place if no color space conversion is required */
+    const bool directAccess = (dataType == DataType::Float32 && codec.sRGBMask == 0);
+
+    /* Resample the axis that shrinks the most first to keep the intermediate images small */
+    int axes[3] = { 0, 1, 2 };
+    std::stable_sort(
+        std::begin(axes),
+        std::end(axes),
+        [&](int lhs, int rhs)
+        {
+            const auto lhsScale = static_cast<double>(GetExtentAxis(dstExtent, lhs)) / GetExtentAxis(srcExtent, lhs);
+            const auto rhsScale = static_cast<double>(GetExtentAxis(dstExtent, rhs)) / GetExtentAxis(srcExtent, rhs);
+            return (lhsScale < rhsScale);
+        }
+    );
+
+    std::vector<int> passes;
+    for (auto axis : axes)
+    {
+        if (GetExtentAxis(srcExtent, axis) != GetExtentAxis(dstExtent, axis))
+            passes.push_back(axis);
+    }
+
+    /* Only a pass along the X axis can load the source image on the fly, so load entire image otherwise */
+    std::unique_ptr<float[]> buffer;
+    const float* src = nullptr;
+
+    if (directAccess)
+        src = reinterpret_cast<const float*>(srcImageDesc.data);
+    else if (passes.front() != 0)
+    {
+        const auto numPixels = GetExtentVolume(srcExtent);
+        buffer = MakeUniqueArray<float>(numPixels * codec.numComponents);
+        LoadImagePixels(codec, srcImageDesc.data, buffer.get(), numPixels, threadCount);
+        src = buffer.get();
+    }
+
+    Extent3D extent = srcExtent;
+
+    for (std::size_t pass = 0; pass < passes.size(); ++pass)
+    {
+        const auto axis         = passes[pass];
+        const auto srcAxisSize  = GetExtentAxis(srcExtent, axis);
+        const auto dstAxisSize  = GetExtentAxis(dstExtent, axis);
+
+        ResampleTaps taps;
+        BuildResampleTaps(taps, srcAxisSize, dstAxisSize, filter);
+
+        /* Determine [outer][axis][inner] layout for the current axis */
+        const auto rowSize      = static_cast<std::size_t>(extent.width) * codec.numComponents;
+        const auto sliceSize    = rowSize * extent.height;
+
+        SetExtentAxis(extent, axis, dstAxisSize);
+
+        /* The last pass stores the pixels in the destination image, all other passes write into an intermediate buffer */
+        std::unique_ptr<float[]> dstBuffer;
+        float* dst = nullptr;
+
+        if (pass + 1 < passes.size())
+        {
+            dstBuffer = MakeUniqueArray<float>(GetExtentVolume(extent) * codec.numComponents);
+            dst = dstBuffer.get();
+        }
+        else if (directAccess)
+            dst = reinterpret_cast<float*>(dstImageDesc.data);
+
+        if (axis == 0)
+        {
+            ResampleRows(
+                taps, codec, static_cast<std::size_t>(extent.height) * extent.depth, srcAxisSize, dstAxisSize,
+                src, srcImageDesc.data, dst, dstImageDesc.data, threadCount
+            );
+        }
+        else if (axis == 1)
+        {
+            ResampleLines(
+                taps, codec, extent.depth, srcAxisSize, dstAxisSize, rowSize,
+                src, dst, dstImageDesc.data, threadCount
+            );
+        }
+        else
+        {
+            ResampleLines(
+                taps, codec, 1, srcAxisSize, dstAxisSize, sliceSize,
+                src, dst, dstImageDesc.data, threadCount
+            );
+        }
+
+        buffer  = std::move(dstBuffer);
+        src     = dst;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
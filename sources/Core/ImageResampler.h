@@ -0,0 +1,45 @@
+/*
+ * ImageResampler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_RESAMPLER_H
+#define LLGL_IMAGE_RESAMPLER_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Types.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Resamples the source image into the destination image. Both images must have the same format and data type.
+The filter is applied separately for each axis whose size differs, starting with the axis that shrinks the most.
+Except for ImageFilter::Nearest, the pixels are filtered as 32-bit floats and stored with rounding to the nearest value.
+If 'sRGB' is true, the color components (but not alpha) are converted from sRGB into linear space before filtering and back afterwards.
+*/
+void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ImageFilter                 filter,
+    bool                        sRGB,
+    std::size_t                 threadCount
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
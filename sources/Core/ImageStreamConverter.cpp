@@ -0,0 +1,270 @@
+/*
+ * ImageStreamConverter.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageStreamConverter.h>
+#include <LLGL/RenderSystem.h>
+#include <LLGL/Texture.h>
+#include "../Renderer/TextureUtils.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Default maximal size (in bytes) of the source and destination strip together.
+static const std::size_t g_defaultMaxStripSize = 4 * 1024 * 1024;
+
+// Returns the texture region for the specified strip of the image that is streamed into 'textureRegion'.
+static TextureRegion GetStripTextureRegion(const TextureType type, const TextureRegion& textureRegion, const Offset3D& offset, const Extent3D& extent)
+{
+    TextureRegion stripRegion = textureRegion;
+
+    switch (type)
+    {
+        case TextureType::Texture1D:
+            break;
+
+        case TextureType::Texture1DArray:
+            /* Each row of a 1D array texture is an array layer */
+            stripRegion.subresource.baseArrayLayer += static_cast<std::uint32_t>(offset.y);
+            stripRegion.subresource.numArrayLayers  = extent.height;
+            break;
+
+        case TextureType::Texture2D:
+        case TextureType::Texture2DMS:
+            stripRegion.offset.y += offset.y;
+            stripRegion.extent.height = extent.height;
+            break;
+
+        case TextureType::Texture2DArray:
+        case TextureType::TextureCube:
+        case TextureType::TextureCubeArray:
+        case TextureType::Texture2DMSArray:
+            /* Each slice of a 2D array texture is an array layer */
+            stripRegion.subresource.baseArrayLayer += static_cast<std::uint32_t>(offset.z);
+            stripRegion.subresource.numArrayLayers  = 1;
+            stripRegion.offset.y += offset.y;
+            stripRegion.extent.height = extent.height;
+            break;
+
+        case TextureType::Texture3D:
+            stripRegion.offset.y += offset.y;
+            stripRegion.offset.z += offset.z;
+            stripRegion.extent.height = extent.height;
+            stripRegion.extent.depth  = 1;
+            break;
+    }
+
+    return stripRegion;
+}
+
+ImageStreamConverter::ImageStreamConverter(
+    const Extent3D&             extent,
+    const ImageFormat           srcFormat,
+    const DataType              srcDataType,
+    const ImageFormat           dstFormat,
+    const DataType              dstDataType,
+    const WriteStripFunction&   writeStripFunc,
+    std::size_t                 maxStripSize,
+    std::size_t                 threadCount)
+:
+    extent_         { extent         },
+    srcFormat_      { srcFormat      },
+    srcDataType_    { srcDataType    },
+    dstFormat_      { dstFormat      },
+    dstDataType_    { dstDataType    },
+    writeStripFunc_ { writeStripFunc },
+    threadCount_    { threadCount    }
+{
+    Initialize(maxStripSize);
+}
+
+ImageStreamConverter::ImageStreamConverter(
+    RenderSystem&               renderSystem,
+    Texture&                    texture,
+    const TextureRegion&        textureRegion,
+    const ImageFormat           srcFormat,
+    const DataType              srcDataType,
+    std::size_t                 maxStripSize,
+    std::size_t                 threadCount)
+:
+    extent_         { CalcTextureExtent(texture.GetType(), textureRegion.extent, textureRegion.subresource.numArrayLayers) },
+    srcFormat_      { srcFormat                                                                                            },
+    srcDataType_    { srcDataType                                                                                          },
+    dstFormat_      { GetFormatAttribs(texture.GetFormat()).format                                                         },
+    dstDataType_    { GetFormatAttribs(texture.GetFormat()).dataType                                                       },
+    threadCount_    { threadCount                                                                                          }
+{
+    /* Forward each strip to the sub region of the texture */
+    auto renderSystemPtr    = &renderSystem;
+    auto texturePtr         = &texture;
+
+    writeStripFunc_ = [renderSystemPtr, texturePtr, textureRegion](const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc)
+    {
+        renderSystemPtr->WriteTexture(
+            *texturePtr,
+            GetStripTextureRegion(texturePtr->GetType(), textureRegion, offset, extent),
+            imageDesc
+        );
+    };
+
+    Initialize(maxStripSize);
+}
+
+std::size_t ImageStreamConverter::Write(const void* data, std::size_t dataSize)
+{
+    auto src = reinterpret_cast<const char*>(data);
+
+    /* Ignore data beyond the end of the image */
+    dataSize = std::min(dataSize, GetRemainingSize());
+    const auto consumedSize = dataSize;
+
+    while (dataSize > 0)
+    {
+        /* Strips never span multiple slices */
+        const auto numRows      = std::min(stripRows_, extent_.height - currentRow_);
+        const auto stripSize    = srcRowSize_ * numRows;
+
+        if (srcStripSize_ == 0 && dataSize >= stripSize)
+        {
+            /* Convert entire strip directly from input data */
+            ConvertStrip(src, numRows);
+            src         += stripSize;
+            dataSize    -= stripSize;
+        }
+        else
+        {
+            /* Append input data to strip buffer */
+            if (!srcStrip_)
+                srcStrip_ = GenerateEmptyByteBuffer(srcRowSize_ * stripRows_, false);
+
+            const auto size = std::min(stripSize - srcStripSize_, dataSize);
+            ::memcpy(srcStrip_.get() + srcStripSize_, src, size);
+
+            src             += size;
+            dataSize        -= size;
+            srcStripSize_   += size;
+
+            if (srcStripSize_ == stripSize)
+            {
+                srcStripSize_ = 0;
+                ConvertStrip(srcStrip_.get(), numRows);
+            }
+        }
+    }
+
+    return consumedSize;
+}
+
+void ImageStreamConverter::Flush()
+{
+    if (srcRowSize_ == 0 || srcStripSize_ < srcRowSize_)
+        return;
+
+    /* Only forward complete rows; compressed images also require complete rows of blocks except at the end of a slice */
+    auto numRows = static_cast<std::uint32_t>(srcStripSize_ / srcRowSize_);
+    if (currentRow_ + numRows < extent_.height)
+        numRows -= numRows % rowAlignment_;
+
+    if (numRows > 0)
+    {
+        const auto convertedSize    = srcRowSize_ * numRows;
+        const auto pendingSize      = srcStripSize_ - convertedSize;
+
+        ConvertStrip(srcStrip_.get(), numRows);
+
+        /* Move pending partial row to the front of the strip buffer */
+        ::memmove(srcStrip_.get(), srcStrip_.get() + convertedSize, pendingSize);
+        srcStripSize_ = pendingSize;
+    }
+}
+
+bool ImageStreamConverter::IsComplete() const
+{
+    return (GetRemainingSize() == 0);
+}
+
+std::size_t ImageStreamConverter::GetRemainingSize() const
+{
+    const auto totalSize    = srcRowSize_ * extent_.height * extent_.depth;
+    const auto writtenSize  = srcRowSize_ * (static_cast<std::size_t>(currentSlice_) * extent_.height + currentRow_) + srcStripSize_;
+    return (totalSize - writtenSize);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ImageStreamConverter::Initialize(std::size_t maxStripSize)
+{
+    /* Validate input parameters */
+    if (IsCompressedFormat(srcFormat_))
+        throw std::invalid_argument("cannot stream image with compressed source format");
+    if (!writeStripFunc_)
+        throw std::invalid_argument("cannot stream image without callback function for converted strips");
+
+    srcRowSize_     = GetMemoryFootprint(srcFormat_, srcDataType_, extent_.width);
+    rowAlignment_   = (IsCompressedFormat(dstFormat_) ? 4 : 1);
+
+    /* Determine average size of each destination row, if a conversion is necessary */
+    const bool  conversionRequired  = (srcFormat_ != dstFormat_ || srcDataType_ != dstDataType_);
+    std::size_t dstRowSize          = 0;
+
+    if (conversionRequired)
+        dstRowSize = GetImageBufferSize(dstFormat_, dstDataType_, Extent3D{ extent_.width, rowAlignment_, 1 }) / rowAlignment_;
+
+    /* Determine number of rows per strip, so that source and destination strip fit into the maximal strip size */
+    if (maxStripSize == 0)
+        maxStripSize = g_defaultMaxStripSize;
+
+    auto numRows = static_cast<std::uint32_t>(std::min<std::size_t>(maxStripSize / std::max<std::size_t>(srcRowSize_ + dstRowSize, 1), extent_.height));
+    numRows -= numRows % rowAlignment_;
+    stripRows_ = std::max(std::min(rowAlignment_, extent_.height), numRows);
+
+    /* Allocate destination strip; the source strip is only allocated if input data must be buffered */
+    if (conversionRequired && stripRows_ > 0)
+        dstStrip_ = GenerateEmptyByteBuffer(GetImageBufferSize(dstFormat_, dstDataType_, Extent3D{ extent_.width, stripRows_, 1 }), false);
+}
+
+void ImageStreamConverter::ConvertStrip(const char* src, std::uint32_t numRows)
+{
+    const Offset3D              stripOffset { 0, static_cast<std::int32_t>(currentRow_), static_cast<std::int32_t>(currentSlice_) };
+    const Extent3D              stripExtent { extent_.width, numRows, 1 };
+    const SrcImageDescriptor    srcDesc     { srcFormat_, srcDataType_, src, srcRowSize_ * numRows };
+
+    /* Move to next strip before the callback is invoked, so an exception does not repeat the strip */
+    currentRow_ += numRows;
+    if (currentRow_ == extent_.height)
+    {
+        currentRow_ = 0;
+        ++currentSlice_;
+    }
+
+    if (dstStrip_)
+    {
+        /* Convert strip into destination strip buffer */
+        const DstImageDescriptor dstDesc { dstFormat_, dstDataType_, dstStrip_.get(), GetImageBufferSize(dstFormat_, dstDataType_, stripExtent) };
+        ConvertImageBuffer(srcDesc, dstDesc, stripExtent, threadCount_);
+        writeStripFunc_(stripOffset, stripExtent, SrcImageDescriptor{ dstFormat_, dstDataType_, dstDesc.data, dstDesc.dataSize });
+    }
+    else
+    {
+        /* Forward source strip as is */
+        writeStripFunc_(stripOffset, stripExtent, srcDesc);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
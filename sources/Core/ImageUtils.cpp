@@ -6,7 +6,10 @@
  */
 
 #include "ImageUtils.h"
+#include "WorkerPool.h"
 #include <LLGL/Types.h>
+#include <algorithm>
+#include <utility>
 #include <cstdint>
 #include <cstring>
 
@@ -15,63 +18,419 @@ namespace LLGL
 {
 
 
+// Minimal number of bytes each thread copies or swaps. Smaller images are processed on the calling thread only.
+static const std::size_t g_threadMinWorkBytes = 256 * 1024;
+
+// Maximal size (in bytes) of a tile for transpositions. Source and destination tiles together must fit into the L1 cache.
+static const std::size_t g_tileMaxBytes = 16 * 1024;
+
+/* ----- Internal functions ----- */
+
+// Returns the minimal number of work items for the worker pool so that each thread processes at least 'g_threadMinWorkBytes'.
+static std::size_t GetMinWorkSize(std::size_t bytesPerItem)
+{
+    return std::max(std::size_t(1), g_threadMinWorkBytes / std::max(bytesPerItem, std::size_t(1)));
+}
+
+// Returns the width and height of a square tile for the specified pixel size, so that it covers entire cache lines without exceeding 'g_tileMaxBytes'.
+static std::uint32_t GetTileSize(std::uint32_t bpp)
+{
+    std::uint32_t tileSize = 16;
+    while (tileSize < 128 && (tileSize * 2) * (tileSize * 2) * bpp <= g_tileMaxBytes)
+        tileSize *= 2;
+    return tileSize;
+}
+
+// Swaps two non-overlapping memory ranges through a small stack buffer.
+static void SwapMemory(char* lhs, char* rhs, std::size_t size)
+{
+    char temp[1024];
+    while (size > 0)
+    {
+        const auto n = std::min(size, sizeof(temp));
+        ::memcpy(temp, lhs, n);
+        ::memcpy(lhs, rhs, n);
+        ::memcpy(rhs, temp, n);
+        lhs += n;
+        rhs += n;
+        size -= n;
+    }
+}
+
+/*
+Pixel operations for a fixed pixel size, so the compiler can replace each memcpy by plain register moves.
+A pixel size of 0 selects the generic operations that take the pixel size at runtime.
+*/
+template <std::size_t PixelSize>
+struct PixelOps
+{
+    static inline void Copy(char* dst, const char* src, std::uint32_t /*bpp*/)
+    {
+        ::memcpy(dst, src, PixelSize);
+    }
+
+    static inline void Swap(char* lhs, char* rhs, std::uint32_t /*bpp*/)
+    {
+        char temp[PixelSize];
+        ::memcpy(temp, lhs, PixelSize);
+        ::memcpy(lhs, rhs, PixelSize);
+        ::memcpy(rhs, temp, PixelSize);
+    }
+};
+
+template <>
+struct PixelOps<0>
+{
+    static inline void Copy(char* dst, const char* src, std::uint32_t bpp)
+    {
+        ::memcpy(dst, src, bpp);
+    }
+
+    static inline void Swap(char* lhs, char* rhs, std::uint32_t bpp)
+    {
+        for (std::uint32_t i = 0; i < bpp; ++i)
+            std::swap(lhs[i], rhs[i]);
+    }
+};
+
+// Calls 'TKernel<N>::Run' with the pixel size N that matches 'bpp', or with N = 0 if there is no specialization for that size.
+template <template <std::size_t> class TKernel, typename... TArgs>
+static void DispatchPixelSize(std::uint32_t bpp, TArgs&&... args)
+{
+    switch (bpp)
+    {
+        case  1: TKernel< 1>::Run(bpp, std::forward<TArgs>(args)...); break;
+        case  2: TKernel< 2>::Run(bpp, std::forward<TArgs>(args)...); break;
+        case  3: TKernel< 3>::Run(bpp, std::forward<TArgs>(args)...); break;
+        case  4: TKernel< 4>::Run(bpp, std::forward<TArgs>(args)...); break;
+        case  6: TKernel< 6>::Run(bpp, std::forward<TArgs>(args)...); break;
+        case  8: TKernel< 8>::Run(bpp, std::forward<TArgs>(args)...); break;
+        case 12: TKernel<12>::Run(bpp, std::forward<TArgs>(args)...); break;
+        case 16: TKernel<16>::Run(bpp, std::forward<TArgs>(args)...); break;
+        default: TKernel< 0>::Run(bpp, std::forward<TArgs>(args)...); break;
+    }
+}
+
+// Runs 'func' for the range [0, count) either directly or on the worker pool.
+template <typename TFunc>
+static void ParallelRange(std::size_t count, std::size_t minWorkSize, std::size_t threadCount, const TFunc& func)
+{
+    if (threadCount < 2 || count < minWorkSize * 2)
+        func(std::size_t(0), count);
+    else
+        WorkerPool::Get().ParallelFor(count, minWorkSize, threadCount, func);
+}
+
+/* ----- Kernels ----- */
+
+template <std::size_t PixelSize>
+struct MirrorRowsKernel
+{
+    static void Run(std::uint32_t bpp, char* data, std::size_t rowStride, std::uint32_t width, std::size_t rowBegin, std::size_t rowEnd)
+    {
+        for (auto row = rowBegin; row < rowEnd; ++row)
+        {
+            auto lhs = data + row * rowStride;
+            auto rhs = lhs + (width - 1) * static_cast<std::size_t>(bpp);
+            for (; lhs < rhs; lhs += bpp, rhs -= bpp)
+                PixelOps<PixelSize>::Swap(lhs, rhs, bpp);
+        }
+    }
+};
+
+template <std::size_t PixelSize>
+struct TransposeKernel
+{
+    /*
+    Transposes the source columns [xBegin, xEnd) of the specified slice.
+    Each source column is a destination row, so different column ranges can be processed in parallel.
+    */
+    static void Run(
+        std::uint32_t   bpp,
+        char*           dst,
+        const char*     src,
+        std::uint32_t   width,
+        std::uint32_t   height,
+        std::uint32_t   tileSize,
+        bool            flipX,
+        bool            flipY,
+        std::uint32_t   xBegin,
+        std::uint32_t   xEnd)
+    {
+        const auto srcRowStride = static_cast<std::size_t>(width) * bpp;
+        const auto dstRowStride = static_cast<std::size_t>(height) * bpp;
+
+        for (std::uint32_t x0 = xBegin; x0 < xEnd; x0 += tileSize)
+        {
+            const auto x1 = std::min(x0 + tileSize, xEnd);
+
+            for (std::uint32_t y0 = 0; y0 < height; y0 += tileSize)
+            {
+                const auto y1 = std::min(y0 + tileSize, height);
+
+                /* Copy tile: each source column becomes a destination row */
+                for (auto x = x0; x < x1; ++x)
+                {
+                    const auto dstRow   = (flipY ? width - 1 - x : x);
+                    auto       dstPixel = dst + dstRow * dstRowStride;
+                    auto       srcPixel = src + y0 * srcRowStride + static_cast<std::size_t>(x) * bpp;
+
+                    if (flipX)
+                    {
+                        dstPixel += static_cast<std::size_t>(height - 1 - y0) * bpp;
+                        for (auto y = y0; y < y1; ++y, dstPixel -= bpp, srcPixel += srcRowStride)
+                            PixelOps<PixelSize>::Copy(dstPixel, srcPixel, bpp);
+                    }
+                    else
+                    {
+                        dstPixel += static_cast<std::size_t>(y0) * bpp;
+                        for (auto y = y0; y < y1; ++y, dstPixel += bpp, srcPixel += srcRowStride)
+                            PixelOps<PixelSize>::Copy(dstPixel, srcPixel, bpp);
+                    }
+                }
+            }
+        }
+    }
+};
+
+template <std::size_t PixelSize>
+struct TransposeSquareKernel
+{
+    // Swaps the tile at (tileX, tileY) with the transposed tile at (tileY, tileX). Tiles on the diagonal are transposed in place.
+    static void Run(std::uint32_t bpp, char* data, std::uint32_t size, std::uint32_t tileSize, std::uint32_t tileY, std::uint32_t tileX)
+    {
+        const auto rowStride    = static_cast<std::size_t>(size) * bpp;
+        const auto y0           = tileY * tileSize;
+        const auto y1           = std::min(y0 + tileSize, size);
+        const auto x0           = tileX * tileSize;
+        const auto x1           = std::min(x0 + tileSize, size);
+
+        for (auto y = y0; y < y1; ++y)
+        {
+            /* Swap pixel (x, y) with pixel (y, x); on the diagonal only the pixels right of the diagonal are swapped */
+            const auto xStart = (tileX == tileY ? y + 1 : x0);
+            auto lhs = data + y * rowStride + static_cast<std::size_t>(xStart) * bpp;
+            auto rhs = data + xStart * rowStride + static_cast<std::size_t>(y) * bpp;
+            for (auto x = xStart; x < x1; ++x, lhs += bpp, rhs += rowStride)
+                PixelOps<PixelSize>::Swap(lhs, rhs, bpp);
+        }
+    }
+};
+
+/* ----- Functions ----- */
+
+static void BitBlitRows(
+    std::uint32_t   height,
+    std::size_t     rowStride,
+    char*           dst,
+    std::size_t     dstRowStride,
+    std::size_t     dstDepthStride,
+    const char*     src,
+    std::size_t     srcRowStride,
+    std::size_t     srcDepthStride,
+    std::size_t     rowBegin,
+    std::size_t     rowEnd)
+{
+    for (auto row = rowBegin; row < rowEnd; ++row)
+    {
+        /* Copy current row */
+        const auto y = row % height;
+        const auto z = row / height;
+        ::memcpy(dst + z * dstDepthStride + y * dstRowStride, src + z * srcDepthStride + y * srcRowStride, rowStride);
+    }
+}
+
 void BitBlit(
     const Extent3D& extent,
     std::uint32_t   bpp,
     char*           dst,
-    std::uint32_t   dstRowStride,
-    std::uint32_t   dstDepthStride,
+    std::size_t     dstRowStride,
+    std::size_t     dstDepthStride,
     const char*     src,
-    std::uint32_t   srcRowStride,
-    std::uint32_t   srcDepthStride)
+    std::size_t     srcRowStride,
+    std::size_t     srcDepthStride,
+    std::size_t     threadCount)
 {
-    const auto rowStride    = bpp * extent.width;
+    const auto rowStride    = static_cast<std::size_t>(bpp) * extent.width;
     const auto depthStride  = rowStride * extent.height;
 
-    if (srcRowStride == dstRowStride && rowStride == dstRowStride)
+    if (srcRowStride == dstRowStride && rowStride == dstRowStride &&
+        srcDepthStride == dstDepthStride && depthStride == dstDepthStride)
+    {
+        /* Copy region directly into output data, split into large contiguous chunks */
+        ParallelRange(
+            depthStride * extent.depth,
+            g_threadMinWorkBytes,
+            threadCount,
+            [&](std::size_t begin, std::size_t end)
+            {
+                ::memcpy(dst + begin, src + begin, end - begin);
+            }
+        );
+    }
+    else if (srcRowStride == dstRowStride && rowStride == dstRowStride)
+    {
+        /* Copy region slice by slice into output data */
+        ParallelRange(
+            extent.depth,
+            GetMinWorkSize(depthStride),
+            threadCount,
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (auto z = begin; z < end; ++z)
+                    ::memcpy(dst + z * dstDepthStride, src + z * srcDepthStride, depthStride);
+            }
+        );
+    }
+    else
     {
-        if (srcDepthStride == dstDepthStride && depthStride == dstDepthStride)
+        /* Copy region row by row into output data */
+        ParallelRange(
+            static_cast<std::size_t>(extent.height) * extent.depth,
+            GetMinWorkSize(rowStride),
+            threadCount,
+            [&](std::size_t begin, std::size_t end)
+            {
+                BitBlitRows(extent.height, rowStride, dst, dstRowStride, dstDepthStride, src, srcRowStride, srcDepthStride, begin, end);
+            }
+        );
+    }
+}
+
+void MirrorImageBufferX(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount)
+{
+    if (extent.width < 2)
+        return;
+
+    const auto rowStride = static_cast<std::size_t>(extent.width) * bpp;
+
+    /* Reverse each row; rows are independent of each other */
+    ParallelRange(
+        static_cast<std::size_t>(extent.height) * extent.depth,
+        GetMinWorkSize(rowStride),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
         {
-            /* Copy region directly into output data */
-            ::memcpy(dst, src, depthStride * extent.depth);
+            DispatchPixelSize<MirrorRowsKernel>(bpp, data, rowStride, extent.width, begin, end);
         }
-        else
+    );
+}
+
+void MirrorImageBufferY(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount)
+{
+    const auto rowStride    = static_cast<std::size_t>(extent.width) * bpp;
+    const auto depthStride  = rowStride * extent.height;
+    const auto halfHeight   = extent.height / 2;
+
+    /* Swap each row in the upper half with its counterpart in the lower half */
+    ParallelRange(
+        static_cast<std::size_t>(halfHeight) * extent.depth,
+        GetMinWorkSize(rowStride * 2),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
         {
-            /* Copy region directly into output data */
-            for (std::uint32_t z = 0; z < extent.depth; ++z)
+            for (auto i = begin; i < end; ++i)
             {
-                /* Copy current slice */
-                ::memcpy(dst, src, depthStride);
-
-                /* Move pointers to next slice */
-                dst += dstDepthStride;
-                src += srcDepthStride;
+                const auto y = i % halfHeight;
+                const auto z = i / halfHeight;
+                auto slice = data + z * depthStride;
+                SwapMemory(slice + y * rowStride, slice + (extent.height - 1 - y) * rowStride, rowStride);
             }
         }
-    }
-    else
-    {
-        /* Adjust depth stride */
-        srcDepthStride -= srcRowStride * extent.height;
+    );
+}
+
+void MirrorImageBufferZ(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount)
+{
+    const auto rowStride    = static_cast<std::size_t>(extent.width) * bpp;
+    const auto depthStride  = rowStride * extent.height;
+    const auto halfDepth    = extent.depth / 2;
 
-        /* Copy region directly into output data */
-        for (std::uint32_t z = 0; z < extent.depth; ++z)
+    /* Swap each row in the front half with the same row in its counterpart slice, so even two slices can be swapped in parallel */
+    ParallelRange(
+        static_cast<std::size_t>(halfDepth) * extent.height,
+        GetMinWorkSize(rowStride * 2),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
         {
-            /* Copy current slice */
-            for (std::uint32_t y = 0; y < extent.height; ++y)
+            for (auto i = begin; i < end; ++i)
             {
-                /* Copy current row */
-                ::memcpy(dst, src, rowStride);
+                const auto y = i % extent.height;
+                const auto z = i / extent.height;
+                SwapMemory(
+                    data + z * depthStride + y * rowStride,
+                    data + (extent.depth - 1 - z) * depthStride + y * rowStride,
+                    rowStride
+                );
+            }
+        }
+    );
+}
 
-                /* Move pointers to next row */
-                dst += dstRowStride;
-                src += srcRowStride;
+void TransposeImageBuffer(
+    char*           dst,
+    const char*     src,
+    const Extent3D& srcExtent,
+    std::uint32_t   bpp,
+    bool            flipX,
+    bool            flipY,
+    std::size_t     threadCount)
+{
+    const auto tileSize     = GetTileSize(bpp);
+    const auto numTiles     = (srcExtent.width + tileSize - 1) / tileSize;
+    const auto depthStride  = static_cast<std::size_t>(srcExtent.width) * srcExtent.height * bpp;
+
+    /* Distribute columns of tiles among the threads; each column of tiles covers distinct rows of the destination */
+    ParallelRange(
+        static_cast<std::size_t>(numTiles) * srcExtent.depth,
+        GetMinWorkSize(static_cast<std::size_t>(tileSize) * srcExtent.height * bpp),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto tile = static_cast<std::uint32_t>(i % numTiles);
+                const auto z    = i / numTiles;
+                DispatchPixelSize<TransposeKernel>(
+                    bpp,
+                    dst + z * depthStride,
+                    src + z * depthStride,
+                    srcExtent.width,
+                    srcExtent.height,
+                    tileSize,
+                    flipX,
+                    flipY,
+                    tile * tileSize,
+                    std::min((tile + 1) * tileSize, srcExtent.width)
+                );
             }
+        }
+    );
+}
+
+void TransposeSquareImageBuffer(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount)
+{
+    const auto size         = extent.width;
+    const auto tileSize     = GetTileSize(bpp);
+    const auto numTiles     = (size + tileSize - 1) / tileSize;
+    const auto depthStride  = static_cast<std::size_t>(size) * size * bpp;
 
-            /* Move pointers to next slice */
-            src += srcDepthStride;
+    /* Distribute rows of tiles among the threads; row Y only swaps the tiles (X, Y) and (Y, X) for X >= Y, so no tile is touched twice */
+    ParallelRange(
+        static_cast<std::size_t>(numTiles) * extent.depth,
+        GetMinWorkSize(static_cast<std::size_t>(tileSize) * size * bpp),
+        threadCount,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto tileY    = static_cast<std::uint32_t>(i % numTiles);
+                const auto z        = i / numTiles;
+                for (auto tileX = tileY; tileX < numTiles; ++tileX)
+                    DispatchPixelSize<TransposeSquareKernel>(bpp, data + z * depthStride, size, tileSize, tileY, tileX);
+            }
         }
-    }
+    );
 }
 
 
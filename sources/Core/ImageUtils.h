@@ -10,6 +10,7 @@
 
 
 #include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -20,18 +21,46 @@ struct Extent3D;
 
 /* ----- Functions ----- */
 
-// Copies the specified extent from the source image to the destination image buffer.
+// Copies the specified extent from the source image to the destination image buffer. Large copies are distributed among 'threadCount' threads of the worker pool.
 void BitBlit(
     const Extent3D& extent,
     std::uint32_t   bpp,
     char*           dst,
-    std::uint32_t   dstRowStride,
-    std::uint32_t   dstDepthStride,
+    std::size_t     dstRowStride,
+    std::size_t     dstDepthStride,
     const char*     src,
-    std::uint32_t   srcRowStride,
-    std::uint32_t   srcDepthStride
+    std::size_t     srcRowStride,
+    std::size_t     srcDepthStride,
+    std::size_t     threadCount     = 0
 );
 
+// Reverses the order of pixels within each row of the image buffer, i.e. mirrors the image at the YZ plane.
+void MirrorImageBufferX(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount);
+
+// Reverses the order of rows within each slice of the image buffer, i.e. mirrors the image at the XZ plane.
+void MirrorImageBufferY(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount);
+
+// Reverses the order of slices of the image buffer, i.e. mirrors the image at the XY plane.
+void MirrorImageBufferZ(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount);
+
+/*
+Transposes each slice of the source image buffer into the destination image buffer, which must have the extent (height, width, depth).
+The pixels are copied in square tiles that fit into the L1 cache, so neither image buffer is walked column by column.
+If 'flipX' is true, the rows of the destination are mirrored, which turns the transposition into a clockwise 90 degree rotation.
+If 'flipY' is true, the order of rows in the destination is mirrored, which turns the transposition into a counter-clockwise 90 degree rotation.
+*/
+void TransposeImageBuffer(
+    char*           dst,
+    const char*     src,
+    const Extent3D& srcExtent,
+    std::uint32_t   bpp,
+    bool            flipX,
+    bool            flipY,
+    std::size_t     threadCount
+);
+
+// Transposes each slice of the square image buffer in place by swapping pairs of tiles. The width and height of 'extent' must be equal.
+void TransposeSquareImageBuffer(char* data, const Extent3D& extent, std::uint32_t bpp, std::size_t threadCount);
 
 } // /namespace LLGL
 
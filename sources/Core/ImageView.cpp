@@ -0,0 +1,163 @@
+/*
+ * ImageView.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageView.h>
+#include <LLGL/Image.h>
+#include "ImageUtils.h"
+#include <stdexcept>
+#include <string>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+ImageView::ImageView(const Extent3D& extent, const ImageFormat format, const DataType dataType, const void* data) :
+    extent_   { extent   },
+    format_   { format   },
+    dataType_ { dataType },
+    data_     { data     }
+{
+}
+
+static void ValidateImageDataSize(const Extent3D& extent, const DstImageDescriptor& imageDesc)
+{
+    const auto requiredDataSize = GetImageBufferSize(imageDesc.format, imageDesc.dataType, extent);
+    if (imageDesc.dataSize < requiredDataSize)
+    {
+        throw std::invalid_argument(
+            "data size of destinaton image descriptor is too small (" + std::to_string(requiredDataSize) +
+            " is required, but only " + std::to_string(imageDesc.dataSize) + " was specified)"
+        );
+    }
+}
+
+void ImageView::ReadPixels(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, std::size_t threadCount) const
+{
+    if (data_ && imageDesc.data && IsRegionInside(offset, extent))
+    {
+        /* Validate required size */
+        ValidateImageDataSize(extent, imageDesc);
+
+        if (IsCompressedFormat(GetFormat()))
+        {
+            /* Compressed images can only be read entirely, since their pixels are not addressable individually */
+            if (offset != Offset3D{ 0, 0, 0 } || extent != GetExtent())
+                throw std::invalid_argument("cannot read sub-region of image with compressed image format");
+            const DstImageDescriptor dstDesc { imageDesc.format, imageDesc.dataType, imageDesc.data, GetImageBufferSize(imageDesc.format, imageDesc.dataType, extent) };
+            if (!ConvertImageBuffer(GetSrcDesc(), dstDesc, extent, threadCount))
+                ::memcpy(imageDesc.data, data_, GetDataSize());
+            return;
+        }
+
+        /* Get source image parameters */
+        const auto  bpp             = GetBytesPerPixel();
+        const auto  srcRowStride    = GetRowStride();
+        const auto  srcDepthStride  = GetDepthStride();
+        const auto  srcOffset       = bpp * (static_cast<std::size_t>(offset.x) + (static_cast<std::size_t>(offset.y) + static_cast<std::size_t>(offset.z) * extent_.height) * extent_.width);
+        auto        src             = reinterpret_cast<const char*>(data_) + srcOffset;
+
+        if (GetFormat() == imageDesc.format && GetDataType() == imageDesc.dataType)
+        {
+            /* Get destination image parameters */
+            const auto  dstRowStride    = bpp * extent.width;
+            const auto  dstDepthStride  = dstRowStride * extent.height;
+            auto        dst             = reinterpret_cast<char*>(imageDesc.data);
+
+            /* Blit region into destination image */
+            BitBlit(
+                extent, static_cast<std::uint32_t>(bpp),
+                dst, dstRowStride, dstDepthStride,
+                src, srcRowStride, srcDepthStride,
+                threadCount
+            );
+        }
+        else if (extent.width == extent_.width && (extent.height == extent_.height || extent.depth == 1))
+        {
+            /* Convert region directly, since it is contiguous in the image buffer */
+            const SrcImageDescriptor srcDesc { GetFormat(), GetDataType(), src, GetImageBufferSize(GetFormat(), GetDataType(), extent) };
+            ConvertImageBuffer(srcDesc, imageDesc, extent, threadCount);
+        }
+        else
+        {
+            /* Copy region into temporary sub-image */
+            Image subImage { extent, GetFormat(), GetDataType() };
+
+            BitBlit(
+                extent, static_cast<std::uint32_t>(bpp),
+                reinterpret_cast<char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride(),
+                src, srcRowStride, srcDepthStride
+            );
+
+            /* Convert sub-image */
+            subImage.Convert(imageDesc.format, imageDesc.dataType, threadCount);
+
+            /* Copy sub-image into output data */
+            ::memcpy(imageDesc.data, subImage.GetData(), imageDesc.dataSize);
+        }
+    }
+}
+
+SrcImageDescriptor ImageView::GetSrcDesc() const
+{
+    SrcImageDescriptor imageDesc;
+    {
+        imageDesc.format    = GetFormat();
+        imageDesc.dataType  = GetDataType();
+        imageDesc.data      = GetData();
+        imageDesc.dataSize  = GetDataSize();
+    }
+    return imageDesc;
+}
+
+std::size_t ImageView::GetBytesPerPixel() const
+{
+    return (ImageFormatSize(format_) * DataTypeSize(dataType_));
+}
+
+std::size_t ImageView::GetRowStride() const
+{
+    return GetImageBufferSize(GetFormat(), GetDataType(), Extent3D{ GetExtent().width, 1, 1 });
+}
+
+std::size_t ImageView::GetDepthStride() const
+{
+    return GetImageBufferSize(GetFormat(), GetDataType(), Extent3D{ GetExtent().width, GetExtent().height, 1 });
+}
+
+std::size_t ImageView::GetNumPixels() const
+{
+    return (static_cast<std::size_t>(extent_.width) * extent_.height * extent_.depth);
+}
+
+std::size_t ImageView::GetDataSize() const
+{
+    return GetImageBufferSize(GetFormat(), GetDataType(), GetExtent());
+}
+
+static bool Is1DRegionValid(std::int32_t offset, std::uint32_t extent, std::uint32_t limit)
+{
+    return (offset >= 0 && static_cast<std::uint32_t>(offset) + extent <= limit);
+}
+
+bool ImageView::IsRegionInside(const Offset3D& offset, const Extent3D& extent) const
+{
+    return
+    (
+        Is1DRegionValid(offset.x, extent.width , extent_.width ) &&
+        Is1DRegionValid(offset.y, extent.height, extent_.height) &&
+        Is1DRegionValid(offset.z, extent.depth , extent_.depth )
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
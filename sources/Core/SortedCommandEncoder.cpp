@@ -0,0 +1,271 @@
+/*
+ * SortedCommandEncoder.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifdef LLGL_ENABLE_UTILITY
+
+#include <LLGL/SortedCommandEncoder.h>
+#include <LLGL/CommandBuffer.h>
+#include "WorkerPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal constants
+ */
+
+// Number of bits per radix sort pass (8 passes for 64-bit keys)
+static const std::uint32_t  g_radixBits     = 8;
+static const std::size_t    g_radixSize     = (1u << g_radixBits);
+static const std::uint32_t  g_numPasses     = 64 / g_radixBits;
+
+// Minimal number of draw packets per chunk, so that small batches are sorted on the calling thread only
+static const std::size_t    g_minChunkSize  = 4096;
+
+
+/*
+ * Internal functions
+ */
+
+// Runs the specified function for each chunk index in [0, numChunks), distributed among the worker threads.
+template <typename TFunc>
+static void ForEachChunk(std::size_t numChunks, const TFunc& func)
+{
+    if (numChunks < 2)
+        func(std::size_t(0));
+    else
+    {
+        WorkerPool::Get().ParallelFor(
+            numChunks, 1, numChunks,
+            [&func](std::size_t begin, std::size_t end)
+            {
+                for (auto chunk = begin; chunk < end; ++chunk)
+                    func(chunk);
+            }
+        );
+    }
+}
+
+
+/*
+ * SortedCommandEncoder class
+ */
+
+SortedCommandEncoder::SortedCommandEncoder(std::uint32_t threadCount) :
+    threadCount_ { threadCount }
+{
+}
+
+void SortedCommandEncoder::Reset()
+{
+    packets_.clear();
+    entries_.clear();
+    sorted_ = true;
+}
+
+void SortedCommandEncoder::Submit(const DrawPacket& packet)
+{
+    packets_.push_back(packet);
+    sorted_ = false;
+}
+
+void SortedCommandEncoder::Submit(std::size_t numPackets, const DrawPacket* packets)
+{
+    if (numPackets > 0)
+    {
+        packets_.insert(packets_.end(), packets, packets + numPackets);
+        sorted_ = false;
+    }
+}
+
+/*
+Stable LSD radix sort of the (key, index) pairs with one byte per pass.
+Each pass counts the digits per chunk, computes the output offset of each (digit, chunk) pair,
+and then scatters the entries of each chunk in parallel. Passes over bytes that are equal for all keys are skipped.
+*/
+void SortedCommandEncoder::Sort()
+{
+    if (sorted_)
+        return;
+
+    const auto numEntries = packets_.size();
+    if (numEntries > 0xFFFFFFFFu)
+        throw std::out_of_range("too many draw packets for sorted command encoder");
+
+    /* Initialize sort entries and determine which bits differ among the keys */
+    entries_.resize(numEntries);
+    entriesTemp_.resize(numEntries);
+
+    std::uint64_t diffBits = 0;
+    for (std::size_t i = 0; i < numEntries; ++i)
+    {
+        entries_[i] = { packets_[i].sortKey, static_cast<std::uint32_t>(i) };
+        diffBits |= (packets_[i].sortKey ^ packets_[0].sortKey);
+    }
+
+    /* Determine number of chunks, one per participating thread */
+    std::size_t numChunks = std::min(static_cast<std::size_t>(threadCount_), numEntries / g_minChunkSize);
+    if (numChunks >= 2)
+        numChunks = std::min(numChunks, WorkerPool::Get().GetNumWorkers() + 1);
+    else
+        numChunks = 1;
+
+    const auto chunkSize = (numEntries + numChunks - 1) / numChunks;
+
+    histograms_.resize(numChunks * g_radixSize);
+
+    SortEntry* src = entries_.data();
+    SortEntry* dst = entriesTemp_.data();
+
+    for (std::uint32_t pass = 0; pass < g_numPasses; ++pass)
+    {
+        const auto shift = pass * g_radixBits;
+        if (((diffBits >> shift) & (g_radixSize - 1)) == 0)
+            continue;
+
+        /* Count digits of each chunk */
+        ForEachChunk(
+            numChunks,
+            [&](std::size_t chunk)
+            {
+                auto histogram  = &histograms_[chunk * g_radixSize];
+                auto begin      = std::min(chunk * chunkSize, numEntries);
+                auto end        = std::min(begin + chunkSize, numEntries);
+
+                std::fill(histogram, histogram + g_radixSize, 0u);
+                for (auto i = begin; i < end; ++i)
+                    ++histogram[(src[i].key >> shift) & (g_radixSize - 1)];
+            }
+        );
+
+        /* Convert counters into output offsets: digits in ascending order, chunks in ascending order within each digit */
+        std::uint32_t offset = 0;
+        for (std::size_t digit = 0; digit < g_radixSize; ++digit)
+        {
+            for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+            {
+                auto& counter = histograms_[chunk * g_radixSize + digit];
+                auto count = counter;
+                counter = offset;
+                offset += count;
+            }
+        }
+
+        /* Scatter entries of each chunk to their output offsets */
+        ForEachChunk(
+            numChunks,
+            [&](std::size_t chunk)
+            {
+                auto offsets    = &histograms_[chunk * g_radixSize];
+                auto begin      = std::min(chunk * chunkSize, numEntries);
+                auto end        = std::min(begin + chunkSize, numEntries);
+
+                for (auto i = begin; i < end; ++i)
+                    dst[offsets[(src[i].key >> shift) & (g_radixSize - 1)]++] = src[i];
+            }
+        );
+
+        std::swap(src, dst);
+    }
+
+    /* Move result into primary entry list */
+    if (src != entries_.data())
+        entries_.swap(entriesTemp_);
+
+    sorted_ = true;
+}
+
+void SortedCommandEncoder::Encode(CommandBuffer& commandBuffer)
+{
+    Sort();
+
+    stats_ = SortedCommandEncoderStats{};
+
+    PipelineState*  boundPipelineState  = nullptr;
+    ResourceHeap*   boundResourceHeap   = nullptr;
+    std::uint32_t   boundFirstSet       = 0;
+    Buffer*         boundVertexBuffer   = nullptr;
+    Buffer*         boundIndexBuffer    = nullptr;
+
+    for (const auto& entry : entries_)
+    {
+        const auto& packet = packets_[entry.index];
+
+        /* Set pipeline state and invalidate resource heap, since the pipeline layout might have changed */
+        if (packet.pipelineState == nullptr)
+            throw std::invalid_argument("cannot encode draw packet without pipeline state");
+
+        if (packet.pipelineState != boundPipelineState)
+        {
+            commandBuffer.SetPipelineState(*packet.pipelineState);
+            boundPipelineState  = packet.pipelineState;
+            boundResourceHeap   = nullptr;
+            ++stats_.pipelineBindings;
+        }
+
+        /* Set resource heap */
+        if (packet.resourceHeap != nullptr && (packet.resourceHeap != boundResourceHeap || packet.firstSet != boundFirstSet))
+        {
+            commandBuffer.SetResourceHeap(*packet.resourceHeap, packet.firstSet);
+            boundResourceHeap   = packet.resourceHeap;
+            boundFirstSet       = packet.firstSet;
+            ++stats_.resourceHeapBindings;
+        }
+
+        /* Set vertex and index buffers */
+        if (packet.vertexBuffer != nullptr && packet.vertexBuffer != boundVertexBuffer)
+        {
+            commandBuffer.SetVertexBuffer(*packet.vertexBuffer);
+            boundVertexBuffer = packet.vertexBuffer;
+            ++stats_.vertexBufferBindings;
+        }
+
+        if (packet.indexBuffer != nullptr && packet.indexBuffer != boundIndexBuffer)
+        {
+            commandBuffer.SetIndexBuffer(*packet.indexBuffer);
+            boundIndexBuffer = packet.indexBuffer;
+            ++stats_.indexBufferBindings;
+        }
+
+        /* Encode draw command */
+        const bool instanced = (packet.numInstances != 1 || packet.firstInstance != 0);
+
+        if (packet.indexBuffer != nullptr)
+        {
+            if (!instanced)
+                commandBuffer.DrawIndexed(packet.numVertices, packet.firstVertex, packet.vertexOffset);
+            else if (packet.firstInstance == 0)
+                commandBuffer.DrawIndexedInstanced(packet.numVertices, packet.numInstances, packet.firstVertex, packet.vertexOffset);
+            else
+                commandBuffer.DrawIndexedInstanced(packet.numVertices, packet.numInstances, packet.firstVertex, packet.vertexOffset, packet.firstInstance);
+        }
+        else
+        {
+            if (!instanced)
+                commandBuffer.Draw(packet.numVertices, packet.firstVertex);
+            else if (packet.firstInstance == 0)
+                commandBuffer.DrawInstanced(packet.numVertices, packet.firstVertex, packet.numInstances);
+            else
+                commandBuffer.DrawInstanced(packet.numVertices, packet.firstVertex, packet.numInstances, packet.firstInstance);
+        }
+
+        ++stats_.drawCommands;
+    }
+}
+
+
+} // /namespace LLGL
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,301 @@
+/*
+ * WorkerPool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "WorkerPool.h"
+#include <LLGL/ThreadPool.h>
+#include <LLGL/Constants.h>
+#include <algorithm>
+#include <exception>
+
+
+namespace LLGL
+{
+
+
+// Number of chunks each participating thread gets on average, to balance uneven work loads.
+static const std::size_t g_chunksPerThread = 4;
+
+// Group of chunks for a single call to "ParallelFor". Stale references in the worker queues keep it alive until they are popped.
+struct WorkerPool::TaskGroup
+{
+    const RangeFunction*        func            = nullptr;
+    std::size_t                 count           = 0;
+    std::size_t                 chunkSize       = 0;
+    std::size_t                 numChunks       = 0;
+    std::atomic<std::size_t>    nextChunk       { 0 };
+    std::atomic<std::size_t>    finishedChunks  { 0 };
+    std::mutex                  mutex;
+    std::condition_variable     finished;
+    std::exception_ptr          exception;
+
+    // Processes chunks of this group until no chunk is left.
+    void Run()
+    {
+        while (true)
+        {
+            const auto chunk = nextChunk.fetch_add(1);
+            if (chunk >= numChunks)
+                break;
+
+            const auto begin    = chunk * chunkSize;
+            const auto end      = std::min(begin + chunkSize, count);
+
+            try
+            {
+                (*func)(begin, end);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard { mutex };
+                if (!exception)
+                    exception = std::current_exception();
+            }
+
+            if (finishedChunks.fetch_add(1) + 1 == numChunks)
+            {
+                std::lock_guard<std::mutex> guard { mutex };
+                finished.notify_all();
+            }
+        }
+    }
+
+    // Blocks until all chunks have been processed.
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock { mutex };
+        finished.wait(lock, [this]() { return (finishedChunks.load() == numChunks); });
+    }
+};
+
+WorkerPool::~WorkerPool()
+{
+    /* Only a fallback: the workers are usually stopped by "Shutdown" before static objects are destroyed */
+    StopWorkers();
+}
+
+WorkerPool& WorkerPool::Get()
+{
+    static WorkerPool instance;
+    return instance;
+}
+
+void WorkerPool::Resize(std::size_t numWorkers)
+{
+    std::lock_guard<std::mutex> guard { poolMutex_ };
+    StopWorkers();
+    numWorkersCfg_ = numWorkers;
+    StartWorkers(numWorkers);
+}
+
+std::size_t WorkerPool::GetNumWorkers()
+{
+    std::lock_guard<std::mutex> guard { poolMutex_ };
+    if (!started_)
+        StartWorkers(numWorkersCfg_);
+    return workers_.size();
+}
+
+void WorkerPool::Shutdown()
+{
+    std::lock_guard<std::mutex> guard { poolMutex_ };
+    StopWorkers();
+}
+
+void WorkerPool::ParallelFor(std::size_t count, std::size_t minWorkSize, std::size_t threadCount, const RangeFunction& func)
+{
+    if (count == 0)
+        return;
+
+    /* Limit number of threads so that each thread gets at least 'minWorkSize' items */
+    minWorkSize = std::max(minWorkSize, std::size_t(1));
+    threadCount = std::min(threadCount, count / minWorkSize);
+
+    if (threadCount < 2)
+    {
+        /* Run entire range on calling thread */
+        func(0, count);
+        return;
+    }
+
+    auto group = std::make_shared<TaskGroup>();
+    std::size_t numHelpers = 0;
+
+    /* Distribute the group among the queues of the helping workers */
+    {
+        std::lock_guard<std::mutex> guard { poolMutex_ };
+
+        if (!started_)
+            StartWorkers(numWorkersCfg_);
+
+        const auto numQueues = queues_.size();
+        numHelpers = std::min(numQueues, threadCount - 1);
+
+        if (numHelpers > 0)
+        {
+            /* Determine chunk size so that each thread gets a few chunks */
+            const auto numThreads = numHelpers + 1;
+            group->func         = &func;
+            group->count        = count;
+            group->chunkSize    = std::max(minWorkSize, (count + numThreads * g_chunksPerThread - 1) / (numThreads * g_chunksPerThread));
+            group->numChunks    = (count + group->chunkSize - 1) / group->chunkSize;
+
+            for (std::size_t i = 0; i < numHelpers; ++i)
+            {
+                auto& queue = *queues_[(nextQueue_ + i) % numQueues];
+                std::lock_guard<std::mutex> queueGuard { queue.mutex };
+                queue.tasks.push_back(group);
+            }
+            nextQueue_ = (nextQueue_ + numHelpers) % numQueues;
+
+            std::lock_guard<std::mutex> wakeGuard { wakeMutex_ };
+            numPendingTasks_ += numHelpers;
+        }
+    }
+
+    if (numHelpers == 0)
+    {
+        /* Pool has no workers, so run entire range on calling thread */
+        func(0, count);
+        return;
+    }
+
+    wakeCondition_.notify_all();
+
+    /* Process chunks on the calling thread as well, then wait for the chunks the workers have taken */
+    group->Run();
+    group->Wait();
+
+    if (group->exception)
+        std::rethrow_exception(group->exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void WorkerPool::StartWorkers(std::size_t numWorkers)
+{
+    if (numWorkers >= Constants::maxThreadCount)
+    {
+        /* Use one worker per hardware thread, except for the thread that submits the work */
+        const auto hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+        numWorkers = (hardwareThreads > 1 ? hardwareThreads - 1 : 0);
+    }
+
+    quit_ = false;
+
+    queues_.reserve(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i)
+        queues_.emplace_back(new WorkQueue());
+
+    workers_.reserve(numWorkers);
+    for (std::size_t i = 0; i < numWorkers; ++i)
+        workers_.emplace_back(&WorkerPool::WorkerMain, this, i);
+
+    started_ = true;
+}
+
+void WorkerPool::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> guard { wakeMutex_ };
+        quit_ = true;
+    }
+    wakeCondition_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+
+    /*
+    Remaining tasks can be dropped, because every caller of "ParallelFor"
+    processes all chunks on its own that have not been taken by a worker.
+    */
+    workers_.clear();
+    queues_.clear();
+    numPendingTasks_    = 0;
+    nextQueue_          = 0;
+    started_            = false;
+}
+
+void WorkerPool::WorkerMain(std::size_t workerIndex)
+{
+    while (true)
+    {
+        std::shared_ptr<TaskGroup> task;
+        if (PopTask(workerIndex, task))
+        {
+            task->Run();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock { wakeMutex_ };
+        wakeCondition_.wait(lock, [this]() { return (quit_ || numPendingTasks_.load() > 0); });
+
+        if (quit_)
+            break;
+    }
+}
+
+bool WorkerPool::PopTask(std::size_t workerIndex, std::shared_ptr<TaskGroup>& task)
+{
+    const auto numQueues = queues_.size();
+
+    /* Pop latest task from own queue first */
+    {
+        auto& queue = *queues_[workerIndex];
+        std::lock_guard<std::mutex> guard { queue.mutex };
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            --numPendingTasks_;
+            return true;
+        }
+    }
+
+    /* Steal oldest task from the other queues */
+    for (std::size_t i = 1; i < numQueues; ++i)
+    {
+        auto& queue = *queues_[(workerIndex + i) % numQueues];
+        std::lock_guard<std::mutex> guard { queue.mutex };
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            --numPendingTasks_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/* ----- Public functions ----- */
+
+LLGL_EXPORT void SetThreadPoolSize(std::size_t numWorkers)
+{
+    WorkerPool::Get().Resize(numWorkers);
+}
+
+LLGL_EXPORT std::size_t GetThreadPoolSize()
+{
+    return WorkerPool::Get().GetNumWorkers();
+}
+
+LLGL_EXPORT void ShutdownThreadPool()
+{
+    WorkerPool::Get().Shutdown();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,115 @@
+/*
+ * WorkerPool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_WORKER_POOL_H
+#define LLGL_WORKER_POOL_H
+
+
+#include <LLGL/Constants.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Library-wide pool of persistent worker threads.
+Each worker has its own queue of tasks and steals tasks from the other queues when its own queue runs empty.
+The worker threads are created on first use, so the pool has no cost for applications that never use it.
+The threads are stopped explicitly by "Shutdown" when the last render system is unloaded (or by "ShutdownThreadPool"),
+because joining threads in the destructor of a static object is not reliable during process exit or module unload.
+*/
+class WorkerPool
+{
+
+    public:
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator = (const WorkerPool&) = delete;
+
+        // Function signature for a range of work items [begin, end).
+        using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+    public:
+
+        ~WorkerPool();
+
+        // Returns the library-wide instance of the thread pool.
+        static WorkerPool& Get();
+
+        // Stops all worker threads and starts the specified number of new ones. 'Constants::maxThreadCount' selects one worker per hardware thread, minus the caller.
+        void Resize(std::size_t numWorkers);
+
+        // Returns the number of worker threads (starts the configured number of workers if the pool has not been used yet).
+        std::size_t GetNumWorkers();
+
+        // Stops and joins all worker threads. The pool starts the configured number of workers again on next use.
+        void Shutdown();
+
+        /*
+        Splits the range [0, count) into chunks of at least 'minWorkSize' items and runs 'func' for each chunk.
+        At most 'threadCount' threads work on the chunks, including the calling thread, which also processes chunks.
+        Returns when all chunks have been processed and rethrows the first exception a chunk has thrown.
+        */
+        void ParallelFor(std::size_t count, std::size_t minWorkSize, std::size_t threadCount, const RangeFunction& func);
+
+    private:
+
+        struct TaskGroup;
+
+        // Task queue of a single worker thread. The owner pops from the back, other workers steal from the front.
+        struct WorkQueue
+        {
+            std::mutex                              mutex;
+            std::deque<std::shared_ptr<TaskGroup>>  tasks;
+        };
+
+    private:
+
+        WorkerPool() = default;
+
+        void StartWorkers(std::size_t numWorkers);
+        void StopWorkers();
+
+        void WorkerMain(std::size_t workerIndex);
+        bool PopTask(std::size_t workerIndex, std::shared_ptr<TaskGroup>& task);
+
+    private:
+
+        std::mutex                              poolMutex_;
+        bool                                    started_        = false;
+        std::size_t                             numWorkersCfg_  = Constants::maxThreadCount;
+        std::size_t                             nextQueue_      = 0;
+
+        std::vector<std::thread>                workers_;
+        std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+        std::mutex                              wakeMutex_;
+        std::condition_variable                 wakeCondition_;
+        std::atomic<std::size_t>                numPendingTasks_ { 0 };
+        bool                                    quit_           = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,7 +7,9 @@
 
 #include "AMD64Assembler.h"
 #include "AMD64Opcode.h"
-#include <limits.h>
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <string.h>
 
 #include <fstream>//!!!
 #include <iomanip>
@@ -33,11 +35,18 @@ see https://en.wikipedia.org/wiki/X86_calling_conventions#List_of_x86_calling_co
 
 /*
 Microsoft x64 calling convention (Windows)
-Preserved for caller: ???
+Preserved for caller: RBX, RBP, RDI, RSI, RSP, R12-R15, XMM6-XMM15
+The caller must reserve 32 bytes of shadow space above the stack arguments.
 */
-static const Reg g_amd64IntParams[] = { Reg::RCX, Reg::RDX, Reg::R8, Reg::R9 };
-static const Reg g_amd64FltParams[] = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3 };
-static const Reg g_amd64TempReg     = Reg::RAX;
+static const Reg g_amd64IntParams[]         = { Reg::RCX, Reg::RDX, Reg::R8, Reg::R9 };
+static const Reg g_amd64FltParams[]         = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3 };
+static const Reg g_amd64CalleeSavedRegs[]   = { Reg::RBX, Reg::RSI, Reg::RDI, Reg::R12, Reg::R13, Reg::R14, Reg::R15,
+                                                Reg::XMM6, Reg::XMM7, Reg::XMM8, Reg::XMM9, Reg::XMM10, Reg::XMM11,
+                                                Reg::XMM12, Reg::XMM13, Reg::XMM14, Reg::XMM15 };
+static const Reg g_amd64VarArgRegs[]        = { Reg::RBX, Reg::RSI, Reg::RDI, Reg::R12, Reg::R13, Reg::R14, Reg::R15 };
+static const Reg g_amd64TempReg             = Reg::RAX;
+static const Reg g_amd64TempFltReg          = Reg::XMM4;
+static const std::uint32_t g_amd64ShadowSpace = 32;
 
 #else
 
@@ -45,14 +54,22 @@ static const Reg g_amd64TempReg     = Reg::RAX;
 System V AMD64 ABI (Solaris, Linux, BSD, macOS)
 Preserved for caller: RBP, RBX, R12-R15
 */
-static const Reg g_amd64IntParams[] = { Reg::RDI, Reg::RSI, Reg::RDX, Reg::RCX, Reg::R8, Reg::R9 };
-static const Reg g_amd64FltParams[] = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3, Reg::XMM4, Reg::XMM5, Reg::XMM6, Reg::XMM7 };
-static const Reg g_amd64TempReg     = Reg::RAX;
+static const Reg g_amd64IntParams[]         = { Reg::RDI, Reg::RSI, Reg::RDX, Reg::RCX, Reg::R8, Reg::R9 };
+static const Reg g_amd64FltParams[]         = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3, Reg::XMM4, Reg::XMM5, Reg::XMM6, Reg::XMM7 };
+static const Reg g_amd64CalleeSavedRegs[]   = { Reg::RBX, Reg::R12, Reg::R13, Reg::R14, Reg::R15 };
+static const Reg g_amd64VarArgRegs[]        = { Reg::RBX, Reg::R12, Reg::R13, Reg::R14, Reg::R15 };
+static const Reg g_amd64TempReg             = Reg::RAX;
+static const Reg g_amd64TempFltReg          = Reg::XMM8;
+static const std::uint32_t g_amd64ShadowSpace = 0;
 
 #endif
 
-static const std::size_t g_amd64IntParamsCount = sizeof(g_amd64IntParams)/sizeof(g_amd64IntParams[0]);
-static const std::size_t g_amd64FltParamsCount = sizeof(g_amd64FltParams)/sizeof(g_amd64FltParams[0]);
+static const std::size_t g_amd64IntParamsCount  = sizeof(g_amd64IntParams)/sizeof(g_amd64IntParams[0]);
+static const std::size_t g_amd64FltParamsCount  = sizeof(g_amd64FltParams)/sizeof(g_amd64FltParams[0]);
+static const std::size_t g_amd64VarArgRegsCount = sizeof(g_amd64VarArgRegs)/sizeof(g_amd64VarArgRegs[0]);
+
+// SIB byte for [RSP] and [R12] without index register: scale = 00, index = 100 (none), base = 100
+static const std::uint8_t g_amd64SIBNoIndex = 0x24;
 
 
 /*
@@ -66,6 +83,42 @@ static std::uint8_t GetArgSize(const ArgType t)
     return sizes[static_cast<std::uint8_t>(t)];
 }
 
+// Counter of parameter registers that have already been assigned to arguments.
+struct ParamRegCounter
+{
+    std::size_t numIntRegs = 0;
+    std::size_t numFltRegs = 0;
+};
+
+// Returns the register for the next argument, or RSP if the argument must be passed on the stack.
+static Reg NextParamReg(bool isFloat, ParamRegCounter& counter)
+{
+    #ifdef _WIN32
+
+    /* Each argument occupies one parameter slot, regardless of its type */
+    const auto slot = counter.numIntRegs++;
+    if (slot < g_amd64IntParamsCount)
+        return (isFloat ? g_amd64FltParams[slot] : g_amd64IntParams[slot]);
+
+    #else
+
+    /* Integral and floating-point arguments are assigned to their registers independently */
+    if (isFloat)
+    {
+        if (counter.numFltRegs < g_amd64FltParamsCount)
+            return g_amd64FltParams[counter.numFltRegs++];
+    }
+    else
+    {
+        if (counter.numIntRegs < g_amd64IntParamsCount)
+            return g_amd64IntParams[counter.numIntRegs++];
+    }
+
+    #endif
+
+    return Reg::RSP;
+}
+
 
 /*
  * AMD64Assembler class
@@ -82,19 +135,43 @@ void AMD64Assembler::Begin()
     #endif
 
     /* Reset data about local stack */
-    localStackSize_ = 128;//0;
-    paramStackSize_ = 0;
-
-    /* Write entry point prologue */
-    WritePrologue();
+    localStackSize_ = 0;
+    argStackSize_   = 0;
+    frameSize_      = 0;
+    usedRegs_       = 0;
+
+    supplements_.clear();
+    varArgs_.clear();
+    stackChunkOffsets_.clear();
+    savedRegs_.clear();
+
+    /*
+    Store entry point parameters; the prologue is inserted in front of the program at the end,
+    because the stack frame size and the registers to preserve are only known after all function calls have been encoded
+    */
     WriteStackFrame(GetEntryVarArgs(), GetStackAllocs());
 }
 
 void AMD64Assembler::End()
 {
-    /* Pop local stack */
-    if (localStackSize_ > 0)
-        AddImm32(Reg::RSP, localStackSize_);
+    /* Take program body out of the assembly to insert the prologue in front of it */
+    std::vector<std::uint8_t> body;
+    body.swap(GetAssembly());
+
+    DetermineSavedRegs();
+    WritePrologue();
+
+    /* Append program body and move supplement offsets behind the prologue */
+    auto& code = GetAssembly();
+    const auto prologueSize = code.size();
+
+    code.insert(code.end(), body.begin(), body.end());
+
+    for (auto& supp : supplements_)
+    {
+        supp.rip        += prologueSize;
+        supp.dstOffset  += prologueSize;
+    }
 
     /* Write entry point epilogue and append supplement at the end of program */
     WriteEpilogue();
@@ -110,132 +187,33 @@ void AMD64Assembler::End()
     #endif // /TEST
 }
 
-void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farCall)
+void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv /*conv*/, bool /*farCall*/)
 {
-    const auto& args = GetArgs();
+    ParamRegCounter counter;
+    std::uint32_t   stackOffset = g_amd64ShadowSpace;
 
-    /* Move first couple of arguments into registers */
-    std::size_t numIntRegs = 0, numFltRegs = 0;
-    std::size_t lastInt, lastFlt;
-    std::size_t num = args.size();
-
-    lastInt = lastFlt = std::numeric_limits<std::size_t>::max();
-
-    for (std::size_t i = 0; i < num; ++i)
+    for (const auto& arg : GetArgs())
     {
-        const auto& arg = args[i];
-
         /* Determine destination register for argument */
-        Reg dstReg = g_amd64TempReg;
-        bool isFloat = IsFloat(arg.type);
+        auto dstReg = NextParamReg(IsFloat(arg.type), counter);
 
-        if (isFloat && numFltRegs < g_amd64FltParamsCount)
+        if (dstReg != Reg::RSP)
         {
-            dstReg  = g_amd64FltParams[numFltRegs++];
-            lastFlt = i;
-        }
-        else if (!isFloat && numIntRegs < g_amd64IntParamsCount)
-        {
-            dstReg  = g_amd64IntParams[numIntRegs++];
-            lastInt = i;
+            /* Move argument into parameter register */
+            LoadArg(dstReg, arg);
         }
         else
-            break;
-
-        if (arg.param < 0xF)
-        {
-            if (arg.param < varArgDisp_.size())
-            {
-                /* Move parameter from local stack into destination register */
-                if (IsFltReg(dstReg))
-                    MovDQURegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
-                else
-                    MovRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
-            }
-        }
-        else if (dstReg >= Reg::R8 && dstReg <= Reg::R15)
         {
-            /* R8-R15 registers are only supported for 64-bit operand size */
-            MovRegImm64(dstReg, arg.value.i64);
-        }
-        else
-        {
-            /* Move value into destination register */
-            switch (arg.type)
-            {
-                case ArgType::Byte:
-                    MovRegImm32(dstReg, arg.value.i8);
-                    break;
-                case ArgType::Word:
-                    MovRegImm32(dstReg, arg.value.i16);
-                    break;
-                case ArgType::DWord:
-                    MovRegImm32(dstReg, arg.value.i32);
-                    break;
-                case ArgType::QWord:
-                    MovRegImm64(dstReg, arg.value.i64);
-                    break;
-                case ArgType::Ptr:
-                    MovRegImm64(dstReg, arg.value.i64);
-                    break;
-                case ArgType::StackPtr:
-                    MovReg(dstReg, Reg::RBP);
-                    SubImm32(dstReg, stackChunkOffsets_[arg.value.i8]);
-                    break;
-                case ArgType::Float:
-                    MovSSRegImm32(dstReg, arg.value.f32);
-                    break;
-                case ArgType::Double:
-                    MovSDRegImm64(dstReg, arg.value.f64);
-                    break;
-            }
+            /* Store argument in outgoing argument area, first argument at the lowest address */
+            StoreArg(static_cast<std::int32_t>(stackOffset), arg);
+            stackOffset += 8;
         }
     }
 
-    /* Push remaining arguments onto stack */
-    Displacement stackDisp;
-
-    for (std::size_t i = 0; i < num; ++i)
-    {
-        auto iRev = num - i - 1u;
-        const auto& arg = args[iRev];
-
-        /* Check if argument has already been moved into a register */
-        bool isFloat = IsFloat(arg.type);
-
-        if ( (  isFloat && iRev == lastFlt ) ||
-             ( !isFloat && iRev == lastInt ) )
-        {
-            break;
-        }
+    /* Outgoing argument area is allocated once by the prologue for all function calls */
+    argStackSize_ = std::max(argStackSize_, stackOffset);
 
-        /* Push argument onto stack */
-        switch (arg.type)
-        {
-            case ArgType::Byte:
-            case ArgType::Word:
-            case ArgType::DWord:
-            case ArgType::Float:
-                MovMemImm32(Reg::RSP, arg.value.i32, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-            case ArgType::QWord:
-            case ArgType::Ptr:
-            case ArgType::Double:
-                MovRegImm64(g_amd64TempReg, arg.value.i64);
-                MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-            case ArgType::StackPtr:
-                MovReg(g_amd64TempReg, Reg::RBP);
-                SubImm32(g_amd64TempReg, stackChunkOffsets_[arg.value.i8]);
-                MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-        }
-    }
-
-    /* Write 'call' instruction */
+    /* Write 'call' instruction (temporary register is never used for parameters) */
     MovRegImm64(g_amd64TempReg, reinterpret_cast<std::uint64_t>(addr));
     CallNear(g_amd64TempReg);
 }
@@ -250,169 +228,300 @@ bool AMD64Assembler::IsLittleEndian() const
     return true;
 }
 
-std::uint8_t AMD64Assembler::DispMod(const Displacement& disp) const
-{
-    if (disp.disp32 != 0)
-    {
-        if (disp.has32Bits)
-            return Operand_Mod10; // disp32
-        else
-            return Operand_Mod01; // disp8
-    }
-    return 0;
-}
-
-std::uint8_t AMD64Assembler::ModRM(std::uint8_t mode, Reg r0, Reg r1) const
-{
-    std::uint8_t modRM = (mode | (RegByte(r0) << 3));
-
-    if (r1 == Reg::RSP)
-        modRM |= Operand_SIB;
-    else
-        modRM |= RegByte(r1);
-
-    return modRM;
-}
-
+/*
+Stack frame layout:
+    [RBP + 16 ...]                  Stack parameters of entry point (Win64: after 32 bytes of shadow space)
+    [RBP + 8]                       Return address
+    [RBP]                           Previous RBP
+    [RBP - localStackSize_ ...]     Entry point parameters and stack allocations
+    [RBP - ... ]                    Preserved callee-saved registers
+    [RSP ...]                       Outgoing arguments of function calls (Win64: after 32 bytes of shadow space)
+*/
 void AMD64Assembler::WritePrologue()
 {
     /* Store base stack pointer (RBP) */
     PushReg(Reg::RBP);
     MovReg(Reg::RBP, Reg::RSP);
 
-    #if 1
-    /* Store general purpose registers */
-    //TODO: determine which registers must be stored
-    PushReg(Reg::RBX);
-    #endif
+    /* Allocate stack frame; RSP remains 16-byte aligned for all function calls */
+    if (frameSize_ > 0)
+        SubImm32(Reg::RSP, frameSize_);
+
+    /* Store callee-saved registers that are used by the program */
+    for (const auto& saved : savedRegs_)
+    {
+        if (IsFltReg(saved.reg))
+            MovDQUMemReg(Reg::RBP, saved.reg, saved.disp);
+        else
+            MovMemReg(Reg::RBP, saved.reg, saved.disp);
+    }
 }
 
 void AMD64Assembler::WriteEpilogue()
 {
-    #if 1
-    /* Restore general purpose registers */
-    //TODO: determine which registers must be restored
-    PopReg(Reg::RBX);
-    #endif
+    /* Restore callee-saved registers */
+    for (const auto& saved : savedRegs_)
+    {
+        if (IsFltReg(saved.reg))
+            MovDQURegMem(saved.reg, Reg::RBP, saved.disp);
+        else
+            MovRegMem(saved.reg, Reg::RBP, saved.disp);
+    }
 
-    /* Restore base stack pointer (RBP) */
+    /* Release stack frame and restore base stack pointer (RBP); the caller pops its own stack arguments */
+    MovReg(Reg::RSP, Reg::RBP);
     PopReg(Reg::RBP);
-    RetNear(paramStackSize_);
+    RetNear();
 }
 
 void AMD64Assembler::WriteStackFrame(
     const std::vector<JIT::ArgType>&    varArgTypes,
     const std::vector<std::uint32_t>&   stackChunks)
 {
-    /* Determine required stack size for variadic arguments */
-    std::uint32_t varArgSize = 0;
-    for (auto type : varArgTypes)
-        varArgSize += (IsFloat(type) ? 16 : 8);
-
-    /* Determine required stack size for allocations */
-    std::uint32_t stackChunksSize = 0;
-    for (auto chunk : stackChunks)
-        stackChunksSize += chunk;
-
-    /* Allocate local stack */
-    localStackSize_ += varArgSize;
-
-    std::uint32_t chunkStackOffset = localStackSize_ + 8;
-
-    localStackSize_ += stackChunksSize;
+    ParamRegCounter counter;
+    std::size_t     numVarArgRegs       = 0;
+    std::int32_t    paramStackOffset    = 16 + static_cast<std::int32_t>(g_amd64ShadowSpace); // first stack parameter after return address and RBP
 
-    if (localStackSize_ > 0)
-        SubImm32(Reg::RSP, localStackSize_);
-
-    /* Store parameters in local stack */
-    std::size_t numIntRegs = 0, numFltRegs = 0;
-    std::int8_t paramStackOffset = 16; // first parameter at [EBP+16]
-    std::int8_t localStackOffset = -16; // local variables after preserved EBX
+    varArgs_.reserve(varArgTypes.size());
 
     for (auto type : varArgTypes)
     {
-        bool isFloat = IsFloat(type);
-        Reg srcReg = g_amd64TempReg;
+        const bool isFloat = IsFloat(type);
 
-        if (isFloat && numFltRegs < g_amd64FltParamsCount)
-        {
-            /* Get parameter from floating-point register */
-            srcReg = g_amd64FltParams[numFltRegs++];
-        }
-        else if (!isFloat && numIntRegs < g_amd64IntParamsCount)
+        /* Determine register of parameter */
+        auto srcReg = NextParamReg(isFloat, counter);
+        if (srcReg == Reg::RSP)
         {
-            /* Get parameter from integer register */
-            srcReg = g_amd64IntParams[numIntRegs++];
+            /* Load parameter from stack of the caller */
+            if (type == ArgType::Float)
+            {
+                srcReg = g_amd64TempFltReg;
+                CvtSD2SSRegMem(srcReg, Reg::RBP, paramStackOffset);
+            }
+            else
+            {
+                srcReg = g_amd64TempReg;
+                MovRegMem(srcReg, Reg::RBP, paramStackOffset);
+            }
+            paramStackOffset += 8;
         }
-        else
+        else if (type == ArgType::Float)
         {
-            /* Load parameter from stack */
-            MovRegMem(srcReg, Reg::RBP, Disp8{ paramStackOffset });
-            paramStackOffset += 8;
-            paramStackSize_ += 8;
+            /* Entry point is variadic, so single-precision parameters have been promoted to double-precision */
+            CvtSD2SSReg(srcReg, srcReg);
         }
 
-        /* Store parameter in local stack */
-        if (IsFltReg(srcReg))
+        VarArgLocation location;
+
+        if (!isFloat && numVarArgRegs < g_amd64VarArgRegsCount)
         {
-            localStackOffset -= 16; // SSE2 register size of 128 bits
-            MovDQUMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
+            /* Keep integral parameter in a callee-saved register, so it survives all function calls */
+            location.reg    = g_amd64VarArgRegs[numVarArgRegs++];
+            location.disp   = 0;
+            MovReg(location.reg, srcReg);
         }
         else
         {
-            localStackOffset -= 8; // x64 register size of 64 bits
-            MovMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
+            /* Store parameter in local stack (floating-point parameters with the full SSE2 register size of 128 bits) */
+            localStackSize_ += (isFloat ? 16 : 8);
+            location.reg    = Reg::RBP;
+            location.disp   = -static_cast<std::int32_t>(localStackSize_);
+
+            if (IsFltReg(srcReg))
+                MovDQUMemReg(Reg::RBP, srcReg, location.disp);
+            else
+                MovMemReg(Reg::RBP, srcReg, location.disp);
         }
 
-        /* Store parameter offset within stack frame */
-        varArgDisp_.push_back(Disp8{ localStackOffset });
+        varArgs_.push_back(location);
     }
 
-    /* Determine stack base for arguments of subsequent calls */
-    argStackBase_.disp8 = localStackOffset;
-
-    /* Determine stack base for allocated stack chunks */
+    /* Determine base pointer displacements of 16-byte aligned stack allocations */
     stackChunkOffsets_.reserve(stackChunks.size());
     for (auto chunk : stackChunks)
     {
-        chunkStackOffset += static_cast<std::int32_t>(chunk);
-        stackChunkOffsets_.push_back(chunkStackOffset);
+        localStackSize_ = GetAlignedSize(localStackSize_ + chunk, 16u);
+        stackChunkOffsets_.push_back(-static_cast<std::int32_t>(localStackSize_));
     }
 }
 
-void AMD64Assembler::WriteOptREX(Reg reg, bool defaultsTo64Bit)
+void AMD64Assembler::DetermineSavedRegs()
 {
-    std::uint8_t prefix = 0;
+    /* Store each callee-saved register below the local stack, if it is written by the program */
+    std::uint32_t savedRegsSize = 0;
 
-    if (Is64Reg(reg))
+    for (auto reg : g_amd64CalleeSavedRegs)
     {
-        if (!defaultsTo64Bit || reg >= Reg::R8)
+        if (IsRegUsed(reg))
         {
-            prefix |= REX_W;
-            if (reg >= Reg::R8)
-                prefix |= REX_B;
+            savedRegsSize += (IsFltReg(reg) ? 16 : 8);
+            savedRegs_.push_back({ reg, -static_cast<std::int32_t>(localStackSize_ + savedRegsSize) });
         }
     }
 
+    /* Determine final stack frame size; RSP is 16-byte aligned after RBP has been pushed */
+    frameSize_ = GetAlignedSize(localStackSize_ + savedRegsSize + argStackSize_, 16u);
+}
+
+void AMD64Assembler::LoadArg(Reg dstReg, const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        if (arg.param < varArgs_.size())
+        {
+            /* Move entry point parameter into destination register */
+            const auto& location = varArgs_[arg.param];
+            if (location.reg != Reg::RBP)
+                MovReg(dstReg, location.reg);
+            else if (IsFltReg(dstReg))
+                MovDQURegMem(dstReg, Reg::RBP, location.disp);
+            else
+                MovRegMem(dstReg, Reg::RBP, location.disp);
+        }
+    }
+    else
+    {
+        /* Move value into destination register */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+                MovRegImm32(dstReg, arg.value.i8);
+                break;
+            case ArgType::Word:
+                MovRegImm32(dstReg, arg.value.i16);
+                break;
+            case ArgType::DWord:
+                MovRegImm32(dstReg, arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+                MovRegImm64(dstReg, arg.value.i64);
+                break;
+            case ArgType::StackPtr:
+                LeaRegMem(dstReg, Reg::RBP, stackChunkOffsets_[arg.value.i8]);
+                break;
+            case ArgType::Float:
+                MovSSRegImm32(dstReg, arg.value.f32);
+                break;
+            case ArgType::Double:
+                MovSDRegImm64(dstReg, arg.value.f64);
+                break;
+        }
+    }
+}
+
+void AMD64Assembler::StoreArg(std::int32_t dstOffset, const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        if (arg.param < varArgs_.size())
+        {
+            /* Copy entry point parameter onto stack (only the lower 64 bits of floating-point parameters) */
+            const auto& location = varArgs_[arg.param];
+            if (location.reg != Reg::RBP)
+                MovMemReg(Reg::RSP, location.reg, dstOffset);
+            else
+            {
+                MovRegMem(g_amd64TempReg, Reg::RBP, location.disp);
+                MovMemReg(Reg::RSP, g_amd64TempReg, dstOffset);
+            }
+        }
+    }
+    else
+    {
+        /* Store value onto stack; each argument occupies 8 bytes */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+            case ArgType::Word:
+            case ArgType::DWord:
+            case ArgType::Float:
+                MovMemImm32(Reg::RSP, arg.value.i32, dstOffset);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+            case ArgType::Double:
+                MovRegImm64(g_amd64TempReg, arg.value.i64);
+                MovMemReg(Reg::RSP, g_amd64TempReg, dstOffset);
+                break;
+            case ArgType::StackPtr:
+                LeaRegMem(g_amd64TempReg, Reg::RBP, stackChunkOffsets_[arg.value.i8]);
+                MovMemReg(Reg::RSP, g_amd64TempReg, dstOffset);
+                break;
+        }
+    }
+}
+
+void AMD64Assembler::UseReg(Reg reg)
+{
+    usedRegs_ |= (1ull << static_cast<unsigned>(GetReg64(reg)));
+}
+
+bool AMD64Assembler::IsRegUsed(Reg reg) const
+{
+    return ((usedRegs_ & (1ull << static_cast<unsigned>(GetReg64(reg)))) != 0);
+}
+
+// Writes the REX prefix for an instruction whose only register operand is encoded in the ModR/M <r/m> field or the opcode.
+void AMD64Assembler::WriteOptREX(bool w64, Reg rm)
+{
+    WriteOptREX(w64, Reg::EAX, rm);
+}
+
+// Writes the REX prefix for an instruction with the specified ModR/M <reg> and <r/m> operands.
+void AMD64Assembler::WriteOptREX(bool w64, Reg reg, Reg rm)
+{
+    std::uint8_t prefix = 0;
+
+    if (w64)
+        prefix |= REX_W;
+    if (IsExtReg(reg))
+        prefix |= REX_R;
+    if (IsExtReg(rm))
+        prefix |= REX_B;
+
     if (prefix != 0)
         WriteByte(REX_Prefix | prefix);
 }
 
-void AMD64Assembler::WriteOptDisp(const Displacement& disp)
+// Writes the ModR/M byte for direct register addressing.
+void AMD64Assembler::WriteModRMReg(std::uint8_t regBits, Reg rm)
 {
-    if (disp.disp32 != 0)
+    WriteByte(Operand_Mod11 | ((regBits & 0x07) << 3) | RegByte(rm));
+}
+
+// Writes the ModR/M byte, optional SIB byte, and optional displacement for memory addressing [baseReg + disp].
+void AMD64Assembler::WriteModRMMem(std::uint8_t regBits, Reg baseReg, std::int32_t disp)
+{
+    const auto base = RegByte(baseReg);
+
+    /* Determine displacement size; [RBP] and [R13] can only be encoded with a displacement */
+    std::uint8_t mod = 0;
+    if (disp != 0 || base == RegByte(Reg::RBP))
+        mod = (disp >= -128 && disp <= 127 ? Operand_Mod01 : Operand_Mod10);
+
+    /* [RSP] and [R12] can only be encoded with a SIB byte */
+    if (base == RegByte(Reg::RSP))
     {
-        if (disp.has32Bits)
-            WriteDWord(static_cast<std::uint32_t>(disp.disp32));
-        else
-            WriteByte(static_cast<std::uint8_t>(disp.disp8));
+        WriteByte(mod | ((regBits & 0x07) << 3) | Operand_SIB);
+        WriteByte(g_amd64SIBNoIndex);
     }
+    else
+        WriteByte(mod | ((regBits & 0x07) << 3) | base);
+
+    if (mod == Operand_Mod01)
+        WriteByte(static_cast<std::uint8_t>(static_cast<std::int8_t>(disp)));
+    else if (mod == Operand_Mod10)
+        WriteDWord(static_cast<std::uint32_t>(disp));
 }
 
-void AMD64Assembler::WriteOptSIB(Reg reg)
+// Writes an SSE2 opcode with its mandatory prefix in front of the optional REX prefix.
+void AMD64Assembler::WriteSSEOpcode(const std::uint8_t (&opcode)[3], Reg reg, Reg rm)
 {
-    if (reg == Reg::RSP)
-        WriteByte((RegByte(reg) << 3) | RegByte(reg));
+    WriteByte(opcode[0]);
+    WriteOptREX(false, reg, rm);
+    WriteByte(opcode[1]);
+    WriteByte(opcode[2]);
 }
 
 void AMD64Assembler::BeginSupplement(const Arg& arg)
@@ -449,18 +558,11 @@ void AMD64Assembler::ApplySupplements()
     }
 }
 
-void AMD64Assembler::ErrInvalidUseOfRSP()
-{
-    #ifdef LLGL_DEBUG
-    //Error("invalid use of %RSP register in MOV instruction");
-    #endif
-}
-
 /* ----- PUSH ----- */
 
 void AMD64Assembler::PushReg(Reg srcReg)
 {
-    WriteOptREX(srcReg, true);
+    WriteOptREX(false, srcReg);
     WriteByte(Opcode_PushReg | RegByte(srcReg));
 }
 
@@ -486,7 +588,7 @@ void AMD64Assembler::Push(Reg srcReg)
     if (IsFltReg(srcReg))
     {
         SubImm32(Reg::RSP, 16);
-        MovDQUMemReg(Reg::RSP, srcReg, {});
+        MovDQUMemReg(Reg::RSP, srcReg, 0);
     }
     else
         PushReg(srcReg);
@@ -496,7 +598,8 @@ void AMD64Assembler::Push(Reg srcReg)
 
 void AMD64Assembler::PopReg(Reg dstReg)
 {
-    WriteOptREX(dstReg, true);
+    UseReg(dstReg);
+    WriteOptREX(false, dstReg);
     WriteByte(Opcode_PopReg | RegByte(dstReg));
 }
 
@@ -504,7 +607,7 @@ void AMD64Assembler::Pop(Reg dstReg)
 {
     if (IsFltReg(dstReg))
     {
-        MovDQURegMem(dstReg, Reg::RSP, {});
+        MovDQURegMem(dstReg, Reg::RSP, 0);
         AddImm32(Reg::RSP, 16);
     }
     else
@@ -513,18 +616,22 @@ void AMD64Assembler::Pop(Reg dstReg)
 
 /* ----- MOV ----- */
 
-// Opcode: 89 /r
+// Opcode: REX.W 89 /r
 void AMD64Assembler::MovReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    UseReg(dstReg);
+    WriteOptREX(true, srcReg, dstReg);
     WriteByte(Opcode_MovMemReg);
-    WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
+    WriteModRMReg(RegByte(srcReg), dstReg);
 }
 
+// Opcode: B8 +rd id (upper 32 bits of the 64-bit register are cleared)
 void AMD64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
 {
     if (dword != 0)
     {
+        UseReg(dstReg);
+        WriteOptREX(false, dstReg);
         WriteByte(Opcode_MovRegImm | RegByte(dstReg));
         WriteDWord(dword);
     }
@@ -532,71 +639,65 @@ void AMD64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
         XOrReg(dstReg, dstReg);
 }
 
+// Opcode: REX.W B8 +rd io
 void AMD64Assembler::MovRegImm64(Reg dstReg, std::uint64_t qword)
 {
-    if (qword != 0)
+    if (qword > 0xFFFFFFFFull)
     {
-        WriteOptREX(dstReg);
+        UseReg(dstReg);
+        WriteOptREX(true, dstReg);
         WriteByte(Opcode_MovRegImm | RegByte(dstReg));
         WriteQWord(qword);
     }
     else
-        XOrReg(dstReg, dstReg);
+        MovRegImm32(dstReg, static_cast<std::uint32_t>(qword));
 }
 
-void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displacement& disp)
+// Opcode: REX.W C7 /0 id
+void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, std::int32_t disp)
 {
-    WriteOptREX(dstMemReg); // prefix
+    WriteOptREX(true, dstMemReg);
     WriteByte(Opcode_MovMemImm);
-    WriteByte(DispMod(disp) | RegByte(dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp); // displacement
-    WriteDWord(dword); // immediate
+    WriteModRMMem(0, dstMemReg, disp);
+    WriteDWord(dword);
 }
 
-void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
+// Opcode: REX.W 89 /r
+void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp)
 {
-    WriteOptREX(srcReg); // prefix
+    WriteOptREX(true, srcReg, dstMemReg);
     WriteByte(Opcode_MovMemReg);
-    WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp); // displacement
+    WriteModRMMem(RegByte(srcReg), dstMemReg, disp);
 }
 
-void AMD64Assembler::MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+// Opcode: REX.W 8B /r
+void AMD64Assembler::MovRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
 {
-    WriteOptREX(dstReg);
+    UseReg(dstReg);
+    WriteOptREX(true, dstReg, srcMemReg);
     WriteByte(Opcode_MovRegMem);
-    WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
-    WriteOptSIB(srcMemReg);
-    WriteOptDisp(disp);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
 }
 
-#if 0 // UNUSED
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
-void AMD64Assembler::MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+// Opcode: REX.W 8D /r
+void AMD64Assembler::LeaRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
 {
-    Write(OpcodeSSE2_MovSSRegMem, 3);
-    WriteByte(DispMod(disp) | (RegByte(dstReg) << 3) | RegByte(srcMemReg));
-    WriteOptDisp(disp); // displacement
+    UseReg(dstReg);
+    WriteOptREX(true, dstReg, srcMemReg);
+    WriteByte(Opcode_LeaRegMem);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
 }
 
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
-void AMD64Assembler::MovSDRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
-{
-    Write(OpcodeSSE2_MovSDRegMem, 3);
-    WriteByte(DispMod(disp) | (RegByte(dstReg) << 3) | RegByte(srcMemReg));
-    WriteOptDisp(disp); // displacement
-}
-#endif // /UNUSED
-
+// Opcode: F3 0F 10 /r with RIP-relative addressing
 void AMD64Assembler::MovSSRegImm32(Reg dstReg, float f32)
 {
-    Write(OpcodeSSE2_MovSSRegMem, 3);
+    UseReg(dstReg);
+    WriteSSEOpcode(OpcodeSSE2_MovSSRegMem, dstReg, Reg::EAX);
     WriteByte((RegByte(dstReg) << 3) | Operand_RIP);
 
     Arg arg;
     arg.type        = ArgType::Float;
+    arg.value.i64   = 0;
     arg.value.f32   = f32;
     BeginSupplement(arg);
 
@@ -605,9 +706,11 @@ void AMD64Assembler::MovSSRegImm32(Reg dstReg, float f32)
     EndSupplement();
 }
 
+// Opcode: F2 0F 10 /r with RIP-relative addressing
 void AMD64Assembler::MovSDRegImm64(Reg dstReg, double f64)
 {
-    Write(OpcodeSSE2_MovSDRegMem, 3);
+    UseReg(dstReg);
+    WriteSSEOpcode(OpcodeSSE2_MovSDRegMem, dstReg, Reg::EAX);
     WriteByte((RegByte(dstReg) << 3) | Operand_RIP);
 
     Arg arg;
@@ -620,42 +723,60 @@ void AMD64Assembler::MovSDRegImm64(Reg dstReg, double f64)
     EndSupplement();
 }
 
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
-void AMD64Assembler::MovDQURegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+// Opcode: F3 0F 6F /r
+void AMD64Assembler::MovDQURegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
+{
+    UseReg(dstReg);
+    WriteSSEOpcode(OpcodeSSE2_MovDQURegMem, dstReg, srcMemReg);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
+}
+
+// Opcode: F3 0F 7F /r
+void AMD64Assembler::MovDQUMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp)
+{
+    WriteSSEOpcode(OpcodeSSE2_MovDQUMemReg, srcReg, dstMemReg);
+    WriteModRMMem(RegByte(srcReg), dstMemReg, disp);
+}
+
+/* ----- CVTSD2SS ----- */
+
+// Opcode: F2 0F 5A /r
+void AMD64Assembler::CvtSD2SSReg(Reg dstReg, Reg srcReg)
 {
-    Write(OpcodeSSE2_MovDQURegMem, 3);
-    WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
-    WriteOptSIB(srcMemReg);
-    WriteOptDisp(disp);
+    UseReg(dstReg);
+    WriteSSEOpcode(OpcodeSSE2_CvtSD2SSRegMem, dstReg, srcReg);
+    WriteModRMReg(RegByte(dstReg), srcReg);
 }
 
-// dstMemReg: RAX-RDI, srcReg: XMM0-XMM7
-void AMD64Assembler::MovDQUMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
+// Opcode: F2 0F 5A /r
+void AMD64Assembler::CvtSD2SSRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
 {
-    Write(OpcodeSSE2_MovDQUMemReg, 3);
-    WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp);
+    UseReg(dstReg);
+    WriteSSEOpcode(OpcodeSSE2_CvtSD2SSRegMem, dstReg, srcMemReg);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
 }
 
 /* ----- ADD ----- */
 
-void AMD64Assembler::AddImm32(Reg dst, std::uint32_t dword)
+// Opcode: REX.W 81 /0 id
+void AMD64Assembler::AddImm32(Reg dstReg, std::uint32_t dword)
 {
-    WriteOptREX(dst);
+    UseReg(dstReg);
+    WriteOptREX(Is64Reg(dstReg), dstReg);
     WriteByte(Opcode_AddImm);
-    WriteByte(Operand_Mod11 | RegByte(dst));
+    WriteModRMReg(0, dstReg);
     WriteDWord(dword);
 }
 
 /* ----- SUB ----- */
 
-// Opcode: 81 /5 id
+// Opcode: REX.W 81 /5 id
 void AMD64Assembler::SubImm32(Reg dstReg, std::uint32_t dword)
 {
-    WriteOptREX(dstReg);
+    UseReg(dstReg);
+    WriteOptREX(Is64Reg(dstReg), dstReg);
     WriteByte(Opcode_SubImm);
-    WriteByte(Operand_Mod11 | (5u << 3) | RegByte(dstReg));
+    WriteModRMReg(5, dstReg);
     WriteDWord(dword);
 }
 
@@ -665,26 +786,30 @@ void AMD64Assembler::SubImm32(Reg dstReg, std::uint32_t dword)
 // Divide RDX:RAX -> Quotient: RAX, Remainder: RDX
 void AMD64Assembler::DivReg(Reg srcReg)
 {
-    WriteOptREX(srcReg);
+    UseReg(Reg::RAX);
+    UseReg(Reg::RDX);
+    WriteOptREX(Is64Reg(srcReg), srcReg);
     WriteByte(Opcode_DivReg);
-    WriteByte(Operand_Mod11 | (6u << 3) | RegByte(srcReg));
+    WriteModRMReg(6, srcReg);
 }
 
 /* ----- XOR ----- */
 
-// Opcode: 31 /r
+// Opcode: 31 /r (32-bit operand size also clears the upper 32 bits of the 64-bit register)
 void AMD64Assembler::XOrReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    UseReg(dstReg);
+    WriteOptREX(false, srcReg, dstReg);
     WriteByte(Opcode_XOrMemReg);
-    WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
+    WriteModRMReg(RegByte(srcReg), dstReg);
 }
 
 /* ----- CALL ----- */
 
+// Opcode: FF /2
 void AMD64Assembler::CallNear(Reg reg)
 {
-    WriteOptREX(reg, true);
+    WriteOptREX(false, reg);
     WriteByte(0xFF);
     WriteByte(Opcode_CallNear | Operand_Mod11 | RegByte(reg));
 }
@@ -732,29 +857,6 @@ void AMD64Assembler::_ForceExcep()
 #endif
 
 
-/*
- * Displacement structure
- */
-
-AMD64Assembler::Displacement::Displacement() :
-    has32Bits { false },
-    disp32    { 0     }
-{
-}
-
-AMD64Assembler::Disp8::Disp8(std::int8_t disp)
-{
-    has32Bits   = false;
-    disp8       = disp;
-}
-
-AMD64Assembler::Disp32::Disp32(std::int32_t disp)
-{
-    has32Bits   = true;
-    disp32      = disp;
-}
-
-
 } // /namespace JIT
 
 } // /namespace LLGL
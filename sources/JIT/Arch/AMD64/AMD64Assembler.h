@@ -38,11 +38,6 @@ class AMD64Assembler final : public JITCompiler
 
     private:
 
-        struct Displacement;
-
-        std::uint8_t DispMod(const Displacement& disp) const;
-        std::uint8_t ModRM(std::uint8_t mode, Reg r0, Reg r1) const;
-
         void WritePrologue();
         void WriteEpilogue();
 
@@ -51,16 +46,24 @@ class AMD64Assembler final : public JITCompiler
             const std::vector<std::uint32_t>&   stackChunks
         );
 
-        void WriteOptREX(Reg reg, bool defaultsTo64Bit = false);
-        void WriteOptDisp(const Displacement& disp);
-        void WriteOptSIB(Reg reg);
+        void DetermineSavedRegs();
+
+        void LoadArg(Reg dstReg, const Arg& arg);
+        void StoreArg(std::int32_t dstOffset, const Arg& arg);
+
+        void UseReg(Reg reg);
+        bool IsRegUsed(Reg reg) const;
+
+        void WriteOptREX(bool w64, Reg rm);
+        void WriteOptREX(bool w64, Reg reg, Reg rm);
+        void WriteModRMReg(std::uint8_t regBits, Reg rm);
+        void WriteModRMMem(std::uint8_t regBits, Reg baseReg, std::int32_t disp);
+        void WriteSSEOpcode(const std::uint8_t (&opcode)[3], Reg reg, Reg rm);
 
         void BeginSupplement(const Arg& arg);
         void EndSupplement();
         void ApplySupplements();
 
-        void ErrInvalidUseOfRSP();
-
     private:
 
         void PushReg(Reg srcReg);
@@ -75,20 +78,19 @@ class AMD64Assembler final : public JITCompiler
         void MovReg(Reg dstReg, Reg srcReg);
         void MovRegImm32(Reg dstReg, std::uint32_t dword);
         void MovRegImm64(Reg dstReg, std::uint64_t qword);
-        void MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displacement& disp);
-        void MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp);
-        void MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
-
-        #if 0 // UNUSED
-        void MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
-        void MovSDRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
-        #endif // /UNUSED
+        void MovMemImm32(Reg dstMemReg, std::uint32_t dword, std::int32_t disp);
+        void MovMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp);
+        void MovRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
+        void LeaRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
 
         void MovSSRegImm32(Reg dstReg, float f32);
         void MovSDRegImm64(Reg dstReg, double f64);
 
-        void MovDQURegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
-        void MovDQUMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp);
+        void MovDQURegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
+        void MovDQUMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp);
+
+        void CvtSD2SSReg(Reg dstReg, Reg srcReg);
+        void CvtSD2SSRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
 
         void AddImm32(Reg dstReg, std::uint32_t dword);
         void SubImm32(Reg dstReg, std::uint32_t dword);
@@ -116,44 +118,45 @@ class AMD64Assembler final : public JITCompiler
             std::size_t     dstOffset;  // Destination byte offset where the instruction must be updated
         };
 
-        struct Displacement
+        // Location of an entry point parameter: either a callee-saved register, or RBP if it is stored in the local stack.
+        struct VarArgLocation
         {
-            Displacement();
-            Displacement(const Displacement&) = default;
-            Displacement& operator = (const Displacement&) = default;
-
-            bool has32Bits;
-            union
-            {
-                std::int8_t     disp8;
-                std::int32_t    disp32;
-            };
+            Reg             reg;
+            std::int32_t    disp;       // Displacement relative to RBP (only if 'reg' is RBP)
         };
 
-        struct Disp8 : public Displacement
+        // Callee-saved register that is preserved by the prologue and restored by the epilogue.
+        struct SavedReg
         {
-            Disp8(std::int8_t disp);
-        };
-
-        struct Disp32 : public Displacement
-        {
-            Disp32(std::int32_t disp);
+            Reg             reg;
+            std::int32_t    disp;       // Displacement relative to RBP
         };
 
     private:
 
-        std::uint32_t           	localStackSize_ = 0;
-        std::uint16_t               paramStackSize_ = 0;
-        Displacement                argStackBase_;
+        // Size (in bytes) of entry point parameters and stack allocations below RBP
+        std::uint32_t               localStackSize_ = 0;
+
+        // Size (in bytes) of the largest argument list that is passed on the stack to a function call (including shadow space)
+        std::uint32_t               argStackSize_   = 0;
+
+        // Final size (in bytes) of the stack frame that is allocated by the prologue
+        std::uint32_t               frameSize_      = 0;
+
+        // Bitmask of registers that are written by the program (see UseReg)
+        std::uint64_t               usedRegs_       = 0;
 
         // Supplement data that must be updated after encoding
         std::vector<Supplement>     supplements_;
 
-        // Displacements of parameters within stack frame
-        std::vector<Displacement>   varArgDisp_;
+        // Locations of entry point parameters
+        std::vector<VarArgLocation> varArgs_;
+
+        // Base pointer displacements of stack allocations
+        std::vector<std::int32_t>   stackChunkOffsets_;
 
-        // Base pointer offsets of stack allocations
-        std::vector<std::uint32_t>  stackChunkOffsets_;
+        // Callee-saved registers that are used by the program
+        std::vector<SavedReg>       savedRegs_;
 
 };
 
@@ -78,6 +78,18 @@ bool IsFltReg(const Reg reg)
     return (reg >= Reg::XMM0 && reg <= Reg::XMM15);
 }
 
+bool IsExtReg(const Reg reg)
+{
+    return ((reg >= Reg::R8 && reg <= Reg::R15) || (reg >= Reg::XMM8 && reg <= Reg::XMM15));
+}
+
+Reg GetReg64(const Reg reg)
+{
+    if (reg >= Reg::EAX && reg <= Reg::EDI)
+        return static_cast<Reg>(static_cast<int>(reg) + (static_cast<int>(Reg::RAX) - static_cast<int>(Reg::EAX)));
+    return reg;
+}
+
 
 } // /namespace JIT
 
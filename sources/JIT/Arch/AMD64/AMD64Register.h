@@ -77,6 +77,12 @@ bool Is64Reg(const Reg reg);
 // Returns true, if 'reg' denotes a floating-point register (i.e. XMM0-XMM15).
 bool IsFltReg(const Reg reg);
 
+// Returns true, if 'reg' requires the REX.R or REX.B prefix bit to be encoded (i.e. R8-R15 and XMM8-XMM15).
+bool IsExtReg(const Reg reg);
+
+// Returns the 64-bit register for the specified 32-bit register (e.g. EAX -> RAX), or the input register otherwise.
+Reg GetReg64(const Reg reg);
+
 
 } // /namespace JIT
 
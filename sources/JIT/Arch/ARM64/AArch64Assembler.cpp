@@ -0,0 +1,604 @@
+/*
+ * AArch64Assembler.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "AArch64Assembler.h"
+#include "AArch64Opcode.h"
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+/*
+ * Internal members
+ */
+
+/*
+Procedure Call Standard for the ARM 64-bit Architecture (AAPCS64)
+see https://developer.arm.com/documentation/ihi0055/latest
+Preserved for caller: X19-X28, X29 (FP), X30 (LR), and the lower 64 bits of V8-V15
+X16 (IP0) and X17 (IP1) are intra-procedure-call scratch registers and never used for parameters.
+*/
+static const Reg g_a64IntParams[]       = { Reg::X0, Reg::X1, Reg::X2, Reg::X3, Reg::X4, Reg::X5, Reg::X6, Reg::X7 };
+static const Reg g_a64FltParams[]       = { Reg::V0, Reg::V1, Reg::V2, Reg::V3, Reg::V4, Reg::V5, Reg::V6, Reg::V7 };
+static const Reg g_a64CalleeSavedRegs[] = { Reg::X19, Reg::X20, Reg::X21, Reg::X22, Reg::X23, Reg::X24, Reg::X25, Reg::X26, Reg::X27, Reg::X28 };
+static const Reg g_a64VarArgRegs[]      = { Reg::X19, Reg::X20, Reg::X21, Reg::X22, Reg::X23, Reg::X24, Reg::X25, Reg::X26, Reg::X27, Reg::X28 };
+static const Reg g_a64TempReg           = Reg::X16;
+static const Reg g_a64AddrReg           = Reg::X17;
+static const Reg g_a64TempFltReg        = Reg::V16;
+
+static const std::size_t g_a64IntParamsCount    = sizeof(g_a64IntParams)/sizeof(g_a64IntParams[0]);
+static const std::size_t g_a64FltParamsCount    = sizeof(g_a64FltParams)/sizeof(g_a64FltParams[0]);
+static const std::size_t g_a64VarArgRegsCount   = sizeof(g_a64VarArgRegs)/sizeof(g_a64VarArgRegs[0]);
+
+
+/*
+ * Internal functions
+ */
+
+// Counter of parameter registers that have already been assigned to arguments.
+struct ParamRegCounter
+{
+    std::size_t numIntRegs = 0;
+    std::size_t numFltRegs = 0;
+};
+
+// Returns the register for the next argument, or SP if the argument must be passed on the stack.
+static Reg NextParamReg(bool isFloat, ParamRegCounter& counter)
+{
+    /* Integral and floating-point arguments are assigned to their registers independently */
+    if (isFloat)
+    {
+        if (counter.numFltRegs < g_a64FltParamsCount)
+            return g_a64FltParams[counter.numFltRegs++];
+    }
+    else
+    {
+        if (counter.numIntRegs < g_a64IntParamsCount)
+            return g_a64IntParams[counter.numIntRegs++];
+    }
+    return Reg::SP;
+}
+
+
+/*
+ * AArch64Assembler class
+ */
+
+void AArch64Assembler::Begin()
+{
+    /* Reset data about local stack */
+    localStackSize_ = 0;
+    argStackSize_   = 0;
+    frameSize_      = 0;
+    usedRegs_       = 0;
+
+    varArgs_.clear();
+    stackChunkOffsets_.clear();
+    savedRegs_.clear();
+
+    /*
+    Store entry point parameters; the prologue is inserted in front of the program at the end,
+    because the stack frame size and the registers to preserve are only known after all function calls have been encoded
+    */
+    WriteStackFrame(GetEntryVarArgs(), GetStackAllocs());
+}
+
+void AArch64Assembler::End()
+{
+    /* Take program body out of the assembly to insert the prologue in front of it */
+    std::vector<std::uint8_t> body;
+    body.swap(GetAssembly());
+
+    DetermineSavedRegs();
+    WritePrologue();
+
+    /* Append program body; all addresses are encoded as absolute immediates, so the body can be moved as is */
+    auto& code = GetAssembly();
+    code.insert(code.end(), body.begin(), body.end());
+
+    WriteEpilogue();
+}
+
+void AArch64Assembler::WriteFuncCall(const void* addr, JITCallConv /*conv*/, bool /*farCall*/)
+{
+    ParamRegCounter counter;
+    std::uint32_t   stackOffset = 0;
+
+    for (const auto& arg : GetArgs())
+    {
+        /* Determine destination register for argument */
+        auto dstReg = NextParamReg(IsFloat(arg.type), counter);
+
+        if (dstReg != Reg::SP)
+        {
+            /* Move argument into parameter register */
+            LoadArg(dstReg, arg);
+        }
+        else
+        {
+            /* Store argument in outgoing argument area, first argument at the lowest address */
+            StoreArg(static_cast<std::int32_t>(stackOffset), arg);
+            stackOffset += 8;
+        }
+    }
+
+    /* Outgoing argument area is allocated once by the prologue for all function calls */
+    argStackSize_ = std::max(argStackSize_, stackOffset);
+
+    /* Write 'blr' instruction (temporary register is never used for parameters) */
+    MovRegImm64(g_a64TempReg, reinterpret_cast<std::uint64_t>(addr));
+    CallReg(g_a64TempReg);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool AArch64Assembler::IsLittleEndian() const
+{
+    return true;
+}
+
+/*
+Stack frame layout:
+    [X29 + 16 ...]                  Stack parameters of entry point
+    [X29 + 8]                       Link register (X30)
+    [X29]                           Previous frame pointer (X29)
+    [X29 - localStackSize_ ...]     Entry point parameters and stack allocations
+    [SP + argStackSize_ ...]        Preserved callee-saved registers
+    [SP ...]                        Outgoing arguments of function calls
+*/
+void AArch64Assembler::WritePrologue()
+{
+    /* Store frame record and set up frame pointer (X29) */
+    PushFrameRecord();
+    AddImm(Reg::X29, Reg::SP, 0);
+
+    /* Allocate stack frame; SP must remain 16-byte aligned */
+    if (frameSize_ > 0)
+        SubImm(Reg::SP, Reg::SP, frameSize_);
+
+    /* Store callee-saved registers that are used by the program */
+    for (const auto& saved : savedRegs_)
+        StrMemReg(Reg::SP, saved.reg, saved.disp);
+}
+
+void AArch64Assembler::WriteEpilogue()
+{
+    /* Restore callee-saved registers */
+    for (const auto& saved : savedRegs_)
+        LdrRegMem(saved.reg, Reg::SP, saved.disp);
+
+    /* Release stack frame and restore frame record */
+    AddImm(Reg::SP, Reg::X29, 0);
+    PopFrameRecord();
+    Ret();
+}
+
+void AArch64Assembler::WriteStackFrame(
+    const std::vector<JIT::ArgType>&    varArgTypes,
+    const std::vector<std::uint32_t>&   stackChunks)
+{
+    ParamRegCounter counter;
+    std::size_t     numVarArgRegs       = 0;
+    std::int32_t    paramStackOffset    = 16; // first stack parameter after frame record
+
+    varArgs_.reserve(varArgTypes.size());
+
+    for (auto type : varArgTypes)
+    {
+        const bool isFloat = IsFloat(type);
+
+        VarArgLocation location;
+        location.reg    = Reg::X29;
+        location.disp   = 0;
+
+        /* Determine register of parameter */
+        auto srcReg = NextParamReg(isFloat, counter);
+        if (srcReg == Reg::SP)
+        {
+            if (!isFloat && numVarArgRegs < g_a64VarArgRegsCount)
+            {
+                /* Load integral parameter from stack of the caller into a callee-saved register */
+                location.reg = g_a64VarArgRegs[numVarArgRegs++];
+                LdrRegMem(location.reg, Reg::X29, paramStackOffset);
+            }
+            else if (type == ArgType::Float)
+            {
+                /* Entry point is variadic, so single-precision parameters have been promoted to double-precision */
+                localStackSize_ += 8;
+                location.disp = -static_cast<std::int32_t>(localStackSize_);
+                LdrRegMem(g_a64TempFltReg, Reg::X29, paramStackOffset);
+                FCvtSDReg(g_a64TempFltReg, g_a64TempFltReg);
+                StrMemReg(Reg::X29, g_a64TempFltReg, location.disp, 4);
+            }
+            else
+            {
+                /* Keep parameter in stack of the caller */
+                location.disp = paramStackOffset;
+            }
+            paramStackOffset += 8;
+        }
+        else if (!isFloat && numVarArgRegs < g_a64VarArgRegsCount)
+        {
+            /* Keep integral parameter in a callee-saved register, so it survives all function calls */
+            location.reg = g_a64VarArgRegs[numVarArgRegs++];
+            MovReg(location.reg, srcReg);
+        }
+        else
+        {
+            /* Store parameter in local stack */
+            localStackSize_ += 8;
+            location.disp = -static_cast<std::int32_t>(localStackSize_);
+
+            if (type == ArgType::Float)
+            {
+                FCvtSDReg(srcReg, srcReg);
+                StrMemReg(Reg::X29, srcReg, location.disp, 4);
+            }
+            else
+                StrMemReg(Reg::X29, srcReg, location.disp);
+        }
+
+        varArgs_.push_back(location);
+    }
+
+    /* Determine frame pointer displacements of 16-byte aligned stack allocations */
+    stackChunkOffsets_.reserve(stackChunks.size());
+    for (auto chunk : stackChunks)
+    {
+        localStackSize_ = GetAlignedSize(localStackSize_ + chunk, 16u);
+        stackChunkOffsets_.push_back(-static_cast<std::int32_t>(localStackSize_));
+    }
+}
+
+void AArch64Assembler::DetermineSavedRegs()
+{
+    /*
+    Store each callee-saved register above the outgoing argument area, if it is written by the program;
+    addressing them relative to SP keeps the displacements small, regardless of the size of stack allocations
+    */
+    std::uint32_t savedRegsSize = 0;
+
+    for (auto reg : g_a64CalleeSavedRegs)
+    {
+        if (IsRegUsed(reg))
+        {
+            savedRegs_.push_back({ reg, static_cast<std::int32_t>(argStackSize_ + savedRegsSize) });
+            savedRegsSize += 8;
+        }
+    }
+
+    /* Determine final stack frame size; SP is 16-byte aligned after the frame record has been pushed */
+    frameSize_ = GetAlignedSize(localStackSize_ + savedRegsSize + argStackSize_, 16u);
+}
+
+void AArch64Assembler::LoadArg(Reg dstReg, const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        if (arg.param < varArgs_.size())
+        {
+            /* Move entry point parameter into destination register */
+            const auto& location = varArgs_[arg.param];
+            if (location.reg != Reg::X29)
+                MovReg(dstReg, location.reg);
+            else
+                LdrRegMem(dstReg, Reg::X29, location.disp, (arg.type == ArgType::Float ? 4 : 8));
+        }
+    }
+    else
+    {
+        /* Move value into destination register */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+                MovRegImm32(dstReg, arg.value.i8);
+                break;
+            case ArgType::Word:
+                MovRegImm32(dstReg, arg.value.i16);
+                break;
+            case ArgType::DWord:
+                MovRegImm32(dstReg, arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+                MovRegImm64(dstReg, arg.value.i64);
+                break;
+            case ArgType::StackPtr:
+                SubImm(dstReg, Reg::X29, static_cast<std::uint32_t>(-stackChunkOffsets_[arg.value.i8]));
+                break;
+            case ArgType::Float:
+                FMovRegImm32(dstReg, arg.value.f32);
+                break;
+            case ArgType::Double:
+                FMovRegImm64(dstReg, arg.value.f64);
+                break;
+        }
+    }
+}
+
+void AArch64Assembler::StoreArg(std::int32_t dstOffset, const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        if (arg.param < varArgs_.size())
+        {
+            /* Copy entry point parameter onto stack */
+            const auto& location = varArgs_[arg.param];
+            if (location.reg != Reg::X29)
+                StrMemReg(Reg::SP, location.reg, dstOffset);
+            else
+            {
+                LdrRegMem(g_a64TempReg, Reg::X29, location.disp, (arg.type == ArgType::Float ? 4 : 8));
+                StrMemReg(Reg::SP, g_a64TempReg, dstOffset);
+            }
+        }
+    }
+    else
+    {
+        /* Store value onto stack; each argument occupies 8 bytes, floating-point values are stored by their bit pattern */
+        switch (arg.type)
+        {
+            case ArgType::Float:
+                MovRegImm32(g_a64TempReg, arg.value.i32);
+                break;
+            case ArgType::Double:
+                MovRegImm64(g_a64TempReg, arg.value.i64);
+                break;
+            default:
+                LoadArg(g_a64TempReg, arg);
+                break;
+        }
+        StrMemReg(Reg::SP, g_a64TempReg, dstOffset);
+    }
+}
+
+void AArch64Assembler::UseReg(Reg reg)
+{
+    usedRegs_ |= (1ull << static_cast<unsigned>(reg));
+}
+
+bool AArch64Assembler::IsRegUsed(Reg reg) const
+{
+    return ((usedRegs_ & (1ull << static_cast<unsigned>(reg))) != 0);
+}
+
+void AArch64Assembler::WriteInstr(std::uint32_t instr)
+{
+    WriteDWord(instr);
+}
+
+// Writes a load/store instruction with the smallest encoding for the specified displacement.
+void AArch64Assembler::WriteLoadStore(std::uint32_t opcode, std::uint32_t size, Reg reg, Reg baseReg, std::int32_t disp)
+{
+    if (disp >= 0 && disp % size == 0 && static_cast<std::uint32_t>(disp) / size < 0x1000)
+    {
+        /* Encode LDR/STR with unsigned scaled 12-bit offset */
+        const auto imm12 = static_cast<std::uint32_t>(disp) / size;
+        WriteInstr(opcode | (imm12 << OpcodeShift_Imm12) | (RegBits(baseReg) << OpcodeShift_Rn) | RegBits(reg));
+    }
+    else if (disp >= -256 && disp < 256)
+    {
+        /* Encode LDUR/STUR with signed unscaled 9-bit offset */
+        const auto imm9 = static_cast<std::uint32_t>(disp) & 0x1FF;
+        WriteInstr((opcode & ~Opcode_LdrStrUnscaled) | (imm9 << OpcodeShift_Imm9) | (RegBits(baseReg) << OpcodeShift_Rn) | RegBits(reg));
+    }
+    else
+    {
+        /* Compute address in scratch register */
+        if (disp < 0)
+            SubImm(g_a64AddrReg, baseReg, static_cast<std::uint32_t>(-disp));
+        else
+            AddImm(g_a64AddrReg, baseReg, static_cast<std::uint32_t>(disp));
+        WriteInstr(opcode | (RegBits(g_a64AddrReg) << OpcodeShift_Rn) | RegBits(reg));
+    }
+}
+
+void AArch64Assembler::MovReg(Reg dstReg, Reg srcReg)
+{
+    UseReg(dstReg);
+    WriteInstr(Opcode_MovReg64 | (RegBits(srcReg) << OpcodeShift_Rm) | RegBits(dstReg));
+}
+
+void AArch64Assembler::MovRegImm32(Reg dstReg, std::uint32_t value)
+{
+    UseReg(dstReg);
+
+    const std::uint32_t lo = (value & 0xFFFF);
+    const std::uint32_t hi = (value >> 16);
+
+    if (hi == 0xFFFF)
+    {
+        /* MOVN writes the inverted immediate, so negative values require only a single instruction */
+        WriteInstr(Opcode_MovN32 | ((~lo & 0xFFFF) << OpcodeShift_Imm16) | RegBits(dstReg));
+    }
+    else if (lo == 0 && hi != 0)
+    {
+        /* Only upper 16 bits are set (e.g. bit pattern of most float literals) */
+        WriteInstr(Opcode_MovZ32 | (1u << OpcodeShift_HW) | (hi << OpcodeShift_Imm16) | RegBits(dstReg));
+    }
+    else
+    {
+        WriteInstr(Opcode_MovZ32 | (lo << OpcodeShift_Imm16) | RegBits(dstReg));
+        if (hi != 0)
+            WriteInstr(Opcode_MovK32 | (1u << OpcodeShift_HW) | (hi << OpcodeShift_Imm16) | RegBits(dstReg));
+    }
+}
+
+void AArch64Assembler::MovRegImm64(Reg dstReg, std::uint64_t value)
+{
+    UseReg(dstReg);
+
+    /* Start with MOVN instead of MOVZ if most 16-bit chunks are 0xFFFF */
+    int numZeroChunks = 0, numOnesChunks = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto chunk = static_cast<std::uint32_t>((value >> (i * 16)) & 0xFFFF);
+        if (chunk == 0x0000)
+            ++numZeroChunks;
+        else if (chunk == 0xFFFF)
+            ++numOnesChunks;
+    }
+
+    const bool          inverted    = (numOnesChunks > numZeroChunks);
+    const std::uint32_t skipChunk   = (inverted ? 0xFFFF : 0x0000);
+    bool                first       = true;
+
+    for (std::uint32_t i = 0; i < 4; ++i)
+    {
+        const auto chunk = static_cast<std::uint32_t>((value >> (i * 16)) & 0xFFFF);
+        if (chunk != skipChunk)
+        {
+            if (first)
+            {
+                if (inverted)
+                    WriteInstr(Opcode_MovN64 | (i << OpcodeShift_HW) | ((~chunk & 0xFFFF) << OpcodeShift_Imm16) | RegBits(dstReg));
+                else
+                    WriteInstr(Opcode_MovZ64 | (i << OpcodeShift_HW) | (chunk << OpcodeShift_Imm16) | RegBits(dstReg));
+                first = false;
+            }
+            else
+                WriteInstr(Opcode_MovK64 | (i << OpcodeShift_HW) | (chunk << OpcodeShift_Imm16) | RegBits(dstReg));
+        }
+    }
+
+    /* All chunks are equal to the skipped chunk, i.e. the value is either 0 or ~0 */
+    if (first)
+        WriteInstr((inverted ? Opcode_MovN64 : Opcode_MovZ64) | RegBits(dstReg));
+}
+
+void AArch64Assembler::FMovRegImm32(Reg dstReg, float f32)
+{
+    UseReg(dstReg);
+
+    /* Move bit pattern via temporary register; zero is moved directly from WZR */
+    DWord bits;
+    ::memcpy(&bits, &f32, sizeof(bits));
+
+    Reg srcReg = Reg::SP;
+    if (bits.i32 != 0)
+    {
+        MovRegImm32(g_a64TempReg, bits.i32);
+        srcReg = g_a64TempReg;
+    }
+
+    WriteInstr(Opcode_FMovSW | (RegBits(srcReg) << OpcodeShift_Rn) | RegBits(dstReg));
+}
+
+void AArch64Assembler::FMovRegImm64(Reg dstReg, double f64)
+{
+    UseReg(dstReg);
+
+    /* Move bit pattern via temporary register; zero is moved directly from XZR */
+    QWord bits;
+    ::memcpy(&bits, &f64, sizeof(bits));
+
+    Reg srcReg = Reg::SP;
+    if (bits.i64 != 0)
+    {
+        MovRegImm64(g_a64TempReg, bits.i64);
+        srcReg = g_a64TempReg;
+    }
+
+    WriteInstr(Opcode_FMovDX | (RegBits(srcReg) << OpcodeShift_Rn) | RegBits(dstReg));
+}
+
+void AArch64Assembler::FCvtSDReg(Reg dstReg, Reg srcReg)
+{
+    UseReg(dstReg);
+    WriteInstr(Opcode_FCvtSD | (RegBits(srcReg) << OpcodeShift_Rn) | RegBits(dstReg));
+}
+
+void AArch64Assembler::AddImm(Reg dstReg, Reg srcReg, std::uint32_t value)
+{
+    AddSubImm(Opcode_AddImm64, Opcode_AddExt64, dstReg, srcReg, value);
+}
+
+void AArch64Assembler::SubImm(Reg dstReg, Reg srcReg, std::uint32_t value)
+{
+    AddSubImm(Opcode_SubImm64, Opcode_SubExt64, dstReg, srcReg, value);
+}
+
+// Writes an ADD/SUB instruction with an arbitrary immediate value; register index 31 denotes SP for both operands.
+void AArch64Assembler::AddSubImm(std::uint32_t opcodeImm, std::uint32_t opcodeExt, Reg dstReg, Reg srcReg, std::uint32_t value)
+{
+    UseReg(dstReg);
+
+    if (value < 0x1000)
+    {
+        /* Encode 12-bit immediate */
+        WriteInstr(opcodeImm | (value << OpcodeShift_Imm12) | (RegBits(srcReg) << OpcodeShift_Rn) | RegBits(dstReg));
+    }
+    else if (value < 0x1000000)
+    {
+        /* Encode upper 12 bits with LSL #12 and lower 12 bits in a second instruction */
+        WriteInstr(opcodeImm | Opcode_ImmLSL12 | ((value >> 12) << OpcodeShift_Imm12) | (RegBits(srcReg) << OpcodeShift_Rn) | RegBits(dstReg));
+        if ((value & 0xFFF) != 0)
+            WriteInstr(opcodeImm | ((value & 0xFFF) << OpcodeShift_Imm12) | (RegBits(dstReg) << OpcodeShift_Rn) | RegBits(dstReg));
+    }
+    else
+    {
+        /* Move immediate into scratch register and encode extended register form */
+        MovRegImm64(g_a64AddrReg, value);
+        WriteInstr(opcodeExt | (RegBits(g_a64AddrReg) << OpcodeShift_Rm) | (RegBits(srcReg) << OpcodeShift_Rn) | RegBits(dstReg));
+    }
+}
+
+void AArch64Assembler::LdrRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp, std::uint32_t size)
+{
+    UseReg(dstReg);
+    if (IsFltReg(dstReg))
+        WriteLoadStore((size == 4 ? Opcode_LdrS : Opcode_LdrD), size, dstReg, srcMemReg, disp);
+    else
+        WriteLoadStore((size == 4 ? Opcode_LdrW : Opcode_LdrX), size, dstReg, srcMemReg, disp);
+}
+
+void AArch64Assembler::StrMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp, std::uint32_t size)
+{
+    if (IsFltReg(srcReg))
+        WriteLoadStore((size == 4 ? Opcode_StrS : Opcode_StrD), size, srcReg, dstMemReg, disp);
+    else
+        WriteLoadStore((size == 4 ? Opcode_StrW : Opcode_StrX), size, srcReg, dstMemReg, disp);
+}
+
+void AArch64Assembler::PushFrameRecord()
+{
+    WriteInstr(Opcode_StpFrameRecord);
+}
+
+void AArch64Assembler::PopFrameRecord()
+{
+    WriteInstr(Opcode_LdpFrameRecord);
+}
+
+void AArch64Assembler::CallReg(Reg reg)
+{
+    WriteInstr(Opcode_Blr | (RegBits(reg) << OpcodeShift_Rn));
+}
+
+void AArch64Assembler::Ret()
+{
+    WriteInstr(Opcode_Ret);
+}
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,134 @@
+/*
+ * AArch64Assembler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_AARCH64_ASSEMBLER_H
+#define LLGL_AARCH64_ASSEMBLER_H
+
+
+#include "AArch64Register.h"
+#include "../../JITCompiler.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+// AArch64 (a.k.a. ARM64) assembly code generator for the AAPCS64 calling convention.
+class AArch64Assembler final : public JITCompiler
+{
+
+    public:
+
+        void Begin() override;
+        void End() override;
+
+    private:
+
+        bool IsLittleEndian() const override;
+        void WriteFuncCall(const void* addr, JITCallConv conv, bool farCall) override;
+
+    private:
+
+        void WritePrologue();
+        void WriteEpilogue();
+
+        void WriteStackFrame(
+            const std::vector<JIT::ArgType>&    varArgTypes,
+            const std::vector<std::uint32_t>&   stackChunks
+        );
+
+        void DetermineSavedRegs();
+
+        void LoadArg(Reg dstReg, const Arg& arg);
+        void StoreArg(std::int32_t dstOffset, const Arg& arg);
+
+        void UseReg(Reg reg);
+        bool IsRegUsed(Reg reg) const;
+
+        void WriteInstr(std::uint32_t instr);
+        void WriteLoadStore(std::uint32_t opcode, std::uint32_t size, Reg reg, Reg baseReg, std::int32_t disp);
+
+    private:
+
+        void MovReg(Reg dstReg, Reg srcReg);
+        void MovRegImm32(Reg dstReg, std::uint32_t value);
+        void MovRegImm64(Reg dstReg, std::uint64_t value);
+
+        void FMovRegImm32(Reg dstReg, float f32);
+        void FMovRegImm64(Reg dstReg, double f64);
+        void FCvtSDReg(Reg dstReg, Reg srcReg);
+
+        void AddImm(Reg dstReg, Reg srcReg, std::uint32_t value);
+        void SubImm(Reg dstReg, Reg srcReg, std::uint32_t value);
+        void AddSubImm(std::uint32_t opcodeImm, std::uint32_t opcodeExt, Reg dstReg, Reg srcReg, std::uint32_t value);
+
+        void LdrRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp, std::uint32_t size = 8);
+        void StrMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp, std::uint32_t size = 8);
+
+        void PushFrameRecord();
+        void PopFrameRecord();
+
+        void CallReg(Reg reg);
+        void Ret();
+
+    private:
+
+        // Location of an entry point parameter: either a callee-saved register, or X29 if it is stored in the stack.
+        struct VarArgLocation
+        {
+            Reg             reg;
+            std::int32_t    disp;       // Displacement relative to X29 (only if 'reg' is X29)
+        };
+
+        // Callee-saved register that is preserved by the prologue and restored by the epilogue.
+        struct SavedReg
+        {
+            Reg             reg;
+            std::int32_t    disp;       // Displacement relative to SP
+        };
+
+    private:
+
+        // Size (in bytes) of entry point parameters and stack allocations below X29
+        std::uint32_t               localStackSize_ = 0;
+
+        // Size (in bytes) of the largest argument list that is passed on the stack to a function call
+        std::uint32_t               argStackSize_   = 0;
+
+        // Final size (in bytes) of the stack frame that is allocated by the prologue (without the frame record)
+        std::uint32_t               frameSize_      = 0;
+
+        // Bitmask of registers that are written by the program (see UseReg)
+        std::uint64_t               usedRegs_       = 0;
+
+        // Locations of entry point parameters
+        std::vector<VarArgLocation> varArgs_;
+
+        // Frame pointer displacements of stack allocations
+        std::vector<std::int32_t>   stackChunkOffsets_;
+
+        // Callee-saved registers that are used by the program
+        std::vector<SavedReg>       savedRegs_;
+
+};
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
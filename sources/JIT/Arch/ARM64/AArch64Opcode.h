@@ -0,0 +1,86 @@
+/*
+ * AArch64Opcode.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_AARCH64_OPCODE_H
+#define LLGL_AARCH64_OPCODE_H
+
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+/*
+All AArch64 instructions are 32 bits wide. The opcodes below denote the fixed bits of each instruction,
+and the operands are OR'ed into their bit fields:
+------------------------------------------------------------------------
+| Field: | Rd/Rt | Rn    | Rm     | imm9    | imm12   | imm16  | hw      |
+|--------|-------|-------|--------|---------|---------|--------|---------|
+| Bits:  | 4:0   | 9:5   | 20:16  | 20:12   | 21:10   | 20:5   | 22:21   |
+------------------------------------------------------------------------
+Register index 31 denotes either SP or the zero register (XZR/WZR), depending on the instruction.
+*/
+
+enum OpcodeShift : std::uint32_t
+{
+    OpcodeShift_Rd      = 0,
+    OpcodeShift_Rn      = 5,
+    OpcodeShift_Rm      = 16,
+    OpcodeShift_Imm9    = 12,
+    OpcodeShift_Imm12   = 10,
+    OpcodeShift_Imm16   = 5,
+    OpcodeShift_HW      = 21,
+};
+
+enum Opcode : std::uint32_t
+{
+    Opcode_MovZ64           = 0xD2800000, // MOVZ Xd, #imm16, LSL #hw*16
+    Opcode_MovZ32           = 0x52800000, // MOVZ Wd, #imm16, LSL #hw*16
+    Opcode_MovN64           = 0x92800000, // MOVN Xd, #imm16, LSL #hw*16
+    Opcode_MovN32           = 0x12800000, // MOVN Wd, #imm16, LSL #hw*16
+    Opcode_MovK64           = 0xF2800000, // MOVK Xd, #imm16, LSL #hw*16
+    Opcode_MovK32           = 0x72800000, // MOVK Wd, #imm16, LSL #hw*16
+    Opcode_MovReg64         = 0xAA0003E0, // ORR Xd, XZR, Xm
+    Opcode_AddImm64         = 0x91000000, // ADD Xd|SP, Xn|SP, #imm12
+    Opcode_SubImm64         = 0xD1000000, // SUB Xd|SP, Xn|SP, #imm12
+    Opcode_AddExt64         = 0x8B206000, // ADD Xd|SP, Xn|SP, Xm, UXTX
+    Opcode_SubExt64         = 0xCB206000, // SUB Xd|SP, Xn|SP, Xm, UXTX
+    Opcode_ImmLSL12         = 0x00400000, // Shift bit for #imm12 in ADD/SUB
+    Opcode_StpFrameRecord   = 0xA9BF7BFD, // STP X29, X30, [SP, #-16]!
+    Opcode_LdpFrameRecord   = 0xA8C17BFD, // LDP X29, X30, [SP], #16
+    Opcode_Blr              = 0xD63F0000, // BLR Xn
+    Opcode_Ret              = 0xD65F03C0, // RET
+    Opcode_Brk              = 0xD4200000, // BRK #imm16
+    Opcode_FMovSW           = 0x1E270000, // FMOV Sd, Wn
+    Opcode_FMovDX           = 0x9E670000, // FMOV Dd, Xn
+    Opcode_FCvtSD           = 0x1E624000, // FCVT Sd, Dn
+    Opcode_LdrX             = 0xF9400000, // LDR Xt, [Xn|SP, #imm12*8]
+    Opcode_StrX             = 0xF9000000, // STR Xt, [Xn|SP, #imm12*8]
+    Opcode_LdrW             = 0xB9400000, // LDR Wt, [Xn|SP, #imm12*4]
+    Opcode_StrW             = 0xB9000000, // STR Wt, [Xn|SP, #imm12*4]
+    Opcode_LdrD             = 0xFD400000, // LDR Dt, [Xn|SP, #imm12*8]
+    Opcode_StrD             = 0xFD000000, // STR Dt, [Xn|SP, #imm12*8]
+    Opcode_LdrS             = 0xBD400000, // LDR St, [Xn|SP, #imm12*4]
+    Opcode_StrS             = 0xBD000000, // STR St, [Xn|SP, #imm12*4]
+    Opcode_LdrStrUnscaled   = 0x01000000, // Bit to clear for LDUR/STUR with signed #imm9 instead of unsigned #imm12
+};
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,36 @@
+/*
+ * AArch64Register.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "AArch64Register.h"
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+std::uint32_t RegBits(const Reg reg)
+{
+    /* General purpose and floating-point registers are both encoded with their index in a 5-bit field */
+    return (static_cast<std::uint32_t>(reg) & 0x1F);
+}
+
+bool IsFltReg(const Reg reg)
+{
+    return (reg >= Reg::V0 && reg <= Reg::V31);
+}
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
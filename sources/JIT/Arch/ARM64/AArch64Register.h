@@ -0,0 +1,108 @@
+/*
+ * AArch64Register.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_AARCH64_REGISTER_H
+#define LLGL_AARCH64_REGISTER_H
+
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace JIT
+{
+
+
+// AArch64 register enumeration.
+enum class Reg
+{
+    X0,
+    X1,
+    X2,
+    X3,
+    X4,
+    X5,
+    X6,
+    X7,
+    X8,
+    X9,
+    X10,
+    X11,
+    X12,
+    X13,
+    X14,
+    X15,
+    X16, // IP0
+    X17, // IP1
+    X18,
+    X19,
+    X20,
+    X21,
+    X22,
+    X23,
+    X24,
+    X25,
+    X26,
+    X27,
+    X28,
+    X29, // FP
+    X30, // LR
+    SP,  // Stack pointer or zero register (XZR), depending on the instruction
+    V0,
+    V1,
+    V2,
+    V3,
+    V4,
+    V5,
+    V6,
+    V7,
+    V8,
+    V9,
+    V10,
+    V11,
+    V12,
+    V13,
+    V14,
+    V15,
+    V16,
+    V17,
+    V18,
+    V19,
+    V20,
+    V21,
+    V22,
+    V23,
+    V24,
+    V25,
+    V26,
+    V27,
+    V28,
+    V29,
+    V30,
+    V31,
+};
+
+
+// Returns the 5-bit register field of an AArch64 instruction for the specified register.
+std::uint32_t RegBits(const Reg reg);
+
+// Returns true, if 'reg' denotes a floating-point/SIMD register (i.e. V0-V31).
+bool IsFltReg(const Reg reg);
+
+
+} // /namespace JIT
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,7 @@
 
 #include "IA32Assembler.h"
 #include "IA32Opcode.h"
+#include "../../../Core/Helper.h"
 
 
 namespace LLGL
@@ -16,40 +17,97 @@ namespace JIT
 {
 
 
+/*
+ * Internal members
+ */
+
+// SIB byte for [ESP] without index register: scale = 00, index = 100 (none), base = 100
+static const std::uint8_t g_ia32SIBNoIndex = 0x24;
+
+
+/*
+ * IA32Assembler class
+ */
+
 void IA32Assembler::Begin()
 {
-    //TODO
+    varArgOffsets_.clear();
+    stackChunkOffsets_.clear();
+
+    /* Store base stack pointer (EBP) */
+    PushReg(Reg::EBP);
+    MovReg(Reg::EBP, Reg::ESP);
+
+    /*
+    Entry point parameters remain on the stack of the caller, first parameter at [EBP+8].
+    The entry point is variadic, so integral parameters are promoted to 32 bits and floating-point parameters to 64 bits
+    */
+    std::int32_t paramOffset = 8;
+    for (auto type : GetEntryVarArgs())
+    {
+        varArgOffsets_.push_back(paramOffset);
+        paramOffset += ((type == ArgType::QWord || IsFloat(type)) ? 8 : 4);
+    }
+
+    /* Determine base pointer displacements of stack allocations */
+    std::uint32_t localStackSize = 0;
+    for (auto chunk : GetStackAllocs())
+    {
+        localStackSize = GetAlignedSize(localStackSize + chunk, 16u);
+        stackChunkOffsets_.push_back(-static_cast<std::int32_t>(localStackSize));
+    }
+
+    /* Allocate local stack; ESP is 8 bytes below a 16-byte boundary after EBP has been pushed */
+    SubImm32(Reg::ESP, localStackSize + 8);
 }
 
 void IA32Assembler::End()
 {
-    //TODO
+    /* Release local stack and restore base stack pointer (EBP) */
+    MovReg(Reg::ESP, Reg::EBP);
+    PopReg(Reg::EBP);
+    RetNear();
 }
 
-void IA32Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farCall)
+void IA32Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool /*farCall*/)
 {
-    #if 0
-    /* Write arguments */
-    for ()
-    {
+    const auto& args = GetArgs();
 
-    }
+    /* Pass 'this' pointer in ECX for '__thiscall' (MSVC only, GCC and Clang pass it as first argument on the stack) */
+    std::size_t firstStackArg = 0;
+    bool calleeCleansStack = (conv == JITCallConv::StdCall);
 
-    /* Write 'this' pointer */
-    if (conv == JITCallConv::ThisCall)
+    #ifdef _MSC_VER
+    if (conv == JITCallConv::ThisCall && !args.empty())
     {
-        if (auto ptr = GetThisPtr())
-            MovRegImm32(Reg::ECX, reinterpret_cast<std::uint32_t>(ptr));
-        else
-            throw std::runtime_error("missing 'this' pointer for '__thiscall' IA-32/x86 instruction");
+        MovRegArg(Reg::ECX, args.front());
+        firstStackArg       = 1;
+        calleeCleansStack   = true;
     }
-
-    /* Write 'call' instruction */
-    if (farCall)
-        CallFar(Reg::EAX);
-    else
-        CallNear(Reg::EAX);
     #endif
+
+    /* Keep ESP 16-byte aligned at function call (required by System V i386 ABI) */
+    std::uint32_t argStackSize = 0;
+    for (auto i = firstStackArg; i < args.size(); ++i)
+        argStackSize += GetArgStackSize(args[i]);
+
+    const auto padding = GetAlignedSize(argStackSize, 16u) - argStackSize;
+    if (padding > 0)
+        SubImm32(Reg::ESP, padding);
+
+    /* Push arguments from right to left */
+    for (auto i = args.size(); i > firstStackArg; --i)
+        PushArg(args[i - 1]);
+
+    /* Write 'call' instruction; far calls are not required in the flat memory model */
+    MovRegImm32(Reg::EAX, static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(addr)));
+    CallNear(Reg::EAX);
+
+    /* Remove arguments from stack if the callee did not */
+    if (calleeCleansStack)
+        argStackSize = 0;
+    if (argStackSize + padding > 0)
+        AddImm32(Reg::ESP, argStackSize + padding);
 }
 
 
@@ -62,6 +120,108 @@ bool IA32Assembler::IsLittleEndian() const
     return true;
 }
 
+std::uint32_t IA32Assembler::GetArgStackSize(const Arg& arg) const
+{
+    /* Single-precision entry point parameters are converted back from double-precision, see PushArg */
+    if (arg.type == ArgType::QWord || arg.type == ArgType::Double)
+        return 8;
+    else
+        return 4;
+}
+
+void IA32Assembler::PushArg(const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        if (arg.param < varArgOffsets_.size())
+        {
+            /* Copy entry point parameter from stack of the caller */
+            auto offset = varArgOffsets_[arg.param];
+            switch (arg.type)
+            {
+                case ArgType::QWord:
+                case ArgType::Double:
+                    PushMem(Reg::EBP, offset + 4);
+                    PushMem(Reg::EBP, offset);
+                    break;
+                case ArgType::Float:
+                    FldMem64(Reg::EBP, offset);
+                    SubImm32(Reg::ESP, 4);
+                    FstpMem32(Reg::ESP, 0);
+                    break;
+                default:
+                    PushMem(Reg::EBP, offset);
+                    break;
+            }
+        }
+    }
+    else
+    {
+        /* Push value onto stack */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+                PushImm32(arg.value.i8);
+                break;
+            case ArgType::Word:
+                PushImm32(arg.value.i16);
+                break;
+            case ArgType::DWord:
+            case ArgType::Ptr:
+            case ArgType::Float:
+                PushImm32(arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Double:
+                PushImm32(static_cast<std::uint32_t>(arg.value.i64 >> 32));
+                PushImm32(static_cast<std::uint32_t>(arg.value.i64 & 0xFFFFFFFF));
+                break;
+            case ArgType::StackPtr:
+                LeaRegMem(Reg::EAX, Reg::EBP, stackChunkOffsets_[arg.value.i8]);
+                PushReg(Reg::EAX);
+                break;
+        }
+    }
+}
+
+void IA32Assembler::MovRegArg(const Reg reg, const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        if (arg.param < varArgOffsets_.size())
+            MovRegMem(reg, Reg::EBP, varArgOffsets_[arg.param]);
+    }
+    else if (arg.type == ArgType::StackPtr)
+        LeaRegMem(reg, Reg::EBP, stackChunkOffsets_[arg.value.i8]);
+    else
+        MovRegImm32(reg, arg.value.i32);
+}
+
+// Writes the ModR/M byte, optional SIB byte, and optional displacement for memory addressing [baseReg + disp].
+void IA32Assembler::WriteModRMMem(std::uint8_t regBits, const Reg baseReg, std::int32_t disp)
+{
+    const auto base = RegByte(baseReg);
+
+    /* Determine displacement size; [EBP] can only be encoded with a displacement */
+    std::uint8_t mod = 0;
+    if (disp != 0 || baseReg == Reg::EBP)
+        mod = (disp >= -128 && disp <= 127 ? Operand_Mod01 : Operand_Mod10);
+
+    /* [ESP] can only be encoded with a SIB byte */
+    if (baseReg == Reg::ESP)
+    {
+        WriteByte(mod | ((regBits & 0x07) << 3) | Operand_SIB);
+        WriteByte(g_ia32SIBNoIndex);
+    }
+    else
+        WriteByte(mod | ((regBits & 0x07) << 3) | base);
+
+    if (mod == Operand_Mod01)
+        WriteByte(static_cast<std::uint8_t>(static_cast<std::int8_t>(disp)));
+    else if (mod == Operand_Mod10)
+        WriteDWord(static_cast<std::uint32_t>(disp));
+}
+
 void IA32Assembler::PushReg(const Reg reg)
 {
     WriteByte(Opcode_PushReg | RegByte(reg));
@@ -73,27 +233,79 @@ void IA32Assembler::PushImm32(std::uint32_t dword)
     WriteDWord(dword);
 }
 
+// Opcode: FF /6
+void IA32Assembler::PushMem(const Reg memReg, std::int32_t disp)
+{
+    WriteByte(Opcode_PushMem);
+    WriteModRMMem(6, memReg, disp);
+}
+
 void IA32Assembler::PopReg(const Reg reg)
 {
     WriteByte(Opcode_PopReg | RegByte(reg));
 }
 
+// Opcode: 89 /r
+void IA32Assembler::MovReg(const Reg dstReg, const Reg srcReg)
+{
+    WriteByte(Opcode_MovMemReg);
+    WriteByte(Operand_Mod11 | (RegByte(srcReg) << 3) | RegByte(dstReg));
+}
+
 void IA32Assembler::MovRegImm32(const Reg reg, std::uint32_t dword)
 {
-    WriteByte(0x48); //???
     WriteByte(Opcode_MovRegImm32 | RegByte(reg));
     WriteDWord(dword);
 }
 
-void IA32Assembler::CallNear(const Reg reg)
+// Opcode: 8B /r
+void IA32Assembler::MovRegMem(const Reg dstReg, const Reg srcMemReg, std::int32_t disp)
 {
-    WriteByte(0xFF);
-    WriteByte(Opcode_CallNear | RegByte(reg));
+    WriteByte(Opcode_MovRegMem);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
 }
 
-void IA32Assembler::CallFar(const Reg reg)
+// Opcode: 8D /r
+void IA32Assembler::LeaRegMem(const Reg dstReg, const Reg srcMemReg, std::int32_t disp)
 {
-    //TODO
+    WriteByte(Opcode_LeaRegMem);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
+}
+
+// Opcode: DD /0
+void IA32Assembler::FldMem64(const Reg memReg, std::int32_t disp)
+{
+    WriteByte(Opcode_FldMem64);
+    WriteModRMMem(0, memReg, disp);
+}
+
+// Opcode: D9 /3
+void IA32Assembler::FstpMem32(const Reg memReg, std::int32_t disp)
+{
+    WriteByte(Opcode_FstpMem32);
+    WriteModRMMem(3, memReg, disp);
+}
+
+// Opcode: 81 /0 id
+void IA32Assembler::AddImm32(const Reg reg, std::uint32_t dword)
+{
+    WriteByte(Opcode_AddImm);
+    WriteByte(Operand_Mod11 | RegByte(reg));
+    WriteDWord(dword);
+}
+
+// Opcode: 81 /5 id
+void IA32Assembler::SubImm32(const Reg reg, std::uint32_t dword)
+{
+    WriteByte(Opcode_SubImm);
+    WriteByte(Operand_Mod11 | (5u << 3) | RegByte(reg));
+    WriteDWord(dword);
+}
+
+void IA32Assembler::CallNear(const Reg reg)
+{
+    WriteByte(0xFF);
+    WriteByte(Opcode_CallNear | RegByte(reg));
 }
 
 void IA32Assembler::RetNear(std::uint16_t word)
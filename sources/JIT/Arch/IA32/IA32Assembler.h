@@ -36,21 +36,47 @@ class IA32Assembler final : public JITCompiler
         bool IsLittleEndian() const override;
         void WriteFuncCall(const void* addr, JITCallConv conv, bool farCall) override;
 
+    private:
+
+        std::uint32_t GetArgStackSize(const Arg& arg) const;
+
+        void PushArg(const Arg& arg);
+        void MovRegArg(const Reg reg, const Arg& arg);
+
+        void WriteModRMMem(std::uint8_t regBits, const Reg baseReg, std::int32_t disp);
+
     private:
 
         void PushReg(const Reg reg);
         void PushImm32(std::uint32_t dword);
+        void PushMem(const Reg memReg, std::int32_t disp);
 
         void PopReg(const Reg reg);
 
+        void MovReg(const Reg dstReg, const Reg srcReg);
         void MovRegImm32(const Reg reg, std::uint32_t dword);
+        void MovRegMem(const Reg dstReg, const Reg srcMemReg, std::int32_t disp);
+        void LeaRegMem(const Reg dstReg, const Reg srcMemReg, std::int32_t disp);
+
+        void FldMem64(const Reg memReg, std::int32_t disp);
+        void FstpMem32(const Reg memReg, std::int32_t disp);
+
+        void AddImm32(const Reg reg, std::uint32_t dword);
+        void SubImm32(const Reg reg, std::uint32_t dword);
 
         void CallNear(const Reg reg);
-        void CallFar(const Reg reg);
 
         void RetNear(std::uint16_t word = 0);
         void RetFar(std::uint16_t word = 0);
 
+    private:
+
+        // Base pointer displacements of entry point parameters
+        std::vector<std::int32_t>   varArgOffsets_;
+
+        // Base pointer displacements of stack allocations
+        std::vector<std::int32_t>   stackChunkOffsets_;
+
 };
 
 
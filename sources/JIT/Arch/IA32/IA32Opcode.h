@@ -21,18 +21,34 @@ namespace JIT
 {
 
 
+enum ModRMBits : std::uint8_t
+{
+    Operand_Mod01   = 0x40, // disp8
+    Operand_Mod10   = 0x80, // disp32
+    Operand_Mod11   = 0xC0, // direct addressing
+    Operand_SIB     = 0x04, // 00 000 100
+};
+
 enum Opcode : std::uint8_t
 {
     Opcode_PushReg      = 0x50,
     Opcode_PopReg       = 0x58,
     Opcode_PushImm32    = 0x68,
+    Opcode_PushMem      = 0xFF, // FF /6
+    Opcode_AddImm       = 0x81, // 81 /0 id
+    Opcode_SubImm       = 0x81, // 81 /5 id
+    Opcode_MovMemReg    = 0x89, // 89 /r
+    Opcode_MovRegMem    = 0x8B, // 8B /r
+    Opcode_LeaRegMem    = 0x8D, // 8D /r
     Opcode_MovRegImm32  = 0xB8, // B8+ rd id
+    Opcode_FldMem32     = 0xD9, // D9 /0
+    Opcode_FstpMem32    = 0xD9, // D9 /3
+    Opcode_FldMem64     = 0xDD, // DD /0
     Opcode_RetNear      = 0xC3, // C3
     Opcode_RetFar       = 0xCB, // CB
     Opcode_RetNearImm16 = 0xC2, // C2 iw
     Opcode_RetFarImm16  = 0xCA, // CA iw
-    Opcode_CallNear     = 0xD0,
-    //OpCode_CallFar      = 0xE0,
+    Opcode_CallNear     = 0xD0, // FF /2 => 11 010 000 => 0xD0
 };
 
 
@@ -17,8 +17,10 @@
 #   include "Platform/POSIX/POSIXJITProgram.h"
 #endif
 
-#if defined LLGL_ARCH_ARM
-//#   include "Arch/ARM/ARMAssembler.h"
+#if defined LLGL_ARCH_ARM64
+#   if defined LLGL_ENABLE_JIT_COMPILER_ARM64
+#       include "Arch/ARM64/AArch64Assembler.h"
+#   endif
 #elif defined LLGL_ARCH_AMD64
 #   include "Arch/AMD64/AMD64Assembler.h"
 #elif defined LLGL_ARCH_IA32
@@ -37,8 +39,14 @@ std::unique_ptr<JITCompiler> JITCompiler::Create()
     std::unique_ptr<JITCompiler> compiler;
 
     /* Create JIT compiler for current CPU architecture */
-    #if defined LLGL_ARCH_ARM
-    //TODO
+    #if defined LLGL_ARCH_ARM64
+    #   if defined LLGL_ENABLE_JIT_COMPILER_ARM64 && (defined LLGL_OS_LINUX || defined LLGL_OS_ANDROID)
+    /*
+    The AArch64 backend has not been executed on hardware or an emulator yet, so it is only selected with LLGL_ENABLE_JIT_COMPILER_ARM64.
+    Apple and Windows deviate from AAPCS64 for variadic arguments, which are used by the entry point.
+    */
+    compiler = MakeUnique<AArch64Assembler>();
+    #   endif
     #elif defined LLGL_ARCH_AMD64
     compiler = MakeUnique<AMD64Assembler>();
     #elif defined LLGL_ARCH_IA32
@@ -242,7 +250,6 @@ void JITCompiler::PushSSizeT(std::int64_t value)
 
 void JITCompiler::Write(const void* data, std::size_t size)
 {
-    assembly_.reserve(assembly_.size() + size);
     auto byteAlignedData = reinterpret_cast<const std::int8_t*>(data);
     #if 0
     if (littleEndian_)
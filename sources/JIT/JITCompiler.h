@@ -63,6 +63,12 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
         // Flushes the currently build program, or null if no program was build.
         std::unique_ptr<JITProgram> FlushProgram();
 
+        // Returns the size (in bytes) of the current assembly code.
+        inline std::size_t GetAssemblySize() const
+        {
+            return assembly_.size();
+        }
+
     public:
 
         // Stores the parameter list of the secified types for the program entry points (must be called before 'Begin').
@@ -118,16 +124,16 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
 
         /*
         Encodes a member function call with the specified variadic arguments.
-        \param[in] func Specifies the function object. This must be a global non-overloaded function.
+        \param[in] func Specifies the member function object. This must be a non-virtual and non-overloaded member function.
         \param[in] inst Specifies the class instance on which the member function is to be called.
         \param[in] args Specifies the argument list. Only pointers, integrals and floating-point types are allowed (no references).
         */
         template <typename Func, typename Inst, typename... Args>
         void CallMember(Func&& func, Inst&& inst, Args&&... args)
         {
-            PushVariant(std::forward<Inst>(inst));//TODO: PushThisPtr(inst);
+            PushVariant(std::forward<Inst>(inst));
             PushArgs(std::forward<Args>(args)...);
-            FuncCall(GetMemberFuncPtr(func));
+            FuncCall(GetMemberFuncPtr(func), JITCallConv::ThisCall);
         }
 
     protected:
@@ -10,7 +10,7 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <unistd.h> // sysconf
-#include <sys/mman.h> // mmap
+#include <sys/mman.h> // mmap, mprotect
 
 
 namespace LLGL
@@ -25,29 +25,40 @@ std::unique_ptr<JITProgram> JITProgram::Create(const void* code, std::size_t siz
 POSIXJITProgram::POSIXJITProgram(const void* code, std::size_t size) :
     size_ { GetAlignedSize(size, std::size_t(sysconf(_SC_PAGE_SIZE))) }
 {
-    /* Map executable memory space */
+    /* Map writable memory space; it is made executable after the code has been copied */
     addr_ = ::mmap(
         nullptr,
         size_,
-        (PROT_READ | PROT_WRITE | PROT_EXEC),
+        (PROT_READ | PROT_WRITE),
         (MAP_PRIVATE | MAP_ANONYMOUS),
         -1, // must be -1 if MAP_ANONYMOUS is used
         0
     );
     
     if (addr_ == MAP_FAILED)
-        throw std::runtime_error("failed to map executable virtual memory with read/write protection mode");
+        throw std::runtime_error("failed to map virtual memory with read/write protection mode");
     
-    /* Copy code into executable memory space */
+    /* Copy code into memory space */
     ::memcpy(addr_, code, size);
 
+    /* Make memory space executable; systems with W^X policy reject mappings that are writable and executable at the same time */
+    if (::mprotect(addr_, size_, (PROT_READ | PROT_EXEC)) != 0)
+    {
+        ::munmap(addr_, size_);
+        throw std::runtime_error("failed to change protection mode of virtual memory to read/execute");
+    }
+
+    /* Flush instruction cache; required on ARM whose instruction and data caches are not coherent, no-op on x86 */
+    char* codeBegin = reinterpret_cast<char*>(addr_);
+    __builtin___clear_cache(codeBegin, codeBegin + size);
+
     /* Set function pointer to executable memory address */
     SetEntryPoint(addr_);
 }
 
-POSIXJITProgram::POSIXJITProgram()
+POSIXJITProgram::~POSIXJITProgram()
 {
-    munmap(addr_, size_);
+    ::munmap(addr_, size_);
 }
 
 
@@ -49,6 +49,11 @@ void DbgRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
     instance_->SetConfiguration(config);
 }
 
+bool DbgRenderSystem::QueryMemoryStatistics(MemoryStatistics& stats)
+{
+    return instance_->QueryMemoryStatistics(stats);
+}
+
 /* ----- Render Context ----- */
 
 RenderContext* DbgRenderSystem::CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface)
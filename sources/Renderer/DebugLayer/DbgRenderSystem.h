@@ -44,6 +44,8 @@ class DbgRenderSystem final : public RenderSystem
 
         void SetConfiguration(const RenderSystemConfiguration& config) override;
 
+        bool QueryMemoryStatistics(MemoryStatistics& stats) override;
+
         /* ----- Render Context ------ */
 
         RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
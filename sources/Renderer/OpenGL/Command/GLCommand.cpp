@@ -0,0 +1,123 @@
+/*
+ * GLCommand.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommand.h"
+
+
+namespace LLGL
+{
+
+
+std::size_t GetGLCommandSize(const GLOpcode opcode, const void* pc)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBufferSubData:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case GLOpcodeCopyBufferSubData:                             return sizeof(GLCmdCopyBufferSubData);
+        case GLOpcodeClearBufferData:                               return sizeof(GLCmdClearBufferData);
+        case GLOpcodeClearBufferSubData:                            return sizeof(GLCmdClearBufferSubData);
+        case GLOpcodeCopyImageSubData:                              return sizeof(GLCmdCopyImageSubData);
+        case GLOpcodeCopyImageToBuffer:                             return sizeof(GLCmdCopyImageBuffer);
+        case GLOpcodeCopyImageFromBuffer:                           return sizeof(GLCmdCopyImageBuffer);
+        case GLOpcodeGenerateMipmap:                                return sizeof(GLCmdGenerateMipmap);
+        case GLOpcodeGenerateMipmapSubresource:                     return sizeof(GLCmdGenerateMipmapSubresource);
+        case GLOpcodeExecute:                                       return sizeof(GLCmdExecute);
+        case GLOpcodeSetAPIDepState:                                return sizeof(GLCmdSetAPIDepState);
+        case GLOpcodeViewport:                                      return sizeof(GLCmdViewport);
+        case GLOpcodeViewportArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
+            return (sizeof(*cmd) + (sizeof(GLViewport) + sizeof(GLDepthRange))*cmd->count);
+        }
+        case GLOpcodeScissor:                                       return sizeof(GLCmdScissor);
+        case GLOpcodeScissorArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
+            return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+        }
+        case GLOpcodeClearColor:                                    return sizeof(GLCmdClearColor);
+        case GLOpcodeClearDepth:                                    return sizeof(GLCmdClearDepth);
+        case GLOpcodeClearStencil:                                  return sizeof(GLCmdClearStencil);
+        case GLOpcodeClear:                                         return sizeof(GLCmdClear);
+        case GLOpcodeClearBuffers:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
+        }
+        case GLOpcodeBindVertexArray:                               return sizeof(GLCmdBindVertexArray);
+        case GLOpcodeBindGL2XVertexArray:                           return sizeof(GLCmdBindGL2XVertexArray);
+        case GLOpcodeBindElementArrayBufferToVAO:                   return sizeof(GLCmdBindElementArrayBufferToVAO);
+        case GLOpcodeBindBufferBase:                                return sizeof(GLCmdBindBufferBase);
+        case GLOpcodeBindBuffersBase:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+            return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+        }
+        case GLOpcodeBeginTransformFeedback:                        return sizeof(GLCmdBeginTransformFeedback);
+        case GLOpcodeBeginTransformFeedbackNV:                      return sizeof(GLCmdBeginTransformFeedbackNV);
+        case GLOpcodeEndTransformFeedback:                          return 0;
+        case GLOpcodeEndTransformFeedbackNV:                        return 0;
+        case GLOpcodeBindResourceHeap:                              return sizeof(GLCmdBindResourceHeap);
+        case GLOpcodeBindRenderPass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindRenderPass*>(pc);
+            return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+        }
+        case GLOpcodeBindPipelineState:                             return sizeof(GLCmdBindPipelineState);
+        case GLOpcodeSetBlendColor:                                 return sizeof(GLCmdSetBlendColor);
+        case GLOpcodeSetStencilRef:                                 return sizeof(GLCmdSetStencilRef);
+        case GLOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case GLOpcodeBeginQuery:                                    return sizeof(GLCmdBeginQuery);
+        case GLOpcodeEndQuery:                                      return sizeof(GLCmdEndQuery);
+        case GLOpcodeBeginConditionalRender:                        return sizeof(GLCmdBeginConditionalRender);
+        case GLOpcodeEndConditionalRender:                          return 0;
+        case GLOpcodeDrawArrays:                                    return sizeof(GLCmdDrawArrays);
+        case GLOpcodeDrawArraysInstanced:                           return sizeof(GLCmdDrawArraysInstanced);
+        case GLOpcodeDrawArraysInstancedBaseInstance:               return sizeof(GLCmdDrawArraysInstancedBaseInstance);
+        case GLOpcodeDrawArraysIndirect:                            return sizeof(GLCmdDrawArraysIndirect);
+        case GLOpcodeDrawElements:                                  return sizeof(GLCmdDrawElements);
+        case GLOpcodeDrawElementsBaseVertex:                        return sizeof(GLCmdDrawElementsBaseVertex);
+        case GLOpcodeDrawElementsInstanced:                         return sizeof(GLCmdDrawElementsInstanced);
+        case GLOpcodeDrawElementsInstancedBaseVertex:               return sizeof(GLCmdDrawElementsInstancedBaseVertex);
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:   return sizeof(GLCmdDrawElementsInstancedBaseVertexBaseInstance);
+        case GLOpcodeDrawElementsIndirect:                          return sizeof(GLCmdDrawElementsIndirect);
+        case GLOpcodeMultiDrawArrays:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawArrays*>(pc);
+            return (sizeof(*cmd) + (sizeof(GLint) + sizeof(GLsizei))*cmd->drawcount);
+        }
+        case GLOpcodeMultiDrawArraysIndirect:                       return sizeof(GLCmdMultiDrawArraysIndirect);
+        case GLOpcodeMultiDrawElementsIndirect:                     return sizeof(GLCmdMultiDrawElementsIndirect);
+        case GLOpcodeDispatchCompute:                               return sizeof(GLCmdDispatchCompute);
+        case GLOpcodeDispatchComputeIndirect:                       return sizeof(GLCmdDispatchComputeIndirect);
+        case GLOpcodeBindTexture:                                   return sizeof(GLCmdBindTexture);
+        case GLOpcodeBindSampler:                                   return sizeof(GLCmdBindSampler);
+        case GLOpcodeUnbindResources:                               return sizeof(GLCmdUnbindResources);
+        case GLOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            return (sizeof(*cmd) + cmd->length + 1);
+        }
+        case GLOpcodePopDebugGroup:                                 return 0;
+        default:                                                    return 0;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
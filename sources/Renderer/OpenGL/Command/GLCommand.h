@@ -14,6 +14,7 @@
 #include <LLGL/Types.h>
 #include "../RenderState/GLState.h"
 #include "../GLProfile.h"
+#include "GLCommandOpcode.h"
 #include <cstdint>
 
 
@@ -359,6 +360,14 @@ struct GLCmdDrawElementsIndirect
     std::uint32_t   stride;
 };
 
+struct GLCmdMultiDrawArrays
+{
+    GLenum      mode;
+    GLsizei     drawcount;
+//  GLint       first[drawcount];
+//  GLsizei     count[drawcount];
+};
+
 struct GLCmdMultiDrawArraysIndirect
 {
     GLuint          id;
@@ -431,6 +440,10 @@ struct GLCmdPushDebugGroup
 //struct GLCmdPopDebugGroup {};
 
 
+// Returns the size (in bytes) of the specified command without its opcode.
+std::size_t GetGLCommandSize(const GLOpcode opcode, const void* pc);
+
+
 } // /namespace LLGL
 
 
@@ -8,6 +8,7 @@
 #include "GLCommandExecutor.h"
 #include "GLCommand.h"
 #include "GLDeferredCommandBuffer.h"
+#include "GLCommandPagePool.h"
 
 #include "../GLRenderContext.h"
 #include "../GLTypes.h"
@@ -36,6 +37,8 @@
 
 #include <LLGL/StaticLimits.h>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 #include <string.h>
 
 #ifdef LLGL_ENABLE_JIT_COMPILER
@@ -47,461 +50,666 @@ namespace LLGL
 {
 
 
+static std::size_t ExecuteGLCmdBufferSubData(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(pc);
+    cmd->buffer->BufferSubData(cmd->offset, cmd->size, cmd + 1);
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t ExecuteGLCmdCopyBufferSubData(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdCopyBufferSubData*>(pc);
+    cmd->writeBuffer->CopyBufferSubData(*(cmd->readBuffer), cmd->readOffset, cmd->writeOffset, cmd->size);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdClearBufferData(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearBufferData*>(pc);
+    cmd->buffer->ClearBufferData(cmd->data);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdClearBufferSubData(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearBufferSubData*>(pc);
+    cmd->buffer->ClearBufferSubData(cmd->offset, cmd->size, cmd->data);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdCopyImageSubData(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdCopyImageSubData*>(pc);
+    cmd->dstTexture->CopyImageSubData(cmd->dstLevel, cmd->dstOffset, *(cmd->srcTexture), cmd->srcLevel, cmd->srcOffset, cmd->extent);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdCopyImageToBuffer(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdCopyImageBuffer*>(pc);
+    cmd->texture->CopyImageToBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdCopyImageFromBuffer(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdCopyImageBuffer*>(pc);
+    cmd->texture->CopyImageFromBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdGenerateMipmap(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdGenerateMipmap*>(pc);
+    GLMipGenerator::Get().GenerateMipsForTexture(stateMngr, *(cmd->texture));
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdGenerateMipmapSubresource(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdGenerateMipmapSubresource*>(pc);
+    GLMipGenerator::Get().GenerateMipsRangeForTexture(stateMngr, *(cmd->texture), cmd->baseMipLevel, cmd->numMipLevels, cmd->baseArrayLayer, cmd->numArrayLayers);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdExecute(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdExecute*>(pc);
+    ExecuteGLDeferredCommandBuffer(*(cmd->commandBuffer), stateMngr);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdSetAPIDepState(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdSetAPIDepState*>(pc);
+    stateMngr.SetGraphicsAPIDependentState(cmd->desc);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdViewport(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
+    {
+        GLViewport viewport = cmd->viewport;
+        stateMngr.SetViewport(viewport);
+
+        GLDepthRange depthRange = cmd->depthRange;
+        stateMngr.SetDepthRange(depthRange);
+    }
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdViewportArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
+    auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
+    {
+        union
+        {
+            GLViewport viewports[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+            GLDepthRange depthRanges[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+        };
+
+        ::memcpy(viewports, cmdData, sizeof(GLViewport)*cmd->count);
+        stateMngr.SetViewportArray(cmd->first, cmd->count, viewports);
+
+        ::memcpy(depthRanges, cmdData + sizeof(GLViewport)*cmd->count, sizeof(GLDepthRange)*cmd->count);
+        stateMngr.SetDepthRangeArray(cmd->first, cmd->count, depthRanges);
+    }
+    return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
+}
+
+static std::size_t ExecuteGLCmdScissor(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
+    {
+        GLScissor scissor = cmd->scissor;
+        stateMngr.SetScissor(scissor);
+    }
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdScissorArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
+    auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
+    {
+        GLScissor scissors[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
+        ::memcpy(scissors, cmdData, sizeof(GLScissor)*cmd->count);
+        stateMngr.SetScissorArray(cmd->first, cmd->count, scissors);
+    }
+    return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+}
+
+static std::size_t ExecuteGLCmdClearColor(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearColor*>(pc);
+    glClearColor(cmd->color[0], cmd->color[1], cmd->color[2], cmd->color[3]);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdClearDepth(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearDepth*>(pc);
+    GLProfile::ClearDepth(cmd->depth);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdClearStencil(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearStencil*>(pc);
+    glClearStencil(cmd->stencil);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdClear(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdClear*>(pc);
+    stateMngr.Clear(cmd->flags);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdClearBuffers(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
+    stateMngr.ClearBuffers(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
+    return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
+}
+
+static std::size_t ExecuteGLCmdBindVertexArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
+    stateMngr.BindVertexArray(cmd->vao);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBindGL2XVertexArray(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindGL2XVertexArray*>(pc);
+    cmd->vertexArrayGL2X->Bind(stateMngr);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBindElementArrayBufferToVAO(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
+    stateMngr.BindElementArrayBufferToVAO(cmd->id, cmd->indexType16Bits);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBindBufferBase(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
+    stateMngr.BindBufferBase(cmd->target, cmd->index, cmd->id);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBindBuffersBase(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+    stateMngr.BindBuffersBase(cmd->target, cmd->first, cmd->count, reinterpret_cast<const GLuint*>(cmd + 1));
+    return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+}
+
+static std::size_t ExecuteGLCmdBeginTransformFeedback(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedback*>(pc);
+    glBeginTransformFeedback(cmd->primitiveMove);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBeginTransformFeedbackNV(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
+    #ifdef GL_NV_transform_feedback
+    glBeginTransformFeedbackNV(cmd->primitiveMove);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdEndTransformFeedback(const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    glEndTransformFeedback();
+    return 0;
+}
+
+static std::size_t ExecuteGLCmdEndTransformFeedbackNV(const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    #ifdef GL_NV_transform_feedback
+    glEndTransformFeedbackNV();
+    #endif
+    return 0;
+}
+
+static std::size_t ExecuteGLCmdBindResourceHeap(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
+    cmd->resourceHeap->Bind(stateMngr, cmd->firstSet);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBindRenderPass(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindRenderPass*>(pc);
+    stateMngr.BindRenderPass(*(cmd->renderTarget), cmd->renderPass, cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1), cmd->defaultClearValue);
+    return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+}
+
+static std::size_t ExecuteGLCmdBindPipelineState(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
+    cmd->pipelineState->Bind(stateMngr);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdSetBlendColor(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdSetBlendColor*>(pc);
+    stateMngr.SetBlendColor(cmd->color);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdSetStencilRef(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdSetStencilRef*>(pc);
+    stateMngr.SetStencilRef(cmd->ref, cmd->face);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdSetUniforms(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
+    GLSetUniformsByLocation(cmd->program, cmd->location, cmd->count, (cmd + 1));
+    return (sizeof(*cmd) + cmd->size);
+}
+
+static std::size_t ExecuteGLCmdBeginQuery(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
+    cmd->queryHeap->Begin(cmd->query);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdEndQuery(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdEndQuery*>(pc);
+    cmd->queryHeap->End(cmd->query);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBeginConditionalRender(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdBeginConditionalRender*>(pc);
+    #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
+    glBeginConditionalRender(cmd->id, cmd->mode);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdEndConditionalRender(const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
+    glEndConditionalRender();
+    #endif
+    return 0;
+}
+
+static std::size_t ExecuteGLCmdDrawArrays(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
+    glDrawArrays(cmd->mode, cmd->first, cmd->count);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawArraysInstanced(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
+    glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawArraysInstancedBaseInstance(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
+    #ifdef LLGL_GLEXT_BASE_INSTANCE
+    glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawArraysIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
+    #ifdef LLGL_GLEXT_DRAW_INDIRECT
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    GLintptr offset = cmd->indirect;
+    for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
+    {
+        glDrawArraysIndirect(cmd->mode, reinterpret_cast<const GLvoid*>(offset));
+        offset += cmd->stride;
+    }
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawElements(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
+    glDrawElements(cmd->mode, cmd->count, cmd->type, cmd->indices);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawElementsBaseVertex(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
+    #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+    glDrawElementsBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawElementsInstanced(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
+    glDrawElementsInstanced(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawElementsInstancedBaseVertex(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
+    #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+    glDrawElementsInstancedBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawElementsInstancedBaseVertexBaseInstance(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
+    #ifdef LLGL_GLEXT_BASE_INSTANCE
+    glDrawElementsInstancedBaseVertexBaseInstance(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDrawElementsIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
+    #ifdef LLGL_GLEXT_DRAW_INDIRECT
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    GLintptr offset = cmd->indirect;
+    for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
+    {
+        glDrawElementsIndirect(cmd->mode, cmd->type, reinterpret_cast<const GLvoid*>(offset));
+        offset += cmd->stride;
+    }
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdMultiDrawArrays(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdMultiDrawArrays*>(pc);
+    #ifdef LLGL_GLEXT_MULTI_DRAW_ARRAYS
+    auto first = reinterpret_cast<const GLint*>(cmd + 1);
+    auto count = reinterpret_cast<const GLsizei*>(first + cmd->drawcount);
+    glMultiDrawArrays(cmd->mode, first, count, cmd->drawcount);
+    #endif
+    return (sizeof(*cmd) + (sizeof(GLint) + sizeof(GLsizei))*cmd->drawcount);
+}
+
+static std::size_t ExecuteGLCmdMultiDrawArraysIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    glMultiDrawArraysIndirect(cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdMultiDrawElementsIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
+    glMultiDrawElementsIndirect(cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDispatchCompute(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
+    #ifdef LLGL_GLEXT_COMPUTE_SHADER
+    glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdDispatchComputeIndirect(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
+    #ifdef LLGL_GLEXT_COMPUTE_SHADER
+    stateMngr.BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
+    glDispatchComputeIndirect(cmd->indirect);
+    #endif
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBindTexture(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
+    stateMngr.ActiveTexture(cmd->slot);
+    stateMngr.BindGLTexture(*(cmd->texture));
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdBindSampler(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
+    stateMngr.BindSampler(cmd->slot, cmd->sampler);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdUnbindResources(const void* pc, GLStateManager& stateMngr)
+{
+    auto cmd = reinterpret_cast<const GLCmdUnbindResources*>(pc);
+    if (cmd->resetUBO)
+        stateMngr.UnbindBuffersBase(GLBufferTarget::UNIFORM_BUFFER, cmd->first, cmd->count);
+    if (cmd->resetSSAO)
+        stateMngr.UnbindBuffersBase(GLBufferTarget::SHADER_STORAGE_BUFFER, cmd->first, cmd->count);
+    if (cmd->resetTransformFeedback)
+        stateMngr.UnbindBuffersBase(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, cmd->first, cmd->count);
+    if (cmd->resetTextures)
+        stateMngr.UnbindTextures(cmd->first, cmd->count);
+    if (cmd->resetImages)
+        stateMngr.UnbindImageTextures(cmd->first, cmd->count);
+    if (cmd->resetSamplers)
+        stateMngr.UnbindSamplers(cmd->first, cmd->count);
+    return sizeof(*cmd);
+}
+
+static std::size_t ExecuteGLCmdPushDebugGroup(const void* pc, GLStateManager& /*stateMngr*/)
+{
+    auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+    #ifdef LLGL_GLEXT_DEBUG
+    glPushDebugGroup(cmd->source, cmd->id, cmd->length, reinterpret_cast<const GLchar*>(cmd + 1));
+    #endif
+    return (sizeof(*cmd) + cmd->length + 1);
+}
+
+static std::size_t ExecuteGLCmdPopDebugGroup(const void* /*pc*/, GLStateManager& /*stateMngr*/)
+{
+    #ifdef LLGL_GLEXT_DEBUG
+    glPopDebugGroup();
+    #endif
+    return 0;
+}
+
 static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLStateManager& stateMngr)
 {
     switch (opcode)
     {
-        case GLOpcodeBufferSubData:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(pc);
-            cmd->buffer->BufferSubData(cmd->offset, cmd->size, cmd + 1);
-            return (sizeof(*cmd) + cmd->size);
-        }
-        case GLOpcodeCopyBufferSubData:
-        {
-            auto cmd = reinterpret_cast<const GLCmdCopyBufferSubData*>(pc);
-            cmd->writeBuffer->CopyBufferSubData(*(cmd->readBuffer), cmd->readOffset, cmd->writeOffset, cmd->size);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearBufferData:
-        {
-            auto cmd = reinterpret_cast<const GLCmdClearBufferData*>(pc);
-            cmd->buffer->ClearBufferData(cmd->data);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearBufferSubData:
-        {
-            auto cmd = reinterpret_cast<const GLCmdClearBufferSubData*>(pc);
-            cmd->buffer->ClearBufferSubData(cmd->offset, cmd->size, cmd->data);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeCopyImageSubData:
-        {
-            auto cmd = reinterpret_cast<const GLCmdCopyImageSubData*>(pc);
-            cmd->dstTexture->CopyImageSubData(cmd->dstLevel, cmd->dstOffset, *(cmd->srcTexture), cmd->srcLevel, cmd->srcOffset, cmd->extent);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeCopyImageToBuffer:
-        {
-            auto cmd = reinterpret_cast<const GLCmdCopyImageBuffer*>(pc);
-            cmd->texture->CopyImageToBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeCopyImageFromBuffer:
-        {
-            auto cmd = reinterpret_cast<const GLCmdCopyImageBuffer*>(pc);
-            cmd->texture->CopyImageFromBuffer(cmd->region, cmd->bufferID, cmd->offset, cmd->size, cmd->rowLength, cmd->imageHeight);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeGenerateMipmap:
-        {
-            auto cmd = reinterpret_cast<const GLCmdGenerateMipmap*>(pc);
-            GLMipGenerator::Get().GenerateMipsForTexture(stateMngr, *(cmd->texture));
-            return sizeof(*cmd);
-        }
-        case GLOpcodeGenerateMipmapSubresource:
-        {
-            auto cmd = reinterpret_cast<const GLCmdGenerateMipmapSubresource*>(pc);
-            GLMipGenerator::Get().GenerateMipsRangeForTexture(stateMngr, *(cmd->texture), cmd->baseMipLevel, cmd->numMipLevels, cmd->baseArrayLayer, cmd->numArrayLayers);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeExecute:
-        {
-            auto cmd = reinterpret_cast<const GLCmdExecute*>(pc);
-            ExecuteGLDeferredCommandBuffer(*(cmd->commandBuffer), stateMngr);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeSetAPIDepState:
-        {
-            auto cmd = reinterpret_cast<const GLCmdSetAPIDepState*>(pc);
-            stateMngr.SetGraphicsAPIDependentState(cmd->desc);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeViewport:
-        {
-            auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
-            {
-                GLViewport viewport = cmd->viewport;
-                stateMngr.SetViewport(viewport);
-
-                GLDepthRange depthRange = cmd->depthRange;
-                stateMngr.SetDepthRange(depthRange);
-            }
-            return sizeof(*cmd);
-        }
-        case GLOpcodeViewportArray:
-        {
-            auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
-            auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
-            {
-                union
-                {
-                    GLViewport viewports[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
-                    GLDepthRange depthRanges[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
-                };
-
-                ::memcpy(viewports, cmdData, sizeof(GLViewport)*cmd->count);
-                stateMngr.SetViewportArray(cmd->first, cmd->count, viewports);
-
-                ::memcpy(depthRanges, cmdData + sizeof(GLViewport)*cmd->count, sizeof(GLDepthRange)*cmd->count);
-                stateMngr.SetDepthRangeArray(cmd->first, cmd->count, depthRanges);
-            }
-            return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
-        }
-        case GLOpcodeScissor:
-        {
-            auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
-            {
-                GLScissor scissor = cmd->scissor;
-                stateMngr.SetScissor(scissor);
-            }
-            return sizeof(*cmd);
-        }
-        case GLOpcodeScissorArray:
-        {
-            auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
-            auto cmdData = reinterpret_cast<const std::int8_t*>(cmd + 1);
-            {
-                GLScissor scissors[LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS];
-                ::memcpy(scissors, cmdData, sizeof(GLScissor)*cmd->count);
-                stateMngr.SetScissorArray(cmd->first, cmd->count, scissors);
-            }
-            return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
-        }
-        case GLOpcodeClearColor:
-        {
-            auto cmd = reinterpret_cast<const GLCmdClearColor*>(pc);
-            glClearColor(cmd->color[0], cmd->color[1], cmd->color[2], cmd->color[3]);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearDepth:
-        {
-            auto cmd = reinterpret_cast<const GLCmdClearDepth*>(pc);
-            GLProfile::ClearDepth(cmd->depth);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearStencil:
-        {
-            auto cmd = reinterpret_cast<const GLCmdClearStencil*>(pc);
-            glClearStencil(cmd->stencil);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClear:
-        {
-            auto cmd = reinterpret_cast<const GLCmdClear*>(pc);
-            stateMngr.Clear(cmd->flags);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeClearBuffers:
-        {
-            auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
-            stateMngr.ClearBuffers(cmd->numAttachments, reinterpret_cast<const AttachmentClear*>(cmd + 1));
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindVertexArray:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
-            stateMngr.BindVertexArray(cmd->vao);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindGL2XVertexArray:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindGL2XVertexArray*>(pc);
-            cmd->vertexArrayGL2X->Bind(stateMngr);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindElementArrayBufferToVAO:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindElementArrayBufferToVAO*>(pc);
-            stateMngr.BindElementArrayBufferToVAO(cmd->id, cmd->indexType16Bits);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindBufferBase:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
-            stateMngr.BindBufferBase(cmd->target, cmd->index, cmd->id);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindBuffersBase:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
-            stateMngr.BindBuffersBase(cmd->target, cmd->first, cmd->count, reinterpret_cast<const GLuint*>(cmd + 1));
-            return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
-        }
-        case GLOpcodeBeginTransformFeedback:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedback*>(pc);
-            glBeginTransformFeedback(cmd->primitiveMove);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBeginTransformFeedbackNV:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
-            #ifdef GL_NV_transform_feedback
-            glBeginTransformFeedbackNV(cmd->primitiveMove);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeEndTransformFeedback:
-        {
-            glEndTransformFeedback();
-            return 0;
-        }
-        case GLOpcodeEndTransformFeedbackNV:
-        {
-            #ifdef GL_NV_transform_feedback
-            glEndTransformFeedbackNV();
-            #endif
-            return 0;
-        }
-        case GLOpcodeBindResourceHeap:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
-            cmd->resourceHeap->Bind(stateMngr, cmd->firstSet);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindRenderPass:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindRenderPass*>(pc);
-            stateMngr.BindRenderPass(*(cmd->renderTarget), cmd->renderPass, cmd->numClearValues, reinterpret_cast<const ClearValue*>(cmd + 1), cmd->defaultClearValue);
-            return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
-        }
-        case GLOpcodeBindPipelineState:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
-            cmd->pipelineState->Bind(stateMngr);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeSetBlendColor:
-        {
-            auto cmd = reinterpret_cast<const GLCmdSetBlendColor*>(pc);
-            stateMngr.SetBlendColor(cmd->color);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeSetStencilRef:
-        {
-            auto cmd = reinterpret_cast<const GLCmdSetStencilRef*>(pc);
-            stateMngr.SetStencilRef(cmd->ref, cmd->face);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeSetUniforms:
-        {
-            auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
-            GLSetUniformsByLocation(cmd->program, cmd->location, cmd->count, (cmd + 1));
-            return (sizeof(*cmd) + cmd->size);
-        }
-        case GLOpcodeBeginQuery:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBeginQuery*>(pc);
-            cmd->queryHeap->Begin(cmd->query);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeEndQuery:
-        {
-            auto cmd = reinterpret_cast<const GLCmdEndQuery*>(pc);
-            cmd->queryHeap->End(cmd->query);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBeginConditionalRender:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBeginConditionalRender*>(pc);
-            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
-            glBeginConditionalRender(cmd->id, cmd->mode);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeEndConditionalRender:
-        {
-            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
-            glEndConditionalRender();
-            #endif
-            return 0;
-        }
-        case GLOpcodeDrawArrays:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
-            glDrawArrays(cmd->mode, cmd->first, cmd->count);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawArraysInstanced:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawArraysInstanced*>(pc);
-            glDrawArraysInstanced(cmd->mode, cmd->first, cmd->count, cmd->instancecount);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawArraysInstancedBaseInstance:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
-            #ifdef LLGL_GLEXT_BASE_INSTANCE
-            glDrawArraysInstancedBaseInstance(cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawArraysIndirect:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
-            #ifdef LLGL_GLEXT_DRAW_INDIRECT
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            GLintptr offset = cmd->indirect;
-            for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
-            {
-                glDrawArraysIndirect(cmd->mode, reinterpret_cast<const GLvoid*>(offset));
-                offset += cmd->stride;
-            }
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElements:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawElements*>(pc);
-            glDrawElements(cmd->mode, cmd->count, cmd->type, cmd->indices);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsBaseVertex:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
-            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
-            glDrawElementsBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsInstanced:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(pc);
-            glDrawElementsInstanced(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsInstancedBaseVertex:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
-            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
-            glDrawElementsInstancedBaseVertex(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
-            #ifdef LLGL_GLEXT_BASE_INSTANCE
-            glDrawElementsInstancedBaseVertexBaseInstance(cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDrawElementsIndirect:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
-            #ifdef LLGL_GLEXT_DRAW_INDIRECT
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            GLintptr offset = cmd->indirect;
-            for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
-            {
-                glDrawElementsIndirect(cmd->mode, cmd->type, reinterpret_cast<const GLvoid*>(offset));
-                offset += cmd->stride;
-            }
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeMultiDrawArraysIndirect:
-        {
-            auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
-            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            glMultiDrawArraysIndirect(cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeMultiDrawElementsIndirect:
-        {
-            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
-            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
-            stateMngr.BindBuffer(GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
-            glMultiDrawElementsIndirect(cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDispatchCompute:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
-            #ifdef LLGL_GLEXT_COMPUTE_SHADER
-            glDispatchCompute(cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeDispatchComputeIndirect:
-        {
-            auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
-            #ifdef LLGL_GLEXT_COMPUTE_SHADER
-            stateMngr.BindBuffer(GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
-            glDispatchComputeIndirect(cmd->indirect);
-            #endif
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindTexture:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
-            stateMngr.ActiveTexture(cmd->slot);
-            stateMngr.BindGLTexture(*(cmd->texture));
-            return sizeof(*cmd);
-        }
-        case GLOpcodeBindSampler:
-        {
-            auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
-            stateMngr.BindSampler(cmd->slot, cmd->sampler);
-            return sizeof(*cmd);
-        }
-        case GLOpcodeUnbindResources:
-        {
-            auto cmd = reinterpret_cast<const GLCmdUnbindResources*>(pc);
-            if (cmd->resetUBO)
-                stateMngr.UnbindBuffersBase(GLBufferTarget::UNIFORM_BUFFER, cmd->first, cmd->count);
-            if (cmd->resetSSAO)
-                stateMngr.UnbindBuffersBase(GLBufferTarget::SHADER_STORAGE_BUFFER, cmd->first, cmd->count);
-            if (cmd->resetTransformFeedback)
-                stateMngr.UnbindBuffersBase(GLBufferTarget::TRANSFORM_FEEDBACK_BUFFER, cmd->first, cmd->count);
-            if (cmd->resetTextures)
-                stateMngr.UnbindTextures(cmd->first, cmd->count);
-            if (cmd->resetImages)
-                stateMngr.UnbindImageTextures(cmd->first, cmd->count);
-            if (cmd->resetSamplers)
-                stateMngr.UnbindSamplers(cmd->first, cmd->count);
-            return sizeof(*cmd);
-        }
-        case GLOpcodePushDebugGroup:
-        {
-            auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
-            #ifdef LLGL_GLEXT_DEBUG
-            glPushDebugGroup(cmd->source, cmd->id, cmd->length, reinterpret_cast<const GLchar*>(cmd + 1));
-            #endif
-            return (sizeof(*cmd) + cmd->length + 1);
-        }
-        case GLOpcodePopDebugGroup:
-        {
-            #ifdef LLGL_GLEXT_DEBUG
-            glPopDebugGroup();
-            #endif
-            return 0;
-        }
-        default:
-            return 0;
+        case GLOpcodeBufferSubData:                               return ExecuteGLCmdBufferSubData(pc, stateMngr);
+        case GLOpcodeCopyBufferSubData:                           return ExecuteGLCmdCopyBufferSubData(pc, stateMngr);
+        case GLOpcodeClearBufferData:                             return ExecuteGLCmdClearBufferData(pc, stateMngr);
+        case GLOpcodeClearBufferSubData:                          return ExecuteGLCmdClearBufferSubData(pc, stateMngr);
+        case GLOpcodeCopyImageSubData:                            return ExecuteGLCmdCopyImageSubData(pc, stateMngr);
+        case GLOpcodeCopyImageToBuffer:                           return ExecuteGLCmdCopyImageToBuffer(pc, stateMngr);
+        case GLOpcodeCopyImageFromBuffer:                         return ExecuteGLCmdCopyImageFromBuffer(pc, stateMngr);
+        case GLOpcodeGenerateMipmap:                              return ExecuteGLCmdGenerateMipmap(pc, stateMngr);
+        case GLOpcodeGenerateMipmapSubresource:                   return ExecuteGLCmdGenerateMipmapSubresource(pc, stateMngr);
+        case GLOpcodeExecute:                                     return ExecuteGLCmdExecute(pc, stateMngr);
+        case GLOpcodeSetAPIDepState:                              return ExecuteGLCmdSetAPIDepState(pc, stateMngr);
+        case GLOpcodeViewport:                                    return ExecuteGLCmdViewport(pc, stateMngr);
+        case GLOpcodeViewportArray:                               return ExecuteGLCmdViewportArray(pc, stateMngr);
+        case GLOpcodeScissor:                                     return ExecuteGLCmdScissor(pc, stateMngr);
+        case GLOpcodeScissorArray:                                return ExecuteGLCmdScissorArray(pc, stateMngr);
+        case GLOpcodeClearColor:                                  return ExecuteGLCmdClearColor(pc, stateMngr);
+        case GLOpcodeClearDepth:                                  return ExecuteGLCmdClearDepth(pc, stateMngr);
+        case GLOpcodeClearStencil:                                return ExecuteGLCmdClearStencil(pc, stateMngr);
+        case GLOpcodeClear:                                       return ExecuteGLCmdClear(pc, stateMngr);
+        case GLOpcodeClearBuffers:                                return ExecuteGLCmdClearBuffers(pc, stateMngr);
+        case GLOpcodeBindVertexArray:                             return ExecuteGLCmdBindVertexArray(pc, stateMngr);
+        case GLOpcodeBindGL2XVertexArray:                         return ExecuteGLCmdBindGL2XVertexArray(pc, stateMngr);
+        case GLOpcodeBindElementArrayBufferToVAO:                 return ExecuteGLCmdBindElementArrayBufferToVAO(pc, stateMngr);
+        case GLOpcodeBindBufferBase:                              return ExecuteGLCmdBindBufferBase(pc, stateMngr);
+        case GLOpcodeBindBuffersBase:                             return ExecuteGLCmdBindBuffersBase(pc, stateMngr);
+        case GLOpcodeBeginTransformFeedback:                      return ExecuteGLCmdBeginTransformFeedback(pc, stateMngr);
+        case GLOpcodeBeginTransformFeedbackNV:                    return ExecuteGLCmdBeginTransformFeedbackNV(pc, stateMngr);
+        case GLOpcodeEndTransformFeedback:                        return ExecuteGLCmdEndTransformFeedback(pc, stateMngr);
+        case GLOpcodeEndTransformFeedbackNV:                      return ExecuteGLCmdEndTransformFeedbackNV(pc, stateMngr);
+        case GLOpcodeBindResourceHeap:                            return ExecuteGLCmdBindResourceHeap(pc, stateMngr);
+        case GLOpcodeBindRenderPass:                              return ExecuteGLCmdBindRenderPass(pc, stateMngr);
+        case GLOpcodeBindPipelineState:                           return ExecuteGLCmdBindPipelineState(pc, stateMngr);
+        case GLOpcodeSetBlendColor:                               return ExecuteGLCmdSetBlendColor(pc, stateMngr);
+        case GLOpcodeSetStencilRef:                               return ExecuteGLCmdSetStencilRef(pc, stateMngr);
+        case GLOpcodeSetUniforms:                                 return ExecuteGLCmdSetUniforms(pc, stateMngr);
+        case GLOpcodeBeginQuery:                                  return ExecuteGLCmdBeginQuery(pc, stateMngr);
+        case GLOpcodeEndQuery:                                    return ExecuteGLCmdEndQuery(pc, stateMngr);
+        case GLOpcodeBeginConditionalRender:                      return ExecuteGLCmdBeginConditionalRender(pc, stateMngr);
+        case GLOpcodeEndConditionalRender:                        return ExecuteGLCmdEndConditionalRender(pc, stateMngr);
+        case GLOpcodeDrawArrays:                                  return ExecuteGLCmdDrawArrays(pc, stateMngr);
+        case GLOpcodeDrawArraysInstanced:                         return ExecuteGLCmdDrawArraysInstanced(pc, stateMngr);
+        case GLOpcodeDrawArraysInstancedBaseInstance:             return ExecuteGLCmdDrawArraysInstancedBaseInstance(pc, stateMngr);
+        case GLOpcodeDrawArraysIndirect:                          return ExecuteGLCmdDrawArraysIndirect(pc, stateMngr);
+        case GLOpcodeDrawElements:                                return ExecuteGLCmdDrawElements(pc, stateMngr);
+        case GLOpcodeDrawElementsBaseVertex:                      return ExecuteGLCmdDrawElementsBaseVertex(pc, stateMngr);
+        case GLOpcodeDrawElementsInstanced:                       return ExecuteGLCmdDrawElementsInstanced(pc, stateMngr);
+        case GLOpcodeDrawElementsInstancedBaseVertex:             return ExecuteGLCmdDrawElementsInstancedBaseVertex(pc, stateMngr);
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance: return ExecuteGLCmdDrawElementsInstancedBaseVertexBaseInstance(pc, stateMngr);
+        case GLOpcodeDrawElementsIndirect:                        return ExecuteGLCmdDrawElementsIndirect(pc, stateMngr);
+        case GLOpcodeMultiDrawArrays:                             return ExecuteGLCmdMultiDrawArrays(pc, stateMngr);
+        case GLOpcodeMultiDrawArraysIndirect:                     return ExecuteGLCmdMultiDrawArraysIndirect(pc, stateMngr);
+        case GLOpcodeMultiDrawElementsIndirect:                   return ExecuteGLCmdMultiDrawElementsIndirect(pc, stateMngr);
+        case GLOpcodeDispatchCompute:                             return ExecuteGLCmdDispatchCompute(pc, stateMngr);
+        case GLOpcodeDispatchComputeIndirect:                     return ExecuteGLCmdDispatchComputeIndirect(pc, stateMngr);
+        case GLOpcodeBindTexture:                                 return ExecuteGLCmdBindTexture(pc, stateMngr);
+        case GLOpcodeBindSampler:                                 return ExecuteGLCmdBindSampler(pc, stateMngr);
+        case GLOpcodeUnbindResources:                             return ExecuteGLCmdUnbindResources(pc, stateMngr);
+        case GLOpcodePushDebugGroup:                              return ExecuteGLCmdPushDebugGroup(pc, stateMngr);
+        case GLOpcodePopDebugGroup:                               return ExecuteGLCmdPopDebugGroup(pc, stateMngr);
+        default:                                                  return 0;
     }
 }
 
-static void ExecuteGLCommandsEmulated(const std::vector<std::uint8_t>& rawBuffer, GLStateManager& stateMngr)
+// Returns the function to execute the specified GL command, or null if the opcode is invalid.
+static GLCommandFunc GetGLCommandFunc(const GLOpcode opcode)
 {
-    /* Initialize program counter to execute virtual GL commands */
-    auto pc     = rawBuffer.data();
-    auto pcEnd  = rawBuffer.data() + rawBuffer.size();
+    switch (opcode)
+    {
+        case GLOpcodeBufferSubData:                               return ExecuteGLCmdBufferSubData;
+        case GLOpcodeCopyBufferSubData:                           return ExecuteGLCmdCopyBufferSubData;
+        case GLOpcodeClearBufferData:                             return ExecuteGLCmdClearBufferData;
+        case GLOpcodeClearBufferSubData:                          return ExecuteGLCmdClearBufferSubData;
+        case GLOpcodeCopyImageSubData:                            return ExecuteGLCmdCopyImageSubData;
+        case GLOpcodeCopyImageToBuffer:                           return ExecuteGLCmdCopyImageToBuffer;
+        case GLOpcodeCopyImageFromBuffer:                         return ExecuteGLCmdCopyImageFromBuffer;
+        case GLOpcodeGenerateMipmap:                              return ExecuteGLCmdGenerateMipmap;
+        case GLOpcodeGenerateMipmapSubresource:                   return ExecuteGLCmdGenerateMipmapSubresource;
+        case GLOpcodeExecute:                                     return ExecuteGLCmdExecute;
+        case GLOpcodeSetAPIDepState:                              return ExecuteGLCmdSetAPIDepState;
+        case GLOpcodeViewport:                                    return ExecuteGLCmdViewport;
+        case GLOpcodeViewportArray:                               return ExecuteGLCmdViewportArray;
+        case GLOpcodeScissor:                                     return ExecuteGLCmdScissor;
+        case GLOpcodeScissorArray:                                return ExecuteGLCmdScissorArray;
+        case GLOpcodeClearColor:                                  return ExecuteGLCmdClearColor;
+        case GLOpcodeClearDepth:                                  return ExecuteGLCmdClearDepth;
+        case GLOpcodeClearStencil:                                return ExecuteGLCmdClearStencil;
+        case GLOpcodeClear:                                       return ExecuteGLCmdClear;
+        case GLOpcodeClearBuffers:                                return ExecuteGLCmdClearBuffers;
+        case GLOpcodeBindVertexArray:                             return ExecuteGLCmdBindVertexArray;
+        case GLOpcodeBindGL2XVertexArray:                         return ExecuteGLCmdBindGL2XVertexArray;
+        case GLOpcodeBindElementArrayBufferToVAO:                 return ExecuteGLCmdBindElementArrayBufferToVAO;
+        case GLOpcodeBindBufferBase:                              return ExecuteGLCmdBindBufferBase;
+        case GLOpcodeBindBuffersBase:                             return ExecuteGLCmdBindBuffersBase;
+        case GLOpcodeBeginTransformFeedback:                      return ExecuteGLCmdBeginTransformFeedback;
+        case GLOpcodeBeginTransformFeedbackNV:                    return ExecuteGLCmdBeginTransformFeedbackNV;
+        case GLOpcodeEndTransformFeedback:                        return ExecuteGLCmdEndTransformFeedback;
+        case GLOpcodeEndTransformFeedbackNV:                      return ExecuteGLCmdEndTransformFeedbackNV;
+        case GLOpcodeBindResourceHeap:                            return ExecuteGLCmdBindResourceHeap;
+        case GLOpcodeBindRenderPass:                              return ExecuteGLCmdBindRenderPass;
+        case GLOpcodeBindPipelineState:                           return ExecuteGLCmdBindPipelineState;
+        case GLOpcodeSetBlendColor:                               return ExecuteGLCmdSetBlendColor;
+        case GLOpcodeSetStencilRef:                               return ExecuteGLCmdSetStencilRef;
+        case GLOpcodeSetUniforms:                                 return ExecuteGLCmdSetUniforms;
+        case GLOpcodeBeginQuery:                                  return ExecuteGLCmdBeginQuery;
+        case GLOpcodeEndQuery:                                    return ExecuteGLCmdEndQuery;
+        case GLOpcodeBeginConditionalRender:                      return ExecuteGLCmdBeginConditionalRender;
+        case GLOpcodeEndConditionalRender:                        return ExecuteGLCmdEndConditionalRender;
+        case GLOpcodeDrawArrays:                                  return ExecuteGLCmdDrawArrays;
+        case GLOpcodeDrawArraysInstanced:                         return ExecuteGLCmdDrawArraysInstanced;
+        case GLOpcodeDrawArraysInstancedBaseInstance:             return ExecuteGLCmdDrawArraysInstancedBaseInstance;
+        case GLOpcodeDrawArraysIndirect:                          return ExecuteGLCmdDrawArraysIndirect;
+        case GLOpcodeDrawElements:                                return ExecuteGLCmdDrawElements;
+        case GLOpcodeDrawElementsBaseVertex:                      return ExecuteGLCmdDrawElementsBaseVertex;
+        case GLOpcodeDrawElementsInstanced:                       return ExecuteGLCmdDrawElementsInstanced;
+        case GLOpcodeDrawElementsInstancedBaseVertex:             return ExecuteGLCmdDrawElementsInstancedBaseVertex;
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance: return ExecuteGLCmdDrawElementsInstancedBaseVertexBaseInstance;
+        case GLOpcodeDrawElementsIndirect:                        return ExecuteGLCmdDrawElementsIndirect;
+        case GLOpcodeMultiDrawArrays:                             return ExecuteGLCmdMultiDrawArrays;
+        case GLOpcodeMultiDrawArraysIndirect:                     return ExecuteGLCmdMultiDrawArraysIndirect;
+        case GLOpcodeMultiDrawElementsIndirect:                   return ExecuteGLCmdMultiDrawElementsIndirect;
+        case GLOpcodeDispatchCompute:                             return ExecuteGLCmdDispatchCompute;
+        case GLOpcodeDispatchComputeIndirect:                     return ExecuteGLCmdDispatchComputeIndirect;
+        case GLOpcodeBindTexture:                                 return ExecuteGLCmdBindTexture;
+        case GLOpcodeBindSampler:                                 return ExecuteGLCmdBindSampler;
+        case GLOpcodeUnbindResources:                             return ExecuteGLCmdUnbindResources;
+        case GLOpcodePushDebugGroup:                              return ExecuteGLCmdPushDebugGroup;
+        case GLOpcodePopDebugGroup:                               return ExecuteGLCmdPopDebugGroup;
+        default:                                                  return nullptr;
+    }
+}
 
+static void ExecuteGLCommandsThreaded(const std::vector<GLDecodedCommand>& decodedCommands, GLStateManager& stateMngr)
+{
+    /* Call pre-decoded functions directly without dispatching opcodes */
+    for (const auto& cmd : decodedCommands)
+        cmd.func(cmd.pc, stateMngr);
+}
+
+static void ExecuteGLCommandsEmulated(const GLCommandPage* firstPage, GLStateManager& stateMngr)
+{
     GLOpcode opcode;
 
-    while (pc < pcEnd)
+    for (auto page = firstPage; page != nullptr; page = page->next)
     {
-        /* Read opcode */
-        opcode = *reinterpret_cast<const GLOpcode*>(pc);
-        pc += sizeof(GLOpcode);
+        /* Initialize program counter to execute virtual GL commands of this page */
+        auto pc     = page->GetData();
+        auto pcEnd  = page->GetData() + page->size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += sizeof(GLOpcode);
 
-        /* Execute command and increment program counter */
-        pc += ExecuteGLCommand(opcode, pc, stateMngr);
+            /* Execute command and increment program counter */
+            pc += ExecuteGLCommand(opcode, pc, stateMngr);
+        }
     }
 }
 
@@ -515,6 +723,31 @@ static void ExecuteGLCommandsNatively(const JITProgram& exec, GLStateManager& st
 
 #endif // /LLGL_ENABLE_JIT_COMPILER
 
+void DecodeGLCommandBuffer(const GLCommandPage* firstPage, std::vector<GLDecodedCommand>& outCommands)
+{
+    outCommands.clear();
+
+    for (auto page = firstPage; page != nullptr; page = page->next)
+    {
+        auto pc     = page->GetData();
+        auto pcEnd  = page->GetData() + page->size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode and store function with pointer to command payload */
+            const auto opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += sizeof(GLOpcode);
+
+            if (auto func = GetGLCommandFunc(opcode))
+                outCommands.push_back({ func, pc });
+            else
+                throw std::invalid_argument("invalid GL opcode in deferred command buffer: " + std::to_string(static_cast<int>(opcode)));
+
+            pc += GetGLCommandSize(opcode, pc);
+        }
+    }
+}
+
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
 {
     #ifdef LLGL_ENABLE_JIT_COMPILER
@@ -525,9 +758,15 @@ void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer, GL
     }
     else
     #endif // /LLGL_ENABLE_JIT_COMPILER
+    if (cmdBuffer.GetDispatchMode() == CommandDispatchMode::Threaded && !cmdBuffer.GetDecodedCommands().empty())
+    {
+        /* Execute GL commands with pre-decoded function pointers */
+        ExecuteGLCommandsThreaded(cmdBuffer.GetDecodedCommands(), stateMngr);
+    }
+    else
     {
         /* Emulate execution of GL commands */
-        ExecuteGLCommandsEmulated(cmdBuffer.GetRawBuffer(), stateMngr);
+        ExecuteGLCommandsEmulated(cmdBuffer.GetFirstPage(), stateMngr);
     }
 }
 
@@ -9,6 +9,12 @@
 #define LLGL_GL_COMMAND_EXECUTOR_H
 
 
+#include <LLGL/RenderSystemFlags.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
 namespace LLGL
 {
 
@@ -16,14 +22,33 @@ namespace LLGL
 class GLStateManager;
 class GLCommandBuffer;
 class GLDeferredCommandBuffer;
+struct GLCommandPage;
+
+// Function pointer type to execute a single GL command; returns the size (in bytes) of the command without its opcode.
+typedef std::size_t (*GLCommandFunc)(const void* pc, GLStateManager& stateMngr);
+
+// Pre-decoded GL command for direct-threaded dispatch.
+struct GLDecodedCommand
+{
+    GLCommandFunc   func;   // Function to execute this command.
+    const void*     pc;     // Pointer to the command payload (behind the opcode) in the raw command buffer.
+};
 
 /*
 Executes all GL commands that have been recorded in the specified command buffer.
 GL render states are tracked with the specified state manager.
+Deferred command buffers are dispatched with their own dispatch mode (see GLDeferredCommandBuffer::GetDispatchMode).
 */
 void ExecuteGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 void ExecuteGLCommandBuffer(const GLCommandBuffer& cmdbuffer, GLStateManager& stateMngr);
 
+/*
+Decodes the specified chain of GL command pages into a list of function and payload pairs,
+so the commands can be executed without the opcode switch (see CommandDispatchMode::Threaded).
+The output list is only valid as long as the pages are not modified.
+*/
+void DecodeGLCommandBuffer(const GLCommandPage* firstPage, std::vector<GLDecodedCommand>& outCommands);
+
 
 } // /namespace LLGL
 
@@ -67,6 +67,7 @@ enum GLOpcode : std::uint8_t
     GLOpcodeDrawElementsInstancedBaseVertex,
     GLOpcodeDrawElementsInstancedBaseVertexBaseInstance,
     GLOpcodeDrawElementsIndirect,
+    GLOpcodeMultiDrawArrays,
     GLOpcodeMultiDrawArraysIndirect,
     GLOpcodeMultiDrawElementsIndirect,
     GLOpcodeDispatchCompute,
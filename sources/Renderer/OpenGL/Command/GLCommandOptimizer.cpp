@@ -0,0 +1,374 @@
+/*
+ * GLCommandOptimizer.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandOptimizer.h"
+#include "GLCommandOpcode.h"
+#include "GLCommand.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Indices of the states whose redundant state commands are removed by the optimizer.
+enum GLTrackedState
+{
+    GLTrackedStatePipeline = 0,
+    GLTrackedStateVertexArray,
+    GLTrackedStateViewport,
+    GLTrackedStateResourceHeap,
+    GLTrackedStateClearColor,
+    GLTrackedStateClearDepth,
+    GLTrackedStateClearStencil,
+
+    GLTrackedStateCount,
+};
+
+static const std::uint32_t g_allTrackedStates   = ((1u << GLTrackedStateCount) - 1u);
+static const std::size_t   g_invalidOffset      = ~static_cast<std::size_t>(0);
+
+// Returns the index of the state that is set by the specified command, or GLTrackedStateCount if the state is not tracked.
+static GLTrackedState GetTrackedState(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBindPipelineState: return GLTrackedStatePipeline;
+        case GLOpcodeBindVertexArray:   return GLTrackedStateVertexArray;
+        case GLOpcodeViewport:          return GLTrackedStateViewport;
+        case GLOpcodeBindResourceHeap:  return GLTrackedStateResourceHeap;
+        case GLOpcodeClearColor:        return GLTrackedStateClearColor;
+        case GLOpcodeClearDepth:        return GLTrackedStateClearDepth;
+        case GLOpcodeClearStencil:      return GLTrackedStateClearStencil;
+        default:                        return GLTrackedStateCount;
+    }
+}
+
+// Returns true if the two state commands of the specified opcode set the same state.
+static bool IsSameState(const GLOpcode opcode, const void* lhs, const void* rhs)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBindPipelineState:
+        {
+            auto a = reinterpret_cast<const GLCmdBindPipelineState*>(lhs);
+            auto b = reinterpret_cast<const GLCmdBindPipelineState*>(rhs);
+            return (a->pipelineState == b->pipelineState);
+        }
+        case GLOpcodeBindVertexArray:
+        {
+            auto a = reinterpret_cast<const GLCmdBindVertexArray*>(lhs);
+            auto b = reinterpret_cast<const GLCmdBindVertexArray*>(rhs);
+            return (a->vao == b->vao);
+        }
+        case GLOpcodeBindResourceHeap:
+        {
+            auto a = reinterpret_cast<const GLCmdBindResourceHeap*>(lhs);
+            auto b = reinterpret_cast<const GLCmdBindResourceHeap*>(rhs);
+            return (a->resourceHeap == b->resourceHeap && a->firstSet == b->firstSet);
+        }
+        case GLOpcodeClearStencil:
+        {
+            auto a = reinterpret_cast<const GLCmdClearStencil*>(lhs);
+            auto b = reinterpret_cast<const GLCmdClearStencil*>(rhs);
+            return (a->stencil == b->stencil);
+        }
+        case GLOpcodeViewport:
+        case GLOpcodeClearColor:
+        case GLOpcodeClearDepth:
+        {
+            /* Compare floating-point values bitwise, so NaNs and signed zeros are never treated as redundant */
+            return (::memcmp(lhs, rhs, GetGLCommandSize(opcode, lhs)) == 0);
+        }
+        default:
+            return false;
+    }
+}
+
+/*
+Returns the bitmask of tracked states that are not modified by the specified command.
+Every command that is unknown to the optimizer invalidates all tracked states, e.g. GLOpcodeExecute and GLOpcodeBindRenderPass.
+*/
+static std::uint32_t GetPreservedStates(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeViewport:
+        case GLOpcodeScissor:
+        case GLOpcodeScissorArray:
+        case GLOpcodeSetBlendColor:
+        case GLOpcodeSetStencilRef:
+            /* Binding the same pipeline state again might reset its static viewports, scissors, blend color, or stencil reference */
+            return (g_allTrackedStates & ~(1u << GLTrackedStatePipeline));
+
+        case GLOpcodeViewportArray:
+            return (g_allTrackedStates & ~((1u << GLTrackedStatePipeline) | (1u << GLTrackedStateViewport)));
+
+        case GLOpcodeBindPipelineState:
+            /* Pipeline state might set static viewports */
+            return (g_allTrackedStates & ~(1u << GLTrackedStateViewport));
+
+        case GLOpcodeBindGL2XVertexArray:
+            return (g_allTrackedStates & ~(1u << GLTrackedStateVertexArray));
+
+        case GLOpcodeBindBufferBase:
+        case GLOpcodeBindBuffersBase:
+        case GLOpcodeBindTexture:
+        case GLOpcodeBindSampler:
+        case GLOpcodeUnbindResources:
+            return (g_allTrackedStates & ~(1u << GLTrackedStateResourceHeap));
+
+        case GLOpcodeClearColor:
+        case GLOpcodeClearDepth:
+        case GLOpcodeClearStencil:
+        case GLOpcodeClear:
+        case GLOpcodeClearBuffers:
+        case GLOpcodeBindVertexArray:
+        case GLOpcodeBindElementArrayBufferToVAO:
+        case GLOpcodeBindResourceHeap:
+        case GLOpcodeSetUniforms:
+        case GLOpcodeBeginQuery:
+        case GLOpcodeEndQuery:
+        case GLOpcodeBeginConditionalRender:
+        case GLOpcodeEndConditionalRender:
+        case GLOpcodeDrawArrays:
+        case GLOpcodeDrawArraysInstanced:
+        case GLOpcodeDrawArraysInstancedBaseInstance:
+        case GLOpcodeDrawArraysIndirect:
+        case GLOpcodeDrawElements:
+        case GLOpcodeDrawElementsBaseVertex:
+        case GLOpcodeDrawElementsInstanced:
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        case GLOpcodeDrawElementsIndirect:
+        case GLOpcodeMultiDrawArrays:
+        case GLOpcodeMultiDrawArraysIndirect:
+        case GLOpcodeMultiDrawElementsIndirect:
+        case GLOpcodeDispatchCompute:
+        case GLOpcodeDispatchComputeIndirect:
+        case GLOpcodePushDebugGroup:
+        case GLOpcodePopDebugGroup:
+            return g_allTrackedStates;
+
+        default:
+            return 0;
+    }
+}
+
+// Returns true if the two clear commands of the specified opcode clear the same attachments with the same values.
+static bool IsSameClear(const GLOpcode opcode, const void* lhs, const void* rhs)
+{
+    switch (opcode)
+    {
+        case GLOpcodeClear:
+        {
+            auto a = reinterpret_cast<const GLCmdClear*>(lhs);
+            auto b = reinterpret_cast<const GLCmdClear*>(rhs);
+            return (a->flags == b->flags);
+        }
+        case GLOpcodeClearBuffers:
+        {
+            auto a = reinterpret_cast<const GLCmdClearBuffers*>(lhs);
+            auto b = reinterpret_cast<const GLCmdClearBuffers*>(rhs);
+            return (a->numAttachments == b->numAttachments && ::memcmp(a + 1, b + 1, sizeof(AttachmentClear)*a->numAttachments) == 0);
+        }
+        default:
+            return false;
+    }
+}
+
+// Helper class to write the optimized command stream.
+class GLCommandStreamWriter
+{
+
+    public:
+
+        GLCommandStreamWriter(std::size_t reservedSize, GLCommandOptimizerStats& stats) :
+            stats_ { stats }
+        {
+            buffer_.reserve(reservedSize);
+        }
+
+        // Appends the specified command and returns the offset of its payload.
+        std::size_t Append(const GLOpcode opcode, const void* pc, std::size_t size)
+        {
+            auto payload = Alloc(opcode, size);
+            ::memcpy(buffer_.data() + payload, pc, size);
+            return payload;
+        }
+
+        // Appends a new command of the specified size and returns the offset of its uninitialized payload.
+        std::size_t Alloc(const GLOpcode opcode, std::size_t size)
+        {
+            const auto offset = buffer_.size();
+            buffer_.resize(offset + sizeof(GLOpcode) + size);
+            *reinterpret_cast<GLOpcode*>(&buffer_[offset]) = opcode;
+            ++stats_.numCommandsOut;
+            return (offset + sizeof(GLOpcode));
+        }
+
+        // Returns a pointer to the payload at the specified offset.
+        const void* Payload(std::size_t offset) const
+        {
+            return (buffer_.data() + offset);
+        }
+
+        std::vector<std::uint8_t>& GetBuffer()
+        {
+            return buffer_;
+        }
+
+    private:
+
+        std::vector<std::uint8_t>   buffer_;
+        GLCommandOptimizerStats&    stats_;
+
+};
+
+// Appends the pending draw commands as one multi-draw command, or as a single draw command if there is only one.
+static void FlushPendingDraws(GLCommandStreamWriter& writer, GLenum mode, std::vector<GLint>& firsts, std::vector<GLsizei>& counts, GLCommandOptimizerStats& stats)
+{
+    if (firsts.size() == 1)
+    {
+        GLCmdDrawArrays cmd;
+        {
+            cmd.mode    = mode;
+            cmd.first   = firsts.front();
+            cmd.count   = counts.front();
+        }
+        writer.Append(GLOpcodeDrawArrays, &cmd, sizeof(cmd));
+    }
+    else if (firsts.size() > 1)
+    {
+        const auto drawcount = firsts.size();
+
+        GLCmdMultiDrawArrays cmd;
+        {
+            cmd.mode        = mode;
+            cmd.drawcount   = static_cast<GLsizei>(drawcount);
+        }
+
+        /* Write multi-draw command followed by the array of first vertices and the array of vertex counts */
+        auto payload = writer.Alloc(GLOpcodeMultiDrawArrays, sizeof(cmd) + (sizeof(GLint) + sizeof(GLsizei))*drawcount);
+        auto dst = writer.GetBuffer().data() + payload;
+        ::memcpy(dst, &cmd, sizeof(cmd));
+        ::memcpy(dst + sizeof(cmd), firsts.data(), sizeof(GLint)*drawcount);
+        ::memcpy(dst + sizeof(cmd) + sizeof(GLint)*drawcount, counts.data(), sizeof(GLsizei)*drawcount);
+
+        stats.numMergedDraws += drawcount;
+    }
+
+    firsts.clear();
+    counts.clear();
+}
+
+void OptimizeGLCommandBuffer(std::vector<std::uint8_t>& buffer, bool multiDrawArrays, GLCommandOptimizerStats& outStats)
+{
+    GLCommandOptimizerStats stats;
+    stats.sizeIn = buffer.size();
+
+    GLCommandStreamWriter writer { buffer.size(), stats };
+
+    /* Offsets of the last state commands in the output stream for each tracked state */
+    std::size_t trackedStates[GLTrackedStateCount];
+    for (auto& offset : trackedStates)
+        offset = g_invalidOffset;
+
+    /* Opcode and offset of the last command in the output stream */
+    GLOpcode    prevOpcode  = GLOpcode(0);
+    std::size_t prevOffset  = g_invalidOffset;
+
+    /* Consecutive draw commands that have not been written yet */
+    GLenum                  pendingMode = 0;
+    std::vector<GLint>      pendingFirsts;
+    std::vector<GLsizei>    pendingCounts;
+
+    /* Initialize program counter to iterate over virtual GL commands */
+    auto pc     = buffer.data();
+    auto pcEnd  = buffer.data() + buffer.size();
+
+    while (pc < pcEnd)
+    {
+        /* Read opcode and size of command */
+        const auto opcode = *reinterpret_cast<const GLOpcode*>(pc);
+        pc += sizeof(GLOpcode);
+
+        const auto size = GetGLCommandSize(opcode, pc);
+        const auto cmd  = pc;
+        pc += size;
+
+        ++stats.numCommandsIn;
+
+        /* Collect consecutive draw commands with the same primitive mode */
+        if (multiDrawArrays && opcode == GLOpcodeDrawArrays)
+        {
+            auto drawCmd = reinterpret_cast<const GLCmdDrawArrays*>(cmd);
+            if (!pendingFirsts.empty() && pendingMode != drawCmd->mode)
+                FlushPendingDraws(writer, pendingMode, pendingFirsts, pendingCounts, stats);
+
+            pendingMode = drawCmd->mode;
+            pendingFirsts.push_back(drawCmd->first);
+            pendingCounts.push_back(drawCmd->count);
+
+            prevOpcode = GLOpcodeDrawArrays;
+            prevOffset = g_invalidOffset;
+            continue;
+        }
+
+        /* Skip state commands that set the same state again; draw commands do not modify any tracked state */
+        const auto trackedState = GetTrackedState(opcode);
+        if (trackedState != GLTrackedStateCount)
+        {
+            const auto trackedOffset = trackedStates[trackedState];
+            if (trackedOffset != g_invalidOffset && IsSameState(opcode, writer.Payload(trackedOffset), cmd))
+            {
+                ++stats.numRedundantStates;
+                continue;
+            }
+        }
+
+        FlushPendingDraws(writer, pendingMode, pendingFirsts, pendingCounts, stats);
+
+        /* Skip clear commands that repeat the previous command */
+        if (prevOpcode == opcode && prevOffset != g_invalidOffset && IsSameClear(opcode, writer.Payload(prevOffset), cmd))
+        {
+            ++stats.numRedundantClears;
+            continue;
+        }
+
+        /* Write command to output stream and invalidate all tracked states this command might modify */
+        const auto offset = writer.Append(opcode, cmd, size);
+
+        const auto preservedStates = GetPreservedStates(opcode);
+        for (int i = 0; i < GLTrackedStateCount; ++i)
+        {
+            if ((preservedStates & (1u << i)) == 0)
+                trackedStates[i] = g_invalidOffset;
+        }
+
+        if (trackedState != GLTrackedStateCount)
+            trackedStates[trackedState] = offset;
+
+        prevOpcode = opcode;
+        prevOffset = offset;
+    }
+
+    FlushPendingDraws(writer, pendingMode, pendingFirsts, pendingCounts, stats);
+
+    /* Replace command stream with optimized stream */
+    buffer.swap(writer.GetBuffer());
+    stats.sizeOut = buffer.size();
+
+    outStats = stats;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,50 @@
+/*
+ * GLCommandOptimizer.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_OPTIMIZER_H
+#define LLGL_GL_COMMAND_OPTIMIZER_H
+
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Statistics of a single optimization pass over a GL command stream.
+struct GLCommandOptimizerStats
+{
+    std::size_t numCommandsIn       = 0; // Number of commands before the optimization.
+    std::size_t numCommandsOut      = 0; // Number of commands after the optimization.
+    std::size_t sizeIn              = 0; // Size (in bytes) of the command stream before the optimization.
+    std::size_t sizeOut             = 0; // Size (in bytes) of the command stream after the optimization.
+    std::size_t numRedundantStates  = 0; // Number of removed state commands that would have set the same state again.
+    std::size_t numRedundantClears  = 0; // Number of removed clear commands that repeated the previous clear command.
+    std::size_t numMergedDraws      = 0; // Number of draw commands that have been merged into multi-draw commands.
+};
+
+/*
+Optimizes the specified GL command stream that has been recorded by a GLDeferredCommandBuffer:
+ - Removes state commands that bind the same pipeline state, vertex array, viewport, resource heap, or clear value that is already bound.
+ - Removes clear commands that immediately repeat the previous clear command.
+ - Merges consecutive GLOpcodeDrawArrays commands with the same primitive mode into a single GLOpcodeMultiDrawArrays command, if 'multiDrawArrays' is true.
+States are only tracked within the command stream, since its commands can be submitted on top of any previous state.
+*/
+void OptimizeGLCommandBuffer(std::vector<std::uint8_t>& buffer, bool multiDrawArrays, GLCommandOptimizerStats& outStats);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
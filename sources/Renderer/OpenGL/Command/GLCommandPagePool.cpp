@@ -0,0 +1,201 @@
+/*
+ * GLCommandPagePool.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandPagePool.h"
+#include <algorithm>
+#include <new>
+
+
+namespace LLGL
+{
+
+
+static GLCommandPage* NewGLCommandPage(std::size_t capacity)
+{
+    auto page = static_cast<GLCommandPage*>(::operator new(sizeof(GLCommandPage) + capacity));
+    page->next      = nullptr;
+    page->capacity  = capacity;
+    page->size      = 0;
+    return page;
+}
+
+static void DeleteGLCommandPage(GLCommandPage* page)
+{
+    ::operator delete(page);
+}
+
+// Returns the tagged index with the specified node index in the lower and the tag in the upper 32 bits.
+static std::uint64_t MakeTaggedIndex(std::uint32_t index, std::uint32_t tag)
+{
+    return ((static_cast<std::uint64_t>(tag) << 32) | index);
+}
+
+static std::uint32_t GetNodeIndex(std::uint64_t taggedIndex)
+{
+    return static_cast<std::uint32_t>(taggedIndex & 0xFFFFFFFFu);
+}
+
+static std::uint32_t GetNodeTag(std::uint64_t taggedIndex)
+{
+    return static_cast<std::uint32_t>(taggedIndex >> 32);
+}
+
+// Returns the number of pages with the specified capacity that fit into the maximum of retained memory.
+static std::uint32_t GetMaxNumRetainedPages(std::size_t pageCapacity, std::size_t maxRetainedSize)
+{
+    return static_cast<std::uint32_t>(std::min<std::size_t>(maxRetainedSize / pageCapacity, 0xFFFFFFFEu));
+}
+
+GLCommandPagePool::GLCommandPagePool(std::size_t pageSize, std::size_t maxRetainedSize) :
+    pageCapacity_      { std::max(pageSize, sizeof(GLCommandPage) * 2) - sizeof(GLCommandPage) },
+    numNodes_          { GetMaxNumRetainedPages(pageCapacity_, maxRetainedSize)                 },
+    nodes_             { new FreeNode[numNodes_]                                                },
+    freePages_         { MakeTaggedIndex(g_invalidNodeIndex, 0)                                 },
+    emptyNodes_        { MakeTaggedIndex(numNodes_ > 0 ? 0 : g_invalidNodeIndex, 0)            },
+    numPagesInUse_     { 0                                                                      },
+    numPagesRetained_  { 0                                                                      },
+    numPagesAllocated_ { 0                                                                      },
+    sizeInUse_         { 0                                                                      },
+    sizeRetained_      { 0                                                                      }
+{
+    /* Link all nodes into the stack of empty nodes */
+    for (std::uint32_t i = 0; i < numNodes_; ++i)
+    {
+        nodes_[i].page = nullptr;
+        nodes_[i].next.store(i + 1 < numNodes_ ? i + 1 : g_invalidNodeIndex, std::memory_order_relaxed);
+    }
+}
+
+GLCommandPagePool::~GLCommandPagePool()
+{
+    Trim();
+}
+
+GLCommandPage* GLCommandPagePool::AllocPage(std::size_t minCapacity)
+{
+    const auto capacity = std::max(minCapacity, pageCapacity_);
+
+    numPagesInUse_.fetch_add(1, std::memory_order_relaxed);
+    sizeInUse_.fetch_add(capacity, std::memory_order_relaxed);
+
+    if (capacity == pageCapacity_)
+    {
+        /* Pop a free page and return its node to the stack of empty nodes */
+        const auto nodeIndex = PopNode(freePages_);
+        if (nodeIndex != g_invalidNodeIndex)
+        {
+            auto page = nodes_[nodeIndex].page;
+            PushNode(emptyNodes_, nodeIndex);
+
+            numPagesRetained_.fetch_sub(1, std::memory_order_relaxed);
+            sizeRetained_.fetch_sub(pageCapacity_, std::memory_order_relaxed);
+
+            page->next = nullptr;
+            page->size = 0;
+            return page;
+        }
+    }
+
+    /* Allocate new page */
+    numPagesAllocated_.fetch_add(1, std::memory_order_relaxed);
+    return NewGLCommandPage(capacity);
+}
+
+void GLCommandPagePool::FreePages(GLCommandPage* firstPage)
+{
+    for (auto page = firstPage; page != nullptr;)
+    {
+        auto next = page->next;
+
+        numPagesInUse_.fetch_sub(1, std::memory_order_relaxed);
+        sizeInUse_.fetch_sub(page->capacity, std::memory_order_relaxed);
+
+        /* Retain regular pages in an empty node, or delete page if all nodes are in use, i.e. the maximum of retained memory is reached */
+        const auto nodeIndex = (page->capacity == pageCapacity_ ? PopNode(emptyNodes_) : g_invalidNodeIndex);
+        if (nodeIndex != g_invalidNodeIndex)
+        {
+            numPagesRetained_.fetch_add(1, std::memory_order_relaxed);
+            sizeRetained_.fetch_add(pageCapacity_, std::memory_order_relaxed);
+
+            nodes_[nodeIndex].page = page;
+            PushNode(freePages_, nodeIndex);
+        }
+        else
+            DeleteGLCommandPage(page);
+
+        page = next;
+    }
+}
+
+void GLCommandPagePool::Trim()
+{
+    for (auto nodeIndex = PopNode(freePages_); nodeIndex != g_invalidNodeIndex; nodeIndex = PopNode(freePages_))
+    {
+        DeleteGLCommandPage(nodes_[nodeIndex].page);
+        nodes_[nodeIndex].page = nullptr;
+        PushNode(emptyNodes_, nodeIndex);
+    }
+
+    numPagesRetained_.store(0, std::memory_order_relaxed);
+    sizeRetained_.store(0, std::memory_order_relaxed);
+}
+
+GLCommandPagePoolStats GLCommandPagePool::GetStats() const
+{
+    GLCommandPagePoolStats stats;
+    {
+        stats.numPagesInUse     = numPagesInUse_.load(std::memory_order_relaxed);
+        stats.numPagesRetained  = numPagesRetained_.load(std::memory_order_relaxed);
+        stats.numPagesAllocated = numPagesAllocated_.load(std::memory_order_relaxed);
+        stats.sizeInUse         = sizeInUse_.load(std::memory_order_relaxed);
+        stats.sizeRetained      = sizeRetained_.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void GLCommandPagePool::PushNode(std::atomic<std::uint64_t>& head, std::uint32_t nodeIndex)
+{
+    auto oldHead = head.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        /* Link node in front of the current stack; the release order publishes the page pointer of the node */
+        nodes_[nodeIndex].next.store(GetNodeIndex(oldHead), std::memory_order_relaxed);
+        if (head.compare_exchange_weak(oldHead, MakeTaggedIndex(nodeIndex, GetNodeTag(oldHead) + 1), std::memory_order_release, std::memory_order_relaxed))
+            break;
+    }
+}
+
+std::uint32_t GLCommandPagePool::PopNode(std::atomic<std::uint64_t>& head)
+{
+    auto oldHead = head.load(std::memory_order_acquire);
+    for (;;)
+    {
+        const auto nodeIndex = GetNodeIndex(oldHead);
+        if (nodeIndex == g_invalidNodeIndex)
+            return g_invalidNodeIndex;
+
+        /*
+        The successor might be stale if another thread popped this node in the meantime,
+        but then the tag of the head has changed and the CAS fails (no ABA problem)
+        */
+        const auto nextIndex = nodes_[nodeIndex].next.load(std::memory_order_relaxed);
+        if (head.compare_exchange_weak(oldHead, MakeTaggedIndex(nextIndex, GetNodeTag(oldHead) + 1), std::memory_order_acquire, std::memory_order_acquire))
+            return nodeIndex;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
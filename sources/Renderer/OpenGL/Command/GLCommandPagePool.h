@@ -0,0 +1,145 @@
+/*
+ * GLCommandPagePool.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_PAGE_POOL_H
+#define LLGL_GL_COMMAND_PAGE_POOL_H
+
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+// Page of GL command stream memory. The command data immediately follows this header.
+struct GLCommandPage
+{
+    GLCommandPage*  next;       // Next page in the command stream, or null if this is the last page.
+    std::size_t     capacity;   // Capacity (in bytes) of the command data.
+    std::size_t     size;       // Size (in bytes) of the command data that is already in use.
+
+    // Returns a pointer to the start of the command data.
+    inline std::uint8_t* GetData()
+    {
+        return reinterpret_cast<std::uint8_t*>(this + 1);
+    }
+
+    // Returns a constant pointer to the start of the command data.
+    inline const std::uint8_t* GetData() const
+    {
+        return reinterpret_cast<const std::uint8_t*>(this + 1);
+    }
+};
+
+// Statistics of a GL command page pool.
+struct GLCommandPagePoolStats
+{
+    std::size_t numPagesInUse       = 0; // Number of pages that are currently used by command buffers.
+    std::size_t numPagesRetained    = 0; // Number of free pages that are retained for recycling.
+    std::size_t numPagesAllocated   = 0; // Total number of pages that have been allocated from the heap.
+    std::size_t sizeInUse           = 0; // Total capacity (in bytes) of all pages in use.
+    std::size_t sizeRetained        = 0; // Total capacity (in bytes) of all retained pages.
+};
+
+/*
+Pool of fixed-size pages for the command streams of GLDeferredCommandBuffer (one instance per GLRenderSystem).
+Released pages are recycled for other command buffers up to a maximum of retained memory.
+Commands that don't fit into a single page get an oversized page, which is never retained.
+This class is thread-safe and lock-free, so command buffers can be recorded on multiple threads:
+free pages are kept in a fixed table of nodes (one per page that can be retained), which are linked into two lock-free stacks,
+one for the nodes that hold a free page and one for the empty nodes. The stack heads are tagged node indices, which avoids the ABA problem,
+and the nodes are never deallocated while the pool is alive, so concurrent pops never read freed memory.
+*/
+class GLCommandPagePool
+{
+
+    public:
+
+        // Default size (in bytes) of each page including its header.
+        static const std::size_t g_defaultPageSize          = 64 * 1024;
+
+        // Default maximum size (in bytes) of free pages that are retained for recycling.
+        static const std::size_t g_defaultMaxRetainedSize   = 16 * 1024 * 1024;
+
+    public:
+
+        GLCommandPagePool(
+            std::size_t pageSize        = g_defaultPageSize,
+            std::size_t maxRetainedSize = g_defaultMaxRetainedSize
+        );
+        ~GLCommandPagePool();
+
+        GLCommandPagePool(const GLCommandPagePool&) = delete;
+        GLCommandPagePool& operator = (const GLCommandPagePool&) = delete;
+
+        // Returns a page with at least the specified capacity (in bytes). The new page has no successor and a size of zero.
+        GLCommandPage* AllocPage(std::size_t minCapacity);
+
+        // Releases the specified chain of pages (linked via GLCommandPage::next).
+        void FreePages(GLCommandPage* firstPage);
+
+        // Deletes all retained pages. This must not be called while other threads use this pool.
+        void Trim();
+
+        // Returns the current statistics of this pool. While other threads use this pool, the counters are not guaranteed to be consistent with each other.
+        GLCommandPagePoolStats GetStats() const;
+
+        // Returns the capacity (in bytes) of regular pages, i.e. the page size without the page header.
+        inline std::size_t GetPageCapacity() const
+        {
+            return pageCapacity_;
+        }
+
+    private:
+
+        // Node of the lock-free stacks for free pages and empty nodes.
+        struct FreeNode
+        {
+            GLCommandPage*              page;
+            std::atomic<std::uint32_t>  next;
+        };
+
+    private:
+
+        // Pushes the specified node onto the stack with the specified tagged head.
+        void PushNode(std::atomic<std::uint64_t>& head, std::uint32_t nodeIndex);
+
+        // Pops a node from the stack with the specified tagged head, or returns g_invalidNodeIndex if the stack is empty.
+        std::uint32_t PopNode(std::atomic<std::uint64_t>& head);
+
+    private:
+
+        static const std::uint32_t  g_invalidNodeIndex  = 0xFFFFFFFFu;
+
+        std::size_t                 pageCapacity_       = 0;
+
+        std::uint32_t               numNodes_           = 0;
+        std::unique_ptr<FreeNode[]> nodes_;
+        std::atomic<std::uint64_t>  freePages_;         // Tagged index of the first node that holds a free page.
+        std::atomic<std::uint64_t>  emptyNodes_;        // Tagged index of the first node that holds no page.
+
+        std::atomic<std::size_t>    numPagesInUse_;
+        std::atomic<std::size_t>    numPagesRetained_;
+        std::atomic<std::size_t>    numPagesAllocated_;
+        std::atomic<std::size_t>    sizeInUse_;
+        std::atomic<std::size_t>    sizeRetained_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
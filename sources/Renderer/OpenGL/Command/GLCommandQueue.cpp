@@ -12,8 +12,10 @@
 #include "../RenderState/GLFence.h"
 #include "../RenderState/GLQueryHeap.h"
 #include "../RenderState/GLStateManager.h"
+#include "../RenderState/GLStateTrace.h"
 #include "../../CheckedCast.h"
 #include "../Ext/GLExtensionRegistry.h"
+#include <LLGL/RenderingProfiler.h>
 #include <algorithm>
 
 
@@ -21,8 +23,14 @@ namespace LLGL
 {
 
 
-GLCommandQueue::GLCommandQueue(const std::shared_ptr<GLStateManager>& stateManager) :
-    stateMngr_ { stateManager }
+GLCommandQueue::GLCommandQueue(
+    const std::shared_ptr<GLStateManager>&  stateManager,
+    RenderingProfiler*                      profiler,
+    GLStateTrace*                           trace)
+:
+    stateMngr_ { stateManager },
+    profiler_  { profiler     },
+    trace_     { trace        }
 {
 }
 
@@ -39,7 +47,15 @@ void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
     {
         auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
         ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, *stateMngr_);
+
+        /* Accumulate the commands that have been removed by the optimizer for each submission */
+        if (profiler_ != nullptr && (deferredCmdBufferGL.GetFlags() & CommandBufferFlags::Optimize) != 0)
+            FlushOptimizerStats(deferredCmdBufferGL.GetOptimizerStats());
     }
+
+    /* Immediate command buffers have already issued their state changes, so both kinds are counted at submission */
+    if (profiler_ != nullptr || trace_ != nullptr)
+        FlushStateCounters();
 }
 
 /* ----- Queries ----- */
@@ -200,6 +216,58 @@ void GLCommandQueue::WaitIdle()
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void GLCommandQueue::FlushStateCounters()
+{
+    if (profiler_ != nullptr)
+    {
+        /* Accumulate issued and elided state changes into profiler */
+        const auto& counters = stateMngr_->GetCounters();
+
+        FrameProfile profile;
+        {
+            profile.issuedCapabilityChanges         = counters.issued[static_cast<std::size_t>(GLStateCategory::Capability   )];
+            profile.elidedCapabilityChanges         = counters.elided[static_cast<std::size_t>(GLStateCategory::Capability   )];
+            profile.issuedRenderStateChanges        = counters.issued[static_cast<std::size_t>(GLStateCategory::RenderState  )];
+            profile.elidedRenderStateChanges        = counters.elided[static_cast<std::size_t>(GLStateCategory::RenderState  )];
+            profile.issuedBufferBindings            = counters.issued[static_cast<std::size_t>(GLStateCategory::Buffer       )];
+            profile.elidedBufferBindings            = counters.elided[static_cast<std::size_t>(GLStateCategory::Buffer       )];
+            profile.issuedVertexArrayBindings       = counters.issued[static_cast<std::size_t>(GLStateCategory::VertexArray  )];
+            profile.elidedVertexArrayBindings       = counters.elided[static_cast<std::size_t>(GLStateCategory::VertexArray  )];
+            profile.issuedFramebufferBindings       = counters.issued[static_cast<std::size_t>(GLStateCategory::Framebuffer  )];
+            profile.elidedFramebufferBindings       = counters.elided[static_cast<std::size_t>(GLStateCategory::Framebuffer  )];
+            profile.issuedTextureBindings           = counters.issued[static_cast<std::size_t>(GLStateCategory::Texture      )];
+            profile.elidedTextureBindings           = counters.elided[static_cast<std::size_t>(GLStateCategory::Texture      )];
+            profile.issuedSamplerBindings           = counters.issued[static_cast<std::size_t>(GLStateCategory::Sampler      )];
+            profile.elidedSamplerBindings           = counters.elided[static_cast<std::size_t>(GLStateCategory::Sampler      )];
+            profile.issuedShaderProgramBindings     = counters.issued[static_cast<std::size_t>(GLStateCategory::ShaderProgram)];
+            profile.elidedShaderProgramBindings     = counters.elided[static_cast<std::size_t>(GLStateCategory::ShaderProgram)];
+        }
+        profiler_->Accumulate(profile);
+    }
+
+    stateMngr_->ResetCounters();
+
+    /* Mark end of submission in state trace */
+    if (trace_ != nullptr)
+        trace_->MarkSubmit(numSubmissions_++);
+}
+
+void GLCommandQueue::FlushOptimizerStats(const GLCommandOptimizerStats& stats)
+{
+    FrameProfile profile;
+    {
+        profile.optimizedStateCommands  = static_cast<std::uint32_t>(stats.numRedundantStates);
+        profile.optimizedClearCommands  = static_cast<std::uint32_t>(stats.numRedundantClears);
+        profile.optimizedDrawCommands   = static_cast<std::uint32_t>(stats.numMergedDraws);
+    }
+    profiler_->Accumulate(profile);
+}
+
+
 } // /namespace LLGL
 
 
@@ -11,6 +11,7 @@
 
 #include <LLGL/CommandQueue.h>
 #include <memory>
+#include <cstdint>
 
 
 namespace LLGL
@@ -18,13 +19,20 @@ namespace LLGL
 
 
 class GLStateManager;
+class GLStateTrace;
+class RenderingProfiler;
+struct GLCommandOptimizerStats;
 
 class GLCommandQueue final : public CommandQueue
 {
 
     public:
 
-        GLCommandQueue(const std::shared_ptr<GLStateManager>& stateManager);
+        GLCommandQueue(
+            const std::shared_ptr<GLStateManager>&  stateManager,
+            RenderingProfiler*                      profiler    = nullptr,
+            GLStateTrace*                           trace       = nullptr
+        );
 
         /* ----- Command Buffers ----- */
 
@@ -47,9 +55,20 @@ class GLCommandQueue final : public CommandQueue
         bool WaitFence(Fence& fence, std::uint64_t timeout) override;
         void WaitIdle() override;
 
+    private:
+
+        // Accumulates the state manager counters into the profiler and marks the submission in the trace.
+        void FlushStateCounters();
+
+        // Accumulates the statistics of the command buffer optimizer into the profiler.
+        void FlushOptimizerStats(const GLCommandOptimizerStats& stats);
+
     private:
 
         std::shared_ptr<GLStateManager> stateMngr_;
+        RenderingProfiler*              profiler_       = nullptr;
+        GLStateTrace*                   trace_          = nullptr;
+        std::uint32_t                   numSubmissions_ = 0;
 
 };
 
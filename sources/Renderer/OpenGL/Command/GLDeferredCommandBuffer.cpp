@@ -46,18 +46,26 @@ namespace LLGL
 {
 
 
-GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t reservedSize) :
-    flags_ { flags }
+GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, GLCommandPagePool& pagePool, const CommandDispatchMode dispatchMode) :
+    flags_              { flags                                                     },
+    dispatchMode_       { dispatchMode                                              },
+    pagePool_           { pagePool                                                  },
+    maxDebugNameLength_ { GLStateManager::Get().GetLimits().maxDebugNameLength      }
 {
-    buffer_.reserve(reservedSize);
+}
+
+GLDeferredCommandBuffer::~GLDeferredCommandBuffer()
+{
+    FreePages();
 }
 
 /* ----- Encoding ----- */
 
 void GLDeferredCommandBuffer::Begin()
 {
-    /* Reset internal command buffer */
-    buffer_.clear();
+    /* Reset internal command buffer and recycle its pages */
+    FreePages();
+    decodedCommands_.clear();
     boundShaderProgram_ = 0;
 
     #ifdef LLGL_ENABLE_JIT_COMPILER
@@ -72,6 +80,10 @@ void GLDeferredCommandBuffer::Begin()
 
 void GLDeferredCommandBuffer::End()
 {
+    /* Optimize command stream before it is assembled */
+    if ((GetFlags() & CommandBufferFlags::Optimize) != 0)
+        OptimizeCommands();
+
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
     /* Generate native assembly only if command buffer will be submitted multiple times */
@@ -264,7 +276,7 @@ void GLDeferredCommandBuffer::SetViewports(std::uint32_t numViewports, const Vie
     #endif // /LLGL_ENABLE_JIT_COMPILER
 
     /* Encode GL command */
-    auto cmd = AllocCommand<GLCmdViewportArray>(GLOpcodeViewportArray, sizeof(GLViewport)*numViewports);
+    auto cmd = AllocCommand<GLCmdViewportArray>(GLOpcodeViewportArray, (sizeof(GLViewport) + sizeof(GLDepthRange))*numViewports);
     {
         cmd->first = 0;
         cmd->count = static_cast<GLsizei>(numViewports);
@@ -960,7 +972,7 @@ void GLDeferredCommandBuffer::PushDebugGroup(const char* name)
     if (HasExtension(GLExt::KHR_debug))
     {
         /* Push debug group name into command stream with default ID no. */
-        const GLint         maxLength       = GLStateManager::Get().GetLimits().maxDebugNameLength;
+        const GLint         maxLength       = maxDebugNameLength_;
         const GLuint        id              = 0;
         const std::size_t   actualLength    = std::strlen(name);
         const std::size_t   croppedLength   = std::min(actualLength, static_cast<std::size_t>(maxLength));
@@ -997,6 +1009,17 @@ void GLDeferredCommandBuffer::SetGraphicsAPIDependentState(const void* stateDesc
 
 /* ----- Internal ----- */
 
+const std::vector<GLDecodedCommand>& GLDeferredCommandBuffer::GetDecodedCommands() const
+{
+    /*
+    Decode command stream lazily for direct-threaded dispatch, so command buffers that are dispatched with the switch-based interpreter
+    don't pay for it, and the dispatch mode can still be switched between submissions of the same command buffer
+    */
+    if (decodedCommands_.empty() && firstPage_ != nullptr)
+        DecodeGLCommandBuffer(firstPage_, decodedCommands_);
+    return decodedCommands_;
+}
+
 bool GLDeferredCommandBuffer::IsImmediateCmdBuffer() const
 {
     return false;
@@ -1066,21 +1089,77 @@ void GLDeferredCommandBuffer::BindSampler(GLSampler& samplerGL, std::uint32_t sl
     }
 }
 
+void GLDeferredCommandBuffer::FreePages()
+{
+    pagePool_.FreePages(firstPage_);
+    firstPage_  = nullptr;
+    lastPage_   = nullptr;
+}
+
+std::uint8_t* GLDeferredCommandBuffer::AllocData(std::size_t size)
+{
+    /* Append new page if the command does not fit into the last page, since commands must not span multiple pages */
+    if (lastPage_ == nullptr || lastPage_->size + size > lastPage_->capacity)
+    {
+        auto page = pagePool_.AllocPage(size);
+        if (lastPage_ != nullptr)
+            lastPage_->next = page;
+        else
+            firstPage_ = page;
+        lastPage_ = page;
+    }
+
+    /* Zero-initialize command memory like a resized std::vector */
+    auto data = lastPage_->GetData() + lastPage_->size;
+    ::memset(data, 0, size);
+    lastPage_->size += size;
+
+    return data;
+}
+
+void GLDeferredCommandBuffer::OptimizeCommands()
+{
+    /* Copy command stream into contiguous buffer */
+    std::vector<std::uint8_t> buffer;
+    {
+        std::size_t size = 0;
+        for (auto page = firstPage_; page != nullptr; page = page->next)
+            size += page->size;
+
+        buffer.reserve(size);
+        for (auto page = firstPage_; page != nullptr; page = page->next)
+            buffer.insert(buffer.end(), page->GetData(), page->GetData() + page->size);
+    }
+
+    OptimizeGLCommandBuffer(buffer, HasExtension(GLExt::EXT_multi_draw_arrays), optimizerStats_);
+
+    /* Write optimized command stream back into recycled pages, one command at a time */
+    FreePages();
+
+    auto pc     = buffer.data();
+    auto pcEnd  = buffer.data() + buffer.size();
+
+    while (pc < pcEnd)
+    {
+        const auto opcode   = *reinterpret_cast<const GLOpcode*>(pc);
+        const auto cmdSize  = sizeof(GLOpcode) + GetGLCommandSize(opcode, pc + sizeof(GLOpcode));
+        ::memcpy(AllocData(cmdSize), pc, cmdSize);
+        pc += cmdSize;
+    }
+}
+
 void GLDeferredCommandBuffer::AllocOpCode(const GLOpcode opcode)
 {
-    buffer_.push_back(opcode);
+    *AllocData(sizeof(opcode)) = opcode;
 }
 
 template <typename T>
 T* GLDeferredCommandBuffer::AllocCommand(const GLOpcode opcode, std::size_t extraSize)
 {
-    /* Resize internal buffer for opcode, command structure, and extra size */
-    auto offset = buffer_.size();
-    {
-        buffer_.resize(offset + sizeof(opcode) + sizeof(T) + extraSize);
-        buffer_[offset] = opcode;
-    }
-    return reinterpret_cast<T*>(&(buffer_[offset + sizeof(opcode)]));
+    /* Allocate opcode, command structure, and extra size in a single page */
+    auto data = AllocData(sizeof(opcode) + sizeof(T) + extraSize);
+    *data = opcode;
+    return reinterpret_cast<T*>(data + sizeof(opcode));
 }
 
 
@@ -11,6 +11,9 @@
 
 #include "GLCommandBuffer.h"
 #include "GLCommandOpcode.h"
+#include "GLCommandOptimizer.h"
+#include "GLCommandExecutor.h"
+#include "GLCommandPagePool.h"
 #include "../RenderState/GLState.h"
 #include "../OpenGL.h"
 #include <memory>
@@ -34,12 +37,19 @@ class GLRenderContext;
 class GLStateManager;
 class GLRenderPass;
 
+/*
+Command buffer that records GL commands into a command stream for later execution.
+Encoding does not access the GL context or any shared mutable state other than the lock-free GLCommandPagePool,
+so different instances can be recorded on different threads at the same time (e.g. secondary command buffers).
+Execution of the command stream must still happen on the thread of the GL context.
+*/
 class GLDeferredCommandBuffer final : public GLCommandBuffer
 {
 
     public:
 
-        GLDeferredCommandBuffer(long flags, std::size_t reservedSize = 0);
+        GLDeferredCommandBuffer(long flags, GLCommandPagePool& pagePool, const CommandDispatchMode dispatchMode = CommandDispatchMode::Switch);
+        ~GLDeferredCommandBuffer();
 
         /* ----- Encoding ----- */
 
@@ -231,10 +241,10 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         // Returns true if this is a primary command buffer.
         bool IsPrimary() const;
 
-        // Returns the internal command buffer as raw byte buffer.
-        inline const std::vector<std::uint8_t>& GetRawBuffer() const
+        // Returns the first page of the internal command stream, or null if the command buffer is empty.
+        inline const GLCommandPage* GetFirstPage() const
         {
-            return buffer_;
+            return firstPage_;
         }
 
         // Returns the flags this command buffer was created with (see CommandBufferDescriptor::flags).
@@ -243,6 +253,27 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
             return flags_;
         }
 
+        // Returns the statistics of the last optimization pass (see CommandBufferFlags::Optimize).
+        inline const GLCommandOptimizerStats& GetOptimizerStats() const
+        {
+            return optimizerStats_;
+        }
+
+        // Sets the mode this command buffer is dispatched with on its next execution (see RenderSystemConfiguration::commandDispatch).
+        inline void SetDispatchMode(const CommandDispatchMode mode)
+        {
+            dispatchMode_ = mode;
+        }
+
+        // Returns the mode this command buffer is dispatched with.
+        inline CommandDispatchMode GetDispatchMode() const
+        {
+            return dispatchMode_;
+        }
+
+        // Returns the pre-decoded commands for direct-threaded dispatch (see CommandDispatchMode::Threaded). Decodes the command stream on the first call after End.
+        const std::vector<GLDecodedCommand>& GetDecodedCommands() const;
+
         #ifdef LLGL_ENABLE_JIT_COMPILER
 
         // Returns the just-in-time compiled command buffer that can be executed natively, or null if not available.
@@ -272,6 +303,15 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void BindTexture(GLTexture& textureGL, std::uint32_t slot);
         void BindSampler(GLSampler& samplerGL, std::uint32_t slot);
 
+        /* Releases all pages of the command stream back to the page pool */
+        void FreePages();
+
+        /* Allocates the specified amount of contiguous bytes in the command stream */
+        std::uint8_t* AllocData(std::size_t size);
+
+        /* Runs the command optimizer over the entire command stream */
+        void OptimizeCommands();
+
         /* Allocates only an opcode for empty commands */
         void AllocOpCode(const GLOpcode opcode);
 
@@ -281,17 +321,28 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
     private:
 
-        GLRenderState               renderState_;
-        GLClearValue                clearValue_;
-        GLuint                      boundShaderProgram_ = 0;
+        GLRenderState                   renderState_;
+        GLClearValue                    clearValue_;
+        GLuint                          boundShaderProgram_ = 0;
+
+        long                            flags_              = 0;
+        CommandDispatchMode             dispatchMode_       = CommandDispatchMode::Switch;
+        GLCommandPagePool&              pagePool_;
+        GLCommandPage*                  firstPage_          = nullptr;
+        GLCommandPage*                  lastPage_           = nullptr;
+        GLint                           maxDebugNameLength_ = 0;
+        GLCommandOptimizerStats         optimizerStats_;
 
-        long                        flags_              = 0;
-        std::vector<std::uint8_t>   buffer_;
+        /*
+        Decoded commands are mutable since they are only a cache of the command stream,
+        which is filled on the first execution with CommandDispatchMode::Threaded
+        */
+        mutable std::vector<GLDecodedCommand> decodedCommands_;
 
         #ifdef LLGL_ENABLE_JIT_COMPILER
-        std::unique_ptr<JITProgram> executable_;
-        std::uint32_t               maxNumViewports_    = 0;
-        std::uint32_t               maxNumScissors_     = 0;
+        std::unique_ptr<JITProgram>     executable_;
+        std::uint32_t                   maxNumViewports_    = 0;
+        std::uint32_t                   maxNumScissors_     = 0;
         #endif // /LLGL_ENABLE_JIT_COMPILER
 
 };
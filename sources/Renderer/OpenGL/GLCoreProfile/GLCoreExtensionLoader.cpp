@@ -213,6 +213,12 @@ static bool Load_GL_ARB_draw_instanced(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_EXT_multi_draw_arrays(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMultiDrawArrays );
+    return true;
+}
+
 static bool Load_GL_ARB_base_instance(bool usePlaceholder)
 {
     LOAD_GLPROC( glDrawArraysInstancedBaseInstance             );
@@ -886,6 +892,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     /* Enable drawing extensions */
     ENABLE_GLEXT( ARB_draw_instanced               );
     ENABLE_GLEXT( ARB_draw_elements_base_vertex    );
+    ENABLE_GLEXT( EXT_multi_draw_arrays            );
 
     /* Enable shader extensions */
     ENABLE_GLEXT( ARB_shader_objects               );
@@ -989,6 +996,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
             "GL_ARB_vertex_shader",
             "GL_EXT_texture3D",
             "GL_EXT_copy_texture",
+            "GL_EXT_multi_draw_arrays",
         };
         for (const auto& ext : coreProfileDefaultExtenions)
             extensions[ext] = false;
@@ -1010,6 +1018,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_draw_instanced               );
     LOAD_GLEXT( ARB_base_instance                );
     LOAD_GLEXT( ARB_draw_elements_base_vertex    );
+    LOAD_GLEXT( EXT_multi_draw_arrays            );
 
     /* Load shader extensions */
     LOAD_GLEXT( ARB_shader_objects               );
@@ -243,6 +243,10 @@ DECL_GLPROC(PFNGLCLEARBUFFERFIPROC,                                 glClearBuffe
 DECL_GLPROC(PFNGLDRAWARRAYSINSTANCEDPROC,                           glDrawArraysInstanced,                          void,           (GLenum, GLint, GLsizei, GLsizei));
 DECL_GLPROC(PFNGLDRAWELEMENTSINSTANCEDPROC,                         glDrawElementsInstanced,                        void,           (GLenum, GLsizei, GLenum, const void*, GLsizei));
 
+/* GL_EXT_multi_draw_arrays */
+
+DECL_GLPROC(PFNGLMULTIDRAWARRAYSPROC,                              glMultiDrawArrays,                              void,           (GLenum, const GLint*, const GLsizei*, GLsizei));
+
 /* GL_ARB_draw_elements_base_vertex */
 
 DECL_GLPROC(PFNGLDRAWELEMENTSBASEVERTEXPROC,                        glDrawElementsBaseVertex,                       void,           (GLenum, GLsizei, GLenum, const void*, GLint));
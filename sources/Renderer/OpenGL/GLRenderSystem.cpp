@@ -24,6 +24,7 @@
 #include "GLRenderingCaps.h"
 #include "Command/GLImmediateCommandBuffer.h"
 #include "Command/GLDeferredCommandBuffer.h"
+#include "Command/GLCommandExecutor.h"
 #include "RenderState/GLGraphicsPSO.h"
 #include "RenderState/GLComputePSO.h"
 
@@ -44,6 +45,10 @@ GLRenderSystem::GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
     /* Extract optional renderer configuartion */
     if (auto rendererConfigGL = GetRendererConfiguration<RendererConfigurationOpenGL>(renderSystemDesc))
         config_ = *rendererConfigGL;
+
+    /* Open optional trace file for GL state changes */
+    if (!config_.stateTraceFilename.empty())
+        stateTrace_ = MakeUnique<GLStateTrace>(config_.stateTraceFilename);
 }
 
 GLRenderSystem::~GLRenderSystem()
@@ -54,6 +59,21 @@ GLRenderSystem::~GLRenderSystem()
     GLStatePool::Get().Clear();
 }
 
+void GLRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
+{
+    RenderSystem::SetConfiguration(config);
+
+    /* Update dispatch mode of all deferred command buffers */
+    for (const auto& cmdBuffer : commandBuffers_)
+    {
+        if (!cmdBuffer->IsImmediateCmdBuffer())
+        {
+            auto deferredCmdBufferGL = LLGL_CAST(GLDeferredCommandBuffer*, cmdBuffer.get());
+            deferredCmdBufferGL->SetDispatchMode(config.commandDispatch);
+        }
+    }
+}
+
 /* ----- Render Context ----- */
 
 // private
@@ -86,12 +106,12 @@ CommandBuffer* GLRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
     /* Get state manager from shared render context */
     if (auto sharedContext = GetSharedRenderContext())
     {
-        if ((desc.flags & (CommandBufferFlags::DeferredSubmit | CommandBufferFlags::MultiSubmit)) != 0)
+        if ((desc.flags & (CommandBufferFlags::DeferredSubmit | CommandBufferFlags::MultiSubmit | CommandBufferFlags::Optimize)) != 0)
         {
             /* Create deferred command buffer */
             return TakeOwnership(
                 commandBuffers_,
-                MakeUnique<GLDeferredCommandBuffer>(desc.flags)
+                MakeUnique<GLDeferredCommandBuffer>(desc.flags, commandPagePool_, GetConfiguration().commandDispatch)
             );
         }
         else
@@ -522,6 +542,15 @@ RenderContext* GLRenderSystem::AddRenderContext(std::unique_ptr<GLRenderContext>
     if (renderContexts_.empty())
         CreateGLContextDependentDevices(*renderContext);
 
+    /*
+    Count and record state changes of every render context: contexts share the state manager of the first context,
+    but a new state manager is created when a context is added after all previous contexts have been released
+    */
+    auto& stateMngr = renderContext->GetStateManager();
+    stateMngr->SetCountersEnabled(config_.profiler != nullptr);
+    if (stateTrace_)
+        stateMngr->SetTrace(stateTrace_.get());
+
     /* Use uniform clipping space */
     GLStateManager::Get().DetermineExtensionsAndLimits();
     
@@ -550,7 +579,7 @@ void GLRenderSystem::CreateGLContextDependentDevices(GLRenderContext& renderCont
         SetDebugCallback(debugCallback_);
 
     /* Create command queue instance */
-    commandQueue_ = MakeUnique<GLCommandQueue>(renderContext.GetStateManager());
+    commandQueue_ = MakeUnique<GLCommandQueue>(renderContext.GetStateManager(), config_.profiler, stateTrace_.get());
 }
 
 void GLRenderSystem::LoadGLExtensions(bool hasGLCoreProfile)
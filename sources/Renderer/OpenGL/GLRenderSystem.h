@@ -15,6 +15,7 @@
 
 #include "Command/GLCommandQueue.h"
 #include "Command/GLCommandBuffer.h"
+#include "Command/GLCommandPagePool.h"
 #include "GLRenderContext.h"
 
 #include "Buffer/GLBuffer.h"
@@ -36,6 +37,7 @@
 #include "RenderState/GLPipelineLayout.h"
 #include "RenderState/GLPipelineState.h"
 #include "RenderState/GLResourceHeap.h"
+#include "RenderState/GLStateTrace.h"
 
 #include <string>
 #include <memory>
@@ -57,6 +59,8 @@ class GLRenderSystem final : public RenderSystem
         GLRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~GLRenderSystem();
 
+        void SetConfiguration(const RenderSystemConfiguration& config) override;
+
         /* ----- Render Context ----- */
 
         RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
@@ -177,6 +181,9 @@ class GLRenderSystem final : public RenderSystem
 
         /* ----- Hardware object containers ----- */
 
+        GLCommandPagePool                       commandPagePool_;   // Must be declared before the command buffers that use it
+        std::unique_ptr<GLStateTrace>           stateTrace_;        // Must be declared before the render contexts whose state manager records into it
+
         HWObjectContainer<GLRenderContext>      renderContexts_;
         HWObjectInstance<GLCommandQueue>        commandQueue_;
         HWObjectContainer<GLCommandBuffer>      commandBuffers_;
@@ -70,6 +70,7 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsInstanced );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsInstancedBaseVertex );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsInstancedBaseVertexBaseInstance );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsIndirect );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawArrays );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawArraysIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawElementsIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDispatchCompute );
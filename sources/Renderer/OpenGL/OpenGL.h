@@ -28,6 +28,10 @@
 #   define LLGL_GLEXT_BASE_INSTANCE
 #endif
 
+#if defined LLGL_OPENGL
+#   define LLGL_GLEXT_MULTI_DRAW_ARRAYS
+#endif
+
 #if defined GL_ARB_multi_draw_indirect
 #   define LLGL_GLEXT_MULTI_DRAW_INDIRECT
 #endif
@@ -13,6 +13,7 @@
 #include "../GLProfile.h"
 #include "../../PipelineStateUtils.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/Helper.h"
 #include "../Texture/GLRenderTarget.h"
 #include "GLStateManager.h"
 #include <LLGL/PipelineStateFlags.h>
@@ -63,6 +64,8 @@ GLBlendState::GLBlendState(const BlendDescriptor& desc, std::uint32_t numColorAt
     if (multiSampleEnabled_)
         stateMngr.SetSampleMask(sampleMask_);
     #endif
+
+    ComputeHash();
 }
 
 void GLBlendState::Bind(GLStateManager& stateMngr)
@@ -108,6 +111,8 @@ void GLBlendState::BindColorMaskOnly(GLStateManager& stateMngr)
 
 int GLBlendState::CompareSWO(const GLBlendState& lhs, const GLBlendState& rhs)
 {
+    LLGL_COMPARE_BOOL_MEMBER_SWO( blendColorDynamic_     );
+    LLGL_COMPARE_BOOL_MEMBER_SWO( blendColorEnabled_     );
     LLGL_COMPARE_MEMBER_SWO     ( blendColor_[0]         );
     LLGL_COMPARE_MEMBER_SWO     ( blendColor_[1]         );
     LLGL_COMPARE_MEMBER_SWO     ( blendColor_[2]         );
@@ -135,6 +140,39 @@ int GLBlendState::CompareSWO(const GLBlendState& lhs, const GLBlendState& rhs)
  * ======= Private: =======
  */
 
+void GLBlendState::ComputeHash()
+{
+    std::size_t seed = 0;
+
+    HashCombine(seed, blendColorDynamic_);
+    HashCombine(seed, blendColorEnabled_);
+    for (auto component : blendColor_)
+        HashCombine(seed, component);
+    HashCombine(seed, sampleAlphaToCoverage_);
+
+    #ifdef LLGL_OPENGL
+    HashCombine(seed, logicOpEnabled_);
+    HashCombine(seed, logicOp_);
+    #endif
+
+    HashCombine(seed, numDrawBuffers_);
+    for (decltype(numDrawBuffers_) i = 0; i < numDrawBuffers_; ++i)
+    {
+        const auto& state = drawBuffers_[i];
+        HashCombine(seed, state.blendEnabled);
+        HashCombine(seed, state.srcColor);
+        HashCombine(seed, state.dstColor);
+        HashCombine(seed, state.funcColor);
+        HashCombine(seed, state.srcAlpha);
+        HashCombine(seed, state.dstAlpha);
+        HashCombine(seed, state.funcAlpha);
+        for (auto mask : state.colorMask)
+            HashCombine(seed, mask);
+    }
+
+    hash_ = seed;
+}
+
 void GLBlendState::BindDrawBufferStates(GLStateManager& stateMngr)
 {
     if (numDrawBuffers_ == 1)
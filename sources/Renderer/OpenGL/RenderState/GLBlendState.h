@@ -13,6 +13,8 @@
 #include <LLGL/StaticLimits.h>
 #include "../OpenGL.h"
 #include <memory>
+#include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -46,6 +48,12 @@ class GLBlendState
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         static int CompareSWO(const GLBlendState& lhs, const GLBlendState& rhs);
 
+        // Returns the hash value of this state that was computed at construction. States that are equal in terms of CompareSWO have equal hash values.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
     private:
 
         struct GLDrawBufferState
@@ -74,6 +82,8 @@ class GLBlendState
         void BindDrawBufferColorMask(const GLDrawBufferState& state);
         void BindIndexedDrawBufferColorMask(const GLDrawBufferState& state, GLuint index);
 
+        void ComputeHash();
+
     private:
 
         bool                blendColorDynamic_                              = false;
@@ -88,6 +98,8 @@ class GLBlendState
         GLuint              numDrawBuffers_                                 = 0;
         GLDrawBufferState   drawBuffers_[LLGL_MAX_NUM_COLOR_ATTACHMENTS]    = {};
 
+        std::size_t         hash_                                           = 0;
+
 };
 
 
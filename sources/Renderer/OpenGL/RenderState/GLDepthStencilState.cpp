@@ -11,6 +11,7 @@
 #include "../GLCore.h"
 #include "../GLTypes.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/Helper.h"
 #include "GLStateManager.h"
 #include <LLGL/PipelineStateFlags.h>
 
@@ -34,6 +35,8 @@ GLDepthStencilState::GLDepthStencilState(const DepthDescriptor& depthDesc, const
     GLStencilFaceState::Convert(stencilBack_, stencilDesc.back, stencilDesc.referenceDynamic);
 
     independentStencilFaces_ = (GLStencilFaceState::CompareSWO(stencilFront_, stencilBack_) != 0);
+
+    ComputeHash();
 }
 
 void GLDepthStencilState::Bind(GLStateManager& stateMngr)
@@ -117,9 +120,9 @@ void GLDepthStencilState::BindStencilWriteMaskOnly()
 int GLDepthStencilState::CompareSWO(const GLDepthStencilState& lhs, const GLDepthStencilState& rhs)
 {
     LLGL_COMPARE_BOOL_MEMBER_SWO( depthTestEnabled_ );
+    LLGL_COMPARE_MEMBER_SWO( depthMask_ );
     if (lhs.depthTestEnabled_)
     {
-        LLGL_COMPARE_MEMBER_SWO( depthMask_ );
         LLGL_COMPARE_MEMBER_SWO( depthFunc_ );
     }
 
@@ -134,7 +137,7 @@ int GLDepthStencilState::CompareSWO(const GLDepthStencilState& lhs, const GLDept
                 return order;
         }
 
-        if (!lhs.independentStencilFaces_)
+        if (lhs.independentStencilFaces_)
         {
             auto order = GLStencilFaceState::CompareSWO(lhs.stencilBack_, rhs.stencilBack_);
             if (order != 0)
@@ -150,6 +153,39 @@ int GLDepthStencilState::CompareSWO(const GLDepthStencilState& lhs, const GLDept
  * ======= Private: =======
  */
 
+void GLDepthStencilState::ComputeHash()
+{
+    std::size_t seed = 0;
+
+    /* Only hash the parameters that are considered by CompareSWO */
+    HashCombine(seed, depthTestEnabled_);
+    HashCombine(seed, depthMask_);
+    if (depthTestEnabled_)
+        HashCombine(seed, depthFunc_);
+
+    HashCombine(seed, stencilTestEnabled_);
+    if (stencilTestEnabled_)
+    {
+        auto HashStencilFace = [&seed](const GLStencilFaceState& state)
+        {
+            HashCombine(seed, state.sfail);
+            HashCombine(seed, state.dpfail);
+            HashCombine(seed, state.dppass);
+            HashCombine(seed, state.func);
+            HashCombine(seed, state.ref);
+            HashCombine(seed, state.mask);
+            HashCombine(seed, state.writeMask);
+        };
+
+        HashCombine(seed, independentStencilFaces_);
+        HashStencilFace(stencilFront_);
+        if (independentStencilFaces_)
+            HashStencilFace(stencilBack_);
+    }
+
+    hash_ = seed;
+}
+
 void GLDepthStencilState::BindStencilFaceState(const GLStencilFaceState& state, GLenum face)
 {
     glStencilOpSeparate(face, state.sfail, state.dpfail, state.dppass);
@@ -13,6 +13,7 @@
 #include <LLGL/StaticLimits.h>
 #include "../OpenGL.h"
 #include <memory>
+#include <cstddef>
 #include <limits.h>
 
 
@@ -50,6 +51,12 @@ class GLDepthStencilState
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         static int CompareSWO(const GLDepthStencilState& lhs, const GLDepthStencilState& rhs);
 
+        // Returns the hash value of this state that was computed at construction. States that are equal in terms of CompareSWO have equal hash values.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
     private:
 
         struct GLStencilFaceState
@@ -71,6 +78,8 @@ class GLDepthStencilState
         void BindStencilFaceState(const GLStencilFaceState& state, GLenum face);
         void BindStencilState(const GLStencilFaceState& state);
 
+        void ComputeHash();
+
     private:
 
         // Depth states
@@ -85,6 +94,8 @@ class GLDepthStencilState
         GLStencilFaceState  stencilFront_;
         GLStencilFaceState  stencilBack_;
 
+        std::size_t         hash_                       = 0;
+
 };
 
 
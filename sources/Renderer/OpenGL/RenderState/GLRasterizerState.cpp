@@ -11,6 +11,7 @@
 #include "../GLCore.h"
 #include "../GLTypes.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/Helper.h"
 #include "GLStateManager.h"
 #include <LLGL/PipelineStateFlags.h>
 
@@ -64,6 +65,8 @@ GLRasterizerState::GLRasterizerState(const RasterizerDescriptor& desc)
     #ifdef LLGL_GL_ENABLE_VENDOR_EXT
     conservativeRaster_     = desc.conservativeRasterization;
     #endif
+
+    ComputeHash();
 }
 
 void GLRasterizerState::Bind(GLStateManager& stateMngr)
@@ -111,6 +114,7 @@ int GLRasterizerState::CompareSWO(const GLRasterizerState& lhs, const GLRasteriz
 
     LLGL_COMPARE_MEMBER_SWO     ( cullFace_             );
     LLGL_COMPARE_MEMBER_SWO     ( frontFace_            );
+    LLGL_COMPARE_BOOL_MEMBER_SWO( rasterizerDiscard_    );
     LLGL_COMPARE_BOOL_MEMBER_SWO( scissorTestEnabled_   );
     LLGL_COMPARE_BOOL_MEMBER_SWO( multiSampleEnabled_   );
     LLGL_COMPARE_BOOL_MEMBER_SWO( lineSmoothEnabled_    );
@@ -129,6 +133,40 @@ int GLRasterizerState::CompareSWO(const GLRasterizerState& lhs, const GLRasteriz
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void GLRasterizerState::ComputeHash()
+{
+    std::size_t seed = 0;
+
+    #ifdef LLGL_OPENGL
+    HashCombine(seed, polygonMode_);
+    HashCombine(seed, depthClampEnabled_);
+    #endif
+
+    HashCombine(seed, cullFace_);
+    HashCombine(seed, frontFace_);
+    HashCombine(seed, rasterizerDiscard_);
+    HashCombine(seed, scissorTestEnabled_);
+    HashCombine(seed, multiSampleEnabled_);
+    HashCombine(seed, lineSmoothEnabled_);
+    HashCombine(seed, lineWidth_);
+    HashCombine(seed, polygonOffsetEnabled_);
+    HashCombine(seed, static_cast<int>(polygonOffsetMode_));
+    HashCombine(seed, polygonOffsetFactor_);
+    HashCombine(seed, polygonOffsetUnits_);
+    HashCombine(seed, polygonOffsetClamp_);
+
+    #ifdef LLGL_GL_ENABLE_VENDOR_EXT
+    HashCombine(seed, conservativeRaster_);
+    #endif
+
+    hash_ = seed;
+}
+
+
 } // /namespace LLGL
 
 
@@ -44,6 +44,16 @@ class GLRasterizerState
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         static int CompareSWO(const GLRasterizerState& lhs, const GLRasterizerState& rhs);
 
+        // Returns the hash value of this state that was computed at construction. States that are equal in terms of CompareSWO have equal hash values.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
+    private:
+
+        void ComputeHash();
+
     private:
 
         #ifdef LLGL_OPENGL
@@ -68,6 +78,8 @@ class GLRasterizerState
         bool        conservativeRaster_     = false;    // glEnable(GL_CONSERVATIVE_RASTERIZATION_NV/INTEL)
         #endif
 
+        std::size_t hash_                   = 0;
+
 };
 
 
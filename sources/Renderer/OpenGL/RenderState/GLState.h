@@ -10,6 +10,8 @@
 
 
 #include "../GLProfile.h"
+#include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -109,6 +111,20 @@ enum class GLTextureTarget
     Num,
 };
 
+// Categories of GL state changes for the redundant-call statistics of the GLStateManager.
+enum class GLStateCategory
+{
+    Capability = 0, // glEnable/glDisable
+    RenderState,    // Fixed function states, e.g. glDepthFunc, glCullFace, glBlendColor
+    Buffer,         // glBindBuffer, glBindBufferBase, glBindBufferRange
+    VertexArray,    // glBindVertexArray
+    Framebuffer,    // glBindFramebuffer, glBindRenderbuffer
+    Texture,        // glActiveTexture, glBindTexture, glBindImageTexture
+    Sampler,        // glBindSampler
+    ShaderProgram,  // glUseProgram
+    Num,
+};
+
 
 /* ----- Structures ----- */
 
@@ -157,6 +173,13 @@ struct GLPixelStore
     GLint alignment     = 4; // Must be 1, 2, 4, or 8
 };
 
+// Number of GL calls that have been issued and elided (i.e. filtered out as redundant) per state category.
+struct GLStateCounters
+{
+    std::uint32_t issued[static_cast<std::size_t>(GLStateCategory::Num)] = {};
+    std::uint32_t elided[static_cast<std::size_t>(GLStateCategory::Num)] = {};
+};
+
 
 } // /namespace LLGL
 
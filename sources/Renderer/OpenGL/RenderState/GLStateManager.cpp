@@ -10,6 +10,7 @@
 #include "GLDepthStencilState.h"
 #include "GLRasterizerState.h"
 #include "GLBlendState.h"
+#include "GLStateTrace.h"
 #include "../GLRenderContext.h"
 #include "../Buffer/GLBuffer.h"
 #include "../Texture/GLTexture.h"
@@ -230,7 +231,7 @@ void GLStateManager::Reset()
 void GLStateManager::Set(GLState state, bool value)
 {
     auto idx = static_cast<std::size_t>(state);
-    if (capabilityState_.values[idx] != value)
+    if (CountStateChange(GLStateCategory::Capability, capabilityState_.values[idx] != value, g_stateCapsEnum[idx]))
     {
         capabilityState_.values[idx] = value;
         if (value)
@@ -243,7 +244,7 @@ void GLStateManager::Set(GLState state, bool value)
 void GLStateManager::Enable(GLState state)
 {
     auto idx = static_cast<std::size_t>(state);
-    if (!capabilityState_.values[idx])
+    if (CountStateChange(GLStateCategory::Capability, !capabilityState_.values[idx], g_stateCapsEnum[idx]))
     {
         capabilityState_.values[idx] = true;
         glEnable(g_stateCapsEnum[idx]);
@@ -253,7 +254,7 @@ void GLStateManager::Enable(GLState state)
 void GLStateManager::Disable(GLState state)
 {
     auto idx = static_cast<std::size_t>(state);
-    if (capabilityState_.values[idx])
+    if (CountStateChange(GLStateCategory::Capability, capabilityState_.values[idx], g_stateCapsEnum[idx]))
     {
         capabilityState_.values[idx] = false;
         glDisable(g_stateCapsEnum[idx]);
@@ -297,7 +298,7 @@ void GLStateManager::Set(GLStateExt state, bool value)
 {
     auto idx = static_cast<std::size_t>(state);
     auto& val = capabilityStateExt_.values[idx];
-    if (val.cap != 0 && val.enabled != value)
+    if (val.cap != 0 && CountStateChange(GLStateCategory::Capability, val.enabled != value, val.cap))
     {
         val.enabled = value;
         if (value)
@@ -311,7 +312,7 @@ void GLStateManager::Enable(GLStateExt state)
 {
     auto idx = static_cast<std::size_t>(state);
     auto& val = capabilityStateExt_.values[idx];
-    if (val.cap != 0 && !val.enabled)
+    if (val.cap != 0 && CountStateChange(GLStateCategory::Capability, !val.enabled, val.cap))
     {
         val.enabled = true;
         glEnable(val.cap);
@@ -322,7 +323,7 @@ void GLStateManager::Disable(GLStateExt state)
 {
     auto idx = static_cast<std::size_t>(state);
     auto& val = capabilityStateExt_.values[idx];
-    if (val.cap != 0 && val.enabled)
+    if (val.cap != 0 && CountStateChange(GLStateCategory::Capability, val.enabled, val.cap))
     {
         val.enabled = false;
         glDisable(val.cap);
@@ -351,6 +352,7 @@ void GLStateManager::SetViewport(GLViewport& viewport)
     if (emulateClipControl_ && !apiDependentState_.originLowerLeft)
         AdjustViewport(viewport);
 
+    CountStateChange(GLStateCategory::RenderState, true);
     glViewport(
         static_cast<GLint>(viewport.x),
         static_cast<GLint>(viewport.y),
@@ -385,6 +387,7 @@ void GLStateManager::SetViewportArray(GLuint first, GLsizei count, GLViewport* v
                 AdjustViewport(viewports[i]);
         }
 
+        CountStateChange(GLStateCategory::RenderState, true);
         glViewportArrayv(first, count, reinterpret_cast<const GLfloat*>(viewports));
     }
     else
@@ -398,6 +401,7 @@ void GLStateManager::SetViewportArray(GLuint first, GLsizei count, GLViewport* v
 
 void GLStateManager::SetDepthRange(const GLDepthRange& depthRange)
 {
+    CountStateChange(GLStateCategory::RenderState, true);
     GLProfile::DepthRange(depthRange.minDepth, depthRange.maxDepth);
 }
 
@@ -409,6 +413,7 @@ void GLStateManager::SetDepthRangeArray(GLuint first, GLsizei count, const GLDep
         AssertViewportLimit(first, count);
         AssertExtViewportArray();
 
+        CountStateChange(GLStateCategory::RenderState, true);
         glDepthRangeArrayv(first, count, reinterpret_cast<const GLdouble*>(depthRanges));
     }
     else
@@ -431,6 +436,7 @@ void GLStateManager::SetScissor(GLScissor& scissor)
     if (emulateClipControl_)
         AdjustScissor(scissor);
 
+    CountStateChange(GLStateCategory::RenderState, true);
     glScissor(scissor.x, scissor.y, scissor.width, scissor.height);
 }
 
@@ -449,6 +455,7 @@ void GLStateManager::SetScissorArray(GLuint first, GLsizei count, GLScissor* sci
                 AdjustScissor(scissors[0]);
         }
 
+        CountStateChange(GLStateCategory::RenderState, true);
         glScissorArrayv(first, count, reinterpret_cast<const GLint*>(scissors));
     }
     else
@@ -476,7 +483,7 @@ void GLStateManager::SetClipControl(GLenum origin, GLenum depth)
 void GLStateManager::SetPolygonMode(GLenum mode)
 {
     #ifdef LLGL_OPENGL
-    if (commonState_.polygonMode != mode)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.polygonMode != mode, mode))
     {
         commonState_.polygonMode = mode;
         glPolygonMode(GL_FRONT_AND_BACK, mode);
@@ -489,7 +496,7 @@ void GLStateManager::SetPolygonOffset(GLfloat factor, GLfloat units, GLfloat cla
     #ifdef GL_ARB_polygon_offset_clamp
     if (HasExtension(GLExt::ARB_polygon_offset_clamp))
     {
-        if (commonState_.offsetFactor != factor || commonState_.offsetUnits != units || commonState_.offsetClamp != clamp)
+        if (CountStateChange(GLStateCategory::RenderState, commonState_.offsetFactor != factor || commonState_.offsetUnits != units || commonState_.offsetClamp != clamp))
         {
             commonState_.offsetFactor   = factor;
             commonState_.offsetUnits    = units;
@@ -500,7 +507,7 @@ void GLStateManager::SetPolygonOffset(GLfloat factor, GLfloat units, GLfloat cla
     else
     #endif
     {
-        if (commonState_.offsetFactor != factor || commonState_.offsetUnits != units)
+        if (CountStateChange(GLStateCategory::RenderState, commonState_.offsetFactor != factor || commonState_.offsetUnits != units))
         {
             commonState_.offsetFactor   = factor;
             commonState_.offsetUnits    = units;
@@ -511,7 +518,7 @@ void GLStateManager::SetPolygonOffset(GLfloat factor, GLfloat units, GLfloat cla
 
 void GLStateManager::SetCullFace(GLenum face)
 {
-    if (commonState_.cullFace != face)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.cullFace != face, face))
     {
         commonState_.cullFace = face;
         glCullFace(face);
@@ -528,7 +535,7 @@ void GLStateManager::SetFrontFace(GLenum mode)
         mode = (mode == GL_CW ? GL_CCW : GL_CW);
 
     /* Set front face */
-    if (commonState_.frontFace != mode)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.frontFace != mode, mode))
     {
         commonState_.frontFace = mode;
         glFrontFace(mode);
@@ -538,7 +545,7 @@ void GLStateManager::SetFrontFace(GLenum mode)
 void GLStateManager::SetPatchVertices(GLint patchVertices)
 {
     #ifdef LLGL_GLEXT_TESSELLATION_SHADER
-    if (commonState_.patchVertices != patchVertices)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.patchVertices != patchVertices, static_cast<std::uint32_t>(patchVertices)))
     {
         commonState_.patchVertices = patchVertices;
         glPatchParameteri(GL_PATCH_VERTICES, patchVertices);
@@ -550,7 +557,7 @@ void GLStateManager::SetLineWidth(GLfloat width)
 {
     /* Clamp width silently into limited range */
     width = std::max(limits_.lineWidthRange[0], std::min(width, limits_.lineWidthRange[1]));
-    if (commonState_.lineWidth != width)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.lineWidth != width))
     {
         commonState_.lineWidth = width;
         glLineWidth(width);
@@ -562,7 +569,7 @@ void GLStateManager::SetPrimitiveRestartIndex(GLuint index)
     #ifdef LLGL_PRIMITIVE_RESTART
     if (HasExtension(GLExt::ARB_compatibility))
     {
-        if (commonState_.primitiveRestartIndex != index)
+        if (CountStateChange(GLStateCategory::RenderState, commonState_.primitiveRestartIndex != index, index))
         {
             commonState_.primitiveRestartIndex = index;
             glPrimitiveRestartIndex(index);
@@ -630,7 +637,7 @@ void GLStateManager::BindDepthStencilState(GLDepthStencilState* depthStencilStat
 
 void GLStateManager::SetDepthFunc(GLenum func)
 {
-    if (commonState_.depthFunc != func)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.depthFunc != func, func))
     {
         commonState_.depthFunc = func;
         glDepthFunc(func);
@@ -639,7 +646,7 @@ void GLStateManager::SetDepthFunc(GLenum func)
 
 void GLStateManager::SetDepthMask(GLboolean flag)
 {
-    if (commonState_.depthMask != flag)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.depthMask != flag, flag))
     {
         commonState_.depthMask = flag;
         glDepthMask(flag);
@@ -688,10 +695,14 @@ void GLStateManager::BindBlendState(GLBlendState* blendState)
 
 void GLStateManager::SetBlendColor(const GLfloat* color)
 {
-    if ( color[0] != commonState_.blendColor[0] ||
-         color[1] != commonState_.blendColor[1] ||
-         color[2] != commonState_.blendColor[2] ||
-         color[3] != commonState_.blendColor[3] )
+    const bool changed =
+    (
+        color[0] != commonState_.blendColor[0] ||
+        color[1] != commonState_.blendColor[1] ||
+        color[2] != commonState_.blendColor[2] ||
+        color[3] != commonState_.blendColor[3]
+    );
+    if (CountStateChange(GLStateCategory::RenderState, changed))
     {
         commonState_.blendColor[0] = color[0];
         commonState_.blendColor[1] = color[1];
@@ -704,7 +715,7 @@ void GLStateManager::SetBlendColor(const GLfloat* color)
 void GLStateManager::SetLogicOp(GLenum opcode)
 {
     #ifdef LLGL_OPENGL
-    if (commonState_.logicOpCode != opcode)
+    if (CountStateChange(GLStateCategory::RenderState, commonState_.logicOpCode != opcode, opcode))
     {
         commonState_.logicOpCode = opcode;
         glLogicOp(opcode);
@@ -724,7 +735,7 @@ void GLStateManager::BindBuffer(GLBufferTarget target, GLuint buffer)
 {
     /* Only bind buffer if the buffer has changed */
     auto targetIdx = static_cast<std::size_t>(target);
-    if (bufferState_.boundBuffers[targetIdx] != buffer)
+    if (CountStateChange(GLStateCategory::Buffer, bufferState_.boundBuffers[targetIdx] != buffer, buffer))
     {
         glBindBuffer(g_bufferTargetsEnum[targetIdx], buffer);
         bufferState_.boundBuffers[targetIdx] = buffer;
@@ -735,6 +746,7 @@ void GLStateManager::BindBufferBase(GLBufferTarget target, GLuint index, GLuint
 {
     /* Always bind buffer with a base index */
     auto targetIdx = static_cast<std::size_t>(target);
+    CountStateChange(GLStateCategory::Buffer, true, buffer);
     glBindBufferBase(g_bufferTargetsEnum[targetIdx], index, buffer);
     bufferState_.boundBuffers[targetIdx] = buffer;
 }
@@ -752,6 +764,7 @@ void GLStateManager::BindBuffersBase(GLBufferTarget target, GLuint first, GLsize
         Bind buffer array, but don't reset the currently bound buffer.
         The spec. of GL_ARB_multi_bind says, that the generic binding point is not modified by this function!
         */
+        CountStateChange(GLStateCategory::Buffer, true, static_cast<std::uint32_t>(count));
         glBindBuffersBase(targetGL, first, count, buffers);
     }
     else
@@ -762,7 +775,10 @@ void GLStateManager::BindBuffersBase(GLBufferTarget target, GLuint first, GLsize
         bufferState_.boundBuffers[targetIdx] = buffers[count - 1];
 
         for (GLsizei i = 0; i < count; ++i)
+        {
+            CountStateChange(GLStateCategory::Buffer, true, buffers[i]);
             glBindBufferBase(targetGL, first + i, buffers[i]);
+        }
     }
 }
 
@@ -770,6 +786,7 @@ void GLStateManager::BindBufferRange(GLBufferTarget target, GLuint index, GLuint
 {
     /* Always bind buffer with a base index */
     auto targetIdx = static_cast<std::size_t>(target);
+    CountStateChange(GLStateCategory::Buffer, true, buffer);
     glBindBufferRange(g_bufferTargetsEnum[targetIdx], index, buffer, offset, size);
     bufferState_.boundBuffers[targetIdx] = buffer;
 }
@@ -787,6 +804,7 @@ void GLStateManager::BindBuffersRange(GLBufferTarget target, GLuint first, GLsiz
         Bind buffer array, but don't reset the currently bound buffer.
         The spec. of GL_ARB_multi_bind says, that the generic binding point is not modified by this function!
         */
+        CountStateChange(GLStateCategory::Buffer, true, static_cast<std::uint32_t>(count));
         glBindBuffersRange(targetGL, first, count, buffers, offsets, sizes);
     }
     else
@@ -800,13 +818,19 @@ void GLStateManager::BindBuffersRange(GLBufferTarget target, GLuint first, GLsiz
         if (HasExtension(GLExt::NV_transform_feedback))
         {
             for (GLsizei i = 0; i < count; ++i)
+            {
+                CountStateChange(GLStateCategory::Buffer, true, buffers[i]);
                 glBindBufferRangeNV(targetGL, first + i, buffers[i], offsets[i], sizes[i]);
+            }
         }
         else
         #endif // /GL_NV_transform_feedback
         {
             for (GLsizei i = 0; i < count; ++i)
+            {
+                CountStateChange(GLStateCategory::Buffer, true, buffers[i]);
                 glBindBufferRange(targetGL, first + i, buffers[i], offsets[i], sizes[i]);
+            }
         }
     }
 }
@@ -825,7 +849,7 @@ static GLuint GetPrimitiveRestartIndex(bool indexType16Bits)
 void GLStateManager::BindVertexArray(GLuint vertexArray)
 {
     /* Only bind VAO if it has changed */
-    if (vertexArrayState_.boundVertexArray != vertexArray)
+    if (CountStateChange(GLStateCategory::VertexArray, vertexArrayState_.boundVertexArray != vertexArray, vertexArray))
     {
         /* Bind VAO */
         glBindVertexArray(vertexArray);
@@ -969,7 +993,7 @@ void GLStateManager::BindFramebuffer(GLFramebufferTarget target, GLuint framebuf
 {
     /* Only bind framebuffer if the framebuffer has changed */
     auto targetIdx = static_cast<std::size_t>(target);
-    if (framebufferState_.boundFramebuffers[targetIdx] != framebuffer)
+    if (CountStateChange(GLStateCategory::Framebuffer, framebufferState_.boundFramebuffers[targetIdx] != framebuffer, framebuffer))
     {
         framebufferState_.boundFramebuffers[targetIdx] = framebuffer;
         glBindFramebuffer(g_framebufferTargetsEnum[targetIdx], framebuffer);
@@ -1016,7 +1040,7 @@ GLRenderTarget* GLStateManager::GetBoundRenderTarget() const
 
 void GLStateManager::BindRenderbuffer(GLuint renderbuffer)
 {
-    if (renderbufferState_.boundRenderbuffer != renderbuffer)
+    if (CountStateChange(GLStateCategory::Framebuffer, renderbufferState_.boundRenderbuffer != renderbuffer, renderbuffer))
     {
         renderbufferState_.boundRenderbuffer = renderbuffer;
         glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
@@ -1072,7 +1096,7 @@ void GLStateManager::ActiveTexture(std::uint32_t layer)
     LLGL_ASSERT_UPPER_BOUND(layer, numTextureLayers);
     #endif
 
-    if (textureState_.activeTexture != layer)
+    if (CountStateChange(GLStateCategory::Texture, textureState_.activeTexture != layer, layer))
     {
         /* Active specified texture layer and store reference to bound textures array */
         SetActiveTextureLayer(layer);
@@ -1084,7 +1108,7 @@ void GLStateManager::BindTexture(GLTextureTarget target, GLuint texture)
 {
     /* Only bind texutre if the texture has changed */
     auto targetIdx = static_cast<std::size_t>(target);
-    if (textureState_.activeLayerRef->boundTextures[targetIdx] != texture)
+    if (CountStateChange(GLStateCategory::Texture, textureState_.activeLayerRef->boundTextures[targetIdx] != texture, texture))
     {
         textureState_.activeLayerRef->boundTextures[targetIdx] = texture;
         glBindTexture(g_textureTargetsEnum[targetIdx], texture);
@@ -1108,6 +1132,7 @@ void GLStateManager::BindTextures(GLuint first, GLsizei count, const GLTextureTa
         The spec. of GL_ARB_multi_bind states that the active texture slot is not modified by this function.
         see https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_multi_bind.txt
         */
+        CountStateChange(GLStateCategory::Texture, true, static_cast<std::uint32_t>(count));
         glBindTextures(first, count, textures);
     }
     else
@@ -1139,6 +1164,7 @@ void GLStateManager::UnbindTextures(GLuint first, GLsizei count)
         The spec. of GL_ARB_multi_bind states that the active texture slot is not modified by this function.
         see https://www.khronos.org/registry/OpenGL/extensions/ARB/ARB_multi_bind.txt
         */
+        CountStateChange(GLStateCategory::Texture, true, static_cast<std::uint32_t>(count));
         glBindTextures(first, count, nullptr);
     }
     else
@@ -1163,6 +1189,7 @@ void GLStateManager::BindImageTexture(GLuint unit, GLint level, GLenum format, G
         LLGL_ASSERT_UPPER_BOUND(unit, limits_.maxImageUnits);
         #endif
 
+        CountStateChange(GLStateCategory::Texture, true, texture);
         if (texture != 0)
             glBindImageTexture(unit, texture, level, GL_TRUE, 0, GL_READ_WRITE, format);
         else
@@ -1182,6 +1209,7 @@ void GLStateManager::BindImageTextures(GLuint first, GLsizei count, const GLenum
     if (HasExtension(GLExt::ARB_multi_bind))
     {
         /* Bind all image units at once */
+        CountStateChange(GLStateCategory::Texture, true, static_cast<std::uint32_t>(count));
         glBindImageTextures(first, count, textures);
     }
     else
@@ -1199,6 +1227,7 @@ void GLStateManager::UnbindImageTextures(GLuint first, GLsizei count)
     if (HasExtension(GLExt::ARB_multi_bind))
     {
         /* Bind all image units at once */
+        CountStateChange(GLStateCategory::Texture, true, static_cast<std::uint32_t>(count));
         glBindImageTextures(first, count, nullptr);
     }
     else
@@ -1262,7 +1291,7 @@ void GLStateManager::BindSampler(GLuint layer, GLuint sampler)
     LLGL_ASSERT_UPPER_BOUND(layer, numTextureLayers);
     #endif
 
-    if (samplerState_.boundSamplers[layer] != sampler)
+    if (CountStateChange(GLStateCategory::Sampler, samplerState_.boundSamplers[layer] != sampler, sampler))
     {
         samplerState_.boundSamplers[layer] = sampler;
         glBindSampler(layer, sampler);
@@ -1279,6 +1308,7 @@ void GLStateManager::BindSamplers(GLuint first, GLsizei count, const GLuint* sam
             samplerState_.boundSamplers[i + first] = samplers[i];
 
         /* Bind all samplers at once */
+        CountStateChange(GLStateCategory::Sampler, true, static_cast<std::uint32_t>(count));
         glBindSamplers(first, count, samplers);
     }
     else
@@ -1305,7 +1335,7 @@ void GLStateManager::NotifySamplerRelease(GLuint sampler)
 
 void GLStateManager::BindShaderProgram(GLuint program)
 {
-    if (shaderState_.boundProgram != program)
+    if (CountStateChange(GLStateCategory::ShaderProgram, shaderState_.boundProgram != program, program))
     {
         shaderState_.boundProgram = program;
         glUseProgram(program);
@@ -1322,6 +1352,25 @@ GLuint GLStateManager::GetBoundShaderProgram() const
     return shaderState_.boundProgram;
 }
 
+/* ----- Feedback ----- */
+
+void GLStateManager::ResetCounters()
+{
+    counters_ = GLStateCounters{};
+}
+
+void GLStateManager::SetCountersEnabled(bool enabled)
+{
+    countersEnabled_ = enabled;
+    countingEnabled_ = (countersEnabled_ || trace_ != nullptr);
+}
+
+void GLStateManager::SetTrace(GLStateTrace* trace)
+{
+    trace_ = trace;
+    countingEnabled_ = (countersEnabled_ || trace_ != nullptr);
+}
+
 /* ----- Render pass ----- */
 
 void GLStateManager::BindRenderPass(
@@ -1436,6 +1485,18 @@ void GLStateManager::ClearBuffers(std::uint32_t numAttachments, const Attachment
  * ======= Private: =======
  */
 
+void GLStateManager::RecordStateChange(GLStateCategory category, bool issued, std::uint32_t value)
+{
+    auto idx = static_cast<std::size_t>(category);
+    if (issued)
+        ++counters_.issued[idx];
+    else
+        ++counters_.elided[idx];
+
+    if (trace_ != nullptr)
+        trace_->Record(category, issued, value);
+}
+
 void GLStateManager::AssertExtViewportArray()
 {
     #ifdef GL_ARB_viewport_array
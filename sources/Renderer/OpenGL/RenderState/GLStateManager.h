@@ -32,6 +32,7 @@ class GLDepthStencilState;
 class GLRasterizerState;
 class GLBlendState;
 class GLRenderPass;
+class GLStateTrace;
 
 // OpenGL state machine manager that keeps track of certain GL states.
 class GLStateManager
@@ -273,12 +274,44 @@ class GLStateManager
             return commonLimits_;
         }
 
+        // Returns the number of issued and elided GL calls per state category since the last call to ResetCounters.
+        inline const GLStateCounters& GetCounters() const
+        {
+            return counters_;
+        }
+
+        // Resets all counters of issued and elided GL calls.
+        void ResetCounters();
+
+        // Enables or disables the counters of issued and elided GL calls. Counting is also enabled while a trace is set. By default disabled.
+        void SetCountersEnabled(bool enabled);
+
+        // Sets the trace all state changes are recorded to, or null to disable tracing. The trace is not owned by the state manager.
+        void SetTrace(GLStateTrace* trace);
+
+        // Returns the trace all state changes are recorded to, or null if tracing is disabled.
+        inline GLStateTrace* GetTrace() const
+        {
+            return trace_;
+        }
+
     private:
 
         struct GLIntermediateBufferWriteMasks;
 
     private:
 
+        // Counts an issued or elided GL call for the specified state category if counting is enabled, and returns the 'issued' parameter.
+        inline bool CountStateChange(GLStateCategory category, bool issued, std::uint32_t value = 0)
+        {
+            if (countingEnabled_)
+                RecordStateChange(category, issued, value);
+            return issued;
+        }
+
+        // Increments the counter of the specified state category and appends the state change to the trace.
+        void RecordStateChange(GLStateCategory category, bool issued, std::uint32_t value);
+
         void AdjustViewport(GLViewport& viewport);
         void AdjustScissor(GLScissor& scissor);
 
@@ -499,6 +532,11 @@ class GLStateManager
         GLRasterizerState*              boundRasterizerState_   = nullptr;
         GLBlendState*                   boundBlendState_        = nullptr;
 
+        GLStateCounters                 counters_;
+        GLStateTrace*                   trace_                  = nullptr;
+        bool                            countersEnabled_        = false;
+        bool                            countingEnabled_        = false;    // Cached (countersEnabled_ || trace_ != nullptr)
+
 };
 
 
@@ -7,8 +7,8 @@
 
 #include "GLStatePool.h"
 #include "GLStateManager.h"
-#include "../../../Core/ContainerUtils.h"
 #include <functional>
+#include <utility>
 
 
 namespace LLGL
@@ -19,62 +19,51 @@ namespace LLGL
  * Internal templates
  */
 
-// Searches a compatible state object with complexity O(log n)
-template <typename T>
-std::shared_ptr<T> FindCompatibleStateObject(
-    std::vector<std::shared_ptr<T>>&    container,
-    const T&                            compareObject,
-    std::size_t&                        index)
-{
-    auto* entry = Utils::FindInSortedArray<std::shared_ptr<T>>(
-        container.data(),
-        container.size(),
-        [&compareObject](const std::shared_ptr<T>& rhs) -> int
-        {
-            return T::CompareSWO(compareObject, *rhs.get());
-        },
-        &index
-    );
-    return (entry != nullptr ? *entry : nullptr);
-}
-
 template <typename T, typename... Args>
-std::shared_ptr<T> CreateRenderStateObject(std::vector<std::shared_ptr<T>>& container, Args&&... args)
+std::shared_ptr<T> CreateRenderStateObject(GLStatePool::HashedContainer<T>& container, Args&&... args)
 {
-    /* Try to find render state object with same parameter */
+    /* Try to find render state object with same parameter among the entries with equal hash value */
     T stateToCompare{ std::forward<Args>(args)... };
 
-    std::size_t insertionIndex = 0;
-    if (auto sharedState = FindCompatibleStateObject(container, stateToCompare, insertionIndex))
-        return sharedState;
+    auto range = container.equal_range(stateToCompare.GetHash());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (T::CompareSWO(stateToCompare, *(it->second)) == 0)
+            return it->second;
+    }
 
-    /* Allocate new render state object with insertion sort */
-    auto newState = std::make_shared<T>(stateToCompare);
-    container.insert(container.begin() + insertionIndex, newState);
+    /* Allocate new render state object */
+    auto newState = std::make_shared<T>(std::move(stateToCompare));
+    container.insert({ newState->GetHash(), newState });
 
     return newState;
 }
 
 template <typename T>
 void ReleaseRenderStateObject(
-    std::vector<std::shared_ptr<T>>&    container,
+    GLStatePool::HashedContainer<T>&    container,
     const std::function<void(T*)>&      callback,
     std::shared_ptr<T>&&                renderState)
 {
+    /* Only remove entry if it's no longer referenced by anything but the pool itself */
     if (renderState && renderState.use_count() == 2)
     {
         /* Reset render state */
         auto objectRef = renderState.get();
         renderState.reset();
 
-        /* Retrieve entry index in container to remove entry */
-        std::size_t entryIndex = 0;
-        if (FindCompatibleStateObject(container, *objectRef, entryIndex) != nullptr)
+        /* Find entry by identity among the entries with equal hash value */
+        auto range = container.equal_range(objectRef->GetHash());
+        for (auto it = range.first; it != range.second; ++it)
         {
-            /* Notify via callback and erase from container */
-            if (callback)
-                callback(objectRef);
-            container.erase(container.begin() + entryIndex);
+            if (it->second.get() == objectRef)
+            {
+                /* Notify via callback and erase from container */
+                if (callback)
+                    callback(objectRef);
+                container.erase(it);
+                break;
+            }
         }
     }
 }
@@ -98,6 +87,18 @@ void GLStatePool::Clear()
     shaderBindingLayouts_.clear();
 }
 
+GLStatePoolStats GLStatePool::GetStats() const
+{
+    GLStatePoolStats stats;
+    {
+        stats.numDepthStencilStates     = depthStencilStates_.size();
+        stats.numRasterizerStates       = rasterizerStates_.size();
+        stats.numBlendStates            = blendStates_.size();
+        stats.numShaderBindingLayouts   = shaderBindingLayouts_.size();
+    }
+    return stats;
+}
+
 GLDepthStencilStateSPtr GLStatePool::CreateDepthStencilState(const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc)
 {
     return CreateRenderStateObject(depthStencilStates_, depthDesc, stencilDesc);
@@ -15,16 +15,29 @@
 #include "GLBlendState.h"
 #include "GLPipelineLayout.h"
 #include "../Shader/GLShaderBindingLayout.h"
-#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstddef>
 
 
 namespace LLGL
 {
 
 
+// Number of state objects that are currently shared in a GL state pool.
+struct GLStatePoolStats
+{
+    std::size_t numDepthStencilStates   = 0;
+    std::size_t numRasterizerStates     = 0;
+    std::size_t numBlendStates          = 0;
+    std::size_t numShaderBindingLayouts = 0;
+};
+
 /*
 Singleton pool for OpenGL depth-stencil-, rasterizer-, and blend states.
 These states are separated from the GLStateManager, because they don't need to exist for every GL context.
+All state objects are indexed by the hash value they compute at construction, so looking up a shared state object is O(1) on average.
+A state object is removed from the pool when the last pipeline state that refers to it is released.
 */
 class GLStatePool
 {
@@ -40,6 +53,9 @@ class GLStatePool
         // Clear all resource containers of this pool (used by GLRenderSystem).
         void Clear();
 
+        // Returns the number of state objects in each container of this pool.
+        GLStatePoolStats GetStats() const;
+
         /* ----- Depth-stencil states ----- */
 
         GLDepthStencilStateSPtr CreateDepthStencilState(const DepthDescriptor& depthDesc, const StencilDescriptor& stencilDesc);
@@ -60,16 +76,22 @@ class GLStatePool
         GLShaderBindingLayoutSPtr CreateShaderBindingLayout(const GLPipelineLayout& pipelineLayout);
         void ReleaseShaderBindingLayout(GLShaderBindingLayoutSPtr&& shaderBindingLayout);
 
+    public:
+
+        // Container of shared state objects indexed by their hash values.
+        template <typename T>
+        using HashedContainer = std::unordered_multimap<std::size_t, std::shared_ptr<T>>;
+
     private:
 
         GLStatePool() = default;
 
     private:
 
-        std::vector<GLDepthStencilStateSPtr>    depthStencilStates_;
-        std::vector<GLRasterizerStateSPtr>      rasterizerStates_;
-        std::vector<GLBlendStateSPtr>           blendStates_;
-        std::vector<GLShaderBindingLayoutSPtr>  shaderBindingLayouts_;
+        HashedContainer<GLDepthStencilState>    depthStencilStates_;
+        HashedContainer<GLRasterizerState>      rasterizerStates_;
+        HashedContainer<GLBlendState>           blendStates_;
+        HashedContainer<GLShaderBindingLayout>  shaderBindingLayouts_;
 
 };
 
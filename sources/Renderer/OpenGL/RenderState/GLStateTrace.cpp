@@ -0,0 +1,62 @@
+/*
+ * GLStateTrace.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStateTrace.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+GLStateTrace::GLStateTrace(const std::string& filename) :
+    file_ { filename, std::ios::out | std::ios::binary | std::ios::trunc }
+{
+    if (!file_.good())
+        throw std::runtime_error("failed to open file for GL state trace: \"" + filename + "\"");
+
+    /* Write file header */
+    const std::uint32_t version     = g_version;
+    const std::uint32_t recordSize  = static_cast<std::uint32_t>(sizeof(GLStateTraceRecord));
+    file_.write("LLGLSTRC", 8);
+    file_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file_.write(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+
+    records_.reserve(g_maxBufferedRecords);
+}
+
+GLStateTrace::~GLStateTrace()
+{
+    Flush();
+}
+
+void GLStateTrace::MarkSubmit(std::uint32_t submitIndex)
+{
+    records_.push_back({ g_submitMarker, 0, 0, submitIndex });
+    if (records_.size() >= g_maxBufferedRecords)
+        Flush();
+}
+
+void GLStateTrace::Flush()
+{
+    if (!records_.empty())
+    {
+        file_.write(
+            reinterpret_cast<const char*>(records_.data()),
+            static_cast<std::streamsize>(records_.size() * sizeof(GLStateTraceRecord))
+        );
+        file_.flush();
+        records_.clear();
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
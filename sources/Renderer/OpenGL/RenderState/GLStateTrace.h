@@ -0,0 +1,90 @@
+/*
+ * GLStateTrace.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STATE_TRACE_H
+#define LLGL_GL_STATE_TRACE_H
+
+
+#include "GLState.h"
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Single record of a GL state trace (8 bytes).
+struct GLStateTraceRecord
+{
+    std::uint8_t    category;   // Value of GLStateCategory, or GLStateTrace::g_submitMarker for a command queue submission.
+    std::uint8_t    issued;     // 1 if the GL call was issued, 0 if it was elided.
+    std::uint16_t   reserved;
+    std::uint32_t   value;      // Category specific value, e.g. the bound object ID.
+};
+
+/*
+Compact binary trace of the GL state changes that pass through the GLStateManager.
+The file starts with the 8 byte magic "LLGLSTRC", followed by the 32-bit version and the 32-bit record size,
+then a flat array of GLStateTraceRecord entries in native byte order.
+Records are buffered in memory and written in blocks to keep the overhead low.
+*/
+class GLStateTrace
+{
+
+    public:
+
+        // Category value of the records that mark a command queue submission.
+        static const std::uint8_t   g_submitMarker  = 0xFF;
+
+        // Version number of the trace file format.
+        static const std::uint32_t  g_version       = 1;
+
+    public:
+
+        GLStateTrace(const std::string& filename);
+        ~GLStateTrace();
+
+        GLStateTrace(const GLStateTrace&) = delete;
+        GLStateTrace& operator = (const GLStateTrace&) = delete;
+
+        // Appends a record for the specified state change.
+        inline void Record(GLStateCategory category, bool issued, std::uint32_t value)
+        {
+            records_.push_back({ static_cast<std::uint8_t>(category), static_cast<std::uint8_t>(issued ? 1 : 0), 0, value });
+            if (records_.size() >= g_maxBufferedRecords)
+                Flush();
+        }
+
+        // Appends a marker record for a command queue submission.
+        void MarkSubmit(std::uint32_t submitIndex);
+
+        // Writes all buffered records to the file.
+        void Flush();
+
+    private:
+
+        static const std::size_t g_maxBufferedRecords = 65536;
+
+    private:
+
+        std::ofstream                   file_;
+        std::vector<GLStateTraceRecord> records_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
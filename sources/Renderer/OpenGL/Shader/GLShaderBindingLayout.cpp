@@ -9,6 +9,7 @@
 #include "../Ext/GLExtensionRegistry.h"
 #include "../Ext/GLExtensions.h"
 #include "../../../Core/HelperMacros.h"
+#include "../../../Core/Helper.h"
 
 
 namespace LLGL
@@ -55,6 +56,16 @@ GLShaderBindingLayout::GLShaderBindingLayout(const GLPipelineLayout& pipelineLay
             }
         }
     }
+
+    /* Compute hash of all bindings */
+    HashCombine(hash_, numUniformBindings_);
+    HashCombine(hash_, numUniformBlockBindings_);
+    HashCombine(hash_, numShaderStorageBindings_);
+    for (const auto& binding : bindings_)
+    {
+        HashCombine(hash_, binding.slot);
+        HashCombine(hash_, binding.name);
+    }
 }
 
 void GLShaderBindingLayout::BindResourceSlots(GLuint program) const
@@ -100,6 +111,8 @@ int GLShaderBindingLayout::CompareSWO(const GLShaderBindingLayout& lhs, const GL
 {
     /* Compare number of bindings first; if equal we can use one of the arrays only */
     LLGL_COMPARE_MEMBER_SWO( bindings_.size() );
+    LLGL_COMPARE_MEMBER_SWO( numUniformBindings_ );
+    LLGL_COMPARE_MEMBER_SWO( numUniformBlockBindings_ );
 
     for (std::size_t i = 0, n = lhs.bindings_.size(); i < n; ++i)
     {
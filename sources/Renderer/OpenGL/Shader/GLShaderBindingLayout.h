@@ -48,6 +48,12 @@ class GLShaderBindingLayout
         // Returns a signed integer of the strict-weak-order (SWO) comparison, and 0 on equality.
         static int CompareSWO(const GLShaderBindingLayout& lhs, const GLShaderBindingLayout& rhs);
 
+        // Returns the hash value of this layout that was computed at construction. Layouts that are equal in terms of CompareSWO have equal hash values.
+        inline std::size_t GetHash() const
+        {
+            return hash_;
+        }
+
     private:
 
         struct ResourceBinding
@@ -62,6 +68,7 @@ class GLShaderBindingLayout
         std::uint8_t                    numUniformBlockBindings_    = 0;
         std::uint8_t                    numShaderStorageBindings_   = 0;
         std::vector<ResourceBinding>    bindings_;
+        std::size_t                     hash_                       = 0;
 
 };
 
@@ -13,147 +13,14 @@
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
 #include "../../CheckedCast.h"
-#include "../../../Core/ContainerUtils.h"
 #include "../../../Core/Helper.h"
 #include "../../../Core/HelperMacros.h"
-#include <algorithm>
 
 
 namespace LLGL
 {
 
 
-static const std::size_t g_maxNumReusableTextureViews = 16;
-
-GLTextureViewPool::~GLTextureViewPool()
-{
-    Clear();
-}
-
-GLTextureViewPool& GLTextureViewPool::Get()
-{
-    static GLTextureViewPool instance;
-    return instance;
-}
-
-void GLTextureViewPool::Clear()
-{
-    /* Delete all texture view GL objects and clear container */
-    for (const auto& texView : textureViews_)
-    {
-        if (texView.texID != 0)
-            glDeleteTextures(1, &(texView.texID));
-    }
-    textureViews_.clear();
-    numReusableEntries_ = 0;
-}
-
-GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
-{
-    #ifdef GL_ARB_texture_view
-
-    if (!HasExtension(GLExt::ARB_texture_view))
-        return 0;
-
-    /* Compress texture view descriptor for faster comparison and sorting */
-    GLTextureView texView;
-    {
-        texView.sourceTexID = sourceTexID;
-    }
-    CompressTextureViewDesc(texView.view, textureViewDesc);
-
-    /* Try to find texture view with same parameters */
-    std::size_t insertionIndex = 0;
-    auto* sharedTexView = Utils::FindInSortedArray<GLTextureView>(
-        textureViews_.data(),
-        textureViews_.size(),
-        [&texView](const GLTextureView& rhs)
-        {
-            return GLTextureViewPool::CompareTextureViewSWO(texView, rhs);
-        },
-        &insertionIndex
-    );
-
-    if (sharedTexView != nullptr)
-    {
-        /* Create a shared GL texture view from the descriptor */
-        return CreateGLTextureView(*sharedTexView, textureViewDesc, true, restoreBoundTexture);
-    }
-    else
-    {
-        /* Create new GL texture view and store it with insertion sort */
-        GLuint texID = CreateGLTextureView(texView, textureViewDesc, false, restoreBoundTexture);
-        textureViews_.insert(textureViews_.begin() + insertionIndex, texView);
-        return texID;
-    }
-
-    #else
-
-    return 0;
-
-    #endif
-}
-
-void GLTextureViewPool::ReleaseTextureView(GLuint texID)
-{
-    /* Try to find texture by GL texture ID only */
-    std::size_t insertionIndex = 0;
-    auto* sharedTexView = Utils::FindInSortedArray<GLTextureView>(
-        textureViews_.data(),
-        textureViews_.size(),
-        [texID](const GLTextureView& rhs)
-        {
-            LLGL_COMPARE_SEPARATE_MEMBERS_SWO(texID, rhs.texID);
-            return 0;
-        },
-        &insertionIndex
-    );
-
-    if (sharedTexView != nullptr)
-    {
-        /* Delete GL texture view if the reference counter reaches 0 */
-        ReleaseSharedGLTextureView(*sharedTexView);
-
-        /* Remove unused entries in the array after a given amount has been freed */
-        if (numReusableEntries_ > g_maxNumReusableTextureViews)
-            FlushReusableTextureViews();
-    }
-}
-
-void GLTextureViewPool::NotifyTextureRelease(GLuint sourceTexID)
-{
-    /* Move all objects that are about to be removed at the end of the list using 'std::remove' */
-    auto it = std::remove_if(
-        textureViews_.begin(),
-        textureViews_.end(),
-        [sourceTexID](const GLTextureView& entry)
-        {
-            return (entry.texID == 0 || entry.sourceTexID == sourceTexID);
-        }
-    );
-
-    /* Iterate over all elements to be deleted */
-    for (; it != textureViews_.end(); ++it)
-        DeleteGLTextureView(*it);
-
-    /* Finally remove the entries from the list */
-    textureViews_.erase(it, textureViews_.end());
-
-    /* Reset reusable entries, since we just deleted all unused entries */
-    numReusableEntries_ = 0;
-}
-
-
-/*
- * ======= Private: =======
- */
-
-int GLTextureViewPool::CompareTextureViewSWO(const GLTextureView& lhs, const GLTextureView& rhs)
-{
-    LLGL_COMPARE_MEMBER_SWO( sourceTexID );
-    return CompareCompressedTexViewSWO(lhs.view, rhs.view);
-}
-
 #ifdef GL_ARB_texture_view
 
 static void InitializeTextureViewSwizzle(GLuint texID, const GLTextureTarget target, const TextureViewDescriptor& textureViewDesc)
@@ -208,80 +75,177 @@ static GLuint GenGLTextureView(GLuint sourceTexID, const TextureViewDescriptor&
     return texID;
 }
 
-GLuint GLTextureViewPool::CreateGLTextureView(GLTextureView& texView, const TextureViewDescriptor& textureViewDesc, bool isSharedTex, bool restoreBoundTexture)
+// Uncompresses the specified 4-bit texture type to a 'GLTextureTarget' enum entry.
+static GLTextureTarget UncompressGLTextureTarget(std::uint32_t type)
 {
-    if (isSharedTex)
-    {
-        if (texView.texID == 0)
-        {
-            /* Create new GL texture view if ID is invalid */
-            GLuint texID = GenGLTextureView(texView.sourceTexID, textureViewDesc, restoreBoundTexture);
-            RetainSharedGLTextureView(texView, texID);
-        }
-    }
-    else
-    {
-        /* Create a new GL texture view and initialize reference counter */
-        texView.texID = GenGLTextureView(texView.sourceTexID, textureViewDesc, restoreBoundTexture);
-    }
-
-    /* Increment reference counter for the shared texture view */
-    texView.refCount++;
+    return GLStateManager::GetTextureTarget(static_cast<TextureType>(type));
+}
 
-    return texView.texID;
+GLTextureViewPool::~GLTextureViewPool()
+{
+    Clear();
 }
 
-// Uncompresses the specified 4-bit texture type to a 'GLTextureTarget' enum entry.
-static GLTextureTarget UncompressGLTextureTarget(std::uint32_t type)
+GLTextureViewPool& GLTextureViewPool::Get()
 {
-    return GLStateManager::GetTextureTarget(static_cast<TextureType>(type));
+    static GLTextureViewPool instance;
+    return instance;
 }
 
-void GLTextureViewPool::DeleteGLTextureView(GLTextureView& texView)
+void GLTextureViewPool::Clear()
 {
-    GLStateManager::Get().DeleteTexture(texView.texID, UncompressGLTextureTarget(texView.view.type));
+    /* Delete all texture view GL objects and clear container */
+    for (const auto& entry : textureViews_)
+    {
+        if (entry.second.texID != 0)
+            glDeleteTextures(1, &(entry.second.texID));
+    }
+    textureViews_.clear();
+    sourceTextures_.clear();
+    textureViewIDs_.clear();
 }
 
-void GLTextureViewPool::RetainSharedGLTextureView(GLTextureView& texView, GLuint texID)
+GLuint GLTextureViewPool::CreateTextureView(GLuint sourceTexID, const TextureViewDescriptor& textureViewDesc, bool restoreBoundTexture)
 {
-    if (texView.texID == 0)
+    #ifdef GL_ARB_texture_view
+
+    if (!HasExtension(GLExt::ARB_texture_view))
+        return 0;
+
+    /* Compress texture view descriptor for faster hashing and comparison */
+    GLTextureViewKey key;
     {
-        /* If this is shared texture view, reclaim one of the reusable entries */
-        texView.texID = texID;
-        if (numReusableEntries_ > 0)
-            --numReusableEntries_;
+        key.sourceTexID = sourceTexID;
     }
+    CompressTextureViewDesc(key.view, textureViewDesc);
+
+    /* Try to find texture view with same parameters */
+    auto it = textureViews_.find(key);
+    if (it != textureViews_.end())
+    {
+        /* Increment reference counter for the shared texture view */
+        it->second.refCount++;
+        return it->second.texID;
+    }
+
+    /* Create new GL texture view */
+    GLuint texID = GenGLTextureView(sourceTexID, textureViewDesc, restoreBoundTexture);
+    if (texID != 0)
+    {
+        /* Store new texture view and link it into the list of its source texture */
+        auto& texView = textureViews_[key];
+        {
+            texView.texID       = texID;
+            texView.refCount    = 1;
+            texView.key         = key;
+        }
+        LinkTextureView(texView);
+        textureViewIDs_[texID] = &texView;
+    }
+
+    return texID;
+
+    #else
+
+    return 0;
+
+    #endif
 }
 
-void GLTextureViewPool::ReleaseSharedGLTextureView(GLTextureView& texView)
+void GLTextureViewPool::ReleaseTextureView(GLuint texID)
 {
-    if (texView.refCount > 0)
+    /* Find texture view by its GL texture ID */
+    auto it = textureViewIDs_.find(texID);
+    if (it != textureViewIDs_.end())
     {
-        texView.refCount--;
+        auto& texView = *(it->second);
+        if (texView.refCount > 0)
+            texView.refCount--;
+
+        /* Delete GL texture view and remove entry if the reference counter reaches 0 */
         if (texView.refCount == 0)
         {
+            const auto key = texView.key;
+            textureViewIDs_.erase(it);
+            UnlinkTextureView(texView);
             DeleteGLTextureView(texView);
-            ++numReusableEntries_;
+            textureViews_.erase(key);
         }
     }
 }
 
-void GLTextureViewPool::FlushReusableTextureViews()
+void GLTextureViewPool::NotifyTextureRelease(GLuint sourceTexID)
 {
-    if (numReusableEntries_ > 0)
+    /* Find list of texture views that were derived from the specified texture */
+    auto it = sourceTextures_.find(sourceTexID);
+    if (it != sourceTextures_.end())
     {
-        RemoveAllFromListIf(
-            textureViews_,
-            [](const GLTextureView& entry)
-            {
-                return (entry.texID == 0);
-            }
-        );
-        numReusableEntries_ = 0;
+        /* Delete all texture views in this list */
+        for (auto texView = it->second; texView != nullptr;)
+        {
+            auto nextTexView    = texView->nextInSource;
+            const auto key      = texView->key;
+            textureViewIDs_.erase(texView->texID);
+            DeleteGLTextureView(*texView);
+            textureViews_.erase(key);
+            texView = nextTexView;
+        }
+        sourceTextures_.erase(it);
     }
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+std::size_t GLTextureViewPool::GLTextureViewKeyHash::operator () (const GLTextureViewKey& key) const
+{
+    std::size_t seed = 0;
+    HashCombine(seed, key.sourceTexID);
+    HashCombine(seed, key.view.base);
+    HashCombine(seed, key.view.firstMip);
+    HashCombine(seed, key.view.numLayers);
+    HashCombine(seed, key.view.firstLayer);
+    return seed;
+}
+
+bool GLTextureViewPool::GLTextureViewKeyEqual::operator () (const GLTextureViewKey& lhs, const GLTextureViewKey& rhs) const
+{
+    return (lhs.sourceTexID == rhs.sourceTexID && CompareCompressedTexViewSWO(lhs.view, rhs.view) == 0);
+}
+
+void GLTextureViewPool::DeleteGLTextureView(GLTextureView& texView)
+{
+    GLStateManager::Get().DeleteTexture(texView.texID, UncompressGLTextureTarget(texView.key.view.type));
+}
+
+void GLTextureViewPool::LinkTextureView(GLTextureView& texView)
+{
+    auto& head = sourceTextures_[texView.key.sourceTexID];
+    texView.prevInSource = nullptr;
+    texView.nextInSource = head;
+    if (head != nullptr)
+        head->prevInSource = &texView;
+    head = &texView;
+}
+
+void GLTextureViewPool::UnlinkTextureView(GLTextureView& texView)
+{
+    if (texView.nextInSource != nullptr)
+        texView.nextInSource->prevInSource = texView.prevInSource;
+
+    if (texView.prevInSource != nullptr)
+        texView.prevInSource->nextInSource = texView.nextInSource;
+    else if (texView.nextInSource != nullptr)
+        sourceTextures_[texView.key.sourceTexID] = texView.nextInSource;
+    else
+        sourceTextures_.erase(texView.key.sourceTexID);
+
+    texView.prevInSource = nullptr;
+    texView.nextInSource = nullptr;
+}
+
 } // /namespace LLGL
 
 
@@ -11,7 +11,8 @@
 
 #include <LLGL/TextureFlags.h>
 #include <cstdint>
-#include <vector>
+#include <cstddef>
+#include <unordered_map>
 #include "../OpenGL.h"
 #include "../../TextureUtils.h"
 
@@ -20,7 +21,12 @@ namespace LLGL
 {
 
 
-// Class to manage create/reuse/delete of GL texture views; used by <GLResourceHeap>
+/*
+Class to manage create/reuse/delete of GL texture views; used by <GLResourceHeap>.
+All texture views are indexed by their source texture and compressed view descriptor in a hash map,
+and the texture views of each source texture are linked in an intrusive list,
+so that releasing a source texture only visits the texture views that were derived from it.
+*/
 class GLTextureViewPool
 {
 
@@ -63,40 +69,56 @@ class GLTextureViewPool
 
     private:
 
-        // Structure that stores a GL texture that was generated with 'glTextureView'; managed by <GLTextureViewPool>
-        struct GLTextureView
+        // Key of a texture view: the source texture and the compressed texture view descriptor.
+        struct GLTextureViewKey
         {
-            GLuint              texID        = 0;
-            GLuint              sourceTexID  = 0;
-            GLuint              refCount     = 0;
+            GLuint              sourceTexID = 0;
             CompressedTexView   view;
         };
 
-        // Compares the two texture views in a strict-weak-order (SWO).
-        static int CompareTextureViewSWO(const GLTextureView& lhs, const GLTextureView& rhs);
+        // Hash function for texture view keys.
+        struct GLTextureViewKeyHash
+        {
+            std::size_t operator () (const GLTextureViewKey& key) const;
+        };
 
-        // Creats a new GL texture view and stores it in the specified view entry.
-        GLuint CreateGLTextureView(GLTextureView& texView, const TextureViewDescriptor& textureViewDesc, bool isSharedTex, bool restoreBoundTexture);
+        // Equality function for texture view keys.
+        struct GLTextureViewKeyEqual
+        {
+            bool operator () (const GLTextureViewKey& lhs, const GLTextureViewKey& rhs) const;
+        };
 
-        // Deletes the specified GL texture view.
-        void DeleteGLTextureView(GLTextureView& texView);
+        // Structure that stores a GL texture that was generated with 'glTextureView'; managed by <GLTextureViewPool>
+        struct GLTextureView
+        {
+            GLuint              texID           = 0;
+            GLuint              refCount        = 0;
+            GLTextureViewKey    key;
+            GLTextureView*      prevInSource    = nullptr;
+            GLTextureView*      nextInSource    = nullptr;
+        };
 
-        // Assignes the specified texture view a new GL texture ID and reclaims it as a reusable entry.
-        void RetainSharedGLTextureView(GLTextureView& texView, GLuint texID);
+    private:
 
-        // Release the specified GL texture object and marks the entry as reusable.
-        void ReleaseSharedGLTextureView(GLTextureView& texView);
+        // Inserts the specified texture view at the front of the list of its source texture.
+        void LinkTextureView(GLTextureView& texView);
 
-        // Removes all empty entries from the texture view list.
-        void FlushReusableTextureViews();
+        // Removes the specified texture view from the list of its source texture.
+        void UnlinkTextureView(GLTextureView& texView);
+
+        // Deletes the specified GL texture view.
+        void DeleteGLTextureView(GLTextureView& texView);
 
     private:
 
-        // Container of all managed texture views.
-        std::vector<GLTextureView>  textureViews_;
+        // Container of all managed texture views. Pointers to the entries remain valid until they are erased.
+        std::unordered_map<GLTextureViewKey, GLTextureView, GLTextureViewKeyHash, GLTextureViewKeyEqual> textureViews_;
+
+        // First texture view of each source texture; maps source texture IDs to the head of their intrusive lists.
+        std::unordered_map<GLuint, GLTextureView*>  sourceTextures_;
 
-        // Number of textures that are already freed, but not removed from the texture view array yet.
-        std::size_t                 numReusableEntries_ = 0;
+        // Maps GL texture view IDs to their entries.
+        std::unordered_map<GLuint, GLTextureView*>  textureViewIDs_;
 
 };
 
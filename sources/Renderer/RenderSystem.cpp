@@ -7,6 +7,7 @@
 
 #include "../Platform/Module.h"
 #include "../Core/Helper.h"
+#include "../Core/WorkerPool.h"
 #include <LLGL/Platform/Platform.h>
 #include <LLGL/Format.h>
 #include <LLGL/ImageFlags.h>
@@ -233,6 +234,10 @@ void RenderSystem::Unload(std::unique_ptr<RenderSystem>&& renderSystem)
         renderSystem.release();
         g_renderSystemModules.erase(it);
     }
+
+    /* Stop the worker threads with the last render system, so they are not joined during static destruction */
+    if (g_renderSystemModules.empty())
+        WorkerPool::Get().Shutdown();
 }
 
 void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
@@ -240,6 +245,47 @@ void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
     config_ = config;
 }
 
+bool RenderSystem::QueryMemoryStatistics(MemoryStatistics& /*stats*/)
+{
+    return false;
+}
+
+Texture* RenderSystem::CreateTextureWithMips(const TextureDescriptor& textureDesc, std::uint32_t numMipImages, const SrcImageDescriptor* mipImages)
+{
+    /* Validate MIP-map images */
+    if (IsMultiSampleTexture(textureDesc.type))
+        throw std::invalid_argument("cannot create multi-sampled texture with MIP-map images");
+    if (numMipImages == 0 || mipImages == nullptr)
+        throw std::invalid_argument("cannot create texture with MIP-map images without any image");
+    if (numMipImages > NumMipLevels(textureDesc))
+    {
+        throw std::invalid_argument(
+            "cannot create texture with " + std::to_string(numMipImages) +
+            " MIP-map images while it has only " + std::to_string(NumMipLevels(textureDesc)) + " MIP-map level(s)"
+        );
+    }
+
+    /* Allocate storage of all MIP-map levels with the first image instead of generating the MIP-maps */
+    auto textureDescNoMips = textureDesc;
+    textureDescNoMips.miscFlags &= ~MiscFlags::GenerateMips;
+
+    auto texture = CreateTexture(textureDescNoMips, &mipImages[0]);
+
+    /* Upload remaining images into their MIP-map levels (including all array layers) */
+    for (std::uint32_t mipLevel = 1; mipLevel < numMipImages; ++mipLevel)
+    {
+        TextureRegion region;
+        {
+            region.subresource.numArrayLayers   = textureDesc.arrayLayers;
+            region.subresource.baseMipLevel     = mipLevel;
+            region.extent                       = texture->GetMipExtent(mipLevel);
+        }
+        WriteTexture(*texture, region, mipImages[mipLevel]);
+    }
+
+    return texture;
+}
+
 
 /*
  * ======= Protected: =======
@@ -119,6 +119,11 @@ Segment Deserializer::Begin()
 
     /* Set new reading position and end of segment */
     pos_ += g_segmentHeaderSize;
+
+    /* Reject segments that exceed the remaining data, e.g. of a truncated blob */
+    if (seg.size > size_ - pos_)
+        throw std::out_of_range("serialization segment exceeds end of data");
+
     segmentEnd_ = pos_ + seg.size;
 
     /* Return pointer to data segment */
@@ -147,7 +147,7 @@ class LLGL_EXPORT Deserializer
         // Resets the reading position to the begin.
         void Reset();
 
-        // Reads the next segment header.
+        // Reads the next segment header or throws an error if the segment exceeds the end of the data.
         Segment Begin();
 
         // Reads the next segment header or throws an error if the segment does not match the specified identifier.
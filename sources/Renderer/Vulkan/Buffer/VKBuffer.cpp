@@ -10,15 +10,17 @@
 #include "../VKTypes.h"
 #include "../Ext/VKExtensions.h"
 #include "../Ext/VKExtensionRegistry.h"
+#include <utility>
 
 
 namespace LLGL
 {
 
 
+// Buffers are always a transfer source, so they can be relocated by the device memory defragmenter
 static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
 {
-    VkBufferUsageFlags flags = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    VkBufferUsageFlags flags = (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
 
     if ((desc.bindFlags & BindFlags::VertexBuffer) != 0)
         flags |= VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
@@ -45,33 +47,20 @@ static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
         }
     }
 
-    if ((desc.cpuAccessFlags & CPUAccessFlags::Read) != 0 || (desc.bindFlags & BindFlags::CopySrc) != 0)
-        flags |= VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
     return flags;
 }
 
 VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc) :
-    Buffer            { desc.bindFlags },
-    bufferObj_        { device         },
-    bufferObjStaging_ { device         },
-    size_             { desc.size      }
+    Buffer            { desc.bindFlags              },
+    bufferObj_        { device                      },
+    bufferObjStaging_ { device                      },
+    size_             { desc.size                   },
+    usage_            { GetVkBufferUsageFlags(desc) }
 {
     if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
         indexType_ = VKTypes::ToVkIndexType(desc.format);
 
-    VkBufferCreateInfo createInfo;
-    {
-        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-        createInfo.pNext                    = nullptr;
-        createInfo.flags                    = 0;
-        createInfo.size                     = desc.size;
-        createInfo.usage                    = GetVkBufferUsageFlags(desc);
-        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
-        createInfo.queueFamilyIndexCount    = 0;
-        createInfo.pQueueFamilyIndices      = nullptr;
-    }
-    bufferObj_.CreateVkBuffer(device, createInfo);
+    bufferObj_.CreateVkBuffer(device, GetVkBufferCreateInfo());
 }
 
 BufferDescriptor VKBuffer::GetDesc() const
@@ -93,6 +82,17 @@ void VKBuffer::BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryReg
     bufferObj_.BindMemoryRegion(device, memoryRegion);
 }
 
+VKDeviceBuffer VKBuffer::Relocate(const VKPtr<VkDevice>& device, VKDeviceMemoryRegion* memoryRegion)
+{
+    /* Create new buffer object with the same attributes and bind it to the new memory region */
+    VKDeviceBuffer deviceBuffer{ device, GetVkBufferCreateInfo() };
+    deviceBuffer.BindMemoryRegion(device, memoryRegion);
+
+    /* Replace primary buffer object and return the previous one */
+    std::swap(bufferObj_, deviceBuffer);
+    return deviceBuffer;
+}
+
 void VKBuffer::TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer)
 {
     bufferObjStaging_ = std::move(deviceBuffer);
@@ -110,6 +110,27 @@ void VKBuffer::Unmap(VkDevice device)
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+VkBufferCreateInfo VKBuffer::GetVkBufferCreateInfo() const
+{
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size_;
+        createInfo.usage                    = usage_;
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    return createInfo;
+}
+
+
 } // /namespace LLGL
 
 
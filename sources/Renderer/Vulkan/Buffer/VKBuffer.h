@@ -30,6 +30,10 @@ class VKBuffer : public Buffer
         VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc);
 
         void BindMemoryRegion(VkDevice device, VKDeviceMemoryRegion* memoryRegion);
+
+        // Replaces the primary buffer object by a new one that is bound to the specified memory region, and returns the previous buffer object.
+        VKDeviceBuffer Relocate(const VKPtr<VkDevice>& device, VKDeviceMemoryRegion* memoryRegion);
+
         void TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer);
 
         void* Map(VkDevice device, const CPUAccess access);
@@ -77,15 +81,46 @@ class VKBuffer : public Buffer
             return indexType_;
         }
 
+        // Pins this buffer to its device memory region, because its VkBuffer handle is stored in a descriptor set, buffer array, or reusable command buffer.
+        inline void Pin()
+        {
+            pinned_ = true;
+        }
+
+        // Returns true if this buffer must not be relocated by the device memory defragmenter.
+        inline bool IsPinned() const
+        {
+            return pinned_;
+        }
+
+        // Stores the ID of the staging ring batch that last transferred data into this buffer.
+        inline void SetStagingBatchID(std::uint64_t id)
+        {
+            stagingBatchID_ = id;
+        }
+
+        // Returns the ID of the staging ring batch that last transferred data into this buffer, or 0 if there is none.
+        inline std::uint64_t GetStagingBatchID() const
+        {
+            return stagingBatchID_;
+        }
+
+    private:
+
+        VkBufferCreateInfo GetVkBufferCreateInfo() const;
+
     private:
 
-        VKDeviceBuffer  bufferObj_;
-        VKDeviceBuffer  bufferObjStaging_;
+        VKDeviceBuffer      bufferObj_;
+        VKDeviceBuffer      bufferObjStaging_;
 
-        VkDeviceSize    size_               = 0;
-        CPUAccess       mappedCPUAccess_    = CPUAccess::ReadOnly;
+        VkDeviceSize        size_               = 0;
+        VkBufferUsageFlags  usage_              = 0;
+        CPUAccess           mappedCPUAccess_    = CPUAccess::ReadOnly;
 
-        VkIndexType     indexType_          = VK_INDEX_TYPE_MAX_ENUM;
+        VkIndexType         indexType_          = VK_INDEX_TYPE_MAX_ENUM;
+        bool                pinned_             = false;
+        std::uint64_t       stagingBatchID_     = 0;
 
 };
 
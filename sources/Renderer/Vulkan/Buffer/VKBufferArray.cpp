@@ -24,6 +24,7 @@ VKBufferArray::VKBufferArray(long bindFlags, std::uint32_t numBuffers, Buffer* c
 
     while (auto next = NextArrayResource<VKBuffer>(numBuffers, bufferArray))
     {
+        next->Pin();
         buffers_.push_back(next->GetVkBuffer());
         offsets_.push_back(0);//next->GetOffset()
     }
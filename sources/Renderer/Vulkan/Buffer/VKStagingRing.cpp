@@ -0,0 +1,259 @@
+/*
+ * VKStagingRing.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKStagingRing.h"
+#include "../VKDevice.h"
+#include "../VKPhysicalDevice.h"
+#include "../VKCore.h"
+#include "../Memory/VKDeviceMemory.h"
+#include "../../../Core/Helper.h"
+#include <limits.h>
+
+
+namespace LLGL
+{
+
+
+static void InsertMemoryBarrier(
+    VkCommandBuffer         commandBuffer,
+    VkPipelineStageFlags    srcStageMask,
+    VkAccessFlags           srcAccessMask,
+    VkPipelineStageFlags    dstStageMask,
+    VkAccessFlags           dstAccessMask)
+{
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = srcAccessMask;
+        barrier.dstAccessMask   = dstAccessMask;
+    }
+    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+VKStagingRing::VKStagingRing(VKDevice& device, const VKPhysicalDevice& physicalDevice, VkDeviceSize size) :
+    device_    { device                  },
+    buffer_    { device, vkDestroyBuffer },
+    allocator_ { size                    }
+{
+    /* Create buffer object for uploads and readbacks */
+    VkBufferCreateInfo createInfo;
+    {
+        createInfo.sType                    = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.pNext                    = nullptr;
+        createInfo.flags                    = 0;
+        createInfo.size                     = size;
+        createInfo.usage                    = (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+        createInfo.sharingMode              = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.queueFamilyIndexCount    = 0;
+        createInfo.pQueueFamilyIndices      = nullptr;
+    }
+    auto result = vkCreateBuffer(device_, &createInfo, nullptr, buffer_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan staging ring buffer");
+
+    /* Allocate dedicated device memory, since it stays mapped for the entire lifetime of the ring */
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(device_, buffer_, &requirements);
+
+    auto memoryTypeIndex = physicalDevice.FindMemoryType(
+        requirements.memoryTypeBits,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    );
+
+    deviceMemory_ = MakeUnique<VKDeviceMemory>(device_.GetVkDevice(), requirements.size, memoryTypeIndex);
+
+    result = vkBindBufferMemory(device_, buffer_, deviceMemory_->GetVkDeviceMemory(), 0);
+    VKThrowIfFailed(result, "failed to bind Vulkan staging ring buffer to device memory");
+
+    mappedData_ = reinterpret_cast<char*>(deviceMemory_->Map(device_, 0, size));
+}
+
+VKStagingRing::~VKStagingRing()
+{
+    WaitIdle();
+
+    /* Release command buffers and fences of all batches */
+    for (const auto& batch : freeBatches_)
+    {
+        vkFreeCommandBuffers(device_, device_.GetVkCommandPool(), 1, &(batch.commandBuffer));
+        vkDestroyFence(device_, batch.fence, nullptr);
+    }
+
+    deviceMemory_->Unmap(device_);
+}
+
+bool VKStagingRing::Allocate(VkDeviceSize size, VkDeviceSize alignment, VKStagingRegion& region)
+{
+    if (size > allocator_.GetCapacity())
+        return false;
+
+    std::uint64_t offset = 0;
+    while (!allocator_.Allocate(size, alignment, offset))
+    {
+        /* Submit current batch and wait for the oldest batch to reclaim its staging regions */
+        Flush();
+        if (pendingBatches_.empty())
+            allocator_.Release(allocator_.GetHead());
+        else
+            ReclaimBatches(true);
+    }
+
+    region.buffer   = buffer_;
+    region.offset   = offset;
+    region.data     = mappedData_ + offset;
+
+    return true;
+}
+
+VkCommandBuffer VKStagingRing::GetCommandBuffer()
+{
+    if (!recording_)
+    {
+        currentBatch_ = AcquireBatch();
+        currentBatch_.id = ++lastBatchID_;
+
+        /* Begin recording the new batch */
+        VkCommandBufferBeginInfo beginInfo;
+        {
+            beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.pNext             = nullptr;
+            beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo  = nullptr;
+        }
+        auto result = vkBeginCommandBuffer(currentBatch_.commandBuffer, &beginInfo);
+        VKThrowIfFailed(result, "failed to begin recording Vulkan staging command buffer");
+
+        /* Wait for all previously submitted commands before the destination resources are overwritten */
+        InsertMemoryBarrier(
+            currentBatch_.commandBuffer,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT),
+            VK_PIPELINE_STAGE_TRANSFER_BIT, (VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT)
+        );
+
+        recording_ = true;
+    }
+    return currentBatch_.commandBuffer;
+}
+
+void VKStagingRing::Flush()
+{
+    if (!recording_)
+        return;
+
+    /* Make uploaded data visible to all subsequent commands and readbacks visible to the host */
+    InsertMemoryBarrier(
+        currentBatch_.commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+        (VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT), (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_HOST_READ_BIT)
+    );
+
+    auto result = vkEndCommandBuffer(currentBatch_.commandBuffer);
+    VKThrowIfFailed(result, "failed to end recording Vulkan staging command buffer");
+
+    /* Submit batch to graphics queue without waiting for its completion */
+    VkSubmitInfo submitInfo = {};
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = (&currentBatch_.commandBuffer);
+    }
+    result = vkQueueSubmit(device_.GetVkQueue(), 1, &submitInfo, currentBatch_.fence);
+    VKThrowIfFailed(result, "failed to submit Vulkan staging command buffer");
+
+    /* Staging regions of this batch can be reclaimed once its fence has been signaled */
+    currentBatch_.ringPosition = allocator_.GetHead();
+    pendingBatches_.push_back(currentBatch_);
+    recording_ = false;
+}
+
+void VKStagingRing::WaitIdle()
+{
+    Flush();
+    while (!pendingBatches_.empty())
+        ReclaimBatches(true);
+}
+
+void VKStagingRing::WaitForBatch(std::uint64_t id)
+{
+    if (id <= completedBatchID_)
+        return;
+
+    /* Submit current batch if it is the requested one */
+    if (recording_ && currentBatch_.id <= id)
+        Flush();
+
+    /* Batches are completed in submission order */
+    while (!pendingBatches_.empty() && pendingBatches_.front().id <= id)
+        ReclaimBatches(true);
+}
+
+void VKStagingRing::NextFrame()
+{
+    Flush();
+    ReclaimBatches(false);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKStagingRing::ReclaimBatches(bool waitOldest)
+{
+    if (waitOldest && !pendingBatches_.empty())
+        vkWaitForFences(device_, 1, &(pendingBatches_.front().fence), VK_TRUE, ULLONG_MAX);
+
+    while (!pendingBatches_.empty())
+    {
+        auto& batch = pendingBatches_.front();
+        if (vkGetFenceStatus(device_, batch.fence) != VK_SUCCESS)
+            break;
+
+        allocator_.Release(batch.ringPosition);
+        completedBatchID_ = batch.id;
+        freeBatches_.push_back(batch);
+        pendingBatches_.pop_front();
+    }
+}
+
+VKStagingRing::Batch VKStagingRing::AcquireBatch()
+{
+    ReclaimBatches(false);
+
+    Batch batch;
+
+    if (!freeBatches_.empty())
+    {
+        /* Reuse command buffer and fence of a completed batch */
+        batch = freeBatches_.back();
+        freeBatches_.pop_back();
+        vkResetFences(device_, 1, &(batch.fence));
+    }
+    else
+    {
+        /* Create command buffer and fence for a new batch */
+        batch.commandBuffer = device_.AllocCommandBuffer(false);
+
+        VkFenceCreateInfo createInfo;
+        {
+            createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+        }
+        auto result = vkCreateFence(device_, &createInfo, nullptr, &(batch.fence));
+        VKThrowIfFailed(result, "failed to create Vulkan fence");
+    }
+
+    return batch;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,125 @@
+/*
+ * VKStagingRing.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_STAGING_RING_H
+#define LLGL_VK_STAGING_RING_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include "../Memory/VKStagingRingAllocator.h"
+#include <vector>
+#include <deque>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKDeviceMemory;
+class VKPhysicalDevice;
+
+// Region within the staging ring buffer.
+struct VKStagingRegion
+{
+    VkBuffer        buffer  = VK_NULL_HANDLE;
+    VkDeviceSize    offset  = 0;
+    void*           data    = nullptr;  // Persistently mapped CPU address of this region.
+};
+
+/*
+Persistently mapped staging buffer for asynchronous uploads and readbacks.
+Staging regions are sub-allocated in a ring, and the transfer commands are recorded into the command buffer of the current batch.
+A batch is submitted to the graphics queue without waiting for it, either explicitly or before any other command buffer is submitted,
+so the uploads are executed before all subsequent commands. The ring memory of a batch is reclaimed once its fence has been signaled;
+the CPU only waits for a batch if the ring is full or the staged data must be read back.
+*/
+class VKStagingRing
+{
+
+    public:
+
+        VKStagingRing(VKDevice& device, const VKPhysicalDevice& physicalDevice, VkDeviceSize size);
+        ~VKStagingRing();
+
+        VKStagingRing(const VKStagingRing&) = delete;
+        VKStagingRing& operator = (const VKStagingRing&) = delete;
+
+        // Allocates a staging region for the current batch, and returns false if the size exceeds the capacity of the ring. Waits for previous batches if the ring is full.
+        bool Allocate(VkDeviceSize size, VkDeviceSize alignment, VKStagingRegion& region);
+
+        // Returns the command buffer of the current batch and begins a new batch if necessary.
+        VkCommandBuffer GetCommandBuffer();
+
+        // Returns the ID of the current batch. IDs are assigned in submission order, starting with 1.
+        inline std::uint64_t GetCurrentBatchID() const
+        {
+            return currentBatch_.id;
+        }
+
+        // Submits the specified batch if necessary and blocks until it has been completed. Returns immediately if the batch has already been completed or the ID is 0.
+        void WaitForBatch(std::uint64_t id);
+
+        // Submits the current batch to the graphics queue without waiting for its completion.
+        void Flush();
+
+        // Submits the current batch and blocks until all batches have been completed.
+        void WaitIdle();
+
+        // Submits the current batch and reclaims the staging regions of all completed batches without blocking.
+        void NextFrame();
+
+    private:
+
+        // Command buffer and fence of a batch of transfer commands.
+        struct Batch
+        {
+            VkCommandBuffer commandBuffer   = VK_NULL_HANDLE;
+            VkFence         fence           = VK_NULL_HANDLE;
+            std::uint64_t   ringPosition    = 0;
+            std::uint64_t   id              = 0;
+        };
+
+    private:
+
+        // Reclaims the staging regions of the completed batches in submission order. Blocks until the oldest batch has been completed if 'waitOldest' is true.
+        void ReclaimBatches(bool waitOldest);
+
+        // Returns a batch from the pool of completed batches, or creates a new one.
+        Batch AcquireBatch();
+
+    private:
+
+        VKDevice&                       device_;
+
+        std::unique_ptr<VKDeviceMemory> deviceMemory_;
+        VKPtr<VkBuffer>                 buffer_;
+        char*                           mappedData_         = nullptr;
+
+        VKStagingRingAllocator          allocator_;
+
+        Batch                           currentBatch_;
+        bool                            recording_          = false;
+        std::uint64_t                   lastBatchID_        = 0;
+        std::uint64_t                   completedBatchID_   = 0;
+
+        std::deque<Batch>               pendingBatches_;
+        std::vector<Batch>              freeBatches_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -24,6 +24,7 @@ static const char* g_optionalExtensions[] =
     VK_EXT_DEBUG_MARKER_EXTENSION_NAME,
     VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME,
     VK_EXT_CONSERVATIVE_RASTERIZATION_EXTENSION_NAME,
+    VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
     //VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME,
     nullptr,
 };
@@ -28,6 +28,7 @@ enum class VKExt
     EXT_conditional_rendering,
     EXT_transform_feedback,
     EXT_conservative_rasterization,
+    EXT_memory_budget,
 
     /* Enumeration entry counter */
     Count,
@@ -6,6 +6,7 @@
  */
 
 #include "VKDeviceMemory.h"
+#include "VKDeviceMemoryDefragPlanner.h"
 #include "../VKCore.h"
 #include "../../../Core/Helper.h"
 
@@ -14,7 +15,7 @@ namespace LLGL
 {
 
 
-VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex) :
+VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex, bool useTLSF) :
     deviceMemory_    { device, vkFreeMemory },
     size_            { size                 },
     memoryTypeIndex_ { memoryTypeIndex      },
@@ -35,6 +36,10 @@ VKDeviceMemory::VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size,
         std::string info = "failed to allocate Vulkan device memory of " + std::to_string(size) + " bytes";
         VKThrowIfFailed(result, info.c_str());
     }
+
+    /* Create TLSF sub-allocator for the entire chunk */
+    if (useTLSF)
+        tlsf_ = MakeUnique<VKDeviceMemoryTLSF>(size);
 }
 
 void* VKDeviceMemory::Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size)
@@ -54,6 +59,9 @@ void VKDeviceMemory::Unmap(VkDevice device)
 
 VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation)
 {
+    if (tlsf_)
+        return AllocateTLSF(size, alignment);
+
     if (size > 0 && alignment > 0)
     {
         /* Adjust size and offset by alignment */
@@ -86,7 +94,9 @@ VKDeviceMemoryRegion* VKDeviceMemory::Allocate(VkDeviceSize size, VkDeviceSize a
 
 void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 {
-    if (region)
+    if (region && tlsf_)
+        ReleaseTLSF(region);
+    else if (region)
     {
         /* Increase maximal size of fragmented blocks */
         maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, region->GetSize());
@@ -109,21 +119,72 @@ void VKDeviceMemory::Release(VKDeviceMemoryRegion* region)
 
 bool VKDeviceMemory::IsEmpty() const
 {
-    return blocks_.empty();
+    if (tlsf_)
+        return tlsf_->IsEmpty();
+    else
+        return blocks_.empty();
 }
 
 VkDeviceSize VKDeviceMemory::GetMaxAllocationSize() const
 {
-    return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
+    if (tlsf_)
+        return tlsf_->GetMaxAllocationSize();
+    else
+        return std::max(maxNewBlockSize_, maxFragmentedBlockSize_);
 }
 
 void VKDeviceMemory::AccumDetails(VKDeviceMemoryDetails& details) const
 {
+    if (tlsf_)
+    {
+        /* Report allocated blocks and free blocks of the TLSF allocator */
+        VKDeviceMemoryTLSFDetails tlsfDetails;
+        tlsf_->AccumDetails(tlsfDetails);
+
+        details.numChunks               += 1;
+        details.numBlocks               += tlsfDetails.numAllocatedBlocks;
+        details.numFragments            += tlsfDetails.numFreeBlocks;
+        details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, tlsfDetails.largestFreeBlock);
+        details.chunkSize               += GetSize();
+        details.blockSize               += tlsfDetails.allocatedSize;
+        return;
+    }
+
     details.numChunks               += 1;
     details.numBlocks               += blocks_.size();
     details.numFragments            += fragmentedBlocks_.size();
     details.maxNewBlockSize         = std::max(details.maxNewBlockSize, maxNewBlockSize_);
     details.maxFragmentedBlockSize  = std::max(details.maxFragmentedBlockSize, maxFragmentedBlockSize_);
+    details.chunkSize               += GetSize();
+
+    for (const auto& block : blocks_)
+        details.blockSize += block->GetSize();
+}
+
+void VKDeviceMemory::AccumFreeRanges(std::vector<VKDefragRange>& freeRanges) const
+{
+    if (tlsf_)
+    {
+        /* Report free blocks of the TLSF allocator */
+        for (auto block = tlsf_->GetFirstBlock(); block != VKDeviceMemoryTLSF::invalidBlock; block = tlsf_->GetNextBlock(block))
+        {
+            if (tlsf_->IsFree(block))
+                freeRanges.push_back({ tlsf_->GetOffset(block), tlsf_->GetSize(block) });
+        }
+    }
+    else
+    {
+        /* Report gaps between the blocks, which are sorted by their offsets */
+        VkDeviceSize offset = 0;
+        for (const auto& block : blocks_)
+        {
+            if (offset < block->GetOffset())
+                freeRanges.push_back({ offset, block->GetOffset() - offset });
+            offset = block->GetOffsetWithSize();
+        }
+        if (offset < GetSize())
+            freeRanges.push_back({ offset, GetSize() - offset });
+    }
 }
 
 #ifdef LLGL_DEBUG
@@ -133,30 +194,19 @@ Prints a single memory region to the output stream.
 Example of 3 consecutive blocks: [0+++++][8++][13++++++]
 Example of 3 fragmented blocks: [0+++++]...[11+].[17++++++]
 */
-static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& region, VKDeviceMemoryRegion* prevRegion)
+static void PrintDeviceMemoryRegion(std::ostream& s, VkDeviceSize offset, VkDeviceSize size, VkDeviceSize prevOffsetEnd)
 {
     /* Print space between previous and current region */
-    if (prevRegion)
-    {
-        auto startOffset    = prevRegion->GetOffsetWithSize();
-        auto endOffset      = region.GetOffset();
-        if (startOffset < endOffset)
-            s << std::string(static_cast<std::size_t>(endOffset - startOffset), '.');
-    }
-    else
-    {
-        auto endOffset = region.GetOffset();
-        if (endOffset > 0)
-            s << std::string(static_cast<std::size_t>(endOffset), '.');
-    }
+    if (prevOffsetEnd < offset)
+        s << std::string(static_cast<std::size_t>(offset - prevOffsetEnd), '.');
 
     /* Print new region */
-    auto n = static_cast<std::size_t>(region.GetSize());
+    auto n = static_cast<std::size_t>(size);
     if (n > 2)
     {
         s << '[';
 
-        auto numStr = std::to_string(region.GetSize());
+        auto numStr = std::to_string(size);
 
         n -= 2;
         if (numStr.size() <= n)
@@ -176,23 +226,47 @@ static void PrintDeviceMemoryRegion(std::ostream& s, VKDeviceMemoryRegion& regio
         s << '|';
 }
 
+// Prints either the allocated or the free blocks of the specified TLSF allocator.
+static void PrintTLSFBlocks(std::ostream& s, const VKDeviceMemoryTLSF& tlsf, bool freeBlocks)
+{
+    VkDeviceSize prevOffsetEnd = 0;
+    for (auto block = tlsf.GetFirstBlock(); block != VKDeviceMemoryTLSF::invalidBlock; block = tlsf.GetNextBlock(block))
+    {
+        if (tlsf.IsFree(block) == freeBlocks)
+        {
+            PrintDeviceMemoryRegion(s, tlsf.GetOffset(block), tlsf.GetSize(block), prevOffsetEnd);
+            prevOffsetEnd = tlsf.GetOffset(block) + tlsf.GetSize(block);
+        }
+    }
+}
+
 void VKDeviceMemory::PrintBlocks(std::ostream& s) const
 {
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : blocks_)
+    if (tlsf_)
+        PrintTLSFBlocks(s, *tlsf_, false);
+    else
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        VkDeviceSize prevOffsetEnd = 0;
+        for (const auto& block : blocks_)
+        {
+            PrintDeviceMemoryRegion(s, block->GetOffset(), block->GetSize(), prevOffsetEnd);
+            prevOffsetEnd = block->GetOffsetWithSize();
+        }
     }
 }
 
 void VKDeviceMemory::PrintFragmentedBlocks(std::ostream& s) const
 {
-    VKDeviceMemoryRegion* prevBlock = nullptr;
-    for (const auto& block : fragmentedBlocks_)
+    if (tlsf_)
+        PrintTLSFBlocks(s, *tlsf_, true);
+    else
     {
-        PrintDeviceMemoryRegion(s, *block, prevBlock);
-        prevBlock = block.get();
+        VkDeviceSize prevOffsetEnd = 0;
+        for (const auto& block : fragmentedBlocks_)
+        {
+            PrintDeviceMemoryRegion(s, block->GetOffset(), block->GetSize(), prevOffsetEnd);
+            prevOffsetEnd = block->GetOffsetWithSize();
+        }
     }
 }
 
@@ -266,19 +340,11 @@ VKDeviceMemoryRegion* VKDeviceMemory::InsertBlock(std::unique_ptr<VKDeviceMemory
     auto regionRef = region.get();
 
     /* Add block by insertion sort */
-    if (!blocks_.empty())
-    {
-        for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it)
-        {
-            if ((*it)->GetOffset() < region->GetOffset())
-            {
-                blocks_.insert(it.base(), std::move(region));
-                break;
-            }
-        }
-    }
-    else
-        blocks_.emplace_back(std::move(region));
+    auto it = blocks_.rbegin();
+    while (it != blocks_.rend() && (*it)->GetOffset() > region->GetOffset())
+        ++it;
+
+    blocks_.insert(it.base(), std::move(region));
 
     return regionRef;
 }
@@ -437,6 +503,42 @@ void VKDeviceMemory::IncMaxFragmentedBlockSize(VkDeviceSize size)
     maxFragmentedBlockSize_ = std::max(maxFragmentedBlockSize_, size);
 }
 
+VKDeviceMemoryRegion* VKDeviceMemory::AllocateTLSF(VkDeviceSize size, VkDeviceSize alignment)
+{
+    auto block = tlsf_->Allocate(size, alignment);
+    if (block == VKDeviceMemoryTLSF::invalidBlock)
+        return nullptr;
+
+    const auto blockSize    = static_cast<VkDeviceSize>(tlsf_->GetSize(block));
+    const auto blockOffset  = static_cast<VkDeviceSize>(tlsf_->GetOffset(block));
+
+    /* Reuse region object from the pool or append a new one */
+    VKDeviceMemoryRegion* region = nullptr;
+
+    if (!freeRegions_.empty())
+    {
+        region = freeRegions_.back();
+        region->MoveAt(blockSize, blockOffset);
+        freeRegions_.pop_back();
+    }
+    else
+    {
+        regionPool_.emplace_back(this, blockSize, blockOffset, memoryTypeIndex_);
+        region = &(regionPool_.back());
+    }
+
+    region->allocatorBlock_ = block;
+
+    return region;
+}
+
+void VKDeviceMemory::ReleaseTLSF(VKDeviceMemoryRegion* region)
+{
+    tlsf_->Release(region->allocatorBlock_);
+    region->allocatorBlock_ = VKDeviceMemoryTLSF::invalidBlock;
+    freeRegions_.push_back(region);
+}
+
 
 } // /namespace LLGL
 
@@ -10,10 +10,12 @@
 
 
 #include "VKDeviceMemoryRegion.h"
+#include "VKDeviceMemoryTLSF.h"
 #include "../VKPtr.h"
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <vector>
+#include <deque>
 #include <memory>
 
 #ifdef LLGL_DEBUG
@@ -25,6 +27,8 @@ namespace LLGL
 {
 
 
+struct VKDefragRange;
+
 // Details structure of VKDeviceMemory for debugging.
 struct VKDeviceMemoryDetails
 {
@@ -33,15 +37,21 @@ struct VKDeviceMemoryDetails
     std::size_t     numFragments            = 0;
     VkDeviceSize    maxNewBlockSize         = 0;
     VkDeviceSize    maxFragmentedBlockSize  = 0;
+    VkDeviceSize    chunkSize               = 0;
+    VkDeviceSize    blockSize               = 0;
 };
 
-// An instance of this class holds a single VkDeviceMemory allocation chunk.
+/*
+An instance of this class holds a single VkDeviceMemory allocation chunk.
+Blocks are either sub-allocated by appending them to the block list and reusing fragmented blocks (default),
+or by a TLSF allocator with pooled region objects (if 'useTLSF' is true).
+*/
 class VKDeviceMemory
 {
 
     public:
 
-        VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex);
+        VKDeviceMemory(const VKPtr<VkDevice>& device, VkDeviceSize size, std::uint32_t memoryTypeIndex, bool useTLSF = false);
 
         VKDeviceMemory(const VKDeviceMemory&) = delete;
         VKDeviceMemory& operator = (const VKDeviceMemory&) = delete;
@@ -67,6 +77,9 @@ class VKDeviceMemory
         // Accumulates the memory details of this device memory into the output structure.
         void AccumDetails(VKDeviceMemoryDetails& details) const;
 
+        // Appends all free ranges of this device memory chunk in ascending order of their offsets.
+        void AccumFreeRanges(std::vector<VKDefragRange>& freeRanges) const;
+
         #ifdef LLGL_DEBUG
 
         void PrintBlocks(std::ostream& s) const;
@@ -127,6 +140,12 @@ class VKDeviceMemory
         // Increases the maximal fragmented block size.
         void IncMaxFragmentedBlockSize(VkDeviceSize size);
 
+        // Allocates a new block with the TLSF allocator and returns a pooled region object for it.
+        VKDeviceMemoryRegion* AllocateTLSF(VkDeviceSize size, VkDeviceSize alignment);
+
+        // Releases the block of the specified region with the TLSF allocator and returns the region object to the pool.
+        void ReleaseTLSF(VKDeviceMemoryRegion* region);
+
         VKPtr<VkDeviceMemory>                               deviceMemory_;
         VkDeviceSize                                        size_                   = 0;
         std::uint32_t                                       memoryTypeIndex_        = 0;
@@ -137,6 +156,10 @@ class VKDeviceMemory
         VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
         std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
 
+        std::unique_ptr<VKDeviceMemoryTLSF>                 tlsf_;
+        std::deque<VKDeviceMemoryRegion>                    regionPool_;
+        std::vector<VKDeviceMemoryRegion*>                  freeRegions_;
+
 };
 
 
@@ -0,0 +1,202 @@
+/*
+ * VKDeviceMemoryDefragPlanner.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDeviceMemoryDefragPlanner.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+static std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment)
+{
+    return (alignment > 1 ? ((value + alignment - 1) / alignment) * alignment : value);
+}
+
+// Returns true if the occupied space of the specified chunk consists only of movable and pending allocations.
+static bool IsChunkEvacuable(const VKDefragChunk& chunk, std::uint64_t usedSize)
+{
+    std::uint64_t movableSize = chunk.pendingSize;
+    for (const auto& alloc : chunk.allocations)
+        movableSize += alloc.size;
+    return (!chunk.allocations.empty() && movableSize >= usedSize);
+}
+
+void VKDeviceMemoryDefragPlanner::Plan(const std::vector<VKDefragChunk>& chunks, std::uint64_t maxMoveSize, std::vector<VKDefragMove>& moves)
+{
+    moves.clear();
+
+    const auto numChunks = chunks.size();
+    if (numChunks < 2)
+        return;
+
+    /* Initialize simulated free ranges and occupied size of each chunk */
+    freeRanges_.resize(numChunks);
+    usedSizes_.resize(numChunks);
+    isSource_.assign(numChunks, false);
+    isDestination_.assign(numChunks, false);
+    srcOrder_.clear();
+    dstOrder_.clear();
+
+    for (std::size_t i = 0; i < numChunks; ++i)
+    {
+        const auto& chunk = chunks[i];
+
+        freeRanges_[i] = chunk.freeRanges;
+
+        std::uint64_t freeSize = 0;
+        for (const auto& range : chunk.freeRanges)
+            freeSize += range.size;
+        usedSizes_[i] = (chunk.size > freeSize ? chunk.size - freeSize : 0);
+
+        if (IsChunkEvacuable(chunk, usedSizes_[i]))
+            srcOrder_.push_back(i);
+
+        /* Chunks that are being evacuated must not receive new allocations, and empty chunks are released by the memory manager */
+        if (chunk.pendingSize == 0 && usedSizes_[i] > 0)
+            dstOrder_.push_back(i);
+    }
+
+    /* Evacuate chunks with the fewest bytes left to move first, and fill the fullest chunks first */
+    std::sort(
+        srcOrder_.begin(), srcOrder_.end(),
+        [&](std::size_t lhs, std::size_t rhs)
+        {
+            const auto lhsSize = usedSizes_[lhs] - std::min(usedSizes_[lhs], chunks[lhs].pendingSize);
+            const auto rhsSize = usedSizes_[rhs] - std::min(usedSizes_[rhs], chunks[rhs].pendingSize);
+            return (lhsSize < rhsSize || (lhsSize == rhsSize && lhs < rhs));
+        }
+    );
+
+    std::sort(
+        dstOrder_.begin(), dstOrder_.end(),
+        [&](std::size_t lhs, std::size_t rhs)
+        {
+            return (usedSizes_[lhs] > usedSizes_[rhs] || (usedSizes_[lhs] == usedSizes_[rhs] && lhs < rhs));
+        }
+    );
+
+    std::uint64_t movedSize = 0;
+
+    for (auto src : srcOrder_)
+    {
+        if (isDestination_[src])
+            continue;
+
+        const auto& srcChunk = chunks[src];
+
+        /* Place largest allocations first */
+        allocOrder_.resize(srcChunk.allocations.size());
+        for (std::size_t i = 0; i < allocOrder_.size(); ++i)
+            allocOrder_[i] = i;
+
+        std::sort(
+            allocOrder_.begin(), allocOrder_.end(),
+            [&srcChunk](std::size_t lhs, std::size_t rhs)
+            {
+                return (srcChunk.allocations[lhs].size > srcChunk.allocations[rhs].size);
+            }
+        );
+
+        /* Simulate placement of all allocations; restore free ranges if the chunk cannot be evacuated entirely */
+        freeRangesSnapshot_ = freeRanges_;
+        chunkMoves_.clear();
+
+        bool evacuable = true;
+
+        for (auto allocIndex : allocOrder_)
+        {
+            const auto& alloc = srcChunk.allocations[allocIndex];
+            bool placed = false;
+
+            for (auto dst : dstOrder_)
+            {
+                if (dst == src || isSource_[dst] || chunks[dst].memoryTypeIndex != srcChunk.memoryTypeIndex)
+                    continue;
+
+                std::uint64_t dstOffset = 0;
+                if (PlaceAllocation(freeRanges_[dst], alloc.size, alloc.alignment, dstOffset))
+                {
+                    chunkMoves_.push_back({ alloc.id, src, dst, dstOffset, alloc.size });
+                    placed = true;
+                    break;
+                }
+            }
+
+            if (!placed)
+            {
+                evacuable = false;
+                break;
+            }
+        }
+
+        if (!evacuable)
+        {
+            freeRanges_.swap(freeRangesSnapshot_);
+            continue;
+        }
+
+        isSource_[src] = true;
+
+        /* Emit moves until the budget is exhausted; always allow at least one move so large allocations cannot stall */
+        for (const auto& move : chunkMoves_)
+        {
+            if (!moves.empty() && movedSize + move.size > maxMoveSize)
+                return;
+
+            isDestination_[move.dstChunk] = true;
+            moves.push_back(move);
+            movedSize += move.size;
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool VKDeviceMemoryDefragPlanner::PlaceAllocation(std::vector<VKDefragRange>& freeRanges, std::uint64_t size, std::uint64_t alignment, std::uint64_t& offset)
+{
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it)
+    {
+        const auto rangeEnd     = it->offset + it->size;
+        const auto alignedBegin = AlignUp(it->offset, alignment);
+
+        if (alignedBegin + size <= rangeEnd)
+        {
+            offset = alignedBegin;
+
+            /* Split free range into the lower padding and the upper remainder */
+            const auto upperOffset = alignedBegin + size;
+            if (alignedBegin > it->offset)
+            {
+                it->size = alignedBegin - it->offset;
+                if (upperOffset < rangeEnd)
+                    freeRanges.insert(it + 1, VKDefragRange{ upperOffset, rangeEnd - upperOffset });
+            }
+            else if (upperOffset < rangeEnd)
+            {
+                it->offset  = upperOffset;
+                it->size    = rangeEnd - upperOffset;
+            }
+            else
+                freeRanges.erase(it);
+
+            return true;
+        }
+    }
+    return false;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
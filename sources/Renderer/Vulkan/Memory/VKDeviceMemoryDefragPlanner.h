@@ -0,0 +1,101 @@
+/*
+ * VKDeviceMemoryDefragPlanner.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DEVICE_MEMORY_DEFRAG_PLANNER_H
+#define LLGL_VK_DEVICE_MEMORY_DEFRAG_PLANNER_H
+
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Free range within a device memory chunk.
+struct VKDefragRange
+{
+    std::uint64_t   offset;
+    std::uint64_t   size;
+};
+
+// Allocation within a device memory chunk that can be moved into another chunk.
+struct VKDefragAllocation
+{
+    std::size_t     id;         // User defined identifier that is passed through to VKDefragMove::id.
+    std::uint64_t   offset;
+    std::uint64_t   size;
+    std::uint64_t   alignment;
+};
+
+// Input description of a device memory chunk. Occupied space that is neither free nor movable is treated as immovable.
+struct VKDefragChunk
+{
+    std::uint32_t                   memoryTypeIndex = 0;
+    std::uint64_t                   size            = 0;
+    std::uint64_t                   pendingSize     = 0;    // Size of allocations that have already been moved out but are not released yet.
+    std::vector<VKDefragRange>      freeRanges;             // Free ranges in ascending order of their offsets.
+    std::vector<VKDefragAllocation> allocations;            // Movable allocations.
+};
+
+// Planned move of a single allocation.
+struct VKDefragMove
+{
+    std::size_t     id;
+    std::size_t     srcChunk;
+    std::size_t     dstChunk;
+    std::uint64_t   dstOffset;
+    std::uint64_t   size;
+};
+
+/*
+Plans the moves of an incremental device memory defragmentation and is independent of the Vulkan API.
+Chunks whose occupied space is entirely movable are evacuated into the free ranges of the other chunks with the same memory type,
+starting with the chunk that has the fewest bytes left to move. Non-empty destination chunks are filled in descending order of their occupied space.
+A chunk is only evacuated if all of its allocations fit into the other chunks, and chunks that receive allocations are never evacuated themselves.
+The planned moves of a single call are limited by a byte budget (except the first move), so a chunk might be evacuated over several calls.
+*/
+class VKDeviceMemoryDefragPlanner
+{
+
+    public:
+
+        // Plans the moves for the specified chunks with the specified byte budget. The output container is cleared first.
+        void Plan(const std::vector<VKDefragChunk>& chunks, std::uint64_t maxMoveSize, std::vector<VKDefragMove>& moves);
+
+    private:
+
+        // Tries to place an allocation of the specified size and alignment into the free ranges, and returns true on success.
+        static bool PlaceAllocation(std::vector<VKDefragRange>& freeRanges, std::uint64_t size, std::uint64_t alignment, std::uint64_t& offset);
+
+    private:
+
+        // Simulated free ranges of each chunk.
+        std::vector<std::vector<VKDefragRange>> freeRanges_;
+        std::vector<std::vector<VKDefragRange>> freeRangesSnapshot_;
+
+        std::vector<std::uint64_t>              usedSizes_;
+        std::vector<std::size_t>                srcOrder_;
+        std::vector<std::size_t>                dstOrder_;
+        std::vector<std::size_t>                allocOrder_;
+        std::vector<bool>                       isSource_;
+        std::vector<bool>                       isDestination_;
+        std::vector<VKDefragMove>               chunkMoves_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
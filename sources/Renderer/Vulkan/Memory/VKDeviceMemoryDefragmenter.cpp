@@ -0,0 +1,295 @@
+/*
+ * VKDeviceMemoryDefragmenter.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDeviceMemoryDefragmenter.h"
+#include "VKDeviceMemoryManager.h"
+#include "../VKDevice.h"
+#include "../Buffer/VKBuffer.h"
+#include "../VKCore.h"
+#include "../../../Core/Helper.h"
+#include <limits.h>
+
+
+namespace LLGL
+{
+
+
+static void InsertMemoryBarrier(
+    VkCommandBuffer         commandBuffer,
+    VkPipelineStageFlags    srcStageMask,
+    VkAccessFlags           srcAccessMask,
+    VkPipelineStageFlags    dstStageMask,
+    VkAccessFlags           dstAccessMask)
+{
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = srcAccessMask;
+        barrier.dstAccessMask   = dstAccessMask;
+    }
+    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+VKDeviceMemoryDefragmenter::VKDeviceMemoryDefragmenter(VKDevice& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize maxMoveSizePerFrame) :
+    device_              { device              },
+    deviceMemoryMngr_    { deviceMemoryMngr    },
+    maxMoveSizePerFrame_ { maxMoveSizePerFrame }
+{
+}
+
+VKDeviceMemoryDefragmenter::~VKDeviceMemoryDefragmenter()
+{
+    ReleaseRetiredBuffers(true);
+
+    /* Release command buffers and fences of all move batches */
+    for (const auto& batch : freeBatches_)
+    {
+        vkFreeCommandBuffers(device_, device_.GetVkCommandPool(), 1, &(batch.commandBuffer));
+        vkDestroyFence(device_, batch.fence, nullptr);
+    }
+}
+
+void VKDeviceMemoryDefragmenter::RegisterBuffer(VKBuffer& buffer)
+{
+    buffers_.push_back(&buffer);
+}
+
+void VKDeviceMemoryDefragmenter::UnregisterBuffer(VKBuffer& buffer)
+{
+    RemoveFromList(buffers_, &buffer);
+}
+
+void VKDeviceMemoryDefragmenter::NextFrame()
+{
+    ReleaseRetiredBuffers(false);
+
+    if (buffers_.empty() || !BuildPlannerInput())
+        return;
+
+    /* Plan moves for the current frame */
+    planner_.Plan(chunks_, maxMoveSizePerFrame_, moves_);
+    if (moves_.empty())
+        return;
+
+    /* Record copy commands of all moves into a single command buffer */
+    auto batch = AcquireBatch();
+    {
+        /* Wait for all previous writes to the source buffers */
+        InsertMemoryBarrier(
+            batch.commandBuffer,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_ACCESS_MEMORY_WRITE_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT
+        );
+
+        for (const auto& move : moves_)
+            MoveBuffer(batch, *buffers_[move.id], chunkRefs_[move.dstChunk]);
+
+        /* Make copied data visible to all subsequent commands */
+        InsertMemoryBarrier(
+            batch.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+            VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+        );
+    }
+    SubmitBatch(std::move(batch));
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKDeviceMemoryDefragmenter::ReleaseRetiredBuffers(bool waitAll)
+{
+    while (!pendingBatches_.empty())
+    {
+        auto& batch = pendingBatches_.front();
+
+        /*
+        The fence signal operation includes all commands that were submitted earlier,
+        so the previous buffer objects are no longer in use by any command buffer that has been submitted before the moves
+        */
+        if (waitAll)
+            vkWaitForFences(device_, 1, &(batch.fence), VK_TRUE, ULLONG_MAX);
+        else if (vkGetFenceStatus(device_, batch.fence) != VK_SUCCESS)
+            break;
+
+        for (auto& deviceBuffer : batch.retiredBuffers)
+        {
+            deviceBuffer.ReleaseVkBuffer();
+            deviceBuffer.ReleaseMemoryRegion(deviceMemoryMngr_);
+        }
+        batch.retiredBuffers.clear();
+
+        freeBatches_.push_back(std::move(batch));
+        pendingBatches_.pop_front();
+    }
+}
+
+VKDeviceMemoryDefragmenter::MoveBatch VKDeviceMemoryDefragmenter::AcquireBatch()
+{
+    MoveBatch batch;
+
+    if (!freeBatches_.empty())
+    {
+        /* Reuse command buffer and fence of a completed batch */
+        batch = std::move(freeBatches_.back());
+        freeBatches_.pop_back();
+        vkResetFences(device_, 1, &(batch.fence));
+    }
+    else
+    {
+        /* Create command buffer and fence for a new batch */
+        batch.commandBuffer = device_.AllocCommandBuffer(false);
+
+        VkFenceCreateInfo createInfo;
+        {
+            createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+            createInfo.pNext = nullptr;
+            createInfo.flags = 0;
+        }
+        auto result = vkCreateFence(device_, &createInfo, nullptr, &(batch.fence));
+        VKThrowIfFailed(result, "failed to create Vulkan fence");
+    }
+
+    /* Begin recording the move batch */
+    VkCommandBufferBeginInfo beginInfo;
+    {
+        beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext             = nullptr;
+        beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo  = nullptr;
+    }
+    auto result = vkBeginCommandBuffer(batch.commandBuffer, &beginInfo);
+    VKThrowIfFailed(result, "failed to begin recording Vulkan command buffer for device memory defragmentation");
+
+    return batch;
+}
+
+void VKDeviceMemoryDefragmenter::SubmitBatch(MoveBatch&& batch)
+{
+    auto result = vkEndCommandBuffer(batch.commandBuffer);
+    VKThrowIfFailed(result, "failed to end recording Vulkan command buffer for device memory defragmentation");
+
+    /* Submit move batch to graphics queue without waiting for its completion */
+    VkSubmitInfo submitInfo = {};
+    {
+        submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount   = 1;
+        submitInfo.pCommandBuffers      = (&batch.commandBuffer);
+    }
+    result = vkQueueSubmit(device_.GetVkQueue(), 1, &submitInfo, batch.fence);
+    VKThrowIfFailed(result, "failed to submit Vulkan command buffer for device memory defragmentation");
+
+    pendingBatches_.push_back(std::move(batch));
+}
+
+bool VKDeviceMemoryDefragmenter::BuildPlannerInput()
+{
+    /* Gather all chunks of the memory types that have more than one chunk */
+    chunkRefs_.clear();
+    chunkIndices_.clear();
+
+    for (std::uint32_t i = 0; i < VK_MAX_MEMORY_TYPES; ++i)
+    {
+        const auto& chunks = deviceMemoryMngr_.GetChunks(i);
+        if (chunks.size() >= 2)
+        {
+            for (const auto& chunk : chunks)
+            {
+                chunkIndices_[chunk.get()] = chunkRefs_.size();
+                chunkRefs_.push_back(chunk.get());
+            }
+        }
+    }
+
+    if (chunkRefs_.empty())
+        return false;
+
+    /* Reset chunk descriptions but keep the capacity of their containers */
+    chunks_.resize(chunkRefs_.size());
+
+    for (std::size_t i = 0; i < chunkRefs_.size(); ++i)
+    {
+        auto& chunk = chunks_[i];
+        {
+            chunk.memoryTypeIndex   = chunkRefs_[i]->GetMemoryTypeIndex();
+            chunk.size              = chunkRefs_[i]->GetSize();
+            chunk.pendingSize       = 0;
+            chunk.freeRanges.clear();
+            chunk.allocations.clear();
+        }
+        chunkRefs_[i]->AccumFreeRanges(chunk.freeRanges);
+    }
+
+    /* Memory of retired buffers will be released, but must not be moved again */
+    for (const auto& batch : pendingBatches_)
+    {
+        for (const auto& deviceBuffer : batch.retiredBuffers)
+        {
+            if (auto region = deviceBuffer.GetMemoryRegion())
+            {
+                auto it = chunkIndices_.find(region->GetParentChunk());
+                if (it != chunkIndices_.end())
+                    chunks_[it->second].pendingSize += region->GetSize();
+            }
+        }
+    }
+
+    /* Add all buffers that are not pinned as movable allocations */
+    for (std::size_t i = 0; i < buffers_.size(); ++i)
+    {
+        const auto& deviceBuffer = buffers_[i]->GetDeviceBuffer();
+        if (buffers_[i]->IsPinned() || buffers_[i]->GetSize() == 0)
+            continue;
+
+        if (auto region = deviceBuffer.GetMemoryRegion())
+        {
+            auto it = chunkIndices_.find(region->GetParentChunk());
+            if (it != chunkIndices_.end())
+            {
+                chunks_[it->second].allocations.push_back(
+                    VKDefragAllocation{ i, region->GetOffset(), region->GetSize(), deviceBuffer.GetRequirements().alignment }
+                );
+            }
+        }
+    }
+
+    return true;
+}
+
+void VKDeviceMemoryDefragmenter::MoveBuffer(MoveBatch& batch, VKBuffer& buffer, VKDeviceMemory* dstChunk)
+{
+    /* Allocate new memory region in destination chunk (the actual allocator may not follow the planned offset) */
+    const auto& requirements = buffer.GetDeviceBuffer().GetRequirements();
+
+    auto memoryRegion = deviceMemoryMngr_.AllocateInChunk(dstChunk, requirements.size, requirements.alignment);
+    if (!memoryRegion)
+        return;
+
+    /* Replace buffer object and copy its content into the new memory region */
+    auto prevDeviceBuffer = buffer.Relocate(device_, memoryRegion);
+
+    VkBufferCopy copyRegion;
+    {
+        copyRegion.srcOffset    = 0;
+        copyRegion.dstOffset    = 0;
+        copyRegion.size         = buffer.GetSize();
+    }
+    vkCmdCopyBuffer(batch.commandBuffer, prevDeviceBuffer.GetVkBuffer(), buffer.GetVkBuffer(), 1, &copyRegion);
+
+    /* Keep previous buffer object alive until the fence of this batch has been signaled */
+    batch.retiredBuffers.push_back(std::move(prevDeviceBuffer));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,112 @@
+/*
+ * VKDeviceMemoryDefragmenter.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DEVICE_MEMORY_DEFRAGMENTER_H
+#define LLGL_VK_DEVICE_MEMORY_DEFRAGMENTER_H
+
+
+#include <vulkan/vulkan.h>
+#include "VKDeviceMemoryDefragPlanner.h"
+#include "../Buffer/VKDeviceBuffer.h"
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKBuffer;
+class VKDeviceMemory;
+class VKDeviceMemoryManager;
+
+/*
+Incremental defragmenter for the Vulkan device memory chunks.
+Once per frame, the moves of the registered buffers are planned by VKDeviceMemoryDefragPlanner within a byte budget,
+and the copies are recorded into a single command buffer. Each moved buffer gets a new VkBuffer handle that is bound to its new memory region,
+so all commands that are recorded afterwards refer to the new location. The copies are submitted with a fence without waiting for their completion,
+and the previous VkBuffer and its memory region are released once that fence has been signaled, i.e. once all previously submitted commands have been completed.
+Buffers that are referenced by descriptor sets, buffer arrays, or command buffers that can be submitted more than once (MultiSubmit or DeferredSubmit)
+are pinned and never moved.
+Images are treated as immovable, since their image views are referenced by framebuffers and descriptor sets.
+*/
+class VKDeviceMemoryDefragmenter
+{
+
+    public:
+
+        VKDeviceMemoryDefragmenter(VKDevice& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize maxMoveSizePerFrame);
+        ~VKDeviceMemoryDefragmenter();
+
+        VKDeviceMemoryDefragmenter(const VKDeviceMemoryDefragmenter&) = delete;
+        VKDeviceMemoryDefragmenter& operator = (const VKDeviceMemoryDefragmenter&) = delete;
+
+        // Registers the specified buffer, so it can be moved into other device memory chunks.
+        void RegisterBuffer(VKBuffer& buffer);
+
+        // Unregisters the specified buffer. This must be called before the buffer is released.
+        void UnregisterBuffer(VKBuffer& buffer);
+
+        // Releases the retired buffers of all completed move batches, then plans, records, and submits the moves for the current frame.
+        void NextFrame();
+
+    private:
+
+        // Submitted copy commands and the previous buffer objects of the moved buffers, which are released once the fence has been signaled.
+        struct MoveBatch
+        {
+            VkCommandBuffer             commandBuffer   = VK_NULL_HANDLE;
+            VkFence                     fence           = VK_NULL_HANDLE;
+            std::vector<VKDeviceBuffer> retiredBuffers;
+        };
+
+    private:
+
+        // Releases the retired buffers of all completed move batches in submission order. Blocks until all batches have been completed if 'waitAll' is true.
+        void ReleaseRetiredBuffers(bool waitAll);
+
+        // Returns a move batch from the pool of completed batches, or creates a new one.
+        MoveBatch AcquireBatch();
+
+        // Submits the specified move batch with its fence without waiting for its completion.
+        void SubmitBatch(MoveBatch&& batch);
+
+        // Builds the input of the move planner for all memory types with more than one chunk. Returns false if there is nothing to defragment.
+        bool BuildPlannerInput();
+
+        // Moves the specified buffer into the destination chunk and records the copy command into the move batch.
+        void MoveBuffer(MoveBatch& batch, VKBuffer& buffer, VKDeviceMemory* dstChunk);
+
+    private:
+
+        VKDevice&                                               device_;
+        VKDeviceMemoryManager&                                  deviceMemoryMngr_;
+        VkDeviceSize                                            maxMoveSizePerFrame_    = 0;
+
+        std::vector<VKBuffer*>                                  buffers_;
+        std::deque<MoveBatch>                                   pendingBatches_;
+        std::vector<MoveBatch>                                  freeBatches_;
+
+        VKDeviceMemoryDefragPlanner                             planner_;
+        std::vector<VKDefragChunk>                              chunks_;
+        std::vector<VKDeviceMemory*>                            chunkRefs_;
+        std::unordered_map<const VKDeviceMemory*, std::size_t>  chunkIndices_;
+        std::vector<VKDefragMove>                               moves_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
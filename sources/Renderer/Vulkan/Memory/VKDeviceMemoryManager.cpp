@@ -6,25 +6,96 @@
  */
 
 #include "VKDeviceMemoryManager.h"
+#include "../VKPhysicalDevice.h"
 #include "../VKCore.h"
 #include "../../../Core/Helper.h"
+#include <algorithm>
 
 
 namespace LLGL
 {
 
 
+/*
+ * Internal constants and functions
+ */
+
+// Number of queue submissions an empty chunk is kept before it is released to the driver.
+static const std::uint64_t g_emptyChunkGracePeriod = 256;
+
+// Strict-weak-order (SWO) of chunks by their maximal allocation size.
+struct ChunkMaxAllocationSizeSWO
+{
+    inline bool operator () (const std::unique_ptr<VKDeviceMemory>& lhs, VkDeviceSize rhs) const
+    {
+        return (lhs->GetMaxAllocationSize() < rhs);
+    }
+
+    inline bool operator () (VkDeviceSize lhs, const std::unique_ptr<VKDeviceMemory>& rhs) const
+    {
+        return (lhs < rhs->GetMaxAllocationSize());
+    }
+};
+
+using VKDeviceMemoryChunkList = std::vector<std::unique_ptr<VKDeviceMemory>>;
+
+// Returns the iterator of the specified chunk within its ordered chunk list.
+static VKDeviceMemoryChunkList::iterator FindChunkInList(VKDeviceMemoryChunkList& chunks, const VKDeviceMemory* chunk)
+{
+    auto IsChunk = [chunk](const std::unique_ptr<VKDeviceMemory>& entry)
+    {
+        return (entry.get() == chunk);
+    };
+
+    /* Search chunk only within the range of chunks with the same maximal allocation size */
+    auto range = std::equal_range(chunks.begin(), chunks.end(), chunk->GetMaxAllocationSize(), ChunkMaxAllocationSizeSWO{});
+
+    auto it = std::find_if(range.first, range.second, IsChunk);
+    if (it != range.second)
+        return it;
+
+    return std::find_if(chunks.begin(), chunks.end(), IsChunk);
+}
+
+// Moves the specified chunk, whose maximal allocation size has changed, to restore the order of the chunk list.
+static void ResortChunkInList(VKDeviceMemoryChunkList& chunks, VKDeviceMemoryChunkList::iterator it)
+{
+    const auto size = (*it)->GetMaxAllocationSize();
+
+    if (it != chunks.begin() && (*(it - 1))->GetMaxAllocationSize() > size)
+    {
+        /* Move chunk towards the front */
+        auto pos = std::upper_bound(chunks.begin(), it, size, ChunkMaxAllocationSizeSWO{});
+        std::rotate(pos, it, it + 1);
+    }
+    else if (it + 1 != chunks.end() && (*(it + 1))->GetMaxAllocationSize() < size)
+    {
+        /* Move chunk towards the back */
+        auto pos = std::lower_bound(it + 1, chunks.end(), size, ChunkMaxAllocationSizeSWO{});
+        std::rotate(it, it + 1, pos);
+    }
+}
+
+
+/*
+ * VKDeviceMemoryManager class
+ */
+
 VKDeviceMemoryManager::VKDeviceMemoryManager(
-    const VKPtr<VkDevice>&                  device,
-    const VkPhysicalDeviceMemoryProperties& memoryProperties,
-    VkDeviceSize                            minAllocationSize,
-    bool                                    reduceFragmentation)
+    const VKPtr<VkDevice>&  device,
+    const VKPhysicalDevice& physicalDevice,
+    VkDeviceSize            minAllocationSize,
+    bool                    reduceFragmentation,
+    bool                    useTLSF)
 :
-    device_              { device              },
-    memoryProperties_    { memoryProperties    },
-    minAllocationSize_   { minAllocationSize   },
-    reduceFragmentation_ { reduceFragmentation }
+    device_              { device                              },
+    physicalDevice_      { physicalDevice                      },
+    memoryProperties_    { physicalDevice.GetMemoryProperties() },
+    minAllocationSize_   { minAllocationSize                   },
+    reduceFragmentation_ { reduceFragmentation                 },
+    useTLSF_             { useTLSF                             }
 {
+    UpdateBudget();
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
@@ -38,9 +109,15 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
 
     if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
-        return chunk->Allocate(size, alignment);
-    else
-        return nullptr;
+    {
+        if (auto region = AllocateInChunk(chunk, size, alignment))
+            return region;
+
+        /* Allocate new chunk if the block could not be allocated within a chunk that is already in use (e.g. due to alignment) */
+        if (!chunk->IsEmpty())
+            return AllocateInChunk(AllocChunk(allocationSize, memoryTypeIndex), size, alignment);
+    }
+    return nullptr;
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
@@ -55,25 +132,48 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
     );
 }
 
+VKDeviceMemoryRegion* VKDeviceMemoryManager::AllocateInChunk(VKDeviceMemory* chunk, VkDeviceSize size, VkDeviceSize alignment)
+{
+    auto& chunks = chunkLists_[chunk->GetMemoryTypeIndex()];
+    auto it = FindChunkInList(chunks, chunk);
+
+    const bool wasEmpty = chunk->IsEmpty();
+
+    /* Allocate block and restore order of chunk list */
+    auto region = chunk->Allocate(size, alignment);
+
+    if (it != chunks.end())
+        ResortChunkInList(chunks, it);
+
+    /* Chunk is no longer subject to the grace period of empty chunks */
+    if (region != nullptr && wasEmpty)
+        RemoveEmptyChunk(chunk);
+
+    return region;
+}
+
 void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
 {
     if (region)
     {
         if (auto chunk = region->GetParentChunk())
         {
-            /* Release block in chunk */
+            /* Release block in chunk and restore order of its chunk list */
+            auto& chunks = chunkLists_[chunk->GetMemoryTypeIndex()];
+            auto it = FindChunkInList(chunks, chunk);
+
             chunk->Release(region);
 
-            /* Release chunk if it's empty */
+            if (it != chunks.end())
+                ResortChunkInList(chunks, it);
+
+            /* Keep empty chunk for a grace period, unless its memory heap exceeds the budget */
             if (chunk->IsEmpty())
             {
-                RemoveFromListIf(
-                    chunks_,
-                    [chunk](std::unique_ptr<VKDeviceMemory>& entry)
-                    {
-                        return (entry.get() == chunk);
-                    }
-                );
+                if (ExceedsBudget(GetHeapIndex(chunk->GetMemoryTypeIndex()), 0))
+                    ReleaseChunk(chunk);
+                else
+                    emptyChunks_.push_back({ chunk, submission_ });
             }
         }
     }
@@ -83,35 +183,88 @@ VKDeviceMemoryDetails VKDeviceMemoryManager::QueryDetails() const
 {
     VKDeviceMemoryDetails details;
     {
-        for (const auto& chunk : chunks_)
-            chunk->AccumDetails(details);
+        for (const auto& chunks : chunkLists_)
+        {
+            for (const auto& chunk : chunks)
+                chunk->AccumDetails(details);
+        }
     }
     return details;
 }
 
+void VKDeviceMemoryManager::QueryStatistics(MemoryStatistics& stats)
+{
+    UpdateBudget();
+
+    const auto details = QueryDetails();
+
+    stats.numChunks             = details.numChunks;
+    stats.numEmptyChunks        = emptyChunks_.size();
+    stats.numBlocks             = details.numBlocks;
+    stats.numFreeBlocks         = details.numFragments;
+    stats.chunkMemorySize       = details.chunkSize;
+    stats.blockMemorySize       = details.blockSize;
+    stats.largestFreeBlockSize  = std::max(details.maxNewBlockSize, details.maxFragmentedBlockSize);
+    stats.budget                = 0;
+    stats.usage                 = 0;
+
+    if (hasBudget_)
+    {
+        for (std::uint32_t i = 0; i < memoryProperties_.memoryHeapCount; ++i)
+        {
+            stats.budget    += heapBudgets_[i];
+            stats.usage     += heapUsages_[i];
+        }
+    }
+}
+
+void VKDeviceMemoryManager::NextSubmission()
+{
+    ++submission_;
+
+    UpdateBudget();
+
+    /* Release all empty chunks on memory heaps that exceed their budget */
+    if (hasBudget_)
+    {
+        for (std::uint32_t i = 0; i < memoryProperties_.memoryHeapCount; ++i)
+        {
+            if (ExceedsBudget(i, 0))
+                ReleaseEmptyChunks(i, submission_);
+        }
+    }
+
+    /* Release all empty chunks whose grace period has expired */
+    if (submission_ >= g_emptyChunkGracePeriod)
+        ReleaseEmptyChunks(~0u, submission_ - g_emptyChunkGracePeriod);
+}
+
 #ifdef LLGL_DEBUG
 
 void VKDeviceMemoryManager::PrintBlocks(std::ostream& s, const std::string& title) const
 {
     std::size_t i = 0;
-    for (const auto& chunk : chunks_)
+    for (const auto& chunks : chunkLists_)
     {
-        s << "chunk[" << (i++) << "]:";
+        for (const auto& chunk : chunks)
+        {
+            s << "chunk[" << (i++) << "]:";
 
-        if (!title.empty())
-            s << " \"" << title << '\"';
+            if (!title.empty())
+                s << " \"" << title << '\"';
 
-        s << '\n';
-        s << "  size             = " << chunk->GetSize() << '\n';
-        s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
+            s << '\n';
+            s << "  size             = " << chunk->GetSize() << '\n';
+            s << "  memoryTypeIndex  = " << chunk->GetMemoryTypeIndex() << '\n';
 
-        s << "  blocks           = ";
-        chunk->PrintBlocks(s);
-        s << '\n';
+            s << "  blocks           = ";
+            chunk->PrintBlocks(s);
+            s << '\n';
 
-        s << "  fragmentedBlocks = ";
-        chunk->PrintFragmentedBlocks(s);
-        s << '\n';
+            s << "  fragmentedBlocks = ";
+            chunk->PrintFragmentedBlocks(s);
+            s << '\n';
+        }
     }
 }
 
@@ -127,24 +280,105 @@ std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits
     return VKFindMemoryType(memoryProperties_, memoryTypeBits, properties);
 }
 
+std::uint32_t VKDeviceMemoryManager::GetHeapIndex(std::uint32_t memoryTypeIndex) const
+{
+    return memoryProperties_.memoryTypes[memoryTypeIndex].heapIndex;
+}
+
 VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
 {
-    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
+    /* Release empty chunks first if the new chunk would exceed the memory budget */
+    const auto heapIndex = GetHeapIndex(memoryTypeIndex);
+    if (ExceedsBudget(heapIndex, size))
+        ReleaseEmptyChunks(heapIndex, submission_);
+
+    auto chunk = MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex, useTLSF_);
+    auto chunkRef = chunk.get();
+
+    /* Track heap usage until the budget is updated the next time */
+    heapUsages_[heapIndex] += size;
+
+    /* Insert chunk into its list ordered by the maximal allocation size */
+    auto& chunks = chunkLists_[memoryTypeIndex];
+    auto pos = std::upper_bound(chunks.begin(), chunks.end(), chunk->GetMaxAllocationSize(), ChunkMaxAllocationSizeSWO{});
+    chunks.insert(pos, std::move(chunk));
+
+    return chunkRef;
 }
 
 VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
 {
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
-    {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
-            return chunk.get();
-    }
+    /* Search for the chunk with the smallest maximal allocation size that is still large enough */
+    auto& chunks = chunkLists_[memoryTypeIndex];
+    auto it = std::lower_bound(chunks.begin(), chunks.end(), minFreeBlockSize, ChunkMaxAllocationSizeSWO{});
+
+    if (it != chunks.end())
+        return it->get();
 
     /* Allocate new chunk */
     return AllocChunk(allocationSize, memoryTypeIndex);
 }
 
+void VKDeviceMemoryManager::ReleaseChunk(VKDeviceMemory* chunk)
+{
+    /* Track heap usage until the budget is updated the next time */
+    const auto heapIndex = GetHeapIndex(chunk->GetMemoryTypeIndex());
+    heapUsages_[heapIndex] -= std::min(heapUsages_[heapIndex], chunk->GetSize());
+
+    RemoveFromListIf(
+        chunkLists_[chunk->GetMemoryTypeIndex()],
+        [chunk](std::unique_ptr<VKDeviceMemory>& entry)
+        {
+            return (entry.get() == chunk);
+        }
+    );
+}
+
+void VKDeviceMemoryManager::ReleaseEmptyChunks(std::uint32_t heapIndex, std::uint64_t maxSubmission)
+{
+    for (auto it = emptyChunks_.begin(); it != emptyChunks_.end();)
+    {
+        auto chunk = it->chunk;
+        if (it->submission <= maxSubmission && (heapIndex == ~0u || GetHeapIndex(chunk->GetMemoryTypeIndex()) == heapIndex))
+        {
+            it = emptyChunks_.erase(it);
+            ReleaseChunk(chunk);
+        }
+        else
+            ++it;
+    }
+}
+
+void VKDeviceMemoryManager::RemoveEmptyChunk(VKDeviceMemory* chunk)
+{
+    RemoveFromListIf(
+        emptyChunks_,
+        [chunk](const EmptyChunk& entry)
+        {
+            return (entry.chunk == chunk);
+        }
+    );
+}
+
+bool VKDeviceMemoryManager::ExceedsBudget(std::uint32_t heapIndex, VkDeviceSize size) const
+{
+    return (hasBudget_ && heapUsages_[heapIndex] + size > heapBudgets_[heapIndex]);
+}
+
+void VKDeviceMemoryManager::UpdateBudget()
+{
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budget;
+    if (physicalDevice_.QueryMemoryBudget(budget))
+    {
+        hasBudget_ = true;
+        for (std::uint32_t i = 0; i < memoryProperties_.memoryHeapCount; ++i)
+        {
+            heapBudgets_[i] = budget.heapBudget[i];
+            heapUsages_[i]  = budget.heapUsage[i];
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -1,5 +1,5 @@
 /*
- * VKDeviceMemory.h
+ * VKDeviceMemoryManager.h
  * 
  * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
  * See "LICENSE.txt" for license information.
@@ -14,6 +14,7 @@
 #include "../VKPtr.h"
 #include "VKDeviceMemory.h"
 #include "VKDeviceMemoryRegion.h"
+#include <LLGL/RenderSystemFlags.h>
 #include <vector>
 #include <memory>
 
@@ -22,11 +23,15 @@ namespace LLGL
 {
 
 
+class VKPhysicalDevice;
+
 /*
 Vulkan device memory manager. Memory allocations are stored in a small hierarchy:
  - Chunk: denotes a single Vulkan memory allocation of type VkDeviceMemory
  - Block: denotes one of multiple regions inside a chunk of type VkBuffer
  - Region: denotes a sub-range inside a block and holds a reference to the VkBuffer and its offset and size (both of type VkDeviceSize).
+Chunks are kept in one list per memory type, which is ordered by the maximal allocation size of each chunk,
+so the best fitting chunk is found by a binary search. Empty chunks are released after a grace period of queue submissions (see NextSubmission).
 */
 class VKDeviceMemoryManager
 {
@@ -35,9 +40,10 @@ class VKDeviceMemoryManager
 
         VKDeviceMemoryManager(
             const VKPtr<VkDevice>&                  device,
-            const VkPhysicalDeviceMemoryProperties& memoryProperties,
+            const VKPhysicalDevice&                 physicalDevice,
             VkDeviceSize                            minAllocationSize,
-            bool                                    reduceFragmentation
+            bool                                    reduceFragmentation,
+            bool                                    useTLSF             = false
         );
 
         VKDeviceMemoryManager(const VKDeviceMemoryManager&) = delete;
@@ -57,44 +63,97 @@ class VKDeviceMemoryManager
             VkMemoryPropertyFlags       properties
         );
 
+        // Allocates a block within the specified chunk and restores the order of its chunk list. Returns null on failure.
+        VKDeviceMemoryRegion* AllocateInChunk(VKDeviceMemory* chunk, VkDeviceSize size, VkDeviceSize alignment);
+
         // Releases the specified device memory block.
         void Release(VKDeviceMemoryRegion* region);
 
         // Queries the memory details of all chunks.
         VKDeviceMemoryDetails QueryDetails() const;
 
+        // Queries the memory statistics of all chunks and the memory budget (if supported).
+        void QueryStatistics(MemoryStatistics& stats);
+
+        // Advances the submission counter, updates the memory budget, and releases all empty chunks whose grace period has expired. Called on each queue submission.
+        void NextSubmission();
+
         #ifdef LLGL_DEBUG
 
         void PrintBlocks(std::ostream& s, const std::string& title = "") const;
 
         #endif
 
+        // Returns the list of all chunks with the specified memory type.
+        inline const std::vector<std::unique_ptr<VKDeviceMemory>>& GetChunks(std::uint32_t memoryTypeIndex) const
+        {
+            return chunkLists_[memoryTypeIndex];
+        }
+
         // Returns the VkDevice object used for this device memory manager.
         inline VkDevice GetVkDevice() const
         {
             return device_;
         }
 
+    private:
+
+        // List of chunks of the same memory type, ordered by their maximal allocation size in ascending order.
+        using ChunkList = std::vector<std::unique_ptr<VKDeviceMemory>>;
+
+        // Chunk that has become empty after the specified queue submission.
+        struct EmptyChunk
+        {
+            VKDeviceMemory* chunk;
+            std::uint64_t   submission;
+        };
+
     private:
 
         // Finds a memory type index for the specified attributes.
         std::uint32_t FindMemoryType(std::uint32_t memoryTypeBits, VkMemoryPropertyFlags properties) const;
 
+        // Returns the memory heap index of the specified memory type.
+        std::uint32_t GetHeapIndex(std::uint32_t memoryTypeIndex) const;
+
         // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
         VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
 
-        // Finds a suitable device memory chunk or allocates a new one.
+        // Finds the best fitting device memory chunk or allocates a new one.
         VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
 
+        // Releases the specified chunk to the driver and removes it from its chunk list.
+        void ReleaseChunk(VKDeviceMemory* chunk);
+
+        // Releases all empty chunks on the specified memory heap (or on all heaps if 'heapIndex' is ~0u) that have been empty since the specified submission or earlier.
+        void ReleaseEmptyChunks(std::uint32_t heapIndex, std::uint64_t maxSubmission);
+
+        // Removes the specified chunk from the list of empty chunks.
+        void RemoveEmptyChunk(VKDeviceMemory* chunk);
+
+        // Returns true if allocating the specified size on the specified heap would exceed the memory budget.
+        bool ExceedsBudget(std::uint32_t heapIndex, VkDeviceSize size) const;
+
+        // Updates the memory budget of all heaps if "VK_EXT_memory_budget" is available.
+        void UpdateBudget();
+
     private:
 
         const VKPtr<VkDevice>&                          device_;
+        const VKPhysicalDevice&                         physicalDevice_;
         VkPhysicalDeviceMemoryProperties                memoryProperties_;
 
         VkDeviceSize                                    minAllocationSize_      = 1024*1024;
         bool                                            reduceFragmentation_    = false;
+        bool                                            useTLSF_                = false;
+
+        ChunkList                                       chunkLists_[VK_MAX_MEMORY_TYPES];
+        std::vector<EmptyChunk>                         emptyChunks_;
+        std::uint64_t                                   submission_             = 0;
 
-        std::vector<std::unique_ptr<VKDeviceMemory>>    chunks_;
+        bool                                            hasBudget_                              = false;
+        VkDeviceSize                                    heapBudgets_[VK_MAX_MEMORY_HEAPS]       = {};
+        VkDeviceSize                                    heapUsages_[VK_MAX_MEMORY_HEAPS]        = {};
 
 };
 
@@ -79,6 +79,7 @@ class VKDeviceMemoryRegion
         VkDeviceSize    size_               = 0;
         VkDeviceSize    offset_             = 0;
         std::uint32_t   memoryTypeIndex_    = 0;
+        std::uint32_t   allocatorBlock_     = ~0u;  // Block ID within the TLSF allocator of the parent chunk (if used).
 
 };
 
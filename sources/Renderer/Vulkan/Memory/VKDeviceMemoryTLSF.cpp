@@ -0,0 +1,382 @@
+/*
+ * VKDeviceMemoryTLSF.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDeviceMemoryTLSF.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Returns the index of the least significant bit that is set. The input must not be zero.
+static std::uint32_t FindLSB(std::uint32_t bits)
+{
+    #if defined _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward(&index, bits);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__
+    return static_cast<std::uint32_t>(__builtin_ctz(bits));
+    #else
+    std::uint32_t index = 0;
+    while ((bits & 1u) == 0)
+    {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+    #endif
+}
+
+// Returns the index of the most significant bit that is set. The input must not be zero.
+static std::uint32_t FindMSB(std::uint64_t bits)
+{
+    #if defined _MSC_VER && defined _WIN64
+    unsigned long index = 0;
+    _BitScanReverse64(&index, bits);
+    return static_cast<std::uint32_t>(index);
+    #elif defined __GNUC__
+    return static_cast<std::uint32_t>(63 - __builtin_clzll(bits));
+    #else
+    std::uint32_t index = 0;
+    while (bits > 1)
+    {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+    #endif
+}
+
+static std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment)
+{
+    return ((value + alignment - 1) & ~(alignment - 1));
+}
+
+
+/*
+ * VKDeviceMemoryTLSF class
+ */
+
+const VKDeviceMemoryTLSF::BlockID   VKDeviceMemoryTLSF::invalidBlock;
+const std::uint64_t                 VKDeviceMemoryTLSF::granularity;
+
+// Size of the smallest first-level bin; all smaller sizes are mapped linearly into the first bin.
+static const std::uint32_t          g_smallSizeLog2 = 9;
+
+VKDeviceMemoryTLSF::VKDeviceMemoryTLSF(std::uint64_t size) :
+    size_ { size & ~(granularity - 1) }
+{
+    for (auto& freeList : freeLists_)
+        std::fill(std::begin(freeList), std::end(freeList), invalidBlock);
+
+    /* Initialize a single free block that covers the entire range */
+    if (size_ > 0)
+    {
+        firstBlock_ = MakeBlock(0, size_);
+        InsertFreeBlock(firstBlock_);
+    }
+}
+
+/*
+Finds a free block that is large enough for the size plus the worst-case alignment padding,
+so the first block of the respective bin can always be used without iterating the free list.
+If there is no such block, the exact size is tried once more, which succeeds for blocks that are already aligned (e.g. a new chunk).
+*/
+VKDeviceMemoryTLSF::BlockID VKDeviceMemoryTLSF::Allocate(std::uint64_t size, std::uint64_t alignment)
+{
+    if (size == 0)
+        return invalidBlock;
+
+    const auto alignedSize  = AlignUp(size, granularity);
+    const auto padding      = (alignment > granularity ? alignment - granularity : 0);
+
+    auto block = FindFreeBlock(alignedSize + padding);
+    if (block == invalidBlock && padding > 0)
+    {
+        block = FindFreeBlock(alignedSize);
+        if (block == invalidBlock || AlignUp(blocks_[block].offset, alignment) != blocks_[block].offset)
+            return invalidBlock;
+    }
+
+    if (block == invalidBlock)
+        return invalidBlock;
+
+    RemoveFreeBlock(block);
+
+    /* Split off the lower part if the block's offset does not match the alignment */
+    if (alignment > granularity)
+    {
+        const auto alignedOffset = AlignUp(blocks_[block].offset, alignment);
+        if (alignedOffset > blocks_[block].offset)
+        {
+            auto upper = SplitBlock(block, alignedOffset - blocks_[block].offset);
+            InsertFreeBlock(block);
+            block = upper;
+        }
+    }
+
+    /* Split off the upper part that is not required */
+    if (blocks_[block].size > alignedSize)
+        InsertFreeBlock(SplitBlock(block, alignedSize));
+
+    ++numAllocatedBlocks_;
+
+    return block;
+}
+
+void VKDeviceMemoryTLSF::Release(BlockID block)
+{
+    if (block >= blocks_.size() || blocks_[block].free)
+        return;
+
+    --numAllocatedBlocks_;
+
+    /* Merge with lower physical neighbor */
+    const auto prev = blocks_[block].prevPhys;
+    if (prev != invalidBlock && blocks_[prev].free)
+    {
+        RemoveFreeBlock(prev);
+        MergeBlocks(prev, block);
+        block = prev;
+    }
+
+    /* Merge with upper physical neighbor */
+    const auto next = blocks_[block].nextPhys;
+    if (next != invalidBlock && blocks_[next].free)
+    {
+        RemoveFreeBlock(next);
+        MergeBlocks(block, next);
+    }
+
+    InsertFreeBlock(block);
+}
+
+std::uint64_t VKDeviceMemoryTLSF::GetMaxAllocationSize() const
+{
+    if (flBitmap_ == 0)
+        return 0;
+
+    /* Any size that is mapped to a bin at or below the smallest size of the largest non-empty bin will succeed */
+    const auto fl = FindMSB(flBitmap_);
+    const auto sl = FindMSB(slBitmaps_[fl]);
+    return GetBinSize(fl, sl);
+}
+
+void VKDeviceMemoryTLSF::AccumDetails(VKDeviceMemoryTLSFDetails& details) const
+{
+    for (auto block = firstBlock_; block != invalidBlock; block = blocks_[block].nextPhys)
+    {
+        const auto& entry = blocks_[block];
+        if (entry.free)
+        {
+            details.numFreeBlocks++;
+            details.largestFreeBlock = std::max(details.largestFreeBlock, entry.size);
+        }
+        else
+        {
+            details.numAllocatedBlocks++;
+            details.allocatedSize += entry.size;
+        }
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool VKDeviceMemoryTLSF::MapInsert(std::uint64_t size, std::uint32_t& fl, std::uint32_t& sl)
+{
+    if (size < (1ull << g_smallSizeLog2))
+    {
+        /* Map small sizes linearly into the first bin */
+        fl = 0;
+        sl = static_cast<std::uint32_t>(size / granularity);
+    }
+    else
+    {
+        /* Map first level to power of two and second level to linear subdivision */
+        const auto msb = FindMSB(size);
+        fl = msb - g_smallSizeLog2 + 1;
+        sl = static_cast<std::uint32_t>(size >> (msb - g_slCountLog2)) ^ g_slCount;
+    }
+    return (fl < g_flCount);
+}
+
+bool VKDeviceMemoryTLSF::MapSearch(std::uint64_t size, std::uint32_t& fl, std::uint32_t& sl)
+{
+    if (size >= (1ull << g_smallSizeLog2))
+        size += (1ull << (FindMSB(size) - g_slCountLog2)) - 1;
+    return MapInsert(size, fl, sl);
+}
+
+std::uint64_t VKDeviceMemoryTLSF::GetBinSize(std::uint32_t fl, std::uint32_t sl)
+{
+    if (fl == 0)
+        return sl * granularity;
+
+    const auto msb = fl + g_smallSizeLog2 - 1;
+    return (1ull << msb) + (static_cast<std::uint64_t>(sl) << (msb - g_slCountLog2));
+}
+
+VKDeviceMemoryTLSF::BlockID VKDeviceMemoryTLSF::MakeBlock(std::uint64_t offset, std::uint64_t size)
+{
+    BlockID block;
+
+    /* Reuse block descriptor from the pool or append a new one */
+    if (!freeBlockIDs_.empty())
+    {
+        block = freeBlockIDs_.back();
+        freeBlockIDs_.pop_back();
+        blocks_[block] = Block{};
+    }
+    else
+    {
+        block = static_cast<BlockID>(blocks_.size());
+        blocks_.emplace_back();
+    }
+
+    blocks_[block].offset   = offset;
+    blocks_[block].size     = size;
+
+    return block;
+}
+
+void VKDeviceMemoryTLSF::FreeBlock(BlockID block)
+{
+    freeBlockIDs_.push_back(block);
+}
+
+VKDeviceMemoryTLSF::BlockID VKDeviceMemoryTLSF::FindFreeBlock(std::uint64_t size) const
+{
+    std::uint32_t fl = 0, sl = 0;
+    if (!MapSearch(size, fl, sl))
+        return invalidBlock;
+
+    /* Search second-level bins of the same first level that are at least as large */
+    auto slMap = slBitmaps_[fl] & (~0u << sl);
+    if (slMap == 0)
+    {
+        /* Search next non-empty first-level bin */
+        if (fl + 1 >= g_flCount)
+            return invalidBlock;
+
+        const auto flMap = flBitmap_ & (~0u << (fl + 1));
+        if (flMap == 0)
+            return invalidBlock;
+
+        fl      = FindLSB(flMap);
+        slMap   = slBitmaps_[fl];
+    }
+
+    sl = FindLSB(slMap);
+
+    return freeLists_[fl][sl];
+}
+
+void VKDeviceMemoryTLSF::InsertFreeBlock(BlockID block)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MapInsert(blocks_[block].size, fl, sl);
+
+    /* Insert block at the front of its free list */
+    auto& head = freeLists_[fl][sl];
+    auto& entry = blocks_[block];
+    {
+        entry.free      = true;
+        entry.prevFree  = invalidBlock;
+        entry.nextFree  = head;
+    }
+    if (head != invalidBlock)
+        blocks_[head].prevFree = block;
+    head = block;
+
+    flBitmap_       |= (1u << fl);
+    slBitmaps_[fl]  |= (1u << sl);
+}
+
+void VKDeviceMemoryTLSF::RemoveFreeBlock(BlockID block)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MapInsert(blocks_[block].size, fl, sl);
+
+    auto& entry = blocks_[block];
+
+    /* Unlink block from its free list */
+    if (entry.prevFree != invalidBlock)
+        blocks_[entry.prevFree].nextFree = entry.nextFree;
+    else
+        freeLists_[fl][sl] = entry.nextFree;
+
+    if (entry.nextFree != invalidBlock)
+        blocks_[entry.nextFree].prevFree = entry.prevFree;
+
+    entry.free      = false;
+    entry.prevFree  = invalidBlock;
+    entry.nextFree  = invalidBlock;
+
+    /* Clear bitmaps if the free list has become empty */
+    if (freeLists_[fl][sl] == invalidBlock)
+    {
+        slBitmaps_[fl] &= ~(1u << sl);
+        if (slBitmaps_[fl] == 0)
+            flBitmap_ &= ~(1u << fl);
+    }
+}
+
+VKDeviceMemoryTLSF::BlockID VKDeviceMemoryTLSF::SplitBlock(BlockID block, std::uint64_t size)
+{
+    /* Make new upper block (this might reallocate the block container) */
+    auto upper = MakeBlock(blocks_[block].offset + size, blocks_[block].size - size);
+
+    auto& lowerEntry = blocks_[block];
+    auto& upperEntry = blocks_[upper];
+
+    /* Link upper block into physical block list */
+    upperEntry.prevPhys = block;
+    upperEntry.nextPhys = lowerEntry.nextPhys;
+
+    if (lowerEntry.nextPhys != invalidBlock)
+        blocks_[lowerEntry.nextPhys].prevPhys = upper;
+
+    lowerEntry.nextPhys = upper;
+    lowerEntry.size     = size;
+
+    return upper;
+}
+
+void VKDeviceMemoryTLSF::MergeBlocks(BlockID lower, BlockID upper)
+{
+    auto& lowerEntry = blocks_[lower];
+    auto& upperEntry = blocks_[upper];
+
+    /* Unlink upper block from physical block list */
+    lowerEntry.size     += upperEntry.size;
+    lowerEntry.nextPhys = upperEntry.nextPhys;
+
+    if (upperEntry.nextPhys != invalidBlock)
+        blocks_[upperEntry.nextPhys].prevPhys = lower;
+
+    FreeBlock(upper);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,181 @@
+/*
+ * VKDeviceMemoryTLSF.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DEVICE_MEMORY_TLSF_H
+#define LLGL_VK_DEVICE_MEMORY_TLSF_H
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+// Details structure of VKDeviceMemoryTLSF for debugging.
+struct VKDeviceMemoryTLSFDetails
+{
+    std::size_t     numAllocatedBlocks  = 0;
+    std::size_t     numFreeBlocks       = 0;
+    std::uint64_t   allocatedSize       = 0;
+    std::uint64_t   largestFreeBlock    = 0;
+};
+
+/*
+Two-level segregated fit (TLSF) sub-allocator for a single device memory chunk.
+This class only manages offsets and sizes and is independent of the Vulkan API.
+Free blocks are kept in size-class bins (first level: power of two, second level: linear subdivision),
+which are found via two bitmaps, so allocation and release are both performed in O(1).
+Neighboring free blocks are merged immediately on release via the physical block links.
+Block descriptors are pooled and referred to by their index, so no heap allocation occurs after warm-up.
+*/
+class VKDeviceMemoryTLSF
+{
+
+    public:
+
+        // Block identifier type; the invalid block is denoted by VKDeviceMemoryTLSF::invalidBlock.
+        using BlockID = std::uint32_t;
+
+        static const BlockID invalidBlock = ~0u;
+
+        // Minimal block size and granularity of all offsets and sizes.
+        static const std::uint64_t granularity = 16;
+
+    public:
+
+        VKDeviceMemoryTLSF(std::uint64_t size);
+
+        // Allocates a new block of the specified size and alignment. Returns invalidBlock if there is no suitable free block.
+        BlockID Allocate(std::uint64_t size, std::uint64_t alignment);
+
+        // Releases the specified block and merges it with its neighboring free blocks.
+        void Release(BlockID block);
+
+        // Returns the largest size that is guaranteed to be allocatable with an alignment of up to the granularity.
+        std::uint64_t GetMaxAllocationSize() const;
+
+        // Accumulates the details of this allocator into the output structure.
+        void AccumDetails(VKDeviceMemoryTLSFDetails& details) const;
+
+        // Returns the offset of the specified block.
+        inline std::uint64_t GetOffset(BlockID block) const
+        {
+            return blocks_[block].offset;
+        }
+
+        // Returns the size of the specified block.
+        inline std::uint64_t GetSize(BlockID block) const
+        {
+            return blocks_[block].size;
+        }
+
+        // Returns true if the specified block is currently free.
+        inline bool IsFree(BlockID block) const
+        {
+            return blocks_[block].free;
+        }
+
+        // Returns the first block in physical order, i.e. the block at offset 0.
+        inline BlockID GetFirstBlock() const
+        {
+            return firstBlock_;
+        }
+
+        // Returns the physical successor of the specified block or invalidBlock.
+        inline BlockID GetNextBlock(BlockID block) const
+        {
+            return blocks_[block].nextPhys;
+        }
+
+        // Returns true if no blocks are allocated.
+        inline bool IsEmpty() const
+        {
+            return (numAllocatedBlocks_ == 0);
+        }
+
+        // Returns the entire size that is managed by this allocator.
+        inline std::uint64_t GetSize() const
+        {
+            return size_;
+        }
+
+    private:
+
+        // Number of first-level bins (power-of-two size classes) and second-level bins (linear subdivisions).
+        static const std::uint32_t g_flCount        = 32;
+        static const std::uint32_t g_slCountLog2    = 5;
+        static const std::uint32_t g_slCount        = (1u << g_slCountLog2);
+
+        struct Block
+        {
+            std::uint64_t   offset      = 0;
+            std::uint64_t   size        = 0;
+            BlockID         prevPhys    = invalidBlock;
+            BlockID         nextPhys    = invalidBlock;
+            BlockID         prevFree    = invalidBlock;
+            BlockID         nextFree    = invalidBlock;
+            bool            free        = false;
+        };
+
+    private:
+
+        // Maps the specified size to its first- and second-level bin index. Returns false if the size exceeds the largest bin.
+        static bool MapInsert(std::uint64_t size, std::uint32_t& fl, std::uint32_t& sl);
+
+        // Rounds up the specified size to the next bin and maps it to the bin index, so any block in this bin is large enough.
+        static bool MapSearch(std::uint64_t size, std::uint32_t& fl, std::uint32_t& sl);
+
+        // Returns the smallest size of the specified bin.
+        static std::uint64_t GetBinSize(std::uint32_t fl, std::uint32_t sl);
+
+        // Returns a new block descriptor from the pool.
+        BlockID MakeBlock(std::uint64_t offset, std::uint64_t size);
+
+        // Returns the specified block descriptor to the pool.
+        void FreeBlock(BlockID block);
+
+        // Finds a free block with at least the specified size, or returns invalidBlock.
+        BlockID FindFreeBlock(std::uint64_t size) const;
+
+        // Inserts the specified block into its free list.
+        void InsertFreeBlock(BlockID block);
+
+        // Removes the specified block from its free list.
+        void RemoveFreeBlock(BlockID block);
+
+        // Splits the specified block at the specified size and returns the new upper block.
+        BlockID SplitBlock(BlockID block, std::uint64_t size);
+
+        // Merges the upper block into the lower block and returns the upper block descriptor to the pool.
+        void MergeBlocks(BlockID lower, BlockID upper);
+
+    private:
+
+        std::uint64_t           size_                           = 0;
+        std::size_t             numAllocatedBlocks_             = 0;
+        BlockID                 firstBlock_                     = invalidBlock;
+
+        std::vector<Block>      blocks_;
+        std::vector<BlockID>    freeBlockIDs_;
+
+        std::uint32_t           flBitmap_                       = 0;
+        std::uint32_t           slBitmaps_[g_flCount]           = {};
+        BlockID                 freeLists_[g_flCount][g_slCount];
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,65 @@
+/*
+ * VKStagingRingAllocator.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKStagingRingAllocator.h"
+
+
+namespace LLGL
+{
+
+
+VKStagingRingAllocator::VKStagingRingAllocator(std::uint64_t capacity) :
+    capacity_ { capacity }
+{
+}
+
+bool VKStagingRingAllocator::Allocate(std::uint64_t size, std::uint64_t alignment, std::uint64_t& offset)
+{
+    if (capacity_ == 0 || size > capacity_)
+        return false;
+
+    /* Restart at the beginning of the ring if it is empty, so the entire capacity is available */
+    if (head_ == tail_ && head_ % capacity_ != 0)
+    {
+        head_ += capacity_ - head_ % capacity_;
+        tail_ = head_;
+    }
+
+    /* Align offset of the new range within the ring */
+    const auto headOffset   = head_ % capacity_;
+    auto alignedOffset      = (alignment > 1 ? ((headOffset + alignment - 1) / alignment) * alignment : headOffset);
+    auto position           = head_ + (alignedOffset - headOffset);
+
+    /* Skip the remaining space at the end of the ring if the range does not fit */
+    if (alignedOffset + size > capacity_)
+    {
+        position        = head_ + (capacity_ - headOffset);
+        alignedOffset   = 0;
+    }
+
+    /* Check if the range overlaps with the ranges that are still in use */
+    if (position + size - tail_ > capacity_)
+        return false;
+
+    head_   = position + size;
+    offset  = alignedOffset;
+
+    return true;
+}
+
+void VKStagingRingAllocator::Release(std::uint64_t position)
+{
+    if (position > tail_ && position <= head_)
+        tail_ = position;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
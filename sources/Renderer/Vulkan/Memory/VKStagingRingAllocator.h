@@ -0,0 +1,72 @@
+/*
+ * VKStagingRingAllocator.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_STAGING_RING_ALLOCATOR_H
+#define LLGL_VK_STAGING_RING_ALLOCATOR_H
+
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Ring allocator for the ranges of the staging ring buffer and is independent of the Vulkan API.
+Ranges are allocated at the head and released in allocation order at the tail. Head and tail are monotonic positions,
+so an empty ring can be distinguished from a full one; the offset of a range within the ring is its position modulo the capacity.
+A range that does not fit between the head and the end of the ring is placed at the beginning, and the remaining space at the end is skipped.
+*/
+class VKStagingRingAllocator
+{
+
+    public:
+
+        VKStagingRingAllocator(std::uint64_t capacity);
+
+        // Allocates a range of the specified size and alignment, and returns false if there is not enough free space left.
+        bool Allocate(std::uint64_t size, std::uint64_t alignment, std::uint64_t& offset);
+
+        // Releases all ranges that were allocated before the specified head position. Positions must be released in ascending order.
+        void Release(std::uint64_t position);
+
+        // Returns the capacity of the ring.
+        inline std::uint64_t GetCapacity() const
+        {
+            return capacity_;
+        }
+
+        // Returns the monotonic position after the last allocated range. This can be passed to Release once all previous ranges are no longer in use.
+        inline std::uint64_t GetHead() const
+        {
+            return head_;
+        }
+
+        // Returns the number of bytes that are currently in use, including the skipped space at the end of the ring.
+        inline std::uint64_t GetUsedSize() const
+        {
+            return (head_ - tail_);
+        }
+
+    private:
+
+        std::uint64_t capacity_ = 0;
+        std::uint64_t head_     = 0;
+        std::uint64_t tail_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -26,7 +26,8 @@ class VKComputePSO final : public VKPipelineState
         VKComputePSO(
             const VKPtr<VkDevice>&              device,
             const ComputePipelineDescriptor&    desc,
-            VkPipelineLayout                    defaultPipelineLayout
+            VkPipelineLayout                    defaultPipelineLayout,
+            VkPipelineCache                     pipelineCache
         );
 
     private:
@@ -34,7 +35,8 @@ class VKComputePSO final : public VKPipelineState
         void CreateVkPipeline(
             VkDevice                            device,
             VkPipelineLayout                    pipelineLayout,
-            const ComputePipelineDescriptor&    desc
+            const ComputePipelineDescriptor&    desc,
+            VkPipelineCache                     pipelineCache
         );
 
 };
@@ -27,7 +27,8 @@ VKGraphicsPSO::VKGraphicsPSO(
     VkPipelineLayout                    defaultPipelineLayout,
     const RenderPass*                   defaultRenderPass,
     const GraphicsPipelineDescriptor&   desc,
-    const VKGraphicsPipelineLimits&     limits)
+    const VKGraphicsPipelineLimits&     limits,
+    VkPipelineCache                     pipelineCache)
 :
     VKPipelineState    { device, VK_PIPELINE_BIND_POINT_GRAPHICS },
     scissorEnabled_    { desc.rasterizer.scissorTestEnabled      },
@@ -42,7 +43,8 @@ VKGraphicsPSO::VKGraphicsPSO(
             GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout),
             *renderPassVK,
             limits,
-            desc
+            desc,
+            pipelineCache
         );
     }
     else
@@ -305,7 +307,8 @@ void VKGraphicsPSO::CreateVkPipeline(
     VkPipelineLayout                    pipelineLayout,
     const VKRenderPass&                 renderPass,
     const VKGraphicsPipelineLimits&     limits,
-    const GraphicsPipelineDescriptor&   desc)
+    const GraphicsPipelineDescriptor&   desc,
+    VkPipelineCache                     pipelineCache)
 {
     /* Get shader program object */
     auto shaderProgramVK = LLGL_CAST(const VKShaderProgram*, desc.shaderProgram);
@@ -382,7 +385,7 @@ void VKGraphicsPSO::CreateVkPipeline(
         createInfo.basePipelineHandle           = VK_NULL_HANDLE;
         createInfo.basePipelineIndex            = 0;
     }
-    auto result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, GetVkPipelineAddress());
+    auto result = vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, GetVkPipelineAddress());
     VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
 }
 
@@ -0,0 +1,200 @@
+/*
+ * VKPipelineCache.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKPipelineCache.h"
+#include "../VKCore.h"
+#include "../VKSerialization.h"
+#include <LLGL/Log.h>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Size (in bytes) of the header at the beginning of the data from 'vkGetPipelineCacheData' (VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+static const std::size_t g_vkCacheHeaderSize = (sizeof(std::uint32_t) * 4 + VK_UUID_SIZE);
+
+VKPipelineCache::VKPipelineCache(const VKPtr<VkDevice>& device, const VkPhysicalDeviceProperties& properties) :
+    device_ { device                         },
+    cache_  { device, vkDestroyPipelineCache }
+{
+    /* Store identity of physical device and driver */
+    header_.vendorID        = properties.vendorID;
+    header_.deviceID        = properties.deviceID;
+    header_.driverVersion   = properties.driverVersion;
+    ::memcpy(header_.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    /* Create empty pipeline cache */
+    VkPipelineCacheCreateInfo createInfo;
+    {
+        createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext            = nullptr;
+        createInfo.flags            = 0;
+        createInfo.initialDataSize  = 0;
+        createInfo.pInitialData     = nullptr;
+    }
+    auto result = vkCreatePipelineCache(device, &createInfo, nullptr, cache_.ReleaseAndGetAddressOf());
+    VKThrowIfCreateFailed(result, "VkPipelineCache");
+}
+
+void VKPipelineCache::Serialize(Serialization::Serializer& writer)
+{
+    /* Query size of pipeline cache data */
+    std::size_t dataSize = 0;
+    auto result = vkGetPipelineCacheData(device_, cache_, &dataSize, nullptr);
+    VKThrowIfFailed(result, "failed to query size of Vulkan pipeline cache data");
+
+    /* Write device header */
+    writer.WriteSegment(Serialization::VKIdent_PipelineCacheHeader, &header_, sizeof(header_));
+
+    /* Retrieve pipeline cache data, then write it into its serialization segment */
+    std::vector<std::int8_t> data(dataSize);
+    if (dataSize > 0)
+    {
+        result = vkGetPipelineCacheData(device_, cache_, &dataSize, data.data());
+        VKThrowIfFailed(result, "failed to retrieve Vulkan pipeline cache data");
+    }
+    writer.WriteSegment(Serialization::VKIdent_PipelineCacheData, data.data(), dataSize);
+}
+
+bool VKPipelineCache::Deserialize(const Blob& blob)
+{
+    try
+    {
+        /* Each segment is validated against the remaining bytes of the blob before it is read */
+        Serialization::Deserializer reader{ blob };
+
+        /* Reject caches from other devices or drivers */
+        VKPipelineCacheHeader header;
+        reader.ReadSegment(Serialization::VKIdent_PipelineCacheHeader, &header, sizeof(header));
+
+        if (header.vendorID         != header_.vendorID         ||
+            header.deviceID         != header_.deviceID         ||
+            header.driverVersion    != header_.driverVersion    ||
+            ::memcmp(header.pipelineCacheUUID, header_.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            return false;
+        }
+
+        /* Validate header of the pipeline cache data before it's passed to the driver */
+        auto seg = reader.ReadSegment(Serialization::VKIdent_PipelineCacheData);
+        if (!IsCompatibleCacheData(seg.data, seg.size))
+            return false;
+
+        MergeCacheData(seg.data, seg.size);
+    }
+    catch (const std::exception&)
+    {
+        /* Malformed or truncated serialization segments */
+        return false;
+    }
+
+    return true;
+}
+
+bool VKPipelineCache::LoadFromFile(const std::string& filename)
+{
+    if (auto blob = Blob::CreateFromFile(filename))
+    {
+        if (Deserialize(*blob))
+            return true;
+        Log::PostReport(Log::ReportType::Warning, "ignored incompatible or corrupted Vulkan pipeline cache: " + filename);
+    }
+    return false;
+}
+
+bool VKPipelineCache::SaveToFile(const std::string& filename)
+{
+    /* Serialize pipeline cache; errors are only reported by the return value, since this is called on shutdown */
+    Serialization::Serializer writer;
+    try
+    {
+        Serialize(writer);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+
+    if (auto blob = writer.Finalize())
+    {
+        std::ofstream file{ filename, std::ios::out | std::ios::binary };
+        if (file.good())
+        {
+            file.write(reinterpret_cast<const char*>(blob->GetData()), static_cast<std::streamsize>(blob->GetSize()));
+            return file.good();
+        }
+    }
+
+    return false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool VKPipelineCache::IsCompatibleCacheData(const void* data, std::size_t size) const
+{
+    /* An empty cache is always compatible */
+    if (size == 0)
+        return true;
+    if (size < g_vkCacheHeaderSize)
+        return false;
+
+    /* Read header fields (VK_PIPELINE_CACHE_HEADER_VERSION_ONE) */
+    std::uint32_t headerFields[4];
+    ::memcpy(headerFields, data, sizeof(headerFields));
+
+    const auto uuid = reinterpret_cast<const std::uint8_t*>(data) + sizeof(headerFields);
+
+    return
+    (
+        headerFields[0] >= g_vkCacheHeaderSize &&
+        headerFields[0] <= size &&
+        headerFields[1] == static_cast<std::uint32_t>(VK_PIPELINE_CACHE_HEADER_VERSION_ONE) &&
+        headerFields[2] == header_.vendorID &&
+        headerFields[3] == header_.deviceID &&
+        ::memcmp(uuid, header_.pipelineCacheUUID, VK_UUID_SIZE) == 0
+    );
+}
+
+void VKPipelineCache::MergeCacheData(const void* data, std::size_t size)
+{
+    if (size == 0)
+        return;
+
+    /* Create temporary pipeline cache with the initial data and merge it into the device-wide cache */
+    VKPtr<VkPipelineCache> srcCache{ device_, vkDestroyPipelineCache };
+    {
+        VkPipelineCacheCreateInfo createInfo;
+        {
+            createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+            createInfo.pNext            = nullptr;
+            createInfo.flags            = 0;
+            createInfo.initialDataSize  = size;
+            createInfo.pInitialData     = data;
+        }
+        auto result = vkCreatePipelineCache(device_, &createInfo, nullptr, srcCache.ReleaseAndGetAddressOf());
+        VKThrowIfCreateFailed(result, "VkPipelineCache");
+    }
+
+    VkPipelineCache srcCaches[] = { srcCache.Get() };
+    auto result = vkMergePipelineCaches(device_, cache_, 1, srcCaches);
+    VKThrowIfFailed(result, "failed to merge Vulkan pipeline caches");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,95 @@
+/*
+ * VKPipelineCache.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_PIPELINE_CACHE_H
+#define LLGL_VK_PIPELINE_CACHE_H
+
+
+#include <LLGL/Blob.h>
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include "../../Serialization.h"
+#include <cstdint>
+#include <string>
+
+
+namespace LLGL
+{
+
+
+/*
+Device-wide Vulkan pipeline cache that is used for all graphics and compute PSOs of a render system.
+The serialized form stores the vendor ID, device ID, driver version, and pipeline cache UUID of the physical device,
+so a cache that was created on a different device or driver is rejected instead of being passed to the driver.
+*/
+class VKPipelineCache
+{
+
+    public:
+
+        VKPipelineCache(const VKPtr<VkDevice>& device, const VkPhysicalDeviceProperties& properties);
+
+        VKPipelineCache(const VKPipelineCache&) = delete;
+        VKPipelineCache& operator = (const VKPipelineCache&) = delete;
+
+        // Writes the device header and the current content of this pipeline cache as serialized segments.
+        void Serialize(Serialization::Serializer& writer);
+
+        /*
+        Merges the serialized pipeline cache into this cache.
+        Returns false if the serialized cache was created on a different device or driver, or if it's malformed.
+        */
+        bool Deserialize(const Blob& blob);
+
+        // Loads and merges the serialized pipeline cache from the specified file. Returns false if the file could not be read or is incompatible.
+        bool LoadFromFile(const std::string& filename);
+
+        // Stores this pipeline cache in serialized form to the specified file. Returns false if the file could not be written.
+        bool SaveToFile(const std::string& filename);
+
+        // Returns the native VkPipelineCache object.
+        inline VkPipelineCache GetVkPipelineCache() const
+        {
+            return cache_.Get();
+        }
+
+    private:
+
+        // Header of the serialized pipeline cache to identify the physical device and driver.
+        struct VKPipelineCacheHeader
+        {
+            std::uint32_t   vendorID;
+            std::uint32_t   deviceID;
+            std::uint32_t   driverVersion;
+            std::uint8_t    pipelineCacheUUID[VK_UUID_SIZE];
+        };
+
+    private:
+
+        // Returns true if the specified Vulkan pipeline cache data starts with a header that matches this device.
+        bool IsCompatibleCacheData(const void* data, std::size_t size) const;
+
+        // Merges the specified Vulkan pipeline cache data into this cache.
+        void MergeCacheData(const void* data, std::size_t size);
+
+    private:
+
+        const VKPtr<VkDevice>&  device_;
+        VKPtr<VkPipelineCache>  cache_;
+        VKPipelineCacheHeader   header_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -310,6 +310,9 @@ void VKResourceHeap::FillWriteDescriptorForBuffer(
 {
     auto bufferVK = LLGL_CAST(VKBuffer*, rvDesc.resource);
 
+    /* Descriptor set refers to the VkBuffer handle, so the buffer must not be relocated */
+    bufferVK->Pin();
+
     /* Initialize buffer information */
     auto bufferInfo = container.NextBufferInfo();
     {
@@ -107,6 +107,18 @@ class VKTexture final : public Texture
             return imageWrapper_.GetMemoryRegion();
         }
 
+        // Stores the ID of the staging ring batch that last transferred data into or out of this texture.
+        inline void SetStagingBatchID(std::uint64_t id)
+        {
+            stagingBatchID_ = id;
+        }
+
+        // Returns the ID of the staging ring batch that last transferred data into or out of this texture, or 0 if there is none.
+        inline std::uint64_t GetStagingBatchID() const
+        {
+            return stagingBatchID_;
+        }
+
     private:
 
         void CreateImage(VkDevice device, const TextureDescriptor& desc);
@@ -120,6 +132,7 @@ class VKTexture final : public Texture
         VkExtent3D          extent_;
         std::uint32_t       numMipLevels_   = 0;
         std::uint32_t       numArrayLayers_ = 0;
+        std::uint64_t       stagingBatchID_ = 0;
 
 };
 
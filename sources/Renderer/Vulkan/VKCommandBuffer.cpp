@@ -151,6 +151,7 @@ void VKCommandBuffer::UpdateBuffer(
     std::uint16_t   dataSize)
 {
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
+    PinBufferIfReusable(dstBufferVK);
 
     auto size   = static_cast<VkDeviceSize>(dataSize);
     auto offset = static_cast<VkDeviceSize>(dstOffset);
@@ -174,6 +175,8 @@ void VKCommandBuffer::CopyBuffer(
 {
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
     auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
+    PinBufferIfReusable(dstBufferVK);
+    PinBufferIfReusable(srcBufferVK);
 
     VkBufferCopy region;
     {
@@ -202,6 +205,7 @@ void VKCommandBuffer::CopyBufferFromTexture(
 {
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
     auto& srcTextureVK = LLGL_CAST(VKTexture&, srcTexture);
+    PinBufferIfReusable(dstBufferVK);
 
     VkBufferImageCopy region;
     {
@@ -233,6 +237,7 @@ void VKCommandBuffer::FillBuffer(
     std::uint64_t   fillSize)
 {
     auto& dstBufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
+    PinBufferIfReusable(dstBufferVK);
 
     /* Determine destination buffer range and ignore <dstOffset> if the whole buffer is meant to be filled */
     VkDeviceSize offset, size;
@@ -303,6 +308,7 @@ void VKCommandBuffer::CopyTextureFromBuffer(
 {
     auto& dstTextureVK = LLGL_CAST(VKTexture&, dstTexture);
     auto& srcBufferVK = LLGL_CAST(VKBuffer&, srcBuffer);
+    PinBufferIfReusable(srcBufferVK);
 
     VkBufferImageCopy region;
     {
@@ -573,6 +579,7 @@ void VKCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Attac
 void VKCommandBuffer::SetVertexBuffer(Buffer& buffer)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
 
     VkBuffer buffers[] = { bufferVK.GetVkBuffer() };
     VkDeviceSize offsets[] = { 0 };
@@ -595,12 +602,16 @@ void VKCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
 void VKCommandBuffer::SetIndexBuffer(Buffer& buffer)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
+
     vkCmdBindIndexBuffer(commandBuffer_, bufferVK.GetVkBuffer(), 0, bufferVK.GetIndexType());
 }
 
 void VKCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
+
     vkCmdBindIndexBuffer(commandBuffer_, bufferVK.GetVkBuffer(), offset, VKTypes::ToVkIndexType(format));
 }
 
@@ -903,6 +914,7 @@ void VKCommandBuffer::SetStreamOutputBuffer(Buffer& buffer)
     LLGL_ASSERT_VK_EXTENSION(VKExt::EXT_transform_feedback, VK_EXT_TRANSFORM_FEEDBACK_EXTENSION_NAME);
 
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
 
     VkBuffer buffers[] = { bufferVK.GetVkBuffer() };
     VkDeviceSize offsets[] = { 0 };
@@ -970,12 +982,16 @@ void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
+
     vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
+
     if (maxDrawIndirectCount_ < numCommands)
     {
         while (numCommands > 0)
@@ -993,12 +1009,16 @@ void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
+
     vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
+
     if (maxDrawIndirectCount_ < numCommands)
     {
         while (numCommands > 0)
@@ -1023,6 +1043,8 @@ void VKCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWo
 void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    PinBufferIfReusable(bufferVK);
+
     vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
 }
 
@@ -1223,6 +1245,16 @@ bool VKCommandBuffer::IsInsideRenderPass() const
     return (recordState_ == RecordState::InsideRenderPass);
 }
 
+void VKCommandBuffer::PinBufferIfReusable(VKBuffer& bufferVK)
+{
+    /*
+    Buffers must not be relocated by the device memory defragmenter once they are referenced by a multi-submit or deferred command buffer,
+    because resubmitting that command buffer would refer to the previous VkBuffer, which is destroyed after the move
+    */
+    if ((usageFlags_ & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) == 0)
+        bufferVK.Pin();
+}
+
 void VKCommandBuffer::AcquireNextBuffer()
 {
     commandBufferIndex_ = (commandBufferIndex_ + 1) % commandBufferList_.size();
@@ -26,6 +26,7 @@ class VKPhysicalDevice;
 class VKResourceHeap;
 class VKRenderPass;
 class VKQueryHeap;
+class VKBuffer;
 
 class VKCommandBuffer final : public CommandBuffer
 {
@@ -275,6 +276,9 @@ class VKCommandBuffer final : public CommandBuffer
 
         bool IsInsideRenderPass() const;
 
+        // Pins the specified buffer if this command buffer can be submitted more than once, since its VkBuffer handle is recorded into the native command buffer.
+        void PinBufferIfReusable(VKBuffer& bufferVK);
+
         void BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelineBindPoint bindingPoint, std::uint32_t firstSet);
 
         // Acquires the next native VkCommandBuffer object.
@@ -9,6 +9,8 @@
 #include "VKCommandBuffer.h"
 #include "RenderState/VKFence.h"
 #include "RenderState/VKQueryHeap.h"
+#include "Buffer/VKStagingRing.h"
+#include "Memory/VKDeviceMemoryManager.h"
 #include "../CheckedCast.h"
 #include "VKCore.h"
 
@@ -17,9 +19,16 @@ namespace LLGL
 {
 
 
-VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue) :
-    device_ { device },
-    native_ { queue  }
+VKCommandQueue::VKCommandQueue(
+    const VKPtr<VkDevice>&  device,
+    VkQueue                 queue,
+    VKDeviceMemoryManager&  deviceMemoryMngr,
+    VKStagingRing*          stagingRing)
+:
+    device_           { device           },
+    native_           { queue            },
+    deviceMemoryMngr_ { deviceMemoryMngr },
+    stagingRing_      { stagingRing      }
 {
 }
 
@@ -31,6 +40,10 @@ void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
 
     VkCommandBuffer commandBuffers[] = { commandBufferVK.GetVkCommandBuffer() };
 
+    /* Submit pending staging transfers first, so uploaded data is available to this command buffer */
+    if (stagingRing_ != nullptr)
+        stagingRing_->Flush();
+
     /* Submit command buffer to graphics queue */
     VkSubmitInfo submitInfo;
     {
@@ -46,6 +59,9 @@ void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
     }
     auto result = vkQueueSubmit(native_, 1, &submitInfo, commandBufferVK.GetQueueSubmitFence());
     VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
+
+    /* Release device memory chunks that have been empty for a while; counted per submission to also cover headless and compute-only applications */
+    deviceMemoryMngr_.NextSubmission();
 }
 
 /* ----- Queries ----- */
@@ -96,6 +112,11 @@ void VKCommandQueue::Submit(Fence& fence)
 {
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
     fenceVK.Reset(device_);
+
+    /* Submit pending staging transfers first, so the fence is signaled after their completion */
+    if (stagingRing_ != nullptr)
+        stagingRing_->Flush();
+
     vkQueueSubmit(native_, 0, nullptr, fenceVK.GetVkFence());
 }
 
@@ -107,6 +128,8 @@ bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 
 void VKCommandQueue::WaitIdle()
 {
+    if (stagingRing_ != nullptr)
+        stagingRing_->WaitIdle();
     vkQueueWaitIdle(native_);
 }
 
@@ -21,6 +21,8 @@ namespace LLGL
 
 
 class VKQueryHeap;
+class VKStagingRing;
+class VKDeviceMemoryManager;
 
 class VKCommandQueue final : public CommandQueue
 {
@@ -29,7 +31,12 @@ class VKCommandQueue final : public CommandQueue
 
         /* ----- Common ----- */
 
-        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue);
+        VKCommandQueue(
+            const VKPtr<VkDevice>&  device,
+            VkQueue                 queue,
+            VKDeviceMemoryManager&  deviceMemoryMngr,
+            VKStagingRing*          stagingRing = nullptr
+        );
 
         /* ----- Command Buffers ----- */
 
@@ -76,8 +83,10 @@ class VKCommandQueue final : public CommandQueue
 
     private:
 
-        VkDevice    device_;
-        VkQueue     native_ = VK_NULL_HANDLE;
+        VkDevice                device_;
+        VkQueue                 native_             = VK_NULL_HANDLE;
+        VKDeviceMemoryManager&  deviceMemoryMngr_;
+        VKStagingRing*          stagingRing_        = nullptr;
 
 };
 
@@ -97,7 +97,8 @@ class VKDevice
             VkFormat                    format,
             const VkOffset3D&           offset,
             const VkExtent3D&           extent,
-            const TextureSubresource&   subresource
+            const TextureSubresource&   subresource,
+            VkDeviceSize                bufferOffset = 0
         );
 
         void CopyBufferToImage(
@@ -115,7 +116,8 @@ class VKDevice
             VkFormat                    format,
             const VkOffset3D&           offset,
             const VkExtent3D&           extent,
-            const TextureSubresource&   subresource
+            const TextureSubresource&   subresource,
+            VkDeviceSize                bufferOffset = 0
         );
 
         void CopyImageToBuffer(
@@ -140,6 +140,7 @@ static std::initializer_list<Format> GetCompressedVKTextureFormatsS3TC()
         Format::BC3UNorm, Format::BC3UNorm_sRGB,
         Format::BC4UNorm, Format::BC4SNorm,
         Format::BC5UNorm, Format::BC5SNorm,
+        Format::BC7UNorm, Format::BC7UNorm_sRGB,
     };
 }
 
@@ -264,6 +265,25 @@ bool VKPhysicalDevice::SupportsExtension(const char* extension) const
     return (it != supportedExtensionNames_.end());
 }
 
+bool VKPhysicalDevice::QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& budget) const
+{
+    if (!HasExtension(VKExt::EXT_memory_budget) || !HasExtension(VKExt::KHR_get_physical_device_properties2))
+        return false;
+
+    /* Chain memory budget into memory properties query of extension "VK_KHR_get_physical_device_properties2" */
+    budget = {};
+    budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    VkPhysicalDeviceMemoryProperties2 memoryPropertiesExt = {};
+    {
+        memoryPropertiesExt.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2;
+        memoryPropertiesExt.pNext = &budget;
+    }
+    vkGetPhysicalDeviceMemoryProperties2(physicalDevice_, &memoryPropertiesExt);
+
+    return true;
+}
+
 
 /*
  * ======= Private: =======
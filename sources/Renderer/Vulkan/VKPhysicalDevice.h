@@ -45,6 +45,9 @@ class VKPhysicalDevice
         // Returns true if the specified Vulkan extension is supported by this physical device.
         bool SupportsExtension(const char* extension) const;
 
+        // Queries the current memory budget and usage of all memory heaps. Returns false if "VK_EXT_memory_budget" is not available.
+        bool QueryMemoryBudget(VkPhysicalDeviceMemoryBudgetPropertiesEXT& budget) const;
+
         /* ----- Handles ----- */
 
         // Returns the native VkPhysicalDevice handle.
@@ -9,6 +9,8 @@
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "Memory/VKDeviceMemoryManager.h"
+#include "Memory/VKDeviceMemoryDefragmenter.h"
+#include "Buffer/VKStagingRing.h"
 #include <LLGL/Platform/NativeHandle.h>
 #include "../../Core/Helper.h"
 #include "../TextureUtils.h"
@@ -44,6 +46,8 @@ VKRenderContext::VKRenderContext(
     VkPhysicalDevice                physicalDevice,
     const VKPtr<VkDevice>&          device,
     VKDeviceMemoryManager&          deviceMemoryMngr,
+    VKDeviceMemoryDefragmenter*     deviceMemoryDefrag,
+    VKStagingRing*                  stagingRing,
     RenderContextDescriptor         desc,
     const std::shared_ptr<Surface>& surface)
 :
@@ -52,6 +56,8 @@ VKRenderContext::VKRenderContext(
     physicalDevice_          { physicalDevice                  },
     device_                  { device                          },
     deviceMemoryMngr_        { deviceMemoryMngr                },
+    deviceMemoryDefrag_      { deviceMemoryDefrag              },
+    stagingRing_             { stagingRing                     },
     surface_                 { instance, vkDestroySurfaceKHR   },
     swapChain_               { device, vkDestroySwapchainKHR   },
     swapChainRenderPass_     { device                          },
@@ -85,6 +91,10 @@ VKRenderContext::VKRenderContext(
 
 void VKRenderContext::Present()
 {
+    /* Submit pending staging transfers and reclaim the staging memory of completed ones */
+    if (stagingRing_ != nullptr)
+        stagingRing_->NextFrame();
+
     /* Initialize semaphores */
     VkSemaphore waitSemaphorse[] = { imageAvailableSemaphore_ };
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
@@ -125,6 +135,10 @@ void VKRenderContext::Present()
 
     /* Get image index for next presentation */
     AcquireNextPresentImage();
+
+    /* Move buffers out of sparsely occupied device memory chunks within the per-frame budget */
+    if (deviceMemoryDefrag_ != nullptr)
+        deviceMemoryDefrag_->NextFrame();
 }
 
 std::uint32_t VKRenderContext::GetSamples() const
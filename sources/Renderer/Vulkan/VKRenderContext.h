@@ -26,6 +26,8 @@ namespace LLGL
 
 class VKDeviceMemoryManager;
 class VKDeviceMemoryRegion;
+class VKDeviceMemoryDefragmenter;
+class VKStagingRing;
 
 class VKRenderContext final : public RenderContext
 {
@@ -37,6 +39,8 @@ class VKRenderContext final : public RenderContext
             VkPhysicalDevice                physicalDevice,
             const VKPtr<VkDevice>&          device,
             VKDeviceMemoryManager&          deviceMemoryMngr,
+            VKDeviceMemoryDefragmenter*     deviceMemoryDefrag,
+            VKStagingRing*                  stagingRing,
             RenderContextDescriptor         desc,
             const std::shared_ptr<Surface>& surface
         );
@@ -119,7 +123,9 @@ class VKRenderContext final : public RenderContext
         VkPhysicalDevice        physicalDevice_                                 = VK_NULL_HANDLE;
         const VKPtr<VkDevice>&  device_;
 
-        VKDeviceMemoryManager&  deviceMemoryMngr_;
+        VKDeviceMemoryManager&      deviceMemoryMngr_;
+        VKDeviceMemoryDefragmenter* deviceMemoryDefrag_                         = nullptr;
+        VKStagingRing*              stagingRing_                                = nullptr;
 
         VKPtr<VkSurfaceKHR>     surface_;
         SurfaceSupportDetails   surfaceSupportDetails_;
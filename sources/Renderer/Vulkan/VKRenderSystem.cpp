@@ -22,6 +22,8 @@
 #include "RenderState/VKComputePSO.h"
 #include <LLGL/Log.h>
 #include <LLGL/ImageFlags.h>
+#include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
@@ -46,6 +48,21 @@ static void DestroyDebugReportCallbackEXT(VkInstance instance, VkDebugReportCall
         func(instance, callback, allocator);
 }
 
+// Alignment of staging regions for buffer uploads. Buffer copies have no alignment requirement, but aligned regions speed up the CPU copy.
+static const VkDeviceSize g_stagingBufferAlignment = 16;
+
+// Returns the alignment of staging regions for image copies, which must be a multiple of 4 and of the texel block size.
+static VkDeviceSize GetStagingImageAlignment(const Format format)
+{
+    const auto blockSize = std::max<VkDeviceSize>(1, GetFormatAttribs(format).bitSize / 8);
+    if (blockSize % 4 == 0)
+        return blockSize;
+    else if (blockSize % 2 == 0)
+        return blockSize * 2;
+    else
+        return blockSize * 4;
+}
+
 static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long cpuAccessFlags)
 {
     if ((cpuAccessFlags & CPUAccessFlags::Write) != 0)
@@ -77,18 +94,62 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
     /* Create default resources */
     CreateDefaultPipelineLayout();
 
+    /* Create device-wide pipeline cache and restore it from file */
+    pipelineCache_ = MakeUnique<VKPipelineCache>(device_, physicalDevice_.GetProperties());
+    if (rendererConfigVK != nullptr && !rendererConfigVK->pipelineCacheFilename.empty())
+    {
+        pipelineCacheFilename_ = rendererConfigVK->pipelineCacheFilename;
+        pipelineCache_->LoadFromFile(pipelineCacheFilename_);
+    }
+
     /* Create device memory manager */
     deviceMemoryMngr_ = MakeUnique<VKDeviceMemoryManager>(
         device_,
-        physicalDevice_.GetMemoryProperties(),
+        physicalDevice_,
         (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
-        (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false)
+        (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false),
+        (rendererConfigVK != nullptr ? rendererConfigVK->tlsfDeviceMemoryAllocator : false)
     );
+
+    /* Create incremental device memory defragmenter (if enabled) */
+    if (rendererConfigVK != nullptr && rendererConfigVK->maxDeviceMemoryDefragSizePerFrame > 0)
+    {
+        deviceMemoryDefrag_ = MakeUnique<VKDeviceMemoryDefragmenter>(
+            device_,
+            *deviceMemoryMngr_,
+            static_cast<VkDeviceSize>(rendererConfigVK->maxDeviceMemoryDefragSizePerFrame)
+        );
+    }
+
+    /* Create persistently mapped staging ring for asynchronous uploads (if enabled) */
+    const auto stagingRingSize = (rendererConfigVK != nullptr ? rendererConfigVK->stagingRingSize : 16*1024*1024);
+    if (stagingRingSize > 0)
+        stagingRing_ = MakeUnique<VKStagingRing>(device_, physicalDevice_, static_cast<VkDeviceSize>(stagingRingSize));
+
+    /* Create command queue interface */
+    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue(), *deviceMemoryMngr_, stagingRing_.get());
 }
 
 VKRenderSystem::~VKRenderSystem()
 {
+    /* Submit pending staging transfers before any resource is released */
+    if (stagingRing_)
+        stagingRing_->WaitIdle();
+
     device_.WaitIdle();
+
+    /* Store device-wide pipeline cache for the next application run */
+    if (!pipelineCacheFilename_.empty())
+    {
+        if (!pipelineCache_->SaveToFile(pipelineCacheFilename_))
+            Log::PostReport(Log::ReportType::Warning, "failed to store Vulkan pipeline cache: " + pipelineCacheFilename_);
+    }
+}
+
+bool VKRenderSystem::QueryMemoryStatistics(MemoryStatistics& stats)
+{
+    deviceMemoryMngr_->QueryStatistics(stats);
+    return true;
 }
 
 /* ----- Render Context ----- */
@@ -97,7 +158,7 @@ RenderContext* VKRenderSystem::CreateRenderContext(const RenderContextDescriptor
 {
     return TakeOwnership(
         renderContexts_,
-        MakeUnique<VKRenderContext>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, desc, surface)
+        MakeUnique<VKRenderContext>(instance_, physicalDevice_, device_, *deviceMemoryMngr_, deviceMemoryDefrag_.get(), stagingRing_.get(), desc, surface)
     );
 }
 
@@ -134,16 +195,6 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
 {
     AssertCreateBuffer(desc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        static_cast<VkDeviceSize>(desc.size),
-        GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
-
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, desc.size);
-
     /* Create primary buffer object */
     auto buffer = TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, desc));
 
@@ -154,20 +205,34 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
     );
     buffer->BindMemoryRegion(device_, memoryRegion);
 
-    /* Copy staging buffer into hardware buffer */
-    device_.CopyBuffer(stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(desc.size));
-
     if (desc.cpuAccessFlags != 0 || (desc.miscFlags & MiscFlags::DynamicUsage) != 0)
     {
+        /* Create staging buffer */
+        VkBufferCreateInfo stagingCreateInfo;
+        BuildVkBufferCreateInfo(
+            stagingCreateInfo,
+            static_cast<VkDeviceSize>(desc.size),
+            GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
+        );
+
+        auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, desc.size);
+
+        /* Copy staging buffer into hardware buffer */
+        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(desc.size));
+
         /* Store ownership of staging buffer */
         buffer->TakeStagingBuffer(std::move(stagingBuffer));
     }
-    else
+    else if (initialData != nullptr)
     {
-        /* Release staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Upload initial data via staging ring */
+        UploadBuffer(*buffer, 0, initialData, static_cast<VkDeviceSize>(desc.size));
     }
 
+    /* Allow primary buffer to be moved by the device memory defragmenter */
+    if (deviceMemoryDefrag_)
+        deviceMemoryDefrag_->RegisterBuffer(*buffer);
+
     return buffer;
 }
 
@@ -182,6 +247,13 @@ void VKRenderSystem::Release(Buffer& buffer)
 {
     /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
+    if (deviceMemoryDefrag_)
+        deviceMemoryDefrag_->UnregisterBuffer(bufferVK);
+
+    /* Wait for the pending staging transfer that might still refer to this buffer */
+    if (stagingRing_)
+        stagingRing_->WaitForBatch(bufferVK.GetStagingBatchID());
+
     bufferVK.GetDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     bufferVK.GetStagingDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
     RemoveFromUniqueSet(buffers_, &buffer);
@@ -206,21 +278,8 @@ void VKRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, con
     }
     else
     {
-        /* Create staging buffer */
-        VkBufferCreateInfo stagingCreateInfo;
-        BuildVkBufferCreateInfo(
-            stagingCreateInfo,
-            dataSize,
-            (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
-        );
-
-        auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, data, dataSize);
-
-        /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), bufferVK.GetVkBuffer(), dataSize, 0, dstOffset);
-
-        /* Release device memory region of staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Upload data via staging ring */
+        UploadBuffer(bufferVK, dstOffset, data, dataSize);
     }
 }
 
@@ -315,21 +374,22 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         initialData = intermediateData.get();
     }
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        initialDataSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT  // <-- TODO: support read/write mapping //GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
-
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, initialDataSize);
-
     /* Create device texture */
     auto textureVK  = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Write initial data into staging memory */
+    VKStagingRegion stagingRegion;
+    VKDeviceBuffer  stagingBuffer{ device_ };
+
+    auto cmdBuffer = BeginStagingTransfer(
+        initialData,
+        initialDataSize,
+        GetStagingImageAlignment(textureDesc.format),
+        stagingRegion,
+        stagingBuffer
+    );
+
+    /* Copy staging memory into hardware texture, then transfer image into sampling-ready state */
     {
         const TextureSubresource subresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() };
 
@@ -344,12 +404,13 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
 
         device_.CopyBufferToImage(
             cmdBuffer,
-            stagingBuffer.GetVkBuffer(),
+            stagingRegion.buffer,
             textureVK->GetVkImage(),
             textureVK->GetVkFormat(),
             VkOffset3D{ 0, 0, 0 },
             textureVK->GetVkExtent(),
-            subresource
+            subresource,
+            stagingRegion.offset
         );
 
         device_.TransitionImageLayout(
@@ -373,10 +434,7 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             );
         }
     }
-    device_.FlushCommandBuffer(cmdBuffer);
-
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    textureVK->SetStagingBatchID(EndStagingTransfer(cmdBuffer, stagingBuffer));
 
     /* Create image view for texture */
     textureVK->CreateInternalImageView(device_);
@@ -386,8 +444,13 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
 
 void VKRenderSystem::Release(Texture& texture)
 {
-    /* Release device memory region, then release texture object */
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
+
+    /* Wait for the pending staging transfer that might still refer to this texture */
+    if (stagingRing_)
+        stagingRing_->WaitForBatch(textureVK.GetStagingBatchID());
+
+    /* Release device memory region, then release texture object */
     deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
     RemoveFromUniqueSet(textures_, &texture);
 }
@@ -439,18 +502,13 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
         imageData = imageDesc.data;
     }
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        imageDataSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT  // <-- TODO: support read/write mapping //GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
+    /* Write image data into staging memory */
+    VKStagingRegion stagingRegion;
+    VKDeviceBuffer  stagingBuffer{ device_ };
 
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, imageData, imageDataSize);
+    auto cmdBuffer = BeginStagingTransfer(imageData, imageDataSize, GetStagingImageAlignment(format), stagingRegion, stagingBuffer);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Copy staging memory into hardware texture, then transfer image into sampling-ready state */
     {
         device_.TransitionImageLayout(
             cmdBuffer,
@@ -463,12 +521,13 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
 
         device_.CopyBufferToImage(
             cmdBuffer,
-            stagingBuffer.GetVkBuffer(),
+            stagingRegion.buffer,
             image,
             textureVK.GetVkFormat(),
             VkOffset3D{ offset.x, offset.y, offset.z },
             VkExtent3D{ extent.width, extent.height, extent.depth },
-            subresource
+            subresource,
+            stagingRegion.offset
         );
 
         device_.TransitionImageLayout(
@@ -480,10 +539,7 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
             subresource
         );
     }
-    device_.FlushCommandBuffer(cmdBuffer);
-
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    textureVK.SetStagingBatchID(EndStagingTransfer(cmdBuffer, stagingBuffer));
 }
 
 void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
@@ -499,13 +555,13 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
     const auto  imageSize       = extent.width * extent.height * extent.depth;
     const auto  imageDataSize   = static_cast<VkDeviceSize>(GetMemoryFootprint(format, imageSize));
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(stagingCreateInfo, imageDataSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo);
+    /* Allocate staging memory for readback */
+    VKStagingRegion stagingRegion;
+    VKDeviceBuffer  stagingBuffer{ device_ };
+
+    auto cmdBuffer = BeginStagingTransfer(nullptr, imageDataSize, GetStagingImageAlignment(format), stagingRegion, stagingBuffer);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Copy hardware texture into staging memory, then transfer image back into sampling-ready state */
     {
         device_.TransitionImageLayout(
             cmdBuffer,
@@ -519,11 +575,12 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
         device_.CopyImageToBuffer(
             cmdBuffer,
             image,
-            stagingBuffer.GetVkBuffer(),
+            stagingRegion.buffer,
             textureVK.GetVkFormat(),
             VkOffset3D{ offset.x, offset.y, offset.z },
             VkExtent3D{ extent.width, extent.height, extent.depth },
-            textureRegion.subresource
+            textureRegion.subresource,
+            stagingRegion.offset
         );
 
         device_.TransitionImageLayout(
@@ -535,23 +592,33 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
             textureRegion.subresource
         );
     }
-    device_.FlushCommandBuffer(cmdBuffer);
 
-    /* Map staging buffer to CPU memory space */
-    if (auto region = stagingBuffer.GetMemoryRegion())
+    if (stagingRegion.data != nullptr)
     {
-        /* Map buffer memory to host memory */
-        auto deviceMemory = region->GetParentChunk();
-        if (auto memory = deviceMemory->Map(device_, region->GetOffset(), imageDataSize))
+        /* Submit staging ring batch and wait for the readback, then copy data from its persistently mapped memory */
+        stagingRing_->WaitForBatch(stagingRing_->GetCurrentBatchID());
+        CopyTextureImageData(imageDesc, extent, format, stagingRegion.data);
+    }
+    else
+    {
+        device_.FlushCommandBuffer(cmdBuffer);
+
+        /* Map staging buffer to CPU memory space */
+        if (auto region = stagingBuffer.GetMemoryRegion())
         {
-            /* Copy data to buffer object */
-            CopyTextureImageData(imageDesc, extent, format, memory);
-            deviceMemory->Unmap(device_);
+            /* Map buffer memory to host memory */
+            auto deviceMemory = region->GetParentChunk();
+            if (auto memory = deviceMemory->Map(device_, region->GetOffset(), imageDataSize))
+            {
+                /* Copy data to buffer object */
+                CopyTextureImageData(imageDesc, extent, format, memory);
+                deviceMemory->Unmap(device_);
+            }
         }
-    }
 
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Release staging buffer */
+        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+    }
 }
 
 /* ----- Sampler States ---- */
@@ -644,28 +711,45 @@ void VKRenderSystem::Release(PipelineLayout& pipelineLayout)
 
 /* ----- Pipeline States ----- */
 
-PipelineState* VKRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    /* Merge serialized cache into device-wide pipeline cache; Vulkan caches don't contain the pipeline state itself */
+    if (!pipelineCache_->Deserialize(serializedCache))
+        Log::PostReport(Log::ReportType::Warning, "ignored incompatible or corrupted Vulkan pipeline cache");
+    return nullptr;
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(
+    auto pipelineState = TakeOwnership(
         pipelineStates_,
         MakeUnique<VKGraphicsPSO>(
             device_,
             defaultPipelineLayout_,
             (!renderContexts_.empty() ? (*renderContexts_.begin())->GetRenderPass() : nullptr),
             desc,
-            gfxPipelineLimits_
+            gfxPipelineLimits_,
+            pipelineCache_->GetVkPipelineCache()
         )
     );
+
+    if (serializedCache != nullptr)
+        *serializedCache = SerializePipelineCache();
+
+    return pipelineState;
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<VKComputePSO>(device_, desc, defaultPipelineLayout_));
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<VKComputePSO>(device_, desc, defaultPipelineLayout_, pipelineCache_->GetVkPipelineCache())
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = SerializePipelineCache();
+
+    return pipelineState;
 }
 
 void VKRenderSystem::Release(PipelineState& pipelineState)
@@ -867,9 +951,6 @@ void VKRenderSystem::CreateLogicalDevice()
     /* Create logical device with all supported physical device feature */
     device_ = physicalDevice_.CreateLogicalDevice();
 
-    /* Create command queue interface */
-    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue());
-
     /* Load Vulkan device extensions */
     VKLoadDeviceExtensions(device_, physicalDevice_.GetExtensionNames());
 }
@@ -945,6 +1026,75 @@ VKDeviceBuffer VKRenderSystem::CreateStagingBuffer(
     return stagingBuffer;
 }
 
+VkCommandBuffer VKRenderSystem::BeginStagingTransfer(
+    const void*         data,
+    VkDeviceSize        dataSize,
+    VkDeviceSize        alignment,
+    VKStagingRegion&    region,
+    VKDeviceBuffer&     stagingBuffer)
+{
+    if (stagingRing_)
+    {
+        /* Write data into staging ring and record the transfer into its current batch */
+        if (stagingRing_->Allocate(dataSize, alignment, region))
+        {
+            if (data != nullptr)
+                ::memcpy(region.data, data, static_cast<std::size_t>(dataSize));
+            return stagingRing_->GetCommandBuffer();
+        }
+
+        /* Submit pending transfers of the staging ring first, so all transfers are executed in order */
+        stagingRing_->Flush();
+    }
+
+    /* Create temporary staging buffer */
+    VkBufferCreateInfo stagingCreateInfo;
+    BuildVkBufferCreateInfo(
+        stagingCreateInfo,
+        dataSize,
+        (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
+    );
+
+    stagingBuffer = CreateStagingBuffer(stagingCreateInfo, data, dataSize);
+
+    region.buffer   = stagingBuffer.GetVkBuffer();
+    region.offset   = 0;
+    region.data     = nullptr;
+
+    return device_.AllocCommandBuffer();
+}
+
+std::uint64_t VKRenderSystem::EndStagingTransfer(VkCommandBuffer commandBuffer, VKDeviceBuffer& stagingBuffer)
+{
+    /* Transfers via staging ring are submitted with their batch, so only wait for temporary staging buffers */
+    if (stagingBuffer.GetVkBuffer() != VK_NULL_HANDLE)
+    {
+        device_.FlushCommandBuffer(commandBuffer);
+        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        return 0;
+    }
+    return stagingRing_->GetCurrentBatchID();
+}
+
+void VKRenderSystem::UploadBuffer(VKBuffer& bufferVK, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize)
+{
+    VKStagingRegion stagingRegion;
+    VKDeviceBuffer  stagingBuffer{ device_ };
+
+    auto cmdBuffer = BeginStagingTransfer(data, dataSize, g_stagingBufferAlignment, stagingRegion, stagingBuffer);
+    {
+        device_.CopyBuffer(cmdBuffer, stagingRegion.buffer, bufferVK.GetVkBuffer(), dataSize, stagingRegion.offset, dstOffset);
+    }
+    bufferVK.SetStagingBatchID(EndStagingTransfer(cmdBuffer, stagingBuffer));
+}
+
+std::unique_ptr<Blob> VKRenderSystem::SerializePipelineCache()
+{
+    Serialization::Serializer writer;
+    pipelineCache_->Serialize(writer);
+    return writer.Finalize();
+}
+
 
 } // /namespace LLGL
 
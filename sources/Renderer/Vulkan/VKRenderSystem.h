@@ -14,6 +14,7 @@
 #include "VKDevice.h"
 #include "../ContainerTypes.h"
 #include "Memory/VKDeviceMemoryManager.h"
+#include "Memory/VKDeviceMemoryDefragmenter.h"
 
 #include "VKCommandQueue.h"
 #include "VKCommandBuffer.h"
@@ -21,6 +22,7 @@
 
 #include "Buffer/VKBuffer.h"
 #include "Buffer/VKBufferArray.h"
+#include "Buffer/VKStagingRing.h"
 
 #include "Shader/VKShader.h"
 #include "Shader/VKShaderProgram.h"
@@ -34,6 +36,7 @@
 #include "RenderState/VKRenderPass.h"
 #include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKGraphicsPSO.h"
+#include "RenderState/VKPipelineCache.h"
 #include "RenderState/VKResourceHeap.h"
 
 #include <string>
@@ -57,6 +60,8 @@ class VKRenderSystem final : public RenderSystem
         VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc);
         ~VKRenderSystem();
 
+        bool QueryMemoryStatistics(MemoryStatistics& stats) override;
+
         /* ----- Render Context ----- */
 
         RenderContext* CreateRenderContext(const RenderContextDescriptor& desc, const std::shared_ptr<Surface>& surface = nullptr) override;
@@ -172,6 +177,25 @@ class VKRenderSystem final : public RenderSystem
             VkDeviceSize                dataSize
         );
 
+        // Begins a staging transfer of the specified size via the staging ring, or via a temporary staging buffer if the staging ring is disabled or too small.
+        VkCommandBuffer BeginStagingTransfer(
+            const void*                 data,
+            VkDeviceSize                dataSize,
+            VkDeviceSize                alignment,
+            VKStagingRegion&            region,
+            VKDeviceBuffer&             stagingBuffer
+        );
+
+        // Ends a staging transfer. Only transfers via a temporary staging buffer are submitted immediately and released after their completion.
+        // Returns the ID of the staging ring batch the transfer was recorded into, or 0 if the transfer has already been completed.
+        std::uint64_t EndStagingTransfer(VkCommandBuffer commandBuffer, VKDeviceBuffer& stagingBuffer);
+
+        // Uploads the specified data into the hardware buffer via a staging transfer.
+        void UploadBuffer(VKBuffer& bufferVK, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize);
+
+        // Returns the device-wide pipeline cache in serialized form.
+        std::unique_ptr<Blob> SerializePipelineCache();
+
     private:
 
         /* ----- Common objects ----- */
@@ -187,6 +211,11 @@ class VKRenderSystem final : public RenderSystem
         bool                                    debugLayerEnabled_      = false;
 
         std::unique_ptr<VKDeviceMemoryManager>  deviceMemoryMngr_;
+        std::unique_ptr<VKDeviceMemoryDefragmenter> deviceMemoryDefrag_;
+        std::unique_ptr<VKStagingRing>          stagingRing_;
+
+        std::unique_ptr<VKPipelineCache>        pipelineCache_;
+        std::string                             pipelineCacheFilename_;
 
         VKGraphicsPipelineLimits                gfxPipelineLimits_;
 
@@ -0,0 +1,43 @@
+/*
+ * VKSerialization.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_SERIALIZATION_H
+#define LLGL_VK_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include <LLGL/RenderSystemFlags.h>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for Vulkan serialization.
+enum VKIdent : IdentType
+{
+    VKIdent_ReservedVulkan = (RendererID::Vulkan << 8),
+    VKIdent_PipelineCacheHeader,    // VKPipelineCacheHeader
+    VKIdent_PipelineCacheData,      // Data from vkGetPipelineCacheData
+};
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,363 @@
+/*
+ * Test_GLCommandOptimizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Renderer/OpenGL/Command/GLCommandOptimizer.h"
+#include "../sources/Renderer/OpenGL/Command/GLCommand.h"
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+#include <string.h>
+
+
+/*
+CPU-side test of the peephole optimizer for GL deferred command buffers.
+Command streams are encoded in the same layout as GLDeferredCommandBuffer records them, optimized with OptimizeGLCommandBuffer,
+and the resulting opcode stream is compared against the expected one. Both streams are then replayed by a reference executor
+that models the GL states the optimizer tracks, and the sequences of draw and clear operations must be equal.
+*/
+
+using namespace LLGL;
+
+static const std::uint32_t g_numRandomStreams = 2000;
+
+static void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::runtime_error(message);
+}
+
+// Helper class to encode a GL command stream like GLDeferredCommandBuffer does.
+class GLCommandStream
+{
+
+    public:
+
+        template <typename T>
+        void Append(const GLOpcode opcode, const T& cmd)
+        {
+            AppendRaw(opcode, &cmd, sizeof(cmd));
+        }
+
+        void AppendRaw(const GLOpcode opcode, const void* data, std::size_t size)
+        {
+            const auto offset = buffer.size();
+            buffer.resize(offset + sizeof(GLOpcode) + size);
+            buffer[offset] = opcode;
+            ::memcpy(&buffer[offset + sizeof(GLOpcode)], data, size);
+        }
+
+        void BindPipelineState(std::uintptr_t id)
+        {
+            Append(GLOpcodeBindPipelineState, GLCmdBindPipelineState{ reinterpret_cast<GLPipelineState*>(id) });
+        }
+
+        void BindVertexArray(GLuint vao)
+        {
+            Append(GLOpcodeBindVertexArray, GLCmdBindVertexArray{ vao });
+        }
+
+        void Viewport(GLfloat width, GLfloat height)
+        {
+            GLCmdViewport cmd;
+            {
+                cmd.viewport    = { 0.0f, 0.0f, width, height };
+                cmd.depthRange  = { 0.0f, 1.0f };
+            }
+            Append(GLOpcodeViewport, cmd);
+        }
+
+        void SetStencilRef(GLint ref)
+        {
+            Append(GLOpcodeSetStencilRef, GLCmdSetStencilRef{ ref, GL_FRONT_AND_BACK });
+        }
+
+        void ClearColor(GLfloat value)
+        {
+            Append(GLOpcodeClearColor, GLCmdClearColor{ { value, value, value, 1.0f } });
+        }
+
+        void Clear(long flags)
+        {
+            Append(GLOpcodeClear, GLCmdClear{ flags });
+        }
+
+        void DrawArrays(GLenum mode, GLint first, GLsizei count)
+        {
+            Append(GLOpcodeDrawArrays, GLCmdDrawArrays{ mode, first, count });
+        }
+
+    public:
+
+        std::vector<std::uint8_t> buffer;
+
+};
+
+// Returns the sequence of opcodes of the specified command stream.
+static std::vector<GLOpcode> GetOpcodes(const std::vector<std::uint8_t>& buffer)
+{
+    std::vector<GLOpcode> opcodes;
+    for (std::size_t pos = 0; pos < buffer.size();)
+    {
+        const auto opcode = static_cast<GLOpcode>(buffer[pos]);
+        opcodes.push_back(opcode);
+        pos += sizeof(GLOpcode) + GetGLCommandSize(opcode, &buffer[pos + sizeof(GLOpcode)]);
+    }
+    return opcodes;
+}
+
+// Draw or clear operation that is recorded by the reference executor.
+struct GLOperation
+{
+    bool            isDraw;
+    std::uintptr_t  pipelineState;
+    GLuint          vao;
+    GLViewport      viewport;
+    GLint           stencilRef;
+    GLfloat         clearColor;
+    long            clearFlags;
+    GLenum          mode;
+    GLint           first;
+    GLsizei         count;
+};
+
+static bool operator == (const GLOperation& lhs, const GLOperation& rhs)
+{
+    return (::memcmp(&lhs, &rhs, sizeof(GLOperation)) == 0);
+}
+
+/*
+Replays the specified command stream and returns the sequence of draw and clear operations with the states they use.
+Pipeline states with an odd ID have a static viewport and stencil reference, which are applied on every binding,
+just like the GL state manager does for static pipeline states. Repeating an identical clear operation has no effect.
+*/
+static std::vector<GLOperation> Execute(const std::vector<std::uint8_t>& buffer)
+{
+    std::vector<GLOperation> ops;
+
+    GLOperation state;
+    ::memset(&state, 0, sizeof(state));
+
+    auto draw = [&](GLenum mode, GLint first, GLsizei count)
+    {
+        auto op = state;
+        {
+            op.isDraw   = true;
+            op.mode     = mode;
+            op.first    = first;
+            op.count    = count;
+        }
+        ops.push_back(op);
+    };
+
+    for (std::size_t pos = 0; pos < buffer.size();)
+    {
+        const auto opcode   = static_cast<GLOpcode>(buffer[pos]);
+        const auto pc       = &buffer[pos + sizeof(GLOpcode)];
+        pos += sizeof(GLOpcode) + GetGLCommandSize(opcode, pc);
+
+        switch (opcode)
+        {
+            case GLOpcodeBindPipelineState:
+            {
+                state.pipelineState = reinterpret_cast<std::uintptr_t>(reinterpret_cast<const GLCmdBindPipelineState*>(pc)->pipelineState);
+                if ((state.pipelineState & 1) != 0)
+                {
+                    state.viewport      = { 0.0f, 0.0f, 64.0f, 64.0f };
+                    state.stencilRef    = 0xFF;
+                }
+            }
+            break;
+
+            case GLOpcodeBindVertexArray:
+                state.vao = reinterpret_cast<const GLCmdBindVertexArray*>(pc)->vao;
+                break;
+
+            case GLOpcodeViewport:
+                state.viewport = reinterpret_cast<const GLCmdViewport*>(pc)->viewport;
+                break;
+
+            case GLOpcodeSetStencilRef:
+                state.stencilRef = reinterpret_cast<const GLCmdSetStencilRef*>(pc)->ref;
+                break;
+
+            case GLOpcodeClearColor:
+                state.clearColor = reinterpret_cast<const GLCmdClearColor*>(pc)->color[0];
+                break;
+
+            case GLOpcodeClear:
+            {
+                auto op = state;
+                {
+                    op.isDraw       = false;
+                    op.clearFlags   = reinterpret_cast<const GLCmdClear*>(pc)->flags;
+                }
+                if (ops.empty() || !(ops.back() == op))
+                    ops.push_back(op);
+            }
+            break;
+
+            case GLOpcodeDrawArrays:
+            {
+                auto cmd = reinterpret_cast<const GLCmdDrawArrays*>(pc);
+                draw(cmd->mode, cmd->first, cmd->count);
+            }
+            break;
+
+            case GLOpcodeMultiDrawArrays:
+            {
+                auto cmd    = reinterpret_cast<const GLCmdMultiDrawArrays*>(pc);
+                auto firsts = reinterpret_cast<const GLint*>(cmd + 1);
+                auto counts = reinterpret_cast<const GLsizei*>(firsts + cmd->drawcount);
+                for (GLsizei i = 0; i < cmd->drawcount; ++i)
+                    draw(cmd->mode, firsts[i], counts[i]);
+            }
+            break;
+
+            default:
+                throw std::runtime_error("unexpected opcode in command stream: " + std::to_string(static_cast<int>(opcode)));
+        }
+    }
+
+    return ops;
+}
+
+static void TestKnownStream()
+{
+    GLCommandStream stream;
+    {
+        stream.ClearColor(0.5f);
+        stream.ClearColor(0.5f);                // redundant
+        stream.Clear(1);
+        stream.Clear(1);                        // redundant
+        stream.BindPipelineState(2);
+        stream.BindPipelineState(2);            // redundant
+        stream.Viewport(800.0f, 600.0f);
+        stream.BindVertexArray(7);
+        stream.BindVertexArray(7);              // redundant
+        stream.DrawArrays(GL_TRIANGLES, 0, 3);
+        stream.DrawArrays(GL_TRIANGLES, 3, 3);  // merged
+        stream.DrawArrays(GL_TRIANGLES, 6, 6);  // merged
+        stream.Viewport(800.0f, 600.0f);        // redundant
+        stream.DrawArrays(GL_LINES, 0, 2);
+        stream.BindPipelineState(3);
+        stream.Viewport(800.0f, 600.0f);        // not redundant: pipeline state might have set a static viewport
+        stream.SetStencilRef(1);
+        stream.BindPipelineState(3);            // not redundant: pipeline state might reset its static stencil reference
+        stream.DrawArrays(GL_LINES, 2, 2);
+    }
+
+    auto optimized = stream.buffer;
+    GLCommandOptimizerStats stats;
+    OptimizeGLCommandBuffer(optimized, true, stats);
+
+    const std::vector<GLOpcode> expectedOpcodes
+    {
+        GLOpcodeClearColor,
+        GLOpcodeClear,
+        GLOpcodeBindPipelineState,
+        GLOpcodeViewport,
+        GLOpcodeBindVertexArray,
+        GLOpcodeMultiDrawArrays,
+        GLOpcodeDrawArrays,
+        GLOpcodeBindPipelineState,
+        GLOpcodeViewport,
+        GLOpcodeSetStencilRef,
+        GLOpcodeBindPipelineState,
+        GLOpcodeDrawArrays,
+    };
+
+    Check(GetOpcodes(optimized) == expectedOpcodes, "known stream test: unexpected opcode stream after optimization");
+
+    Check(stats.numCommandsIn == 19, "known stream test: expected 19 input commands, but got " + std::to_string(stats.numCommandsIn));
+    Check(stats.numCommandsOut == expectedOpcodes.size(), "known stream test: expected " + std::to_string(expectedOpcodes.size()) + " output commands, but got " + std::to_string(stats.numCommandsOut));
+    Check(stats.numRedundantStates == 4, "known stream test: expected 4 redundant states, but got " + std::to_string(stats.numRedundantStates));
+    Check(stats.numRedundantClears == 1, "known stream test: expected 1 redundant clear, but got " + std::to_string(stats.numRedundantClears));
+    Check(stats.numMergedDraws == 3, "known stream test: expected 3 merged draws, but got " + std::to_string(stats.numMergedDraws));
+    Check(stats.sizeIn == stream.buffer.size() && stats.sizeOut == optimized.size(), "known stream test: mismatch in stream sizes");
+
+    Check(Execute(optimized) == Execute(stream.buffer), "known stream test: MISMATCH in execution result");
+
+    /* Without multi-draw support, draw commands must be left as is */
+    auto optimizedNoMultiDraw = stream.buffer;
+    OptimizeGLCommandBuffer(optimizedNoMultiDraw, false, stats);
+
+    Check(stats.numMergedDraws == 0, "known stream test: draws must not be merged without multi-draw support");
+    Check(Execute(optimizedNoMultiDraw) == Execute(stream.buffer), "known stream test: MISMATCH in execution result without multi-draw support");
+
+    std::cout << "known stream test: ok" << std::endl;
+}
+
+static void TestRandomStreams()
+{
+    std::mt19937 rng{ 1234 };
+
+    std::size_t numCommandsIn   = 0;
+    std::size_t numCommandsOut  = 0;
+
+    for (std::uint32_t i = 0; i < g_numRandomStreams; ++i)
+    {
+        /* Generate command stream with only a few distinct states, so many commands are redundant */
+        GLCommandStream stream;
+
+        const auto numCommands = 1 + rng() % 64;
+        for (std::uint32_t j = 0; j < numCommands; ++j)
+        {
+            switch (rng() % 7)
+            {
+                case 0: stream.BindPipelineState(1 + rng() % 3);                                        break;
+                case 1: stream.BindVertexArray(1 + rng() % 2);                                          break;
+                case 2: stream.Viewport(rng() % 2 != 0 ? 64.0f : 800.0f, 64.0f);                        break;
+                case 3: stream.SetStencilRef(static_cast<GLint>(rng() % 2));                            break;
+                case 4: stream.ClearColor(rng() % 2 != 0 ? 0.0f : 1.0f);                                break;
+                case 5: stream.Clear(1 + rng() % 2);                                                    break;
+                case 6: stream.DrawArrays(rng() % 4 != 0 ? GL_TRIANGLES : GL_LINES, rng() % 8, 3);      break;
+            }
+        }
+
+        /* Optimize stream and compare execution results */
+        auto optimized = stream.buffer;
+        GLCommandOptimizerStats stats;
+        OptimizeGLCommandBuffer(optimized, true, stats);
+
+        Check(stats.numCommandsIn == numCommands, "random stream test: mismatch in number of input commands");
+        Check(stats.numCommandsOut == GetOpcodes(optimized).size(), "random stream test: mismatch in number of output commands");
+        Check(stats.numCommandsOut <= stats.numCommandsIn, "random stream test: optimized stream has more commands than the input stream");
+        Check(Execute(optimized) == Execute(stream.buffer), "random stream test: MISMATCH in execution result of stream " + std::to_string(i));
+
+        /* Optimizing the stream a second time must not change it any further */
+        auto optimizedTwice = optimized;
+        OptimizeGLCommandBuffer(optimizedTwice, true, stats);
+        Check(optimizedTwice == optimized, "random stream test: optimization of stream " + std::to_string(i) + " is not idempotent");
+
+        numCommandsIn   += numCommands;
+        numCommandsOut  += GetOpcodes(optimized).size();
+    }
+
+    std::cout << "random stream test: " << g_numRandomStreams << " streams, " << numCommandsIn << " commands reduced to " << numCommandsOut << ": ok" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestKnownStream();
+        TestRandomStreams();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
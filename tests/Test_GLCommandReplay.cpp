@@ -0,0 +1,584 @@
+/*
+ * Test_GLCommandReplay.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Renderer/OpenGL/Command/GLDeferredCommandBuffer.h"
+#include "../sources/Renderer/OpenGL/Command/GLCommandExecutor.h"
+#include "../sources/Renderer/OpenGL/Command/GLCommandPagePool.h"
+#include "../sources/Renderer/OpenGL/RenderState/GLStateManager.h"
+#include "../sources/Renderer/OpenGL/RenderState/GLQueryHeap.h"
+#include "../sources/Renderer/OpenGL/RenderState/GLResourceHeap.h"
+#include "../sources/Renderer/OpenGL/Buffer/GLBuffer.h"
+#include "../sources/Renderer/OpenGL/Buffer/GL2XVertexArray.h"
+#include "../sources/Renderer/OpenGL/Texture/GLTexture.h"
+#include "../sources/Renderer/OpenGL/Texture/GLMipGenerator.h"
+#include "../sources/Renderer/OpenGL/Shader/GLShaderUniform.h"
+#include "../sources/Renderer/OpenGL/Ext/GLExtensions.h"
+#include "../sources/Renderer/OpenGL/GLProfile.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+
+
+/*
+Headless benchmark for the replay of GL deferred command buffers:
+records the same random command stream into three GLDeferredCommandBuffer objects and replays them with the real ExecuteGLDeferredCommandBuffer,
+with CommandDispatchMode::Switch, with CommandDispatchMode::Threaded, and, if LLGL_ENABLE_JIT_COMPILER is defined,
+with the native program from AssembleGLDeferredCommandBuffer (CommandBufferFlags::MultiSubmit).
+No GL context is required: the GLStateManager functions and GL entry points that these commands use are replaced by stubs in this file,
+which only filter redundant states and accumulate their arguments into a checksum. All paths must produce the same checksum,
+so the measured difference is the dispatch overhead of each path.
+*/
+
+using namespace LLGL;
+
+static const std::uint32_t  g_numCommands   = 100000;
+static const int            g_numRuns       = 50;
+
+static unsigned int g_seed = 0;
+
+static int FastRand()
+{
+    g_seed = (214013 * g_seed + 2531011);
+    return (g_seed >> 16) & 0x7FFF;
+}
+
+static std::uint32_t RandUInt(std::uint32_t max)
+{
+    return static_cast<std::uint32_t>(FastRand()) % (max + 1);
+}
+
+
+/*
+ * Stub GL entry points
+ */
+
+static std::uint64_t g_checksum = 0;
+
+static void Accum(std::uint64_t value)
+{
+    g_checksum = g_checksum * 31 + value;
+}
+
+static void AccumFloat(GLfloat value)
+{
+    Accum(static_cast<std::uint64_t>(static_cast<std::int64_t>(value * 1000.0f)));
+}
+
+GLAPI void GLAPIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    Accum(mode);
+    Accum(static_cast<std::uint32_t>(first));
+    Accum(static_cast<std::uint32_t>(count));
+}
+
+GLAPI void GLAPIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+    Accum(mode);
+    Accum(static_cast<std::uint32_t>(count));
+    Accum(type);
+    Accum(reinterpret_cast<std::uintptr_t>(indices));
+}
+
+GLAPI void GLAPIENTRY glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    AccumFloat(red);
+    AccumFloat(green);
+    AccumFloat(blue);
+    AccumFloat(alpha);
+}
+
+GLAPI void GLAPIENTRY glClearStencil(GLint s)
+{
+    Accum(static_cast<std::uint32_t>(s));
+}
+
+static void GLAPIENTRY StubDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instancecount)
+{
+    glDrawArrays(mode, first, count);
+    Accum(static_cast<std::uint32_t>(instancecount));
+}
+
+static void GLAPIENTRY StubDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLint basevertex)
+{
+    glDrawElements(mode, count, type, indices);
+    Accum(static_cast<std::uint32_t>(basevertex));
+}
+
+// Replaces the GL extension entry points that are used by the recorded commands.
+static void LoadStubGLProcs()
+{
+    LLGL::glDrawArraysInstanced     = StubDrawArraysInstanced;
+    #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
+    LLGL::glDrawElementsBaseVertex  = StubDrawElementsBaseVertex;
+    #endif
+}
+
+static void ThrowNotStubbed(const char* funcName)
+{
+    throw std::runtime_error(std::string("GL function is not stubbed for this test: ") + funcName);
+}
+
+
+/*
+ * Stub GL state manager
+ */
+
+namespace LLGL
+{
+
+
+GLStateManager*             GLStateManager::active_         = nullptr;
+GLStateManager::GLLimits    GLStateManager::commonLimits_;
+
+GLStateManager::GLStateManager()
+{
+    limits_.maxViewports        = 16;
+    limits_.maxDebugNameLength  = 256;
+    active_ = this;
+}
+
+void GLStateManager::NotifyRenderTargetHeight(GLint height)
+{
+    renderTargetHeight_ = height;
+}
+
+void GLStateManager::SetViewport(GLViewport& viewport)
+{
+    /* Modify input like the real state manager adjusts the viewport to the render target height */
+    viewport.y = static_cast<GLfloat>(renderTargetHeight_) - viewport.height - viewport.y;
+    AccumFloat(viewport.x);
+    AccumFloat(viewport.y);
+    AccumFloat(viewport.width);
+    AccumFloat(viewport.height);
+}
+
+void GLStateManager::SetViewportArray(GLuint first, GLsizei count, GLViewport* viewports)
+{
+    Accum(first);
+    for (GLsizei i = 0; i < count; ++i)
+        SetViewport(viewports[i]);
+}
+
+void GLStateManager::SetDepthRange(const GLDepthRange& depthRange)
+{
+    Accum(static_cast<std::uint64_t>(depthRange.minDepth * 1000.0));
+    Accum(static_cast<std::uint64_t>(depthRange.maxDepth * 1000.0));
+}
+
+void GLStateManager::SetDepthRangeArray(GLuint first, GLsizei count, const GLDepthRange* depthRanges)
+{
+    Accum(first);
+    for (GLsizei i = 0; i < count; ++i)
+        SetDepthRange(depthRanges[i]);
+}
+
+void GLStateManager::SetScissor(GLScissor& scissor)
+{
+    scissor.y = renderTargetHeight_ - scissor.height - scissor.y;
+    Accum(static_cast<std::uint32_t>(scissor.x));
+    Accum(static_cast<std::uint32_t>(scissor.y));
+    Accum(static_cast<std::uint32_t>(scissor.width));
+    Accum(static_cast<std::uint32_t>(scissor.height));
+}
+
+void GLStateManager::SetScissorArray(GLuint first, GLsizei count, GLScissor* scissors)
+{
+    Accum(first);
+    for (GLsizei i = 0; i < count; ++i)
+        SetScissor(scissors[i]);
+}
+
+void GLStateManager::SetBlendColor(const GLfloat* color)
+{
+    if (!std::equal(color, color + 4, commonState_.blendColor))
+    {
+        std::copy(color, color + 4, commonState_.blendColor);
+        for (int i = 0; i < 4; ++i)
+            AccumFloat(color[i]);
+    }
+}
+
+void GLStateManager::SetStencilRef(GLint ref, GLenum face)
+{
+    Accum(static_cast<std::uint32_t>(ref));
+    Accum(face);
+}
+
+void GLStateManager::Clear(long flags)
+{
+    Accum(static_cast<std::uint64_t>(flags));
+}
+
+void GLStateManager::SetGraphicsAPIDependentState(const OpenGLDependentStateDescriptor& /*stateDesc*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindBuffer(GLBufferTarget /*target*/, GLuint /*buffer*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindBufferBase(GLBufferTarget /*target*/, GLuint /*index*/, GLuint /*buffer*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindBuffersBase(GLBufferTarget /*target*/, GLuint /*first*/, GLsizei /*count*/, const GLuint* /*buffers*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::UnbindBuffersBase(GLBufferTarget /*target*/, GLuint /*first*/, GLsizei /*count*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindVertexArray(GLuint /*vertexArray*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindElementArrayBufferToVAO(GLuint /*buffer*/, bool /*indexType16Bits*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::ActiveTexture(std::uint32_t /*layer*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::UnbindTextures(GLuint /*first*/, GLsizei /*count*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::UnbindImageTextures(GLuint /*first*/, GLsizei /*count*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindGLTexture(const GLTexture& /*texture*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindSampler(GLuint /*layer*/, GLuint /*sampler*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::UnbindSamplers(GLuint /*first*/, GLsizei /*count*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::BindRenderPass(
+    RenderTarget&       /*renderTarget*/,
+    const RenderPass*   /*renderPass*/,
+    std::uint32_t       /*numClearValues*/,
+    const ClearValue*   /*clearValues*/,
+    const GLClearValue& /*defaultClearValue*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLStateManager::ClearBuffers(std::uint32_t /*numAttachments*/, const AttachmentClear* /*attachments*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+
+/*
+ * Stub GL objects (not used by the recorded commands)
+ */
+
+void GLBuffer::BufferSubData(GLintptr /*offset*/, GLsizeiptr /*size*/, const void* /*data*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLBuffer::ClearBufferData(std::uint32_t /*data*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLBuffer::ClearBufferSubData(GLintptr /*offset*/, GLsizeiptr /*size*/, std::uint32_t /*data*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLBuffer::CopyBufferSubData(const GLBuffer& /*readBuffer*/, GLintptr /*readOffset*/, GLintptr /*writeOffset*/, GLsizeiptr /*size*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GL2XVertexArray::Bind(GLStateManager& /*stateMngr*/) const
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLTexture::CopyImageSubData(GLint, const Offset3D&, GLTexture&, GLint, const Offset3D&, const Extent3D&)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLTexture::CopyImageToBuffer(const TextureRegion&, GLuint, GLintptr, GLsizei, GLint, GLint)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLTexture::CopyImageFromBuffer(const TextureRegion&, GLuint, GLintptr, GLsizei, GLint, GLint)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+GLMipGenerator& GLMipGenerator::Get()
+{
+    throw std::runtime_error("GL function is not stubbed for this test: GLMipGenerator::Get");
+}
+
+void GLMipGenerator::GenerateMipsForTexture(GLStateManager&, GLTexture&)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLMipGenerator::GenerateMipsRangeForTexture(GLStateManager&, GLTexture&, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLQueryHeap::Begin(std::uint32_t /*query*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLQueryHeap::End(std::uint32_t /*query*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLResourceHeap::Bind(GLStateManager& /*stateMngr*/, std::uint32_t /*firstSet*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLSetUniformsByLocation(GLuint /*program*/, GLint /*location*/, GLsizei /*count*/, const void* /*data*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+void GLProfile::ClearDepth(GLclamp_t /*depth*/)
+{
+    ThrowNotStubbed(__FUNCTION__);
+}
+
+
+} // /namespace LLGL
+
+
+/*
+ * Benchmark
+ */
+
+// Records a random command stream that only depends on the seed.
+static void RecordCommands(CommandBuffer& cmdBuffer, unsigned int seed)
+{
+    g_seed = seed;
+
+    cmdBuffer.Begin();
+    {
+        for (std::uint32_t i = 0; i < g_numCommands; ++i)
+        {
+            switch (RandUInt(9))
+            {
+                case 0:
+                    cmdBuffer.SetViewport(
+                        Viewport
+                        {
+                            static_cast<float>(RandUInt(100)),
+                            static_cast<float>(RandUInt(100)),
+                            static_cast<float>(1 + RandUInt(699)),
+                            static_cast<float>(1 + RandUInt(499))
+                        }
+                    );
+                    break;
+
+                case 1:
+                {
+                    const Viewport viewports[2] =
+                    {
+                        Viewport{ 0.0f, 0.0f, 400.0f, 600.0f },
+                        Viewport{ 400.0f, 0.0f, static_cast<float>(1 + RandUInt(399)), 600.0f },
+                    };
+                    cmdBuffer.SetViewports(2, viewports);
+                }
+                break;
+
+                case 2:
+                    cmdBuffer.SetScissor(Scissor{ 0, 0, static_cast<std::int32_t>(1 + RandUInt(799)), static_cast<std::int32_t>(1 + RandUInt(599)) });
+                    break;
+
+                case 3:
+                    cmdBuffer.SetBlendFactor({ static_cast<float>(RandUInt(1)), 0.5f, 0.25f, 1.0f });
+                    break;
+
+                case 4:
+                    cmdBuffer.SetStencilReference(RandUInt(255), StencilFace::FrontAndBack);
+                    break;
+
+                case 5:
+                    cmdBuffer.SetClearColor({ static_cast<float>(RandUInt(10)) / 10.0f, 0.2f, 0.4f, 1.0f });
+                    cmdBuffer.Clear(ClearFlags::Color);
+                    break;
+
+                case 6:
+                    cmdBuffer.Draw(3 + RandUInt(30), RandUInt(100));
+                    break;
+
+                case 7:
+                    cmdBuffer.DrawInstanced(3 + RandUInt(30), RandUInt(100), 1 + RandUInt(15));
+                    break;
+
+                case 8:
+                    cmdBuffer.DrawIndexed(3 + RandUInt(30), RandUInt(100));
+                    break;
+
+                case 9:
+                    cmdBuffer.DrawIndexed(3 + RandUInt(30), RandUInt(100), static_cast<std::int32_t>(RandUInt(50)));
+                    break;
+            }
+        }
+    }
+    cmdBuffer.End();
+}
+
+struct ReplayResult
+{
+    double          minTime     = 0.0;  // Minimal replay time (in milliseconds).
+    double          medianTime  = 0.0;  // Median replay time (in milliseconds).
+    std::uint64_t   checksum    = 0;
+};
+
+static ReplayResult Replay(const GLDeferredCommandBuffer& cmdBuffer, GLStateManager& stateMngr)
+{
+    ReplayResult result;
+    std::vector<double> times;
+
+    for (int run = 0; run < g_numRuns; ++run)
+    {
+        // Reset cached blend color, so every run starts with the same redundant state filtering
+        const GLfloat invalidBlendColor[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+        stateMngr.SetBlendColor(invalidBlendColor);
+
+        g_checksum = 0;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ExecuteGLDeferredCommandBuffer(cmdBuffer, stateMngr);
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        times.push_back(std::chrono::duration<double, std::milli>(endTime - startTime).count());
+
+        if (run == 0)
+            result.checksum = g_checksum;
+        else if (result.checksum != g_checksum)
+            throw std::runtime_error("MISMATCH: checksum differs between runs of the same command buffer");
+    }
+
+    std::sort(times.begin(), times.end());
+    result.minTime      = times.front();
+    result.medianTime   = times[times.size() / 2];
+
+    return result;
+}
+
+static void PrintResult(const char* name, const ReplayResult& result, const ReplayResult& reference)
+{
+    std::cout << "  " << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(3);
+    std::cout << "min " << std::setw(8) << result.minTime << " ms, median " << std::setw(8) << result.medianTime << " ms";
+    std::cout << " (" << std::setprecision(1) << (result.medianTime * 1.0e6 / g_numCommands) << " ns/command, ";
+    std::cout << std::setprecision(2) << (reference.medianTime / result.medianTime) << "x)" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        LoadStubGLProcs();
+
+        GLStateManager stateMngr;
+        stateMngr.NotifyRenderTargetHeight(600);
+
+        GLCommandPagePool pagePool;
+
+        // Record the same command stream into a command buffer for each dispatch path
+        GLDeferredCommandBuffer cmdBufferSwitch{ 0, pagePool, CommandDispatchMode::Switch };
+        GLDeferredCommandBuffer cmdBufferThreaded{ 0, pagePool, CommandDispatchMode::Threaded };
+
+        const unsigned int seed = 12345;
+
+        RecordCommands(cmdBufferSwitch, seed);
+        RecordCommands(cmdBufferThreaded, seed);
+
+        // Replay command buffers
+        auto resultSwitch   = Replay(cmdBufferSwitch, stateMngr);
+        auto resultThreaded = Replay(cmdBufferThreaded, stateMngr);
+
+        std::cout << "replay of " << g_numCommands << " random GL commands (" << g_numRuns << " runs):" << std::endl;
+        PrintResult("switch", resultSwitch, resultSwitch);
+        PrintResult("threaded", resultThreaded, resultSwitch);
+
+        if (resultThreaded.checksum != resultSwitch.checksum)
+            throw std::runtime_error("MISMATCH: threaded dispatch differs from switch dispatch");
+
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+
+        GLDeferredCommandBuffer cmdBufferJIT{ CommandBufferFlags::MultiSubmit, pagePool, CommandDispatchMode::Switch };
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            RecordCommands(cmdBufferJIT, seed);
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            if (cmdBufferJIT.GetExecutable())
+            {
+                auto resultJIT = Replay(cmdBufferJIT, stateMngr);
+                PrintResult("jit", resultJIT, resultSwitch);
+                std::cout << "  recording and assembly of JIT program: " << std::setprecision(3) << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms" << std::endl;
+
+                if (resultJIT.checksum != resultSwitch.checksum)
+                    throw std::runtime_error("MISMATCH: JIT program differs from switch dispatch");
+            }
+            else
+                std::cout << "  jit       not available on this architecture" << std::endl;
+        }
+
+        #else
+
+        std::cout << "  jit       not enabled (LLGL_ENABLE_JIT_COMPILER)" << std::endl;
+
+        #endif // /LLGL_ENABLE_JIT_COMPILER
+
+        std::cout << "checksums: ok" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
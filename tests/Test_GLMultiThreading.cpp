@@ -0,0 +1,290 @@
+/*
+ * Test_GLMultiThreading.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "../sources/Renderer/OpenGL/Command/GLDeferredCommandBuffer.h"
+#include <vector>
+#include <thread>
+#include <functional>
+#include <stdexcept>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <cstdint>
+
+
+/*
+Stress test for multi-threaded recording of secondary GL command buffers:
+each frame, 8 worker threads record their own secondary command buffer with thousands of small draw calls,
+which are then executed in order by the primary command buffer on the render thread.
+Every few frames, the secondary command buffers are recorded serially instead to compare the recording time.
+Each frame is also recorded serially into a second set of command buffers, and the command streams of both sets must be byte-equal.
+By default, the window is never shown and only a few frames are recorded; pass "-window" to run the full stress test on screen.
+*/
+
+static const std::size_t    g_numThreads        = 8;
+static const std::uint32_t  g_numDrawsPerThread = 20000;
+static const std::uint32_t  g_gridSize          = 64;
+static const std::uint32_t  g_numCheckFrames    = 16;
+static const std::uint32_t  g_numStressFrames   = 600;
+
+// Returns the raw command stream of the specified deferred GL command buffer over all its pages.
+static std::vector<std::uint8_t> GetCommandStream(const LLGL::CommandBuffer& cmdBuffer)
+{
+    const auto& cmdBufferGL = static_cast<const LLGL::GLDeferredCommandBuffer&>(cmdBuffer);
+
+    std::vector<std::uint8_t> stream;
+    for (auto page = cmdBufferGL.GetFirstPage(); page != nullptr; page = page->next)
+        stream.insert(stream.end(), page->GetData(), page->GetData() + page->size);
+
+    return stream;
+}
+
+static void RecordSecondaryCommands(
+    LLGL::CommandBuffer&    commands,
+    LLGL::PipelineState&    pipeline,
+    LLGL::Buffer&           vertexBuffer,
+    const LLGL::Extent2D&   resolution,
+    std::size_t             threadIndex,
+    std::uint32_t           frame)
+{
+    const float cellWidth   = static_cast<float>(resolution.width) / static_cast<float>(g_gridSize);
+    const float cellHeight  = static_cast<float>(resolution.height) / static_cast<float>(g_gridSize);
+
+    commands.Begin();
+    {
+        commands.PushDebugGroup(("Worker " + std::to_string(threadIndex)).c_str());
+        {
+            commands.SetPipelineState(pipeline);
+            commands.SetVertexBuffer(vertexBuffer);
+
+            for (std::uint32_t i = 0; i < g_numDrawsPerThread; ++i)
+            {
+                /* Draw one triangle per grid cell; each thread covers different cells */
+                const auto cell = (static_cast<std::uint32_t>(threadIndex) + i * g_numThreads + frame) % (g_gridSize * g_gridSize);
+                const auto x    = static_cast<float>(cell % g_gridSize) * cellWidth;
+                const auto y    = static_cast<float>(cell / g_gridSize) * cellHeight;
+
+                commands.SetViewport(LLGL::Viewport{ x, y, cellWidth, cellHeight });
+                commands.Draw(3, 0);
+            }
+        }
+        commands.PopDebugGroup();
+    }
+    commands.End();
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const bool showWindow = (argc > 1 && std::string(argv[1]) == "-window");
+
+        // Load render system module
+        auto renderer = LLGL::RenderSystem::Load("OpenGL");
+
+        // Create render context
+        LLGL::RenderContextDescriptor contextDesc;
+        {
+            contextDesc.videoMode.resolution = { 800, 600 };
+        }
+        auto context = renderer->CreateRenderContext(contextDesc);
+
+        auto& window = static_cast<LLGL::Window&>(context->GetSurface());
+        window.SetTitle(L"LLGL Test: GL Multi-Threading ( " + std::wstring(g_numThreads, L'|') + L" )");
+        if (showWindow)
+            window.Show();
+
+        // Create vertex buffer
+        LLGL::VertexFormat vertexFormat;
+        vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+        const float vertices[] = { -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, -1.0f };
+
+        LLGL::BufferDescriptor vertexBufferDesc;
+        {
+            vertexBufferDesc.size           = sizeof(vertices);
+            vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+            vertexBufferDesc.vertexAttribs  = vertexFormat.attributes;
+        }
+        auto vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, vertices);
+
+        // Create shaders
+        LLGL::ShaderDescriptor vertShaderDesc;
+        {
+            vertShaderDesc.type                 = LLGL::ShaderType::Vertex;
+            vertShaderDesc.source               = "#version 130\nin vec2 position;\nvoid main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+            vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+            vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+        }
+        auto vertShader = renderer->CreateShader(vertShaderDesc);
+
+        LLGL::ShaderDescriptor fragShaderDesc;
+        {
+            fragShaderDesc.type         = LLGL::ShaderType::Fragment;
+            fragShaderDesc.source       = "#version 130\nout vec4 fragColor;\nvoid main() { fragColor = vec4(gl_FragCoord.xy / vec2(800.0, 600.0), 1.0, 1.0); }\n";
+            fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+        }
+        auto fragShader = renderer->CreateShader(fragShaderDesc);
+
+        for (auto shader : { vertShader, fragShader })
+        {
+            if (shader->HasErrors())
+                throw std::runtime_error(shader->GetReport());
+        }
+
+        LLGL::ShaderProgramDescriptor shaderProgramDesc;
+        {
+            shaderProgramDesc.vertexShader      = vertShader;
+            shaderProgramDesc.fragmentShader    = fragShader;
+        }
+        auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+        if (shaderProgram->HasErrors())
+            throw std::runtime_error(shaderProgram->GetReport());
+
+        // Create graphics pipeline
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.shaderProgram = shaderProgram;
+        }
+        auto pipeline = renderer->CreatePipelineState(pipelineDesc);
+
+        // Create primary command buffer and one secondary command buffer per worker thread
+        auto commandQueue   = renderer->GetCommandQueue();
+        auto commands       = renderer->CreateCommandBuffer();
+
+        LLGL::CommandBufferDescriptor secondaryCmdBufferDesc;
+        {
+            secondaryCmdBufferDesc.flags = LLGL::CommandBufferFlags::DeferredSubmit;
+        }
+        std::vector<LLGL::CommandBuffer*> secondaryCommands(g_numThreads);
+        for (auto& cmdBuffer : secondaryCommands)
+            cmdBuffer = renderer->CreateCommandBuffer(secondaryCmdBufferDesc);
+
+        // Create reference command buffers that are always recorded serially
+        std::vector<LLGL::CommandBuffer*> referenceCommands(g_numThreads);
+        for (auto& cmdBuffer : referenceCommands)
+            cmdBuffer = renderer->CreateCommandBuffer(secondaryCmdBufferDesc);
+
+        // Main loop
+        const auto resolution = context->GetResolution();
+
+        double          timeParallel    = 0.0;
+        double          timeSerial      = 0.0;
+        std::uint32_t   framesParallel  = 0;
+        std::uint32_t   framesSerial    = 0;
+        std::size_t     streamSize      = 0;
+
+        const auto numFrames = (showWindow ? g_numStressFrames : g_numCheckFrames);
+
+        for (std::uint32_t frame = 0; window.ProcessEvents() && frame < numFrames; ++frame)
+        {
+            // Record secondary command buffers in parallel, except for every 4th frame
+            const bool serial = (frame % 4 == 3);
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            if (serial)
+            {
+                for (std::size_t i = 0; i < g_numThreads; ++i)
+                    RecordSecondaryCommands(*secondaryCommands[i], *pipeline, *vertexBuffer, resolution, i, frame);
+            }
+            else
+            {
+                std::vector<std::thread> workers;
+                workers.reserve(g_numThreads);
+
+                for (std::size_t i = 0; i < g_numThreads; ++i)
+                {
+                    workers.emplace_back(
+                        RecordSecondaryCommands,
+                        std::ref(*secondaryCommands[i]), std::ref(*pipeline), std::ref(*vertexBuffer), resolution, i, frame
+                    );
+                }
+
+                for (auto& worker : workers)
+                    worker.join();
+            }
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+            if (serial)
+            {
+                timeSerial += duration;
+                ++framesSerial;
+            }
+            else
+            {
+                timeParallel += duration;
+                ++framesParallel;
+            }
+
+            // Compare command streams against serial recording of the same frame
+            for (std::size_t i = 0; i < g_numThreads; ++i)
+            {
+                RecordSecondaryCommands(*referenceCommands[i], *pipeline, *vertexBuffer, resolution, i, frame);
+
+                const auto stream           = GetCommandStream(*secondaryCommands[i]);
+                const auto referenceStream  = GetCommandStream(*referenceCommands[i]);
+
+                if (stream.empty() || stream != referenceStream)
+                {
+                    throw std::runtime_error(
+                        "MISMATCH between parallel and serial command stream of worker " + std::to_string(i) +
+                        " in frame " + std::to_string(frame) + " (" + std::to_string(stream.size()) + " vs. " +
+                        std::to_string(referenceStream.size()) + " bytes)"
+                    );
+                }
+
+                streamSize += stream.size();
+            }
+
+            // Execute secondary command buffers in order on the render thread
+            commands->Begin();
+            {
+                commands->BeginRenderPass(*context);
+                {
+                    commands->SetClearColor({ 0.1f, 0.1f, 0.2f });
+                    commands->Clear(LLGL::ClearFlags::Color);
+
+                    for (auto cmdBuffer : secondaryCommands)
+                        commands->Execute(*cmdBuffer);
+                }
+                commands->EndRenderPass();
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+
+            context->Present();
+        }
+
+        std::cout << "command streams: ok (" << streamSize << " bytes compared)" << std::endl;
+
+        // Print average recording times
+        if (framesParallel > 0 && framesSerial > 0)
+        {
+            const auto avgParallel  = timeParallel / framesParallel;
+            const auto avgSerial    = timeSerial / framesSerial;
+            std::cout << "recording of " << g_numThreads << " x " << g_numDrawsPerThread << " draws:" << std::endl;
+            std::cout << "  serial:   " << avgSerial << " ms" << std::endl;
+            std::cout << "  parallel: " << avgParallel << " ms (" << (avgSerial / avgParallel) << "x)" << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,327 @@
+/*
+ * Test_GLStateCounters.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <string.h>
+
+
+/*
+Test for the issued and elided GL state changes of the OpenGL backend:
+submits a deferred command buffer with redundant state changes twice, with a profiler and a state trace in the GL renderer configuration.
+The counters of the second submission must report the redundant bindings as elided, and the trace file must contain
+one marker per submission and the same number of issued and elided state changes per category as the profiler.
+Then submits the same commands recorded with the CommandBufferFlags::Optimize flag,
+for which the profiler must report the redundant binding as removed by the command buffer optimizer.
+*/
+
+static const char*          g_traceFilename     = "Test_GLStateCounters.trace";
+static const std::uint8_t   g_submitMarker      = 0xFF;
+static const std::size_t    g_numCategories     = 8;
+
+// Same layout as GLStateTraceRecord.
+struct TraceRecord
+{
+    std::uint8_t    category;
+    std::uint8_t    issued;
+    std::uint16_t   reserved;
+    std::uint32_t   value;
+};
+
+// Issued and elided state changes per category, in the order of GLStateCategory.
+struct StateCounters
+{
+    std::uint32_t issued[g_numCategories];
+    std::uint32_t elided[g_numCategories];
+};
+
+static void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::runtime_error(message);
+}
+
+static StateCounters GetStateCounters(const LLGL::FrameProfile& profile)
+{
+    StateCounters counters;
+    {
+        counters.issued[0] = profile.issuedCapabilityChanges;
+        counters.elided[0] = profile.elidedCapabilityChanges;
+        counters.issued[1] = profile.issuedRenderStateChanges;
+        counters.elided[1] = profile.elidedRenderStateChanges;
+        counters.issued[2] = profile.issuedBufferBindings;
+        counters.elided[2] = profile.elidedBufferBindings;
+        counters.issued[3] = profile.issuedVertexArrayBindings;
+        counters.elided[3] = profile.elidedVertexArrayBindings;
+        counters.issued[4] = profile.issuedFramebufferBindings;
+        counters.elided[4] = profile.elidedFramebufferBindings;
+        counters.issued[5] = profile.issuedTextureBindings;
+        counters.elided[5] = profile.elidedTextureBindings;
+        counters.issued[6] = profile.issuedSamplerBindings;
+        counters.elided[6] = profile.elidedSamplerBindings;
+        counters.issued[7] = profile.issuedShaderProgramBindings;
+        counters.elided[7] = profile.elidedShaderProgramBindings;
+    }
+    return counters;
+}
+
+static std::uint32_t SumIssued(const StateCounters& counters)
+{
+    std::uint32_t sum = 0;
+    for (auto n : counters.issued)
+        sum += n;
+    return sum;
+}
+
+static std::uint32_t SumElided(const StateCounters& counters)
+{
+    std::uint32_t sum = 0;
+    for (auto n : counters.elided)
+        sum += n;
+    return sum;
+}
+
+// Reads the trace file and returns the state counters of each submission.
+static std::vector<StateCounters> ReadTrace(const std::string& filename)
+{
+    std::ifstream file{ filename, std::ios::in | std::ios::binary };
+    Check(file.good(), "failed to open GL state trace: " + filename);
+
+    /* Read and validate file header */
+    char            magic[8]    = {};
+    std::uint32_t   version     = 0;
+    std::uint32_t   recordSize  = 0;
+
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&recordSize), sizeof(recordSize));
+
+    Check(file.good() && ::memcmp(magic, "LLGLSTRC", 8) == 0, "invalid magic in GL state trace");
+    Check(version == 1, "unexpected version in GL state trace: " + std::to_string(version));
+    Check(recordSize == sizeof(TraceRecord), "unexpected record size in GL state trace: " + std::to_string(recordSize));
+
+    /* Accumulate records until each submission marker */
+    std::vector<StateCounters> submissions;
+
+    StateCounters counters;
+    ::memset(&counters, 0, sizeof(counters));
+
+    TraceRecord record;
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        if (record.category == g_submitMarker)
+        {
+            Check(record.value == submissions.size(), "unexpected submission index in GL state trace: " + std::to_string(record.value));
+            submissions.push_back(counters);
+            ::memset(&counters, 0, sizeof(counters));
+        }
+        else
+        {
+            Check(record.category < g_numCategories, "invalid category in GL state trace: " + std::to_string(record.category));
+            Check(record.issued <= 1, "invalid issued flag in GL state trace");
+            if (record.issued != 0)
+                ++counters.issued[record.category];
+            else
+                ++counters.elided[record.category];
+        }
+    }
+
+    return submissions;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        std::vector<StateCounters> profiles;
+        std::vector<LLGL::FrameProfile> frameProfiles;
+
+        {
+            // Load render system module with a profiler and a state trace
+            LLGL::RenderingProfiler profiler;
+
+            LLGL::RendererConfigurationOpenGL rendererConfig;
+            {
+                rendererConfig.profiler             = &profiler;
+                rendererConfig.stateTraceFilename   = g_traceFilename;
+            }
+            LLGL::RenderSystemDescriptor rendererDesc;
+            {
+                rendererDesc.moduleName         = (argc > 1 ? argv[1] : "OpenGL");
+                rendererDesc.rendererConfig     = &rendererConfig;
+                rendererDesc.rendererConfigSize = sizeof(rendererConfig);
+            }
+            auto renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+            // Create render context
+            LLGL::RenderContextDescriptor contextDesc;
+            {
+                contextDesc.videoMode.resolution = { 800, 600 };
+            }
+            auto context = renderer->CreateRenderContext(contextDesc);
+
+            auto& window = static_cast<LLGL::Window&>(context->GetSurface());
+            window.SetTitle(L"LLGL Test: GL State Counters");
+
+            // Create vertex buffer
+            LLGL::VertexFormat vertexFormat;
+            vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+            const float vertices[] = { -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, -1.0f };
+
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.size           = sizeof(vertices);
+                vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+                vertexBufferDesc.vertexAttribs  = vertexFormat.attributes;
+            }
+            auto vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, vertices);
+
+            // Create shaders
+            LLGL::ShaderDescriptor vertShaderDesc;
+            {
+                vertShaderDesc.type                 = LLGL::ShaderType::Vertex;
+                vertShaderDesc.source               = "#version 130\nin vec2 position;\nvoid main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+                vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+                vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+            }
+            auto vertShader = renderer->CreateShader(vertShaderDesc);
+
+            LLGL::ShaderDescriptor fragShaderDesc;
+            {
+                fragShaderDesc.type         = LLGL::ShaderType::Fragment;
+                fragShaderDesc.source       = "#version 130\nout vec4 fragColor;\nvoid main() { fragColor = vec4(1.0); }\n";
+                fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+            }
+            auto fragShader = renderer->CreateShader(fragShaderDesc);
+
+            for (auto shader : { vertShader, fragShader })
+            {
+                if (shader->HasErrors())
+                    throw std::runtime_error(shader->GetReport());
+            }
+
+            LLGL::ShaderProgramDescriptor shaderProgramDesc;
+            {
+                shaderProgramDesc.vertexShader      = vertShader;
+                shaderProgramDesc.fragmentShader    = fragShader;
+            }
+            auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+            if (shaderProgram->HasErrors())
+                throw std::runtime_error(shaderProgram->GetReport());
+
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram = shaderProgram;
+            }
+            auto pipeline = renderer->CreatePipelineState(pipelineDesc);
+
+            // Record command buffer with redundant vertex buffer bindings
+            LLGL::CommandBufferDescriptor cmdBufferDesc;
+            {
+                cmdBufferDesc.flags = LLGL::CommandBufferFlags::DeferredSubmit;
+            }
+            auto cmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
+
+            cmdBufferDesc.flags |= LLGL::CommandBufferFlags::Optimize;
+            auto optimizedCmdBuffer = renderer->CreateCommandBuffer(cmdBufferDesc);
+
+            for (auto commands : { cmdBuffer, optimizedCmdBuffer })
+            {
+                commands->Begin();
+                {
+                    commands->BeginRenderPass(*context);
+                    {
+                        commands->SetPipelineState(*pipeline);
+                        commands->SetVertexBuffer(*vertexBuffer);
+                        commands->SetVertexBuffer(*vertexBuffer);
+                        commands->Draw(3, 0);
+                    }
+                    commands->EndRenderPass();
+                }
+                commands->End();
+            }
+
+            // Submit command buffer twice, then the optimized command buffer once, and store the counters of each submission
+            auto queue = renderer->GetCommandQueue();
+
+            for (auto commands : { cmdBuffer, cmdBuffer, optimizedCmdBuffer })
+            {
+                queue->Submit(*commands);
+                queue->WaitIdle();
+
+                LLGL::FrameProfile profile;
+                profiler.NextProfile(&profile);
+                profiles.push_back(GetStateCounters(profile));
+                frameProfiles.push_back(profile);
+            }
+
+            // Unload render system to flush the state trace
+            LLGL::RenderSystem::Unload(std::move(renderer));
+        }
+
+        // Validate counters of the profiler
+        const auto& first   = profiles[0];
+        const auto& second  = profiles[1];
+
+        Check(SumIssued(first) > 0, "first submission did not issue any GL state changes");
+        Check(first.elided[3] >= 1, "redundant vertex array binding was not elided in first submission");
+        Check(second.issued[3] == 0 && second.elided[3] >= 2, "vertex array bindings were not elided in second submission");
+        Check(SumElided(second) > 0, "second submission did not elide any GL state changes");
+        Check(SumIssued(second) <= SumIssued(first), "second submission issued more GL state changes than the first one");
+
+        std::cout << "profiler counters: ok (issued/elided: " << SumIssued(first) << '/' << SumElided(first) << ", then " << SumIssued(second) << '/' << SumElided(second) << ')' << std::endl;
+
+        // Validate optimizer counters of the profiler
+        const auto& optimized = frameProfiles[2];
+
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            const auto& profile = frameProfiles[i];
+            Check(
+                profile.optimizedStateCommands == 0 && profile.optimizedClearCommands == 0 && profile.optimizedDrawCommands == 0,
+                "optimizer counters reported for command buffer without optimization in submission " + std::to_string(i)
+            );
+        }
+
+        Check(optimized.optimizedStateCommands >= 1, "redundant vertex array binding was not removed by optimizer");
+        Check(optimized.elidedVertexArrayBindings < second.elided[3], "optimized command buffer did not reduce the redundant vertex array bindings");
+
+        std::cout << "optimizer counters: ok (removed state/clear commands: " << optimized.optimizedStateCommands << '/' << optimized.optimizedClearCommands << ", merged draws: " << optimized.optimizedDrawCommands << ')' << std::endl;
+
+        // Validate trace against the profiler
+        const auto submissions = ReadTrace(g_traceFilename);
+
+        Check(submissions.size() == profiles.size(), "expected " + std::to_string(profiles.size()) + " submissions in GL state trace, but got " + std::to_string(submissions.size()));
+        for (std::size_t i = 0; i < submissions.size(); ++i)
+        {
+            if (::memcmp(&submissions[i], &profiles[i], sizeof(StateCounters)) != 0)
+                throw std::runtime_error("MISMATCH between GL state trace and profiler counters in submission " + std::to_string(i));
+        }
+
+        std::cout << "state trace: ok" << std::endl;
+
+        std::remove(g_traceFilename);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,246 @@
+/*
+ * Test_GLStatePool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "../sources/Renderer/OpenGL/RenderState/GLStatePool.h"
+#include <vector>
+#include <stdexcept>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+
+/*
+Benchmark and test for the GL state pool:
+creates 50k graphics pipelines that share a few thousand unique depth, rasterizer, and blend states and a few hundred shader binding layouts,
+so the pool holds thousands of entries and every state object is shared by several pipelines.
+Then releases all pipelines again in interleaved order. After each step, the number of pooled states must match the number of unique states
+that are still referenced, i.e. all pipelines with equal states share the same state object and the pool is empty after all pipelines are released.
+The test links the GL module directly to query the state pool of the loaded module.
+*/
+
+static const std::uint32_t  g_numPipelines          = 50000;
+static const std::uint32_t  g_numRounds             = 4;
+static const std::uint32_t  g_numDepthStates        = 4096;
+static const std::uint32_t  g_numRasterizerStates   = 4096;
+static const std::uint32_t  g_numBlendStates        = 4096;
+static const std::uint32_t  g_numBindingLayouts     = 256;
+
+// Returns the indices of the unique states the specified pipeline refers to.
+static std::uint32_t GetDepthStateIndex(std::uint32_t index)       { return (index % g_numDepthStates); }
+static std::uint32_t GetRasterizerStateIndex(std::uint32_t index)  { return ((index / 3) % g_numRasterizerStates); }
+static std::uint32_t GetBlendStateIndex(std::uint32_t index)       { return ((index / 7) % g_numBlendStates); }
+static std::uint32_t GetBindingLayoutIndex(std::uint32_t index)    { return (index % g_numBindingLayouts); }
+
+static void InitializePipelineStates(LLGL::GraphicsPipelineDescriptor& desc, std::uint32_t index)
+{
+    /* Select depth-stencil state by its stencil read mask */
+    desc.depth.testEnabled                  = true;
+    desc.depth.writeEnabled                 = true;
+    desc.stencil.testEnabled                = true;
+    desc.stencil.front.readMask             = GetDepthStateIndex(index);
+    desc.stencil.back.readMask              = GetDepthStateIndex(index);
+
+    /* Select rasterizer state by its line width */
+    desc.rasterizer.lineWidth               = 1.0f + static_cast<float>(GetRasterizerStateIndex(index));
+
+    /* Select blend state by its static blend factor */
+    desc.blend.blendFactor                  = { static_cast<float>(GetBlendStateIndex(index)) / g_numBlendStates, 0.0f, 0.0f, 1.0f };
+}
+
+static void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::runtime_error(message);
+}
+
+// Returns the number of unique values the specified selector returns for all pipelines in [first, g_numPipelines) with the specified step.
+static std::size_t CountUniqueStates(std::uint32_t (*selector)(std::uint32_t), std::uint32_t numStates, std::uint32_t first, std::uint32_t step)
+{
+    std::vector<bool> used(numStates, false);
+    std::size_t count = 0;
+
+    for (std::uint32_t i = first; i < g_numPipelines; i += step)
+    {
+        const auto stateIndex = selector(i);
+        if (!used[stateIndex])
+        {
+            used[stateIndex] = true;
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+// Checks that the state pool holds exactly the unique states of all pipelines in [first, g_numPipelines) with the specified step.
+static void CheckPoolStats(const std::string& context, std::uint32_t first, std::uint32_t step)
+{
+    const auto stats = LLGL::GLStatePool::Get().GetStats();
+
+    const auto Compare = [&context](const char* name, std::size_t actual, std::size_t expected)
+    {
+        Check(
+            actual == expected,
+            "MISMATCH in number of pooled " + std::string(name) + " " + context + ": " +
+            std::to_string(actual) + " (expected " + std::to_string(expected) + ")"
+        );
+    };
+
+    Compare("depth-stencil states", stats.numDepthStencilStates, CountUniqueStates(GetDepthStateIndex, g_numDepthStates, first, step));
+    Compare("rasterizer states", stats.numRasterizerStates, CountUniqueStates(GetRasterizerStateIndex, g_numRasterizerStates, first, step));
+    Compare("blend states", stats.numBlendStates, CountUniqueStates(GetBlendStateIndex, g_numBlendStates, first, step));
+    Compare("shader binding layouts", stats.numShaderBindingLayouts, CountUniqueStates(GetBindingLayoutIndex, g_numBindingLayouts, first, step));
+}
+
+// Checks that the state pool is empty.
+static void CheckPoolEmpty(const std::string& context)
+{
+    CheckPoolStats(context, g_numPipelines, 1);
+}
+
+static double ElapsedMilliseconds(const std::chrono::high_resolution_clock::time_point& startTime)
+{
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load render system module
+        auto renderer = LLGL::RenderSystem::Load(argc > 1 ? argv[1] : "OpenGL");
+
+        // Create render context
+        LLGL::RenderContextDescriptor contextDesc;
+        {
+            contextDesc.videoMode.resolution = { 800, 600 };
+        }
+        auto context = renderer->CreateRenderContext(contextDesc);
+
+        auto& window = static_cast<LLGL::Window&>(context->GetSurface());
+        window.SetTitle(L"LLGL Test: GL State Pool ( " + std::to_wstring(g_numPipelines) + L" PSOs )");
+
+        // Create shaders
+        LLGL::VertexFormat vertexFormat;
+        vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+        LLGL::ShaderDescriptor vertShaderDesc;
+        {
+            vertShaderDesc.type                 = LLGL::ShaderType::Vertex;
+            vertShaderDesc.source               = "#version 130\nin vec2 position;\nvoid main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+            vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+            vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+        }
+        auto vertShader = renderer->CreateShader(vertShaderDesc);
+
+        LLGL::ShaderDescriptor fragShaderDesc;
+        {
+            fragShaderDesc.type         = LLGL::ShaderType::Fragment;
+            fragShaderDesc.source       = "#version 130\nout vec4 fragColor;\nvoid main() { fragColor = vec4(1.0); }\n";
+            fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+        }
+        auto fragShader = renderer->CreateShader(fragShaderDesc);
+
+        for (auto shader : { vertShader, fragShader })
+        {
+            if (shader->HasErrors())
+                throw std::runtime_error(shader->GetReport());
+        }
+
+        LLGL::ShaderProgramDescriptor shaderProgramDesc;
+        {
+            shaderProgramDesc.vertexShader      = vertShader;
+            shaderProgramDesc.fragmentShader    = fragShader;
+        }
+        auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+        if (shaderProgram->HasErrors())
+            throw std::runtime_error(shaderProgram->GetReport());
+
+        // Create pipeline layouts with a single named binding at a different slot each
+        std::vector<LLGL::PipelineLayout*> pipelineLayouts(g_numBindingLayouts);
+        for (std::uint32_t i = 0; i < g_numBindingLayouts; ++i)
+        {
+            LLGL::PipelineLayoutDescriptor layoutDesc;
+            {
+                layoutDesc.bindings =
+                {
+                    LLGL::BindingDescriptor{ "colorMap", LLGL::ResourceType::Texture, LLGL::BindFlags::Sampled, LLGL::StageFlags::FragmentStage, i }
+                };
+            }
+            pipelineLayouts[i] = renderer->CreatePipelineLayout(layoutDesc);
+        }
+
+        CheckPoolEmpty("before any pipeline is created");
+
+        // Create and release all pipelines several times
+        std::vector<LLGL::PipelineState*> pipelines(g_numPipelines);
+
+        double timeCreate   = 0.0;
+        double timeRelease  = 0.0;
+
+        for (std::uint32_t round = 0; round < g_numRounds; ++round)
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            for (std::uint32_t i = 0; i < g_numPipelines; ++i)
+            {
+                LLGL::GraphicsPipelineDescriptor pipelineDesc;
+                {
+                    pipelineDesc.shaderProgram  = shaderProgram;
+                    pipelineDesc.pipelineLayout = pipelineLayouts[GetBindingLayoutIndex(i)];
+                    InitializePipelineStates(pipelineDesc, i);
+                }
+                pipelines[i] = renderer->CreatePipelineState(pipelineDesc);
+            }
+
+            timeCreate += ElapsedMilliseconds(startTime);
+
+            const auto roundContext = " in round " + std::to_string(round);
+            CheckPoolStats("after creating all pipelines" + roundContext, 0, 1);
+
+            // Release even pipelines first and odd pipelines second, so shared states are released while others still refer to them
+            for (std::uint32_t parity = 0; parity < 2; ++parity)
+            {
+                startTime = std::chrono::high_resolution_clock::now();
+
+                for (std::uint32_t i = parity; i < g_numPipelines; i += 2)
+                    renderer->Release(*pipelines[i]);
+
+                timeRelease += ElapsedMilliseconds(startTime);
+
+                if (parity == 0)
+                    CheckPoolStats("after releasing even pipelines" + roundContext, 1, 2);
+                else
+                    CheckPoolEmpty("after releasing all pipelines" + roundContext);
+            }
+        }
+
+        std::cout << "pooled states: ok (" << g_numDepthStates << " depth-stencil, " << g_numRasterizerStates << " rasterizer, "
+            << g_numBlendStates << " blend states, " << g_numBindingLayouts << " binding layouts)" << std::endl;
+
+        // Print average times per round and per pipeline
+        const auto avgCreate    = timeCreate / g_numRounds;
+        const auto avgRelease   = timeRelease / g_numRounds;
+        std::cout << "state pool with " << g_numPipelines << " PSOs:" << std::endl;
+        std::cout << "  create:  " << avgCreate << " ms (" << (avgCreate * 1000.0 / g_numPipelines) << " us per PSO)" << std::endl;
+        std::cout << "  release: " << avgRelease << " ms (" << (avgRelease * 1000.0 / g_numPipelines) << " us per PSO)" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,155 @@
+/*
+ * Test_GLTextureViewPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <vector>
+#include <stdexcept>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+
+/*
+Benchmark for the GL texture view pool:
+creates a few hundred textures with 128 texture views each (via resource heaps), so the pool manages tens of thousands of texture views.
+Each texture gets two resource heaps with the same views, so every texture view is shared once.
+Then measures the time to release one resource heap per texture, and to release the textures including all of their views.
+*/
+
+static const std::uint32_t  g_numTextures       = 256;
+static const std::uint32_t  g_numMipLevels      = 4;
+static const std::uint32_t  g_numSwizzles       = 32;
+static const std::uint32_t  g_numViewsPerTex    = g_numMipLevels * g_numSwizzles;
+
+static LLGL::TextureSwizzleRGBA GetSwizzle(std::uint32_t index)
+{
+    static const LLGL::TextureSwizzle components[] = { LLGL::TextureSwizzle::Red, LLGL::TextureSwizzle::Green, LLGL::TextureSwizzle::Blue, LLGL::TextureSwizzle::Alpha };
+
+    LLGL::TextureSwizzleRGBA swizzle;
+    {
+        swizzle.r = components[index % 4];
+        swizzle.g = components[(index / 4) % 4];
+        swizzle.a = (index / 16 != 0 ? LLGL::TextureSwizzle::One : LLGL::TextureSwizzle::Alpha);
+    }
+    return swizzle;
+}
+
+static double ElapsedMilliseconds(const std::chrono::high_resolution_clock::time_point& startTime)
+{
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load render system module
+        auto renderer = LLGL::RenderSystem::Load(argc > 1 ? argv[1] : "OpenGL");
+
+        // Create render context
+        LLGL::RenderContextDescriptor contextDesc;
+        {
+            contextDesc.videoMode.resolution = { 800, 600 };
+        }
+        auto context = renderer->CreateRenderContext(contextDesc);
+
+        auto& window = static_cast<LLGL::Window&>(context->GetSurface());
+        window.SetTitle(L"LLGL Test: GL Texture View Pool ( " + std::to_wstring(g_numTextures * g_numViewsPerTex) + L" views )");
+
+        // Create pipeline layout with a single texture binding
+        LLGL::PipelineLayoutDescriptor layoutDesc;
+        {
+            layoutDesc.bindings =
+            {
+                LLGL::BindingDescriptor{ LLGL::ResourceType::Texture, LLGL::BindFlags::Sampled, LLGL::StageFlags::FragmentStage, 0 }
+            };
+        }
+        auto pipelineLayout = renderer->CreatePipelineLayout(layoutDesc);
+
+        // Create textures with MIP-maps
+        std::vector<LLGL::Texture*> textures(g_numTextures);
+
+        LLGL::TextureDescriptor texDesc;
+        {
+            texDesc.type        = LLGL::TextureType::Texture2D;
+            texDesc.bindFlags   = LLGL::BindFlags::Sampled;
+            texDesc.miscFlags   = 0;
+            texDesc.format      = LLGL::Format::RGBA8UNorm;
+            texDesc.extent      = { 64, 64, 1 };
+            texDesc.mipLevels   = g_numMipLevels;
+        }
+        for (auto& tex : textures)
+            tex = renderer->CreateTexture(texDesc);
+
+        // Create two resource heaps with the same texture views for each texture
+        std::vector<LLGL::ResourceHeap*> resourceHeaps(g_numTextures * 2);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (std::uint32_t i = 0; i < g_numTextures; ++i)
+        {
+            LLGL::ResourceHeapDescriptor heapDesc;
+            {
+                heapDesc.pipelineLayout = pipelineLayout;
+                heapDesc.resourceViews.reserve(g_numViewsPerTex);
+                for (std::uint32_t j = 0; j < g_numViewsPerTex; ++j)
+                {
+                    LLGL::TextureViewDescriptor texViewDesc;
+                    {
+                        texViewDesc.type                        = LLGL::TextureType::Texture2D;
+                        texViewDesc.format                      = LLGL::Format::RGBA8UNorm;
+                        texViewDesc.subresource.baseMipLevel    = j % g_numMipLevels;
+                        texViewDesc.subresource.numMipLevels    = 1;
+                        texViewDesc.swizzle                     = GetSwizzle(j / g_numMipLevels);
+                    }
+                    heapDesc.resourceViews.push_back(LLGL::ResourceViewDescriptor{ textures[i], texViewDesc });
+                }
+            }
+            resourceHeaps[i * 2    ] = renderer->CreateResourceHeap(heapDesc);
+            resourceHeaps[i * 2 + 1] = renderer->CreateResourceHeap(heapDesc);
+        }
+
+        const auto timeCreate = ElapsedMilliseconds(startTime);
+
+        // Release first resource heap of each texture, which only decrements the reference counters of the texture views
+        startTime = std::chrono::high_resolution_clock::now();
+
+        for (std::uint32_t i = 0; i < g_numTextures; ++i)
+            renderer->Release(*resourceHeaps[i * 2]);
+
+        const auto timeReleaseHeaps = ElapsedMilliseconds(startTime);
+
+        // Release all textures, which also deletes all texture views that were derived from them
+        startTime = std::chrono::high_resolution_clock::now();
+
+        for (auto tex : textures)
+            renderer->Release(*tex);
+
+        const auto timeReleaseTextures = ElapsedMilliseconds(startTime);
+
+        for (std::uint32_t i = 0; i < g_numTextures; ++i)
+            renderer->Release(*resourceHeaps[i * 2 + 1]);
+
+        // Print timings
+        std::cout << "texture view pool with " << g_numTextures << " x " << g_numViewsPerTex << " views:" << std::endl;
+        std::cout << "  create heaps:     " << timeCreate << " ms" << std::endl;
+        std::cout << "  release heaps:    " << timeReleaseHeaps << " ms" << std::endl;
+        std::cout << "  release textures: " << timeReleaseTextures << " ms (" << (timeReleaseTextures * 1000.0 / g_numTextures) << " us per texture)" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
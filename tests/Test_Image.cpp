@@ -6,7 +6,10 @@
  */
 
 #include <LLGL/Image.h>
+#include <LLGL/Blob.h>
 #include <iostream>
+#include <fstream>
+#include <string.h>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
@@ -108,6 +111,187 @@ void Test_Resize()
     SaveImagePNG(img1, "Output/img1-resize-smaller.png");
 }
 
+void Test_ResizeFiltered()
+{
+    const struct
+    {
+        LLGL::ImageFilter   filter;
+        const char*         name;
+    }
+    filters[] =
+    {
+        { LLGL::ImageFilter::Nearest, "nearest" },
+        { LLGL::ImageFilter::Box,     "box"     },
+        { LLGL::ImageFilter::Linear,  "linear"  },
+        { LLGL::ImageFilter::Lanczos, "lanczos" },
+        { LLGL::ImageFilter::Kaiser,  "kaiser"  },
+    };
+
+    for (const auto& f : filters)
+    {
+        auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+        img1.Resize(LLGL::Extent3D { 100, 60, 1 }, f.filter, true, LLGL::Constants::maxThreadCount);
+        SaveImagePNG(img1, std::string("Output/img1-resize-") + f.name + "-smaller.png");
+
+        img1.Resize(LLGL::Extent3D { 800, 480, 1 }, f.filter, true, LLGL::Constants::maxThreadCount);
+        SaveImagePNG(img1, std::string("Output/img1-resize-") + f.name + "-larger.png");
+    }
+}
+
+void Test_MipChain()
+{
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    auto mipChain = LLGL::GenerateMipChain(img1, LLGL::TextureType::Texture2D, LLGL::ImageFilter::Kaiser, true, 0, LLGL::Constants::maxThreadCount);
+
+    for (std::size_t i = 0; i < mipChain.levels.size(); ++i)
+    {
+        const auto& level = mipChain.levels[i];
+        LLGL::Image mipImage { mipChain.extents[i], level.format, level.dataType, LLGL::GenerateEmptyByteBuffer(level.dataSize, false) };
+        ::memcpy(mipImage.GetData(), level.data, level.dataSize);
+        SaveImagePNG(mipImage, "Output/img1-mip" + std::to_string(i) + ".png");
+    }
+}
+
+void Test_MappedImage()
+{
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+
+    /* Store raw image buffer with a header, so the image buffer starts at an offset within the file */
+    const std::uint32_t header[4] = { img1.GetExtent().width, img1.GetExtent().height, 0, 0 };
+    {
+        std::ofstream file { "Output/img1-raw.bin", std::ios::out | std::ios::binary };
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(img1.GetData()), img1.GetDataSize());
+    }
+
+    /* Map raw image into memory and read pixels without copying the image buffer */
+    std::shared_ptr<LLGL::Blob> blob = LLGL::Blob::CreateFromMappedFile("Output/img1-raw.bin");
+    if (!blob)
+        throw std::runtime_error("failed to map file into memory: Output/img1-raw.bin");
+
+    LLGL::Image img1Mapped { img1.GetExtent(), img1.GetFormat(), img1.GetDataType(), blob, sizeof(header) };
+    if (img1Mapped.GetSrcDesc().data != reinterpret_cast<const char*>(blob->GetData()) + sizeof(header))
+        throw std::runtime_error("mapped image does not refer to shared image buffer");
+    if (::memcmp(img1Mapped.GetSrcDesc().data, img1.GetData(), img1.GetDataSize()) != 0)
+        throw std::runtime_error("mapped image does not match source image");
+
+    LLGL::Image img1Sub { LLGL::Extent3D { 109, 110, 1 }, LLGL::ImageFormat::BGR, img1.GetDataType() };
+    img1Mapped.GetView().ReadPixels(LLGL::Offset3D { 109, 0, 0 }, img1Sub.GetExtent(), img1Sub.GetDstDesc());
+    SaveImagePNG(img1Sub, "Output/img1Sub-mapped.png");
+
+    /* Blit from the mapped image into itself, which detaches the shared image buffer */
+    img1Mapped.Blit(LLGL::Offset3D { 0, 0, 0 }, img1Mapped, LLGL::Offset3D { 64, 64, 0 }, LLGL::Extent3D { 128, 128, 1 });
+    SaveImagePNG(img1Mapped, "Output/img1-mapped-blit.png");
+
+    if (::memcmp(blob->GetData(), header, sizeof(header)) != 0)
+        throw std::runtime_error("writing to mapped image modified the shared image buffer");
+}
+
+// Returns the pixel at the specified position as raw bytes.
+static std::string GetPixelBytes(const LLGL::Image& img, std::uint32_t x, std::uint32_t y, std::uint32_t z)
+{
+    const auto bpp = img.GetBytesPerPixel();
+    const auto pos = ((static_cast<std::size_t>(z) * img.GetExtent().height + y) * img.GetExtent().width + x) * bpp;
+    return std::string(reinterpret_cast<const char*>(img.GetSrcDesc().data) + pos, bpp);
+}
+
+// Compares the transformed image with the original image pixel by pixel; 'mapPos' maps a position in the transformed image to the original image.
+template <typename TMapPos>
+static void VerifyTransformedImage(const LLGL::Image& result, const LLGL::Image& original, const LLGL::Extent3D& expectedExtent, const char* name, TMapPos mapPos)
+{
+    const auto& extent = result.GetExtent();
+    if (extent.width != expectedExtent.width || extent.height != expectedExtent.height || extent.depth != expectedExtent.depth)
+        throw std::runtime_error(std::string(name) + ": unexpected image extent");
+
+    for (std::uint32_t z = 0; z < extent.depth; ++z)
+    {
+        for (std::uint32_t y = 0; y < extent.height; ++y)
+        {
+            for (std::uint32_t x = 0; x < extent.width; ++x)
+            {
+                std::uint32_t srcX = x, srcY = y, srcZ = z;
+                mapPos(srcX, srcY, srcZ);
+                if (GetPixelBytes(result, x, y, z) != GetPixelBytes(original, srcX, srcY, srcZ))
+                    throw std::runtime_error(std::string(name) + ": pixel mismatch at (" + std::to_string(x) + ", " + std::to_string(y) + ", " + std::to_string(z) + ")");
+            }
+        }
+    }
+}
+
+void Test_RotateAndMirror()
+{
+    const LLGL::ImageFormat formats[]   = { LLGL::ImageFormat::R, LLGL::ImageFormat::RGB, LLGL::ImageFormat::RGBA, LLGL::ImageFormat::RGB, LLGL::ImageFormat::RGBA };
+    const LLGL::DataType    dataTypes[] = { LLGL::DataType::UInt8, LLGL::DataType::UInt8, LLGL::DataType::UInt8, LLGL::DataType::Float32, LLGL::DataType::Float64 };
+    const LLGL::Extent3D    extents[]   = { { 1, 1, 1 }, { 67, 45, 2 }, { 130, 130, 3 }, { 300, 7, 1 } };
+    const std::size_t       threadCounts[] = { 0, LLGL::Constants::maxThreadCount };
+
+    for (std::size_t i = 0; i < sizeof(formats)/sizeof(formats[0]); ++i)
+    {
+        for (const auto& extent : extents)
+        {
+            for (auto threadCount : threadCounts)
+            {
+                /* Fill image with unique byte pattern */
+                LLGL::Image original { extent, formats[i], dataTypes[i] };
+                auto bytes = reinterpret_cast<std::uint8_t*>(original.GetData());
+                for (std::size_t j = 0; j < original.GetDataSize(); ++j)
+                    bytes[j] = static_cast<std::uint8_t>((j * 7919u) >> 3);
+
+                const auto w = extent.width, h = extent.height, d = extent.depth;
+                const LLGL::Extent3D transposedExtent { h, w, d };
+
+                auto img = original;
+                img.MirrorYZPlane(threadCount);
+                VerifyTransformedImage(img, original, extent, "MirrorYZPlane", [&](std::uint32_t& x, std::uint32_t&, std::uint32_t&) { x = w - 1 - x; });
+
+                img = original;
+                img.MirrorXZPlane(threadCount);
+                VerifyTransformedImage(img, original, extent, "MirrorXZPlane", [&](std::uint32_t&, std::uint32_t& y, std::uint32_t&) { y = h - 1 - y; });
+
+                img = original;
+                img.MirrorXYPlane(threadCount);
+                VerifyTransformedImage(img, original, extent, "MirrorXYPlane", [&](std::uint32_t&, std::uint32_t&, std::uint32_t& z) { z = d - 1 - z; });
+
+                img = original;
+                img.Transpose(threadCount);
+                VerifyTransformedImage(img, original, transposedExtent, "Transpose", [&](std::uint32_t& x, std::uint32_t& y, std::uint32_t&) { std::swap(x, y); });
+
+                img = original;
+                img.Rotate90(true, threadCount);
+                VerifyTransformedImage(
+                    img, original, transposedExtent, "Rotate90(clockwise)",
+                    [&](std::uint32_t& x, std::uint32_t& y, std::uint32_t&) { const auto srcX = y; y = h - 1 - x; x = srcX; }
+                );
+
+                img = original;
+                img.Rotate90(false, threadCount);
+                VerifyTransformedImage(
+                    img, original, transposedExtent, "Rotate90(counter-clockwise)",
+                    [&](std::uint32_t& x, std::uint32_t& y, std::uint32_t&) { const auto srcY = x; x = w - 1 - y; y = srcY; }
+                );
+
+                /* Blit overlapping region within the same image */
+                if (w > 1 && h > 1)
+                {
+                    img = original;
+                    img.Blit(LLGL::Offset3D { 1, 1, 0 }, img, LLGL::Offset3D { 0, 0, 0 }, LLGL::Extent3D { w - 1, h - 1, d }, threadCount);
+                    VerifyTransformedImage(
+                        img, original, extent, "Blit",
+                        [&](std::uint32_t& x, std::uint32_t& y, std::uint32_t&) { if (x > 0 && y > 0) { --x; --y; } }
+                    );
+                }
+            }
+        }
+    }
+
+    /* Rotate a real image for visual inspection */
+    auto img1 = LoadImage("Media/Textures/Grid.png", LLGL::ImageFormat::RGBA);
+    img1.Rotate90(true, LLGL::Constants::maxThreadCount);
+    SaveImagePNG(img1, "Output/img1-rotated.png");
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -115,6 +299,10 @@ int main(int argc, char* argv[])
         //Test_PixelOperations();
         //Test_Blit();
         Test_Resize();
+        Test_ResizeFiltered();
+        Test_MipChain();
+        Test_MappedImage();
+        Test_RotateAndMirror();
     }
     catch (const std::exception& e)
     {
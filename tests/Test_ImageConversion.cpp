@@ -0,0 +1,453 @@
+/*
+ * Test_ImageConversion.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Image.h>
+#include <LLGL/ImageStreamConverter.h>
+#include <LLGL/Format.h>
+#include "../sources/Core/ImageConversionKernels.h"
+#include "../sources/Core/Float16Compressor.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+
+
+static unsigned int g_seed = 1;
+
+static int FastRand()
+{
+    g_seed = (214013 * g_seed + 2531011);
+    return (g_seed >> 16) & 0x7FFF;
+}
+
+// Fills the buffer with random values in the normalized range of the data type.
+static void FillRandom(std::vector<char>& buffer, LLGL::DataType dataType)
+{
+    if (dataType == LLGL::DataType::Float32)
+    {
+        auto data = reinterpret_cast<float*>(buffer.data());
+        for (std::size_t i = 0, n = buffer.size() / sizeof(float); i < n; ++i)
+            data[i] = static_cast<float>(FastRand()) / 32767.0f;
+    }
+    else if (dataType == LLGL::DataType::Float16)
+    {
+        auto data = reinterpret_cast<std::uint16_t*>(buffer.data());
+        for (std::size_t i = 0, n = buffer.size() / sizeof(std::uint16_t); i < n; ++i)
+            data[i] = static_cast<std::uint16_t>(FastRand() % 0x3C00); // [0, 1)
+    }
+    else
+    {
+        for (auto& x : buffer)
+            x = static_cast<char>(FastRand());
+    }
+}
+
+// Returns the average time (in milliseconds) of the specified image conversion.
+static double MeasureConversion(const LLGL::SrcImageDescriptor& srcDesc, const LLGL::DstImageDescriptor& dstDesc, std::size_t threadCount, int numRuns)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (int i = 0; i < numRuns; ++i)
+        LLGL::ConvertImageBuffer(srcDesc, dstDesc, threadCount);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count() / numRuns;
+}
+
+// Compares the SIMD kernel of the specified data type conversion with the generic fallback, both on a single thread.
+static void BenchmarkDataTypeConversion(const char* name, LLGL::DataType srcDataType, LLGL::DataType dstDataType)
+{
+    const std::size_t   numElements = 2048 * 2048 * 4;
+    const int           numRuns     = 5;
+
+    std::vector<char> srcBuffer(numElements * LLGL::DataTypeSize(srcDataType));
+    std::vector<char> dstBufferGeneric(numElements * LLGL::DataTypeSize(dstDataType));
+    std::vector<char> dstBufferSIMD(dstBufferGeneric.size());
+
+    FillRandom(srcBuffer, srcDataType);
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2);
+
+    auto kernel = LLGL::FindDataTypeConversionKernel(srcDataType, dstDataType);
+    if (kernel == nullptr)
+    {
+        std::cout << " no kernel for this CPU" << std::endl;
+        return;
+    }
+
+    /* Measure generic fallback */
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < numRuns; ++i)
+        LLGL::ConvertDataTypeGeneric(srcDataType, srcBuffer.data(), dstDataType, dstBufferGeneric.data(), numElements);
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto timeGeneric = std::chrono::duration<double, std::milli>(endTime - startTime).count() / numRuns;
+
+    /* Measure SIMD kernel */
+    startTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < numRuns; ++i)
+        kernel(srcBuffer.data(), dstBufferSIMD.data(), numElements);
+    endTime = std::chrono::high_resolution_clock::now();
+    auto timeSIMD = std::chrono::duration<double, std::milli>(endTime - startTime).count() / numRuns;
+
+    /* Both paths must produce the same output */
+    bool equal = (::memcmp(dstBufferGeneric.data(), dstBufferSIMD.data(), dstBufferSIMD.size()) == 0);
+
+    std::cout << " generic: " << std::setw(8) << timeGeneric << " ms";
+    std::cout << ", SIMD: " << std::setw(8) << timeSIMD << " ms";
+    std::cout << ", speedup: " << std::setw(6) << (timeGeneric / timeSIMD) << "x";
+    std::cout << (equal ? "" : " (MISMATCH)") << std::endl;
+}
+
+// Measures the bandwidth (in GB/s) of the specified image conversion, counting both the source and destination buffer.
+static double MeasureBandwidth(std::size_t numBytes, double milliseconds)
+{
+    return (static_cast<double>(numBytes) / (milliseconds * 1.0e6));
+}
+
+static void BenchmarkFusedConversion(
+    const char*         name,
+    LLGL::ImageFormat   srcFormat,
+    LLGL::DataType      srcDataType,
+    LLGL::ImageFormat   dstFormat,
+    LLGL::DataType      dstDataType,
+    std::size_t         threadCount)
+{
+    const std::size_t   numPixels   = 2048 * 2048;
+    const int           numRuns     = 5;
+
+    std::vector<char> srcBuffer(numPixels * LLGL::ImageFormatSize(srcFormat) * LLGL::DataTypeSize(srcDataType));
+    std::vector<char> tmpBuffer(numPixels * LLGL::ImageFormatSize(srcFormat) * LLGL::DataTypeSize(dstDataType));
+    std::vector<char> dstBufferTwoPass(numPixels * LLGL::ImageFormatSize(dstFormat) * LLGL::DataTypeSize(dstDataType));
+    std::vector<char> dstBufferFused(dstBufferTwoPass.size());
+
+    FillRandom(srcBuffer, srcDataType);
+
+    const LLGL::SrcImageDescriptor srcDesc { srcFormat, srcDataType, srcBuffer.data(), srcBuffer.size() };
+    const LLGL::SrcImageDescriptor tmpSrcDesc { srcFormat, dstDataType, tmpBuffer.data(), tmpBuffer.size() };
+    const LLGL::DstImageDescriptor tmpDstDesc { srcFormat, dstDataType, tmpBuffer.data(), tmpBuffer.size() };
+    const LLGL::DstImageDescriptor dstDescTwoPass { dstFormat, dstDataType, dstBufferTwoPass.data(), dstBufferTwoPass.size() };
+    const LLGL::DstImageDescriptor dstDescFused { dstFormat, dstDataType, dstBufferFused.data(), dstBufferFused.size() };
+
+    /* Measure two passes with an intermediate buffer, first for the data type and then for the format */
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < numRuns; ++i)
+    {
+        LLGL::ConvertImageBuffer(srcDesc, tmpDstDesc, threadCount);
+        LLGL::ConvertImageBuffer(tmpSrcDesc, dstDescTwoPass, threadCount);
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto timeTwoPass = std::chrono::duration<double, std::milli>(endTime - startTime).count() / numRuns;
+
+    /* Measure single pass */
+    auto timeFused = MeasureConversion(srcDesc, dstDescFused, threadCount, numRuns);
+
+    /* Measure memcpy of the destination buffer as reference */
+    startTime = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < numRuns; ++i)
+        ::memcpy(dstBufferTwoPass.data(), dstBufferFused.data(), dstBufferFused.size());
+    endTime = std::chrono::high_resolution_clock::now();
+    auto timeMemcpy = std::chrono::duration<double, std::milli>(endTime - startTime).count() / numRuns;
+
+    /* Both paths must produce the same output */
+    LLGL::ConvertImageBuffer(srcDesc, tmpDstDesc, threadCount);
+    LLGL::ConvertImageBuffer(tmpSrcDesc, dstDescTwoPass, threadCount);
+    bool equal = (::memcmp(dstBufferTwoPass.data(), dstBufferFused.data(), dstBufferFused.size()) == 0);
+
+    const auto bandwidthFused   = MeasureBandwidth(srcBuffer.size() + dstBufferFused.size(), timeFused);
+    const auto bandwidthMemcpy  = MeasureBandwidth(dstBufferFused.size() * 2, timeMemcpy);
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2);
+    std::cout << " two-pass: " << std::setw(8) << timeTwoPass << " ms";
+    std::cout << ", fused: " << std::setw(8) << timeFused << " ms";
+    std::cout << ", " << std::setw(6) << bandwidthFused << " GB/s";
+    std::cout << " (memcpy: " << std::setw(6) << bandwidthMemcpy << " GB/s)";
+    std::cout << (equal ? "" : " (MISMATCH)") << std::endl;
+}
+
+// Compares the Float16 kernels with the scalar functions for all 16-bit values and the 32-bit values around the edge cases.
+static void TestFloat16BitExactness()
+{
+    std::vector<std::uint16_t> halfs(0x10000);
+    for (std::size_t i = 0; i < halfs.size(); ++i)
+        halfs[i] = static_cast<std::uint16_t>(i);
+
+    std::vector<std::uint32_t> floats;
+    for (std::uint32_t edge : { 0x00000000u, 0x33000000u, 0x38800000u, 0x477FE000u, 0x477FF000u, 0x7F800000u, 0x7F800001u, 0x7FC00000u })
+    {
+        for (std::uint32_t i = 0; i < 0x1000; ++i)
+        {
+            floats.push_back((edge + i - 0x800u));
+            floats.push_back((edge + i - 0x800u) | 0x80000000u);
+        }
+    }
+
+    std::vector<float>          floatsScalar(halfs.size()), floatsSIMD(halfs.size());
+    std::vector<std::uint16_t>  halfsScalar(floats.size()), halfsSIMD(floats.size());
+
+    for (std::size_t i = 0; i < halfs.size(); ++i)
+        floatsScalar[i] = LLGL::DecompressFloat16(halfs[i]);
+    for (std::size_t i = 0; i < floats.size(); ++i)
+    {
+        float value;
+        ::memcpy(&value, &floats[i], sizeof(value));
+        halfsScalar[i] = LLGL::CompressFloat16(value);
+    }
+
+    LLGL::ConvertImageBuffer(
+        { LLGL::ImageFormat::R, LLGL::DataType::Float16, halfs.data(), halfs.size() * 2 },
+        { LLGL::ImageFormat::R, LLGL::DataType::Float32, floatsSIMD.data(), floatsSIMD.size() * 4 }
+    );
+    LLGL::ConvertImageBuffer(
+        { LLGL::ImageFormat::R, LLGL::DataType::Float32, floats.data(), floats.size() * 4 },
+        { LLGL::ImageFormat::R, LLGL::DataType::Float16, halfsSIMD.data(), halfsSIMD.size() * 2 }
+    );
+
+    bool equalFloats    = (::memcmp(floatsScalar.data(), floatsSIMD.data(), floatsSIMD.size() * 4) == 0);
+    bool equalHalfs     = (::memcmp(halfsScalar.data(), halfsSIMD.data(), halfsSIMD.size() * 2) == 0);
+
+    std::cout << "Float16 -> Float32 (all values):     " << (equalFloats ? "bit-exact" : "MISMATCH") << std::endl;
+    std::cout << "Float32 -> Float16 (edge cases):     " << (equalHalfs ? "bit-exact" : "MISMATCH") << std::endl;
+}
+
+// Returns the peak signal-to-noise ratio (in dB) of the first 'numComponents' components of two RGBA8 images.
+static double ComputePSNR(const std::uint8_t* a, const std::uint8_t* b, std::size_t numPixels, int numComponents)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < numPixels; ++i)
+    {
+        for (int c = 0; c < numComponents; ++c)
+        {
+            const double d = static_cast<double>(a[i*4 + c]) - static_cast<double>(b[i*4 + c]);
+            sum += d*d;
+        }
+    }
+    const double mse = sum / static_cast<double>(numPixels * numComponents);
+    return (mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : 99.0);
+}
+
+static void BenchmarkBlockCompression(const char* name, LLGL::ImageFormat format, int numComponents, std::size_t threadCount)
+{
+    const LLGL::Extent3D extent { 1024, 1024, 1 };
+    const std::size_t numPixels = extent.width * extent.height;
+
+    /* Generate smooth test image with some noise, which is typical for color textures */
+    std::vector<std::uint8_t> srcBuffer(numPixels * 4);
+    for (std::uint32_t y = 0; y < extent.height; ++y)
+    {
+        for (std::uint32_t x = 0; x < extent.width; ++x)
+        {
+            auto pixel = &srcBuffer[(y * extent.width + x) * 4];
+            pixel[0] = static_cast<std::uint8_t>((x / 4 + FastRand() % 8) & 0xFF);
+            pixel[1] = static_cast<std::uint8_t>((y / 4 + FastRand() % 8) & 0xFF);
+            pixel[2] = static_cast<std::uint8_t>(((x + y) / 8) & 0xFF);
+            pixel[3] = 255;
+        }
+    }
+
+    const LLGL::SrcImageDescriptor srcDesc { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, srcBuffer.data(), srcBuffer.size() };
+
+    /* Compress and decompress image again */
+    auto startTime = std::chrono::high_resolution_clock::now();
+    auto compressedBuffer = LLGL::ConvertImageBuffer(srcDesc, format, LLGL::DataType::UInt8, extent, threadCount);
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    const auto compressedSize = LLGL::GetImageBufferSize(format, LLGL::DataType::UInt8, extent);
+    const LLGL::SrcImageDescriptor compressedDesc { format, LLGL::DataType::UInt8, compressedBuffer.get(), compressedSize };
+    auto dstBuffer = LLGL::ConvertImageBuffer(compressedDesc, LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, extent, threadCount);
+
+    auto psnr = ComputePSNR(srcBuffer.data(), reinterpret_cast<const std::uint8_t*>(dstBuffer.get()), numPixels, numComponents);
+
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(2);
+    std::cout << " compress: " << std::setw(8) << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms";
+    std::cout << ", ratio: " << std::setw(4) << (srcBuffer.size() / compressedSize) << ":1";
+    std::cout << ", PSNR: " << std::setw(6) << psnr << " dB";
+    std::cout << (psnr >= 30.0 ? "" : " (LOW QUALITY)") << std::endl;
+}
+
+static void TestStreamConversion(const char* name, LLGL::ImageFormat dstFormat, LLGL::DataType dstDataType, std::size_t maxStripSize)
+{
+    const LLGL::Extent3D extent { 333, 257, 2 };
+    const auto srcFormat    = LLGL::ImageFormat::RGB;
+    const auto srcDataType  = LLGL::DataType::UInt8;
+
+    std::vector<char> srcImage(LLGL::GetImageBufferSize(srcFormat, srcDataType, extent));
+    FillRandom(srcImage, srcDataType);
+
+    /* Convert entire image at once as reference */
+    const auto dstSliceSize = LLGL::GetImageBufferSize(dstFormat, dstDataType, LLGL::Extent3D{ extent.width, extent.height, 1 });
+    std::vector<char> refImage(dstSliceSize * extent.depth);
+    for (std::uint32_t z = 0; z < extent.depth; ++z)
+    {
+        const auto srcSliceSize = srcImage.size() / extent.depth;
+        const LLGL::SrcImageDescriptor srcDesc { srcFormat, srcDataType, srcImage.data() + srcSliceSize * z, srcSliceSize };
+        const LLGL::DstImageDescriptor dstDesc { dstFormat, dstDataType, refImage.data() + dstSliceSize * z, dstSliceSize };
+        if (!LLGL::ConvertImageBuffer(srcDesc, dstDesc, LLGL::Extent3D{ extent.width, extent.height, 1 }))
+            ::memcpy(dstDesc.data, srcDesc.data, srcDesc.dataSize);
+    }
+
+    /* Stream image in chunks of random size that do not end on row boundaries */
+    std::vector<char> dstImage(refImage.size());
+    std::size_t maxStripDataSize = 0;
+
+    LLGL::ImageStreamConverter converter
+    {
+        extent, srcFormat, srcDataType, dstFormat, dstDataType,
+        [&](const LLGL::Offset3D& offset, const LLGL::Extent3D& stripExtent, const LLGL::SrcImageDescriptor& imageDesc)
+        {
+            const auto dstOffset = LLGL::GetImageBufferSize(dstFormat, dstDataType, LLGL::Extent3D{ extent.width, static_cast<std::uint32_t>(offset.y), 1 });
+            ::memcpy(dstImage.data() + dstSliceSize * offset.z + dstOffset, imageDesc.data, imageDesc.dataSize);
+            maxStripDataSize = std::max(maxStripDataSize, imageDesc.dataSize + LLGL::GetImageBufferSize(srcFormat, srcDataType, stripExtent));
+        },
+        maxStripSize
+    };
+
+    for (std::size_t offset = 0; !converter.IsComplete();)
+    {
+        const auto chunkSize = static_cast<std::size_t>(FastRand() % 4000);
+        offset += converter.Write(srcImage.data() + offset, chunkSize);
+        if (FastRand() % 8 == 0)
+            converter.Flush();
+    }
+
+    const bool equal = (::memcmp(dstImage.data(), refImage.data(), refImage.size()) == 0);
+    std::cout << "RGB UInt8 -> " << name << " (" << converter.GetStripRows() << " rows per strip, ";
+    std::cout << maxStripDataSize << " bytes per strip): " << (equal ? "ok" : "MISMATCH") << std::endl;
+
+    if (!equal)
+        throw std::runtime_error("stream conversion does not match conversion of entire image");
+    if (maxStripSize > 0 && maxStripDataSize > maxStripSize && converter.GetStripRows() > 4)
+        throw std::runtime_error("stream conversion exceeded maximal strip size");
+}
+
+// Decodes BC7 blocks of different modes and compares the first and last pixel with the output of a reference decoder.
+static void TestBC7Decoding()
+{
+    struct BC7TestBlock
+    {
+        const char*     mode;
+        std::uint8_t    block[16];
+        std::uint8_t    firstPixel[4];
+        std::uint8_t    lastPixel[4];
+    };
+
+    const BC7TestBlock testBlocks[] =
+    {
+        {
+            "mode 1 (2 subsets, shared P-bits)",
+            { 0x6E, 0x25, 0xCF, 0x73, 0x4C, 0x49, 0xA1, 0xDD, 0x27, 0x3E, 0x4D, 0x8F, 0xAB, 0x5F, 0x5B, 0xDB },
+            { 190, 93, 121, 255 }, { 230, 137, 125, 255 }
+        },
+        {
+            "mode 4 (rotation, index selection)",
+            { 0xF0, 0x01, 0xB6, 0x50, 0xC2, 0xA2, 0x0B, 0xC2, 0x66, 0x62, 0xCB, 0x3A, 0x7A, 0x68, 0x4C, 0x83 },
+            { 25, 93, 44, 36 }, { 80, 50, 172, 22 }
+        },
+        {
+            "mode 7 (2 subsets, RGBA)",
+            { 0x80, 0x85, 0xFE, 0x49, 0x5A, 0xD2, 0x9D, 0x07, 0xC0, 0x2A, 0xFA, 0x11, 0x4F, 0x17, 0x2A, 0x90 },
+            { 224, 130, 163, 108 }, { 101, 199, 62, 194 }
+        },
+    };
+
+    for (const auto& test : testBlocks)
+    {
+        std::uint8_t pixels[64];
+        const LLGL::SrcImageDescriptor srcDesc { LLGL::ImageFormat::BC7, LLGL::DataType::UInt8, test.block, sizeof(test.block) };
+        const LLGL::DstImageDescriptor dstDesc { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, pixels, sizeof(pixels) };
+        LLGL::ConvertImageBuffer(srcDesc, dstDesc, LLGL::Extent3D{ 4, 4, 1 });
+
+        const bool equal = (::memcmp(pixels, test.firstPixel, 4) == 0 && ::memcmp(pixels + 60, test.lastPixel, 4) == 0);
+        std::cout << "BC7 decoding " << test.mode << ": " << (equal ? "ok" : "MISMATCH") << std::endl;
+
+        if (!equal)
+            throw std::runtime_error("BC7 decoding does not match reference decoder");
+    }
+}
+
+// Checks that images with compressed formats report the strides of their 4x4 blocks and reject pixel regions.
+static void TestCompressedImageStrides()
+{
+    LLGL::Image image{ LLGL::Extent3D{ 10, 6, 2 }, LLGL::ImageFormat::BC7, LLGL::DataType::UInt8 };
+
+    if (image.GetRowStride() != 3 * 16 || image.GetDepthStride() != 3 * 2 * 16 || image.GetDataSize() != 3 * 2 * 2 * 16)
+        throw std::runtime_error("wrong strides of compressed image");
+
+    /* Entire image can be read and converted */
+    std::vector<std::uint8_t> pixels(10 * 6 * 2 * 4);
+    image.ReadPixels({ 0, 0, 0 }, image.GetExtent(), { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, pixels.data(), pixels.size() });
+
+    /* Sub-regions must be rejected */
+    try
+    {
+        image.ReadPixels({ 4, 0, 0 }, { 4, 4, 1 }, { LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, pixels.data(), pixels.size() });
+        throw std::runtime_error("reading sub-region of compressed image was not rejected");
+    }
+    catch (const std::invalid_argument&)
+    {
+    }
+
+    std::cout << "compressed image strides: ok" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        TestFloat16BitExactness();
+        TestStreamConversion("RGBA Float16", LLGL::ImageFormat::RGBA, LLGL::DataType::Float16, 64 * 1024);
+        TestStreamConversion("BC1         ", LLGL::ImageFormat::BC1, LLGL::DataType::UInt8, 16 * 1024);
+        TestStreamConversion("RGB  UInt8  ", LLGL::ImageFormat::RGB, LLGL::DataType::UInt8, 0);
+        TestBC7Decoding();
+        TestCompressedImageStrides();
+
+        std::cout << "=== single thread (2048 x 2048 RGBA) ===" << std::endl;
+        BenchmarkDataTypeConversion("UInt8   -> Float32", LLGL::DataType::UInt8,   LLGL::DataType::Float32);
+        BenchmarkDataTypeConversion("Float32 -> UInt8",   LLGL::DataType::Float32, LLGL::DataType::UInt8  );
+        BenchmarkDataTypeConversion("Int8    -> Float32", LLGL::DataType::Int8,    LLGL::DataType::Float32);
+        BenchmarkDataTypeConversion("Float32 -> Int8",    LLGL::DataType::Float32, LLGL::DataType::Int8   );
+        BenchmarkDataTypeConversion("UInt16  -> Float32", LLGL::DataType::UInt16,  LLGL::DataType::Float32);
+        BenchmarkDataTypeConversion("Float32 -> UInt16",  LLGL::DataType::Float32, LLGL::DataType::UInt16 );
+        BenchmarkDataTypeConversion("Float16 -> Float32", LLGL::DataType::Float16, LLGL::DataType::Float32);
+        BenchmarkDataTypeConversion("Float32 -> Float16", LLGL::DataType::Float32, LLGL::DataType::Float16);
+
+        for (std::size_t threadCount : { std::size_t(1), std::size_t(LLGL::Constants::maxThreadCount) })
+        {
+            std::cout << "=== " << (threadCount == 1 ? "single thread" : "max. threads") << " (2048 x 2048) ===" << std::endl;
+            BenchmarkFusedConversion("RGB   UInt8   -> RGBA Float32", LLGL::ImageFormat::RGB,  LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, threadCount);
+            BenchmarkFusedConversion("BGRA  UInt8   -> RGBA Float16", LLGL::ImageFormat::BGRA, LLGL::DataType::UInt8,   LLGL::ImageFormat::RGBA, LLGL::DataType::Float16, threadCount);
+            BenchmarkFusedConversion("RGBA  Float32 -> BGR  UInt8  ", LLGL::ImageFormat::RGBA, LLGL::DataType::Float32, LLGL::ImageFormat::BGR,  LLGL::DataType::UInt8,   threadCount);
+            BenchmarkFusedConversion("RGBA  Float16 -> R    Float32", LLGL::ImageFormat::RGBA, LLGL::DataType::Float16, LLGL::ImageFormat::R,    LLGL::DataType::Float32, threadCount);
+            BenchmarkFusedConversion("ARGB  UInt16  -> RGBA UInt8  ", LLGL::ImageFormat::ARGB, LLGL::DataType::UInt16,  LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8,   threadCount);
+        }
+
+        for (std::size_t threadCount : { std::size_t(1), std::size_t(LLGL::Constants::maxThreadCount) })
+        {
+            std::cout << "=== " << (threadCount == 1 ? "single thread" : "max. threads") << " (1024 x 1024 RGBA) ===" << std::endl;
+            BenchmarkBlockCompression("RGBA8 -> BC1", LLGL::ImageFormat::BC1, 3, threadCount);
+            BenchmarkBlockCompression("RGBA8 -> BC2", LLGL::ImageFormat::BC2, 4, threadCount);
+            BenchmarkBlockCompression("RGBA8 -> BC3", LLGL::ImageFormat::BC3, 4, threadCount);
+            BenchmarkBlockCompression("RGBA8 -> BC4", LLGL::ImageFormat::BC4, 1, threadCount);
+            BenchmarkBlockCompression("RGBA8 -> BC5", LLGL::ImageFormat::BC5, 2, threadCount);
+            BenchmarkBlockCompression("RGBA8 -> BC7", LLGL::ImageFormat::BC7, 4, threadCount);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        #ifdef _WIN32
+        system("pause");
+        #endif
+    }
+    return 0;
+}
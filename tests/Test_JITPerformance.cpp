@@ -0,0 +1,322 @@
+/*
+ * Test_JITPerformance.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+
+
+#if defined LLGL_ENABLE_JIT_COMPILER
+
+#include "../sources/JIT/JITCompiler.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+
+
+/*
+Benchmark for emulated deferred command buffers of the OpenGL backend:
+records the same random command stream into a deferred command buffer and into a deferred multi-submit command buffer,
+and submits it through the real command queue. The deferred command buffer is replayed by ExecuteGLDeferredCommandBuffer
+with CommandDispatchMode::Switch and CommandDispatchMode::Threaded, the multi-submit command buffer is replayed
+by the native program from AssembleGLDeferredCommandBuffer. The CPU time of each submission is measured, and the
+issued and elided GL state changes of all paths are cross-checked with the profiler of the GL renderer configuration.
+*/
+
+static const std::uint32_t  g_numCommands       = 20000;
+static const int            g_numRuns           = 50;
+static const std::uint32_t  g_numVertexBuffers  = 4;
+static const std::uint32_t  g_numPipelines      = 4;
+
+static unsigned int g_seed = 0;
+
+static int FastRand()
+{
+    g_seed = (214013 * g_seed + 2531011);
+    return (g_seed >> 16) & 0x7FFF;
+}
+
+static std::uint32_t RandUInt(std::uint32_t max)
+{
+    return static_cast<std::uint32_t>(FastRand()) % (max + 1);
+}
+
+struct BenchmarkScene
+{
+    LLGL::RenderContext*                context = nullptr;
+    std::vector<LLGL::Buffer*>          vertexBuffers;
+    std::vector<LLGL::PipelineState*>   pipelines;
+};
+
+// Records a random command stream that only depends on the seed
+static void RecordCommands(LLGL::CommandBuffer& cmdBuffer, const BenchmarkScene& scene, unsigned int seed)
+{
+    g_seed = seed;
+
+    cmdBuffer.Begin();
+    {
+        cmdBuffer.BeginRenderPass(*scene.context);
+        {
+            for (std::uint32_t i = 0; i < g_numCommands; ++i)
+            {
+                switch (RandUInt(5))
+                {
+                    case 0:
+                        cmdBuffer.SetViewport(
+                            LLGL::Viewport
+                            {
+                                static_cast<float>(RandUInt(100)),
+                                static_cast<float>(RandUInt(100)),
+                                static_cast<float>(1 + RandUInt(699)),
+                                static_cast<float>(1 + RandUInt(499))
+                            }
+                        );
+                        break;
+                    case 1:
+                        cmdBuffer.SetVertexBuffer(*scene.vertexBuffers[RandUInt(g_numVertexBuffers - 1)]);
+                        break;
+                    case 2:
+                        cmdBuffer.SetPipelineState(*scene.pipelines[RandUInt(g_numPipelines - 1)]);
+                        break;
+                    case 3:
+                        cmdBuffer.SetStencilReference(RandUInt(3));
+                        break;
+                    case 4:
+                        cmdBuffer.Draw(3, RandUInt(3));
+                        break;
+                    default:
+                        cmdBuffer.DrawInstanced(3, RandUInt(3), 1 + RandUInt(3));
+                        break;
+                }
+            }
+        }
+        cmdBuffer.EndRenderPass();
+    }
+    cmdBuffer.End();
+}
+
+// Submits the command buffer several times and returns the average CPU time (in milliseconds) of a single submission
+static double MeasureSubmission(LLGL::CommandQueue& queue, LLGL::CommandBuffer& cmdBuffer)
+{
+    double totalTime = 0.0;
+
+    for (int i = 0; i < g_numRuns; ++i)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        queue.Submit(cmdBuffer);
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        totalTime += std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        /* Exclude the GPU work from the measurement */
+        queue.WaitIdle();
+    }
+
+    return (totalTime / g_numRuns);
+}
+
+struct BenchmarkResult
+{
+    double              time = 0.0;
+    LLGL::FrameProfile  profile;
+};
+
+static BenchmarkResult RunBenchmark(
+    LLGL::RenderSystem&         renderer,
+    LLGL::RenderingProfiler&    profiler,
+    LLGL::CommandBuffer&        cmdBuffer,
+    LLGL::CommandDispatchMode   dispatchMode)
+{
+    auto config = renderer.GetConfiguration();
+    config.commandDispatch = dispatchMode;
+    renderer.SetConfiguration(config);
+
+    auto& queue = *renderer.GetCommandQueue();
+
+    /* Submit once to bring the state manager into the state at the end of the command stream */
+    queue.Submit(cmdBuffer);
+    queue.WaitIdle();
+    profiler.NextProfile();
+
+    BenchmarkResult result;
+    result.time = MeasureSubmission(queue, cmdBuffer);
+    profiler.NextProfile(&result.profile);
+
+    return result;
+}
+
+static bool CompareStateCounters(const LLGL::FrameProfile& lhs, const LLGL::FrameProfile& rhs)
+{
+    const std::uint32_t* lhsBegin = &(lhs.issuedCapabilityChanges);
+    const std::uint32_t* lhsEnd = &(lhs.elidedShaderProgramBindings) + 1;
+    const std::uint32_t* rhsBegin = &(rhs.issuedCapabilityChanges);
+    return std::equal(lhsBegin, lhsEnd, rhsBegin);
+}
+
+static void PrintResult(const std::string& name, const BenchmarkResult& result, const BenchmarkResult& reference)
+{
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(3);
+    std::cout << result.time << " ms (" << std::setprecision(2) << (reference.time / result.time) << "x)";
+    std::cout << ", " << (result.profile.issuedRenderStateChanges + result.profile.issuedBufferBindings + result.profile.issuedVertexArrayBindings);
+    std::cout << " issued state changes" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load render system module with a profiler for the issued and elided GL state changes
+        LLGL::RenderingProfiler profiler;
+
+        LLGL::RendererConfigurationOpenGL rendererConfig;
+        {
+            rendererConfig.profiler = &profiler;
+        }
+        LLGL::RenderSystemDescriptor rendererDesc;
+        {
+            rendererDesc.moduleName         = (argc > 1 ? argv[1] : "OpenGL");
+            rendererDesc.rendererConfig     = &rendererConfig;
+            rendererDesc.rendererConfigSize = sizeof(rendererConfig);
+        }
+        auto renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+        // Create render context
+        LLGL::RenderContextDescriptor contextDesc;
+        {
+            contextDesc.videoMode.resolution = { 800, 600 };
+        }
+        BenchmarkScene scene;
+        scene.context = renderer->CreateRenderContext(contextDesc);
+
+        auto& window = static_cast<LLGL::Window&>(scene.context->GetSurface());
+        window.SetTitle(L"LLGL Test: JIT Performance ( " + std::to_wstring(g_numCommands) + L" commands )");
+
+        // Create vertex buffers
+        LLGL::VertexFormat vertexFormat;
+        vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+        const float vertices[] = { -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, -1.0f, -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, -1.0f };
+
+        LLGL::BufferDescriptor vertexBufferDesc;
+        {
+            vertexBufferDesc.size           = sizeof(vertices);
+            vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+            vertexBufferDesc.vertexAttribs  = vertexFormat.attributes;
+        }
+        for (std::uint32_t i = 0; i < g_numVertexBuffers; ++i)
+            scene.vertexBuffers.push_back(renderer->CreateBuffer(vertexBufferDesc, vertices));
+
+        // Create shaders
+        LLGL::ShaderDescriptor vertShaderDesc;
+        {
+            vertShaderDesc.type                 = LLGL::ShaderType::Vertex;
+            vertShaderDesc.source               = "#version 130\nin vec2 position;\nvoid main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+            vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+            vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+        }
+        auto vertShader = renderer->CreateShader(vertShaderDesc);
+
+        LLGL::ShaderDescriptor fragShaderDesc;
+        {
+            fragShaderDesc.type         = LLGL::ShaderType::Fragment;
+            fragShaderDesc.source       = "#version 130\nout vec4 fragColor;\nvoid main() { fragColor = vec4(1.0); }\n";
+            fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+        }
+        auto fragShader = renderer->CreateShader(fragShaderDesc);
+
+        for (auto shader : { vertShader, fragShader })
+        {
+            if (shader->HasErrors())
+                throw std::runtime_error(shader->GetReport());
+        }
+
+        LLGL::ShaderProgramDescriptor shaderProgramDesc;
+        {
+            shaderProgramDesc.vertexShader      = vertShader;
+            shaderProgramDesc.fragmentShader    = fragShader;
+        }
+        auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+        if (shaderProgram->HasErrors())
+            throw std::runtime_error(shaderProgram->GetReport());
+
+        // Create pipelines with different depth, rasterizer, and blend states
+        for (std::uint32_t i = 0; i < g_numPipelines; ++i)
+        {
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram                  = shaderProgram;
+                pipelineDesc.depth.testEnabled              = ((i & 1) != 0);
+                pipelineDesc.rasterizer.cullMode            = ((i & 2) != 0 ? LLGL::CullMode::Back : LLGL::CullMode::Disabled);
+                pipelineDesc.blend.targets[0].blendEnabled  = (i >= 2);
+            }
+            scene.pipelines.push_back(renderer->CreatePipelineState(pipelineDesc));
+        }
+
+        // Record the same command stream into an interpreted and a JIT compiled command buffer
+        LLGL::CommandBufferDescriptor deferredDesc;
+        {
+            deferredDesc.flags = LLGL::CommandBufferFlags::DeferredSubmit;
+        }
+        auto deferredCmdBuffer = renderer->CreateCommandBuffer(deferredDesc);
+
+        LLGL::CommandBufferDescriptor multiSubmitDesc;
+        {
+            multiSubmitDesc.flags = (LLGL::CommandBufferFlags::DeferredSubmit | LLGL::CommandBufferFlags::MultiSubmit);
+        }
+        auto multiSubmitCmdBuffer = renderer->CreateCommandBuffer(multiSubmitDesc);
+
+        const unsigned int seed = 1234;
+        RecordCommands(*deferredCmdBuffer, scene, seed);
+        RecordCommands(*multiSubmitCmdBuffer, scene, seed);
+
+        // Replay both command buffers through the command queue
+        const bool hasJIT = (LLGL::JITCompiler::Create() != nullptr);
+
+        const auto resultSwitch     = RunBenchmark(*renderer, profiler, *deferredCmdBuffer, LLGL::CommandDispatchMode::Switch);
+        const auto resultThreaded   = RunBenchmark(*renderer, profiler, *deferredCmdBuffer, LLGL::CommandDispatchMode::Threaded);
+        const auto resultJIT        = RunBenchmark(*renderer, profiler, *multiSubmitCmdBuffer, LLGL::CommandDispatchMode::Switch);
+
+        std::cout << "submission of " << g_numCommands << " commands (average of " << g_numRuns << " runs):" << std::endl;
+        PrintResult("interpreter (switch):", resultSwitch, resultSwitch);
+        PrintResult("interpreter (threaded):", resultThreaded, resultSwitch);
+        PrintResult(hasJIT ? "JIT program:" : "JIT program (unsupported):", resultJIT, resultSwitch);
+
+        if (!CompareStateCounters(resultSwitch.profile, resultThreaded.profile))
+            throw std::runtime_error("MISMATCH: threaded interpreter issued different GL state changes than switch interpreter");
+        if (!CompareStateCounters(resultSwitch.profile, resultJIT.profile))
+            throw std::runtime_error("MISMATCH: JIT program issued different GL state changes than switch interpreter");
+
+        std::cout << "GL state changes of all paths: ok" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+#else // LLGL_ENABLE_JIT_COMPILER
+
+#include <iostream>
+
+int main()
+{
+    std::cerr << "LLGL was not compiled with LLGL_ENABLE_JIT_COMPILER" << std::endl;
+    return 0;
+}
+
+#endif // /LLGL_ENABLE_JIT_COMPILER
+
+
+
+// ================================================================================
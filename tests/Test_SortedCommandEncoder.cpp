@@ -0,0 +1,205 @@
+/*
+ * Test_SortedCommandEncoder.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/SortedCommandEncoder.h>
+#include <vector>
+#include <random>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+
+
+/*
+Test for the SortedCommandEncoder utility:
+draws thousands of small triangles with a random combination of pipeline states and vertex buffers,
+once in submission order and once sorted by pipeline state and vertex buffer,
+then compares the number of state changes that reach the command buffer (via the rendering profiler of the debug layer).
+*/
+
+static const std::size_t    g_numPipelines      = 4;
+static const std::size_t    g_numVertexBuffers  = 4;
+static const std::uint32_t  g_numDraws          = 20000;
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load render system module with profiler
+        LLGL::RenderingProfiler profiler;
+        auto renderer = LLGL::RenderSystem::Load((argc > 1 ? argv[1] : "OpenGL"), &profiler);
+
+        // Create render context
+        LLGL::RenderContextDescriptor contextDesc;
+        {
+            contextDesc.videoMode.resolution = { 800, 600 };
+        }
+        auto context = renderer->CreateRenderContext(contextDesc);
+
+        auto& window = static_cast<LLGL::Window&>(context->GetSurface());
+        window.SetTitle(L"LLGL Test: SortedCommandEncoder ( " + std::wstring(renderer->GetName().begin(), renderer->GetName().end()) + L" )");
+        window.Show();
+
+        // Create vertex buffers with differently sized triangles
+        LLGL::VertexFormat vertexFormat;
+        vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+        std::vector<LLGL::Buffer*> vertexBuffers(g_numVertexBuffers);
+        for (std::size_t i = 0; i < g_numVertexBuffers; ++i)
+        {
+            const float s = 0.01f * static_cast<float>(i + 1);
+            const float vertices[] = { -s, -s, 0.0f, s, s, -s };
+
+            LLGL::BufferDescriptor vertexBufferDesc;
+            {
+                vertexBufferDesc.size           = sizeof(vertices);
+                vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+                vertexBufferDesc.vertexAttribs  = vertexFormat.attributes;
+            }
+            vertexBuffers[i] = renderer->CreateBuffer(vertexBufferDesc, vertices);
+        }
+
+        // Create shaders
+        LLGL::ShaderDescriptor vertShaderDesc;
+        {
+            vertShaderDesc.type                 = LLGL::ShaderType::Vertex;
+            vertShaderDesc.source               = "#version 130\nin vec2 position;\nvoid main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+            vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+            vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+        }
+        auto vertShader = renderer->CreateShader(vertShaderDesc);
+
+        LLGL::ShaderDescriptor fragShaderDesc;
+        {
+            fragShaderDesc.type         = LLGL::ShaderType::Fragment;
+            fragShaderDesc.source       = "#version 130\nout vec4 fragColor;\nvoid main() { fragColor = vec4(1.0, 0.5, 0.2, 0.25); }\n";
+            fragShaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+        }
+        auto fragShader = renderer->CreateShader(fragShaderDesc);
+
+        for (auto shader : { vertShader, fragShader })
+        {
+            if (shader->HasErrors())
+                throw std::runtime_error(shader->GetReport());
+        }
+
+        LLGL::ShaderProgramDescriptor shaderProgramDesc;
+        {
+            shaderProgramDesc.vertexShader      = vertShader;
+            shaderProgramDesc.fragmentShader    = fragShader;
+        }
+        auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+        if (shaderProgram->HasErrors())
+            throw std::runtime_error(shaderProgram->GetReport());
+
+        // Create graphics pipelines with different blend and cull modes
+        std::vector<LLGL::PipelineState*> pipelines(g_numPipelines);
+        for (std::size_t i = 0; i < g_numPipelines; ++i)
+        {
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.shaderProgram                      = shaderProgram;
+                pipelineDesc.blend.targets[0].blendEnabled      = ((i & 1) != 0);
+                pipelineDesc.rasterizer.cullMode                = ((i & 2) != 0 ? LLGL::CullMode::Back : LLGL::CullMode::Disabled);
+            }
+            pipelines[i] = renderer->CreatePipelineState(pipelineDesc);
+        }
+
+        // Generate draw packets in random order
+        std::mt19937 rng;
+        std::vector<LLGL::DrawPacket> packets(g_numDraws);
+
+        for (auto& packet : packets)
+        {
+            const auto pipelineIndex    = rng() % g_numPipelines;
+            const auto bufferIndex      = rng() % g_numVertexBuffers;
+
+            packet.sortKey          = (static_cast<std::uint64_t>(pipelineIndex) << 48) | (static_cast<std::uint64_t>(bufferIndex) << 32);
+            packet.pipelineState    = pipelines[pipelineIndex];
+            packet.vertexBuffer     = vertexBuffers[bufferIndex];
+            packet.numVertices      = 3;
+        }
+
+        // Encode draw packets in submission order (unique sort keys) and sorted by state
+        auto commandQueue   = renderer->GetCommandQueue();
+        auto commands       = renderer->CreateCommandBuffer();
+
+        LLGL::SortedCommandEncoder unsortedEncoder;
+        LLGL::SortedCommandEncoder sortedEncoder;
+
+        for (std::uint32_t i = 0; i < g_numDraws; ++i)
+        {
+            auto unsortedPacket = packets[i];
+            unsortedPacket.sortKey = i;
+            unsortedEncoder.Submit(unsortedPacket);
+        }
+
+        sortedEncoder.Submit(packets.size(), packets.data());
+
+        LLGL::FrameProfile profiles[2];
+
+        for (std::uint32_t frame = 0; window.ProcessEvents() && frame < 120; ++frame)
+        {
+            // Alternate between unsorted and sorted draw packets
+            const std::size_t sorted = (frame % 2);
+            auto& encoder = (sorted != 0 ? sortedEncoder : unsortedEncoder);
+
+            commands->Begin();
+            {
+                commands->BeginRenderPass(*context);
+                {
+                    commands->SetClearColor({ 0.1f, 0.1f, 0.2f });
+                    commands->Clear(LLGL::ClearFlags::Color);
+                    commands->SetViewport(context->GetResolution());
+                    encoder.Encode(*commands);
+                }
+                commands->EndRenderPass();
+            }
+            commands->End();
+            commandQueue->Submit(*commands);
+
+            context->Present();
+
+            profiler.NextProfile(&profiles[sorted]);
+
+            // Validate profile against statistics of the encoder
+            const auto& stats = encoder.GetStats();
+            if (profiles[sorted].graphicsPipelineBindings != stats.pipelineBindings ||
+                profiles[sorted].vertexBufferBindings != stats.vertexBufferBindings ||
+                profiles[sorted].drawCommands != stats.drawCommands)
+            {
+                throw std::runtime_error("mismatch between encoder statistics and rendering profile");
+            }
+        }
+
+        // Sorted draw packets must only change states when the sort key changes
+        const auto& sortedStats = sortedEncoder.GetStats();
+        if (sortedStats.pipelineBindings != g_numPipelines || sortedStats.vertexBufferBindings > g_numPipelines * g_numVertexBuffers)
+            throw std::runtime_error("sorted command encoder did not merge redundant state changes");
+
+        // Print state changes of both encodings
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            std::cout << (i == 0 ? "unsorted:" : "sorted:  ");
+            std::cout << " draws = " << profiles[i].drawCommands;
+            std::cout << ", pipeline bindings = " << profiles[i].graphicsPipelineBindings;
+            std::cout << ", vertex buffer bindings = " << profiles[i].vertexBufferBindings << std::endl;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,199 @@
+/*
+ * Test_VKDefragResubmit.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <vector>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+
+
+/*
+Test for the incremental Vulkan device memory defragmenter in conjunction with multi-submit command buffers:
+fragments the device memory, records a MultiSubmit command buffer that references several buffers,
+then renders enough frames for the defragmenter to move the remaining buffers and resubmits the same command buffer.
+The buffers that are referenced by the command buffer must not be moved, i.e. the validation layer must not report any errors
+and the resubmitted copy and fill commands must still write into the destination buffer.
+*/
+
+static const std::uint64_t  g_bufferSize        = 64*1024;
+static const std::uint32_t  g_numBuffers        = 64;
+static const std::uint32_t  g_numFrames         = 16;
+static const std::uint32_t  g_fillValue         = 0xA5A5A5A5;
+
+static void Check(bool condition, const std::string& msg)
+{
+    if (!condition)
+        throw std::runtime_error(msg);
+}
+
+static bool HasMoreFragments(const LLGL::MemoryStatistics& lhs, const LLGL::MemoryStatistics& rhs)
+{
+    return (lhs.numFreeBlocks > rhs.numFreeBlocks || lhs.largestFreeBlockSize < rhs.largestFreeBlockSize);
+}
+
+int main()
+{
+    try
+    {
+        // Load Vulkan render system with validation layer and device memory defragmentation
+        LLGL::RendererConfigurationVulkan config;
+        {
+            config.enabledLayers                        = { "VK_LAYER_KHRONOS_validation" };
+            config.minDeviceMemoryAllocationSize        = 4 * g_bufferSize;
+            config.maxDeviceMemoryDefragSizePerFrame    = g_numBuffers * g_bufferSize;
+        }
+        LLGL::RenderSystemDescriptor rendererDesc;
+        {
+            rendererDesc.moduleName         = "Vulkan";
+            rendererDesc.rendererConfig     = &config;
+            rendererDesc.rendererConfigSize = sizeof(config);
+        }
+        auto renderer = LLGL::RenderSystem::Load(rendererDesc);
+
+        // Count all errors reported by the validation layer
+        std::uint32_t numErrors = 0;
+
+        LLGL::Log::SetReportCallback(
+            [](LLGL::Log::ReportType type, const std::string& message, const std::string& /*contextInfo*/, void* userData)
+            {
+                if (type == LLGL::Log::ReportType::Error)
+                {
+                    std::cerr << message << std::endl;
+                    ++(*reinterpret_cast<std::uint32_t*>(userData));
+                }
+            },
+            &numErrors
+        );
+
+        // Create render context to drive the defragmenter with each presented frame
+        LLGL::RenderContextDescriptor contextDesc;
+        {
+            contextDesc.videoMode.resolution = { 800, 600 };
+        }
+        auto context = renderer->CreateRenderContext(contextDesc);
+
+        auto queue = renderer->GetCommandQueue();
+
+        // Create filler buffers with a source pattern
+        std::vector<std::uint32_t> srcData(g_bufferSize / sizeof(std::uint32_t));
+        for (std::size_t i = 0; i < srcData.size(); ++i)
+            srcData[i] = static_cast<std::uint32_t>(i * 7 + 3);
+
+        LLGL::VertexFormat vertexFormat;
+        vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+        std::vector<LLGL::Buffer*> buffers(g_numBuffers);
+        for (std::uint32_t i = 0; i < g_numBuffers; ++i)
+            buffers[i] = renderer->CreateBuffer(LLGL::VertexBufferDesc(g_bufferSize, vertexFormat), srcData.data());
+
+        // Create referenced buffers after the filler buffers, so the defragmenter would move them into the released regions
+        auto srcBuffer      = renderer->CreateBuffer(LLGL::VertexBufferDesc(g_bufferSize, vertexFormat), srcData.data());
+        auto dstBuffer      = renderer->CreateBuffer(LLGL::VertexBufferDesc(g_bufferSize, vertexFormat, LLGL::CPUAccessFlags::Read));
+        auto vertexBuffer   = renderer->CreateBuffer(LLGL::VertexBufferDesc(g_bufferSize, vertexFormat), srcData.data());
+        auto indexBuffer    = renderer->CreateBuffer(LLGL::IndexBufferDesc(g_bufferSize, LLGL::Format::R32UInt), srcData.data());
+
+        // Release every other buffer to fragment the device memory
+        for (std::uint32_t i = 0; i < g_numBuffers; i += 2)
+        {
+            renderer->Release(*buffers[i]);
+            buffers[i] = nullptr;
+        }
+
+        // Record multi-submit command buffer that references the buffers directly
+        LLGL::CommandBufferDescriptor cmdBufferDesc;
+        {
+            cmdBufferDesc.flags = LLGL::CommandBufferFlags::MultiSubmit;
+        }
+        auto multiSubmitCommands = renderer->CreateCommandBuffer(cmdBufferDesc);
+
+        multiSubmitCommands->Begin();
+        {
+            multiSubmitCommands->CopyBuffer(*dstBuffer, 0, *srcBuffer, 0, g_bufferSize / 2);
+            multiSubmitCommands->FillBuffer(*dstBuffer, g_bufferSize / 2, g_fillValue, g_bufferSize / 2);
+            multiSubmitCommands->SetVertexBuffer(*vertexBuffer);
+            multiSubmitCommands->SetIndexBuffer(*indexBuffer);
+        }
+        multiSubmitCommands->End();
+
+        queue->Submit(*multiSubmitCommands);
+        queue->WaitIdle();
+
+        // Render frames so the defragmenter moves all buffers that are not referenced by the command buffer
+        LLGL::MemoryStatistics statsBefore, statsAfter;
+        Check(renderer->QueryMemoryStatistics(statsBefore), "Vulkan render system did not report memory statistics");
+
+        auto frameCommands = renderer->CreateCommandBuffer();
+        frameCommands->SetClearColor({ 0.2f, 0.2f, 0.4f, 1.0f });
+
+        for (std::uint32_t frame = 0; frame < g_numFrames; ++frame)
+        {
+            frameCommands->Begin();
+            {
+                frameCommands->BeginRenderPass(*context);
+                {
+                    frameCommands->Clear(LLGL::ClearFlags::Color);
+                }
+                frameCommands->EndRenderPass();
+            }
+            frameCommands->End();
+            queue->Submit(*frameCommands);
+
+            context->Present();
+        }
+
+        queue->WaitIdle();
+
+        Check(renderer->QueryMemoryStatistics(statsAfter), "Vulkan render system did not report memory statistics");
+        Check(HasMoreFragments(statsBefore, statsAfter), "device memory was not defragmented between submissions");
+
+        // Clear destination buffer and resubmit the same command buffer
+        std::vector<std::uint32_t> zeroData(srcData.size(), 0);
+        renderer->WriteBuffer(*dstBuffer, 0, zeroData.data(), g_bufferSize);
+
+        queue->Submit(*multiSubmitCommands);
+        queue->WaitIdle();
+
+        // Verify copied and filled content of destination buffer
+        if (auto dstData = reinterpret_cast<const std::uint32_t*>(renderer->MapBuffer(*dstBuffer, LLGL::CPUAccess::ReadOnly)))
+        {
+            const std::size_t halfSize = srcData.size() / 2;
+            bool matches = true;
+
+            for (std::size_t i = 0; i < halfSize && matches; ++i)
+                matches = (dstData[i] == srcData[i]);
+            for (std::size_t i = halfSize; i < srcData.size() && matches; ++i)
+                matches = (dstData[i] == g_fillValue);
+
+            renderer->UnmapBuffer(*dstBuffer);
+
+            Check(matches, "MISMATCH: resubmitted command buffer did not write the destination buffer");
+        }
+        else
+            throw std::runtime_error("failed to map destination buffer");
+
+        LLGL::Log::SetReportCallback(nullptr);
+
+        Check(numErrors == 0, "validation layer reported " + std::to_string(numErrors) + " error(s)");
+
+        std::cout << "free blocks before/after defragmentation: " << statsBefore.numFreeBlocks << "/" << statsAfter.numFreeBlocks << std::endl;
+        std::cout << "largest free block before/after defragmentation: " << statsBefore.largestFreeBlockSize << "/" << statsAfter.largestFreeBlockSize << std::endl;
+        std::cout << "resubmission after defragmentation: ok" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,399 @@
+/*
+ * Test_VKDeviceMemoryDefrag.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Renderer/Vulkan/Memory/VKDeviceMemoryDefragPlanner.h"
+#include <vector>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+
+
+/*
+CPU-side simulation test of the move planner for the incremental Vulkan device memory defragmentation.
+Each simulated chunk stores its allocations by offset; the planner is invoked once per frame with a byte budget,
+and every planned move is validated (alignment, free destination range, memory type, budget) before it is applied.
+Moved allocations are released after a few frames like the retired buffers of the defragmenter.
+*/
+
+using LLGL::VKDefragChunk;
+using LLGL::VKDefragMove;
+using LLGL::VKDefragRange;
+
+static const std::uint64_t  g_chunkSize             = 16ull * 1024 * 1024;
+static const std::uint32_t  g_numMemoryTypes        = 2;
+static const std::uint32_t  g_numChunksPerType      = 8;
+static const std::uint32_t  g_numAllocs             = 6000;
+static const std::uint64_t  g_maxMoveSizePerFrame   = 2ull * 1024 * 1024;
+static const std::uint64_t  g_releaseLatency        = 3;
+static const std::uint64_t  g_maxFrames             = 10000;
+
+static const std::uint64_t  g_alignments[]          = { 16, 64, 256, 4096, 65536 };
+
+static const std::size_t    g_invalidIndex          = ~static_cast<std::size_t>(0);
+
+struct SimAllocation
+{
+    std::size_t     chunk;
+    std::uint64_t   offset;
+    std::uint64_t   size;
+    std::uint64_t   alignment;
+    bool            movable;
+    bool            alive;
+    std::uint64_t   releaseFrame;
+};
+
+struct SimChunk
+{
+    std::uint32_t                       memoryTypeIndex;
+    std::uint64_t                       size;
+    std::map<std::uint64_t, std::size_t> allocs; // Offset -> allocation index (includes pending allocations)
+};
+
+class SimMemory
+{
+
+    public:
+
+        std::vector<SimChunk>       chunks;
+        std::vector<SimAllocation>  allocs;
+
+    public:
+
+        // Returns true if the specified range is entirely free within the specified chunk.
+        bool IsFree(std::size_t chunk, std::uint64_t offset, std::uint64_t size) const
+        {
+            const auto& entries = chunks[chunk].allocs;
+            if (offset + size > chunks[chunk].size)
+                return false;
+
+            auto next = entries.lower_bound(offset);
+            if (next != entries.end() && next->first < offset + size)
+                return false;
+
+            if (next != entries.begin())
+            {
+                auto prev = std::prev(next);
+                if (prev->first + allocs[prev->second].size > offset)
+                    return false;
+            }
+
+            return true;
+        }
+
+        // Allocates a block with first-fit in the specified chunk, and returns the allocation index or ~0.
+        std::size_t Allocate(std::size_t chunk, std::uint64_t size, std::uint64_t alignment, bool movable)
+        {
+            std::uint64_t offset = 0;
+            for (const auto& entry : chunks[chunk].allocs)
+            {
+                if ((offset + alignment - 1) / alignment * alignment + size <= entry.first)
+                    break;
+                offset = entry.first + allocs[entry.second].size;
+            }
+
+            offset = (offset + alignment - 1) / alignment * alignment;
+            if (offset + size > chunks[chunk].size)
+                return g_invalidIndex;
+
+            return Insert(chunk, offset, size, alignment, movable);
+        }
+
+        std::size_t Insert(std::size_t chunk, std::uint64_t offset, std::uint64_t size, std::uint64_t alignment, bool movable)
+        {
+            const auto index = allocs.size();
+            allocs.push_back({ chunk, offset, size, alignment, movable, true, 0 });
+            chunks[chunk].allocs[offset] = index;
+            return index;
+        }
+
+        void Release(std::size_t index)
+        {
+            chunks[allocs[index].chunk].allocs.erase(allocs[index].offset);
+            allocs[index].alive         = false;
+            allocs[index].releaseFrame  = 0;
+        }
+
+        // Converts the simulated chunks into the input of the planner.
+        void BuildPlannerInput(std::vector<VKDefragChunk>& output) const
+        {
+            output.resize(chunks.size());
+
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+            {
+                auto& dst = output[i];
+
+                dst.memoryTypeIndex = chunks[i].memoryTypeIndex;
+                dst.size            = chunks[i].size;
+                dst.pendingSize     = 0;
+                dst.freeRanges.clear();
+                dst.allocations.clear();
+
+                std::uint64_t offset = 0;
+                for (const auto& entry : chunks[i].allocs)
+                {
+                    const auto& alloc = allocs[entry.second];
+
+                    if (entry.first > offset)
+                        dst.freeRanges.push_back({ offset, entry.first - offset });
+                    offset = entry.first + alloc.size;
+
+                    if (alloc.releaseFrame != 0)
+                        dst.pendingSize += alloc.size;
+                    else if (alloc.movable)
+                        dst.allocations.push_back({ entry.second, alloc.offset, alloc.size, alloc.alignment });
+                }
+
+                if (offset < chunks[i].size)
+                    dst.freeRanges.push_back({ offset, chunks[i].size - offset });
+            }
+        }
+
+        std::size_t CountNonEmptyChunks() const
+        {
+            return static_cast<std::size_t>(
+                std::count_if(chunks.begin(), chunks.end(), [](const SimChunk& chunk) { return !chunk.allocs.empty(); })
+            );
+        }
+
+        std::uint64_t GetAliveSize() const
+        {
+            std::uint64_t size = 0;
+            for (const auto& alloc : allocs)
+            {
+                if (alloc.alive && alloc.releaseFrame == 0)
+                    size += alloc.size;
+            }
+            return size;
+        }
+
+};
+
+struct DefragResult
+{
+    std::uint64_t   numFrames   = 0;
+    std::uint64_t   numMoves    = 0;
+    std::uint64_t   movedSize   = 0;
+};
+
+// Validates all planned moves of a single frame against the simulated memory and applies them.
+static void ApplyMoves(SimMemory& mem, const std::vector<VKDefragMove>& moves, std::uint64_t maxMoveSize, std::uint64_t frame, DefragResult& result)
+{
+    std::uint64_t frameSize = 0;
+
+    for (const auto& move : moves)
+    {
+        if (move.id >= mem.allocs.size())
+            throw std::runtime_error("move refers to unknown allocation " + std::to_string(move.id));
+
+        auto& alloc = mem.allocs[move.id];
+
+        if (!alloc.alive || alloc.releaseFrame != 0)
+            throw std::runtime_error("move refers to allocation that has already been moved");
+        if (!alloc.movable)
+            throw std::runtime_error("move refers to immovable allocation");
+        if (alloc.chunk != move.srcChunk || alloc.size != move.size)
+            throw std::runtime_error("move does not match its source allocation");
+        if (move.srcChunk == move.dstChunk)
+            throw std::runtime_error("move within the same chunk");
+        if (mem.chunks[move.srcChunk].memoryTypeIndex != mem.chunks[move.dstChunk].memoryTypeIndex)
+            throw std::runtime_error("move between different memory types");
+        if (move.dstOffset % alloc.alignment != 0)
+            throw std::runtime_error("misaligned destination offset " + std::to_string(move.dstOffset) + " for alignment " + std::to_string(alloc.alignment));
+        if (!mem.IsFree(move.dstChunk, move.dstOffset, move.size))
+            throw std::runtime_error("destination range at offset " + std::to_string(move.dstOffset) + " overlaps another allocation");
+
+        for (const auto& entry : mem.chunks[move.srcChunk].allocs)
+        {
+            if (!mem.allocs[entry.second].movable)
+                throw std::runtime_error("move out of a chunk that cannot be evacuated");
+        }
+
+        /* Allocate destination and retire source allocation */
+        mem.Insert(move.dstChunk, move.dstOffset, alloc.size, alloc.alignment, true);
+        mem.allocs[move.id].releaseFrame = frame + g_releaseLatency;
+
+        frameSize += move.size;
+    }
+
+    if (moves.size() > 1 && frameSize > maxMoveSize)
+        throw std::runtime_error("moves of frame " + std::to_string(frame) + " exceed the byte budget: " + std::to_string(frameSize));
+
+    result.numMoves     += moves.size();
+    result.movedSize    += frameSize;
+}
+
+// Releases all retired allocations whose latency has expired.
+static bool ReleaseRetired(SimMemory& mem, std::uint64_t frame, bool releaseAll)
+{
+    bool anyPending = false;
+
+    for (std::size_t i = 0; i < mem.allocs.size(); ++i)
+    {
+        auto& alloc = mem.allocs[i];
+        if (alloc.alive && alloc.releaseFrame != 0)
+        {
+            if (releaseAll || alloc.releaseFrame <= frame)
+                mem.Release(i);
+            else
+                anyPending = true;
+        }
+    }
+
+    return anyPending;
+}
+
+// Runs the planner once per frame until no more moves are planned and all retired allocations are released.
+static DefragResult RunDefragmentation(SimMemory& mem, std::uint64_t maxMoveSize)
+{
+    LLGL::VKDeviceMemoryDefragPlanner planner;
+    std::vector<VKDefragChunk> chunks;
+    std::vector<VKDefragMove> moves;
+
+    DefragResult result;
+
+    for (std::uint64_t frame = 1; frame <= g_maxFrames; ++frame)
+    {
+        const bool anyPending = ReleaseRetired(mem, frame, false);
+
+        mem.BuildPlannerInput(chunks);
+        planner.Plan(chunks, maxMoveSize, moves);
+
+        if (moves.empty() && !anyPending)
+        {
+            result.numFrames = frame;
+            return result;
+        }
+
+        ApplyMoves(mem, moves, maxMoveSize, frame, result);
+    }
+
+    throw std::runtime_error("defragmentation did not converge within " + std::to_string(g_maxFrames) + " frames");
+}
+
+// Two chunks with movable allocations: the less occupied chunk must be evacuated into the other one over several frames.
+static void TestTwoChunks()
+{
+    const std::uint64_t chunkSize = 1024 * 1024;
+    const std::uint64_t allocSize = 64 * 1024;
+
+    SimMemory mem;
+    mem.chunks.push_back({ 0, chunkSize, {} });
+    mem.chunks.push_back({ 0, chunkSize, {} });
+
+    for (int i = 0; i < 12; ++i)
+        mem.Allocate(0, allocSize, 256, true);
+    for (int i = 0; i < 4; ++i)
+        mem.Allocate(1, allocSize, 256, true);
+
+    auto result = RunDefragmentation(mem, 2 * allocSize);
+
+    if (!mem.chunks[1].allocs.empty() || mem.chunks[0].allocs.size() != 16)
+        throw std::runtime_error("two chunk test: less occupied chunk was not evacuated");
+    if (result.numMoves != 4 || result.movedSize != 4 * allocSize)
+        throw std::runtime_error("two chunk test: unexpected number of moves: " + std::to_string(result.numMoves));
+
+    std::cout << "two chunk test: passed (" << result.numFrames << " frames)" << std::endl;
+}
+
+// Chunk with an immovable allocation must never be evacuated, but it can still receive allocations.
+static void TestImmovableChunk()
+{
+    const std::uint64_t chunkSize = 1024 * 1024;
+
+    SimMemory mem;
+    mem.chunks.push_back({ 0, chunkSize, {} });
+    mem.chunks.push_back({ 0, chunkSize, {} });
+
+    mem.Allocate(0, 4096, 4096, false);
+    for (int i = 0; i < 8; ++i)
+        mem.Allocate(1, 32 * 1024, 256, true);
+
+    RunDefragmentation(mem, chunkSize);
+
+    if (!mem.chunks[1].allocs.empty() || mem.chunks[0].allocs.size() != 9)
+        throw std::runtime_error("immovable chunk test: movable chunk was not evacuated into chunk with immovable allocation");
+
+    std::cout << "immovable chunk test: passed" << std::endl;
+}
+
+// Fragments several chunks by random allocation and release, then defragments them with a per-frame budget.
+static void TestRandomFragmentation()
+{
+    std::mt19937 rng;
+    SimMemory mem;
+
+    for (std::uint32_t type = 0; type < g_numMemoryTypes; ++type)
+    {
+        for (std::uint32_t i = 0; i < g_numChunksPerType; ++i)
+            mem.chunks.push_back({ type, g_chunkSize, {} });
+    }
+
+    /* Fill chunks in order like the device memory manager, then release most allocations in random order */
+    std::vector<std::size_t> allocated;
+
+    for (std::uint32_t i = 0; i < g_numAllocs; ++i)
+    {
+        const auto type         = rng() % g_numMemoryTypes;
+        const auto size         = 256 + static_cast<std::uint64_t>(rng()) % (64 * 1024);
+        const auto alignment    = g_alignments[rng() % (sizeof(g_alignments) / sizeof(g_alignments[0]))];
+        const bool movable      = (rng() % 200 != 0);
+
+        for (std::uint32_t j = 0; j < g_numChunksPerType; ++j)
+        {
+            const auto index = mem.Allocate(type * g_numChunksPerType + j, size, alignment, movable);
+            if (index != g_invalidIndex)
+            {
+                allocated.push_back(index);
+                break;
+            }
+        }
+    }
+
+    std::shuffle(allocated.begin(), allocated.end(), rng);
+    for (std::size_t i = 0; i < allocated.size() * 3 / 4; ++i)
+        mem.Release(allocated[i]);
+
+    const auto aliveSizeBefore  = mem.GetAliveSize();
+    const auto numChunksBefore  = mem.CountNonEmptyChunks();
+
+    auto result = RunDefragmentation(mem, g_maxMoveSizePerFrame);
+
+    const auto aliveSizeAfter   = mem.GetAliveSize();
+    const auto numChunksAfter   = mem.CountNonEmptyChunks();
+
+    if (aliveSizeBefore != aliveSizeAfter)
+        throw std::runtime_error("random fragmentation test: allocated size changed from " + std::to_string(aliveSizeBefore) + " to " + std::to_string(aliveSizeAfter));
+    if (numChunksAfter >= numChunksBefore)
+        throw std::runtime_error("random fragmentation test: no chunk was evacuated");
+
+    std::cout << "random fragmentation test: " << numChunksBefore << " -> " << numChunksAfter << " non-empty chunks, ";
+    std::cout << result.numMoves << " moves (" << (result.movedSize / 1024) << " KB) in " << result.numFrames << " frames" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestTwoChunks();
+        TestImmovableChunk();
+        TestRandomFragmentation();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
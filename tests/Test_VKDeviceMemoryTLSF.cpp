@@ -0,0 +1,243 @@
+/*
+ * Test_VKDeviceMemoryTLSF.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Renderer/Vulkan/Memory/VKDeviceMemoryTLSF.h"
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+
+/*
+Unit test and benchmark for the TLSF sub-allocator of the Vulkan device memory chunks.
+The allocator only manages offsets, so no Vulkan device is required: the "device memory" is a shadow array
+that records which allocation owns each granule, which is used to validate bounds, alignment, and overlaps.
+The benchmark churns through several hundred thousand allocations similar to a level load.
+*/
+
+using LLGL::VKDeviceMemoryTLSF;
+
+static const std::uint64_t  g_shadowChunkSize   = 16ull * 1024 * 1024;
+static const std::uint32_t  g_numShadowOps      = 200000;
+
+static const std::uint64_t  g_benchChunkSize    = 4ull * 1024 * 1024 * 1024;
+static const std::uint32_t  g_numBenchAllocs    = 100000;
+static const std::uint32_t  g_numBenchRounds    = 4;
+
+static const std::uint64_t  g_alignments[]      = { 4, 16, 64, 256, 4096, 65536 };
+
+// Returns a random size between 1 byte and the specified maximum size with a logarithmic distribution.
+static std::uint64_t RandomSize(std::mt19937& rng, std::uint32_t maxSizeLog2)
+{
+    const auto sizeLog2 = rng() % (maxSizeLog2 + 1);
+    return 1 + (static_cast<std::uint64_t>(rng()) % (1ull << sizeLog2));
+}
+
+static std::uint64_t RandomAlignment(std::mt19937& rng)
+{
+    return g_alignments[rng() % (sizeof(g_alignments) / sizeof(g_alignments[0]))];
+}
+
+// Fake device memory chunk: stores the owner of each granule to detect overlapping allocations.
+class ShadowMemory
+{
+
+    public:
+
+        ShadowMemory(std::uint64_t size) :
+            owners_ ( static_cast<std::size_t>(size / VKDeviceMemoryTLSF::granularity), VKDeviceMemoryTLSF::invalidBlock )
+        {
+        }
+
+        void Fill(std::uint64_t offset, std::uint64_t size, VKDeviceMemoryTLSF::BlockID expected, VKDeviceMemoryTLSF::BlockID owner)
+        {
+            const auto first    = static_cast<std::size_t>(offset / VKDeviceMemoryTLSF::granularity);
+            const auto last     = static_cast<std::size_t>((offset + size - 1) / VKDeviceMemoryTLSF::granularity);
+
+            if (last >= owners_.size())
+                throw std::runtime_error("allocation exceeds device memory chunk: offset = " + std::to_string(offset) + ", size = " + std::to_string(size));
+
+            for (auto i = first; i <= last; ++i)
+            {
+                if (owners_[i] != expected)
+                    throw std::runtime_error("overlapping allocation at offset " + std::to_string(i * VKDeviceMemoryTLSF::granularity));
+                owners_[i] = owner;
+            }
+        }
+
+    private:
+
+        std::vector<VKDeviceMemoryTLSF::BlockID> owners_;
+
+};
+
+struct Allocation
+{
+    VKDeviceMemoryTLSF::BlockID block;
+    std::uint64_t               size;
+};
+
+static void ReleaseRandom(VKDeviceMemoryTLSF& tlsf, std::vector<Allocation>& allocs, std::mt19937& rng, ShadowMemory* shadow)
+{
+    const auto index = rng() % allocs.size();
+    const auto alloc = allocs[index];
+
+    if (shadow)
+        shadow->Fill(tlsf.GetOffset(alloc.block), alloc.size, alloc.block, VKDeviceMemoryTLSF::invalidBlock);
+
+    tlsf.Release(alloc.block);
+
+    allocs[index] = allocs.back();
+    allocs.pop_back();
+}
+
+// Validates that the allocator is entirely free and merged back into a single block.
+static void ValidateEmpty(const VKDeviceMemoryTLSF& tlsf, const std::string& context)
+{
+    LLGL::VKDeviceMemoryTLSFDetails details;
+    tlsf.AccumDetails(details);
+
+    if (!tlsf.IsEmpty() || details.numAllocatedBlocks != 0 || details.numFreeBlocks != 1 || details.largestFreeBlock != tlsf.GetSize())
+    {
+        throw std::runtime_error(
+            context + ": free blocks were not merged (" + std::to_string(details.numFreeBlocks) +
+            " free blocks, largest = " + std::to_string(details.largestFreeBlock) + ")"
+        );
+    }
+
+    if (tlsf.GetMaxAllocationSize() > tlsf.GetSize())
+        throw std::runtime_error(context + ": maximal allocation size exceeds chunk size");
+}
+
+// Randomly allocates and releases blocks, and validates each allocation against the shadow memory.
+static void TestShadowMemory()
+{
+    VKDeviceMemoryTLSF tlsf(g_shadowChunkSize);
+    ShadowMemory shadow(g_shadowChunkSize);
+
+    std::mt19937 rng;
+    std::vector<Allocation> allocs;
+
+    std::uint32_t numFailed = 0;
+
+    for (std::uint32_t i = 0; i < g_numShadowOps; ++i)
+    {
+        if (allocs.empty() || rng() % 8 < 5)
+        {
+            const auto size         = RandomSize(rng, 16);
+            const auto alignment    = RandomAlignment(rng);
+            const auto maxSize      = tlsf.GetMaxAllocationSize();
+
+            auto block = tlsf.Allocate(size, std::min(alignment, VKDeviceMemoryTLSF::granularity));
+            if (block != VKDeviceMemoryTLSF::invalidBlock)
+            {
+                /* Release block again and allocate it with the actual alignment */
+                tlsf.Release(block);
+            }
+            else if (size <= maxSize)
+                throw std::runtime_error("allocation of " + std::to_string(size) + " bytes failed within maximal allocation size " + std::to_string(maxSize));
+
+            block = tlsf.Allocate(size, alignment);
+            if (block == VKDeviceMemoryTLSF::invalidBlock)
+            {
+                ++numFailed;
+                continue;
+            }
+
+            if (tlsf.GetOffset(block) % alignment != 0)
+                throw std::runtime_error("misaligned allocation at offset " + std::to_string(tlsf.GetOffset(block)) + " for alignment " + std::to_string(alignment));
+            if (tlsf.GetSize(block) < size)
+                throw std::runtime_error("allocation is smaller than requested");
+
+            shadow.Fill(tlsf.GetOffset(block), size, VKDeviceMemoryTLSF::invalidBlock, block);
+            allocs.push_back({ block, size });
+        }
+        else
+            ReleaseRandom(tlsf, allocs, rng, &shadow);
+    }
+
+    while (!allocs.empty())
+        ReleaseRandom(tlsf, allocs, rng, &shadow);
+
+    ValidateEmpty(tlsf, "shadow memory test");
+
+    std::cout << "shadow memory test: " << g_numShadowOps << " operations passed (" << numFailed << " allocations failed due to a full chunk)" << std::endl;
+}
+
+// Allocates many blocks, releases half of them in random order, refills them, and releases all blocks again.
+static void BenchmarkChurn()
+{
+    VKDeviceMemoryTLSF tlsf(g_benchChunkSize);
+
+    std::mt19937 rng;
+    std::vector<Allocation> allocs;
+    allocs.reserve(g_numBenchAllocs);
+
+    std::uint64_t   numOps      = 0;
+    double          totalTime   = 0.0;
+
+    for (std::uint32_t round = 0; round < g_numBenchRounds; ++round)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        auto allocate = [&](std::uint32_t count)
+        {
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                const auto size = RandomSize(rng, 16);
+                auto block = tlsf.Allocate(size, RandomAlignment(rng));
+                if (block == VKDeviceMemoryTLSF::invalidBlock)
+                    throw std::runtime_error("allocation failed during benchmark");
+                allocs.push_back({ block, size });
+            }
+            numOps += count;
+        };
+
+        allocate(g_numBenchAllocs);
+
+        for (std::uint32_t i = 0; i < g_numBenchAllocs / 2; ++i)
+            ReleaseRandom(tlsf, allocs, rng, nullptr);
+        numOps += g_numBenchAllocs / 2;
+
+        allocate(g_numBenchAllocs / 2);
+
+        numOps += allocs.size();
+        while (!allocs.empty())
+            ReleaseRandom(tlsf, allocs, rng, nullptr);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        totalTime += std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        ValidateEmpty(tlsf, "benchmark round " + std::to_string(round));
+    }
+
+    std::cout << "churn benchmark: " << numOps << " allocations and releases in " << totalTime << " ms (";
+    std::cout << (totalTime * 1000000.0 / static_cast<double>(numOps)) << " ns per operation)" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestShadowMemory();
+        BenchmarkChurn();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,205 @@
+/*
+ * Test_VKPipelineCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <LLGL/Utility.h>
+#include <vector>
+#include <stdexcept>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <cstdio>
+
+
+/*
+Test for the device-wide Vulkan pipeline cache:
+creates a set of graphics pipelines with a cold cache and retrieves the serialized cache,
+then reloads the render system, restores the cache, and creates the same pipelines again.
+Also verifies that a truncated cache is rejected, that pipelines can still be created with an empty cache,
+and that the cache file is written on shutdown.
+*/
+
+static const std::uint32_t  g_numPipelines      = 32;
+static const char*          g_cacheFilename     = "VKPipelineCache.bin";
+
+// Creates all test pipelines and returns the elapsed time in milliseconds; stores the serialized cache of the last pipeline.
+static double CreatePipelines(LLGL::RenderSystem& renderer, std::unique_ptr<LLGL::Blob>* serializedCache)
+{
+    // Create render context
+    LLGL::RenderContextDescriptor contextDesc;
+    {
+        contextDesc.videoMode.resolution = { 800, 600 };
+    }
+    auto context = renderer.CreateRenderContext(contextDesc);
+
+    // Create shader program
+    LLGL::VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "coord",    LLGL::Format::RG32Float });
+    vertexFormat.AppendAttribute({ "texCoord", LLGL::Format::RG32Float });
+    vertexFormat.AppendAttribute({ "color",    LLGL::Format::RGB32Float });
+
+    auto vertShaderDesc = LLGL::ShaderDescFromFile(LLGL::ShaderType::Vertex,   "Shaders/Triangle.vert.spv");
+    auto fragShaderDesc = LLGL::ShaderDescFromFile(LLGL::ShaderType::Fragment, "Shaders/Triangle.frag.spv");
+
+    vertShaderDesc.vertex.inputAttribs = vertexFormat.attributes;
+
+    LLGL::ShaderProgramDescriptor shaderProgramDesc;
+    {
+        shaderProgramDesc.vertexShader      = renderer.CreateShader(vertShaderDesc);
+        shaderProgramDesc.fragmentShader    = renderer.CreateShader(fragShaderDesc);
+    }
+    auto shaderProgram = renderer.CreateShaderProgram(shaderProgramDesc);
+
+    if (shaderProgram->HasErrors())
+        throw std::runtime_error(shaderProgram->GetReport());
+
+    // Create pipeline layout
+    LLGL::PipelineLayoutDescriptor layoutDesc;
+    {
+        layoutDesc.bindings =
+        {
+            LLGL::BindingDescriptor { LLGL::ResourceType::Buffer,  LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::VertexStage  , 2 },
+            LLGL::BindingDescriptor { LLGL::ResourceType::Buffer,  LLGL::BindFlags::ConstantBuffer, LLGL::StageFlags::FragmentStage, 5 },
+            LLGL::BindingDescriptor { LLGL::ResourceType::Sampler, 0,                               LLGL::StageFlags::FragmentStage, 3 },
+            LLGL::BindingDescriptor { LLGL::ResourceType::Texture, 0,                               LLGL::StageFlags::FragmentStage, 4 },
+        };
+    }
+    auto pipelineLayout = renderer.CreatePipelineLayout(layoutDesc);
+
+    // Create pipelines with different blend, cull, and topology states
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (std::uint32_t i = 0; i < g_numPipelines; ++i)
+    {
+        LLGL::GraphicsPipelineDescriptor pipelineDesc;
+        {
+            pipelineDesc.shaderProgram                  = shaderProgram;
+            pipelineDesc.renderPass                     = context->GetRenderPass();
+            pipelineDesc.pipelineLayout                 = pipelineLayout;
+            pipelineDesc.primitiveTopology              = ((i & 1) != 0 ? LLGL::PrimitiveTopology::TriangleStrip : LLGL::PrimitiveTopology::TriangleList);
+            pipelineDesc.blend.targets[0].blendEnabled  = ((i & 2) != 0);
+            pipelineDesc.rasterizer.cullMode            = ((i & 4) != 0 ? LLGL::CullMode::Back : LLGL::CullMode::Disabled);
+            pipelineDesc.depth.testEnabled              = ((i & 8) != 0);
+            pipelineDesc.rasterizer.frontCCW            = ((i & 16) != 0);
+        }
+        if (!renderer.CreatePipelineState(pipelineDesc, (i + 1 == g_numPipelines ? serializedCache : nullptr)))
+            throw std::runtime_error("failed to create graphics pipeline " + std::to_string(i));
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+// Passes the specified cache to the render system and returns true if it was rejected with a warning.
+static bool IsCacheRejected(LLGL::RenderSystem& renderer, const LLGL::Blob& cache)
+{
+    bool rejected = false;
+
+    LLGL::Log::SetReportCallback(
+        [](LLGL::Log::ReportType type, const std::string& message, const std::string& /*contextInfo*/, void* userData)
+        {
+            if (type == LLGL::Log::ReportType::Warning && message.find("pipeline cache") != std::string::npos)
+                *reinterpret_cast<bool*>(userData) = true;
+        },
+        &rejected
+    );
+
+    renderer.CreatePipelineState(cache);
+
+    LLGL::Log::SetReportCallback(nullptr);
+
+    return rejected;
+}
+
+static std::unique_ptr<LLGL::RenderSystem> LoadVulkan(const LLGL::RendererConfigurationVulkan& config)
+{
+    LLGL::RenderSystemDescriptor rendererDesc;
+    {
+        rendererDesc.moduleName         = "Vulkan";
+        rendererDesc.rendererConfig     = &config;
+        rendererDesc.rendererConfigSize = sizeof(config);
+    }
+    return LLGL::RenderSystem::Load(rendererDesc);
+}
+
+int main()
+{
+    try
+    {
+        std::remove(g_cacheFilename);
+
+        // Create pipelines with cold cache and retrieve serialized cache
+        std::unique_ptr<LLGL::Blob> serializedCache;
+        double timeCold = 0.0;
+        {
+            LLGL::RendererConfigurationVulkan config;
+            auto renderer = LoadVulkan(config);
+            timeCold = CreatePipelines(*renderer, &serializedCache);
+            LLGL::RenderSystem::Unload(std::move(renderer));
+        }
+
+        if (!serializedCache || serializedCache->GetSize() == 0)
+            throw std::runtime_error("Vulkan render system did not return a serialized pipeline cache");
+
+        // Truncated caches must be rejected without passing them to the driver
+        std::vector<std::int8_t> corruptedData(
+            reinterpret_cast<const std::int8_t*>(serializedCache->GetData()),
+            reinterpret_cast<const std::int8_t*>(serializedCache->GetData()) + serializedCache->GetSize() / 2
+        );
+
+        auto corruptedCache = LLGL::Blob::CreateStrongRef(std::move(corruptedData));
+
+        {
+            LLGL::RendererConfigurationVulkan config;
+            auto renderer = LoadVulkan(config);
+
+            if (!IsCacheRejected(*renderer, *corruptedCache))
+                throw std::runtime_error("Vulkan render system did not reject truncated pipeline cache");
+
+            // Pipelines must still be created with the empty cache
+            CreatePipelines(*renderer, nullptr);
+            LLGL::RenderSystem::Unload(std::move(renderer));
+        }
+
+        // Restore cache in new render system and create the same pipelines again
+        double timeWarm = 0.0;
+        {
+            LLGL::RendererConfigurationVulkan config;
+            {
+                config.pipelineCacheFilename = g_cacheFilename;
+            }
+            auto renderer = LoadVulkan(config);
+
+            // Restore valid cache
+            if (IsCacheRejected(*renderer, *serializedCache))
+                throw std::runtime_error("Vulkan render system rejected valid pipeline cache");
+
+            timeWarm = CreatePipelines(*renderer, nullptr);
+            LLGL::RenderSystem::Unload(std::move(renderer));
+        }
+
+        // Pipeline cache file must have been written on shutdown
+        if (!LLGL::Blob::CreateFromFile(g_cacheFilename))
+            throw std::runtime_error("Vulkan render system did not store pipeline cache file: " + std::string(g_cacheFilename));
+
+        // Print pipeline creation times
+        std::cout << "creation of " << g_numPipelines << " graphics pipelines:" << std::endl;
+        std::cout << "  cold cache: " << timeCold << " ms" << std::endl;
+        std::cout << "  warm cache: " << timeWarm << " ms (" << (timeCold / timeWarm) << "x)" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,186 @@
+/*
+ * Test_VKStagingRing.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Renderer/Vulkan/Memory/VKStagingRingAllocator.h"
+#include <vector>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <iostream>
+#include <string>
+
+
+/*
+CPU-side simulation test of the ring allocator for the Vulkan staging ring.
+Ranges are allocated into batches that are submitted at random and completed after a random latency like the fences of the staging ring.
+Every allocated range is validated (alignment, bounds, no overlap with ranges that are still in use) before it is released with its batch.
+*/
+
+using LLGL::VKStagingRingAllocator;
+
+static const std::uint64_t  g_capacity          = 1024 * 1024;
+static const std::uint32_t  g_numAllocs         = 200000;
+static const std::uint64_t  g_alignments[]      = { 1, 4, 12, 16, 256 };
+
+struct Range
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+struct Batch
+{
+    std::vector<Range>  ranges;
+    std::uint64_t       position;
+};
+
+static void Check(bool condition, const std::string& message)
+{
+    if (!condition)
+        throw std::runtime_error(message);
+}
+
+static bool Overlaps(const Range& lhs, const Range& rhs)
+{
+    return (lhs.offset < rhs.offset + rhs.size && rhs.offset < lhs.offset + lhs.size);
+}
+
+static void TestWrapAround()
+{
+    VKStagingRingAllocator ring{ 1000 };
+    std::uint64_t offset = 0;
+
+    Check(ring.Allocate(600, 1, offset) && offset == 0, "wrap-around test: first allocation failed");
+    const auto position0 = ring.GetHead();
+
+    Check(ring.Allocate(300, 1, offset) && offset == 600, "wrap-around test: second allocation failed");
+    const auto position1 = ring.GetHead();
+
+    /* Ring is full until the first range is released */
+    Check(!ring.Allocate(200, 1, offset), "wrap-around test: allocation must fail while ring is full");
+
+    ring.Release(position0);
+
+    /* Remaining 100 bytes at the end are skipped */
+    Check(ring.Allocate(200, 1, offset) && offset == 0, "wrap-around test: allocation must wrap around to the beginning");
+    Check(ring.GetUsedSize() == 300 + 100 + 200, "wrap-around test: used size must include the skipped space");
+
+    ring.Release(position1);
+    ring.Release(ring.GetHead());
+    Check(ring.GetUsedSize() == 0, "wrap-around test: ring must be empty after all ranges have been released");
+
+    /* Entire ring can be allocated at once */
+    Check(ring.Allocate(1000, 1, offset) && offset == 0 && ring.GetUsedSize() == 1000, "wrap-around test: full-size allocation failed");
+    Check(!ring.Allocate(1001, 1, offset), "wrap-around test: allocation larger than the ring must fail");
+
+    std::cout << "wrap-around test: passed" << std::endl;
+}
+
+static void TestRandomBatches()
+{
+    std::mt19937 rng{ 1234 };
+
+    VKStagingRingAllocator ring{ g_capacity };
+
+    Batch               currentBatch;
+    std::deque<Batch>   pendingBatches;
+    std::vector<Range>  liveRanges;
+
+    std::uint64_t numWaits      = 0;
+    std::uint64_t allocatedSize = 0;
+
+    auto submitBatch = [&]()
+    {
+        currentBatch.position = ring.GetHead();
+        pendingBatches.push_back(std::move(currentBatch));
+        currentBatch = Batch{};
+    };
+
+    auto completeOldestBatch = [&]()
+    {
+        const auto& batch = pendingBatches.front();
+        for (const auto& range : batch.ranges)
+        {
+            for (auto it = liveRanges.begin(); it != liveRanges.end(); ++it)
+            {
+                if (it->offset == range.offset && it->size == range.size)
+                {
+                    liveRanges.erase(it);
+                    break;
+                }
+            }
+        }
+        ring.Release(batch.position);
+        pendingBatches.pop_front();
+    };
+
+    for (std::uint32_t i = 0; i < g_numAllocs; ++i)
+    {
+        /* Mostly small uploads with occasional large ones */
+        const auto size         = (rng() % 50 == 0 ? 64 * 1024 + rng() % (256 * 1024) : 1 + rng() % 4096);
+        const auto alignment    = g_alignments[rng() % (sizeof(g_alignments) / sizeof(g_alignments[0]))];
+
+        std::uint64_t offset = 0;
+        while (!ring.Allocate(size, alignment, offset))
+        {
+            /* Submit current batch and wait for the oldest one, just like the staging ring does */
+            if (!currentBatch.ranges.empty())
+                submitBatch();
+            Check(!pendingBatches.empty(), "random batch test: allocation failed although ring is empty");
+            completeOldestBatch();
+            ++numWaits;
+        }
+
+        const Range range{ offset, size };
+
+        Check(offset % alignment == 0, "random batch test: misaligned offset " + std::to_string(offset));
+        Check(offset + size <= g_capacity, "random batch test: range exceeds ring capacity");
+        for (const auto& live : liveRanges)
+            Check(!Overlaps(range, live), "random batch test: range overlaps with range in use at offset " + std::to_string(live.offset));
+        Check(ring.GetUsedSize() <= g_capacity, "random batch test: used size exceeds ring capacity");
+
+        currentBatch.ranges.push_back(range);
+        liveRanges.push_back(range);
+        allocatedSize += size;
+
+        /* Submit batches at random and complete some of them without waiting */
+        if (rng() % 8 == 0)
+            submitBatch();
+        while (!pendingBatches.empty() && rng() % 16 == 0)
+            completeOldestBatch();
+    }
+
+    /* Wait for all batches */
+    submitBatch();
+    while (!pendingBatches.empty())
+        completeOldestBatch();
+
+    Check(liveRanges.empty(), "random batch test: ranges left in use");
+    Check(ring.GetUsedSize() == 0, "random batch test: ring not empty after all batches have been completed");
+
+    std::cout << "random batch test: " << g_numAllocs << " allocations (" << (allocatedSize / (1024 * 1024)) << " MB) with " << numWaits << " waits" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestWrapAround();
+        TestRandomBatches();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -304,6 +304,17 @@ int main()
             // Present result on screen
             context->Present();
         }
+
+        // Print device memory statistics
+        LLGL::MemoryStatistics memoryStats;
+        if (renderer->QueryMemoryStatistics(memoryStats))
+        {
+            std::cout << "Device memory:    " << memoryStats.numBlocks << " blocks in " << memoryStats.numChunks << " chunks (" << memoryStats.numEmptyChunks << " empty)" << std::endl;
+            std::cout << "                  " << memoryStats.blockMemorySize << " of " << memoryStats.chunkMemorySize << " bytes used, ";
+            std::cout << memoryStats.numFreeBlocks << " free blocks (largest: " << memoryStats.largestFreeBlockSize << " bytes)" << std::endl;
+            if (memoryStats.budget > 0)
+                std::cout << "                  " << memoryStats.usage << " of " << memoryStats.budget << " bytes of budget used" << std::endl;
+        }
     }
     catch (const std::exception& e)
     {